@@ -101,6 +101,14 @@ namespace node
 				auto lag = std::chrono::system_clock::now() - cyng::value_cast(frame.at(3), std::chrono::system_clock::now());
 				CYNG_LOG_TRACE(logger_, "cluster login lag: " << cyng::to_str(lag));
 
+				//
+				//	compress large frames if accepted by master (optional)
+				//
+				if ((frame.size() > 5) && (cyng::value_cast(frame.at(5), std::string()) == cluster_compression)) {
+					CYNG_LOG_TRACE(logger_, "cluster compression: " << cluster_compression);
+					ctx.run(cyng::generate_invoke("stream.compress", static_cast<std::uint64_t>(cluster_compression_threshold)));
+				}
+
 				//
 				//	slot [0]
 				//
@@ -8,6 +8,7 @@ set (http_srv_cpp
 	lib/http/server/src/session.cpp
 	lib/http/server/src/connections.cpp
 	lib/http/server/src/auth.cpp
+	lib/http/server/src/asset_cache.cpp
 
 )
 
@@ -17,6 +18,7 @@ set (http_srv_h
 	src/main/include/smf/http/srv/session.h
 #	src/main/include/smf/http/srv/handle_request.hpp
 	src/main/include/smf/http/srv/connections.h
+	src/main/include/smf/http/srv/asset_cache.h
 )
 
 set (http_parser 
@@ -0,0 +1,392 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#include <smf/http/srv/asset_cache.h>
+#include <smf/http/srv/path_cat.h>
+#include <smf/http/srv/mime_type.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <boost/beast/zlib/deflate_stream.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/algorithm/string.hpp>
+#include <boost/crc.hpp>
+
+namespace node
+{
+	namespace http
+	{
+		namespace
+		{
+			/**
+			 * FNV-1a (64 bit)
+			 */
+			std::uint64_t fnv1a(std::string const& data)
+			{
+				std::uint64_t h = 0xcbf29ce484222325ull;
+				for (auto const c : data) {
+					h ^= static_cast<std::uint8_t>(c);
+					h *= 0x100000001b3ull;
+				}
+				return h;
+			}
+
+			/**
+			 * @param suffix distinguishes representations of the same file
+			 */
+			std::string strong_etag(std::string const& data, std::string const& suffix)
+			{
+				std::stringstream ss;
+				ss
+					<< '"'
+					<< std::hex
+					<< data.size()
+					<< '-'
+					<< std::setw(16)
+					<< std::setfill('0')
+					<< fnv1a(data)
+					<< suffix
+					<< '"'
+					;
+				return ss.str();
+			}
+
+			/**
+			 * Uncached files are identified by size and modification time
+			 */
+			std::string weak_etag(std::uint64_t size, std::time_t last_write)
+			{
+				std::stringstream ss;
+				ss
+					<< "W/\""
+					<< std::hex
+					<< size
+					<< '-'
+					<< last_write
+					<< '"'
+					;
+				return ss.str();
+			}
+
+			void append_le32(std::string& out, std::uint32_t v)
+			{
+				out.push_back(static_cast<char>(v & 0xFF));
+				out.push_back(static_cast<char>((v >> 8) & 0xFF));
+				out.push_back(static_cast<char>((v >> 16) & 0xFF));
+				out.push_back(static_cast<char>((v >> 24) & 0xFF));
+			}
+		}
+
+		asset_cache::asset_cache(cyng::logging::log_ptr logger
+			, std::string const& doc_root
+			, std::size_t max_entries
+			, std::size_t max_file_size
+			, std::size_t max_total_size
+			, std::chrono::seconds check_interval)
+		: logger_(logger)
+			, doc_root_(doc_root)
+			, max_entries_((max_entries == 0) ? 1 : max_entries)
+			, max_file_size_(max_file_size)
+			, max_total_size_(max_total_size)
+			, check_interval_(check_interval)
+			, entries_()
+			, bytes_(0)
+			, mutex_()
+		{}
+
+		asset_cache::entry_ptr asset_cache::get(std::string const& request_target)
+		{
+			auto const target = normalize_target(request_target);
+			auto const now = std::chrono::steady_clock::now();
+			entry_ptr ep;
+			std::size_t cached = 0;
+
+			{
+				cyng::async::shared_lock<cyng::async::shared_mutex> lock(mutex_);
+				cached = bytes_;
+				auto pos = entries_.find(target);
+				if (pos != entries_.end()) {
+					if (now - pos->second.checked_ < check_interval_) {
+
+						//
+						//	fast path - no file system access
+						//
+						return pos->second.entry_;
+					}
+					ep = pos->second.entry_;
+				}
+			}
+
+			if (ep) {
+
+				//
+				//	revalidate
+				//
+				boost::system::error_code ec;
+				auto const last_write = boost::filesystem::last_write_time(ep->path_, ec);
+				auto const size = (!ec) ? boost::filesystem::file_size(ep->path_, ec) : 0u;
+				if (!ec && (last_write == ep->last_write_) && (size == ep->size_)) {
+
+					cyng::async::unique_lock<cyng::async::shared_mutex> lock(mutex_);
+					auto pos = entries_.find(target);
+					if (pos != entries_.end()) {
+						pos->second.checked_ = now;
+					}
+					return ep;
+				}
+
+				CYNG_LOG_TRACE(logger_, "asset " << ep->path_ << " modified");
+			}
+
+			//
+			//	(re-)load without holding the lock
+			//
+			auto const np = load(target, cached);
+
+			cyng::async::unique_lock<cyng::async::shared_mutex> lock(mutex_);
+			auto pos = entries_.find(target);
+			if (pos != entries_.end()) {
+				if (pos->second.entry_->data_)	bytes_ -= pos->second.entry_->data_->size();
+				if (pos->second.entry_->gzip_)	bytes_ -= pos->second.entry_->gzip_->size();
+				entries_.erase(pos);
+			}
+
+			//
+			//	don't cache missing files
+			//
+			if (np) {
+				if (entries_.size() >= max_entries_)	evict();
+				if (np->data_)	bytes_ += np->data_->size();
+				if (np->gzip_)	bytes_ += np->gzip_->size();
+				entries_.emplace(target, slot{ np, now });
+			}
+			return np;
+		}
+
+		asset_cache::entry_ptr asset_cache::load(std::string const& target, std::size_t cached)
+		{
+			auto path = path_cat(doc_root_, target);
+
+			boost::system::error_code ec;
+			if (boost::filesystem::is_directory(path, ec)) {
+				path.append("index.html");
+			}
+
+			if (!boost::filesystem::is_regular_file(path, ec)) {
+				return entry_ptr();
+			}
+
+			auto e = std::make_shared<entry>();
+			e->path_ = path;
+			e->mime_ = mime_type(path).to_string();
+			e->size_ = boost::filesystem::file_size(path, ec);
+			e->last_write_ = boost::filesystem::last_write_time(path, ec);
+			if (ec) {
+				return entry_ptr();
+			}
+
+			//
+			//	check memory budget - concurrent loads may
+			//	overshoot slightly
+			//
+			if ((e->size_ <= max_file_size_) && (cached + e->size_ <= max_total_size_)) {
+
+				std::ifstream ifs(path, std::ios::binary);
+				if (!ifs.is_open()) {
+					return entry_ptr();
+				}
+
+				auto data = std::make_shared<std::string>();
+				data->resize(static_cast<std::size_t>(e->size_));
+				ifs.read(&(*data)[0], data->size());
+				data->resize(static_cast<std::size_t>(ifs.gcount()));
+
+				e->etag_ = strong_etag(*data, "");
+
+				if (is_compressible(e->mime_)) {
+					auto gz = std::make_shared<std::string>(gzip(*data));
+
+					//
+					//	keep compressed variant only if it saves at least 10% -
+					//	otherwise (or if compression failed) serve identity only
+					//
+					if (!gz->empty() && gz->size() < (data->size() * 9) / 10) {
+						e->gzip_ = gz;
+						e->etag_gzip_ = strong_etag(*data, "-gz");
+					}
+				}
+				e->data_ = data;
+
+				CYNG_LOG_TRACE(logger_, "cache asset "
+					<< e->path_
+					<< " - "
+					<< e->data_->size()
+					<< " bytes"
+					<< (e->gzip_ ? " / gzip: " + std::to_string(e->gzip_->size()) + " bytes" : ""));
+			}
+			else {
+				e->etag_ = weak_etag(e->size_, e->last_write_);
+			}
+
+			return e;
+		}
+
+		void asset_cache::evict()
+		{
+			auto oldest = entries_.begin();
+			for (auto pos = entries_.begin(); pos != entries_.end(); ++pos) {
+				if (pos->second.checked_ < oldest->second.checked_)	oldest = pos;
+			}
+			if (oldest != entries_.end()) {
+				if (oldest->second.entry_->data_)	bytes_ -= oldest->second.entry_->data_->size();
+				if (oldest->second.entry_->gzip_)	bytes_ -= oldest->second.entry_->gzip_->size();
+				entries_.erase(oldest);
+			}
+		}
+
+		void asset_cache::clear()
+		{
+			cyng::async::unique_lock<cyng::async::shared_mutex> lock(mutex_);
+			entries_.clear();
+			bytes_ = 0;
+		}
+
+		std::size_t asset_cache::size() const
+		{
+			cyng::async::shared_lock<cyng::async::shared_mutex> lock(mutex_);
+			return entries_.size();
+		}
+
+		std::size_t asset_cache::bytes() const
+		{
+			cyng::async::shared_lock<cyng::async::shared_mutex> lock(mutex_);
+			return bytes_;
+		}
+
+		bool match_etag(boost::beast::string_view if_none_match, std::string const& etag)
+		{
+			if (if_none_match.empty())	return false;
+
+			std::string const value(if_none_match.begin(), if_none_match.end());
+			std::vector<std::string> tags;
+			boost::algorithm::split(tags, value, boost::algorithm::is_any_of(","));
+			for (auto& tag : tags) {
+				boost::algorithm::trim(tag);
+				if (tag == "*" || tag == etag)	return true;
+
+				//	weak comparison (RFC 7232, 2.3.2)
+				if (boost::algorithm::starts_with(tag, "W/") && (tag.substr(2) == etag))	return true;
+			}
+			return false;
+		}
+
+		bool accepts_gzip(boost::beast::string_view accept_encoding)
+		{
+			if (accept_encoding.empty())	return false;
+
+			//
+			//	q-value of gzip and of the wildcard - negative if not listed
+			//
+			double q_gzip{ -1.0 }, q_any{ -1.0 };
+
+			std::string const value(accept_encoding.begin(), accept_encoding.end());
+			std::vector<std::string> codings;
+			boost::algorithm::split(codings, value, boost::algorithm::is_any_of(","));
+			for (auto const& coding : codings) {
+
+				//	coding;q=0.5
+				std::vector<std::string> params;
+				boost::algorithm::split(params, coding, boost::algorithm::is_any_of(";"));
+				auto const name = boost::algorithm::to_lower_copy(boost::algorithm::trim_copy(params.front()));
+
+				double q{ 1.0 };
+				for (auto pos = params.begin() + 1; pos != params.end(); ++pos) {
+					auto const param = boost::algorithm::trim_copy(*pos);
+					if (boost::algorithm::istarts_with(param, "q=")) {
+						std::istringstream ss(param.substr(2));
+						if (!(ss >> q))	q = 0.0;	//	malformed weight is a refusal
+					}
+				}
+
+				if (name == "gzip" || name == "x-gzip") {
+					q_gzip = (std::max)(q_gzip, q);
+				}
+				else if (name == "*") {
+					q_any = q;
+				}
+			}
+
+			//	q=0 means "not acceptable" (RFC 7231, 5.3.4)
+			return (q_gzip < 0.0)
+				? (q_any > 0.0)
+				: (q_gzip > 0.0)
+				;
+		}
+
+		bool is_compressible(boost::beast::string_view mime)
+		{
+			return boost::algorithm::starts_with(mime, "text/")
+				|| boost::algorithm::equals(mime, "application/javascript")
+				|| boost::algorithm::equals(mime, "application/json")
+				|| boost::algorithm::equals(mime, "application/xml")
+				|| boost::algorithm::equals(mime, "image/svg+xml")
+				;
+		}
+
+		std::string normalize_target(std::string const& target)
+		{
+			std::string result;
+			result.reserve(target.size());
+			for (auto const c : target) {
+				if (c == '?' || c == '#')	break;
+				if (c == '/' && !result.empty() && result.back() == '/')	continue;
+				result.push_back(c);
+			}
+			return result;
+		}
+
+		std::string gzip(std::string const& data)
+		{
+			//
+			//	gzip header: ID1, ID2, CM (deflate), FLG, MTIME (4), XFL, OS (unix)
+			//
+			std::string out{ '\x1f', '\x8b', '\x08', '\x00', '\x00', '\x00', '\x00', '\x00', '\x00', '\x03' };
+			auto const offset = out.size();
+
+			boost::beast::zlib::deflate_stream ds;
+			ds.reset(6, 15, 8, boost::beast::zlib::Strategy::normal);
+
+			out.resize(offset + ds.upper_bound(data.size()));
+
+			boost::beast::zlib::z_params zs;
+			zs.next_in = data.data();
+			zs.avail_in = data.size();
+			zs.next_out = &out[offset];
+			zs.avail_out = out.size() - offset;
+
+			boost::beast::error_code ec;
+			ds.write(zs, boost::beast::zlib::Flush::finish, ec);
+			if (ec != boost::beast::zlib::error::end_of_stream) {
+				return std::string();
+			}
+			out.resize(offset + zs.total_out);
+
+			//
+			//	trailer: CRC32 and ISIZE (little endian)
+			//
+			boost::crc_32_type crc;
+			crc.process_bytes(data.data(), data.size());
+			append_le32(out, crc.checksum());
+			append_le32(out, static_cast<std::uint32_t>(data.size()));
+
+			return out;
+		}
+	}
+}
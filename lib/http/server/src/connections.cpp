@@ -27,6 +27,8 @@ namespace node
 			, auth_dirs const& ad
 #endif
 			, bool https_rewrite
+			, std::uint64_t body_limit
+			, std::size_t spool_threshold
 			)
 		: logger_(logger)
 			, vm_(vm)
@@ -35,6 +37,9 @@ namespace node
 			, auth_dirs_(ad)
 #endif
 			, https_rewrite_(https_rewrite)
+			, body_limit_(body_limit)
+			, spool_threshold_(spool_threshold)
+			, assets_(logger, doc_root, 4096, 1024 * 1024, 64 * 1024 * 1024, std::chrono::seconds(2))
 			, uidgen_()
 			, sessions_()
 			, mutex_()
@@ -46,17 +51,23 @@ namespace node
 			return vm_;
 		}
 
+		asset_cache& connections::assets()
+		{
+			return assets_;
+		}
+
 		void connections::create_session(boost::asio::ip::tcp::socket socket)
 		{
 			auto obj = cyng::make_object<session>(logger_
 				, *this
 				, uidgen_()
 				, std::move(socket)
-				, doc_root_
 #ifdef NODE_SSL_INSTALLED
 				, auth_dirs_
 #endif
-				, https_rewrite_);
+				, https_rewrite_
+				, body_limit_
+				, spool_threshold_);
 
 			auto sp = const_cast<session*>(cyng::object_cast<session>(obj));
 			BOOST_ASSERT(sp != nullptr);
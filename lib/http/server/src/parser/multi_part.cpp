@@ -19,7 +19,8 @@ namespace node
 			, cyng::logging::log_ptr logger
 			, std::uint64_t& content_size
 			, boost::beast::string_view target
-			, boost::uuids::uuid tag)
+			, boost::uuids::uuid tag
+			, std::size_t spool_threshold)
 		: state_(chunk_init_)
 			, cb_(cb)
 			, logger_(logger)
@@ -27,13 +28,21 @@ namespace node
 			, boundary_()
 			, chunck_()
 			, content_size_(content_size)
-			, target_(target)
+			, target_(target.begin(), target.end())
 			, tag_(tag)
 			, upload_size_(0)
 			, progress_(0)
 			, column_(0)
+			, spool_threshold_(spool_threshold)
+			, spool_()
+			, spool_path_()
 		{}
 
+		multi_part_parser::~multi_part_parser()
+		{
+			discard_spool();
+		}
+
 		void multi_part_parser::reset(std::string const& boundary)
 		{
 #ifdef _DEBUG
@@ -44,6 +53,7 @@ namespace node
 			//	reset temporary data
 			//
 			clear(upload_);
+			discard_spool();
 
 			CYNG_LOG_TRACE(logger_, "boundary: " << boundary);
 			boundary_ = boundary;
@@ -331,6 +341,7 @@ namespace node
 					{
 						CYNG_LOG_TRACE(logger_, "upload file: "
 							<< filename);
+						upload_.file_ = true;
 					}
 
 					switch (cd.type_)
@@ -393,6 +404,7 @@ namespace node
 		{
 			chunck_.clear();
 			clear(upload_);
+			discard_spool();
 			return chunk_header_;
 		}
 
@@ -409,6 +421,10 @@ namespace node
 			//	save data into memory
 			//	or write on disk
 			upload_.data_.push_back(c);
+			if (upload_.file_ && (spool_threshold_ != 0) && (upload_.data_.size() >= spool_threshold_))
+			{
+				spool();
+			}
 
 			//	upload is running
 			return state_;
@@ -448,6 +464,31 @@ namespace node
 							, var_name
 							, std::string(upload_.data_.begin(), upload_.data_.end())));
 					}
+					else if (spool_.is_open())
+					{
+						//
+						//	flush remaining data and hand over the file
+						//
+						spool();
+						spool_.close();
+
+						CYNG_LOG_DEBUG(logger_, "upload of ["
+							<< var_name
+							<< "] spooled into "
+							<< spool_path_);
+
+						cb_(cyng::generate_invoke("http.upload.file"
+							, tag_
+							, var_name
+							, filename
+							, to_str(upload_.type_)
+							, spool_path_.string()));
+
+						//
+						//	ownership moved to the receiver
+						//
+						spool_path_.clear();
+					}
 					else
 					{
 
@@ -487,11 +528,56 @@ namespace node
 				;
 		}
 
+		void multi_part_parser::spool()
+		{
+			if (!spool_.is_open())
+			{
+				//	opening the spool file failed already
+				if (!spool_.good())	return;
+
+				spool_path_ = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("smf-upload-%%%%-%%%%-%%%%-%%%%.tmp");
+				spool_.open(spool_path_.string(), std::ios::binary | std::ios::trunc);
+				if (!spool_.is_open())
+				{
+					CYNG_LOG_ERROR(logger_, "cannot open spool file "
+						<< spool_path_);
+					spool_path_.clear();
+
+					//	keep data in memory
+					return;
+				}
+				CYNG_LOG_TRACE(logger_, "open spool file "
+					<< spool_path_);
+			}
+
+			spool_.write(upload_.data_.data(), upload_.data_.size());
+			upload_.data_.clear();
+		}
+
+		void multi_part_parser::discard_spool()
+		{
+			if (spool_.is_open())
+			{
+				spool_.close();
+			}
+			spool_.clear();
+			if (!spool_path_.empty())
+			{
+				CYNG_LOG_WARNING(logger_, "remove incomplete spool file "
+					<< spool_path_);
+
+				boost::system::error_code ec;
+				boost::filesystem::remove(spool_path_, ec);
+				spool_path_.clear();
+			}
+		}
+
 		multi_part_parser::multi_part::multi_part()
 			: size_(0)
 			, data_()
 			, meta_()
 			, type_()
+			, file_(false)
 		{}
 
 		void clear(multi_part_parser::multi_part& req)
@@ -28,7 +28,9 @@ namespace node
 #endif
 			, std::set<boost::asio::ip::address> const& blacklist
 			, cyng::controller& vm
-			, bool https_rewrite)
+			, bool https_rewrite
+			, std::uint64_t body_limit
+			, std::size_t spool_threshold)
 		: logger_(logger)
 			, acceptor_(ioc)
 			, socket_(ioc)
@@ -39,7 +41,9 @@ namespace node
 #ifdef NODE_SSL_INSTALLED
 				, ad
 #endif
-				, https_rewrite)
+				, https_rewrite
+				, body_limit
+				, spool_threshold)
 			, is_listening_(false)
 			, shutdown_complete_()
 			, mutex_()
@@ -8,8 +8,6 @@
 #include <smf/http/srv/connections.h>
 #include <smf/http/srv/session.h>
 #include <smf/http/srv/websocket.h>
-#include <smf/http/srv/path_cat.h>
-#include <smf/http/srv/mime_type.h>
 #include <smf/http/srv/connections.h>
 #include <smf/http/srv/parser/multi_part.h>
 
@@ -26,27 +24,49 @@ namespace node
 
 	namespace http
 	{
+		namespace
+		{
+			/**
+			 * Request target must be absolute and must not leave the document root.
+			 */
+			bool is_valid_target(boost::beast::string_view target)
+			{
+				return !target.empty()
+					&& target[0] == '/'
+					&& target.find("..") == boost::beast::string_view::npos
+					;
+			}
+		}
+
 		session::session(cyng::logging::log_ptr logger
 			, connections& cm
 			, boost::uuids::uuid tag
 			, boost::asio::ip::tcp::socket socket
-			, std::string const& doc_root
 #ifdef NODE_SSL_INSTALLED
 			, auth_dirs const& ad
 #endif
-			, bool https_rewrite)
+			, bool https_rewrite
+			, std::uint64_t body_limit
+			, std::size_t spool_threshold)
 		: logger_(logger)
 			, tag_(tag)
-			, doc_root_(doc_root)
 #ifdef NODE_SSL_INSTALLED
 			, auth_dirs_(ad)
 #endif
 			, https_rewrite_(https_rewrite)
+			, body_limit_(body_limit)
+			, spool_threshold_(spool_threshold)
 			, socket_(std::move(socket))
 			, connection_manager_(cm)
 			, strand_(socket_.get_executor())
 			, timer_(socket_.get_executor().context(), (std::chrono::steady_clock::time_point::max)())
 			, buffer_()
+			, header_parser_()
+			, parser_()
+			, stream_parser_()
+			, chunk_()
+			, mpp_()
+			, payload_size_(0)
 			, queue_(*this)
             , shutdown_(false)
 			, authorized_(false)
@@ -100,18 +120,19 @@ namespace node
             // Set the timer
 			timer_.expires_after(std::chrono::seconds(15));
 
-			// Make the request empty before reading,
-			// otherwise the operation behavior is undefined.
-			req_ = {};
+			//
+			//	Read the header first. The body limit is checked
+			//	against the content length before any payload is read.
+			//
+			header_parser_.emplace();
+			header_parser_->body_limit(body_limit_);
 
-			// Read a request
-			boost::beast::http::async_read(socket_, buffer_, req_,
+			boost::beast::http::async_read_header(socket_, buffer_, *header_parser_,
 				boost::asio::bind_executor(
 					strand_,
 					std::bind(
-						&session::on_read,
+						&session::on_read_header,
 						this,
-						//shared_from_this(),
 						std::placeholders::_1)));
 		}
 
@@ -165,21 +186,14 @@ namespace node
 			}
 		}
 
-		void session::on_read(boost::system::error_code ec)
+		bool session::check_read_error(boost::system::error_code ec)
 		{
-            //
-            //  no activities during shutdown
-            //
-            if (shutdown_)  return;
-
-            //CYNG_LOG_TRACE(logger_, "session read use count " << (this->shared_from_this().use_count() - 1));
-
 			// Happens when the timer closes the socket
 			if (ec == boost::asio::error::operation_aborted)
 			{
 				CYNG_LOG_WARNING(logger_, tag() << " - timer aborted session");
 				auto obj = connection_manager_.stop_session(tag());
-				return;
+				return false;
 			}
 
 			// This means they closed the connection
@@ -187,19 +201,110 @@ namespace node
 			{
 				CYNG_LOG_TRACE(logger_,  tag() << " session closed - read");
 				auto obj = connection_manager_.stop_session(tag());
-// 				queue_.items_.clear();
-				return;
+				return false;
+			}
+
+			//	content length exceeds configured limit
+			if (ec == boost::beast::http::error::body_limit)
+			{
+				CYNG_LOG_WARNING(logger_, tag() << " body limit of " << body_limit_ << " bytes exceeded");
+
+				//
+				//	answer with the HTTP version of the request
+				//
+				std::uint32_t version{ 11 };
+				if (stream_parser_)	version = stream_parser_->get().version();
+				else if (parser_)	version = parser_->get().version();
+				else if (header_parser_)	version = header_parser_->get().version();
+
+				mpp_.reset();
+				stream_parser_.reset();
+				parser_.reset();
+				header_parser_.reset();
+
+				//	413 - closes connection after sending
+				queue_(send_payload_too_large(version));
+				return false;
 			}
 
 			if (ec)
 			{
 				CYNG_LOG_ERROR(logger_, tag() << " read error: " << ec.message());
 				auto obj = connection_manager_.stop_session(tag());
+				return false;
+			}
+			return true;
+		}
+
+		void session::on_read_header(boost::system::error_code ec)
+		{
+            //
+            //  no activities during shutdown
+            //
+            if (shutdown_)  return;
+
+			if (!check_read_error(ec))	return;
+
+			auto const& header = header_parser_->get();
+
+			//
+			//	Validate the target before any request handler (including
+			//	the upload) is selected. The body is not read, so the
+			//	connection is closed after the response.
+			//
+			if (!is_valid_target(header.target()))
+			{
+				auto const version = header.version();
+				header_parser_.reset();
+				return queue_(send_bad_request(version
+					, false
+					, "Illegal request-target"));
+			}
+
+			if (header.method() == boost::beast::http::verb::post
+				&& boost::algorithm::starts_with(header[boost::beast::http::field::content_type], "multipart/form-data"))
+			{
+				//
+				//	stream upload in chunks
+				//
+				stream_parser_.emplace(std::move(*header_parser_));
+				header_parser_.reset();
+				stream_parser_->body_limit(body_limit_);
+				start_upload();
 				return;
 			}
 
+			//
+			//	Read the (small) remaining body into a string. The string_body
+			//	reader reserves the announced content length in advance.
+			//
+			parser_.emplace(std::move(*header_parser_));
+			header_parser_.reset();
+			parser_->body_limit(body_limit_);
+
+			boost::beast::http::async_read(socket_, buffer_, *parser_,
+				boost::asio::bind_executor(
+					strand_,
+					std::bind(
+						&session::on_read,
+						this,
+						std::placeholders::_1)));
+		}
+
+		void session::on_read(boost::system::error_code ec)
+		{
+            //
+            //  no activities during shutdown
+            //
+            if (shutdown_)  return;
+
+			if (!check_read_error(ec))	return;
+
+			auto req = parser_->release();
+			parser_.reset();
+
 			// See if it is a WebSocket Upgrade
-			if (boost::beast::websocket::is_upgrade(req_))
+			if (boost::beast::websocket::is_upgrade(req))
 			{
 				CYNG_LOG_TRACE(logger_, "update session " 
 					<< tag()
@@ -207,7 +312,7 @@ namespace node
 					<< socket_.remote_endpoint());
 
 				// Create a WebSocket websocket_session by transferring the socket
-				connection_manager_.upgrade(tag(), std::move(socket_), std::move(req_));
+				connection_manager_.upgrade(tag(), std::move(socket_), std::move(req));
 
 				//
 				//  There is an object bound to the timer that increases the lifetime of session until times is canceled
@@ -218,7 +323,7 @@ namespace node
 
 			// Send the response
 			CYNG_LOG_TRACE(logger_, "handle request " << socket_.remote_endpoint());
-			handle_request(std::move(req_));
+			handle_request(std::move(req));
 
 			// If we aren't at the queue limit, try to pipeline another request
 			if (!queue_.is_full())
@@ -227,6 +332,100 @@ namespace node
 			}
 		}
 
+		void session::start_upload()
+		{
+			auto const& header = stream_parser_->get();
+			auto const target = header.target();
+
+			//
+			//	without content length the progress cannot be calculated
+			//
+			auto const content_length = stream_parser_->content_length();
+			if (!content_length || (*content_length == 0)) {
+				CYNG_LOG_WARNING(logger_, "no payload for " << target);
+				stream_parser_.reset();
+				return queue_(send_bad_request(header.version()
+					, false
+					, "content length required"));
+			}
+
+			payload_size_ = *content_length;
+			CYNG_LOG_INFO(logger_, payload_size_ << " bytes posted to " << target);
+
+			mpp_ = std::unique_ptr<multi_part_parser>(new multi_part_parser([this](cyng::vector_t&& prg) {
+
+				//	executed by HTTP session
+				CYNG_LOG_DEBUG(logger_, cyng::io::to_str(prg));
+				connection_manager_.vm().async_run(std::move(prg));
+
+			}, logger_
+				, payload_size_
+				, target
+				, tag_
+				, spool_threshold_));
+
+			//
+			//	open new upload sequence
+			//
+			connection_manager_.vm().async_run(cyng::generate_invoke("http.upload.start"
+				, tag_
+				, header.version()
+				, std::string(target.begin(), target.end())
+				, payload_size_));
+
+			do_read_chunk();
+		}
+
+		void session::do_read_chunk()
+		{
+			if (shutdown_)  return;
+
+			//	each chunk restarts the timer
+			timer_.expires_after(std::chrono::seconds(15));
+
+			stream_parser_->get().body().data = chunk_.data();
+			stream_parser_->get().body().size = chunk_.size();
+
+			boost::beast::http::async_read(socket_, buffer_, *stream_parser_,
+				boost::asio::bind_executor(
+					strand_,
+					std::bind(
+						&session::on_read_chunk,
+						this,
+						std::placeholders::_1)));
+		}
+
+		void session::on_read_chunk(boost::system::error_code ec)
+		{
+			if (shutdown_)  return;
+
+			//	buffer is full - not an error
+			if (ec == boost::beast::http::error::need_buffer)	ec = {};
+			if (!check_read_error(ec))	return;
+
+			//
+			//	parse payload and generate program sequences
+			//
+			auto const size = chunk_.size() - stream_parser_->get().body().size;
+			mpp_->parse(chunk_.begin(), chunk_.begin() + size);
+
+			if (!stream_parser_->is_done())
+			{
+				return do_read_chunk();
+			}
+
+			//
+			//	upload complete - response is generated by "http.upload.complete"
+			//
+			mpp_.reset();
+			stream_parser_.reset();
+
+			if (!queue_.is_full())
+			{
+				do_read();
+			}
+		}
+
 		void session::handle_request(boost::beast::http::request<boost::beast::http::string_body>&& req)
 		{
 			if (req.method() != boost::beast::http::verb::get &&
@@ -238,9 +437,7 @@ namespace node
 					, "Unknown HTTP-method"));
 			}
 
-			if (req.target().empty() ||
-				req.target()[0] != '/' ||
-				req.target().find("..") != boost::beast::string_view::npos)
+			if (!is_valid_target(req.target()))
 			{
 				return queue_(send_bad_request(req.version()
 					, req.keep_alive()
@@ -336,23 +533,12 @@ namespace node
 				}
 #endif
 
-				// Build the path to the requested file
-				std::string path = path_cat(doc_root_, req.target());
-				if (boost::filesystem::is_directory(path))
-				//if (req.target().back() == '/')
-				{
-					path.append("index.html");
-				}
-
 				//
-				// Attempt to open the file
+				//	Lookup the requested file in the asset cache.
+				//	Directories are resolved to index.html.
 				//
-				boost::beast::error_code ec;
-				boost::beast::http::file_body::value_type body;
-				body.open(path.c_str(), boost::beast::file_mode::scan, ec);
-
-				// Handle the case where the file doesn't exist
-				if (ec == boost::system::errc::no_such_file_or_directory)
+				auto const asset = connection_manager_.assets().get(req.target().to_string());
+				if (!asset)
 				{
 					//
 					//	ToDo: send system message
@@ -366,30 +552,61 @@ namespace node
 						, req.target().to_string()));
 				}
 
-				// Handle an unknown error
-				if (ec)	{
-					return queue_(send_server_error(req.version()
-						, req.keep_alive()
-						, ec));
-				}
+				//
+				//	compressed if supported by client - the gzip variant
+				//	has its own ETag
+				//
+				auto const compressed = asset->gzip_ && accepts_gzip(req[boost::beast::http::field::accept_encoding]);
 
-				// Cache the size since we need it after the move
-				auto const size = body.size();
+				//
+				//	conditional request
+				//
+				if (match_etag(req[boost::beast::http::field::if_none_match], compressed ? asset->etag_gzip_ : asset->etag_))
+				{
+					return queue_(send_not_modified(req.version(), req.keep_alive(), *asset, compressed));
+				}
 
 				if (req.method() == boost::beast::http::verb::head)
 				{
 					// Respond to HEAD request
-					return queue_(send_head(req.version(), req.keep_alive(), path, size));
+					return queue_(send_head(req.version(), req.keep_alive(), *asset, compressed));
 				}
-				else if (req.method() == boost::beast::http::verb::get)
+
+				if (asset->data_)
 				{
-					// Respond to GET request
-					return queue_(send_get(req.version()
+					//
+					//	serve from memory
+					//
+					return queue_(send_asset(req.version(), req.keep_alive(), *asset, compressed));
+				}
+
+				//
+				// Attempt to open the file
+				//
+				boost::beast::error_code ec;
+				boost::beast::http::file_body::value_type body;
+				body.open(asset->path_.c_str(), boost::beast::file_mode::scan, ec);
+
+				// Handle the case where the file doesn't exist
+				if (ec == boost::system::errc::no_such_file_or_directory)
+				{
+					return queue_(send_not_found(req.version()
+						, req.keep_alive()
+						, req.target().to_string()));
+				}
+
+				// Handle an unknown error
+				if (ec)	{
+					return queue_(send_server_error(req.version()
 						, req.keep_alive()
-						, std::move(body)
-						, path
-						, size));
+						, ec));
 				}
+
+				// Respond to GET request
+				return queue_(send_get(req.version()
+					, req.keep_alive()
+					, std::move(body)
+					, *asset));
 			}
 			else if (req.method() == boost::beast::http::verb::post)
 			{
@@ -403,6 +620,9 @@ namespace node
 				CYNG_LOG_INFO(logger_, *req.payload_size() << " bytes posted to " << target);
 				std::uint64_t payload_size = *req.payload_size();
 
+				//
+				//	body is moved into the program - no copy
+				//
 				if (boost::algorithm::equals(content_type, "application/xml"))
 				{
 					connection_manager_.vm().async_run(cyng::generate_invoke("http.post.xml"
@@ -410,7 +630,7 @@ namespace node
 						, req.version()
 						, std::string(target.begin(), target.end())
 						, payload_size
-						, std::string(req.body().begin(), req.body().end())));
+						, std::move(req.body())));
 
 				}
 				//	Content-Type:application/json; charset=UTF-8
@@ -421,7 +641,7 @@ namespace node
 						, req.version()
 						, std::string(target.begin(), target.end())
 						, payload_size
-						, std::string(req.body().begin(), req.body().end())));
+						, std::move(req.body())));
 
 				}
 				else if (boost::algorithm::starts_with(content_type, "application/x-www-form-urlencoded"))
@@ -432,46 +652,10 @@ namespace node
 						, req.version()
 						, std::string(target.begin(), target.end())
 						, payload_size
-						, std::string(req.body().begin(), req.body().end())));
+						, std::move(req.body())));
 
 				}
-				else if (boost::algorithm::starts_with(content_type, "multipart/form-data"))
-				{
-					//
-					//	payload parser
-					//
-					if (req.payload_size()) {
-						CYNG_LOG_INFO(logger_, *req.payload_size() << " bytes posted to " << target);
-						std::uint64_t payload_size = *req.payload_size();
-						multi_part_parser mpp([&](cyng::vector_t&& prg) {
-
-							//	executed by HTTP session
-							CYNG_LOG_DEBUG(logger_, cyng::io::to_str(prg));
-							connection_manager_.vm().async_run(std::move(prg));
-
-						}, logger_
-							, payload_size
-							, target
-							, tag_);
-
-						//
-						//	open new upload sequence
-						//
-						connection_manager_.vm().async_run(cyng::generate_invoke("http.upload.start"
-							, tag_
-							, req.version()
-							, std::string(target.begin(), target.end())
-							, payload_size));
-
-						//
-						//	parse payload and generate program sequences
-						//
-						mpp.parse(req.body().begin(), req.body().end());
-					}
-					else {
-						CYNG_LOG_WARNING(logger_, "no payload for " << target);
-					}
-				}
+				//	multipart/form-data is streamed (see start_upload())
 
 				return;
 			}
@@ -492,6 +676,18 @@ namespace node
 			return res;
 		}
 
+		boost::beast::http::response<boost::beast::http::string_body> session::send_payload_too_large(std::uint32_t version)
+		{
+			CYNG_LOG_WARNING(logger_, "413 - payload too large");
+			boost::beast::http::response<boost::beast::http::string_body> res{ boost::beast::http::status::payload_too_large, version };
+			res.set(boost::beast::http::field::server, NODE::version_string);
+			res.set(boost::beast::http::field::content_type, "text/html");
+			res.keep_alive(false);
+			res.body() = "Payload exceeds " + std::to_string(body_limit_) + " bytes";
+			res.prepare_payload();
+			return res;
+		}
+
 		boost::beast::http::response<boost::beast::http::string_body> session::send_redirect(std::uint32_t version
 			, bool keep_alive
 			, std::string host
@@ -525,29 +721,80 @@ namespace node
 
 		boost::beast::http::response<boost::beast::http::empty_body> session::send_head(std::uint32_t version
 			, bool keep_alive
-			, std::string const& path
-			, std::uint64_t size)
+			, asset_cache::entry const& asset
+			, bool compressed)
 		{
 			boost::beast::http::response<boost::beast::http::empty_body> res{ boost::beast::http::status::ok, version };
 			res.set(boost::beast::http::field::server, NODE::version_string);
-			res.set(boost::beast::http::field::content_type, mime_type(path));
-			res.content_length(size);
+			res.set(boost::beast::http::field::content_type, asset.mime_);
+			res.set(boost::beast::http::field::etag, compressed ? asset.etag_gzip_ : asset.etag_);
+			if (asset.gzip_) {
+				res.set(boost::beast::http::field::vary, "Accept-Encoding");
+			}
+			if (compressed) {
+				res.set(boost::beast::http::field::content_encoding, "gzip");
+			}
+			res.content_length(compressed ? asset.gzip_->size() : asset.size_);
 			res.keep_alive(keep_alive);
 			return res;
 		}
 
+		boost::beast::http::response<boost::beast::http::empty_body> session::send_not_modified(std::uint32_t version
+			, bool keep_alive
+			, asset_cache::entry const& asset
+			, bool compressed)
+		{
+			boost::beast::http::response<boost::beast::http::empty_body> res{ boost::beast::http::status::not_modified, version };
+			res.set(boost::beast::http::field::server, NODE::version_string);
+			res.set(boost::beast::http::field::etag, compressed ? asset.etag_gzip_ : asset.etag_);
+			res.set(boost::beast::http::field::cache_control, "no-cache");
+			if (asset.gzip_) {
+				res.set(boost::beast::http::field::vary, "Accept-Encoding");
+			}
+			res.keep_alive(keep_alive);
+			return res;
+		}
+
+		boost::beast::http::response<asset_body> session::send_asset(std::uint32_t version
+			, bool keep_alive
+			, asset_cache::entry const& asset
+			, bool compressed)
+		{
+			boost::beast::http::response<asset_body> res{
+				std::piecewise_construct,
+				std::make_tuple(compressed ? asset.gzip_ : asset.data_),
+				std::make_tuple(boost::beast::http::status::ok, version) };
+			res.set(boost::beast::http::field::server, NODE::version_string);
+			res.set(boost::beast::http::field::content_type, asset.mime_);
+			res.set(boost::beast::http::field::etag, compressed ? asset.etag_gzip_ : asset.etag_);
+			res.set(boost::beast::http::field::cache_control, "no-cache");
+			if (asset.gzip_) {
+				res.set(boost::beast::http::field::vary, "Accept-Encoding");
+			}
+			if (compressed) {
+				res.set(boost::beast::http::field::content_encoding, "gzip");
+			}
+			res.keep_alive(keep_alive);
+			res.prepare_payload();
+			return res;
+		}
+
 		boost::beast::http::response<boost::beast::http::file_body> session::send_get(std::uint32_t version
 			, bool keep_alive
 			, boost::beast::http::file_body::value_type&& body
-			, std::string const& path
-			, std::uint64_t size)
+			, asset_cache::entry const& asset)
 		{
+			// Cache the size since we need it after the move
+			auto const size = body.size();
+
 			boost::beast::http::response<boost::beast::http::file_body> res{
 				std::piecewise_construct,
 				std::make_tuple(std::move(body)),
 				std::make_tuple(boost::beast::http::status::ok, version) };
 			res.set(boost::beast::http::field::server, NODE::version_string);
-			res.set(boost::beast::http::field::content_type, mime_type(path));
+			res.set(boost::beast::http::field::content_type, asset.mime_);
+			res.set(boost::beast::http::field::etag, asset.etag_);
+			res.set(boost::beast::http::field::cache_control, "no-cache");
 			res.content_length(size);
 			res.keep_alive(keep_alive);
 			return res;
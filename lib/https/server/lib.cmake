@@ -9,6 +9,7 @@ set (https_srv_cpp
 	lib/https/server/src/detector.cpp
 	lib/https/server/src/detect_ssl.hpp
 	lib/https/server/src/connections.cpp
+	lib/https/server/src/tls_session.cpp
 )
 
 set (https_srv_h
@@ -22,6 +23,7 @@ set (https_srv_h
 #	src/main/include/smf/https/srv/handle_request.hpp
 	src/main/include/smf/https/srv/ssl_stream.hpp
 	src/main/include/smf/https/srv/connections.h
+	src/main/include/smf/https/srv/tls_session.h
 )
 
 set (http_parser 
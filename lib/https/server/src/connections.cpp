@@ -20,11 +20,15 @@ namespace node
 		connections::connections(cyng::logging::log_ptr logger
 			, cyng::controller& vm
 			, std::string const& doc_root
-			, auth_dirs const& ad)
+			, auth_dirs const& ad
+			, std::uint64_t body_limit
+			, std::size_t spool_threshold)
 		: logger_(logger)
 			, vm_(vm)
 			, doc_root_(doc_root)
 			, auth_dirs_(ad)
+			, body_limit_(body_limit)
+			, spool_threshold_(spool_threshold)
 			, uidgen_()
 			, sessions_()
 			, mutex_()
@@ -55,7 +59,9 @@ namespace node
 				, ctx
 				, std::move(buffer)
 				, doc_root_
-				, auth_dirs_);
+				, auth_dirs_
+				, body_limit_
+				, spool_threshold_);
 
 			auto sp = const_cast<ssl_session*>(cyng::object_cast<ssl_session>(obj));
 			BOOST_ASSERT(sp != nullptr);
@@ -73,7 +79,9 @@ namespace node
 				, std::move(socket)
 				, std::move(buffer)
 				, doc_root_
-				, auth_dirs_);
+				, auth_dirs_
+				, body_limit_
+				, spool_threshold_);
 
 			auto sp = const_cast<plain_session*>(cyng::object_cast<plain_session>(obj));
 			BOOST_ASSERT(sp != nullptr);
@@ -21,13 +21,15 @@ namespace node
 			, std::string const& doc_root
 			, auth_dirs const& ad
 			, std::set<boost::asio::ip::address> const& blacklist
-			, cyng::controller& vm)
+			, cyng::controller& vm
+			, std::uint64_t body_limit
+			, std::size_t spool_threshold)
 		: std::enable_shared_from_this<server>()
 			, logger_(logger)
 			, ctx_(ctx)
 			, acceptor_(ioc)
 			, socket_(ioc)
-			, connection_manager_(logger, vm, doc_root, ad)
+			, connection_manager_(logger, vm, doc_root, ad, body_limit, spool_threshold)
 			, blacklist_(blacklist)
 			, is_listening_(false)
 			, shutdown_complete_()
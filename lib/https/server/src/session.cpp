@@ -23,8 +23,10 @@ namespace node
 			, boost::asio::ip::tcp::socket socket
 			, boost::beast::flat_buffer buffer
 			, std::string const& doc_root
-			, auth_dirs const& ad)
-		: session<plain_session>(logger, cm, tag, socket.get_executor().context(), std::move(buffer), doc_root, ad)
+			, auth_dirs const& ad
+			, std::uint64_t body_limit
+			, std::size_t spool_threshold)
+		: session<plain_session>(logger, cm, tag, socket.get_executor().context(), std::move(buffer), doc_root, ad, body_limit, spool_threshold)
 			, socket_(std::move(socket))
 			, strand_(socket_.get_executor())
 		{}
@@ -89,8 +91,10 @@ namespace node
 			, boost::asio::ssl::context& ctx
 			, boost::beast::flat_buffer buffer
 			, std::string const& doc_root
-			, auth_dirs const& ad)
-		: session<ssl_session>(logger, cm, tag, socket.get_executor().context(), std::move(buffer), doc_root, ad)
+			, auth_dirs const& ad
+			, std::uint64_t body_limit
+			, std::size_t spool_threshold)
+		: session<ssl_session>(logger, cm, tag, socket.get_executor().context(), std::move(buffer), doc_root, ad, body_limit, spool_threshold)
 			, stream_(std::move(socket), ctx)
 			, strand_(stream_.get_executor())
 		{}
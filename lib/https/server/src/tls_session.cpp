@@ -0,0 +1,249 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#include <smf/https/srv/tls_session.h>
+
+#include <cyng/dom/reader.h>
+#include <cyng/numeric_cast.hpp>
+
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <openssl/ssl.h>
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+#else
+#include <openssl/hmac.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <mutex>
+
+namespace node
+{
+	namespace https
+	{
+		namespace
+		{
+			struct ticket_key
+			{
+				unsigned char name_[16];
+				unsigned char aes_[32];
+				unsigned char hmac_[32];
+				std::chrono::steady_clock::time_point created_;
+			};
+
+			/**
+			 * Owned by the SSL context (ex data)
+			 */
+			struct ticket_keys
+			{
+				ticket_keys(std::chrono::seconds rotation)
+					: mutex_()
+					, rotation_(rotation)
+					, keys_()
+					, valid_(0)
+				{}
+
+				std::mutex mutex_;
+				std::chrono::seconds const rotation_;
+				std::array<ticket_key, 2> keys_;	//!<	[0] current, [1] previous
+				std::size_t valid_;	//!<	number of valid keys
+			};
+
+			bool generate(ticket_key& k)
+			{
+				k.created_ = std::chrono::steady_clock::now();
+				return RAND_bytes(k.name_, sizeof(k.name_)) == 1
+					&& RAND_bytes(k.aes_, sizeof(k.aes_)) == 1
+					&& RAND_bytes(k.hmac_, sizeof(k.hmac_)) == 1
+					;
+			}
+
+			/**
+			 * Requires lock
+			 */
+			bool rotate(ticket_keys& tk)
+			{
+				auto const now = std::chrono::steady_clock::now();
+				if (tk.valid_ != 0 && (now - tk.keys_[0].created_) < tk.rotation_)	return true;
+
+				//
+				//	Rotation is lazy. If the current key is older than two
+				//	intervals it must not be kept as previous key.
+				//
+				if (tk.valid_ != 0 && (now - tk.keys_[0].created_) < (tk.rotation_ * 2)) {
+					tk.keys_[1] = tk.keys_[0];
+					tk.valid_ = tk.keys_.size();
+				}
+				else {
+					tk.valid_ = 1;
+				}
+				return generate(tk.keys_[0]);
+			}
+
+			/**
+			 * HMAC-SHA256 with the specified key
+			 */
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+			bool init_hmac(EVP_MAC_CTX* hctx, ticket_key const& k)
+			{
+				char digest[] = "SHA256";
+				OSSL_PARAM params[] = {
+					OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_KEY, const_cast<unsigned char*>(k.hmac_), sizeof(k.hmac_)),
+					OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, digest, 0),
+					OSSL_PARAM_construct_end()
+				};
+				return EVP_MAC_CTX_set_params(hctx, params) == 1;
+			}
+#else
+			bool init_hmac(HMAC_CTX* hctx, ticket_key const& k)
+			{
+				return HMAC_Init_ex(hctx, k.hmac_, sizeof(k.hmac_), EVP_sha256(), nullptr) == 1;
+			}
+#endif
+
+			void free_keys(void*, void* ptr, CRYPTO_EX_DATA*, int, long, void*)
+			{
+				delete static_cast<ticket_keys*>(ptr);
+			}
+
+			int get_index()
+			{
+				static int const idx = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, &free_keys);
+				return idx;
+			}
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+			using hmac_ctx_t = EVP_MAC_CTX;
+#else
+			using hmac_ctx_t = HMAC_CTX;
+#endif
+
+			int ticket_cb(SSL* ssl
+				, unsigned char* key_name
+				, unsigned char* iv
+				, EVP_CIPHER_CTX* cctx
+				, hmac_ctx_t* hctx
+				, int enc)
+			{
+				auto tk = static_cast<ticket_keys*>(SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), get_index()));
+				if (tk == nullptr)	return -1;
+
+				std::lock_guard<std::mutex> lk(tk->mutex_);
+				if (!rotate(*tk))	return -1;
+
+				if (enc != 0) {
+					//
+					//	issue new ticket with current key
+					//
+					auto const& k = tk->keys_[0];
+					if (RAND_bytes(iv, EVP_CIPHER_iv_length(EVP_aes_256_cbc())) != 1)	return -1;
+					std::memcpy(key_name, k.name_, sizeof(k.name_));
+					if (EVP_EncryptInit_ex(cctx, EVP_aes_256_cbc(), nullptr, k.aes_, iv) != 1)	return -1;
+					if (!init_hmac(hctx, k))	return -1;
+					return 1;
+				}
+
+				auto const now = std::chrono::steady_clock::now();
+				for (std::size_t idx = 0; idx < tk->valid_; ++idx) {
+					auto const& k = tk->keys_[idx];
+					if (std::memcmp(key_name, k.name_, sizeof(k.name_)) == 0) {
+
+						//
+						//	expired
+						//
+						if ((now - k.created_) >= (tk->rotation_ * 2))	return 0;
+
+						if (!init_hmac(hctx, k))	return -1;
+						if (EVP_DecryptInit_ex(cctx, EVP_aes_256_cbc(), nullptr, k.aes_, iv) != 1)	return -1;
+
+						//	renew tickets of the previous key
+						return (idx == 0) ? 1 : 2;
+					}
+				}
+
+				//
+				//	unknown or expired key - full handshake
+				//
+				return 0;
+			}
+		}
+
+		bool enable_session_resumption(boost::asio::ssl::context& ctx
+			, std::string const& id
+			, std::size_t cache_size
+			, std::chrono::seconds timeout
+			, std::chrono::seconds rotation)
+		{
+			SSL_CTX* native = ctx.native_handle();
+
+			//
+			//	session cache
+			//
+			SSL_CTX_set_session_cache_mode(native, SSL_SESS_CACHE_SERVER);
+			SSL_CTX_sess_set_cache_size(native, static_cast<long>(cache_size));
+			SSL_CTX_set_timeout(native, static_cast<long>(timeout.count()));
+
+			auto const sid = id.substr(0, SSL_MAX_SID_CTX_LENGTH);
+			SSL_CTX_set_session_id_context(native
+				, reinterpret_cast<unsigned char const*>(sid.data())
+				, static_cast<unsigned int>(sid.size()));
+
+			//
+			//	session tickets
+			//
+			auto const idx = get_index();
+			if (idx < 0)	return false;
+
+			delete static_cast<ticket_keys*>(SSL_CTX_get_ex_data(native, idx));
+			auto tk = new ticket_keys(rotation);
+			if (SSL_CTX_set_ex_data(native, idx, tk) != 1) {
+				delete tk;
+				return false;
+			}
+
+			{
+				std::lock_guard<std::mutex> lk(tk->mutex_);
+				if (!rotate(*tk))	return false;
+			}
+
+			SSL_CTX_clear_options(native, SSL_OP_NO_TICKET);
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+			return SSL_CTX_set_tlsext_ticket_key_evp_cb(native, &ticket_cb) == 1;
+#else
+			return SSL_CTX_set_tlsext_ticket_key_cb(native, &ticket_cb) == 1;
+#endif
+		}
+
+		void setup_session_resumption(boost::asio::ssl::context& ctx
+			, cyng::logging::log_ptr logger
+			, std::string const& id
+			, cyng::tuple_t const& cfg)
+		{
+			auto const dom = cyng::make_reader(cfg);
+			auto const session_cache = cyng::numeric_cast<std::size_t>(dom.get("tls-session-cache"), 20000u);
+			if (session_cache == 0) {
+				CYNG_LOG_INFO(logger, "TLS session resumption disabled");
+				return;
+			}
+
+			if (enable_session_resumption(ctx
+				, id
+				, session_cache
+				, std::chrono::seconds(cyng::numeric_cast<std::uint32_t>(dom.get("tls-session-timeout"), 7200u))
+				, std::chrono::seconds(cyng::numeric_cast<std::uint32_t>(dom.get("tls-ticket-rotation"), 3600u)))) {
+				CYNG_LOG_INFO(logger, "TLS session resumption enabled - cache size: " << session_cache);
+			}
+			else {
+				CYNG_LOG_WARNING(logger, "TLS session tickets not available");
+			}
+		}
+	}
+}
@@ -7,6 +7,8 @@ set (ipt_bus_cpp
 	lib/ipt/bus/src/bus.cpp
 	lib/ipt/bus/src/generator.cpp
 	lib/ipt/bus/src/config.cpp
+	lib/ipt/bus/src/push_pool.cpp
+	lib/ipt/bus/src/push_reassembly.cpp
 )
 
 set (ipt_bus_h
@@ -15,6 +17,8 @@ set (ipt_bus_h
 	src/main/include/smf/ipt/bus.h
 	src/main/include/smf/ipt/generator.h
 	src/main/include/smf/ipt/config.h
+	src/main/include/smf/ipt/push_pool.h
+	src/main/include/smf/ipt/push_reassembly.h
 )
 
 if(${PROJECT_NAME}_SSL_SUPPORT)
@@ -31,6 +35,8 @@ set (ipt_bus_tasks
 	lib/ipt/bus/src/tasks/register_target.cpp
 	lib/ipt/bus/src/tasks/watchdog.h
 	lib/ipt/bus/src/tasks/watchdog.cpp
+	lib/ipt/bus/src/tasks/push_pool_monitor.h
+	lib/ipt/bus/src/tasks/push_pool_monitor.cpp
 )
 
 source_group("tasks" FILES ${ipt_bus_tasks})
@@ -19,6 +19,7 @@
 #include <cyng/async/task/task_builder.hpp>
 #include <boost/uuid/nil_generator.hpp>
 #include <boost/uuid/uuid_io.hpp>
+#include <boost/asio/post.hpp>
 #ifdef SMF_IO_DEBUG
 #include <cyng/io/hex_dump.hpp>
 #include <fstream>
@@ -27,6 +28,7 @@
 #include "tasks/close_connection.h"
 #include "tasks/register_target.h"
 #include "tasks/watchdog.h"
+#include "tasks/push_pool_monitor.h"
 
 namespace node
 {
@@ -54,8 +56,14 @@ namespace node
 			, model_(model)
 			, retries_((retries == 0) ? 1 : retries)
 			, watchdog_(0u)
+			, redirect_()
 			, state_(STATE_INITIAL_)
+			, throttled_(false)
+			, read_suspended_(false)
 			, task_db_()
+			, pool_(push_pool_idle_timeout, push_pool_max_retries)
+			, tsk_pool_(cyng::async::NO_TASK)
+			, reassembly_(push_pool_max_window)
 		{
 			if (scramble_key::default_scramble_key_ != sk.key()) {
 				CYNG_LOG_WARNING(logger_, "using a non-default scramble key ");
@@ -117,7 +125,7 @@ namespace node
 			vm_.register_function("ipt.req.deregister.push.target", 3, std::bind(&bus::ipt_req_deregister_push_target, this, std::placeholders::_1));
 			vm_.register_function("ipt.res.open.push.channel", 8, std::bind(&bus::ipt_res_open_channel, this, std::placeholders::_1));
 			vm_.register_function("ipt.res.close.push.channel", 4, std::bind(&bus::ipt_res_close_channel, this, std::placeholders::_1));
-			vm_.register_function("ipt.res.transfer.pushdata", 0, std::bind(&bus::ipt_res_transfer_push_data, this, std::placeholders::_1));
+			vm_.register_function("ipt.res.transfer.pushdata", 7, std::bind(&bus::ipt_res_transfer_push_data, this, std::placeholders::_1));
 			vm_.register_function("ipt.req.transmit.data", 1, std::bind(&bus::ipt_req_transmit_data, this, std::placeholders::_1));
 			vm_.register_function("ipt.req.open.connection", 1, std::bind(&bus::ipt_req_open_connection, this, std::placeholders::_1));
 			vm_.register_function("ipt.res.open.connection", 2, std::bind(&bus::ipt_res_open_connection, this, std::placeholders::_1));
@@ -136,6 +144,15 @@ namespace node
 			vm_.register_function("bus.store.relation", 2, std::bind(&bus::store_relation, this, std::placeholders::_1));
 			vm_.register_function("bus.remove.relation", 1, std::bind(&bus::remove_relation, this, std::placeholders::_1));
 
+			//
+			//	push channel pool
+			//
+			vm_.register_function("bus.req.push.data", 3, std::bind(&bus::pool_push_data, this, std::placeholders::_1));
+			vm_.register_function("bus.pool.track.open", 2, std::bind(&bus::pool_track_open, this, std::placeholders::_1));
+			vm_.register_function("bus.pool.track.transfer", 2, std::bind(&bus::pool_track_transfer, this, std::placeholders::_1));
+			vm_.register_function("bus.pool.expire", 0, std::bind(&bus::pool_expire, this, std::placeholders::_1));
+			vm_.register_function("bus.pool.clear", 0, std::bind(&bus::pool_clear, this, std::placeholders::_1));
+
 			//
 			//	statistical data
 			//
@@ -147,6 +164,7 @@ namespace node
 		{
 			CYNG_LOG_TRACE(logger_, "start ipt client");
 			transition(STATE_INITIAL_);
+			read_suspended_ = false;
             do_read();
 		}
 
@@ -173,7 +191,8 @@ namespace node
 				for (auto const& tsk : task_db_) {
 					mux_.stop(tsk.second);
 				}
-				
+				stop_pool_monitor();
+
 
 				//
 				//  close socket
@@ -234,6 +253,19 @@ namespace node
 			return socket_.remote_endpoint();
 		}
 
+		void bus::throttle(bool on)
+		{
+			if (throttled_.exchange(on) == on)	return;
+
+			CYNG_LOG_WARNING(logger_, vm_.tag()
+				<< (on ? " suspends" : " continues")
+				<< " reading from master");
+
+			if (!on && read_suspended_.exchange(false)) {
+				boost::asio::post(mux_.get_io_service(), std::bind(&bus::do_read, this));
+			}
+		}
+
 		void bus::do_read()
 		{
             //
@@ -241,6 +273,15 @@ namespace node
             //
             if (STATE_SHUTDOWN_ == state_.load())  return;
 
+			//
+			//	Suspend reading. Who ever resets the suspended flag
+			//	first continues reading.
+			//
+			if (throttled_.load()) {
+				read_suspended_ = true;
+				if (throttled_.load() || !read_suspended_.exchange(false))	return;
+			}
+
 			//auto self(shared_from_this());
 			BOOST_ASSERT(socket_.is_open());
 			socket_.async_read_some(boost::asio::buffer(buffer_),
@@ -270,6 +311,13 @@ namespace node
 					//	slot [1] - go offline
 					//
 					mux_.stop("node::watchdog");
+
+					//
+					//	all push channels are lost
+					//
+					stop_pool_monitor();
+					vm_.async_run(cyng::generate_invoke("bus.pool.clear"));
+
 					on_logout();
 				}
 				else
@@ -321,6 +369,7 @@ namespace node
 				//	update bus state
 				//
 				state_ = STATE_AUTHORIZED_;
+				redirect_.clear();
 
 				ctx.queue(cyng::generate_invoke("log.msg.info"
 					, "successful authorized"
@@ -340,12 +389,28 @@ namespace node
 					cyng::async::start_task_sync<watchdog>(mux_, logger_, vm_, watchdog_);
 
 				}
+
+				//
+				//	close idle push channels
+				//
+				stop_pool_monitor();
+				tsk_pool_ = cyng::async::start_task_delayed<push_pool_monitor>(mux_
+					, push_pool_idle_timeout
+					, logger_
+					, vm_
+					, push_pool_idle_timeout).first;
+
 				on_login_response(watchdog_, redirect);
 			}
 			else	{
 				state_ = STATE_ERROR_;
 				watchdog_ = 0u;
                 ctx.queue(cyng::generate_invoke("log.msg.warning", "login failed"));
+				if (!redirect.empty()) {
+					//	sharded cluster - the host reconnects to this address
+					ctx.queue(cyng::generate_invoke("log.msg.warning", "redirected to", redirect));
+				}
+				redirect_ = redirect;
 
 				//
 				//	slot [1]
@@ -519,6 +584,34 @@ namespace node
 				, frame.at(4)
 				, tp_res_open_push_channel_policy::get_response_name(res)));
 
+			//
+			//	channels opened by the pool are not reported
+			//
+			std::string target;
+			if (pool_.opened(std::get<1>(tpl)
+				, tp_res_open_push_channel_policy::is_success(res)
+				, std::get<3>(tpl)
+				, std::get<4>(tpl)
+				, std::get<5>(tpl)
+				, std::get<6>(tpl)
+				, target)) {
+
+				pool_results();
+				if (tp_res_open_push_channel_policy::is_success(res)) {
+
+					//
+					//	send queued data
+					//
+					pool_drain(ctx, target);
+				}
+				else {
+					ctx.queue(cyng::generate_invoke("log.msg.warning"
+						, "open push channel failed - data dropped"
+						, target));
+				}
+				return;
+			}
+
 			//
 			//	* [u8] seq
 			//	* [u8] res
@@ -576,9 +669,39 @@ namespace node
 			const cyng::vector_t frame = ctx.get_frame();
 			ctx.queue(cyng::generate_invoke("log.msg.trace", "ipt.res.transfer.pushdata", frame));
 
-			//
-			//	ToDo: forward to client
-			//
+			auto const tpl = cyng::tuple_cast<
+				boost::uuids::uuid,	//	[0] session tag
+				sequence_type,		//	[1] ipt seq
+				response_type,		//	[2] ipt response
+				std::uint32_t,		//	[3] channel
+				std::uint32_t,		//	[4] source
+				std::uint8_t,		//	[5] status
+				std::uint8_t		//	[6] block
+			>(frame);
+
+			auto const success = tp_res_pushdata_transfer_policy::is_success(std::get<2>(tpl));
+
+			std::string target;
+			if (pool_.transferred(std::get<1>(tpl), success, target)) {
+
+				pool_results();
+				push_pool::channel ch;
+				if (!success && push_pool::POOL_CLOSED == pool_.get_status(target, ch)) {
+					ctx.queue(cyng::generate_invoke("log.msg.error", "push data transfer failed - data dropped", target));
+					ctx.queue(cyng::generate_invoke("req.close.push.channel", std::get<3>(tpl)));
+					ctx.queue(cyng::generate_invoke("stream.flush"));
+				}
+				else {
+					if (!success) {
+						ctx.queue(cyng::generate_invoke("log.msg.warning", "push data transfer failed - resend block", target, std::get<6>(tpl)));
+					}
+
+					//
+					//	window has space for another block (or the failed one)
+					//
+					pool_drain(ctx, target);
+				}
+			}
 		}
 
 		void bus::ipt_req_transmit_data(cyng::context& ctx)
@@ -947,16 +1070,27 @@ namespace node
 				of.write(std::get<6>(tpl).data(), std::get<6>(tpl).size());
 			}
 #endif
+			//
+			//	reassemble segmented payloads
+			//
+			auto const payloads = reassembly_.put(std::get<2>(tpl)
+				, std::get<3>(tpl)
+				, std::get<4>(tpl)
+				, std::get<5>(tpl)
+				, std::get<6>(tpl));
+
 			// 
 			//	* [u8] seq
 			//	* [u32] channel
 			//	* [u32] source
 			//	* [buffer] data
 			//
-			on_req_transfer_push_data(std::get<1>(tpl) //	seq
-				, std::get<2>(tpl)		//	channel
-				, std::get<3>(tpl)		//	source
-				, std::get<6>(tpl));	//	data
+			for (auto const& data : payloads) {
+				on_req_transfer_push_data(std::get<1>(tpl) //	seq
+					, std::get<2>(tpl)		//	channel
+					, std::get<3>(tpl)		//	source
+					, data);	//	data
+			}
 		}
 
 		bool bus::req_login(master_record const& rec)
@@ -1136,6 +1270,147 @@ namespace node
 			}
 		}
 
+		void bus::req_transfer_push_data(std::string const& target, cyng::buffer_t const& data, std::size_t tsk)
+		{
+			vm_.async_run(cyng::generate_invoke("bus.req.push.data", target, data, tsk));
+		}
+
+		void bus::pool_push_data(cyng::context& ctx)
+		{
+			const cyng::vector_t frame = ctx.get_frame();
+			auto const tpl = cyng::tuple_cast<
+				std::string,		//	[0] target
+				cyng::buffer_t,		//	[1] data
+				std::size_t			//	[2] task
+			>(frame);
+
+			if (!is_online()) {
+				ctx.queue(cyng::generate_invoke("log.msg.warning", "bus.req.push.data - not authorized", std::get<0>(tpl), get_state()));
+				if (std::get<2>(tpl) != cyng::async::NO_TASK) {
+					mux_.post(std::get<2>(tpl), 1, cyng::tuple_factory(false, std::get<0>(tpl)));
+				}
+				return;
+			}
+
+			push_pool::channel ch;
+			switch (pool_.get_status(std::get<0>(tpl), ch)) {
+			case push_pool::POOL_OPEN:
+				pool_.enqueue(std::get<0>(tpl), std::get<1>(tpl), std::get<2>(tpl));
+				pool_drain(ctx, std::get<0>(tpl));
+				break;
+			case push_pool::POOL_OPENING:
+				pool_.enqueue(std::get<0>(tpl), std::get<1>(tpl), std::get<2>(tpl));
+				break;
+			default:
+				pool_.enqueue(std::get<0>(tpl), std::get<1>(tpl), std::get<2>(tpl));
+				pool_open(ctx, std::get<0>(tpl));
+				break;
+			}
+		}
+
+		void bus::pool_track_open(cyng::context& ctx)
+		{
+			const cyng::vector_t frame = ctx.get_frame();
+			auto const tpl = cyng::tuple_cast<
+				sequence_type,		//	[0] ipt seq
+				std::string			//	[1] target
+			>(frame);
+
+			pool_.track_open(std::get<0>(tpl), std::get<1>(tpl));
+		}
+
+		void bus::pool_track_transfer(cyng::context& ctx)
+		{
+			const cyng::vector_t frame = ctx.get_frame();
+			auto const tpl = cyng::tuple_cast<
+				sequence_type,		//	[0] ipt seq
+				std::string			//	[1] target
+			>(frame);
+
+			pool_.track_transfer(std::get<0>(tpl), std::get<1>(tpl));
+		}
+
+		void bus::pool_expire(cyng::context& ctx)
+		{
+			auto const now = std::chrono::steady_clock::now();
+
+			//
+			//	incoming payloads of closed channels
+			//
+			auto const count = reassembly_.expire(now, push_pool_idle_timeout);
+			if (count != 0) {
+				ctx.queue(cyng::generate_invoke("log.msg.warning", "incomplete push data dropped", count));
+			}
+
+			auto const channels = pool_.expire(now);
+			for (auto const& ch : channels) {
+				ctx.queue(cyng::generate_invoke("log.msg.debug", "close idle push channel", ch.channel_, ch.source_));
+				ctx.queue(cyng::generate_invoke("req.close.push.channel", ch.channel_));
+			}
+			if (!channels.empty()) {
+				ctx.queue(cyng::generate_invoke("stream.flush"));
+			}
+		}
+
+		void bus::pool_clear(cyng::context& ctx)
+		{
+			auto const channels = pool_.clear();
+			pool_results();
+			reassembly_.clear();
+			if (!channels.empty()) {
+				ctx.queue(cyng::generate_invoke("log.msg.debug", "push channels lost", channels.size()));
+			}
+		}
+
+		void bus::pool_results()
+		{
+			for (auto const& r : pool_.get_results()) {
+				if (r.tsk_ != cyng::async::NO_TASK) {
+					mux_.post(r.tsk_, 1, cyng::tuple_factory(r.success_, r.target_));
+				}
+			}
+		}
+
+		void bus::pool_open(cyng::context& ctx, std::string const& target)
+		{
+			ctx.queue(cyng::generate_invoke("req.open.push.channel", target, "", "", "", "", 0));
+			ctx.queue(cyng::generate_invoke("bus.pool.track.open", cyng::invoke("ipt.seq.push"), target));
+			ctx.queue(cyng::generate_invoke("stream.flush"));
+		}
+
+		void bus::pool_drain(cyng::context& ctx, std::string const& target)
+		{
+			push_pool::channel ch;
+			push_pool::segment seg;
+			bool flush{ false };
+			while (pool_.next(target, ch, seg)) {
+				ctx.queue(cyng::generate_invoke("req.transfer.push.data"
+					, ch.channel_
+					, ch.source_
+					, seg.status_
+					, seg.block_
+					, seg.data_));
+				ctx.queue(cyng::generate_invoke("bus.pool.track.transfer", cyng::invoke("ipt.seq.push"), target));
+				flush = true;
+			}
+			if (flush) {
+				ctx.queue(cyng::generate_invoke("stream.flush"));
+			}
+		}
+
+		void bus::stop_pool_monitor()
+		{
+			auto const tsk = tsk_pool_.exchange(cyng::async::NO_TASK);
+			if (tsk != cyng::async::NO_TASK) {
+				mux_.stop(tsk);
+			}
+		}
+
+		std::string const& bus::get_redirect() const
+		{
+			return redirect_;
+		}
+
 		std::string bus::get_state() const
 		{
 			switch (state_) {
@@ -54,6 +54,7 @@ namespace node
 			, model_(model)
 			, retries_((retries == 0) ? 1 : retries)
 			, watchdog_(0)
+			, redirect_()
 			, state_(STATE_INITIAL_)
 			, task_db_()
 		{
@@ -321,6 +322,7 @@ namespace node
 				//	update bus_tls state
 				//
 				state_ = STATE_AUTHORIZED_;
+				redirect_.clear();
 
 				ctx.queue(cyng::generate_invoke("log.msg.info"
 					, "successful authorized"
@@ -346,6 +348,11 @@ namespace node
 				state_ = STATE_ERROR_;
 				watchdog_ = 0u;
                 ctx.queue(cyng::generate_invoke("log.msg.warning", "login failed"));
+				if (!redirect.empty()) {
+					//	sharded cluster - the host reconnects to this address
+					ctx.queue(cyng::generate_invoke("log.msg.warning", "redirected to", redirect));
+				}
+				redirect_ = redirect;
 
 				//
 				//	slot [1]
@@ -1138,6 +1145,11 @@ namespace node
 			}
 		}
 
+		std::string const& bus_tls::get_redirect() const
+		{
+			return redirect_;
+		}
+
 		std::string bus_tls::get_state() const
 		{
 			switch (state_) {
@@ -67,6 +67,7 @@ namespace node
 		redundancy::redundancy(master_config_t const& cfg)
 			: config_(cfg)
 			, master_(0)
+			, redirect_()
 		{
 			BOOST_ASSERT(!config_.empty());
 		}
@@ -74,11 +75,13 @@ namespace node
 		redundancy::redundancy(redundancy const& other)
 			: config_(other.config_)
 			, master_(other.master_)
+			, redirect_(other.redirect_)
 		{}
 
 
 		bool redundancy::next() const
 		{
+			redirect_.reset();
 			if (!config_.empty())
 			{
 				master_++;
@@ -91,9 +94,31 @@ namespace node
 			return false;
 		}
 
+		bool redundancy::redirect(std::string const& address) const
+		{
+			//
+			//	host:port - IPv6 addresses contain colons too
+			//
+			auto const pos = address.rfind(':');
+			if (pos == std::string::npos || pos == 0 || pos + 1 == address.size())	return false;
+
+			auto const& rec = config_.at(master_);
+			redirect_ = std::make_shared<master_record const>(address.substr(0, pos)
+				, address.substr(pos + 1)
+				, rec.account_
+				, rec.pwd_
+				, rec.sk_
+				, rec.scrambled_
+				, static_cast<int>(rec.monitor_.count()));
+			return true;
+		}
+
 		master_record const& redundancy::get() const
 		{
-			return config_.at(master_);
+			return (redirect_)
+				? *redirect_
+				: config_.at(master_)
+				;
 		}
 
 		std::string redundancy::get_address() const
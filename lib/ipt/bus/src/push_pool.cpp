@@ -0,0 +1,298 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#include <smf/ipt/push_pool.h>
+#include <smf/ipt/response.hpp>
+
+#include <algorithm>
+
+namespace node
+{
+	namespace ipt
+	{
+		namespace
+		{
+			/**
+			 * header, channel, source, status, block and length field
+			 * of a transfer request.
+			 */
+			constexpr std::size_t block_overhead = HEADER_SIZE + 4 + 4 + 1 + 1 + 4;
+
+			/**
+			 * Smallest packet size accepted by the master.
+			 */
+			constexpr std::size_t min_packet_size = 0x100;
+		}
+
+		push_pool::push_pool(std::chrono::seconds idle_timeout, std::size_t max_retries)
+			: idle_timeout_(idle_timeout)
+			, max_retries_(max_retries)
+			, targets_()
+			, open_requests_()
+			, transfers_()
+			, results_()
+		{}
+
+		push_pool::status push_pool::get_status(std::string const& target, channel& ch) const
+		{
+			auto pos = targets_.find(target);
+			if (pos == targets_.end())	return POOL_CLOSED;
+
+			if (pos->second.status_ == POOL_OPEN) {
+				ch = pos->second.channel_;
+			}
+			return pos->second.status_;
+		}
+
+		void push_pool::enqueue(std::string const& target, cyng::buffer_t const& data, std::size_t tsk)
+		{
+			auto& e = targets_[target];
+			if (e.status_ == POOL_CLOSED) {
+				e.status_ = POOL_OPENING;
+			}
+			e.pending_.push_back(payload{ data, 0u, 0u, tsk });
+		}
+
+		void push_pool::track_open(sequence_type seq, std::string const& target)
+		{
+			open_requests_[seq] = target;
+		}
+
+		bool push_pool::opened(sequence_type seq
+			, bool success
+			, std::uint32_t channel
+			, std::uint32_t source
+			, std::uint16_t packet_size
+			, std::uint8_t window_size
+			, std::string& target)
+		{
+			auto req = open_requests_.find(seq);
+			if (req == open_requests_.end())	return false;
+
+			target = req->second;
+			open_requests_.erase(req);
+
+			auto pos = targets_.find(target);
+			if (pos == targets_.end())	return true;
+
+			if (success) {
+				auto& e = pos->second;
+				e.status_ = POOL_OPEN;
+				e.channel_.channel_ = channel;
+				e.channel_.source_ = source;
+				e.last_use_ = std::chrono::steady_clock::now();
+				e.block_size_ = std::max<std::size_t>(packet_size, min_packet_size) - block_overhead;
+				e.window_ = std::min<std::size_t>(std::max<std::size_t>(window_size, 1u), push_pool_max_window);
+				e.block_ = 0;
+			}
+			else {
+				//
+				//	target not available - drop data
+				//
+				remove(pos);
+			}
+			return true;
+		}
+
+		bool push_pool::next(std::string const& target, channel& ch, segment& seg)
+		{
+			auto pos = targets_.find(target);
+			if (pos == targets_.end())	return false;
+
+			auto& e = pos->second;
+			if (e.status_ != POOL_OPEN || e.in_flight_ >= e.window_)	return false;
+
+			if (!e.resend_.empty()) {
+
+				//
+				//	retransmit failed block unchanged
+				//
+				seg = e.resend_.front().seg_;
+				e.sent_.push_back(std::move(e.resend_.front()));
+				e.resend_.pop_front();
+			}
+			else {
+				if (e.cut_ >= e.pending_.size())	return false;
+
+				//
+				//	cut next block from first payload with unsent data
+				//
+				auto& p = e.pending_.at(e.cut_);
+				auto const size = std::min(e.block_size_, p.data_.size() - p.offset_);
+
+				seg.status_ = tp_res_pushdata_transfer_policy::PRIO_NORMAL;
+				seg.status_ |= (p.offset_ == 0)
+					? tp_res_pushdata_transfer_policy::SYN
+					: tp_res_pushdata_transfer_policy::ACK
+					;
+				if (p.offset_ + size == p.data_.size())	seg.status_ |= tp_res_pushdata_transfer_policy::FIN;
+				seg.block_ = e.block_++;
+				seg.data_.assign(p.data_.begin() + p.offset_, p.data_.begin() + p.offset_ + size);
+
+				p.offset_ += size;
+				++p.unconfirmed_;
+				e.sent_.push_back(flight{ e.first_ + e.cut_, seg, 0u });
+				if (p.offset_ == p.data_.size()) {
+					++e.cut_;
+				}
+			}
+
+			ch = e.channel_;
+			++e.in_flight_;
+			e.last_use_ = std::chrono::steady_clock::now();
+			return true;
+		}
+
+		void push_pool::track_transfer(sequence_type seq, std::string const& target)
+		{
+			auto pos = targets_.find(target);
+			if (pos != targets_.end() && !pos->second.sent_.empty()) {
+				transfers_.emplace(seq, std::make_pair(target, std::move(pos->second.sent_.front())));
+				pos->second.sent_.pop_front();
+			}
+		}
+
+		bool push_pool::transferred(sequence_type seq
+			, bool success
+			, std::string& target)
+		{
+			auto req = transfers_.find(seq);
+			if (req == transfers_.end())	return false;
+
+			target = req->second.first;
+			auto f = std::move(req->second.second);
+			transfers_.erase(req);
+
+			auto pos = targets_.find(target);
+			if (pos == targets_.end())	return true;
+
+			auto& e = pos->second;
+			--e.in_flight_;
+			e.last_use_ = std::chrono::steady_clock::now();
+
+			if (success) {
+				auto const idx = static_cast<std::size_t>(f.serial_ - e.first_);
+				if (idx < e.pending_.size() && e.pending_.at(idx).unconfirmed_ != 0) {
+					--e.pending_.at(idx).unconfirmed_;
+				}
+
+				//
+				//	remove payloads that are sent and confirmed completely
+				//
+				while (e.cut_ != 0 && e.pending_.front().unconfirmed_ == 0) {
+					results_.push_back(result{ e.pending_.front().tsk_, target, true });
+					e.pending_.pop_front();
+					--e.cut_;
+					++e.first_;
+				}
+			}
+			else if (++f.retries_ > max_retries_) {
+				//
+				//	give up
+				//
+				remove(pos);
+			}
+			else {
+				//
+				//	send this block again - the channel stays open
+				//
+				e.resend_.push_back(std::move(f));
+			}
+			return true;
+		}
+
+		std::vector<push_pool::channel> push_pool::expire(std::chrono::steady_clock::time_point now)
+		{
+			std::vector<channel> r;
+			for (auto pos = targets_.begin(); pos != targets_.end(); ) {
+				auto const& e = pos->second;
+				if (e.status_ == POOL_OPEN
+					&& e.pending_.empty()
+					&& e.in_flight_ == 0
+					&& (now - e.last_use_) > idle_timeout_) {
+					r.push_back(e.channel_);
+					pos = targets_.erase(pos);
+				}
+				else {
+					++pos;
+				}
+			}
+			return r;
+		}
+
+		std::vector<push_pool::channel> push_pool::clear()
+		{
+			std::vector<channel> r;
+			for (auto const& t : targets_) {
+				if (t.second.status_ == POOL_OPEN) {
+					r.push_back(t.second.channel_);
+				}
+				drop(t.first, t.second);
+			}
+			targets_.clear();
+			open_requests_.clear();
+			transfers_.clear();
+			return r;
+		}
+
+		std::size_t push_pool::size() const
+		{
+			return targets_.size();
+		}
+
+		std::vector<push_pool::result> push_pool::get_results()
+		{
+			std::vector<result> r;
+			r.swap(results_);
+			return r;
+		}
+
+		void push_pool::remove(std::map<std::string, entry>::iterator pos)
+		{
+			//
+			//	responses of the removed channel are ignored
+			//
+			forget(pos->first);
+			drop(pos->first, pos->second);
+			targets_.erase(pos);
+		}
+
+		void push_pool::drop(std::string const& target, entry const& e)
+		{
+			for (auto const& p : e.pending_) {
+				results_.push_back(result{ p.tsk_, target, false });
+			}
+		}
+
+		void push_pool::forget(std::string const& target)
+		{
+			for (auto it = transfers_.begin(); it != transfers_.end(); ) {
+				if (it->second.first == target) {
+					it = transfers_.erase(it);
+				}
+				else {
+					++it;
+				}
+			}
+		}
+
+		push_pool::entry::entry()
+			: status_(POOL_CLOSED)
+			, channel_{ 0u, 0u }
+			, last_use_(std::chrono::steady_clock::now())
+			, block_size_(0)
+			, window_(1)
+			, block_(0)
+			, in_flight_(0)
+			, pending_()
+			, cut_(0)
+			, first_(0)
+			, sent_()
+			, resend_()
+		{}
+	}
+}
@@ -0,0 +1,169 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#include <smf/ipt/push_reassembly.h>
+#include <smf/ipt/response.hpp>
+
+namespace node
+{
+	namespace ipt
+	{
+		namespace
+		{
+			/**
+			 * Blocks more than half of the number range behind the
+			 * expected block are considered as already received.
+			 */
+			bool is_behind(std::uint8_t block, std::uint8_t expected)
+			{
+				return static_cast<std::uint8_t>(block - expected) >= 0x80;
+			}
+		}
+
+		push_reassembly::push_reassembly(std::size_t max_parked)
+			: max_parked_(max_parked)
+			, streams_()
+		{}
+
+		std::vector<cyng::buffer_t> push_reassembly::put(std::uint32_t channel
+			, std::uint32_t source
+			, std::uint8_t status
+			, std::uint8_t block
+			, cyng::buffer_t const& data)
+		{
+			std::vector<cyng::buffer_t> r;
+			auto const key = std::make_pair(channel, source);
+			bool const syn = (status & tp_res_pushdata_transfer_policy::SYN) != 0;
+
+			auto pos = streams_.find(key);
+			if (pos == streams_.end()) {
+				if (!syn) {
+					//
+					//	sender without segmentation
+					//
+					r.push_back(data);
+					return r;
+				}
+				pos = streams_.emplace(key, stream(block)).first;
+			}
+
+			auto& s = pos->second;
+			s.last_use_ = std::chrono::steady_clock::now();
+
+			if (syn && !s.partial_ && is_behind(block, s.expected_)) {
+
+				//
+				//	new sequence - drop all blocks before
+				//
+				s.expected_ = block;
+				for (auto idx = s.parked_.begin(); idx != s.parked_.end(); ) {
+					if (is_behind(idx->first, block)) {
+						idx = s.parked_.erase(idx);
+					}
+					else {
+						++idx;
+					}
+				}
+			}
+
+			if (is_behind(block, s.expected_)) {
+				//	duplicate
+				return r;
+			}
+
+			if (block != s.expected_) {
+				//
+				//	wait for the missing blocks
+				//
+				if (s.parked_.size() < max_parked_) {
+					s.parked_.emplace(block, std::make_pair(status, data));
+				}
+				else {
+					streams_.erase(pos);
+				}
+				return r;
+			}
+
+			append(s, status, data, r);
+
+			//
+			//	parked blocks that are in order now
+			//
+			for (auto idx = s.parked_.find(s.expected_); idx != s.parked_.end(); idx = s.parked_.find(s.expected_)) {
+				auto const tmp = std::move(idx->second);
+				s.parked_.erase(idx);
+				append(s, tmp.first, tmp.second, r);
+			}
+
+			if (!s.partial_ && s.parked_.empty()) {
+				//	nothing pending
+				streams_.erase(pos);
+			}
+
+			return r;
+		}
+
+		void push_reassembly::append(stream& s
+			, std::uint8_t status
+			, cyng::buffer_t const& data
+			, std::vector<cyng::buffer_t>& r)
+		{
+			++s.expected_;
+
+			if ((status & tp_res_pushdata_transfer_policy::SYN) != 0) {
+				//	an incomplete payload is dropped
+				s.payload_.clear();
+				s.partial_ = true;
+			}
+			else if (!s.partial_) {
+				//	tail of a dropped payload
+				return;
+			}
+
+			s.payload_.insert(s.payload_.end(), data.begin(), data.end());
+
+			if ((status & tp_res_pushdata_transfer_policy::FIN) != 0) {
+				r.push_back(std::move(s.payload_));
+				s.payload_.clear();
+				s.partial_ = false;
+			}
+		}
+
+		std::size_t push_reassembly::expire(std::chrono::steady_clock::time_point now, std::chrono::seconds timeout)
+		{
+			std::size_t count{ 0 };
+			for (auto pos = streams_.begin(); pos != streams_.end(); ) {
+				if ((now - pos->second.last_use_) > timeout) {
+					pos = streams_.erase(pos);
+					++count;
+				}
+				else {
+					++pos;
+				}
+			}
+			return count;
+		}
+
+		void push_reassembly::clear()
+		{
+			streams_.clear();
+		}
+
+		std::size_t push_reassembly::size() const
+		{
+			return streams_.size();
+		}
+
+		push_reassembly::stream::stream(std::uint8_t block)
+			: expected_(block)
+			, partial_(false)
+			, payload_()
+			, parked_()
+			, last_use_(std::chrono::steady_clock::now())
+		{}
+	}
+}
@@ -0,0 +1,55 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#include "push_pool_monitor.h"
+#include <cyng/vm/generator.h>
+
+namespace node
+{
+	push_pool_monitor::push_pool_monitor(cyng::async::base_task* btp
+		, cyng::logging::log_ptr logger
+		, cyng::controller& vm
+		, std::chrono::seconds interval)
+	: base_(*btp)
+		, logger_(logger)
+		, vm_(vm)
+		, interval_(interval)
+	{
+		CYNG_LOG_INFO(logger_, "task #"
+			<< base_.get_id()
+			<< ':'
+			<< vm_.tag()
+			<< " <"
+			<< base_.get_class_name()
+			<< "> with "
+			<< interval_.count()
+			<< " seconds");
+	}
+
+	cyng::continuation push_pool_monitor::run()
+	{
+		//
+		//	re/start monitor
+		//
+		base_.suspend(interval_);
+
+		//
+		//	close idle push channels
+		//
+		vm_.async_run(cyng::generate_invoke("bus.pool.expire"));
+		return cyng::continuation::TASK_CONTINUE;
+	}
+
+	void push_pool_monitor::stop()
+	{
+		CYNG_LOG_INFO(logger_, "task #"
+			<< base_.get_id()
+			<< " <"
+			<< base_.get_class_name()
+			<< "> is stopped");
+	}
+}
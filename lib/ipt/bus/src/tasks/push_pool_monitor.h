@@ -0,0 +1,42 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#ifndef NODE_IPT_BUS_TASK_PUSH_POOL_MONITOR_H
+#define NODE_IPT_BUS_TASK_PUSH_POOL_MONITOR_H
+
+#include <cyng/async/mux.h>
+#include <cyng/log.h>
+#include <cyng/vm/controller.h>
+
+namespace node
+{
+	/**
+	 * Periodically closes idle push channels of the bus
+	 */
+	class push_pool_monitor
+	{
+	public:
+		using signatures_t = std::tuple<>;
+
+	public:
+		push_pool_monitor(cyng::async::base_task* bt
+			, cyng::logging::log_ptr
+			, cyng::controller& vm
+			, std::chrono::seconds interval);
+		cyng::continuation run();
+		void stop();
+
+	private:
+		cyng::async::base_task& base_;
+		cyng::logging::log_ptr logger_;
+		cyng::controller& vm_;	//!< ipt device
+		const std::chrono::seconds interval_;
+	};
+
+}
+
+#endif
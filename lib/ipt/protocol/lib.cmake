@@ -8,6 +8,7 @@ set (ipt_protocol_cpp
 	lib/ipt/protocol/src/response.cpp
 	lib/ipt/protocol/src/scramble_key.cpp
 	lib/ipt/protocol/src/scramble_key_format.cpp
+	lib/ipt/protocol/src/scrambler.cpp
 	lib/ipt/protocol/src/parser.cpp
 	lib/ipt/protocol/src/serializer.cpp
 )
@@ -20,6 +21,7 @@ set (ipt_protocol_h
 	src/main/include/smf/ipt/scramble_key.h
 	src/main/include/smf/ipt/scramble_key_format.h
 	src/main/include/smf/ipt/scramble_key_io.hpp
+	src/main/include/smf/ipt/scrambler.h
 	src/main/include/smf/ipt/parser.h
 	src/main/include/smf/ipt/serializer.h
 )
@@ -0,0 +1,124 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#include <smf/ipt/scrambler.h>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define SMF_IPT_SCRAMBLER_SSE2
+#endif
+
+namespace node
+{
+	namespace ipt
+	{
+		static_assert(scrambler::KEY_LENGTH == 32, "block processing requires a key length of 32 bytes");
+
+		scrambler::scrambler()
+			: key_()
+			, offset_(0)
+			, generation_(0)
+		{}
+
+		scrambler& scrambler::operator=(key_type const& key)
+		{
+			key_ = key;
+			offset_ = 0;
+			++generation_;
+			return *this;
+		}
+
+		void scrambler::reset()
+		{
+			key_.fill(0);
+			offset_ = 0;
+			++generation_;
+		}
+
+		char scrambler::operator[](char c)
+		{
+			c ^= key_[offset_];
+			offset_ = (offset_ + 1) % KEY_LENGTH;
+			return c;
+		}
+
+		void scrambler::apply(char* p, std::size_t size)
+		{
+			apply(p, p, size);
+		}
+
+		void scrambler::apply(char const* src, char* dst, std::size_t size)
+		{
+			//
+			//	rotate key to current offset
+			//
+			alignas(32) char key[KEY_LENGTH];
+			std::memcpy(key, key_.data() + offset_, KEY_LENGTH - offset_);
+			std::memcpy(key + (KEY_LENGTH - offset_), key_.data(), offset_);
+
+			//
+			//	Full blocks don't change the offset. Unaligned loads
+			//	and stores allow src and dst to be equal.
+			//
+			std::size_t pos = 0;
+#if defined(__AVX2__)
+			__m256i const k = _mm256_load_si256(reinterpret_cast<__m256i const*>(key));
+			for (; pos + KEY_LENGTH <= size; pos += KEY_LENGTH) {
+				__m256i const v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(src + pos));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + pos), _mm256_xor_si256(v, k));
+			}
+#elif defined(SMF_IPT_SCRAMBLER_SSE2)
+			__m128i const k0 = _mm_load_si128(reinterpret_cast<__m128i const*>(key));
+			__m128i const k1 = _mm_load_si128(reinterpret_cast<__m128i const*>(key + 16));
+			for (; pos + KEY_LENGTH <= size; pos += KEY_LENGTH) {
+				__m128i const v0 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(src + pos));
+				__m128i const v1 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(src + pos + 16));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + pos), _mm_xor_si128(v0, k0));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + pos + 16), _mm_xor_si128(v1, k1));
+			}
+#else
+			std::uint64_t k[KEY_LENGTH / 8];
+			std::memcpy(k, key, KEY_LENGTH);
+			for (; pos + KEY_LENGTH <= size; pos += KEY_LENGTH) {
+				std::uint64_t v[KEY_LENGTH / 8];
+				std::memcpy(v, src + pos, KEY_LENGTH);
+				for (std::size_t idx = 0; idx < KEY_LENGTH / 8; ++idx) {
+					v[idx] ^= k[idx];
+				}
+				std::memcpy(dst + pos, v, KEY_LENGTH);
+			}
+#endif
+
+			//
+			//	remaining bytes
+			//
+			std::size_t const tail = size - pos;
+			for (std::size_t idx = 0; idx < tail; ++idx) {
+				dst[pos + idx] = src[pos + idx] ^ key[idx];
+			}
+			offset_ = (offset_ + tail) % KEY_LENGTH;
+		}
+
+		void scrambler::skip(std::size_t size)
+		{
+			offset_ = (offset_ + size) % KEY_LENGTH;
+		}
+
+		std::size_t scrambler::offset() const
+		{
+			return offset_;
+		}
+
+		std::uint64_t scrambler::generation() const
+		{
+			return generation_;
+		}
+	}
+}
@@ -15,6 +15,8 @@
 #endif
 #include <cyng/tuple_cast.hpp>
 #include <boost/predef.h>
+#include <algorithm>
+#include <array>
 
 namespace node
 {
@@ -750,29 +752,38 @@ namespace node
 
 		void serializer::write(scramble_key::key_type const& key)
 		{
-			std::for_each(key.begin(), key.end(), [this](char c) {
-				put(c);
-			});
+			put(key.data(), key.size());
 		}
 
 		void serializer::write(cyng::buffer_t const& data)
 		{
-			for (auto c : data)
+			auto pos = data.begin();
+			while (pos != data.end())
 			{
-				if (c == ESCAPE_SIGN)
-				{
-					//	duplicate escapes
-					put(c);
-				}
-				put(c);
+				//
+				//	write blocks without escape
+				//
+				auto const esc = std::find(pos, data.end(), static_cast<char>(ESCAPE_SIGN));
+				put(data.data() + std::distance(data.begin(), pos), std::distance(pos, esc));
+				if (esc == data.end())	break;
+
+				//	duplicate escapes
+				put(*esc);
+				put(*esc);
+				pos = esc + 1;
 			}
 		}
 		void serializer::put(const char* p, std::size_t size)
 		{
-			std::for_each(p, p + size, [this](char c) {
-				put(c);
-			});
-
+			std::array<char, 512> block;
+			while (size != 0)
+			{
+				std::size_t const n = (std::min)(size, block.size());
+				scrambler_.apply(p, block.data(), n);
+				ostream_.write(block.data(), n);
+				p += n;
+				size -= n;
+			}
 		}
 		void serializer::put(char c)
 		{
@@ -6,6 +6,9 @@ set (mbus_protocol_cpp
 	lib/mbus/protocol/src/parser.cpp
 	lib/mbus/protocol/src/variable_data_block.cpp
 	lib/mbus/protocol/src/units.cpp
+	lib/mbus/protocol/src/header.cpp
+	lib/mbus/protocol/src/dedup.cpp
+	lib/mbus/protocol/src/data_record.cpp
 )
 
 set (mbus_protocol_h
@@ -13,8 +16,17 @@ set (mbus_protocol_h
 	src/main/include/smf/mbus/parser.h
 	src/main/include/smf/mbus/variable_data_block.h
 	src/main/include/smf/mbus/units.h
+	src/main/include/smf/mbus/header.h
+	src/main/include/smf/mbus/dedup.h
+	src/main/include/smf/mbus/vif_table.h
+	src/main/include/smf/mbus/data_record.h
 )
 
+if(${PROJECT_NAME}_SSL_SUPPORT)
+	list(APPEND mbus_protocol_cpp lib/mbus/protocol/src/aes.cpp)
+	list(APPEND mbus_protocol_h src/main/include/smf/mbus/aes.h)
+endif()
+
 # define the main program
 set (mbus_protocol_lib
   ${mbus_protocol_cpp}
@@ -0,0 +1,103 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#include <smf/mbus/aes.h>
+#include <smf/mbus/header.h>
+#include <algorithm>
+
+namespace node
+{
+	namespace wmbus
+	{
+		key_cache::entry::entry()
+			: key_{ { 0 } }
+			, ctx_(EVP_CIPHER_CTX_new(), &EVP_CIPHER_CTX_free)
+		{}
+
+		key_cache::key_cache(std::size_t max_size)
+			: max_size_(max_size)
+			, cache_()
+		{}
+
+		EVP_CIPHER_CTX* key_cache::lookup(cyng::buffer_t const& server_id, cyng::buffer_t const& key)
+		{
+			if (key.size() != 16)	return nullptr;
+
+			auto pos = cache_.find(server_id);
+			if (pos != cache_.end()) {
+				if (std::equal(key.begin(), key.end(), pos->second.key_.begin(), [](char a, unsigned char b) {
+					return static_cast<unsigned char>(a) == b;
+				})) {
+					return pos->second.ctx_.get();
+				}
+
+				//
+				//	key has changed
+				//
+				cache_.erase(pos);
+			}
+
+			if (cache_.size() >= max_size_) {
+				cache_.clear();
+			}
+
+			entry e;
+			if (!e.ctx_)	return nullptr;
+			std::copy(key.begin(), key.end(), e.key_.begin());
+
+			//
+			//	expand the key once - the IV is set for each telegram
+			//
+			if (EVP_DecryptInit_ex(e.ctx_.get(), EVP_aes_128_cbc(), nullptr, e.key_.data(), nullptr) != 1) {
+				return nullptr;
+			}
+			auto r = cache_.emplace(server_id, std::move(e));
+			return r.first->second.ctx_.get();
+		}
+
+		bool key_cache::decrypt_mode_5(cyng::buffer_t const& server_id
+			, cyng::buffer_t const& key
+			, std::array<unsigned char, 16> const& iv
+			, char* data
+			, std::size_t size)
+		{
+			if (size == 0 || (size % 16) != 0)	return false;
+
+			auto const ctx = lookup(server_id, key);
+			if (ctx == nullptr)	return false;
+
+			//
+			//	Without padding EVP_DecryptUpdate() returns all blocks
+			//	and no EVP_DecryptFinal_ex() is required.
+			//
+			if (EVP_DecryptInit_ex(ctx, nullptr, nullptr, nullptr, iv.data()) != 1)	return false;
+			EVP_CIPHER_CTX_set_padding(ctx, 0);
+
+			int len{ 0 };
+			auto p = reinterpret_cast<unsigned char*>(data);
+			if (EVP_DecryptUpdate(ctx, p, &len, p, static_cast<int>(size)) != 1)	return false;
+			if (static_cast<std::size_t>(len) != size)	return false;
+
+			return (data[0] == IDLE_FILLER) && (data[1] == IDLE_FILLER);
+		}
+
+		void key_cache::erase(cyng::buffer_t const& server_id)
+		{
+			cache_.erase(server_id);
+		}
+
+		void key_cache::clear()
+		{
+			cache_.clear();
+		}
+
+		std::size_t key_cache::size() const
+		{
+			return cache_.size();
+		}
+	}
+}
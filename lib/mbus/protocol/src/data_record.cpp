@@ -0,0 +1,268 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#include <smf/mbus/data_record.h>
+#include <cstring>
+
+namespace node
+{
+	namespace mbus
+	{
+		namespace
+		{
+			/**
+			 * read little endian integer and extend sign
+			 */
+			std::int64_t read_integer(unsigned char const* p, std::size_t size)
+			{
+				std::uint64_t v{ 0 };
+				for (std::size_t idx = size; idx != 0; --idx) {
+					v = (v << 8) | p[idx - 1];
+				}
+				if (size != 0 && size < 8 && ((p[size - 1] & 0x80) == 0x80)) {
+					v |= ~std::uint64_t(0) << (size * 8);
+				}
+				return static_cast<std::int64_t>(v);
+			}
+
+			/**
+			 * data type G
+			 */
+			std::int64_t read_date(unsigned char const* p)
+			{
+				std::int64_t const day = p[0] & 0x1F;
+				std::int64_t const month = p[1] & 0x0F;
+				std::int64_t const year = 2000 + (((p[0] & 0xE0) >> 5) | ((p[1] & 0xF0) >> 1));
+				return (year * 10000) + (month * 100) + day;
+			}
+
+			/**
+			 * data type F
+			 */
+			std::int64_t read_date_time(unsigned char const* p)
+			{
+				std::int64_t const minute = p[0] & 0x3F;
+				std::int64_t const hour = p[1] & 0x1F;
+				std::int64_t const day = p[2] & 0x1F;
+				std::int64_t const month = p[3] & 0x0F;
+				std::int64_t const year = 2000 + (((p[2] & 0xE0) >> 5) | ((p[3] & 0xF0) >> 1));
+				return (((year * 10000) + (month * 100) + day) * 10000) + (hour * 100) + minute;
+			}
+
+			/**
+			 * LVAR (table 5 of EN 13757-3)
+			 */
+			bool read_lvar(unsigned char lvar, record_type& type, std::size_t& size)
+			{
+				if (lvar < 0xC0) {
+					type = RECORD_STRING;
+					size = lvar;
+				}
+				else if (lvar <= 0xC9) {
+					type = RECORD_BCD;
+					size = lvar - 0xC0;
+				}
+				else if (lvar >= 0xD0 && lvar <= 0xD9) {
+					//	negative BCD
+					type = RECORD_BCD;
+					size = lvar - 0xD0;
+				}
+				else if (lvar >= 0xE0 && lvar <= 0xEF) {
+					type = RECORD_INTEGER;
+					size = lvar - 0xE0;
+				}
+				else {
+					return false;
+				}
+				return true;
+			}
+		}
+
+		bool decode_bcd(unsigned char const* p, std::size_t size, std::int64_t& value)
+		{
+			//
+			//	most significant byte comes last
+			//
+			bool negative = false;
+			std::int64_t v{ 0 };
+			for (std::size_t idx = size; idx != 0; --idx) {
+				unsigned const hi = (p[idx - 1] >> 4) & 0x0F;
+				unsigned const lo = p[idx - 1] & 0x0F;
+				if (idx == size && hi == 0x0F) {
+					negative = true;
+				}
+				else if (hi > 9) {
+					return false;
+				}
+				else {
+					v = v * 10 + hi;
+				}
+				if (lo > 9)	return false;
+				v = v * 10 + lo;
+			}
+			value = negative ? -v : v;
+			return true;
+		}
+
+		std::size_t decode_records(char const* data
+			, std::size_t size
+			, data_record* records
+			, std::size_t capacity
+			, std::size_t& count)
+		{
+			auto const p = reinterpret_cast<unsigned char const*>(data);
+			std::size_t offset{ 0 };
+			count = 0;
+
+			while (offset < size && count < capacity) {
+
+				//
+				//	DIF
+				//
+				auto const dif = p[offset];
+				if (dif == 0x2F) {
+					//	idle filler
+					++offset;
+					continue;
+				}
+				if ((dif & 0xEF) == 0x0F) {
+					//	manufacturer specific data follow
+					break;
+				}
+
+				std::size_t const start = offset++;
+				data_record& rec = records[count];
+				std::memset(&rec, 0, sizeof(data_record));
+
+				rec.func_ = (dif & 0x30) >> 4;
+				rec.storage_nr_ = (dif & 0x40) >> 6;
+
+				//
+				//	DIFE
+				//
+				bool ext = (dif & 0x80) == 0x80;
+				for (unsigned pos = 0; ext && offset < size; ++pos) {
+					auto const dife = p[offset++];
+					rec.storage_nr_ |= static_cast<std::uint64_t>(dife & 0x0F) << ((pos * 4) + 1);
+					rec.tariff_ |= static_cast<std::uint32_t>((dife & 0x30) >> 4) << (pos * 2);
+					rec.sub_unit_ |= static_cast<std::uint16_t>(((dife & 0x40) >> 6) << pos);
+					ext = (dife & 0x80) == 0x80;
+				}
+				if (offset >= size)	return start;
+
+				//
+				//	VIF
+				//
+				auto const vif = p[offset++];
+				vif_entry ve = vif_primary_table[vif & 0x7F];
+				ext = (vif & 0x80) == 0x80;
+
+				if (ve.type_ == VIF_EXT_FD || ve.type_ == VIF_EXT_FB) {
+					if (offset >= size)	return start;
+					auto const vife = p[offset++];
+					ve = (ve.type_ == VIF_EXT_FD)
+						? vif_ext_fd_table[vife & 0x7F]
+						: vif_entry{ VIF_UNKNOWN, UNDEFINED_, 0 }
+						;
+					ext = (vife & 0x80) == 0x80;
+				}
+				else if (ve.type_ == VIF_PLAIN_TEXT) {
+					//	length and ASCII string follow
+					if (offset >= size)	return start;
+					offset += p[offset] + 1;
+				}
+
+				//
+				//	combinable VIFEs
+				//
+				while (ext && offset < size) {
+					auto const vife = p[offset++];
+					if ((vife & 0x78) == 0x70) {
+						//	multiplicative correction factor 10^(nnn-6)
+						ve.scaler_ += static_cast<std::int8_t>((vife & 0x07) - 6);
+					}
+					ext = (vife & 0x80) == 0x80;
+				}
+
+				rec.vif_ = ve.type_;
+				rec.unit_ = ve.unit_;
+				rec.scaler_ = ve.scaler_;
+
+				//
+				//	data field
+				//
+				auto const de = dif_table[dif & 0x0F];
+				std::size_t field_size = de.size_;
+				unsigned char lvar{ 0 };
+				switch (de.coding_) {
+				case DIF_NONE:
+					rec.type_ = RECORD_NONE;
+					break;
+				case DIF_INTEGER:
+					rec.type_ = RECORD_INTEGER;
+					break;
+				case DIF_REAL:
+					rec.type_ = RECORD_REAL;
+					break;
+				case DIF_BCD:
+					rec.type_ = RECORD_BCD;
+					break;
+				case DIF_VARIABLE:
+					if (offset >= size)	return start;
+					lvar = p[offset++];
+					if (!read_lvar(lvar, rec.type_, field_size))	return start;
+					break;
+				default:
+					return start;
+				}
+
+				if (offset + field_size > size)	return start;
+
+				rec.offset_ = static_cast<std::uint16_t>(offset);
+				rec.size_ = static_cast<std::uint8_t>(field_size);
+
+				switch (rec.type_) {
+				case RECORD_INTEGER:
+					if (rec.vif_ == VIF_DATE && field_size == 2) {
+						rec.type_ = RECORD_DATE;
+						rec.value_.i_ = read_date(p + offset);
+					}
+					else if (rec.vif_ == VIF_DATE_TIME && field_size == 4) {
+						rec.type_ = RECORD_DATE_TIME;
+						rec.value_.i_ = read_date_time(p + offset);
+					}
+					else {
+						rec.value_.i_ = read_integer(p + offset, field_size);
+					}
+					break;
+				case RECORD_REAL:
+				{
+					float f;
+					std::memcpy(&f, p + offset, sizeof(f));
+					rec.value_.f_ = f;
+				}
+					break;
+				case RECORD_BCD:
+					if (!decode_bcd(p + offset, field_size, rec.value_.i_)) {
+						rec.type_ = RECORD_INVALID;
+					}
+					else if (lvar >= 0xD0 && lvar <= 0xD9) {
+						rec.value_.i_ = -rec.value_.i_;
+					}
+					break;
+				default:
+					break;
+				}
+
+				offset += field_size;
+				++count;
+			}
+
+			return offset;
+		}
+	}
+}
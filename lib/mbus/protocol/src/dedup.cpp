@@ -0,0 +1,88 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#include <smf/mbus/dedup.h>
+
+namespace node
+{
+	namespace wmbus
+	{
+		bool dedup::key::operator==(key const& other) const
+		{
+			return (manufacturer_ == other.manufacturer_)
+				&& (id_ == other.id_)
+				&& (access_no_ == other.access_no_)
+				&& (crc_ == other.crc_)
+				;
+		}
+
+		std::size_t dedup::key_hash::operator()(key const& k) const
+		{
+			//
+			//	72 bits are folded into 64 - equality compares all fields
+			//
+			return std::hash<std::uint64_t>()((static_cast<std::uint64_t>(k.id_)
+				| (static_cast<std::uint64_t>(k.crc_) << 32)
+				| (static_cast<std::uint64_t>(k.manufacturer_) << 48))
+				^ (static_cast<std::uint64_t>(k.access_no_) << 56));
+		}
+
+		dedup::dedup(std::chrono::seconds window, std::size_t max_size)
+			: window_(window)
+			, max_size_(max_size)
+			, set_()
+			, queue_()
+			, duplicates_(0)
+		{
+			set_.reserve(max_size_);
+		}
+
+		bool dedup::test_and_set(std::uint16_t manufacturer, std::uint32_t id, std::uint8_t access_no, std::uint16_t crc)
+		{
+			return test_and_set(manufacturer, id, access_no, crc, clock_t::now());
+		}
+
+		bool dedup::test_and_set(std::uint16_t manufacturer, std::uint32_t id, std::uint8_t access_no, std::uint16_t crc, clock_t::time_point now)
+		{
+			purge(now);
+
+			key const k{ manufacturer, id, access_no, crc };
+			if (!set_.insert(k).second) {
+				++duplicates_;
+				return false;
+			}
+
+			//
+			//	limit memory consumption
+			//
+			if (queue_.size() == max_size_) {
+				set_.erase(queue_.front().key_);
+				queue_.pop_front();
+			}
+			queue_.push_back({ k, now });
+			return true;
+		}
+
+		void dedup::purge(clock_t::time_point now)
+		{
+			while (!queue_.empty() && (queue_.front().tp_ + window_ < now)) {
+				set_.erase(queue_.front().key_);
+				queue_.pop_front();
+			}
+		}
+
+		std::size_t dedup::size() const
+		{
+			return queue_.size();
+		}
+
+		std::uint64_t dedup::get_duplicates() const
+		{
+			return duplicates_;
+		}
+	}
+}
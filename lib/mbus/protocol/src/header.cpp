@@ -0,0 +1,132 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#include <smf/mbus/header.h>
+#include <algorithm>
+
+namespace node
+{
+	namespace wmbus
+	{
+		header::header()
+			: access_no_(0)
+			, status_(0)
+			, cfg_(0)
+			, offset_(0)
+			, address_{ { 0 } }
+			, long_(false)
+		{}
+
+		std::uint8_t header::get_mode() const
+		{
+			return static_cast<std::uint8_t>((cfg_ >> 8) & 0x1F);
+		}
+
+		std::size_t header::get_block_count() const
+		{
+			return static_cast<std::size_t>((cfg_ >> 4) & 0x0F);
+		}
+
+		std::size_t header::get_offset() const
+		{
+			return offset_;
+		}
+
+		std::uint8_t header::get_access_no() const
+		{
+			return access_no_;
+		}
+
+		std::uint8_t header::get_status() const
+		{
+			return status_;
+		}
+
+		bool header::has_address() const
+		{
+			return long_;
+		}
+
+		std::array<unsigned char, 16> header::get_iv(cyng::buffer_t const& server_id, std::uint8_t version) const
+		{
+			std::array<unsigned char, 16> iv;
+			if (long_) {
+				std::copy(address_.begin(), address_.end(), iv.begin());
+			}
+			else if (server_id.size() == 9) {
+
+				//
+				//	server ID: [0] type, [1-2] manufacturer, [3-6] ID, [7] medium
+				//	link layer address: manufacturer, ID, version, medium
+				//
+				std::copy(server_id.begin() + 1, server_id.begin() + 7, iv.begin());
+				iv[6] = version;
+				iv[7] = static_cast<unsigned char>(server_id.at(7));
+			}
+			else {
+				std::fill(iv.begin(), iv.begin() + 8, 0);
+			}
+			std::fill(iv.begin() + 8, iv.end(), access_no_);
+			return iv;
+		}
+
+		bool read_header(std::uint8_t ci, cyng::buffer_t const& payload, header& h)
+		{
+			std::size_t pos{ 0 };
+			switch (ci) {
+			case CI_LONG_HEADER:
+				if (payload.size() < 12)	return false;
+
+				//
+				//	ID (4), manufacturer (2), version (1), medium (1)
+				//	reordered to manufacturer, ID, version, medium
+				//
+				h.address_[0] = static_cast<unsigned char>(payload.at(4));
+				h.address_[1] = static_cast<unsigned char>(payload.at(5));
+				std::copy(payload.begin(), payload.begin() + 4, h.address_.begin() + 2);
+				h.address_[6] = static_cast<unsigned char>(payload.at(6));
+				h.address_[7] = static_cast<unsigned char>(payload.at(7));
+				h.long_ = true;
+				pos = 8;
+				break;
+			case CI_SHORT_HEADER:
+				if (payload.size() < 4)	return false;
+				h.long_ = false;
+				break;
+			default:
+				return false;
+			}
+
+			h.access_no_ = static_cast<std::uint8_t>(payload.at(pos));
+			h.status_ = static_cast<std::uint8_t>(payload.at(pos + 1));
+			h.cfg_ = static_cast<std::uint16_t>(payload.at(pos + 2) & 0xFF)
+				| static_cast<std::uint16_t>((payload.at(pos + 3) & 0xFF) << 8);
+			h.offset_ = pos + 4;
+			return true;
+		}
+
+		std::uint16_t crc16_en13757(unsigned char const* cp, std::size_t len)
+		{
+			std::uint16_t crc{ 0 };
+			while (len-- != 0) {
+				crc ^= static_cast<std::uint16_t>(*cp++) << 8;
+				for (int i = 0; i < 8; ++i) {
+					crc = (crc & 0x8000)
+						? static_cast<std::uint16_t>((crc << 1) ^ 0x3D65)
+						: static_cast<std::uint16_t>(crc << 1)
+						;
+				}
+			}
+			return static_cast<std::uint16_t>(~crc);
+		}
+
+		std::uint16_t crc16_en13757(cyng::buffer_t const& b)
+		{
+			return crc16_en13757(reinterpret_cast<unsigned char const*>(b.data()), b.size());
+		}
+	}
+}
@@ -311,7 +311,8 @@ namespace node
 		{
 			v.u_.c_ = this->c_;
 			//std::cout << "protocol type: " << +v.u_.internal_.type_ << ", protocol version: " << +v.u_.internal_.ver_ << std::endl;
-			this->parser_.version_ = v.u_.internal_.ver_;
+			//	the complete version byte is part of the IV of encrypted telegrams
+			this->parser_.version_ = static_cast<std::uint8_t>(this->c_);
 			this->parser_.server_id_[8] = v.u_.internal_.ver_;
 			return STATE_DEV_TYPE;
 		}
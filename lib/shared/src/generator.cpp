@@ -6,6 +6,7 @@
  */
 
 #include <smf/cluster/generator.h>
+#include <smf/cluster/serializer.h>
 #include <cyng/chrono.h>
 #include <cyng/intrinsics/label.h>
 
@@ -46,6 +47,7 @@ namespace node
 					, cyng::invoke_remote("ip.tcp.socket.ep.remote")
 					, NODE_PLATFORM		//	since v0.4
 					, cyng::code::PID	//	since v0.4
+					, std::string(cluster_compression)	//	supported compression
 				))
 			<< cyng::generate_invoke("stream.flush")
 			<< cyng::label(":STOP")
@@ -132,6 +134,31 @@ namespace node
 			;
 	}
 
+	cyng::vector_t bus_req_db_merge(std::string const& table
+		, cyng::vector_t const& key
+		, cyng::vector_t const& data
+		, std::uint64_t generation
+		, boost::uuids::uuid source)
+	{
+		//	
+		//	key and data will not be unwinded
+		//
+		cyng::vector_t prg;
+		return prg << cyng::generate_invoke_unwinded("stream.serialize"
+			, cyng::generate_invoke_remote_unwinded("bus.req.db.merge", table, key, data, generation, source))
+			<< cyng::generate_invoke_unwinded("stream.flush")
+			;
+	}
+
+	cyng::vector_t bus_req_db_reconcile(std::string const& table)
+	{
+		cyng::vector_t prg;
+		return prg << cyng::generate_invoke_unwinded("stream.serialize"
+			, cyng::generate_invoke_remote_unwinded("bus.req.db.reconcile", table))
+			<< cyng::generate_invoke_unwinded("stream.flush")
+			;
+	}
+
 	cyng::vector_t bus_req_db_modify(std::string const& table
 		, cyng::vector_t const& key
 		, cyng::attr_t const& value
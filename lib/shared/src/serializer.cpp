@@ -7,41 +7,279 @@
 
 #include <smf/cluster/serializer.h>
 #include <cyng/vm/generator.h>
+#include <cyng/io/parser/parser.h>
+#include <cyng/intrinsics/buffer.h>
+#include <cyng/value_cast.hpp>
+#include <cyng/object_cast.hpp>
+
+#include <boost/beast/zlib/deflate_stream.hpp>
+#include <boost/beast/zlib/inflate_stream.hpp>
 
 namespace node
 {
-	serializer::serializer(boost::asio::ip::tcp::socket& s, cyng::controller& vm)
-		: buffer_()
-		, ostream_(&buffer_)
+	serializer::serializer(boost::asio::ip::tcp::socket& s
+		, cyng::controller& vm
+		, std::size_t inflate_limit)
+		: out_(std::make_shared<outbound>(s, vm))
+		, buffer_(new boost::asio::streambuf())
+		, ostream_(buffer_.get())
+		, threshold_(0)
+		, inflate_limit_(inflate_limit)
 	{
-        vm.register_function("stream.flush", 0, [this, &s](cyng::context& ctx) {
-
-#ifdef SMF_IO_DEBUG
-			//	get content of buffer
-			//boost::asio::const_buffer cbuffer(*buffer_.data().begin());
-			//const char* p = boost::asio::buffer_cast<const char*>(cbuffer);
-			//const std::size_t size = boost::asio::buffer_size(cbuffer);
-
-			//cyy::io::hex_dump hd;
-			//hd(std::cerr, p, p + size);
-#endif
-
-			boost::system::error_code ec;
-			boost::asio::write(s, buffer_, ec);
-			ctx.set_register(ec);
-        });
+		vm.register_function("stream.flush", 0, std::bind(&serializer::flush, this, std::placeholders::_1));
 
-        vm.register_function("stream.serialize", 0, [this](cyng::context& ctx) {
+		vm.register_function("stream.serialize", 0, [this](cyng::context& ctx) {
 
 			const cyng::vector_t frame = ctx.get_frame();
-			for (auto obj : frame)
+			for (auto const& obj : frame)
 			{
 				//cyng::io::serialize_plain(std::cerr, obj);
 				cyng::io::serialize_binary(ostream_, obj);
 			}
 
-        });
+		});
+
+		vm.register_function("stream.compress", 1, std::bind(&serializer::compress, this, std::placeholders::_1));
+		vm.register_function("stream.inflate", 2, std::bind(&serializer::inflate, this, std::placeholders::_1));
+	}
+
+	serializer::~serializer()
+	{
+		cyng::async::lock_guard<cyng::async::mutex> lk(out_->mutex_);
+		out_->socket_ = nullptr;
+		out_->vm_ = nullptr;
+		out_->queue_.clear();
+	}
+
+	void serializer::flush(cyng::context& ctx)
+	{
+		if (buffer_->size() == 0)	return;
+
+		if ((threshold_ != 0) && (buffer_->size() > threshold_)) {
+			deflate_buffer();
+		}
+
+		cyng::async::lock_guard<cyng::async::mutex> lk(out_->mutex_);
+
+		if (out_->ec_) {
+
+			//
+			//	connection is lost - this frame cannot be written
+			//
+			ctx.set_register(out_->ec_);
+			buffer_->consume(buffer_->size());
+			return;
+		}
+
+		//
+		//	frame is queued - a failing write is reported
+		//	when it completes
+		//
+		ctx.set_register(boost::system::error_code());
+
+		out_->queue_.push_back(std::move(buffer_));
+		buffer_ = out_->get_buffer();
+		ostream_.rdbuf(buffer_.get());
+
+		if (out_->sending_.empty()) {
+			outbound::do_write(out_);
+		}
+	}
+
+	void serializer::compress(cyng::context& ctx)
+	{
+		const cyng::vector_t frame = ctx.get_frame();
+		threshold_ = cyng::numeric_cast<std::size_t>(frame.at(0), cluster_compression_threshold);
+	}
+
+	void serializer::inflate(cyng::context& ctx)
+	{
+		const cyng::vector_t frame = ctx.get_frame();
+		auto const ptr = cyng::object_cast<cyng::buffer_t>(frame.at(0));
+		auto const size = cyng::numeric_cast<std::uint64_t>(frame.at(1), 0u);
+		if (ptr == nullptr || size == 0)	return;
+
+		//
+		//	don't trust the declared size
+		//
+		if (size > inflate_limit_) {
+			ctx.queue(cyng::generate_invoke("log.msg.error"
+				, "stream.inflate - frame too large"
+				, size
+				, inflate_limit_));
+			ctx.set_register(boost::system::errc::make_error_code(boost::system::errc::message_size));
+			return;
+		}
+
+		cyng::buffer_t data(static_cast<std::size_t>(size));
+
+		boost::beast::zlib::inflate_stream is;
+		is.reset(15);
+
+		boost::beast::zlib::z_params zs;
+		zs.next_in = ptr->data();
+		zs.avail_in = ptr->size();
+		zs.next_out = data.data();
+		zs.avail_out = data.size();
+
+		boost::beast::error_code ec;
+		is.write(zs, boost::beast::zlib::Flush::finish, ec);
+		if (ec && ec != boost::beast::zlib::error::end_of_stream) {
+			ctx.set_register(ec);
+			return;
+		}
+
+		//
+		//	the complete stream must fill the buffer exactly
+		//
+		if (ec != boost::beast::zlib::error::end_of_stream || zs.total_out != size) {
+			ctx.queue(cyng::generate_invoke("log.msg.error"
+				, "stream.inflate - size mismatch"
+				, size
+				, static_cast<std::uint64_t>(zs.total_out)));
+			ctx.set_register(boost::system::errc::make_error_code(boost::system::errc::bad_message));
+			return;
+		}
 
+		//
+		//	execute the content in order - before anything else
+		//	that was received in the meantime
+		//
+		cyng::parser p([&ctx](cyng::vector_t&& prg) {
+			ctx.queue(std::move(prg));
+		});
+		p.read(data.data(), data.data() + data.size());
+	}
+
+	void serializer::deflate_buffer()
+	{
+		//
+		//	streambuf content is contiguous
+		//
+		boost::asio::const_buffer const cbuffer = buffer_->data();
+		auto const size = cbuffer.size();
+
+		boost::beast::zlib::deflate_stream ds;
+		ds.reset(1, 15, 8, boost::beast::zlib::Strategy::normal);
+
+		cyng::buffer_t out(ds.upper_bound(size));
+
+		boost::beast::zlib::z_params zs;
+		zs.next_in = cbuffer.data();
+		zs.avail_in = size;
+		zs.next_out = out.data();
+		zs.avail_out = out.size();
+
+		boost::beast::error_code ec;
+		ds.write(zs, boost::beast::zlib::Flush::finish, ec);
+		if (ec && ec != boost::beast::zlib::error::end_of_stream)	return;
+
+		//
+		//	send uncompressed if there is no gain
+		//
+		if (zs.total_out >= size)	return;
+		out.resize(zs.total_out);
+
+		buffer_->consume(size);
+		for (auto const& obj : cyng::generate_invoke("stream.inflate", out, static_cast<std::uint64_t>(size)))
+		{
+			cyng::io::serialize_binary(ostream_, obj);
+		}
+	}
+
+	serializer::outbound::outbound(boost::asio::ip::tcp::socket& s, cyng::controller& vm)
+		: socket_(&s)
+		, vm_(&vm)
+		, queue_()
+		, sending_()
+		, spare_()
+		, ec_()
+		, mutex_()
+	{}
+
+	void serializer::outbound::do_write(std::shared_ptr<outbound> sp)
+	{
+		BOOST_ASSERT(sp->sending_.empty());
+		BOOST_ASSERT(sp->socket_ != nullptr);
+
+		std::vector<boost::asio::const_buffer> buffers;
+		buffers.reserve(sp->queue_.size());
+		while (!sp->queue_.empty()) {
+			buffers.push_back(sp->queue_.front()->data());
+			sp->sending_.push_back(std::move(sp->queue_.front()));
+			sp->queue_.pop_front();
+		}
+
+		//
+		//	the handler keeps the buffers alive, even if the
+		//	serializer is gone
+		//
+		auto& s = *sp->socket_;
+		boost::asio::async_write(s, buffers, [sp](boost::system::error_code const& ec, std::size_t) {
+			on_write(sp, ec);
+		});
+	}
+
+	void serializer::outbound::on_write(std::shared_ptr<outbound> sp, boost::system::error_code const& ec)
+	{
+		cyng::async::lock_guard<cyng::async::mutex> lk(sp->mutex_);
+
+		//
+		//	recycle buffers
+		//
+		auto const count = sp->sending_.size();
+		for (auto& b : sp->sending_) {
+			sp->recycle(std::move(b));
+		}
+		sp->sending_.clear();
+
+		//
+		//	serializer was destroyed
+		//
+		if (sp->socket_ == nullptr)	return;
+
+		if (ec) {
+
+			//
+			//	connection is lost - drop all pending data
+			//
+			sp->ec_ = ec;
+			auto const dropped = sp->queue_.size();
+			for (auto& b : sp->queue_) {
+				sp->recycle(std::move(b));
+			}
+			sp->queue_.clear();
+
+			if (ec != boost::asio::error::operation_aborted) {
+				sp->vm_->async_run(cyng::generate_invoke("log.msg.error"
+					, "stream write failed"
+					, ec
+					, (count + dropped)
+					, "frame(s) lost"));
+			}
+		}
+		else if (!sp->queue_.empty()) {
+			do_write(sp);
+		}
+	}
+
+	serializer::buffer_ptr serializer::outbound::get_buffer()
+	{
+		if (spare_.empty())	return buffer_ptr(new boost::asio::streambuf());
+		auto sp = std::move(spare_.back());
+		spare_.pop_back();
+		return sp;
+	}
+
+	void serializer::outbound::recycle(buffer_ptr&& sp)
+	{
+		//
+		//	keep a few buffers only
+		//
+		if (spare_.size() < 8) {
+			sp->consume(sp->size());
+			spare_.push_back(std::move(sp));
+		}
 	}
 
 }
@@ -28,11 +28,13 @@ namespace node
 	namespace sml
 	{
 
-		abl_exporter::abl_exporter(boost::filesystem::path root_dir
+		abl_exporter::abl_exporter(output_files& files
+			, boost::filesystem::path root_dir
 			, std::string prefix
 			, std::string suffix
 			, bool eol)
-		: root_dir_(root_dir)
+		: files_(files)
+			, root_dir_(root_dir)
 			, prefix_(prefix)
 			, suffix_(suffix)
 			, eol_(eol ? "\r\n" : "\n")
@@ -45,14 +47,16 @@ namespace node
 			reset();
 		}
 
-		abl_exporter::abl_exporter(boost::filesystem::path root_dir
+		abl_exporter::abl_exporter(output_files& files
+			, boost::filesystem::path root_dir
 			, std::string prefix
 			, std::string suffix
 			, bool eol
 			, std::uint32_t source
 			, std::uint32_t channel
 			, std::string const& target)
-		: root_dir_(root_dir)
+		: files_(files)
+			, root_dir_(root_dir)
 			, prefix_(prefix)
 			, suffix_(suffix)
 			, eol_(eol ? "\r\n" : "\n")
@@ -311,7 +315,7 @@ namespace node
 			//
 			ro_.set_value("status", *pos++);
 
-			std::ofstream of((root_dir_ / get_abl_filename(prefix_, suffix_, gw_id, server_id)).string(), std::ios::app | std::ios::binary);
+			auto& of = files_.open(root_dir_ / get_abl_filename(prefix_, suffix_, gw_id, server_id));
 			//ofstream_.open((root_dir_ / get_abl_filename(prefix_ + server_id, suffix_, source_, channel_, target_)).string());
 
 			if (of.is_open()) {
@@ -0,0 +1,488 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#include <smf/sml/exporter/archive_format.h>
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <tuple>
+
+namespace node
+{
+	namespace sml
+	{
+		namespace
+		{
+			const char chunk_magic[4] = { 'S', 'M', 'F', 'C' };
+			const std::uint8_t chunk_version = 1;
+
+			/**
+			 * magic, version, min time, max time, records, dictionary size, column size
+			 */
+			const std::size_t chunk_header_size = 4 + 1 + 8 + 8 + 4 + 4 + 4;
+
+			void put_fixed(std::string& out, std::uint64_t value, std::size_t size)
+			{
+				for (std::size_t idx = 0; idx < size; ++idx) {
+					out.push_back(static_cast<char>((value >> (8 * idx)) & 0xFF));
+				}
+			}
+
+			std::uint64_t get_fixed(char const* p, std::size_t size)
+			{
+				std::uint64_t value{ 0 };
+				for (std::size_t idx = 0; idx < size; ++idx) {
+					value |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(p[idx])) << (8 * idx);
+				}
+				return value;
+			}
+
+			void put_varint(std::string& out, std::uint64_t value)
+			{
+				while (value >= 0x80) {
+					out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+					value >>= 7;
+				}
+				out.push_back(static_cast<char>(value));
+			}
+
+			std::uint64_t zigzag(std::int64_t value)
+			{
+				return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+			}
+
+			std::int64_t unzigzag(std::uint64_t value)
+			{
+				return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+			}
+
+			/**
+			 * differences wrap around instead of overflow
+			 */
+			std::int64_t sub(std::int64_t a, std::int64_t b)
+			{
+				return static_cast<std::int64_t>(static_cast<std::uint64_t>(a) - static_cast<std::uint64_t>(b));
+			}
+
+			std::int64_t add(std::int64_t a, std::int64_t b)
+			{
+				return static_cast<std::int64_t>(static_cast<std::uint64_t>(a) + static_cast<std::uint64_t>(b));
+			}
+
+			/**
+			 * read from a chunk section
+			 */
+			class cursor
+			{
+			public:
+				explicit cursor(std::string const& section)
+					: pos_(section.data())
+					, end_(section.data() + section.size())
+					, good_(true)
+				{}
+
+				std::uint64_t varint()
+				{
+					std::uint64_t value{ 0 };
+					for (unsigned shift = 0; pos_ != end_ && shift < 64; shift += 7) {
+						auto const c = static_cast<std::uint8_t>(*pos_++);
+						value |= static_cast<std::uint64_t>(c & 0x7F) << shift;
+						if ((c & 0x80) == 0) {
+							return value;
+						}
+					}
+					good_ = false;
+					return 0;
+				}
+
+				std::int64_t svarint()
+				{
+					return unzigzag(varint());
+				}
+
+				/**
+				 * Read the number of elements of a list. Each element
+				 * takes at least min_size bytes, so the count can't be
+				 * larger than the rest of the section allows.
+				 */
+				std::size_t count(std::size_t min_size)
+				{
+					auto const n = varint();
+					if (n > static_cast<std::uint64_t>(end_ - pos_) / min_size) {
+						good_ = false;
+						return 0;
+					}
+					return static_cast<std::size_t>(n);
+				}
+
+				std::uint8_t byte()
+				{
+					if (pos_ == end_) {
+						good_ = false;
+						return 0;
+					}
+					return static_cast<std::uint8_t>(*pos_++);
+				}
+
+				std::string bytes(std::uint64_t size)
+				{
+					if (static_cast<std::uint64_t>(end_ - pos_) < size) {
+						good_ = false;
+						return std::string();
+					}
+					std::string s(pos_, static_cast<std::size_t>(size));
+					pos_ += size;
+					return s;
+				}
+
+				bool good() const
+				{
+					return good_;
+				}
+
+			private:
+				char const* pos_;
+				char const* const end_;
+				bool good_;
+			};
+
+			struct series
+			{
+				std::size_t server_;
+				std::size_t code_;
+				std::uint8_t unit_;
+				std::int8_t scaler_;
+				std::size_t size_;
+			};
+
+			bool read_section(std::istream& is, std::string& section, std::size_t size)
+			{
+				section.resize(size);
+				if (size != 0) {
+					is.read(&section[0], size);
+				}
+				return static_cast<std::size_t>(is.gcount()) == size;
+			}
+
+			void skip_section(std::istream& is, std::size_t size)
+			{
+				is.seekg(size, std::ios::cur);
+			}
+		}
+
+		archive_filter::archive_filter()
+			: servers_()
+			, codes_()
+			, begin_(std::numeric_limits<std::int64_t>::min())
+			, end_(std::numeric_limits<std::int64_t>::max())
+		{}
+
+		bool archive_filter::overlaps(std::int64_t min_time, std::int64_t max_time) const
+		{
+			return min_time <= end_ && max_time >= begin_;
+		}
+
+		bool archive_filter::match_server(std::string const& server) const
+		{
+			return servers_.empty() || (servers_.count(server) != 0);
+		}
+
+		bool archive_filter::match_code(obis const& code) const
+		{
+			return codes_.empty() || (codes_.count(code) != 0);
+		}
+
+		bool archive_filter::match(archive_record const& rec) const
+		{
+			return rec.time_ >= begin_
+				&& rec.time_ <= end_
+				&& match_server(rec.server_)
+				&& match_code(rec.code_);
+		}
+
+		archive_chunk::archive_chunk()
+			: records_()
+		{}
+
+		void archive_chunk::append(archive_record const& rec)
+		{
+			records_.push_back(rec);
+		}
+
+		std::size_t archive_chunk::size() const
+		{
+			return records_.size();
+		}
+
+		bool archive_chunk::empty() const
+		{
+			return records_.empty();
+		}
+
+		void archive_chunk::write(std::ostream& os)
+		{
+			if (records_.empty())	return;
+
+			//
+			//	dictionaries in order of appearance
+			//
+			std::map<std::string, std::size_t> servers;
+			std::map<obis, std::size_t> codes;
+			std::vector<std::string> server_list;
+			std::vector<obis> code_list;
+			std::vector<std::pair<std::size_t, std::size_t>> keys;
+			keys.reserve(records_.size());
+
+			auto min_time = records_.front().time_;
+			auto max_time = records_.front().time_;
+
+			for (auto const& rec : records_) {
+				auto srv = servers.emplace(rec.server_, server_list.size());
+				if (srv.second)	server_list.push_back(rec.server_);
+				auto code = codes.emplace(rec.code_, code_list.size());
+				if (code.second)	code_list.push_back(rec.code_);
+				keys.emplace_back(srv.first->second, code.first->second);
+
+				min_time = std::min(min_time, rec.time_);
+				max_time = std::max(max_time, rec.time_);
+			}
+
+			//
+			//	sort by series and time
+			//
+			std::vector<std::size_t> order(records_.size());
+			std::iota(order.begin(), order.end(), 0);
+			std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+				return std::make_tuple(keys[a].first, keys[a].second, records_[a].unit_, records_[a].scaler_, records_[a].time_)
+					< std::make_tuple(keys[b].first, keys[b].second, records_[b].unit_, records_[b].scaler_, records_[b].time_);
+			});
+
+			std::vector<series> series_list;
+			for (auto const idx : order) {
+				auto const& rec = records_[idx];
+				if (series_list.empty()
+					|| series_list.back().server_ != keys[idx].first
+					|| series_list.back().code_ != keys[idx].second
+					|| series_list.back().unit_ != rec.unit_
+					|| series_list.back().scaler_ != rec.scaler_) {
+					series_list.push_back(series{ keys[idx].first, keys[idx].second, rec.unit_, rec.scaler_, 0 });
+				}
+				++series_list.back().size_;
+			}
+
+			//
+			//	dictionary section
+			//
+			std::string dict;
+			put_varint(dict, server_list.size());
+			for (auto const& server : server_list) {
+				put_varint(dict, server.size());
+				dict.append(server);
+			}
+			put_varint(dict, code_list.size());
+			for (auto const& code : code_list) {
+				auto const buffer = code.to_buffer();
+				dict.append(buffer.begin(), buffer.end());
+			}
+			put_varint(dict, series_list.size());
+			for (auto const& s : series_list) {
+				put_varint(dict, s.server_);
+				put_varint(dict, s.code_);
+				dict.push_back(static_cast<char>(s.unit_));
+				dict.push_back(static_cast<char>(s.scaler_));
+				put_varint(dict, s.size_);
+			}
+
+			//
+			//	column section
+			//
+			std::string times, values, status;
+			auto pos = order.begin();
+			for (auto const& s : series_list) {
+				std::int64_t prev_time = min_time, prev_delta = 0, prev_value = 0;
+				for (std::size_t idx = 0; idx < s.size_; ++idx, ++pos) {
+					auto const& rec = records_[*pos];
+
+					auto const delta = sub(rec.time_, prev_time);
+					put_varint(times, zigzag(sub(delta, prev_delta)));
+					prev_delta = delta;
+					prev_time = rec.time_;
+
+					put_varint(values, zigzag(sub(rec.value_, prev_value)));
+					prev_value = rec.value_;
+				}
+			}
+
+			for (auto run = order.begin(); run != order.end(); ) {
+				auto const value = records_[*run].status_;
+				auto next = std::find_if(run, order.end(), [&](std::size_t idx) {
+					return records_[idx].status_ != value;
+				});
+				put_varint(status, std::distance(run, next));
+				put_varint(status, value);
+				run = next;
+			}
+
+			//
+			//	header
+			//
+			std::string header(chunk_magic, sizeof(chunk_magic));
+			header.push_back(static_cast<char>(chunk_version));
+			put_fixed(header, static_cast<std::uint64_t>(min_time), 8);
+			put_fixed(header, static_cast<std::uint64_t>(max_time), 8);
+			put_fixed(header, records_.size(), 4);
+			put_fixed(header, dict.size(), 4);
+			put_fixed(header, times.size() + values.size() + status.size(), 4);
+
+			os.write(header.data(), header.size());
+			os.write(dict.data(), dict.size());
+			os.write(times.data(), times.size());
+			os.write(values.data(), values.size());
+			os.write(status.data(), status.size());
+
+			records_.clear();
+		}
+
+		archive_stats::archive_stats()
+			: chunks_(0)
+			, skipped_(0)
+			, records_(0)
+			, matches_(0)
+		{}
+
+		bool scan_archive(std::istream& is
+			, archive_filter const& filter
+			, std::function<void(archive_record const&)> cb
+			, archive_stats& stats)
+		{
+			std::string dict, columns;
+			for (;;) {
+
+				char header[chunk_header_size];
+				is.read(header, chunk_header_size);
+				if (is.gcount() == 0 && is.eof())	return true;
+				if (static_cast<std::size_t>(is.gcount()) != chunk_header_size)	return false;
+				if (!std::equal(chunk_magic, chunk_magic + sizeof(chunk_magic), header))	return false;
+				if (static_cast<std::uint8_t>(header[4]) != chunk_version)	return false;
+
+				auto const min_time = static_cast<std::int64_t>(get_fixed(header + 5, 8));
+				auto const max_time = static_cast<std::int64_t>(get_fixed(header + 13, 8));
+				auto const size = static_cast<std::size_t>(get_fixed(header + 21, 4));
+				auto const dict_size = static_cast<std::size_t>(get_fixed(header + 25, 4));
+				auto const column_size = static_cast<std::size_t>(get_fixed(header + 29, 4));
+
+				++stats.chunks_;
+
+				//
+				//	time index
+				//
+				if (!filter.overlaps(min_time, max_time)) {
+					++stats.skipped_;
+					skip_section(is, dict_size + column_size);
+					continue;
+				}
+
+				//
+				//	dictionary
+				//
+				if (!read_section(is, dict, dict_size))	return false;
+				cursor dc(dict);
+
+				//
+				//	min. size of an element: server (length), OBIS code (6 bytes),
+				//	series (server, code, unit, scaler, size)
+				//
+				std::vector<std::string> server_list(dc.count(1));
+				for (auto& server : server_list) {
+					server = dc.bytes(dc.varint());
+				}
+				std::vector<obis> code_list(dc.count(std::tuple_size<obis::data_type>::value));
+				for (auto& code : code_list) {
+					obis::data_type d;
+					for (auto& c : d)	c = dc.byte();
+					code = obis(d);
+				}
+				std::vector<series> series_list(dc.count(5));
+				std::size_t total{ 0 };
+				bool selected{ false };
+				for (auto& s : series_list) {
+					s.server_ = static_cast<std::size_t>(dc.varint());
+					s.code_ = static_cast<std::size_t>(dc.varint());
+					s.unit_ = dc.byte();
+					s.scaler_ = static_cast<std::int8_t>(dc.byte());
+					s.size_ = static_cast<std::size_t>(dc.varint());
+					if (!dc.good() || s.server_ >= server_list.size() || s.code_ >= code_list.size() || s.size_ > size - total)	return false;
+					total += s.size_;
+					selected = selected || (filter.match_server(server_list.at(s.server_)) && filter.match_code(code_list.at(s.code_)));
+				}
+				if (!dc.good() || total != size)	return false;
+
+				if (!selected) {
+					++stats.skipped_;
+					skip_section(is, column_size);
+					continue;
+				}
+
+				//
+				//	columns
+				//
+				//
+				//	each record takes at least two bytes (time and value)
+				//
+				if (size > column_size / 2)	return false;
+				if (!read_section(is, columns, column_size))	return false;
+				cursor cc(columns);
+
+				std::vector<std::int64_t> times;
+				times.reserve(size);
+				for (auto const& s : series_list) {
+					std::int64_t prev_time = min_time, prev_delta = 0;
+					for (std::size_t idx = 0; idx < s.size_; ++idx) {
+						prev_delta = add(prev_delta, cc.svarint());
+						prev_time = add(prev_time, prev_delta);
+						times.push_back(prev_time);
+					}
+				}
+
+				std::vector<std::int64_t> values;
+				values.reserve(size);
+				for (auto const& s : series_list) {
+					std::int64_t prev_value = 0;
+					for (std::size_t idx = 0; idx < s.size_; ++idx) {
+						prev_value = add(prev_value, cc.svarint());
+						values.push_back(prev_value);
+					}
+				}
+
+				std::vector<std::uint64_t> status;
+				status.reserve(size);
+				while (status.size() < size && cc.good()) {
+					auto const run = cc.varint();
+					auto const value = cc.varint();
+					if (run == 0 || run > size - status.size())	return false;
+					status.insert(status.end(), static_cast<std::size_t>(run), value);
+				}
+				if (!cc.good())	return false;
+
+				std::size_t row{ 0 };
+				for (auto const& s : series_list) {
+					auto const& server = server_list.at(s.server_);
+					auto const& code = code_list.at(s.code_);
+					for (std::size_t idx = 0; idx < s.size_; ++idx, ++row) {
+						++stats.records_;
+						archive_record const rec{ server, code, times.at(row), values.at(row), s.scaler_, s.unit_, status.at(row) };
+						if (filter.match(rec)) {
+							++stats.matches_;
+							cb(rec);
+						}
+					}
+				}
+			}
+			return true;
+		}
+	}
+}
@@ -0,0 +1,280 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#include <smf/sml/exporter/archive_sml_exporter.h>
+#include <smf/sml/srv_id_io.h>
+
+#include <cyng/numeric_cast.hpp>
+#include <cyng/value_cast.hpp>
+#include <cyng/chrono.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace node
+{
+	namespace sml
+	{
+		namespace
+		{
+			bool is_integer(std::size_t tag)
+			{
+				switch (tag) {
+				case cyng::TC_INT8:
+				case cyng::TC_INT16:
+				case cyng::TC_INT32:
+				case cyng::TC_INT64:
+				case cyng::TC_UINT8:
+				case cyng::TC_UINT16:
+				case cyng::TC_UINT32:
+				case cyng::TC_UINT64:
+					return true;
+				default:
+					break;
+				}
+				return false;
+			}
+		}
+
+		archive_exporter::archive_exporter(output_files& files
+			, boost::filesystem::path root_dir
+			, std::string prefix
+			, std::string suffix
+			, std::size_t chunk_size)
+		: files_(files)
+			, root_dir_(root_dir)
+			, prefix_(prefix)
+			, suffix_(suffix)
+			, chunk_size_(std::max<std::size_t>(chunk_size, 1u))
+			, chunks_()
+		{}
+
+		archive_exporter::~archive_exporter()
+		{
+			flush();
+		}
+
+		void archive_exporter::read(cyng::tuple_t const& msg, std::size_t idx)
+		{
+			read_msg(msg.begin(), msg.end(), idx);
+		}
+
+		void archive_exporter::flush(std::chrono::seconds max_age)
+		{
+			auto const now = std::chrono::steady_clock::now();
+			for (auto pos = chunks_.begin(); pos != chunks_.end(); ) {
+				if (now - pos->second.since_ >= max_age) {
+					write(pos->first, pos->second.chunk_);
+					pos = chunks_.erase(pos);
+				}
+				else {
+					++pos;
+				}
+			}
+		}
+
+		void archive_exporter::flush()
+		{
+			for (auto& c : chunks_) {
+				write(c.first, c.second.chunk_);
+			}
+			chunks_.clear();
+		}
+
+		std::size_t archive_exporter::size() const
+		{
+			std::size_t size{ 0 };
+			for (auto const& c : chunks_) {
+				size += c.second.chunk_.size();
+			}
+			return size;
+		}
+
+		void archive_exporter::write(boost::filesystem::path const& p, archive_chunk& chunk)
+		{
+			if (!chunk.empty()) {
+				chunk.write(files_.open(p));
+			}
+		}
+
+		void archive_exporter::read_msg(cyng::tuple_t::const_iterator pos, cyng::tuple_t::const_iterator end, std::size_t idx)
+		{
+			std::size_t count = std::distance(pos, end);
+			BOOST_ASSERT_MSG(count == 5, "SML message");
+			if (count != 5)	return;
+
+			//
+			//	(1) transaction id, (2) groupNo, (3) abortOnError
+			//
+			std::advance(pos, 3);
+
+			//
+			//	(4/5) CHOICE - msg type
+			//
+			cyng::tuple_t choice;
+			choice = cyng::value_cast(*pos, choice);
+			BOOST_ASSERT_MSG(choice.size() == 2, "CHOICE");
+			if (choice.size() == 2)
+			{
+				read_body(choice.front(), choice.back());
+			}
+		}
+
+		void archive_exporter::read_body(cyng::object type, cyng::object body)
+		{
+			auto const code = cyng::value_cast<std::uint16_t>(type, 0);
+			if (code == BODY_GET_PROFILE_LIST_RESPONSE) {
+
+				cyng::tuple_t tpl;
+				tpl = cyng::value_cast(body, tpl);
+				read_get_profile_list_response(tpl.begin(), tpl.end());
+			}
+		}
+
+		void archive_exporter::read_get_profile_list_response(cyng::tuple_t::const_iterator pos, cyng::tuple_t::const_iterator end)
+		{
+			std::size_t count = std::distance(pos, end);
+			BOOST_ASSERT_MSG(count == 9, "Get Profile List Response");
+			if (count != 9)	return;
+
+			//
+			//	serverId
+			//
+			cyng::buffer_t server_id;
+			server_id = cyng::value_cast(*pos++, server_id);
+
+			//
+			//	actTime
+			//
+			auto const act_time = read_time(*pos++);
+
+			//
+			//	regPeriod
+			//
+			++pos;
+
+			//
+			//	parameterTreePath (OBIS) - profile
+			//
+			cyng::tuple_t path;
+			path = cyng::value_cast(*pos++, path);
+			auto const profile = path.empty()
+				? obis()
+				: read_obis(path.front());
+
+			//
+			//	valTime - timestamp of the values
+			//
+			auto const val_time = read_time(*pos++);
+
+			//
+			//	M-bus status
+			//
+			auto const status = cyng::numeric_cast<std::uint64_t>(*pos++, 0u);
+
+			//
+			//	without a timestamp the readings cannot be archived
+			//
+			if (!val_time.second && !act_time.second)	return;
+			auto const time = val_time.second
+				? val_time.first
+				: act_time.first;
+
+			auto const server = from_server_id(server_id);
+			auto const p = root_dir_ / get_archive_filename(prefix_, suffix_, profile, time);
+
+			auto res = chunks_.emplace(p, pending{ archive_chunk(), std::chrono::steady_clock::now() });
+			auto& chunk = res.first->second.chunk_;
+
+			//
+			//	period-List
+			//
+			cyng::tuple_t list;
+			list = cyng::value_cast(*pos++, list);
+			for (auto const& obj : list) {
+
+				cyng::tuple_t entry;
+				entry = cyng::value_cast(obj, entry);
+				if (entry.size() != 5)	continue;
+
+				auto it = entry.begin();
+				auto const code = read_obis(*it++);
+				auto const unit = cyng::value_cast<std::uint8_t>(*it++, 0);
+				auto const scaler = cyng::numeric_cast<std::int8_t>(*it++, 0);
+				auto const value = *it;
+
+				//
+				//	only integer values
+				//
+				if (!is_integer(value.get_class().tag()))	continue;
+
+				chunk.append(archive_record{ server
+					, code
+					, time
+					, cyng::numeric_cast<std::int64_t>(value, 0)
+					, scaler
+					, unit
+					, status });
+			}
+
+			if (chunk.size() >= chunk_size_) {
+				write(p, chunk);
+				chunks_.erase(res.first);
+			}
+			else if (chunk.empty()) {
+				chunks_.erase(res.first);
+			}
+		}
+
+		std::pair<std::int64_t, bool> archive_exporter::read_time(cyng::object obj)
+		{
+			cyng::tuple_t choice;
+			choice = cyng::value_cast(obj, choice);
+			if (choice.size() == 2)
+			{
+				auto code = cyng::value_cast<std::uint8_t>(choice.front(), 0);
+				if (code == TIME_TIMESTAMP) {
+					return std::make_pair(static_cast<std::int64_t>(cyng::value_cast<std::uint32_t>(choice.back(), 0)), true);
+				}
+			}
+			return std::make_pair(0, false);
+		}
+
+		obis archive_exporter::read_obis(cyng::object obj)
+		{
+			cyng::buffer_t tmp;
+			tmp = cyng::value_cast(obj, tmp);
+			return obis(tmp);
+		}
+
+		boost::filesystem::path get_archive_filename(std::string prefix
+			, std::string suffix
+			, obis profile
+			, std::int64_t time)
+		{
+			std::tm tm = cyng::chrono::convert_utc(static_cast<std::time_t>(time));
+
+			std::stringstream ss;
+			ss
+				<< prefix
+				<< '-'
+				<< profile.to_str()
+				<< '-'
+				<< std::setfill('0')
+				<< cyng::chrono::year(tm)
+				<< std::setw(2)
+				<< cyng::chrono::month(tm)
+				<< std::setw(2)
+				<< cyng::chrono::day(tm)
+				<< '.'
+				<< suffix
+				;
+			return ss.str();
+		}
+	}	//	sml
+}
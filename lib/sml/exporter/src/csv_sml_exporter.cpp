@@ -27,11 +27,13 @@ namespace node
 	namespace sml
 	{
 
-		csv_exporter::csv_exporter(boost::filesystem::path root_dir
+		csv_exporter::csv_exporter(output_files& files
+			, boost::filesystem::path root_dir
 			, std::string prefix
 			, std::string suffix
 			, bool header)
-		: root_dir_(root_dir)
+		: files_(files)
+			, root_dir_(root_dir)
 			, prefix_(prefix)
 			, suffix_(suffix)
 			, header_(header)
@@ -40,19 +42,21 @@ namespace node
 			, target_()
 			, rgn_()
 			, ro_(rgn_())
-			, ofstream_()
+			, file_()
 		{
 			reset();
 		}
 
-		csv_exporter::csv_exporter(boost::filesystem::path root_dir
+		csv_exporter::csv_exporter(output_files& files
+			, boost::filesystem::path root_dir
 			, std::string prefix
 			, std::string suffix
 			, bool header
 			, std::uint32_t source
 			, std::uint32_t channel
 			, std::string const& target)
-		: root_dir_(root_dir)
+		: files_(files)
+			, root_dir_(root_dir)
 			, prefix_(prefix)
 			, suffix_(suffix)
 			, header_(header)
@@ -61,7 +65,7 @@ namespace node
 			, target_(target)
 			, rgn_()
 			, ro_(rgn_())
-			, ofstream_()
+			, file_()
 		{
 			reset();
 		}
@@ -77,9 +81,9 @@ namespace node
 
 		void csv_exporter::write_header()
 		{
-			ofstream_
+			files_.open(file_)
 				<< "pk;idx;obis;value;unit"
-				<< std::endl
+				<< '\n'
 				;
 		}
 
@@ -161,7 +165,7 @@ namespace node
 				break;
 			case BODY_CLOSE_RESPONSE:
 				//cyng::xml::write(node.append_child("data"), body);
-				if (ofstream_.is_open())	ofstream_.close();
+				if (!file_.empty())	files_.close(file_);
 				break;
 			case BODY_GET_PROFILE_PACK_REQUEST:
 				//cyng::xml::write(node.append_child("data"), body);
@@ -287,7 +291,7 @@ namespace node
 
 			const std::string server_id = cyng::io::to_hex(ro_.server_id_);
 
-			ofstream_.open((root_dir_ / get_csv_filename(prefix_ + server_id, suffix_, source_, channel_, target_)).string());
+			file_ = root_dir_ / get_csv_filename(prefix_ + server_id, suffix_, source_, channel_, target_);
 
 			if (header_) {
 				header_ = false;
@@ -503,7 +507,7 @@ namespace node
 			//	, ro_.get_value("value"));	//	formatted value
 
 
-			ofstream_
+			files_.open(file_)
 				<< ro_.pk_
 				<< ";"
 				<< ro_.trx_
@@ -513,7 +517,7 @@ namespace node
 				<< cyng::io::to_str(ro_.get_value("value"))
 				<< ";"
 				<< get_unit_name(unit)
-				<< std::endl
+				<< '\n'
 				;
 		}
 
@@ -0,0 +1,188 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#include <smf/sml/exporter/output_files.h>
+#include <boost/predef.h>
+#include <algorithm>
+#include <iterator>
+
+#if BOOST_OS_WINDOWS
+#include <io.h>
+#include <fcntl.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace node
+{
+	namespace sml
+	{
+		namespace
+		{
+			/**
+			 * write all data of the file to the storage device
+			 */
+			void sync_file(std::string const& path)
+			{
+#if BOOST_OS_WINDOWS
+				int const fd = ::_open(path.c_str(), _O_WRONLY | _O_BINARY);
+				if (fd != -1) {
+					::_commit(fd);
+					::_close(fd);
+				}
+#else
+				int const fd = ::open(path.c_str(), O_WRONLY);
+				if (fd != -1) {
+					::fsync(fd);
+					::close(fd);
+				}
+#endif
+			}
+		}
+
+		output_files::output_files(std::size_t max_open
+			, std::size_t buffer_size
+			, std::chrono::seconds idle_timeout
+			, std::chrono::seconds sync_interval)
+		: max_open_(std::max<std::size_t>(max_open, 1u))
+			, buffer_size_(buffer_size)
+			, idle_timeout_(idle_timeout)
+			, sync_interval_(sync_interval)
+			, lru_()
+			, index_()
+			, unsynced_()
+			, last_sync_(std::chrono::steady_clock::now())
+			, closed_()
+		{}
+
+		output_files::~output_files()
+		{
+			clear();
+		}
+
+		std::ofstream& output_files::open(boost::filesystem::path const& p, bool truncate)
+		{
+			auto const path = p.string();
+			auto const now = std::chrono::steady_clock::now();
+
+			auto pos = index_.find(path);
+			if (pos != index_.end()) {
+
+				if (!truncate) {
+					//
+					//	most recently used
+					//
+					lru_.splice(lru_.begin(), lru_, pos->second);
+					pos->second->last_use_ = now;
+					return *pos->second->stream_;
+				}
+				remove(pos->second);
+			}
+
+			//
+			//	bound number of open files
+			//
+			while (lru_.size() >= max_open_) {
+				remove(std::prev(lru_.end()));
+			}
+
+			lru_.emplace_front();
+			auto& e = lru_.front();
+			e.path_ = path;
+			e.buffer_.resize(buffer_size_);
+			e.last_use_ = now;
+
+			//
+			//	the buffer must be set before the file is opened
+			//
+			e.stream_.reset(new std::ofstream());
+			if (!e.buffer_.empty()) {
+				e.stream_->rdbuf()->pubsetbuf(e.buffer_.data(), e.buffer_.size());
+			}
+			e.stream_->open(path, std::ios::out | std::ios::binary | (truncate ? std::ios::trunc : std::ios::app));
+
+			if (!e.stream_->is_open()) {
+				lru_.pop_front();
+				return closed_;
+			}
+
+			index_.emplace(path, lru_.begin());
+			if (sync_interval_.count() != 0) {
+				unsynced_.insert(path);
+			}
+			return *e.stream_;
+		}
+
+		void output_files::close(boost::filesystem::path const& p)
+		{
+			auto pos = index_.find(p.string());
+			if (pos != index_.end()) {
+				remove(pos->second);
+			}
+		}
+
+		void output_files::flush()
+		{
+			auto const now = std::chrono::steady_clock::now();
+			for (auto pos = lru_.begin(); pos != lru_.end(); ) {
+				if (now - pos->last_use_ > idle_timeout_) {
+					remove(pos++);
+				}
+				else {
+					pos->stream_->flush();
+					++pos;
+				}
+			}
+
+			if (sync_interval_.count() != 0 && now - last_sync_ >= sync_interval_) {
+				sync();
+			}
+		}
+
+		void output_files::clear()
+		{
+			while (!lru_.empty()) {
+				remove(lru_.begin());
+			}
+			if (sync_interval_.count() != 0) {
+				sync();
+			}
+		}
+
+		std::size_t output_files::size() const
+		{
+			return lru_.size();
+		}
+
+		void output_files::remove(list_t::iterator pos)
+		{
+			//
+			//	close() flushes the buffer
+			//
+			pos->stream_->close();
+			index_.erase(pos->path_);
+			lru_.erase(pos);
+		}
+
+		void output_files::sync()
+		{
+			for (auto const& path : unsynced_) {
+				sync_file(path);
+			}
+			unsynced_.clear();
+
+			//
+			//	open files will be written again
+			//
+			for (auto const& e : lru_) {
+				unsynced_.insert(e.path_);
+			}
+			last_sync_ = std::chrono::steady_clock::now();
+		}
+	}
+}
@@ -30,6 +30,7 @@ namespace node
 		xml_exporter::xml_exporter()
 		: doc_()
 			, root_()
+			, fragment_()
 			, encoding_("UTF-8")
 			, root_name_("SML")
 			, source_(0)
@@ -42,6 +43,7 @@ namespace node
 		xml_exporter::xml_exporter(std::string const& encoding, std::string const& root)
 		: doc_()
 			, root_()
+			, fragment_()
 			, encoding_(encoding)
 			, root_name_(root)
 			, source_(0)
@@ -58,6 +60,7 @@ namespace node
 			, std::string const& target)
 		: doc_()
 			, root_()
+			, fragment_()
 			, encoding_(encoding)
 			, root_name_(root)
 			, source_(source)
@@ -129,19 +132,58 @@ namespace node
 			return doc_.save_file(p.c_str(), PUGIXML_TEXT("  "));
 		}
 
+		void xml_exporter::write(std::ostream& os)
+		{
+			doc_.save(os, PUGIXML_TEXT("  "));
+		}
+
+		void xml_exporter::write_header(std::ostream& os)
+		{
+			//
+			//	same output as doc_.save() up to the first message
+			//
+			os
+				<< "<?xml version=\"1.0\" encoding=\""
+				<< encoding_
+				<< "\" standalone=\"yes\"?>\n<"
+				<< root_name_
+				<< " xmlns:xsi=\"w3.org/2001/XMLSchema-instance\">\n"
+				;
+
+			for (auto const& node : root_.children()) {
+				node.print(os, PUGIXML_TEXT("  "), pugi::format_default, pugi::encoding_auto, 1);
+			}
+		}
+
+		void xml_exporter::write(std::ostream& os, cyng::tuple_t const& msg, std::size_t idx)
+		{
+			read_msg(fragment_, msg.begin(), msg.end(), idx);
+			fragment_.first_child().print(os, PUGIXML_TEXT("  "), pugi::format_default, pugi::encoding_auto, 1);
+			fragment_.reset();
+		}
+
+		void xml_exporter::write_footer(std::ostream& os)
+		{
+			os
+				<< "</"
+				<< root_name_
+				<< ">\n"
+				;
+		}
+
 		void xml_exporter::read(cyng::tuple_t const& msg, std::size_t idx)
 		{
 			//std::string s = std::to_string(idx);
-			read_msg(msg.begin(), msg.end(), idx);
+			read_msg(root_, msg.begin(), msg.end(), idx);
 		}
 
-		void xml_exporter::read_msg(cyng::tuple_t::const_iterator pos, cyng::tuple_t::const_iterator end, std::size_t idx)
+		void xml_exporter::read_msg(pugi::xml_node parent, cyng::tuple_t::const_iterator pos, cyng::tuple_t::const_iterator end, std::size_t idx)
 		{
 			std::size_t count = std::distance(pos, end);
 			BOOST_ASSERT_MSG(count == 5, "SML message");
 			boost::ignore_unused(count);	//	release version
 			
-			auto msg = root_.append_child("msg");
+			auto msg = parent.append_child("msg");
 			msg.append_attribute("idx").set_value(idx);
 
 			//
@@ -41,6 +41,7 @@ set (sml_generator
 	src/main/include/smf/sml/protocol/generator.h
 	src/main/include/smf/sml/protocol/value.hpp
 	src/main/include/smf/sml/protocol/reader.h
+	src/main/include/smf/sml/protocol/request_template.h
 
 	lib/sml/protocol/src/parser.cpp
 	lib/sml/protocol/src/serializer.cpp
@@ -48,6 +49,7 @@ set (sml_generator
 	lib/sml/protocol/src/generator.cpp
 	lib/sml/protocol/src/value.cpp
 	lib/sml/protocol/src/reader.cpp
+	lib/sml/protocol/src/request_template.cpp
 )
 
 set (sml_parser
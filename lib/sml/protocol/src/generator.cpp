@@ -8,6 +8,7 @@
 #include <smf/sml/protocol/generator.h>
 #include <smf/sml/protocol/message.h>
 #include <smf/sml/protocol/serializer.h>
+#include <smf/sml/protocol/request_template.h>
 #include <smf/sml/protocol/value.hpp>
 #include <smf/sml/crc16.h>
 #include <smf/sml/obis_db.h>
@@ -82,6 +83,82 @@ namespace node
 			return msg_.size();
 		}
 
+		std::size_t generator::append_msg(cyng::buffer_t&& msg)
+		{
+			msg_.push_back(std::move(msg));
+			return msg_.size();
+		}
+
+		namespace
+		{
+			//
+			//	Preserialized requests that are sent frequently.
+			//	The first two slots are always trx and group number.
+			//
+
+			request_template const& open_request_template()
+			{
+				static request_template const tpl = request_template(BODY_OPEN_REQUEST, 7)
+					.append(cyng::make_object())	//	codepage
+					.slot(request_template::SLOT_OCTET)	//	client id
+					.slot(request_template::SLOT_OCTET)	//	req file id
+					.slot(request_template::SLOT_OCTET)	//	server id
+					.slot(request_template::SLOT_OCTET)	//	name
+					.slot(request_template::SLOT_OCTET)	//	pwd
+					.append(cyng::make_object())	//	sml-Version
+					;
+				return tpl;
+			}
+
+			request_template const& close_request_template()
+			{
+				static request_template const tpl = request_template(BODY_CLOSE_REQUEST, 1)
+					.append(cyng::make_object())	//	signature
+					;
+				return tpl;
+			}
+
+			request_template const& get_proc_parameter_template()
+			{
+				static request_template const tpl = request_template(BODY_GET_PROC_PARAMETER_REQUEST, 5)
+					.slot(request_template::SLOT_OCTET)	//	server id
+					.slot(request_template::SLOT_OCTET)	//	username
+					.slot(request_template::SLOT_OCTET)	//	password
+					.list(1).slot(request_template::SLOT_OCTET)	//	path entry
+					.append(cyng::make_object())	//	attribute
+					;
+				return tpl;
+			}
+
+			request_template const& get_list_template()
+			{
+				static request_template const tpl = request_template(BODY_GET_LIST_REQUEST, 5)
+					.slot(request_template::SLOT_OCTET)	//	client id
+					.slot(request_template::SLOT_OCTET)	//	server id
+					.slot(request_template::SLOT_OCTET)	//	username
+					.slot(request_template::SLOT_OCTET)	//	password
+					.slot(request_template::SLOT_OCTET)	//	list name
+					;
+				return tpl;
+			}
+
+			request_template const& get_profile_list_template()
+			{
+				static request_template const tpl = request_template(BODY_GET_PROFILE_LIST_REQUEST, 9)
+					.slot(request_template::SLOT_OCTET)	//	server id
+					.slot(request_template::SLOT_OCTET)	//	username
+					.slot(request_template::SLOT_OCTET)	//	password
+					.append(cyng::make_object(false))	//	with raw data
+					.slot(request_template::SLOT_TIMESTAMP)	//	begin time
+					.slot(request_template::SLOT_TIMESTAMP)	//	end time
+					.list(1).slot(request_template::SLOT_OCTET)	//	path entry
+					.list(0)	//	object list
+					.list(0)	//	details
+					;
+				return tpl;
+			}
+		}
+
 
 		req_generator::req_generator()
 			: generator()
@@ -94,39 +171,25 @@ namespace node
 			, std::string const& pwd)
 		{
 			BOOST_ASSERT_MSG(msg_.empty(), "pending SML data");
-			return append_msg(message(cyng::make_object(*trx_)	//	trx
+			return append_msg(open_request_template().render({ *trx_	//	trx
 				, group_no_++	//	group
-				, 0 // abort code
-				, BODY_OPEN_REQUEST
-
-				//
-				//	generate public open request
-				//
-				, open_request(cyng::make_object()	// codepage
-					, cyng::make_object(client_id.to_buffer())	// clientId
-					, cyng::make_object(gen_file_id())	//	req file id
-					, cyng::make_object(server_id)	//	server id
-					, cyng::make_object(name)	//	name
-					, cyng::make_object(pwd)	//	pwd
-					, cyng::make_object()	// sml-Version 
-				)
-			));
+				, client_id.to_buffer()	//	clientId
+				, gen_file_id()	//	req file id
+				, server_id
+				, name
+				, pwd }));
 		}
 
 		std::size_t req_generator::public_close()
 		{
 			++trx_;
-			return append_msg(message(cyng::make_object(*trx_)
-				, 0	//	group is 0 for CLOSE REQUEST
-				, 0 //	abort code
-				, BODY_CLOSE_REQUEST
+			return append_msg(close_request_template().render({ *trx_
+				, static_cast<std::uint8_t>(0) }));	//	group is 0 for CLOSE REQUEST
+		}
 
-				//
-				//	generate public open response
-				//
-				, close_response(cyng::make_object()
-				)
-			));
+		std::string req_generator::get_trx() const
+		{
+			return *trx_;
 		}
 
 		std::size_t req_generator::set_proc_parameter_restart(cyng::buffer_t const& server_id
@@ -457,20 +520,12 @@ namespace node
 			, std::string const& password)
 		{
 			++trx_;
-			return append_msg(message(cyng::make_object(*trx_)
+			return append_msg(get_proc_parameter_template().render({ *trx_
 				, group_no_++	//	group
-				, 0 //	abort code
-				, BODY_GET_PROC_PARAMETER_REQUEST	//	0x500
-
-				//
-				//	generate get process parameter request
-				//
-				, get_proc_parameter_request(cyng::make_object(server_id)
-					, username
-					, password
-					, code)
-				)
-			);
+				, server_id
+				, username
+				, password
+				, code }));
 		}
 
 		std::size_t req_generator::get_list(cyng::buffer_t const& client_id
@@ -480,22 +535,31 @@ namespace node
 			, obis code)
 		{
 			++trx_;
-			return append_msg(message(cyng::make_object(*trx_)
+			return append_msg(get_list_template().render({ *trx_
 				, group_no_++	//	group
-				, 0 //	abort code
-				, BODY_GET_LIST_REQUEST	//	0x700
-
-				//
-				//	generate get list request
-				//
-				, get_list_request(cyng::make_object(client_id)
-					, cyng::make_object(server_id)
-					, username
-					, password
-					, code)
-				)
-			);
+				, client_id
+				, server_id
+				, username
+				, password
+				, code }));
+		}
 
+		std::size_t req_generator::get_profile_list(cyng::buffer_t const& server_id
+			, std::string const& username
+			, std::string const& password
+			, std::chrono::system_clock::time_point begin_time
+			, std::chrono::system_clock::time_point end_time
+			, obis code)
+		{
+			++trx_;
+			return append_msg(get_profile_list_template().render({ *trx_
+				, group_no_++	//	group
+				, server_id
+				, username
+				, password
+				, begin_time
+				, end_time
+				, code }));
 		}
 
 		std::size_t req_generator::get_proc_parameter_srv_visible(cyng::buffer_t const& srv
@@ -0,0 +1,207 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#include <smf/sml/protocol/request_template.h>
+#include <smf/sml/protocol/serializer.h>
+#include <smf/sml/crc16.h>
+#include <cyng/factory.h>
+#include <sstream>
+#include <limits>
+#include <boost/assert.hpp>
+
+namespace node
+{
+	namespace sml
+	{
+		namespace
+		{
+			/**
+			 * TL field of an octet string. The length includes
+			 * the TL field itself.
+			 */
+			void append_length_field(cyng::buffer_t& buf, std::size_t size)
+			{
+				std::size_t count = 1;
+				std::size_t length = size + count;
+				while (length > (std::size_t(1) << (4 * count)) - 1) {
+					++count;
+					length = size + count;
+				}
+
+				while (count-- != 0) {
+					std::uint8_t tl = (length >> (4 * count)) & 0x0F;
+					if (count != 0)	tl |= 0x80;	//	continuation bit
+					buf.push_back(tl);
+				}
+			}
+
+			/**
+			 * Same encoding as serializer<std::uint32_t>:
+			 * use as few bytes as possible.
+			 */
+			void append_uint32(cyng::buffer_t& buf, std::uint32_t v)
+			{
+				if (v < std::numeric_limits<std::uint8_t>::max()) {
+					buf.insert(buf.end(), { 0x62, static_cast<char>(v) });
+				}
+				else if (v < std::numeric_limits<std::uint16_t>::max()) {
+					buf.insert(buf.end(), { 0x63
+						, static_cast<char>(v >> 8)
+						, static_cast<char>(v) });
+				}
+				else if (v < std::numeric_limits<std::uint32_t>::max() / 0x100) {
+					buf.insert(buf.end(), { 0x64
+						, static_cast<char>(v >> 16)
+						, static_cast<char>(v >> 8)
+						, static_cast<char>(v) });
+				}
+				else {
+					buf.insert(buf.end(), { 0x65
+						, static_cast<char>(v >> 24)
+						, static_cast<char>(v >> 16)
+						, static_cast<char>(v >> 8)
+						, static_cast<char>(v) });
+				}
+			}
+
+			void append_value(cyng::buffer_t& buf, request_template::value const& v)
+			{
+				switch (v.type_) {
+				case request_template::SLOT_OCTET:
+					append_length_field(buf, v.size_);
+					buf.insert(buf.end(), v.data_, v.data_ + v.size_);
+					break;
+				case request_template::SLOT_UINT8:
+					buf.insert(buf.end(), { 0x62, static_cast<char>(v.num_) });
+					break;
+				case request_template::SLOT_TIMESTAMP:
+					//	list of 2: choice TIME_TIMESTAMP and value
+					buf.insert(buf.end(), { 0x72, 0x62, static_cast<char>(TIME_TIMESTAMP) });
+					append_uint32(buf, v.num_);
+					break;
+				default:
+					BOOST_ASSERT_MSG(false, "unknown slot type");
+					break;
+				}
+			}
+		}
+
+		request_template::value::value(std::string const& str)
+			: type_(SLOT_OCTET)
+			, data_(str.data())
+			, size_(str.size())
+			, num_(0)
+		{}
+
+		request_template::value::value(cyng::buffer_t const& buf)
+			: type_(SLOT_OCTET)
+			, data_(buf.data())
+			, size_(buf.size())
+			, num_(0)
+		{}
+
+		request_template::value::value(obis const& code)
+			: type_(SLOT_OCTET)
+			, data_(reinterpret_cast<char const*>(code.data().data()))
+			, size_(code.size())
+			, num_(0)
+		{}
+
+		request_template::value::value(std::uint8_t v)
+			: type_(SLOT_UINT8)
+			, data_(nullptr)
+			, size_(0)
+			, num_(v)
+		{}
+
+		request_template::value::value(std::chrono::system_clock::time_point tp)
+			: type_(SLOT_TIMESTAMP)
+			, data_(nullptr)
+			, size_(0)
+			//	UNIX timestamp - Y2K38 problem (same as make_timestamp())
+			, num_(static_cast<std::uint32_t>(std::chrono::system_clock::to_time_t(tp)))
+		{}
+
+		request_template::request_template(sml_messages_enum type, std::size_t count)
+			: skeleton_()
+			, slots_()
+		{
+			list(6);
+			slot(SLOT_OCTET);	//	trx
+			slot(SLOT_UINT8);	//	group
+			append(cyng::make_object(static_cast<std::uint8_t>(0)));	//	abort code
+
+			//	choice + body
+			list(2);
+			append(cyng::make_object(static_cast<std::uint16_t>(type)));
+			list(count);
+		}
+
+		request_template& request_template::list(std::size_t count)
+		{
+			BOOST_ASSERT_MSG(count < 0x10, "list too long");
+			skeleton_.push_back(static_cast<char>(0x70 | (count & 0x0F)));
+			return *this;
+		}
+
+		request_template& request_template::append(cyng::object obj)
+		{
+			std::ostringstream os;
+			serialize(os, obj);
+			auto const s = os.str();
+			skeleton_.insert(skeleton_.end(), s.begin(), s.end());
+			return *this;
+		}
+
+		request_template& request_template::slot(slot_type type)
+		{
+			slots_.push_back({ skeleton_.size(), type });
+			return *this;
+		}
+
+		std::size_t request_template::slots() const
+		{
+			return slots_.size();
+		}
+
+		cyng::buffer_t request_template::render(std::initializer_list<value> values) const
+		{
+			BOOST_ASSERT_MSG(values.size() == slots_.size(), "wrong number of slot values");
+
+			//
+			//	reserve enough space for the values and the
+			//	CRC16 with end of message (4 bytes)
+			//
+			std::size_t size = skeleton_.size() + 4;
+			for (auto const& v : values) {
+				size += v.size_ + 8;
+			}
+
+			cyng::buffer_t buf;
+			buf.reserve(size);
+
+			auto pos = values.begin();
+			std::size_t offset = 0;
+			for (auto const& s : slots_) {
+				buf.insert(buf.end(), skeleton_.begin() + offset, skeleton_.begin() + s.offset_);
+				offset = s.offset_;
+				if (pos != values.end()) {
+					BOOST_ASSERT_MSG(pos->type_ == s.type_, "wrong slot type");
+					append_value(buf, *pos++);
+				}
+			}
+			buf.insert(buf.end(), skeleton_.begin() + offset, skeleton_.end());
+
+			//
+			//	placeholder for CRC16 and end of message
+			//
+			buf.insert(buf.end(), { 0x63, 0x00, 0x00, 0x00 });
+			sml_set_crc16(buf);
+			return buf;
+		}
+	}
+}
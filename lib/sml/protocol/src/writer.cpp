@@ -21,57 +21,31 @@ namespace node
 		{
 			BOOST_ASSERT_MSG((type == 0x70) || (type == 0x00), "invalid type mask");
 
-			if (length > 0xF)
+			//
+			//	Count the required TL bytes. The length of an octet string
+			//	includes the TL field and contains one TL byte already.
+			//	Each additional TL byte increases the length, which in turn
+			//	may require another TL byte. The length of a list is the
+			//	number of elements.
+			//
+			std::size_t count = 1;
+			while (count < 2 * sizeof(length) && (length >> (4 * count)) != 0)
 			{
-				//
-				// maximal count of shifts that are necesarry
-				//
-				int shifts = (sizeof(std::uint32_t) * 2) - 1;
-
-				//
-				//	get upper limit - this is log8()
-				//
-				std::uint32_t mask = 0xF0000000;
-				while (shifts != 0)
-				{
-					if ((length & mask) != 0)	break;
-
-					mask >>= 4;
-					shifts--;
-				}
-
-				//std::cout << std::dec << shifts << " shift(s) required, mask = " << std::hex << mask << std::endl;
-
-				while (shifts-- != 0)
-				{
-					//
-					//	get bits for TL field
-					//
-					std::uint8_t tl = (length & mask);
-					if (tl > 0x0F)
-					{
-						tl >>= 4;
-					}
-					tl |= 0x80;	//	continuation bit
-					//	ToDo: type mask 0x70 == list of..., 0x00 == octet
-					tl |= type;
-					os.put(tl);
-
-					//std::cout << "write " << std::hex << (+tl) << std::endl;
-
-					mask >>= 4;
-					length++;
-				}
+				++count;
+				if (type == 0x00)	++length;
 			}
 
 			//
-			//	write last element + type info
+			//	Most significant nibble first. The type info is part of
+			//	the first TL byte only.
 			//
-			std::uint8_t tl = (length & 0x0000000F);
-			tl |= type;
-			os.put(tl);
-			//std::cout << "write " << std::hex << (+tl) << std::endl;
-
+			while (count-- != 0)
+			{
+				std::uint8_t tl = (length >> (4 * count)) & 0x0F;
+				if (count != 0)	tl |= 0x80;	//	continuation bit
+				os.put(tl | type);
+				type = 0x00;
+			}
 		}
 
 		std::ostream& serializer <cyng::eod>::write(std::ostream& os, cyng::eod v)
@@ -21,6 +21,7 @@
 #include <cyng/dom/reader.h>
 #include <cyng/dom/tree_walker.h>
 #include <cyng/vector_cast.hpp>
+#include <cyng/numeric_cast.hpp>
 #include <cyng/rnd.h>
 
 #if BOOST_OS_WINDOWS
@@ -229,7 +230,9 @@ namespace node
 						cyng::param_factory("redirect", cyng::vector_factory({
 							cyng::param_factory("/", "/index.html")
 						})),
-						cyng::param_factory("https-rewrite", false)	//	301 - Moved Permanently
+						cyng::param_factory("https-rewrite", false),	//	301 - Moved Permanently
+						cyng::param_factory("body-limit", 64u * 1024u * 1024u),	//	max. request body size in bytes
+						cyng::param_factory("spool-threshold", 1024u * 1024u)	//	uploaded files larger than this are written to disk
 					))
 
 					, cyng::param_factory("cluster", cyng::vector_factory({ cyng::tuple_factory(
@@ -432,6 +435,10 @@ namespace node
 			CYNG_LOG_WARNING(logger, "HTTPS rewrite is active");
 		}
 
+		auto const body_limit = cyng::numeric_cast<std::uint64_t>(dom.get("body-limit"), 64u * 1024u * 1024u);
+		auto const spool_threshold = cyng::numeric_cast<std::size_t>(dom.get("spool-threshold"), 1024u * 1024u);
+		CYNG_LOG_INFO(logger, "body limit: " << body_limit << " bytes, spool threshold: " << spool_threshold << " bytes");
+
 		//
 		//	get blacklisted addresses
 		//
@@ -460,7 +467,9 @@ namespace node
 			, ad
 #endif
 			, blacklist
-			, https_rewrite);
+			, https_rewrite
+			, body_limit
+			, spool_threshold);
 
 	}
 
@@ -40,7 +40,9 @@ namespace node
 		, auth_dirs const& ad
 #endif
 		, std::set<boost::asio::ip::address> const& blacklist
-		, bool https_rewrite)
+		, bool https_rewrite
+		, std::uint64_t body_limit
+		, std::size_t spool_threshold)
 	: base_(*btp)
 		, uidgen_()
 		, bus_(bus_factory(btp->mux_, logger, cluster_tag, btp->get_id()))
@@ -57,8 +59,10 @@ namespace node
 #endif
 			, blacklist
 			, bus_->vm_
-			, https_rewrite)
-		, dispatcher_(logger, server_.get_cm())
+			, https_rewrite
+			, body_limit
+			, spool_threshold)
+		, dispatcher_(logger, server_.get_cm(), btp->mux_.get_io_service())
 		, db_sync_(logger, cache_)
 		, forward_(logger, cache_, server_.get_cm())
 		, form_data_(logger)
@@ -197,6 +201,11 @@ namespace node
         //
         stop_sys_task();
 
+		//
+		//	stop publishing table changes
+		//
+		dispatcher_.stop();
+
 		//
 		//	stop server
 		//
@@ -438,6 +447,15 @@ namespace node
 			CYNG_LOG_TRACE(logger_, "ws.read - pull channel [" << channel << "]");
 			dispatcher_.pull(cache_, channel, tag_ws);
 		}
+		else if (boost::algorithm::equals(cmd, "query"))
+		{
+			CYNG_LOG_TRACE(logger_, "ws.read - query channel [" << channel << "]");
+
+			//
+			//	send a single page of a table
+			//
+			dispatcher_.query(cache_, channel, tag_ws, reader);
+		}
 		else if (boost::algorithm::equals(cmd, "insert"))
 		{
 			node::fwd_insert(logger_
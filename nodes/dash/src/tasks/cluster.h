@@ -47,6 +47,8 @@ namespace node
 #endif
 			, std::set<boost::asio::ip::address> const&
 			, bool https_rewrite
+			, std::uint64_t body_limit
+			, std::size_t spool_threshold
 		);
 		cyng::continuation run();
 		void stop();
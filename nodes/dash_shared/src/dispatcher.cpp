@@ -9,17 +9,55 @@
 #include <cyng/json.h>
 #include <cyng/io/serializer.h>
 #include <cyng/tuple_cast.hpp>
+#include <cyng/numeric_cast.hpp>
 #include <cyng/sys/memory.h>
 
 #include <boost/algorithm/string.hpp>
-#include <boost/core/ignore_unused.hpp>
 
 namespace node 
 {
-	dispatcher::dispatcher(cyng::logging::log_ptr logger, connection_manager_interface& cm)
+	namespace
+	{
+		/**
+		 * @return table name of a channel that supports paged queries
+		 */
+		std::string get_table_name(std::string const& channel)
+		{
+			if (boost::algorithm::starts_with(channel, "config.device"))	return "TDevice";
+			if (boost::algorithm::starts_with(channel, "config.gateway"))	return "TGateway";
+			if (boost::algorithm::starts_with(channel, "config.meter"))	return "TMeter";
+			if (boost::algorithm::starts_with(channel, "config.lora"))	return "TLoRaDevice";
+			if (boost::algorithm::starts_with(channel, "status.session"))	return "_Session";
+			if (boost::algorithm::starts_with(channel, "status.target"))	return "_Target";
+			if (boost::algorithm::starts_with(channel, "status.connection"))	return "_Connection";
+			if (boost::algorithm::starts_with(channel, "status.cluster"))	return "_Cluster";
+			if (boost::algorithm::starts_with(channel, "monitor.msg"))	return "_SysMsg";
+			if (boost::algorithm::starts_with(channel, "monitor.tsdb"))	return "_TimeSeries";
+			if (boost::algorithm::starts_with(channel, "monitor.lora"))	return "_LoRaUplink";
+			if (boost::algorithm::starts_with(channel, "task.csv"))	return "_CSV";
+			return "";
+		}
+	}
+
+	dispatcher::dispatcher(cyng::logging::log_ptr logger, connection_manager_interface& cm, cyng::io_service_t& ios)
 		: logger_(logger)
 		, connection_manager_(cm)
-	{}
+		, publisher_(logger, cm, ios, std::chrono::milliseconds(250), 512)
+		, views_()
+	{
+		//
+		//	the set of views is fixed after construction
+		//	and can be accessed without lock
+		//
+		for (auto const& table : { "TDevice", "TGateway", "TMeter", "TLoRaDevice", "_Session", "_Target", "_Connection", "_Cluster", "_SysMsg", "_TimeSeries", "_LoRaUplink", "_CSV" }) {
+			views_.emplace(table, std::unique_ptr<table_view>(new table_view(table)));
+		}
+	}
+
+	void dispatcher::stop()
+	{
+		publisher_.stop();
+	}
 
 	void dispatcher::register_this(cyng::controller& vm)
 	{
@@ -206,166 +244,90 @@ namespace node
 		, std::uint64_t gen
 		, boost::uuids::uuid source)
 	{
+		invalidate(tbl->meta().get_name());
+
 		cyng::table::record rec(tbl->meta_ptr(), key, data, gen);
 
 		if (boost::algorithm::equals(tbl->meta().get_name(), "TDevice"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("insert")),
-				cyng::param_factory("channel", "config.device"),
-				cyng::param_factory("rec", rec.convert()));
+			publisher_.insert("config.device", key, rec.convert());
 
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("config.device", msg);
-
-			update_channel("table.device.count", tbl->size());
+			publisher_.count("table.device.count", tbl->size());
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "TGateway"))
 		{
 			//	data: {"cmd": "insert", "channel": "config.device", "rec": {"key": {"pk":"0b5c2a64-5c48-48f1-883b-e5be3a3b1e3d"}, "data": {"creationTime":"2018-02-04 15:31:34.00000000","descr":"comment #55","enabled":true,"id":"ID","msisdn":"1055","name":"device-55","pwd":"crypto","query":6,"vFirmware":"v55"}, "gen": 55}}
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("insert")),
-				cyng::param_factory("channel", "config.gateway"),
-				cyng::param_factory("rec", rec.convert()));
+			publisher_.insert("config.gateway", key, rec.convert());
 
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("config.gateway", msg);
-
-			update_channel("table.gateway.count", tbl->size());
+			publisher_.count("table.gateway.count", tbl->size());
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "TMeter"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("insert")),
-				cyng::param_factory("channel", "config.meter"),
-				cyng::param_factory("rec", rec.convert()));
+			publisher_.insert("config.meter", key, rec.convert());
 
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("config.meter", msg);
-
-			update_channel("table.meter.count", tbl->size());
+			publisher_.count("table.meter.count", tbl->size());
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "TLoRaDevice"))
 		{
 			//	
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("insert")),
-				cyng::param_factory("channel", "config.lora"),
-				cyng::param_factory("rec", rec.convert()));
+			publisher_.insert("config.lora", key, rec.convert());
 
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("config.lora", msg);
-
-			update_channel("table.LoRa.count", tbl->size());
+			publisher_.count("table.LoRa.count", tbl->size());
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "_Session"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("insert")),
-				cyng::param_factory("channel", "status.session"),
-				cyng::param_factory("rec", rec.convert()));
+			publisher_.insert("status.session", key, rec.convert());
 
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("status.session", msg);
-
-			update_channel("table.session.count", tbl->size());
+			publisher_.count("table.session.count", tbl->size());
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "_Target"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("insert")),
-				cyng::param_factory("channel", "status.target"),
-				cyng::param_factory("rec", rec.convert()));
+			publisher_.insert("status.target", key, rec.convert());
 
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("status.target", msg);
-
-			update_channel("table.target.count", tbl->size());
+			publisher_.count("table.target.count", tbl->size());
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "_Connection"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("insert")),
-				cyng::param_factory("channel", "status.connection"),
-				cyng::param_factory("rec", rec.convert()));
+			publisher_.insert("status.connection", key, rec.convert());
 
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("status.connection", msg);
-
-			update_channel("table.connection.count", tbl->size());
+			publisher_.count("table.connection.count", tbl->size());
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "_Cluster"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("insert")),
-				cyng::param_factory("channel", "status.cluster"),
-				cyng::param_factory("rec", rec.convert()));
+			publisher_.insert("status.cluster", key, rec.convert());
 
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("status.cluster", msg);
-
-			update_channel("table.cluster.count", tbl->size());
+			publisher_.count("table.cluster.count", tbl->size());
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "_Config"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("insert")),
-				cyng::param_factory("channel", "config.sys"),
-				cyng::param_factory("rec", rec.convert()));
-
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("config.sys", msg);
+			publisher_.insert("config.sys", key, rec.convert());
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "_SysMsg"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("insert")),
-				cyng::param_factory("channel", "monitor.msg"),
-				cyng::param_factory("rec", rec.convert()));
+			publisher_.insert("monitor.msg", key, rec.convert());
 
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("monitor.msg", msg);
-
-			update_channel("table.msg.count", tbl->size());
+			publisher_.count("table.msg.count", tbl->size());
 
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "_TimeSeries"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("insert")),
-				cyng::param_factory("channel", "monitor.tsdb"),
-				cyng::param_factory("rec", rec.convert()));
+			publisher_.insert("monitor.tsdb", key, rec.convert());
 
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("monitor.tsdb", msg);
-
-			update_channel("table.msg.count", tbl->size());
+			publisher_.count("table.msg.count", tbl->size());
 
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "_LoRaUplink"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("insert")),
-				cyng::param_factory("channel", "monitor.lora"),
-				cyng::param_factory("rec", rec.convert()));
+			publisher_.insert("monitor.lora", key, rec.convert());
 
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("monitor.lora", msg);
-
-			update_channel("table.uplink.count", tbl->size());
+			publisher_.count("table.uplink.count", tbl->size());
 
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "_CSV"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("insert")),
-				cyng::param_factory("channel", "task.csv"),
-				cyng::param_factory("rec", rec.convert()));
+			publisher_.insert("task.csv", key, rec.convert());
 
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("task.csv", msg);
-
-			update_channel("table.csv.count", tbl->size());
+			publisher_.count("table.csv.count", tbl->size());
 
 		}
 		else
@@ -377,142 +339,72 @@ namespace node
 
 	void dispatcher::sig_del(cyng::store::table const* tbl, cyng::table::key_type const& key, boost::uuids::uuid source)
 	{
+		invalidate(tbl->meta().get_name());
+
 		if (boost::algorithm::equals(tbl->meta().get_name(), "TDevice"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("delete")),
-				cyng::param_factory("channel", "config.device"),
-				cyng::param_factory("key", key));
+			publisher_.remove("config.device", key);
 
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("config.device", msg);
-
-			update_channel("table.device.count", tbl->size());
+			publisher_.count("table.device.count", tbl->size());
 
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "TGateway"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("delete")),
-				cyng::param_factory("channel", "config.gateway"),
-				cyng::param_factory("key", key));
-
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("config.gateway", msg);
-			update_channel("table.gateway.count", tbl->size());
+			publisher_.remove("config.gateway", key);
+			publisher_.count("table.gateway.count", tbl->size());
 
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "TMeter"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("delete")),
-				cyng::param_factory("channel", "config.meter"),
-				cyng::param_factory("key", key));
-
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("config.meter", msg);
-			update_channel("table.meter.count", tbl->size());
+			publisher_.remove("config.meter", key);
+			publisher_.count("table.meter.count", tbl->size());
 
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "TLoRaDevice"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("delete")),
-				cyng::param_factory("channel", "config.lora"),
-				cyng::param_factory("key", key));
-
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("config.lora", msg);
-			update_channel("table.LoRa.count", tbl->size());
+			publisher_.remove("config.lora", key);
+			publisher_.count("table.LoRa.count", tbl->size());
 
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "_Session"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("delete")),
-				cyng::param_factory("channel", "status.session"),
-				cyng::param_factory("key", key));
+			publisher_.remove("status.session", key);
 
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("status.session", msg);
-
-			update_channel("table.session.count", tbl->size());
+			publisher_.count("table.session.count", tbl->size());
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "_Target"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("delete")),
-				cyng::param_factory("channel", "status.target"),
-				cyng::param_factory("key", key));
-
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("status.target", msg);
+			publisher_.remove("status.target", key);
 
-			update_channel("table.target.count", tbl->size());
+			publisher_.count("table.target.count", tbl->size());
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "_Connection"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("delete")),
-				cyng::param_factory("channel", "status.connection"),
-				cyng::param_factory("key", key));
+			publisher_.remove("status.connection", key);
 
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("status.connection", msg);
-
-			update_channel("table.connection.count", tbl->size());
+			publisher_.count("table.connection.count", tbl->size());
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "_Cluster"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("delete")),
-				cyng::param_factory("channel", "status.cluster"),
-				cyng::param_factory("key", key));
-
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("status.cluster", msg);
+			publisher_.remove("status.cluster", key);
 
-			update_channel("table.cluster.count", tbl->size());
+			publisher_.count("table.cluster.count", tbl->size());
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "_SysMsg"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("delete")),
-				cyng::param_factory("channel", "monitor.msg"),
-				cyng::param_factory("key", key));
-
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("monitor.msg", msg);
+			publisher_.remove("monitor.msg", key);
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "_TimeSeries"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("delete")),
-				cyng::param_factory("channel", "monitor.tsdb"),
-				cyng::param_factory("key", key));
-
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("monitor.tsdb", msg);
+			publisher_.remove("monitor.tsdb", key);
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "_LoRaUplink"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("delete")),
-				cyng::param_factory("channel", "monitor.lora"),
-				cyng::param_factory("key", key));
-
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("monitor.lora", msg);
+			publisher_.remove("monitor.lora", key);
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "_CSV"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("delete")),
-				cyng::param_factory("channel", "task.csv"),
-				cyng::param_factory("key", key));
-
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("task.csv", msg);
+			publisher_.remove("task.csv", key);
 		}
 		else
 		{
@@ -523,111 +415,63 @@ namespace node
 
 	void dispatcher::sig_clr(cyng::store::table const* tbl, boost::uuids::uuid source)
 	{
+		invalidate(tbl->meta().get_name());
+
 		if (boost::algorithm::equals(tbl->meta().get_name(), "TDevice"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("clear")),
-				cyng::param_factory("channel", "config.device"));
-
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("config.device", msg);
+			publisher_.clear("config.device");
 
-			update_channel("table.device.count", tbl->size());
+			publisher_.count("table.device.count", tbl->size());
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "TGateway"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("clear")),
-				cyng::param_factory("channel", "config.gateway"));
-
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("config.gateway", msg);
-			update_channel("table.gateway.count", tbl->size());
+			publisher_.clear("config.gateway");
+			publisher_.count("table.gateway.count", tbl->size());
 
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "TMeter"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("clear")),
-				cyng::param_factory("channel", "config.meter"));
-
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("config.meter", msg);
-			update_channel("table.meter.count", tbl->size());
+			publisher_.clear("config.meter");
+			publisher_.count("table.meter.count", tbl->size());
 
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "_Session"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("clear")),
-				cyng::param_factory("channel", "status.session"));
+			publisher_.clear("status.session");
 
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("status.session", msg);
-
-			update_channel("table.session.count", tbl->size());
+			publisher_.count("table.session.count", tbl->size());
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "_Target"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("clear")),
-				cyng::param_factory("channel", "status.target"));
-
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("status.target", msg);
+			publisher_.clear("status.target");
 
-			update_channel("table.target.count", tbl->size());
+			publisher_.count("table.target.count", tbl->size());
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "_Connection"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("clear")),
-				cyng::param_factory("channel", "status.connection"));
+			publisher_.clear("status.connection");
 
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("status.connection", msg);
-
-			update_channel("table.connection.count", tbl->size());
+			publisher_.count("table.connection.count", tbl->size());
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "_Cluster"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("clear")),
-				cyng::param_factory("channel", "status.cluster"));
-
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("status.cluster", msg);
+			publisher_.clear("status.cluster");
 
-			update_channel("table.cluster.count", tbl->size());
+			publisher_.count("table.cluster.count", tbl->size());
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "_SysMsg"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("clear")),
-				cyng::param_factory("channel", "monitor.msg"));
-
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("monitor.msg", msg);
+			publisher_.clear("monitor.msg");
 
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "_TimeSeries"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("clear")),
-				cyng::param_factory("channel", "monitor.tsdb"));
-
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("monitor.tsdb", msg);
+			publisher_.clear("monitor.tsdb");
 
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "_LoRaUplink"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("clear")),
-				cyng::param_factory("channel", "monitor.lora"));
-
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("monitor.lora", msg);
+			publisher_.clear("monitor.lora");
 
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "_Config"))
@@ -636,12 +480,7 @@ namespace node
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "_CSV"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("clear")),
-				cyng::param_factory("channel", "task.csv"));
-
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("task.csv", msg);
+			publisher_.clear("task.csv");
 		}
 		else
 		{
@@ -665,115 +504,54 @@ namespace node
 		//
 		auto pm = tbl->meta().to_param_map(attr);
 
+		auto pos = views_.find(tbl->meta().get_name());
+		if (pos != views_.end()) {
+			std::vector<std::string> columns;
+			for (auto const& param : pm) {
+				columns.push_back(param.first);
+			}
+			pos->second->modify(key, columns);
+		}
+
 		if (boost::algorithm::equals(tbl->meta().get_name(), "TDevice"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("modify")),
-				cyng::param_factory("channel", "config.device"),
-				cyng::param_factory("key", key),
-				cyng::param_factory("value", pm));
-
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("config.device", msg);
+			publisher_.modify("config.device", key, pm);
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "TGateway"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("modify")),
-				cyng::param_factory("channel", "config.gateway"),
-				cyng::param_factory("key", key),
-				cyng::param_factory("value", pm));
-
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("config.gateway", msg);
+			publisher_.modify("config.gateway", key, pm);
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "TMeter"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("modify")),
-				cyng::param_factory("channel", "config.meter"),
-				cyng::param_factory("key", key),
-				cyng::param_factory("value", pm));
-
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("config.meter", msg);
+			publisher_.modify("config.meter", key, pm);
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "TLoRaDevice"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("modify")),
-				cyng::param_factory("channel", "config.lora"),
-				cyng::param_factory("key", key),
-				cyng::param_factory("value", pm));
-
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("config.lora", msg);
+			publisher_.modify("config.lora", key, pm);
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "_Session"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("modify")),
-				cyng::param_factory("channel", "status.session"),
-				cyng::param_factory("key", key),
-				cyng::param_factory("value", pm));
-
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("status.session", msg);
+			publisher_.modify("status.session", key, pm);
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "_Target"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("modify")),
-				cyng::param_factory("channel", "status.target"),
-				cyng::param_factory("key", key),
-				cyng::param_factory("value", pm));
-
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("status.target", msg);
+			publisher_.modify("status.target", key, pm);
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "_Connection"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("modify")),
-				cyng::param_factory("channel", "status.connection"),
-				cyng::param_factory("key", key),
-				cyng::param_factory("value", pm));
-
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("status.connection", msg);
+			publisher_.modify("status.connection", key, pm);
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "_Cluster"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("modify")),
-				cyng::param_factory("channel", "status.cluster"),
-				cyng::param_factory("key", key),
-				cyng::param_factory("value", pm));
-
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("status.cluster", msg);
+			publisher_.modify("status.cluster", key, pm);
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "_Config"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("modify")),
-				cyng::param_factory("channel", "config.system"),
-				cyng::param_factory("key", key),
-				cyng::param_factory("value", pm));
-
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("config.system", msg);
+			publisher_.modify("config.system", key, pm);
 		}
 		else if (boost::algorithm::equals(tbl->meta().get_name(), "_CSV"))
 		{
-			auto tpl = cyng::tuple_factory(
-				cyng::param_factory("cmd", std::string("modify")),
-				cyng::param_factory("channel", "task.csv"),
-				cyng::param_factory("key", key),
-				cyng::param_factory("value", pm));
-
-			auto msg = cyng::json::to_string(tpl);
-			connection_manager_.push_event("task.csv", msg);
+			publisher_.modify("task.csv", key, pm);
 		}
 		else
 		{
@@ -1021,64 +799,131 @@ namespace node
 		connection_manager_.add_channel(tag, channel);
 
 		//
-		//	send initial data set of device table
+		//	Copy the records and release the table before
+		//	sending anything. Writers are blocked only for
+		//	the time it takes to copy the table.
 		//
+		std::vector<cyng::table::record> records;
 		db.access([&](cyng::store::table const* tbl) {
+			records.reserve(tbl->size());
+			tbl->loop([&](cyng::table::record const& rec) -> bool {
+				records.push_back(rec);
+				return true;	//	continue
+			});
+		}, cyng::store::read_access(table));
 
-			//
-			//	inform client that data upload is starting
-			//
-			display_loading_icon(tag, true, channel);
-
-			//
-			//	get total record size
-			//
-			auto size{ tbl->size() };
-			std::size_t percent{ 0 }, idx{ 0 };
-
-			//
-			//	upload data
-			//
-			const auto counter = tbl->loop([&](cyng::table::record const& rec) -> bool {
+		//
+		//	inform client that data upload is starting
+		//
+		display_loading_icon(tag, true, channel);
 
-				CYNG_LOG_TRACE(logger_, "ws.read - insert " << table << cyng::io::to_str(rec.key()));
+		//
+		//	upload data in blocks of 256 records
+		//
+		std::size_t percent{ 0 };
+		cyng::vector_t items;
+		for (std::size_t idx = 0; idx < records.size(); ++idx) {
 
-				auto tpl = cyng::tuple_factory(
-					cyng::param_factory("cmd", std::string("insert")),
-					cyng::param_factory("channel", channel),
-					cyng::param_factory("rec", rec.convert()));
+			items.push_back(cyng::tuple_factory(
+				cyng::param_factory("cmd", std::string("insert")),
+				cyng::param_factory("channel", channel),
+				cyng::param_factory("rec", records.at(idx).convert())));
 
-				auto msg = cyng::json::to_string(tpl);
-				connection_manager_.ws_msg(tag, msg);
+			if (items.size() == 256 || idx + 1 == records.size()) {
 
-				++idx;
+				connection_manager_.ws_msg(tag, cyng::json::to_string(cyng::make_object(items)));
+				items.clear();
 
 				//
 				//	calculate charge status in percent
 				//
-				const auto prev_percent = percent;
-				percent = (100u * idx) / size;
-
+				auto const prev_percent = percent;
+				percent = (100u * (idx + 1)) / records.size();
 				if (prev_percent != percent) {
 					display_loading_level(tag, percent, channel);
+				}
+			}
+		}
+		CYNG_LOG_INFO(logger_, records.size() << ' ' << table << " records sent");
+
+		//
+		//	inform client that data upload is finished
+		//
+		display_loading_icon(tag, false, channel);
+	}
+
+	void dispatcher::query(cyng::store::db& db, std::string const& channel, boost::uuids::uuid tag, cyng::reader<cyng::object> const& reader)
+	{
+		//	{"cmd":"query", "channel":"config.device", "draw":1, "start":0, "length":25, "order":"name", "dir":"asc", "search":"", "columns":["name","msisdn"]}
+		auto pos = views_.find(get_table_name(channel));
+		if (pos == views_.end()) {
+			CYNG_LOG_WARNING(logger_, "ws.read - channel [" << channel << "] doesn't support queries");
+			return;
+		}
 
-					//
-					//	give GUI a change to refresh
-					//
-					std::this_thread::sleep_for(std::chrono::milliseconds(12));
+		table_view::query q;
+		q.start_ = cyng::numeric_cast<std::size_t>(reader.get("start"), 0u);
+		q.length_ = cyng::numeric_cast<std::size_t>(reader.get("length"), 25u);
+		q.order_ = cyng::value_cast<std::string>(reader.get("order"), "");
+		q.ascending_ = !boost::algorithm::equals(cyng::value_cast<std::string>(reader.get("dir"), "asc"), "desc");
+		q.search_ = cyng::value_cast<std::string>(reader.get("search"), "");
+
+		cyng::vector_t tmp;
+		tmp = cyng::value_cast(reader.get("columns"), tmp);
+		for (auto const& col : tmp) {
+			q.columns_.push_back(cyng::value_cast<std::string>(col, ""));
+		}
+
+		auto const r = pos->second->select(db, q);
+
+		//
+		//	visible columns only
+		//
+		cyng::vector_t rows;
+		std::vector<cyng::table::key_type> keys;
+		rows.reserve(r.rows_.size());
+		keys.reserve(r.rows_.size());
+		for (auto const& rec : r.rows_) {
+			keys.push_back(rec.key());
+			if (q.columns_.empty()) {
+				rows.push_back(rec.convert());
+			}
+			else {
+				auto const obj = rec.convert();
+				auto const dom = cyng::make_reader(obj);
+				cyng::param_map_t data;
+				for (auto const& col : q.columns_) {
+					data.emplace(col, rec[col]);
 				}
+				rows.push_back(cyng::param_map_factory("key", dom.get("key"))("data", data)("gen", dom.get("gen"))());
+			}
+		}
 
-				return true;	//	continue
-			});
-			BOOST_ASSERT(counter == 0);
-			boost::ignore_unused(counter);	//	release version
-			CYNG_LOG_INFO(logger_, tbl->size() << ' ' << tbl->meta().get_name() << " records sent");
-
-			//
-			//	inform client that data upload is finished
-			//
-			display_loading_icon(tag, false, channel);
-		}, cyng::store::read_access(table));
+		//
+		//	live updates for this page only
+		//
+		publisher_.window(tag, channel, keys);
+
+		CYNG_LOG_TRACE(logger_, "ws.read - query " << channel << " => " << rows.size() << '/' << r.filtered_ << '/' << r.total_);
+
+		auto tpl = cyng::tuple_factory(
+			cyng::param_factory("cmd", std::string("page")),
+			cyng::param_factory("channel", channel),
+			cyng::param_t("draw", reader.get("draw")),
+			cyng::param_factory("start", q.start_),
+			cyng::param_factory("total", r.total_),
+			cyng::param_factory("filtered", r.filtered_),
+			cyng::param_factory("rows", rows));
+
+		connection_manager_.ws_msg(tag, cyng::json::to_string(tpl));
+	}
+
+	void dispatcher::invalidate(std::string const& table)
+	{
+		auto pos = views_.find(table);
+		if (pos != views_.end()) {
+			pos->second->invalidate();
+		}
 	}
 
 	void dispatcher::subscribe_table_device_count(cyng::store::db& db, std::string const& channel, boost::uuids::uuid tag)
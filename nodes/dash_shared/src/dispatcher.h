@@ -8,17 +8,21 @@
 #ifndef NODE_HTTP_DISPATCHER_H
 #define NODE_HTTP_DISPATCHER_H
 
+#include "publisher.h"
+#include "table_view.h"
 #include <smf/http/srv/cm_interface.h>
 #include <cyng/log.h>
 #include <cyng/store/db.h>
 #include <cyng/vm/controller.h>
+#include <cyng/dom/reader.h>
+#include <memory>
 
 namespace node 
 {
 	class dispatcher
 	{
 	public:
-		dispatcher(cyng::logging::log_ptr, connection_manager_interface&);
+		dispatcher(cyng::logging::log_ptr, connection_manager_interface&, cyng::io_service_t&);
 
 		void register_this(cyng::controller&);
 
@@ -27,6 +31,11 @@ namespace node
 		 */
 		void subscribe(cyng::store::db&);
 
+		/**
+		 * stop publishing table changes
+		 */
+		void stop();
+
 		/**
 		 * Update a channel with a specific size/count information. Mostly table size information.
 		 */
@@ -42,6 +51,13 @@ namespace node
 		 */
 		void pull(cyng::store::db&, std::string const& channel, boost::uuids::uuid tag);
 
+		/**
+		 * Paged, sorted and filtered request from ws. Replies with
+		 * a single "page" message and limits live updates of the
+		 * channel to the rows of this page.
+		 */
+		void query(cyng::store::db&, std::string const& channel, boost::uuids::uuid tag, cyng::reader<cyng::object> const&);
+
 	private:
 		void sig_ins(cyng::store::table const*
 			, cyng::table::key_type const&
@@ -57,6 +73,12 @@ namespace node
 			, boost::uuids::uuid);
 
 		void subscribe(cyng::store::db&, std::string table, std::string const& channel, boost::uuids::uuid tag);
+
+		/**
+		 * Mark cached view of the table as outdated
+		 */
+		void invalidate(std::string const& table);
+
 		void display_loading_icon(boost::uuids::uuid tag, bool, std::string const&);
 		void display_loading_level(boost::uuids::uuid tag, std::size_t, std::string const&);
 
@@ -87,6 +109,16 @@ namespace node
 		cyng::logging::log_ptr logger_;
 		connection_manager_interface & connection_manager_;
 
+		/**
+		 * Table changes are coalesced and published periodically
+		 */
+		publisher publisher_;
+
+		/**
+		 * table name => sorted view for paged queries
+		 */
+		std::map<std::string, std::unique_ptr<table_view>> views_;
+
 	};
 }
 
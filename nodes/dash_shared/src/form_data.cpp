@@ -24,6 +24,7 @@ namespace node
 	{
 		vm.register_function("http.upload.start", 2, std::bind(&form_data::http_upload_start, this, std::placeholders::_1));
 		vm.register_function("http.upload.data", 5, std::bind(&form_data::http_upload_data, this, std::placeholders::_1));
+		vm.register_function("http.upload.file", 5, std::bind(&form_data::http_upload_file, this, std::placeholders::_1));
 		vm.register_function("http.upload.var", 3, std::bind(&form_data::http_upload_var, this, std::placeholders::_1));
 		vm.register_function("http.upload.progress", 4, std::bind(&form_data::http_upload_progress, this, std::placeholders::_1));
 		vm.register_function("http.upload.complete", 4, std::bind(&form_data::http_upload_complete, this, std::placeholders::_1));
@@ -116,6 +117,54 @@ namespace node
 		}
 	}
 
+	void form_data::http_upload_file(cyng::context& ctx)
+	{
+		//	http.upload.file - [ecf139d4-184e-441d-a857-9d02eb58148b,devConf_0,device_localhost.xml,text/xml,/tmp/smf-upload-8f3a-....tmp]
+		//
+		//	Large uploads are already spooled into a temporary file
+		//	by the HTTP session.
+		//
+		//	* session tag
+		//	* variable name
+		//	* file name
+		//	* mime type
+		//	* path of temporary file
+		//	
+		const cyng::vector_t frame = ctx.get_frame();
+		auto const tpl = cyng::tuple_cast<
+			boost::uuids::uuid,	//	[0] session tag
+			std::string,		//	[1] variable name
+			std::string,		//	[2] file name
+			std::string,		//	[3] mime type
+			std::string			//	[4] temporary file
+		>(frame);
+
+		auto pos = data_.find(std::get<0>(tpl));
+		if (pos != data_.end()) {
+			CYNG_LOG_TRACE(logger_, "http.upload.file - "
+				<< std::get<0>(tpl)
+				<< ", "
+				<< std::get<1>(tpl)
+				<< ", "
+				<< std::get<2>(tpl)
+				<< ", mime type: "
+				<< std::get<3>(tpl)
+				<< " => "
+				<< std::get<4>(tpl));
+
+			pos->second.emplace(std::get<1>(tpl), std::get<4>(tpl));
+			pos->second.emplace(std::get<2>(tpl), std::get<3>(tpl));
+		}
+		else {
+			CYNG_LOG_WARNING(logger_, "http.upload.file - session "
+				<< std::get<0>(tpl)
+				<< " not found");
+
+			boost::system::error_code ec;
+			boost::filesystem::remove(std::get<4>(tpl), ec);
+		}
+	}
+
 	void form_data::http_upload_var(cyng::context& ctx)
 	{
 		//	[5910f652-95ce-4d94-b60f-6ff4a26730ba,smf-upload-config-device-version,v5.0]
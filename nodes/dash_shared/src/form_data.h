@@ -23,6 +23,7 @@ namespace node
 	private:
 		void http_upload_start(cyng::context& ctx);
 		void http_upload_data(cyng::context& ctx);
+		void http_upload_file(cyng::context& ctx);
 		void http_upload_var(cyng::context& ctx);
 		void http_upload_progress(cyng::context& ctx);
 		void http_upload_complete(cyng::context& ctx);
@@ -0,0 +1,348 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#include "publisher.h"
+#include <cyng/json.h>
+#include <cyng/factory/set_factory.h>
+
+namespace node
+{
+	publisher::publisher(cyng::logging::log_ptr logger
+		, connection_manager_interface& cm
+		, cyng::io_service_t& ios
+		, std::chrono::milliseconds window
+		, std::size_t max_pending)
+	: logger_(logger)
+		, connection_manager_(cm)
+		, timer_(ios)
+		, window_(window)
+		, max_pending_(max_pending)
+		, channels_()
+		, windows_()
+		, counts_()
+		, counts_sent_()
+		, pending_(0)
+		, armed_(false)
+		, stopped_(false)
+		, mutex_()
+	{}
+
+	void publisher::insert(std::string const& channel
+		, cyng::table::key_type const& key
+		, cyng::object rec)
+	{
+		bool early{ false };
+		{
+			cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+			auto& c = lookup(channel, key);
+			c.rec_ = rec;
+			c.values_.clear();
+			early = schedule();
+		}
+		if (early)	flush();
+	}
+
+	void publisher::modify(std::string const& channel
+		, cyng::table::key_type const& key
+		, cyng::param_map_t const& values)
+	{
+		bool early{ false };
+		{
+			cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+			auto& c = lookup(channel, key);
+
+			//
+			//	later values win
+			//
+			for (auto const& v : values) {
+				c.values_[v.first] = v.second;
+			}
+			early = schedule();
+		}
+		if (early)	flush();
+	}
+
+	void publisher::remove(std::string const& channel
+		, cyng::table::key_type const& key)
+	{
+		bool early{ false };
+		{
+			cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+			auto& c = lookup(channel, key);
+			if (c.rec_.is_null()) {
+				//	record existed before this window
+				c.deleted_ = true;
+			}
+			//	else: inserted and deleted in the same window
+			c.rec_ = cyng::make_object();
+			c.values_.clear();
+			early = schedule();
+		}
+		if (early)	flush();
+	}
+
+	void publisher::clear(std::string const& channel)
+	{
+		bool early{ false };
+		{
+			cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+			auto& chan = channels_[channel];
+
+			//
+			//	all pending changes are obsolete
+			//
+			pending_ -= chan.changes_.size();
+			chan.changes_.clear();
+			chan.index_.clear();
+			chan.cleared_ = true;
+			early = schedule();
+		}
+		if (early)	flush();
+	}
+
+	void publisher::window(boost::uuids::uuid tag
+		, std::string const& channel
+		, std::vector<cyng::table::key_type> const& keys)
+	{
+		std::set<std::string> ids;
+		for (auto const& key : keys) {
+			ids.insert(cyng::json::to_string(key));
+		}
+
+		cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+		windows_[std::make_pair(tag, channel)] = std::move(ids);
+	}
+
+	void publisher::close(boost::uuids::uuid tag)
+	{
+		cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+		remove_windows(tag);
+	}
+
+	void publisher::count(std::string const& channel, std::size_t size)
+	{
+		bool early{ false };
+		{
+			cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+			counts_[channel] = size;
+			early = schedule();
+		}
+		if (early)	flush();
+	}
+
+	void publisher::flush()
+	{
+		std::vector<std::pair<std::string, std::string>> msgs;
+		std::vector<std::pair<boost::uuids::uuid, std::string>> direct;
+		{
+			cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+			msgs = collect(direct);
+		}
+
+		//
+		//	push without holding the lock
+		//
+		for (auto const& msg : msgs) {
+			connection_manager_.push_event(msg.first, msg.second);
+		}
+		for (auto const& msg : direct) {
+			if (!connection_manager_.ws_msg(msg.first, msg.second)) {
+				//	websocket is gone
+				close(msg.first);
+			}
+		}
+	}
+
+	void publisher::stop()
+	{
+		cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+		stopped_ = true;
+		boost::system::error_code ec;
+		timer_.cancel(ec);
+	}
+
+	publisher::change& publisher::lookup(std::string const& channel, cyng::table::key_type const& key)
+	{
+		auto& chan = channels_[channel];
+		auto const id = cyng::json::to_string(key);
+		auto pos = chan.index_.find(id);
+		if (pos != chan.index_.end()) {
+			return chan.changes_.at(pos->second);
+		}
+
+		chan.index_.emplace(id, chan.changes_.size());
+		chan.changes_.emplace_back();
+		chan.changes_.back().key_ = key;
+		chan.changes_.back().id_ = id;
+		++pending_;
+		return chan.changes_.back();
+	}
+
+	bool publisher::schedule()
+	{
+		if (stopped_)	return false;
+
+		//
+		//	flush early - the caller flushes after releasing the lock
+		//
+		if (pending_ >= max_pending_)	return true;
+
+		if (!armed_) {
+			armed_ = true;
+			timer_.expires_after(window_);
+			timer_.async_wait(std::bind(&publisher::on_timer, this, std::placeholders::_1));
+		}
+		return false;
+	}
+
+	void publisher::on_timer(boost::system::error_code const& ec)
+	{
+		if (ec == boost::asio::error::operation_aborted)	return;
+
+		{
+			cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+			armed_ = false;
+			if (stopped_)	return;
+		}
+		flush();
+	}
+
+	std::vector<std::pair<std::string, std::string>> publisher::collect(std::vector<std::pair<boost::uuids::uuid, std::string>>& direct)
+	{
+		std::vector<std::pair<std::string, std::string>> msgs;
+
+		//
+		//	changes of visible rows
+		//
+		for (auto const& w : windows_) {
+			auto pos = channels_.find(w.first.second);
+			if (pos != channels_.end()) {
+				auto msg = collect(pos->first, pos->second, w.second);
+				if (!msg.empty()) {
+					direct.emplace_back(w.first.first, msg);
+				}
+			}
+		}
+
+		for (auto& chan : channels_) {
+
+			cyng::vector_t items;
+			if (chan.second.cleared_) {
+				items.push_back(cyng::tuple_factory(
+					cyng::param_factory("cmd", std::string("clear")),
+					cyng::param_factory("channel", chan.first)));
+			}
+
+			for (auto const& c : chan.second.changes_) {
+				if (c.deleted_) {
+					items.push_back(cyng::tuple_factory(
+						cyng::param_factory("cmd", std::string("delete")),
+						cyng::param_factory("channel", chan.first),
+						cyng::param_factory("key", c.key_)));
+				}
+				if (!c.rec_.is_null()) {
+					items.push_back(cyng::tuple_factory(
+						cyng::param_factory("cmd", std::string("insert")),
+						cyng::param_factory("channel", chan.first),
+						cyng::param_factory("rec", c.rec_)));
+				}
+				if (!c.values_.empty()) {
+					items.push_back(cyng::tuple_factory(
+						cyng::param_factory("cmd", std::string("modify")),
+						cyng::param_factory("channel", chan.first),
+						cyng::param_factory("key", c.key_),
+						cyng::param_factory("value", c.values_)));
+				}
+			}
+
+			if (items.size() == 1) {
+				msgs.emplace_back(chan.first, cyng::json::to_string(items.front()));
+			}
+			else if (!items.empty()) {
+				msgs.emplace_back(chan.first, cyng::json::to_string(cyng::make_object(items)));
+			}
+		}
+		channels_.clear();
+		pending_ = 0;
+
+		//
+		//	send changed counters only
+		//
+		for (auto const& cnt : counts_) {
+			auto pos = counts_sent_.find(cnt.first);
+			if (pos == counts_sent_.end() || pos->second != cnt.second) {
+				msgs.emplace_back(cnt.first, cyng::json::to_string(cyng::tuple_factory(
+					cyng::param_factory("cmd", std::string("update")),
+					cyng::param_factory("channel", cnt.first),
+					cyng::param_factory("value", cnt.second))));
+				counts_sent_[cnt.first] = cnt.second;
+			}
+		}
+		counts_.clear();
+
+		if (!msgs.empty()) {
+			CYNG_LOG_TRACE(logger_, "publish " << msgs.size() << " message(s)");
+		}
+		return msgs;
+	}
+
+	std::string publisher::collect(std::string const& name, channel const& chan, std::set<std::string> const& keys) const
+	{
+		bool reload = chan.cleared_;
+		cyng::vector_t items;
+		for (auto const& c : chan.changes_) {
+			if (c.deleted_ || !c.rec_.is_null()) {
+				reload = true;
+			}
+			else if (!c.values_.empty() && keys.count(c.id_) != 0) {
+				items.push_back(cyng::tuple_factory(
+					cyng::param_factory("cmd", std::string("modify")),
+					cyng::param_factory("channel", name),
+					cyng::param_factory("key", c.key_),
+					cyng::param_factory("value", c.values_)));
+			}
+		}
+
+		if (reload) {
+			//
+			//	client has to request the page again
+			//
+			return cyng::json::to_string(cyng::tuple_factory(
+				cyng::param_factory("cmd", std::string("reload")),
+				cyng::param_factory("channel", name)));
+		}
+		if (items.size() == 1) {
+			return cyng::json::to_string(items.front());
+		}
+		return (items.empty())
+			? std::string()
+			: cyng::json::to_string(cyng::make_object(items))
+			;
+	}
+
+	void publisher::remove_windows(boost::uuids::uuid tag)
+	{
+		auto pos = windows_.lower_bound(std::make_pair(tag, std::string()));
+		while (pos != windows_.end() && pos->first.first == tag) {
+			pos = windows_.erase(pos);
+		}
+	}
+
+	publisher::change::change()
+		: key_()
+		, id_()
+		, deleted_(false)
+		, rec_()
+		, values_()
+	{}
+
+	publisher::channel::channel()
+		: cleared_(false)
+		, index_()
+		, changes_()
+	{}
+}
@@ -0,0 +1,176 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#ifndef NODE_HTTP_PUBLISHER_H
+#define NODE_HTTP_PUBLISHER_H
+
+#include <smf/http/srv/cm_interface.h>
+#include <cyng/log.h>
+#include <cyng/compatibility/io_service.h>
+#include <cyng/compatibility/async.h>
+#include <cyng/intrinsics/sets.h>
+#include <cyng/table/key.hpp>
+
+#include <chrono>
+#include <map>
+#include <set>
+#include <vector>
+
+#include <boost/asio/steady_timer.hpp>
+
+namespace node
+{
+	/**
+	 * Coalesces table changes per channel and pushes them as one
+	 * JSON array per flush to all subscribers.
+	 *
+	 * Changes on the same key within a flush window are folded:
+	 * <ul>
+	 * <li>modify + modify => one modify with merged values</li>
+	 * <li>insert + modify => insert followed by one modify</li>
+	 * <li>insert + delete => nothing</li>
+	 * <li>modify + delete => delete</li>
+	 * </ul>
+	 * Count updates only send the last value of a window.
+	 *
+	 * Websockets that requested a single page of a table (see table_view)
+	 * don't subscribe the channel. They are registered with the keys of
+	 * the visible rows and receive modifications of these rows only.
+	 * Inserts, deletes and clear operations are reported with a
+	 * "reload" command since they move the visible window.
+	 */
+	class publisher
+	{
+		/**
+		 * pending changes of a single record
+		 */
+		struct change
+		{
+			change();
+
+			cyng::table::key_type key_;
+			std::string id_;	//!<	key as JSON string
+			bool deleted_;	//!<	delete before insert/modify
+			cyng::object rec_;	//!<	converted record if inserted
+			cyng::param_map_t values_;	//!<	modified values
+		};
+
+		/**
+		 * pending changes of a channel in order of first appearance
+		 */
+		struct channel
+		{
+			channel();
+
+			bool cleared_;
+			std::map<std::string, std::size_t> index_;
+			std::vector<change> changes_;
+		};
+
+	public:
+		publisher(cyng::logging::log_ptr
+			, connection_manager_interface&
+			, cyng::io_service_t&
+			, std::chrono::milliseconds window
+			, std::size_t max_pending);
+
+		void insert(std::string const& channel
+			, cyng::table::key_type const& key
+			, cyng::object rec);
+		void modify(std::string const& channel
+			, cyng::table::key_type const& key
+			, cyng::param_map_t const& values);
+		void remove(std::string const& channel
+			, cyng::table::key_type const& key);
+		void clear(std::string const& channel);
+
+		/**
+		 * Register the visible rows of a websocket. Replaces a previous
+		 * window of the same websocket and channel.
+		 */
+		void window(boost::uuids::uuid tag
+			, std::string const& channel
+			, std::vector<cyng::table::key_type> const& keys);
+
+		/**
+		 * Remove all windows of the specified websocket
+		 */
+		void close(boost::uuids::uuid tag);
+
+		/**
+		 * Update a channel with a table size
+		 */
+		void count(std::string const& channel, std::size_t size);
+
+		/**
+		 * Send all pending changes
+		 */
+		void flush();
+
+		/**
+		 * stop timer
+		 */
+		void stop();
+
+	private:
+		/**
+		 * @return change record for the specified key. Requires lock.
+		 */
+		change& lookup(std::string const& channel, cyng::table::key_type const& key);
+
+		/**
+		 * Start timer if not running. Requires lock.
+		 *
+		 * @return true if there are to much pending changes and the
+		 * caller has to flush() after releasing the lock.
+		 */
+		bool schedule();
+
+		void on_timer(boost::system::error_code const&);
+
+		/**
+		 * Generate the JSON messages of all pending changes
+		 * and reset the pending state. Requires lock.
+		 *
+		 * @param direct receives the messages for windows
+		 */
+		std::vector<std::pair<std::string, std::string>> collect(std::vector<std::pair<boost::uuids::uuid, std::string>>& direct);
+
+		/**
+		 * @return message for a window or an empty string. Requires lock.
+		 */
+		std::string collect(std::string const& name, channel const&, std::set<std::string> const& keys) const;
+
+		/**
+		 * Requires lock.
+		 */
+		void remove_windows(boost::uuids::uuid tag);
+
+	private:
+		cyng::logging::log_ptr logger_;
+		connection_manager_interface& connection_manager_;
+		boost::asio::steady_timer timer_;
+		std::chrono::milliseconds const window_;
+		std::size_t const max_pending_;
+
+		std::map<std::string, channel> channels_;
+
+		/**
+		 * (websocket, channel) => keys of visible rows
+		 */
+		std::map<std::pair<boost::uuids::uuid, std::string>, std::set<std::string>> windows_;
+		std::map<std::string, std::size_t> counts_;
+		std::map<std::string, std::size_t> counts_sent_;
+		std::size_t pending_;
+		bool armed_;
+		bool stopped_;
+
+		cyng::async::mutex mutex_;
+	};
+}
+
+#endif
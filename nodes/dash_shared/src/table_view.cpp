@@ -0,0 +1,284 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#include "table_view.h"
+#include <cyng/io/serializer.h>
+#include <cyng/numeric_cast.hpp>
+#include <cyng/dom/reader.h>
+#include <cyng/intrinsics/traits/tag.hpp>
+
+#include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace node
+{
+	namespace
+	{
+		bool is_numeric(cyng::object const& obj)
+		{
+			switch (obj.get_class().tag()) {
+			case cyng::TC_INT8:
+			case cyng::TC_INT16:
+			case cyng::TC_INT32:
+			case cyng::TC_INT64:
+			case cyng::TC_UINT8:
+			case cyng::TC_UINT16:
+			case cyng::TC_UINT32:
+			case cyng::TC_UINT64:
+			case cyng::TC_FLOAT:
+			case cyng::TC_DOUBLE:
+				return true;
+			default:
+				break;
+			}
+			return false;
+		}
+	}
+
+	table_view::query::query()
+		: start_(0)
+		, length_(0)
+		, order_()
+		, ascending_(true)
+		, search_()
+		, columns_()
+	{}
+
+	table_view::table_view(std::string const& table)
+		: table_(table)
+		, changes_(0)
+		, mutex_()
+		, snapshot_(0)
+		, valid_(false)
+		, rows_()
+		, index_()
+		, columns_()
+		, texts_()
+		, orders_()
+		, modified_mutex_()
+		, modified_()
+		, modified_columns_()
+	{}
+
+	void table_view::invalidate()
+	{
+		++changes_;
+	}
+
+	void table_view::modify(cyng::table::key_type const& key, std::vector<std::string> const& columns)
+	{
+		cyng::async::lock_guard<cyng::async::mutex> lk(modified_mutex_);
+		modified_.emplace(cyng::io::to_str(key), key);
+		modified_columns_.insert(columns.begin(), columns.end());
+	}
+
+	table_view::result table_view::select(cyng::store::db& db, query const& q)
+	{
+		cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+		refresh(db);
+		patch(db);
+
+		result r;
+		r.total_ = rows_.size();
+		r.filtered_ = 0;
+
+		//
+		//	row sequence
+		//
+		std::vector<std::size_t> natural;
+		if (q.order_.empty()) {
+			natural.resize(rows_.size());
+			std::iota(natural.begin(), natural.end(), 0u);
+		}
+		std::vector<std::size_t> const& seq = (q.order_.empty())
+			? natural
+			: get_order(q.order_)
+			;
+
+		//
+		//	columns to search
+		//
+		auto const needle = boost::algorithm::to_lower_copy(q.search_);
+		std::vector<std::vector<std::string> const*> haystack;
+		if (!needle.empty()) {
+			for (auto const& col : (q.columns_.empty() ? columns_ : q.columns_)) {
+				haystack.push_back(&get_texts(col));
+			}
+		}
+
+		auto const end = (q.length_ == 0)
+			? std::numeric_limits<std::size_t>::max()
+			: q.start_ + q.length_
+			;
+
+		for (std::size_t pos = 0; pos < seq.size(); ++pos) {
+
+			auto const idx = (q.ascending_)
+				? seq.at(pos)
+				: seq.at(seq.size() - pos - 1)
+				;
+
+			if (!needle.empty()) {
+				auto const match = std::any_of(haystack.begin(), haystack.end(), [&](std::vector<std::string> const* texts) {
+					return texts->at(idx).find(needle) != std::string::npos;
+				});
+				if (!match)	continue;
+			}
+
+			if (r.filtered_ >= q.start_ && r.filtered_ < end) {
+				r.rows_.push_back(rows_.at(idx));
+			}
+			++r.filtered_;
+		}
+
+		return r;
+	}
+
+	void table_view::refresh(cyng::store::db& db)
+	{
+		//
+		//	changes_ is read before the table is copied. A change
+		//	in between forces another refresh on the next request.
+		//
+		auto const changes = changes_.load();
+		if (valid_ && changes == snapshot_)	return;
+
+		//
+		//	the copy contains all modifications up to now
+		//
+		{
+			cyng::async::lock_guard<cyng::async::mutex> lk(modified_mutex_);
+			modified_.clear();
+			modified_columns_.clear();
+		}
+
+		rows_.clear();
+		index_.clear();
+		texts_.clear();
+		orders_.clear();
+
+		db.access([&](cyng::store::table const* tbl) {
+			rows_.reserve(tbl->size());
+			tbl->loop([&](cyng::table::record const& rec) -> bool {
+				rows_.push_back(rec);
+				return true;	//	continue
+			});
+		}, cyng::store::read_access(table_));
+
+		for (std::size_t idx = 0; idx < rows_.size(); ++idx) {
+			index_.emplace(cyng::io::to_str(rows_.at(idx).key()), idx);
+		}
+
+		//
+		//	column names of key and body
+		//
+		columns_.clear();
+		if (!rows_.empty()) {
+			auto const dom = cyng::make_reader(rows_.front().convert());
+			for (auto const name : { "key", "data" }) {
+				cyng::param_map_t pm;
+				pm = cyng::value_cast(dom.get(name), pm);
+				for (auto const& param : pm) {
+					columns_.push_back(param.first);
+				}
+			}
+		}
+
+		snapshot_ = changes;
+		valid_ = true;
+	}
+
+	void table_view::patch(cyng::store::db& db)
+	{
+		std::map<std::string, cyng::table::key_type> modified;
+		std::set<std::string> columns;
+		{
+			cyng::async::lock_guard<cyng::async::mutex> lk(modified_mutex_);
+			modified.swap(modified_);
+			columns.swap(modified_columns_);
+		}
+		if (modified.empty())	return;
+
+		std::vector<std::size_t> patched;
+		db.access([&](cyng::store::table const* tbl) {
+			for (auto const& m : modified) {
+				auto pos = index_.find(m.first);
+				if (pos == index_.end())	continue;
+
+				//
+				//	removed records are handled by invalidate()
+				//
+				auto const rec = tbl->lookup(m.second);
+				if (!rec.empty()) {
+					rows_.at(pos->second) = rec;
+					patched.push_back(pos->second);
+				}
+			}
+		}, cyng::store::read_access(table_));
+
+		for (auto const& col : columns) {
+
+			//
+			//	only sort orders of modified columns are outdated
+			//
+			orders_.erase(col);
+
+			auto pos = texts_.find(col);
+			if (pos != texts_.end()) {
+				for (auto const idx : patched) {
+					pos->second.at(idx) = boost::algorithm::to_lower_copy(cyng::io::to_str(rows_.at(idx)[col]));
+				}
+			}
+		}
+	}
+
+	std::vector<std::string> const& table_view::get_texts(std::string const& column)
+	{
+		auto pos = texts_.find(column);
+		if (pos != texts_.end())	return pos->second;
+
+		std::vector<std::string> texts;
+		texts.reserve(rows_.size());
+		for (auto const& rec : rows_) {
+			texts.push_back(boost::algorithm::to_lower_copy(cyng::io::to_str(rec[column])));
+		}
+		return texts_.emplace(column, std::move(texts)).first->second;
+	}
+
+	std::vector<std::size_t> const& table_view::get_order(std::string const& column)
+	{
+		auto pos = orders_.find(column);
+		if (pos != orders_.end())	return pos->second;
+
+		//
+		//	sort numbers by value and everything else by text
+		//
+		std::vector<std::pair<bool, double>> values;
+		values.reserve(rows_.size());
+		for (auto const& rec : rows_) {
+			auto const obj = rec[column];
+			values.emplace_back(is_numeric(obj), is_numeric(obj) ? cyng::numeric_cast<double>(obj, 0.0) : 0.0);
+		}
+		auto const& texts = get_texts(column);
+
+		std::vector<std::size_t> order(rows_.size());
+		std::iota(order.begin(), order.end(), 0u);
+		std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+			if (values.at(a).first != values.at(b).first) {
+				//	numbers first (strict weak ordering for mixed columns)
+				return values.at(a).first;
+			}
+			return (values.at(a).first)
+				? values.at(a).second < values.at(b).second
+				: texts.at(a) < texts.at(b)
+				;
+		});
+		return orders_.emplace(column, std::move(order)).first->second;
+	}
+}
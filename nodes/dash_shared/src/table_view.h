@@ -0,0 +1,121 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#ifndef NODE_HTTP_TABLE_VIEW_H
+#define NODE_HTTP_TABLE_VIEW_H
+
+#include <cyng/store/db.h>
+#include <cyng/table/record.h>
+#include <cyng/compatibility/async.h>
+
+#include <atomic>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace node
+{
+	/**
+	 * Sorted and filtered view of a cache table to serve
+	 * paged requests from the dashboard (DataTables server-side mode).
+	 *
+	 * The table is copied under a short read lock only if records were
+	 * inserted or removed since the last request. Modified records are
+	 * read again and patched into the copy. Text representations and
+	 * sort orders are computed on demand outside of any table lock and
+	 * cached. A modification updates the texts of the modified columns
+	 * and drops their sort orders only.
+	 */
+	class table_view
+	{
+	public:
+		struct query
+		{
+			query();
+
+			std::size_t start_;
+			std::size_t length_;	//!<	0 means all
+			std::string order_;		//!<	column name to sort, empty for table order
+			bool ascending_;
+			std::string search_;	//!<	case insensitive substring
+			std::vector<std::string> columns_;	//!<	visible columns - search all columns if empty
+		};
+
+		struct result
+		{
+			std::size_t total_;		//!<	table size
+			std::size_t filtered_;	//!<	records matching the search
+			std::vector<cyng::table::record> rows_;	//!<	requested page
+		};
+
+	public:
+		table_view(std::string const& table);
+
+		/**
+		 * Mark view as outdated. Doesn't block and is safe to call
+		 * from table listeners (while the table is locked).
+		 */
+		void invalidate();
+
+		/**
+		 * Mark columns of a record as modified. The record is patched
+		 * into the view on the next request. Doesn't block on the view
+		 * and is safe to call from table listeners (while the table is locked).
+		 */
+		void modify(cyng::table::key_type const& key, std::vector<std::string> const& columns);
+
+		/**
+		 * @return requested page
+		 */
+		result select(cyng::store::db&, query const&);
+
+	private:
+		/**
+		 * Take a new snapshot of the table if required. Requires lock.
+		 */
+		void refresh(cyng::store::db&);
+
+		/**
+		 * Read modified records again. Requires lock.
+		 */
+		void patch(cyng::store::db&);
+
+		/**
+		 * @return lower case text of the specified column for all rows. Requires lock.
+		 */
+		std::vector<std::string> const& get_texts(std::string const& column);
+
+		/**
+		 * @return row indices in ascending order of the specified column. Requires lock.
+		 */
+		std::vector<std::size_t> const& get_order(std::string const& column);
+
+	private:
+		std::string const table_;
+		std::atomic<std::uint64_t> changes_;
+
+		cyng::async::mutex mutex_;
+		std::uint64_t snapshot_;	//!<	value of changes_ at last refresh
+		bool valid_;
+		std::vector<cyng::table::record> rows_;
+		std::map<std::string, std::size_t> index_;	//!<	row by key
+		std::vector<std::string> columns_;	//!<	all columns
+		std::map<std::string, std::vector<std::string>> texts_;
+		std::map<std::string, std::vector<std::size_t>> orders_;
+
+		/**
+		 * Modifications since the last request. The lock is never held
+		 * while waiting for a table lock.
+		 */
+		cyng::async::mutex modified_mutex_;
+		std::map<std::string, cyng::table::key_type> modified_;
+		std::set<std::string> modified_columns_;
+	};
+}
+
+#endif
@@ -25,6 +25,10 @@ set (node_dashs_shared
 	nodes/dash_shared/src/sync_db.cpp
 	nodes/dash_shared/src/dispatcher.h
 	nodes/dash_shared/src/dispatcher.cpp
+	nodes/dash_shared/src/publisher.h
+	nodes/dash_shared/src/publisher.cpp
+	nodes/dash_shared/src/table_view.h
+	nodes/dash_shared/src/table_view.cpp
 	nodes/dash_shared/src/forwarder.h
 	nodes/dash_shared/src/forwarder.cpp
 	nodes/dash_shared/src/form_data.h
@@ -9,6 +9,7 @@
 #include "tasks/cluster.h"
 #include <NODE_project_info.h>
 #include <smf/http/srv/auth.h>
+#include <smf/https/srv/tls_session.h>
 
 #include <cyng/log.h>
 #include <cyng/async/mux.h>
@@ -20,6 +21,7 @@
 #include <cyng/dom/reader.h>
 #include <cyng/dom/tree_walker.h>
 #include <cyng/vector_cast.hpp>
+#include <cyng/numeric_cast.hpp>
 #include <cyng/rnd.h>
 
 #if BOOST_OS_WINDOWS
@@ -205,6 +207,9 @@ namespace node
 						cyng::param_factory("tls-certificate-chain", "demo.cert"),
                         cyng::param_factory("tls-private-key", "priv.key"),
 						cyng::param_factory("tls-dh", "demo.dh"),	//	diffie-hellman
+						cyng::param_factory("tls-session-cache", 20000),	//	0 disables session resumption
+						cyng::param_factory("tls-session-timeout", 7200),	//	seconds
+						cyng::param_factory("tls-ticket-rotation", 3600),	//	seconds
 						cyng::param_factory("auth", cyng::vector_factory({
 							//	directory: /
 							//	authType:
@@ -234,7 +239,9 @@ namespace node
 							})),	//	blacklist
 						cyng::param_factory("redirect", cyng::vector_factory({
 							cyng::param_factory("/", "/index.html")
-						}))
+						})),
+						cyng::param_factory("body-limit", 64u * 1024u * 1024u),	//	max. request body size in bytes
+						cyng::param_factory("spool-threshold", 1024u * 1024u)	//	uploaded files larger than this are written to disk
 
 					))
 
@@ -466,6 +473,13 @@ namespace node
 			CYNG_LOG_INFO(logger, "restricted access to [" << dir.first << "]");
 		}
 
+		//
+		//	request body
+		//
+		auto const body_limit = cyng::numeric_cast<std::uint64_t>(dom.get("body-limit"), 64u * 1024u * 1024u);
+		auto const spool_threshold = cyng::numeric_cast<std::size_t>(dom.get("spool-threshold"), 1024u * 1024u);
+		CYNG_LOG_INFO(logger, "body limit: " << body_limit << " bytes, spool threshold: " << spool_threshold << " bytes");
+
 		//
 		//	get blacklisted addresses
 		//
@@ -493,6 +507,11 @@ namespace node
 		//
 		if (load_server_certificate(ctx, logger, tls_pwd, tls_certificate_chain, tls_private_key, tls_dh)) {
 
+			//
+			//	session resumption
+			//
+			https::setup_session_resumption(ctx, logger, "smf.dashs", cfg_srv);
+
 
 			cyng::async::start_task_delayed<cluster>(mux
 				, std::chrono::seconds(1)
@@ -502,7 +521,9 @@ namespace node
 				, boost::asio::ip::tcp::endpoint{ host, port }
 				, doc_root
 				, ad
-				, blacklist);
+				, blacklist
+				, body_limit
+				, spool_threshold);
 		}
 		else {
 			CYNG_LOG_FATAL(logger, "loading server certificates failed");
@@ -39,15 +39,17 @@ namespace node
 		, boost::asio::ip::tcp::endpoint ep
 		, std::string const& doc_root
 		, auth_dirs const& ad
-		, std::set<boost::asio::ip::address> const& blacklist)
+		, std::set<boost::asio::ip::address> const& blacklist
+		, std::uint64_t body_limit
+		, std::size_t spool_threshold)
 	: base_(*btp)
 		, uidgen_()
 		, bus_(bus_factory(btp->mux_, logger, uidgen_(), btp->get_id()))
 		, logger_(logger)
 		, config_(cfg_cls)
 		, cache_()
-		, server_(logger, btp->mux_.get_io_service(), ctx, ep, doc_root, ad, blacklist, bus_->vm_)
-		, dispatcher_(logger, server_.get_cm())
+		, server_(logger, btp->mux_.get_io_service(), ctx, ep, doc_root, ad, blacklist, bus_->vm_, body_limit, spool_threshold)
+		, dispatcher_(logger, server_.get_cm(), btp->mux_.get_io_service())
 		, db_sync_(logger, cache_)
 		, forward_(logger, cache_, server_.get_cm())
 		, form_data_(logger)
@@ -175,6 +177,11 @@ namespace node
         //
         stop_sys_task();
 
+		//
+		//	stop publishing table changes
+		//
+		dispatcher_.stop();
+
 		//
 		//	stop server
 		//
@@ -404,6 +411,15 @@ namespace node
 			CYNG_LOG_TRACE(logger_, "ws.read - pull channel [" << channel << "]");
 			dispatcher_.pull(cache_, channel, tag_ws);
 		}
+		else if (boost::algorithm::equals(cmd, "query"))
+		{
+			CYNG_LOG_TRACE(logger_, "ws.read - query channel [" << channel << "]");
+
+			//
+			//	send a single page of a table
+			//
+			dispatcher_.query(cache_, channel, tag_ws, reader);
+		}
 		else if (boost::algorithm::equals(cmd, "insert"))
 		{
 			node::fwd_insert(logger_
@@ -42,7 +42,9 @@ namespace node
 			, boost::asio::ip::tcp::endpoint
 			, std::string const& doc_root
 			, auth_dirs const& ad
-			, std::set<boost::asio::ip::address> const&);
+			, std::set<boost::asio::ip::address> const&
+			, std::uint64_t body_limit
+			, std::size_t spool_threshold);
 		cyng::continuation run();
 		void stop();
 
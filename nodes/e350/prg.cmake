@@ -7,6 +7,7 @@ set (node_e350_cpp
 	nodes/e350/src/controller.cpp
 	nodes/shared/net/server_stub.cpp
 	nodes/shared/net/session_stub.cpp
+	nodes/shared/net/buffer_pool.cpp
 	nodes/e350/src/server.cpp
 	nodes/e350/src/session.cpp
 #	nodes/e350/src/connection.cpp
@@ -19,6 +20,7 @@ set (node_e350_h
 	nodes/e350/src/server.h
 #	nodes/e350/src/connection.h
 	src/main/include/smf/cluster/session_stub.h
+	src/main/include/smf/cluster/buffer_pool.h
 	nodes/e350/src/session.h
 )
 
@@ -23,6 +23,7 @@
 #include <cyng/json.h>
 #include <cyng/value_cast.hpp>
 #include <cyng/vector_cast.hpp>
+#include <cyng/numeric_cast.hpp>
 #include <cyng/compatibility/io_service.h>
 #include <cyng/vm/controller.h>
 
@@ -213,7 +214,9 @@ namespace node
 						cyng::param_factory("redirect", cyng::vector_factory({
 							cyng::param_factory("/", "/index.html")
 						})),
-						cyng::param_factory("https-rewrite", false)	//	301 - Moved Permanently
+						cyng::param_factory("https-rewrite", false),	//	301 - Moved Permanently
+						cyng::param_factory("body-limit", 64u * 1024u * 1024u),	//	max. request body size in bytes
+						cyng::param_factory("spool-threshold", 1024u * 1024u)	//	uploaded files larger than this are written to disk
 					))
 					, cyng::param_factory("mail", cyng::tuple_factory(
 						cyng::param_factory("host", "smtp.gmail.com"),
@@ -265,6 +268,10 @@ namespace node
 		if (https_rewrite) {
 			CYNG_LOG_WARNING(logger, "HTTPS rewrite is active");
 		}
+
+		auto const body_limit = cyng::numeric_cast<std::uint64_t>(dom["http"].get("body-limit"), 64u * 1024u * 1024u);
+		auto const spool_threshold = cyng::numeric_cast<std::size_t>(dom["http"].get("spool-threshold"), 1024u * 1024u);
+		CYNG_LOG_TRACE(logger, "body limit: " << body_limit << " bytes, spool threshold: " << spool_threshold << " bytes");
 		
 		mail_config mx;
 		init(dom.get("mail"), mx);
@@ -311,7 +318,9 @@ namespace node
 #endif
 			, blacklist
 			, vm
-			, https_rewrite);
+			, https_rewrite
+			, body_limit
+			, spool_threshold);
 
 
 		//
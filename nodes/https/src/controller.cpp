@@ -8,6 +8,7 @@
 #include "controller.h"
 #include <NODE_project_info.h>
 #include "logic.h"
+#include <smf/https/srv/tls_session.h>
 
 #include <cyng/log.h>
 #include <cyng/async/scheduler.h>
@@ -20,6 +21,7 @@
 #include <cyng/value_cast.hpp>
 #include <cyng/compatibility/io_service.h>
 #include <cyng/vector_cast.hpp>
+#include <cyng/numeric_cast.hpp>
 #include <cyng/vm/controller.h>
 
 #include <fstream>
@@ -196,6 +198,9 @@ namespace node
 						cyng::param_factory("tls-certificate-chain", "fullchain.pem"),
 						cyng::param_factory("tls-private-key", "privkey.pem"),
 						cyng::param_factory("tls-dh", "dh4096.pem"),	//	diffie-hellman
+						cyng::param_factory("tls-session-cache", 20000),	//	0 disables session resumption
+						cyng::param_factory("tls-session-timeout", 7200),	//	seconds
+						cyng::param_factory("tls-ticket-rotation", 3600),	//	seconds
 						cyng::param_factory("auth", cyng::vector_factory({
 							//	directory: /
 							//	authType:
@@ -225,7 +230,9 @@ namespace node
 						})),	//	blacklist
 						cyng::param_factory("redirect", cyng::vector_factory({
 							cyng::param_factory("/", "/index.html")
-						}))
+						})),
+						cyng::param_factory("body-limit", 64u * 1024u * 1024u),	//	max. request body size in bytes
+						cyng::param_factory("spool-threshold", 1024u * 1024u)	//	uploaded files larger than this are written to disk
 					))
 					, cyng::param_factory("mail", cyng::tuple_factory(
 						cyng::param_factory("host", "smtp.gmail.com"),
@@ -287,6 +294,10 @@ namespace node
 			CYNG_LOG_INFO(logger, "restricted access to [" << dir.first << "]");
 		}
 
+		auto const body_limit = cyng::numeric_cast<std::uint64_t>(dom["https"].get("body-limit"), 64u * 1024u * 1024u);
+		auto const spool_threshold = cyng::numeric_cast<std::size_t>(dom["https"].get("spool-threshold"), 1024u * 1024u);
+		CYNG_LOG_INFO(logger, "body limit: " << body_limit << " bytes, spool threshold: " << spool_threshold << " bytes");
+
 		//
 		//	get blacklisted addresses
 		//
@@ -323,6 +334,12 @@ namespace node
 		//
 		if (load_server_certificate(ctx, logger, tls_pwd, tls_certificate_chain, tls_private_key, tls_dh)) {
 
+			//
+			//	session resumption
+			//
+			cyng::tuple_t tpl;
+			https::setup_session_resumption(ctx, logger, "smf.https", cyng::value_cast(dom.get("https"), tpl));
+
 			//
 			//	create VM controller
 			//
@@ -339,7 +356,9 @@ namespace node
 				, doc_root
 				, ad
 				, blacklist
-				, vm);
+				, vm
+				, body_limit
+				, spool_threshold);
 
 			if (srv) {
 				CYNG_LOG_TRACE(logger, "HTTPS server established");
@@ -243,6 +243,7 @@ namespace node
 					, cyng::param_factory("accept-all-ids", false)	//	accept only the specified MAC id
 					, cyng::param_factory("gpio-path", "/sys/class/gpio")	//	accept only the specified MAC id
 					, cyng::param_factory("gpio-list", cyng::vector_factory({46, 47, 50, 53}))
+					, cyng::param_factory("push-dir", "")	//	files to push - empty to disable
 
 					//	on this address the gateway acts as a server
 					//	configuration interface
@@ -283,7 +284,11 @@ namespace node
 						cyng::param_factory("stopbits", "one"),	//	one, onepointfive, two
 						cyng::param_factory("speed", 115200),
 						cyng::param_factory("transparent-mode", false),
-						cyng::param_factory("transparent-port", 12001)
+						cyng::param_factory("transparent-port", 12001),
+						//	AES keys of encrypted meters (security mode 5)
+						//	"server ID": "16 bytes key as hex string", example:
+						//	"01-e61e-16000913-07-0f": "000102030405060708090a0b0c0d0e0f"
+						cyng::param_factory("keys", cyng::tuple_factory())
 					))
 
 					, cyng::param_factory("wired-LMN", cyng::tuple_factory(
@@ -738,6 +743,13 @@ namespace node
 			config.insert("_Config", cyng::table::key_generator("gpio.50"), cyng::table::data_generator(std::size_t(cyng::async::NO_TASK)), 1, tag);
 			config.insert("_Config", cyng::table::key_generator("gpio.53"), cyng::table::data_generator(std::size_t(cyng::async::NO_TASK)), 1, tag);
 
+			//
+			//	directory with files to push
+			//
+			auto const push_dir = cyng::value_cast<std::string>(dom.get("push-dir"), "");
+			CYNG_LOG_INFO(logger, "push.dir: " << (push_dir.empty() ? "disabled" : push_dir));
+			config.insert("_Config", cyng::table::key_generator("push.dir"), cyng::table::data_generator(push_dir), 1, tag);
+
 			//
 			//	get if-1107 default configuration
 			//
@@ -12,6 +12,7 @@
 #include <smf/sml/srv_id_io.h>
 #include <smf/sml/obis_io.h>
 #include <smf/mbus/defs.h>
+#include <smf/mbus/data_record.h>
 
 #include <cyng/io/serializer.h>
 #include <cyng/vm/generator.h>
@@ -59,6 +60,10 @@ namespace node
 			, server_id_(to_gateway_srv_id(mac))
 			, reader_()
 			, sml_gen_()
+			, dedup_(std::chrono::seconds(30), 4096)
+#ifdef NODE_SSL_INSTALLED
+			, key_cache_(1024)
+#endif
 		{
 			reset();
 
@@ -1480,7 +1485,7 @@ namespace node
 			cyng::vector_t const frame = ctx.get_frame();
 			//CYNG_LOG_TRACE(logger_, ctx.get_name() << " - " << cyng::io::to_str(frame));
             
-			auto const tpl = cyng::tuple_cast<
+			auto tpl = cyng::tuple_cast<
 				cyng::buffer_t,		//	[0] server id
 				std::string,		//	[1] manufacturer
 				std::uint8_t,		//	[2] version
@@ -1490,6 +1495,28 @@ namespace node
 				cyng::buffer_t		//	[6] payload
 			>(frame);
 
+			//
+			//	read transport layer header
+			//
+			wmbus::header h;
+			bool const has_header = wmbus::read_header(std::get<5>(tpl), std::get<6>(tpl), h);
+
+			//
+			//	drop duplicates (received from repeaters)
+			//
+			if (!dedup_.test_and_set(sml::get_manufacturer_code(std::get<0>(tpl))
+				, std::get<4>(tpl)
+				, h.get_access_no()
+				, wmbus::crc16_en13757(std::get<6>(tpl)))) {
+
+				CYNG_LOG_TRACE(logger_, ctx.get_name() 
+					<< " - drop duplicate #"
+					<< dedup_.get_duplicates()
+					<< " from "
+					<< std::get<4>(tpl));
+				return;
+			}
+
 			auto const server_id = sml::from_server_id(std::get<0>(tpl));
 
 			CYNG_LOG_DEBUG(logger_, ctx.get_name() << " - server id: " << server_id);
@@ -1522,22 +1549,119 @@ namespace node
 			//cyng::buffer_t dev_id = cyng::to_vector<char>(std::get<4>(tpl));
 			//std::reverse(dev_id.begin(), dev_id.end());
 
-			update_device_table(std::get<0>(tpl), std::get<1>(tpl), std::get<2>(tpl), std::get<3>(tpl), std::get<5>(tpl), ctx.tag());
+			auto const aes = update_device_table(std::get<0>(tpl), std::get<1>(tpl), std::get<2>(tpl), std::get<3>(tpl), std::get<5>(tpl), ctx.tag());
+
+			if (!has_header) {
+				CYNG_LOG_WARNING(logger_, ctx.get_name() 
+					<< " - unsupported frame type: "
+					<< +std::get<5>(tpl));
+				return;
+			}
+
+			if (decrypt(std::get<0>(tpl), std::get<2>(tpl), h, aes, std::get<6>(tpl))) {
+				decode_data_blocks(std::get<0>(tpl), std::get<6>(tpl), h.get_offset());
+			}
+		}
+
+		bool kernel::decrypt(cyng::buffer_t const& server_id
+			, std::uint8_t version
+			, wmbus::header const& h
+			, cyng::buffer_t const& aes
+			, cyng::buffer_t& payload)
+		{
+			auto const size = h.get_block_count() * 16;
+			switch (h.get_mode()) {
+			case 0:
+				//	not encrypted
+				return true;
+#ifdef NODE_SSL_INSTALLED
+			case 5:
+				if (aes.size() != 16) {
+					CYNG_LOG_WARNING(logger_, "no AES key for " << sml::from_server_id(server_id));
+					return false;
+				}
+				if (h.get_offset() + size > payload.size()) {
+					CYNG_LOG_WARNING(logger_, "invalid encryption size " << size << " for " << sml::from_server_id(server_id));
+					return false;
+				}
+				if (!key_cache_.decrypt_mode_5(server_id, aes, h.get_iv(server_id, version), payload.data() + h.get_offset(), size)) {
+					CYNG_LOG_WARNING(logger_, "decryption failed (mode 5) for " << sml::from_server_id(server_id));
+					return false;
+				}
+				return true;
+			case 7:
+				//
+				//	The key derivation requires the message counter of the
+				//	authentication and fragmentation layer (AFL) which is 
+				//	not part of a CI 0x72/0x7A frame.
+				//
+				CYNG_LOG_WARNING(logger_, "security mode 7 without AFL from " << sml::from_server_id(server_id));
+				return false;
+#endif
+			default:
+				break;
+			}
+
+			CYNG_LOG_WARNING(logger_, "unsupported security mode " << +h.get_mode() << " from " << sml::from_server_id(server_id));
+			return false;
+		}
 
+		void kernel::decode_data_blocks(cyng::buffer_t const& server_id
+			, cyng::buffer_t const& payload
+			, std::size_t offset)
+		{
+			if (offset >= payload.size())	return;
 
 			//
-			//	ToDo: decode variable_data_block vdb;
+			//	a wireless M-Bus frame has max. 255 bytes and each 
+			//	record requires at least 2 bytes
 			//
-
+			std::array<mbus::data_record, 128> records;
+			std::size_t count{ 0 };
+			auto const pos = offset + mbus::decode_records(payload.data() + offset
+				, payload.size() - offset
+				, records.data()
+				, records.size()
+				, count);
+
+			CYNG_LOG_DEBUG(logger_, count 
+				<< " data block(s) from " 
+				<< sml::from_server_id(server_id)
+				<< " - "
+				<< (payload.size() - pos)
+				<< " bytes not decoded");
+
+			for (std::size_t idx = 0; idx < count; ++idx) {
+				auto const& rec = records.at(idx);
+				if (rec.type_ == mbus::RECORD_REAL) {
+					CYNG_LOG_TRACE(logger_, sml::from_server_id(server_id)
+						<< " value: "
+						<< rec.value_.f_
+						<< ", scaler: "
+						<< +rec.scaler_
+						<< ", unit: "
+						<< mbus::get_unit_name(rec.unit_));
+				}
+				else {
+					CYNG_LOG_TRACE(logger_, sml::from_server_id(server_id)
+						<< " value: "
+						<< rec.value_.i_
+						<< ", scaler: "
+						<< +rec.scaler_
+						<< ", unit: "
+						<< mbus::get_unit_name(rec.unit_));
+				}
+			}
 		}
 
-		void kernel::update_device_table(cyng::buffer_t const& dev_id
+		cyng::buffer_t kernel::update_device_table(cyng::buffer_t const& dev_id
 			, std::string const& manufacturer
 			, std::uint8_t version
 			, std::uint8_t media
 			, std::uint8_t frame_type
 			, boost::uuids::uuid tag)
 		{
+			cyng::buffer_t aes;
 			config_db_.access([&](cyng::store::table* tbl) {
 
 				auto const rec = tbl->lookup(cyng::table::key_generator(dev_id));
@@ -1567,9 +1691,11 @@ namespace node
 				}
 				else {
 					CYNG_LOG_TRACE(logger_, "update device: " << cyng::io::to_hex(dev_id));
+					aes = cyng::value_cast(rec["aes"], aes);
 					tbl->modify(rec.key(), cyng::param_factory("lastSeen", std::chrono::system_clock::now()), tag);
 				}
 			}, cyng::store::write_access("mbus-devices"));
+			return aes;
 		}
 	}	//	sml
 }
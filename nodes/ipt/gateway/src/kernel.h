@@ -14,6 +14,11 @@
 #include <smf/ipt/config.h>
 #include <smf/sml/protocol/reader.h>
 #include <smf/sml/protocol/generator.h>
+#include <smf/mbus/header.h>
+#include <smf/mbus/dedup.h>
+#ifdef NODE_SSL_INSTALLED
+#include <smf/mbus/aes.h>
+#endif
 
 #include <cyng/log.h>
 #include <cyng/vm/controller.h>
@@ -88,7 +93,30 @@ namespace node
 			 */
 			void mbus_push_frame(cyng::context& ctx);
 
-			void update_device_table(cyng::buffer_t const& dev_id
+			/**
+			 * Decrypt the payload (if encrypted) in place.
+			 *
+			 * @param version version byte of the link layer (part of the IV)
+			 * @return false if payload is encrypted and cannot be decrypted
+			 */
+			bool decrypt(cyng::buffer_t const& server_id
+				, std::uint8_t version
+				, wmbus::header const& h
+				, cyng::buffer_t const& aes
+				, cyng::buffer_t& payload);
+
+			/**
+			 * Decode all variable data blocks of the payload
+			 * in one pass without dynamic memory allocation.
+			 */
+			void decode_data_blocks(cyng::buffer_t const& server_id
+				, cyng::buffer_t const& payload
+				, std::size_t offset);
+
+			/**
+			 * @return AES key of the device
+			 */
+			cyng::buffer_t update_device_table(cyng::buffer_t const& dev_id
 				, std::string const& manufacturer
 				, std::uint8_t version
 				, std::uint8_t media
@@ -133,6 +161,17 @@ namespace node
 			 */
 			res_generator sml_gen_;
 
+			/**
+			 * drop wireless M-Bus telegrams received from repeaters
+			 */
+			wmbus::dedup dedup_;
+
+#ifdef NODE_SSL_INSTALLED
+			/**
+			 * AES key schedules of all wireless M-Bus devices
+			 */
+			wmbus::key_cache key_cache_;
+#endif
 		};
 
 	}	//	sml
@@ -14,6 +14,7 @@
 #include <smf/ipt/response.hpp>
 #include <smf/ipt/generator.h>
 #include <smf/sml/protocol/serializer.h>
+#include <smf/sml/srv_id_io.h>
 #include <cyng/factory/set_factory.h>
 #include <cyng/async/task/task_builder.hpp>
 #include <cyng/io/serializer.h>
@@ -21,6 +22,9 @@
 #include <cyng/io/serializer.h>
 #include <cyng/tuple_cast.hpp>
 #include <cyng/numeric_cast.hpp>
+#include <cyng/parser/buffer_parser.h>
+#include <cyng/table/key.hpp>
+#include <cyng/table/body.hpp>
 
 #include <boost/uuid/random_generator.hpp>
 #ifdef SMF_IO_DEBUG
@@ -119,6 +123,7 @@ namespace node
 			//	wireless-LMN configuration
 			//	update status word
 			//
+			load_meter_keys(config_db, cfg_wireless_lmn);
 			auto pos = tid_map.find(47);
 			status_word.set_mbus_if_available(start_wireless_lmn(config_db, cfg_wireless_lmn, (pos != tid_map.end()) ? pos->second : cyng::async::NO_TASK));
 
@@ -175,6 +180,51 @@ namespace node
 			return enabled;
 		}
 
+		void network::load_meter_keys(cyng::store::db& db, cyng::tuple_t const& cfg)
+		{
+			auto dom = cyng::make_reader(cfg);
+			cyng::tuple_t keys;
+			keys = cyng::value_cast(dom.get("keys"), keys);
+
+			for (auto const& obj : keys) {
+
+				cyng::param_t param;
+				param = cyng::value_cast(obj, param);
+
+				auto const server_id = sml::from_server_id(param.first);
+				auto const r = cyng::parse_hex_string(cyng::value_cast<std::string>(param.second, ""));
+				if (server_id.size() != 9 || !r.second || r.first.size() != 16) {
+					CYNG_LOG_WARNING(logger_, "invalid AES key configuration for meter " << param.first);
+					continue;
+				}
+
+				db.access([&](cyng::store::table* tbl) {
+
+					auto const key = cyng::table::key_generator(server_id);
+					if (!tbl->insert(key
+						, cyng::table::data_generator(std::chrono::system_clock::now()
+							, "+++"	//	class
+							, true	//	visible
+							, false	//	active
+							, param.first	//	description
+							, 0ull	//	status
+							, cyng::buffer_t{ 0, 0 }	//	mask
+							, 26000ul	//	interval
+							, cyng::make_buffer({})	//	pubKey
+							, r.first	//	aes
+							, ""	//	user
+							, "")	//	password
+						, 1	//	generation
+						, vm_.tag())) {
+
+						tbl->modify(key, cyng::param_factory("aes", r.first), vm_.tag());
+					}
+				}, cyng::store::write_access("mbus-devices"));
+
+				CYNG_LOG_INFO(logger_, "AES key for meter " << param.first << " loaded");
+			}
+		}
+
 		bool network::start_wired_lmn(cyng::store::db& db, cyng::tuple_t const& cfg, std::size_t tid)
 		{
 			auto dom = cyng::make_reader(cfg);
@@ -503,9 +553,14 @@ namespace node
 		void network::reconfigure_impl()
 		{
 			//
-			//	switch to other master
+			//	sharded cluster: reconnect to the IP-T node of
+			//	the redirect - otherwise switch to other master
 			//
-			if (config_.next())
+			if (config_.redirect(get_redirect()))
+			{
+				CYNG_LOG_INFO(logger_, "redirected to " << config_.get_address());
+			}
+			else if (config_.next())
 			{
 				CYNG_LOG_INFO(logger_, "switch to redundancy ["
 					<< config_.master_
@@ -170,6 +170,12 @@ namespace node
 			void insert_seq_open_channel_rel(cyng::context& ctx);
 
 			bool start_wireless_lmn(cyng::store::db&, cyng::tuple_t const&, std::size_t);
+
+			/**
+			 * Insert the configured AES keys of the wireless M-Bus meters
+			 * into table "mbus-devices".
+			 */
+			void load_meter_keys(cyng::store::db&, cyng::tuple_t const&);
 			bool start_wired_lmn(cyng::store::db&, cyng::tuple_t const&, std::size_t);
 			std::map<int, std::size_t> control_gpio(cyng::store::db&, std::map<int, std::string> gpio_paths);
 
@@ -14,7 +14,9 @@
 #include <cyng/vm/generator.h>
 
 #include <boost/filesystem.hpp>
-#include <boost/range/iterator_range.hpp>
+
+#include <fstream>
+#include <iterator>
 
 namespace node
 {
@@ -34,6 +36,7 @@ namespace node
 			, vm_(vm)
 			, key_(key)
 			, tag_(tag)
+			, pending_()
 			, state_(TASK_STATE_INITIAL_)
 		{
 			CYNG_LOG_INFO(logger_, "initialize task #"
@@ -104,95 +107,87 @@ namespace node
 			, std::size_t count
 			, std::string target)
 		{
-			if (success) {
+			//
+			//	push channels are managed by the bus (push_pool)
+			//
+			CYNG_LOG_TRACE(logger_, "task #"
+				<< base_.get_id()
+				<< " <"
+				<< base_.get_class_name()
+				<< "> push channel "
+				<< target
+				<< (success ? " is open" : " failed"));
 
-				CYNG_LOG_TRACE(logger_, "task #"
+			return cyng::continuation::TASK_CONTINUE;
+		}
+
+		//	slot 1
+		cyng::continuation push_ops::process(bool success
+			, std::string target)
+		{
+			if (pending_.empty()) {
+				CYNG_LOG_WARNING(logger_, "task #"
 					<< base_.get_id()
 					<< " <"
 					<< base_.get_class_name()
-					<< "> push channel "
-					<< target
-					<< " is open");
-
-				//
-				//	ToDo: push data
-				//
-				//
-				for (auto const& entry : boost::make_iterator_range(boost::filesystem::directory_iterator("D:\\installations\\EBS\\reimport"), {}))
-				{
-					//const std::string file_name = "D:\\installations\\EBS\\debug\\smf--SML-201812T191303-pushStore49b04d0a-31a3a9c5.sml";
-					const std::string file_name = entry.path().string();
-					std::ifstream file(file_name, std::ios::binary | std::ios::app);
-
-					if (file.is_open())
-					{
-						//	dont skip whitepsaces
-						file >> std::noskipws;
-						cyng::buffer_t data;
-						data.insert(data.begin(), std::istream_iterator<char>(file), std::istream_iterator<char>());
-
-						vm_.async_run(cyng::generate_invoke("req.transfer.push.data"
-							, channel
-							, source
-							, std::uint8_t(0xC1)	//	status
-							, std::uint8_t(0)	//	block
-							, data));
-						vm_.async_run(cyng::generate_invoke("stream.flush"));
-						file.close();
-
-						CYNG_LOG_WARNING(logger_, "task #"
-							<< base_.get_id()
-							<< " <"
-							<< base_.get_class_name()
-							<< "> remove "
-							<< entry.path());
-						boost::filesystem::remove(entry.path());
-
-						config_db_.insert("op.log"
-							, cyng::table::key_generator(0UL)
-							, cyng::table::data_generator(std::chrono::system_clock::now()
-								, static_cast<std::uint32_t>(900u)	//	reg period - 15 min
-								, std::chrono::system_clock::now()	//	val time
-								, static_cast<std::uint64_t>(status_word_.operator std::uint64_t())	//	status
-								, node::sml::evt_push_succes()	//	event - push successful
-								, cyng::make_buffer({ 0x81, 0x46, 0x00, 0x00, 0x02, 0xFF })
-								, std::chrono::system_clock::now()	//	val time
-								, cyng::make_buffer({ 0x02, 0xE6, 0x1E, 0x27, 0x66, 0x03, 0x15, 0x35, 0x03 })
-								, target
-								, static_cast<std::uint8_t>(1u))		//	push_nr
-							, 1	//	generation
-							, tag_);
-
-
+					<< "> no pending push data to "
+					<< target);
+				return cyng::continuation::TASK_CONTINUE;
+			}
 
-						break;	//	one item at a time
-					}
-				}
+			if (success) {
 
-				//
-				//	close push channel
-				//
-				CYNG_LOG_TRACE(logger_, "task #"
+				CYNG_LOG_INFO(logger_, "task #"
 					<< base_.get_id()
 					<< " <"
 					<< base_.get_class_name()
-					<< "> close push channel "
-					<< channel
-					<< ':'
-					<< source);
-				vm_.async_run(cyng::generate_invoke("req.close.push.channel", channel));
+					<< "> remove "
+					<< pending_);
 
+				boost::system::error_code ec;
+				boost::filesystem::remove(pending_, ec);
+				if (ec) {
+					CYNG_LOG_ERROR(logger_, "task #"
+						<< base_.get_id()
+						<< " <"
+						<< base_.get_class_name()
+						<< "> cannot remove "
+						<< pending_
+						<< ": "
+						<< ec.message());
+				}
+
+				config_db_.insert("op.log"
+					, cyng::table::key_generator(0UL)
+					, cyng::table::data_generator(std::chrono::system_clock::now()
+						, static_cast<std::uint32_t>(900u)	//	reg period - 15 min
+						, std::chrono::system_clock::now()	//	val time
+						, static_cast<std::uint64_t>(status_word_.operator std::uint64_t())	//	status
+						, node::sml::evt_push_succes()	//	event - push successful
+						, cyng::make_buffer({ 0x81, 0x46, 0x00, 0x00, 0x02, 0xFF })
+						, std::chrono::system_clock::now()	//	val time
+						, cyng::make_buffer({ 0x02, 0xE6, 0x1E, 0x27, 0x66, 0x03, 0x15, 0x35, 0x03 })
+						, target
+						, static_cast<std::uint8_t>(1u))		//	push_nr
+					, 1	//	generation
+					, tag_);
 			}
 			else {
+
+				//
+				//	keep the file for the next interval
+				//
 				CYNG_LOG_WARNING(logger_, "task #"
 					<< base_.get_id()
 					<< " <"
 					<< base_.get_class_name()
-					<< "> open push channel "
+					<< "> push data to "
 					<< target
-					<< " failed");
-
+					<< " failed - keep "
+					<< pending_);
 			}
+
+			pending_.clear();
 			return cyng::continuation::TASK_CONTINUE;
 		}
 
@@ -248,26 +243,77 @@ namespace node
 		void push_ops::push()
 		{
 			if (status_word_.is_authorized()) {
-				config_db_.access([&](cyng::store::table const* tbl) {
 
+				std::string target;
+				config_db_.access([&](cyng::store::table const* tbl) {
 					auto rec = tbl->lookup(this->key_);
-					const auto target(cyng::value_cast<std::string>(rec["target"], ""));
+					target = cyng::value_cast<std::string>(rec["target"], "");
+				}, cyng::store::read_access("push.ops"));
 
-					CYNG_LOG_INFO(logger_, "task #"
+				CYNG_LOG_INFO(logger_, "task #"
+					<< base_.get_id()
+					<< " <"
+					<< base_.get_class_name()
+					<< "> push data to "
+					<< target);
+
+				if (!pending_.empty()) {
+					CYNG_LOG_WARNING(logger_, "task #"
+						<< base_.get_id()
+						<< " <"
+						<< base_.get_class_name()
+						<< "> "
+						<< pending_
+						<< " is still pending");
+					return;
+				}
+
+				auto const dir = cyng::value_cast<std::string>(config_db_.get_value("_Config", "value", std::string("push.dir")), "");
+				if (dir.empty()) {
+					CYNG_LOG_TRACE(logger_, "task #"
 						<< base_.get_id()
 						<< " <"
 						<< base_.get_class_name()
-						<< "> open channel "
-						<< target);
+						<< "> no push directory configured");
+					return;
+				}
 
-					vm_
-						.async_run(cyng::generate_invoke("req.open.push.channel", target, "", "", "", "", 0))
-						.async_run(cyng::generate_invoke("bus.store.rel.channel.open", cyng::invoke("ipt.seq.push"), base_.get_id(), target))
-						.async_run(cyng::generate_invoke("stream.flush", target))
-						.async_run(cyng::generate_invoke("log.msg.info", "req.open.push.channel", cyng::invoke("ipt.seq.push")))
-						;
+				//
+				//	The bus reuses an open push channel to this target
+				//	or opens a new one. The file will be removed when
+				//	the bus reports success in slot 1.
+				//
+				boost::system::error_code ec;
+				for (boost::filesystem::directory_iterator pos(dir, ec), end; !ec && pos != end; pos.increment(ec))
+				{
+					boost::system::error_code ec_file;
+					if (!boost::filesystem::is_regular_file(pos->path(), ec_file))	continue;
 
-				}, cyng::store::read_access("push.ops"));
+					std::ifstream file(pos->path().string(), std::ios::binary);
+					if (file.is_open())
+					{
+						//	dont skip whitepsaces
+						file >> std::noskipws;
+						cyng::buffer_t data;
+						data.insert(data.begin(), std::istream_iterator<char>(file), std::istream_iterator<char>());
+						file.close();
+
+						pending_ = pos->path();
+						vm_.async_run(cyng::generate_invoke("bus.req.push.data", target, data, base_.get_id()));
+						break;	//	one item at a time
+					}
+				}
+
+				if (ec) {
+					CYNG_LOG_WARNING(logger_, "task #"
+						<< base_.get_id()
+						<< " <"
+						<< base_.get_class_name()
+						<< "> cannot read "
+						<< dir
+						<< ": "
+						<< ec.message());
+				}
 			}
 			else {
 
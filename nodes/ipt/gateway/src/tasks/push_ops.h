@@ -14,6 +14,8 @@
 #include <cyng/async/mux.h>
 #include <cyng/store/db.h>
 
+#include <boost/filesystem/path.hpp>
+
 namespace node
 {
 	namespace ipt
@@ -22,7 +24,8 @@ namespace node
 		{
 		public:
 			using msg_0 = std::tuple<bool, std::uint32_t, std::uint32_t, std::uint16_t, std::size_t, std::string>;
-			using signatures_t = std::tuple<msg_0>;
+			using msg_1 = std::tuple<bool, std::string>;
+			using signatures_t = std::tuple<msg_0, msg_1>;
 
 		public:
 			push_ops(cyng::async::base_task* bt
@@ -47,6 +50,13 @@ namespace node
 				, std::size_t count
 				, std::string target);
 
+			/**
+			 * @brief slot [1]
+			 *
+			 * push data confirmed (or dropped) by the bus
+			 */
+			cyng::continuation process(bool success
+				, std::string target);
 
 		private:
 			void set_tp();
@@ -75,6 +85,11 @@ namespace node
 
 			const boost::uuids::uuid tag_;
 
+			/**
+			 * file that waits for the push data response
+			 */
+			boost::filesystem::path pending_;
+
 			enum {
 				TASK_STATE_INITIAL_,
 				TASK_STATE_RUNNING_,
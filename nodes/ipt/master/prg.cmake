@@ -7,11 +7,14 @@ set (node_ipt_master_cpp
 	nodes/ipt/master/src/controller.cpp
 	nodes/shared/net/server_stub.cpp
 	nodes/shared/net/session_stub.cpp
+	nodes/shared/net/buffer_pool.cpp
 	nodes/ipt/master/src/server.cpp
 	nodes/ipt/master/src/session.cpp
 	nodes/ipt/master/src/session_state.cpp
 	nodes/ipt/master/src/proxy_data.cpp
 	nodes/ipt/master/src/proxy_comm.cpp
+	nodes/ipt/master/src/credential_cache.cpp
+	nodes/ipt/master/src/admission.cpp
 )
 
 set (node_ipt_master_h
@@ -20,10 +23,13 @@ set (node_ipt_master_h
 	src/main/include/smf/cluster/server_stub.h
 	nodes/ipt/master/src/server.h
 	src/main/include/smf/cluster/session_stub.h
+	src/main/include/smf/cluster/buffer_pool.h
 	nodes/ipt/master/src/session.h
 	nodes/ipt/master/src/session_state.h
 	nodes/ipt/master/src/proxy_data.h
 	nodes/ipt/master/src/proxy_comm.h
+	nodes/ipt/master/src/credential_cache.h
+	nodes/ipt/master/src/admission.h
 )
 
 set (node_ipt_master_info
@@ -0,0 +1,52 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#include "admission.h"
+#include <algorithm>
+
+namespace node
+{
+	namespace ipt
+	{
+		admission::admission(std::uint32_t rate, std::uint32_t burst)
+			: rate_(rate)
+			, burst_(static_cast<double>(std::max(burst, rate)))
+			, mutex_()
+			, tokens_(burst_)
+			, last_(std::chrono::steady_clock::now())
+			, rejected_(0)
+		{}
+
+		bool admission::try_acquire()
+		{
+			if (rate_ == 0)	return true;
+
+			cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+
+			//
+			//	refill
+			//
+			auto const now = std::chrono::steady_clock::now();
+			std::chrono::duration<double> const elapsed = now - last_;
+			last_ = now;
+			tokens_ = std::min(burst_, tokens_ + elapsed.count() * rate_);
+
+			if (tokens_ < 1.0) {
+				++rejected_;
+				return false;
+			}
+			tokens_ -= 1.0;
+			return true;
+		}
+
+		std::uint64_t admission::get_rejected() const
+		{
+			cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+			return rejected_;
+		}
+	}
+}
@@ -0,0 +1,58 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#ifndef NODE_IPT_MASTER_ADMISSION_H
+#define NODE_IPT_MASTER_ADMISSION_H
+
+#include <cyng/compatibility/async.h>
+#include <chrono>
+#include <cstdint>
+
+namespace node
+{
+	namespace ipt
+	{
+		/**
+		 * Token bucket to limit the login rate.
+		 *
+		 * After a network outage a large number of devices reconnect
+		 * at the same time. Logins above the configured rate are
+		 * rejected so the devices retry later and the load on the
+		 * master is spread over time. Thread safe.
+		 */
+		class admission
+		{
+		public:
+			/**
+			 * @param rate logins per second (0 means unlimited)
+			 * @param burst maximum number of logins at once
+			 */
+			admission(std::uint32_t rate, std::uint32_t burst);
+
+			/**
+			 * @return true if a login is admitted
+			 */
+			bool try_acquire();
+
+			/**
+			 * @return number of rejected logins
+			 */
+			std::uint64_t get_rejected() const;
+
+		private:
+			std::uint32_t const rate_;
+			double const burst_;
+
+			mutable cyng::async::mutex mutex_;
+			double tokens_;
+			std::chrono::steady_clock::time_point last_;
+			std::uint64_t rejected_;
+		};
+	}
+}
+
+#endif
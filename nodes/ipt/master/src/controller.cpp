@@ -17,6 +17,7 @@
 #include <cyng/io/serializer.h>
 #include <cyng/json.h>
 #include <cyng/dom/reader.h>
+#include <cyng/numeric_cast.hpp>
 #include <cyng/dom/tree_walker.h>
 #include <cyng/rnd.h>
 #if BOOST_OS_WINDOWS
@@ -192,7 +193,11 @@ namespace node
 					cyng::param_factory("service", "26862"),
 					cyng::param_factory("sk", "0102030405060708090001020304050607080900010203040506070809000001"),	//	scramble key
 					cyng::param_factory("watchdog", 30),	//	for IP-T connection (minutes)
-					cyng::param_factory("timeout", 10)		//	connection timeout in seconds
+					cyng::param_factory("timeout", 10),		//	connection timeout in seconds
+					cyng::param_factory("proxy-batch", 16),	//	max. number of SML requests per gateway transaction
+					cyng::param_factory("login-cache", true),	//	answer logins from a local copy of TDevice
+					cyng::param_factory("login-rate", 200),	//	max. logins per second (0 = unlimited)
+					cyng::param_factory("login-burst", 1000)	//	max. logins at once
 				))
 				, cyng::param_factory("sml-log", false)		//	log SML parser
 				, cyng::param_factory("cluster", cyng::vector_factory({ cyng::tuple_factory(
@@ -397,7 +402,11 @@ namespace node
 			, sk
 			, cyng::value_cast<int>(dom.get("watchdog"), 30)
 			, cyng::value_cast<int>(dom.get("timeout"), 12)
-			, sml_log);
+			, sml_log
+			, cyng::numeric_cast<std::size_t>(dom.get("proxy-batch"), 16u)
+			, cyng::value_cast(dom.get("login-cache"), true)
+			, cyng::numeric_cast<std::uint32_t>(dom.get("login-rate"), 200u)
+			, cyng::numeric_cast<std::uint32_t>(dom.get("login-burst"), 1000u));
 
 	}
 
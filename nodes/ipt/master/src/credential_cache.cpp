@@ -0,0 +1,180 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#include "credential_cache.h"
+#include <cyng/value_cast.hpp>
+#include <boost/algorithm/string/predicate.hpp>
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/rand.h>
+#include <random>
+#include <vector>
+
+namespace node
+{
+	namespace ipt
+	{
+		credential_cache::credential_cache(bool enabled)
+			: enabled_(enabled)
+			, mutex_()
+			, key_()
+			, entries_()
+			, names_()
+		{
+			random_bytes(key_.data(), key_.size());
+		}
+
+		bool credential_cache::is_enabled() const
+		{
+			return enabled_;
+		}
+
+		void credential_cache::insert(boost::uuids::uuid pk
+			, std::string const& name
+			, std::string const& pwd
+			, std::uint32_t query)
+		{
+			if (!enabled_)	return;
+
+			auto const salt = make_salt();
+			auto const d = digest(salt, pwd);
+
+			cyng::async::unique_lock<cyng::async::shared_mutex> lock(mutex_);
+			remove_by_pk(pk);
+
+			entries_.emplace(pk, entry{ name, salt, d, query, false });
+			names_[name] = pk;
+		}
+
+		void credential_cache::modify(boost::uuids::uuid pk, cyng::param_t const& param)
+		{
+			if (!enabled_)	return;
+
+			cyng::async::unique_lock<cyng::async::shared_mutex> lock(mutex_);
+			auto pos = entries_.find(pk);
+			if (pos == entries_.end())	return;
+
+			if (boost::algorithm::equals(param.first, "name")) {
+				names_.erase(pos->second.name_);
+				pos->second.name_ = cyng::value_cast<std::string>(param.second, "");
+				names_[pos->second.name_] = pk;
+			}
+			else if (boost::algorithm::equals(param.first, "pwd")) {
+				pos->second.salt_ = make_salt();
+				pos->second.digest_ = digest(pos->second.salt_, cyng::value_cast<std::string>(param.second, ""));
+			}
+			else if (boost::algorithm::equals(param.first, "query")) {
+				pos->second.query_ = cyng::value_cast<std::uint32_t>(param.second, 6u);
+			}
+			else {
+				return;
+			}
+
+			//
+			//	give the cache another chance
+			//
+			pos->second.forward_ = false;
+		}
+
+		void credential_cache::remove(boost::uuids::uuid pk)
+		{
+			cyng::async::unique_lock<cyng::async::shared_mutex> lock(mutex_);
+			remove_by_pk(pk);
+		}
+
+		void credential_cache::forward(boost::uuids::uuid pk)
+		{
+			cyng::async::unique_lock<cyng::async::shared_mutex> lock(mutex_);
+			auto pos = entries_.find(pk);
+			if (pos != entries_.end()) {
+				pos->second.forward_ = true;
+			}
+		}
+
+		void credential_cache::clear()
+		{
+			cyng::async::unique_lock<cyng::async::shared_mutex> lock(mutex_);
+			entries_.clear();
+			names_.clear();
+		}
+
+		credential_cache::result credential_cache::test(std::string const& name, std::string const& pwd, boost::uuids::uuid& pk, std::uint32_t& query) const
+		{
+			if (!enabled_)	return CC_MISS;
+
+			cyng::async::shared_lock<cyng::async::shared_mutex> lock(mutex_);
+			auto pos = names_.find(name);
+			if (pos == names_.end())	return CC_MISS;
+
+			pk = pos->second;
+			auto const& e = entries_.at(pos->second);
+			auto const d = digest(e.salt_, pwd);
+			if (CRYPTO_memcmp(d.data(), e.digest_.data(), d.size()) != 0)	return CC_REJECT;
+			if (e.forward_)	return CC_FORWARD;
+
+			query = e.query_;
+			return CC_MATCH;
+		}
+
+		std::size_t credential_cache::size() const
+		{
+			cyng::async::shared_lock<cyng::async::shared_mutex> lock(mutex_);
+			return entries_.size();
+		}
+
+		credential_cache::digest_t credential_cache::digest(salt_t const& salt, std::string const& pwd) const
+		{
+			std::vector<unsigned char> msg(salt.begin(), salt.end());
+			msg.insert(msg.end(), pwd.begin(), pwd.end());
+
+			digest_t d{};
+			unsigned int size = static_cast<unsigned int>(d.size());
+			HMAC(EVP_sha256()
+				, key_.data()
+				, static_cast<int>(key_.size())
+				, msg.data()
+				, msg.size()
+				, d.data()
+				, &size);
+			return d;
+		}
+
+		credential_cache::salt_t credential_cache::make_salt()
+		{
+			salt_t salt;
+			random_bytes(salt.data(), salt.size());
+			return salt;
+		}
+
+		void credential_cache::random_bytes(unsigned char* p, std::size_t size)
+		{
+			if (RAND_bytes(p, static_cast<int>(size)) != 1) {
+
+				//
+				//	no entropy from openSSL
+				//
+				std::random_device rd;
+				for (std::size_t idx = 0; idx < size; ++idx) {
+					p[idx] = static_cast<unsigned char>(rd());
+				}
+			}
+		}
+
+		void credential_cache::remove_by_pk(boost::uuids::uuid pk)
+		{
+			auto pos = entries_.find(pk);
+			if (pos != entries_.end()) {
+				auto idx = names_.find(pos->second.name_);
+				if (idx != names_.end() && idx->second == pk) {
+					names_.erase(idx);
+				}
+				entries_.erase(pos);
+			}
+		}
+	}
+}
@@ -0,0 +1,148 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#ifndef NODE_IPT_MASTER_CREDENTIAL_CACHE_H
+#define NODE_IPT_MASTER_CREDENTIAL_CACHE_H
+
+#include <cyng/compatibility/async.h>
+#include <cyng/intrinsics/sets.h>
+#include <boost/uuid/uuid.hpp>
+#include <array>
+#include <map>
+#include <string>
+#include <cstdint>
+
+namespace node
+{
+	namespace ipt
+	{
+		/**
+		 * Local copy of the account data from table TDevice.
+		 * Synchronized by a subscription on the master.
+		 *
+		 * Passwords are never stored in plain text. Each entry
+		 * keeps a HMAC-SHA256 of a random salt and the password only.
+		 * The HMAC key is generated at startup and never leaves the process.
+		 * All methods are thread safe.
+		 *
+		 * Logins with matching credentials are answered by the IP-T node
+		 * and reported to the master afterwards. If the master disagrees
+		 * (account already online or served by another shard) the account
+		 * is marked and following logins are decided by the master again.
+		 */
+		class credential_cache
+		{
+		public:
+			using salt_t = std::array<unsigned char, 16>;
+			using digest_t = std::array<unsigned char, 32>;
+
+		private:
+			struct entry
+			{
+				std::string name_;
+				salt_t salt_;
+				digest_t digest_;
+				std::uint32_t query_;
+				bool forward_;	//!<	master decides
+			};
+
+		public:
+			/**
+			 * result of test()
+			 */
+			enum result
+			{
+				CC_MISS,	//!<	unknown account or cache disabled
+				CC_MATCH,	//!<	account and password match
+				CC_REJECT,	//!<	account exists but password doesn't match
+				CC_FORWARD,	//!<	account exists but the master has to decide
+			};
+
+		public:
+			credential_cache(bool enabled);
+
+			/**
+			 * @return true if logins are tested against this cache
+			 */
+			bool is_enabled() const;
+
+			/**
+			 * Insert or replace a TDevice record
+			 */
+			void insert(boost::uuids::uuid pk
+				, std::string const& name
+				, std::string const& pwd
+				, std::uint32_t query);
+
+			/**
+			 * Update a single TDevice column. Columns not
+			 * relevant for authorization are ignored.
+			 */
+			void modify(boost::uuids::uuid pk, cyng::param_t const&);
+
+			void remove(boost::uuids::uuid pk);
+
+			/**
+			 * The master rejected a login answered from this cache.
+			 * Following logins of this account are forwarded to the
+			 * master until the record is modified.
+			 */
+			void forward(boost::uuids::uuid pk);
+
+			void clear();
+
+			/**
+			 * Test credentials.
+			 *
+			 * @param pk contains the primary key of the account in TDevice if the account exists
+			 * @param query contains the query flags of the device if successful
+			 */
+			result test(std::string const& name, std::string const& pwd, boost::uuids::uuid& pk, std::uint32_t& query) const;
+
+			std::size_t size() const;
+
+		private:
+			/**
+			 * @return HMAC-SHA256 of salt and password
+			 */
+			digest_t digest(salt_t const& salt, std::string const& pwd) const;
+
+			/**
+			 * @return a new random salt
+			 */
+			static salt_t make_salt();
+
+			/**
+			 * Fill the buffer with random bytes from openSSL
+			 */
+			static void random_bytes(unsigned char*, std::size_t);
+
+			/**
+			 * Requires an exclusive lock.
+			 */
+			void remove_by_pk(boost::uuids::uuid pk);
+
+		private:
+			bool const enabled_;
+			mutable cyng::async::shared_mutex mutex_;
+
+			/**
+			 * random HMAC key
+			 */
+			std::array<unsigned char, 32> key_;
+
+			std::map<boost::uuids::uuid, entry> entries_;
+
+			/**
+			 * account name => primary key
+			 */
+			std::map<std::string, boost::uuids::uuid> names_;
+		};
+	}
+}
+
+#endif
@@ -20,11 +20,17 @@ namespace node
 			, std::chrono::seconds timeout
 			, scramble_key const& sk
 			, uint16_t watchdog
-			, bool sml_log)
+			, bool sml_log
+			, std::size_t proxy_batch
+			, credential_cache& cache
+			, admission& adm)
 		: server_stub(mux, logger, bus, timeout)
 			, sk_(sk)
 			, watchdog_(watchdog)
 			, sml_log_(sml_log)
+			, proxy_batch_(proxy_batch)
+			, cache_(cache)
+			, admission_(adm)
 		{
 			//
 			//	client/server functions
@@ -47,7 +53,10 @@ namespace node
 				, timeout_
 				, sk_
 				, watchdog_
-				, sml_log_);
+				, sml_log_
+				, proxy_batch_
+				, cache_
+				, admission_);
 		}
 
 		bool server::close_connection(boost::uuids::uuid tag, cyng::object obj)
@@ -10,6 +10,8 @@
 
 #include <smf/cluster/server_stub.h>
 #include <smf/ipt/scramble_key.h>
+#include "credential_cache.h"
+#include "admission.h"
 
 namespace node 
 {
@@ -24,7 +26,10 @@ namespace node
 				, std::chrono::seconds timeout
 				, scramble_key const& sk
 				, uint16_t watchdog
-				, bool sml_log);
+				, bool sml_log
+				, std::size_t proxy_batch
+				, credential_cache& cache
+				, admission& adm);
 
 		protected:
 			virtual cyng::object make_client(boost::uuids::uuid tag, boost::asio::ip::tcp::socket socket) override;
@@ -37,6 +42,9 @@ namespace node
 			 scramble_key const sk_;
 			 std::uint16_t const watchdog_;
 			 bool const sml_log_;
+			 std::size_t const proxy_batch_;
+			 credential_cache& cache_;
+			 admission& admission_;
 		};
 	}
 }
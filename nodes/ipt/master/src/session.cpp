@@ -42,7 +42,10 @@ namespace node
 			, std::chrono::seconds timeout
 			, scramble_key const& sk
 			, std::uint16_t watchdog
-			, bool sml_log)
+			, bool sml_log
+			, std::size_t proxy_batch
+			, credential_cache& cache
+			, admission& adm)
 		: session_stub(std::move(socket), mux, logger, bus, tag, timeout)
 			, parser_([this](cyng::vector_t&& prg) {
 				//CYNG_LOG_DEBUG(logger_, prg.size() << " ipt instructions received");
@@ -51,6 +54,8 @@ namespace node
 			}, sk)
 			, serializer_(socket_, vm_, sk)
 			, timeout_(timeout)
+			, cache_(cache)
+			, admission_(adm)
 			, state_(this)
 			, proxy_comm_(state_)
 #ifdef SMF_IO_LOG
@@ -75,7 +80,7 @@ namespace node
 
 			vm_.register_function("client.req.gateway.proxy", 11, std::bind(&session::client_req_gateway_proxy, this, std::placeholders::_1));
 			
-			vm_.register_function("session.start.proxy", 0, [this, sml_log](cyng::context& ctx) {
+			vm_.register_function("session.start.proxy", 0, [this, sml_log, proxy_batch](cyng::context& ctx) {
 
 				//
 				//	start SML proxy 
@@ -85,7 +90,8 @@ namespace node
 					, bus_
 					, vm_
 					, timeout_
-					, sml_log)));
+					, sml_log
+					, proxy_batch)));
 
 			});
 
@@ -1426,8 +1432,11 @@ namespace node
 			//	set acknownlegde flag
 			//
 			std::uint8_t status = cyng::value_cast<std::uint8_t>(dom.get("status"), 0);
-			//BOOST_ASSERT_MSG(status == 0xc1, "invalid push channel status");
-			if (status != 0xc1)
+			//
+			//	segmented payloads have SYN only in the first block, ACK in
+			//	all following blocks and FIN in the last block
+			//
+			if ((status & ~(tp_res_pushdata_transfer_policy::SYN | tp_res_pushdata_transfer_policy::ACK | tp_res_pushdata_transfer_policy::FIN | 0x03)) != 0)
 			{
 				ctx.queue(cyng::generate_invoke("log.msg.warning"
 					, "client.res.transfer.pushdata - status"
@@ -1770,7 +1779,10 @@ namespace node
 			, std::chrono::seconds const& timeout
 			, scramble_key const& sk
 			, std::uint16_t watchdog
-			, bool sml_log)
+			, bool sml_log
+			, std::size_t proxy_batch
+			, credential_cache& cache
+			, admission& adm)
 		{
 			return cyng::make_object<session>(std::move(socket)
 				, mux
@@ -1780,7 +1792,10 @@ namespace node
 				, timeout
 				, sk
 				, watchdog
-				, sml_log);
+				, sml_log
+				, proxy_batch
+				, cache
+				, adm);
 		}
 
 	}
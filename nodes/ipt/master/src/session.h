@@ -13,6 +13,8 @@
 #include <smf/cluster/session_stub.h>
 #include "session_state.h"
 #include "proxy_comm.h"
+#include "credential_cache.h"
+#include "admission.h"
 
 namespace node 
 {
@@ -34,7 +36,10 @@ namespace node
 				, std::chrono::seconds timeout
 				, scramble_key const& sk
 				, std::uint16_t watchdog
-				, bool sml_log);
+				, bool sml_log
+				, std::size_t proxy_batch
+				, credential_cache& cache
+				, admission& adm);
 
 			session(session const&) = delete;
 			session& operator=(session const&) = delete;
@@ -143,6 +148,13 @@ namespace node
 			 */
 			std::map<sequence_type, std::pair<std::size_t, std::size_t>>	task_db_;
 
+			/**
+			 * local copy of TDevice and login rate limit
+			 * (shared by all sessions)
+			 */
+			credential_cache& cache_;
+			admission& admission_;
+
 			/**
 			 * contains state of local connections
 			 */
@@ -166,7 +178,10 @@ namespace node
 			, std::chrono::seconds const& timeout
 			, scramble_key const& sk
 			, std::uint16_t watchdog
-			, bool sml_log);
+			, bool sml_log
+			, std::size_t proxy_batch
+			, credential_cache& cache
+			, admission& adm);
 
 	}
 }
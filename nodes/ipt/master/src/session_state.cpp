@@ -321,6 +321,37 @@ namespace node
 			//
 			cyng::vector_t prg;
 
+			//
+			//	read original data
+			//
+			auto dom = cyng::make_reader(evt.bag_);
+
+			if (cyng::value_cast(dom.get("cached"), false)) {
+
+				//
+				//	login was already answered from cache
+				//
+				if (!evt.success_) {
+
+					//
+					//	master disagrees (e.g. account already online or served by another shard).
+					//	Following logins of this account are decided by the master.
+					//
+					CYNG_LOG_WARNING(logger_, sp_->vm().tag()
+						<< " cached login of ["
+						<< evt.name_
+						<< "] rejected by master: "
+						<< evt.msg_);
+
+					sp_->cache_.forward(cyng::value_cast(dom.get("pk"), boost::uuids::nil_uuid()));
+					prg
+						<< cyng::generate_invoke_unwinded("ip.tcp.socket.shutdown")
+						<< cyng::generate_invoke_unwinded("ip.tcp.socket.close")
+						;
+				}
+				return prg;
+			}
+
 			switch (state_) {
 			case S_IDLE:
 				break;
@@ -329,66 +360,85 @@ namespace node
 				return prg;
 			}
 
-
 			//
-			//	read original data
+			//	sharded cluster: account is served by another IP-T node
 			//
-			auto dom = cyng::make_reader(evt.bag_);
+			const std::string redirect = cyng::value_cast<std::string>(dom.get("redirect"), "");
 
 			//
 			//	IP-T result type
 			//
 			const response_type res = evt.success_
 				? ctrl_res_login_public_policy::SUCCESS
-				: ctrl_res_login_public_policy::UNKNOWN_ACCOUNT
+				: (redirect.empty() ? ctrl_res_login_public_policy::UNKNOWN_ACCOUNT : ctrl_res_login_public_policy::NEW_ADDRESS)
 				;
 
 			//
 			//	send login response to device
 			//
 			const std::string security = cyng::value_cast<std::string>(dom.get("security"), "undef");
+			if (evt.success_) {
+				return accept_login(security, evt.name_, evt.query_);
+			}
+
+			prg << cyng::unwind(login_response(security, res, idle_.watchdog_, redirect));
+
+			//
+			//	gatekeeper will terminating this session
+			//
+			return prg;
+		}
+
+		cyng::vector_t session_state::login_response(std::string const& security
+			, response_type res
+			, std::uint16_t watchdog
+			, std::string const& redirect)
+		{
+			cyng::vector_t prg;
 			if (boost::algorithm::equals(security, "scrambled")) {
-				prg << cyng::generate_invoke_unwinded("res.login.scrambled", res, idle_.watchdog_, "");
+				prg << cyng::generate_invoke_unwinded("res.login.scrambled", res, watchdog, redirect);
 			}
 			else {
-				prg << cyng::generate_invoke_unwinded("res.login.public", res, idle_.watchdog_, "");
+				prg << cyng::generate_invoke_unwinded("res.login.public", res, watchdog, redirect);
 			}
 			prg << cyng::generate_invoke_unwinded("stream.flush");
+			return prg;
+		}
 
-			if (evt.success_) {
-
-				//
-				//	update session state
-				//
-				transit(S_AUTHORIZED);
-
-				//
-				//	stop gatekeeper
-				//
-				idle_.stop(sp_->mux_);
+		cyng::vector_t session_state::accept_login(std::string const& security, std::string const& name, std::uint32_t query_flags)
+		{
+			cyng::vector_t prg;
 
-				//
-				//	start watchdog
-				//
-				if (idle_.watchdog_ != 0) {
-					prg << cyng::generate_invoke_unwinded("session.start.watchdog", idle_.watchdog_, evt.name_);
-				}
+			const response_type res = ctrl_res_login_public_policy::SUCCESS;
+			prg << cyng::unwind(login_response(security, res, idle_.watchdog_, ""));
 
-				//
-				//	send query
-				//
-				prg << cyng::unwind(query(evt.query_));
+			//
+			//	update session state
+			//
+			transit(S_AUTHORIZED);
 
-				//
-				//	start proxy
-				//
-				prg << cyng::generate_invoke_unwinded("session.start.proxy");
+			//
+			//	stop gatekeeper
+			//
+			idle_.stop(sp_->mux_);
 
+			//
+			//	start watchdog
+			//
+			if (idle_.watchdog_ != 0) {
+				prg << cyng::generate_invoke_unwinded("session.start.watchdog", idle_.watchdog_, name);
 			}
 
 			//
-			//	gatekeeper will terminating this session
+			//	send query
+			//
+			prg << cyng::unwind(query(query_flags));
+
 			//
+			//	start proxy
+			//
+			prg << cyng::generate_invoke_unwinded("session.start.proxy");
+
 			return prg;
 		}
 
@@ -466,14 +516,12 @@ namespace node
 
 		cyng::vector_t session_state::react(state::evt_req_login_public evt)
 		{
-			cyng::vector_t prg;
-
 			switch (state_) {
 			case S_IDLE:
 				break;
 			default:
 				signal_wrong_state("evt_req_login_public");
-				return prg;
+				return cyng::vector_t();
 			}
 
 			CYNG_LOG_INFO(logger_, "ipt.req.login.public "
@@ -483,48 +531,17 @@ namespace node
 				<< ':'
 				<< evt.pwd_);
 
-			if (sp_->bus_->is_online()) {
-
-				sp_->bus_->vm_.async_run(client_req_login(evt.tag_
-					, evt.name_	//	name
-					, evt.pwd_	//	pwd
-					, "plain" //	login scheme
-					, cyng::param_map_factory("tp-layer", "ipt")("security", "public")("time", std::chrono::system_clock::now())));
-
-			}
-			else {
-
-				//
-				//	reject login - faulty master
-				//
-				const response_type res = ctrl_res_login_public_policy::MALFUNCTION;
-
-				prg
-					<< cyng::generate_invoke_unwinded("res.login.public", res, static_cast<std::uint16_t>(0), "")
-					<< cyng::generate_invoke_unwinded("stream.flush")
-					<< cyng::generate_invoke_unwinded("log.msg.error", "public login failed - no master")
-					;
-
-			}
-
-			//
-			//	update watchdog timer
-			//
-			authorized_.activity(sp_->mux_);
-
-			return prg;
+			return req_login(evt.tag_, evt.name_, evt.pwd_, "public");
 		}
 
 		cyng::vector_t session_state::react(state::evt_req_login_scrambled evt)
 		{
-			cyng::vector_t prg;
-
 			switch (state_) {
 			case S_IDLE:
 				break;
 			default:
 				signal_wrong_state("evt_req_login_scrambled");
-				return prg;
+				return cyng::vector_t();
 			}
 
 			CYNG_LOG_INFO(logger_, "ipt.req.login.scrambled "
@@ -534,16 +551,17 @@ namespace node
 				<< ':'
 				<< evt.pwd_);
 
-			if (sp_->bus_->is_online()) {
+			return req_login(evt.tag_, evt.name_, evt.pwd_, "scrambled");
+		}
 
-				sp_->bus_->vm_.async_run(client_req_login(evt.tag_
-					, evt.name_	//	name
-					, evt.pwd_	//	pwd
-					, "plain" //	login scheme
-					, cyng::param_map_factory("tp-layer", "ipt")("security", "scrambled")("time", std::chrono::system_clock::now())));
+		cyng::vector_t session_state::req_login(boost::uuids::uuid tag
+			, std::string const& name
+			, std::string const& pwd
+			, std::string const& security)
+		{
+			cyng::vector_t prg;
 
-			}
-			else {
+			if (!sp_->bus_->is_online()) {
 
 				//
 				//	reject login - faulty master
@@ -551,11 +569,82 @@ namespace node
 				const response_type res = ctrl_res_login_public_policy::MALFUNCTION;
 
 				prg
-					<< cyng::generate_invoke_unwinded("res.login.public", res, static_cast<std::uint16_t>(0), "")
-					<< cyng::generate_invoke_unwinded("stream.flush")
-					<< cyng::generate_invoke_unwinded("log.msg.error", "scrambled login failed - no master")
+					<< cyng::unwind(login_response(security, res, 0, ""))
+					<< cyng::generate_invoke_unwinded("log.msg.error", security + " login failed - no master")
 					;
 			}
+			else if (!sp_->admission_.try_acquire()) {
+
+				//
+				//	reject login - too many logins at once.
+				//	The login response has no "busy" code. MALFUNCTION
+				//	signals a temporary fault of the master and the device
+				//	will try again later.
+				//
+				const response_type res = ctrl_res_login_public_policy::MALFUNCTION;
+
+				prg
+					<< cyng::unwind(login_response(security, res, 0, ""))
+					<< cyng::generate_invoke_unwinded("log.msg.warning", security + " login of [" + name + "] deferred - login rate exceeded")
+					;
+			}
+			else {
+
+				boost::uuids::uuid pk = boost::uuids::nil_uuid();
+				std::uint32_t query_flags{ 6 };
+				switch (sp_->cache_.test(name, pwd, pk, query_flags)) {
+				case credential_cache::CC_REJECT:
+
+					//
+					//	wrong password - no need to ask the master.
+					//	gatekeeper will terminating this session
+					//
+					CYNG_LOG_WARNING(logger_, sp_->vm().tag() << " login of [" << name << "] rejected by cache (wrong password)");
+					prg << cyng::unwind(login_response(security, ctrl_res_login_public_policy::UNKNOWN_ACCOUNT, idle_.watchdog_, ""));
+
+					//
+					//	inform master
+					//
+					sp_->bus_->vm_.async_run(bus_insert_msg(cyng::logging::severity::LEVEL_WARNING
+						, security + " login of [" + name + "] rejected by IP-T node (wrong password)"));
+					break;
+
+				case credential_cache::CC_MATCH:
+
+					//
+					//	answer login and inform the master afterwards.
+					//	The master creates the session record. The primary key
+					//	saves the master a scan of the device table.
+					//
+					prg << cyng::unwind(accept_login(security, name, query_flags));
+					sp_->bus_->vm_.async_run(client_req_login(tag
+						, name	//	name
+						, pwd	//	pwd
+						, "plain" //	login scheme
+						, cyng::param_map_factory("tp-layer", "ipt")("security", security)("pk", pk)("cached", true)("time", std::chrono::system_clock::now())));
+					break;
+
+				case credential_cache::CC_FORWARD:
+
+					//
+					//	master decides (online state, shard redirect)
+					//
+					sp_->bus_->vm_.async_run(client_req_login(tag
+						, name	//	name
+						, pwd	//	pwd
+						, "plain" //	login scheme
+						, cyng::param_map_factory("tp-layer", "ipt")("security", security)("pk", pk)("time", std::chrono::system_clock::now())));
+					break;
+
+				default:
+					sp_->bus_->vm_.async_run(client_req_login(tag
+						, name	//	name
+						, pwd	//	pwd
+						, "plain" //	login scheme
+						, cyng::param_map_factory("tp-layer", "ipt")("security", security)("time", std::chrono::system_clock::now())));
+					break;
+				}
+			}
 
 			//
 			//	update watchdog timer
@@ -2003,7 +2092,7 @@ namespace node
 
 			void state_connected_task::attention_msg(cyng::async::mux& mux, cyng::vector_t vec)
 			{
-				mux.post(tsk_proxy_, 6, cyng::tuple_t{ vec.at(3), vec.at(4) });
+				mux.post(tsk_proxy_, 6, cyng::tuple_t{ vec.at(1), vec.at(3), vec.at(4) });
 			}
 
 		}
@@ -549,6 +549,29 @@ namespace node
 
 			cyng::vector_t query(std::uint32_t);
 
+			/**
+			 * Answer login requests from the local cache and inform the
+			 * master afterwards. Unknown accounts are forwarded to the master.
+			 * A wrong password is rejected immediately and reported to the master.
+			 */
+			cyng::vector_t req_login(boost::uuids::uuid tag
+				, std::string const& name
+				, std::string const& pwd
+				, std::string const& security);
+
+			/**
+			 * send login response with the login type of the request
+			 */
+			cyng::vector_t login_response(std::string const& security
+				, response_type res
+				, std::uint16_t watchdog
+				, std::string const& redirect);
+
+			/**
+			 * send login response and start session
+			 */
+			cyng::vector_t accept_login(std::string const& security, std::string const& name, std::uint32_t query_flags);
+
 		private:
 			session* sp_;
 			cyng::logging::log_ptr logger_;
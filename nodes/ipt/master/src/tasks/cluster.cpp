@@ -10,6 +10,11 @@
 #include <cyng/async/task/task_builder.hpp>
 #include <cyng/io/serializer.h>
 #include <cyng/vm/generator.h>
+#include <cyng/tuple_cast.hpp>
+#include <cyng/value_cast.hpp>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/uuid/nil_generator.hpp>
 
 namespace node
 {
@@ -22,20 +27,45 @@ namespace node
 		, ipt::scramble_key const& sk
 		, uint16_t watchdog
 		, int timeout
-		, bool sml_log)
+		, bool sml_log
+		, std::size_t proxy_batch
+		, bool login_cache
+		, std::uint32_t login_rate
+		, std::uint32_t login_burst)
 	: base_(*btp)
 	, bus_(bus_factory(btp->mux_, logger, cluster_tag, btp->get_id()))
 	, logger_(logger)
 	, config_(cfg_cls)
 	, ipt_address_(address)
 	, ipt_service_(service)
-	, server_(btp->mux_, logger_, bus_, std::chrono::seconds(timeout), sk, watchdog, sml_log)
+	, cache_(login_cache)
+	, admission_(login_rate, login_burst)
+	, server_(btp->mux_, logger_, bus_, std::chrono::seconds(timeout), sk, watchdog, sml_log, proxy_batch, cache_, admission_)
 	{
 		CYNG_LOG_INFO(logger_, "initialize task #"
 			<< base_.get_id()
 			<< " <"
 			<< base_.get_class_name()
-			<< ">");
+			<< "> login cache is "
+			<< (cache_.is_enabled() ? "ON" : "OFF")
+			<< ", max. "
+			<< login_rate
+			<< " logins/sec");
+
+		//
+		//	TDevice synchronization
+		//
+		bus_->vm_.register_function("db.trx.start", 0, [this](cyng::context& ctx) {
+			CYNG_LOG_TRACE(logger_, "db.trx.start");
+		});
+		bus_->vm_.register_function("db.trx.commit", 0, [this](cyng::context& ctx) {
+			CYNG_LOG_TRACE(logger_, "db.trx.commit");
+		});
+		bus_->vm_.register_function("bus.res.subscribe", 6, std::bind(&cluster::res_subscribe, this, std::placeholders::_1));
+		bus_->vm_.register_function("db.req.insert", 4, std::bind(&cluster::db_req_insert, this, std::placeholders::_1));
+		bus_->vm_.register_function("db.req.remove", 3, std::bind(&cluster::db_req_remove, this, std::placeholders::_1));
+		bus_->vm_.register_function("db.req.modify.by.param", 5, std::bind(&cluster::db_req_modify_by_param, this, std::placeholders::_1));
+		bus_->vm_.register_function("db.clear", 1, std::bind(&cluster::db_clear, this, std::placeholders::_1));
 
 		//
 		//	implement request handler
@@ -86,6 +116,16 @@ namespace node
 			CYNG_LOG_WARNING(logger_, "insufficient cluster protocol version: "	<< v);
 		}
 
+		//
+		//	The master sends all existing records and
+		//	all following changes.
+		//
+		if (cache_.is_enabled()) {
+			cache_.clear();
+			CYNG_LOG_INFO(logger_, "subscribe table TDevice");
+			bus_->vm_.async_run(bus_req_subscribe("TDevice", base_.get_id()));
+		}
+
 		//
 		//	start ipt master
 		//
@@ -106,6 +146,11 @@ namespace node
 		//
 		server_.close();
 
+		//
+		//	cache will be synchronized again after reconnect
+		//
+		cache_.clear();
+
 		//
 		//	switch to other configuration
 		//
@@ -169,4 +214,123 @@ namespace node
 
 	}
 
+	void cluster::res_subscribe(cyng::context& ctx)
+	{
+		const cyng::vector_t frame = ctx.get_frame();
+		//
+		//	* table name
+		//	* record key
+		//	* record data
+		//	* generation
+		//	* origin session id
+		//	* optional task id
+		//	
+		auto tpl = cyng::tuple_cast<
+			std::string,			//	[0] table name
+			cyng::table::key_type,	//	[1] table key
+			cyng::table::data_type,	//	[2] record
+			std::uint64_t,			//	[3] generation
+			boost::uuids::uuid,		//	[4] origin session id
+			std::size_t				//	[5] optional task id
+		>(frame);
+
+		//
+		//	reorder vectors
+		//
+		std::reverse(std::get<1>(tpl).begin(), std::get<1>(tpl).end());
+		std::reverse(std::get<2>(tpl).begin(), std::get<2>(tpl).end());
+
+		insert(std::get<0>(tpl), std::get<1>(tpl), std::get<2>(tpl));
+	}
+
+	void cluster::db_req_insert(cyng::context& ctx)
+	{
+		const cyng::vector_t frame = ctx.get_frame();
+		//
+		//	* table name
+		//	* record key
+		//	* record data
+		//	* generation
+		//	* source
+		//	
+		auto tpl = cyng::tuple_cast<
+			std::string,			//	[0] table name
+			cyng::table::key_type,	//	[1] table key
+			cyng::table::data_type,	//	[2] record
+			std::uint64_t,			//	[3] generation
+			boost::uuids::uuid		//	[4] source
+		>(frame);
+
+		std::reverse(std::get<1>(tpl).begin(), std::get<1>(tpl).end());
+		std::reverse(std::get<2>(tpl).begin(), std::get<2>(tpl).end());
+
+		insert(std::get<0>(tpl), std::get<1>(tpl), std::get<2>(tpl));
+	}
+
+	void cluster::db_req_remove(cyng::context& ctx)
+	{
+		const cyng::vector_t frame = ctx.get_frame();
+		//
+		//	* table name
+		//	* record key
+		//	* source
+		//	
+		auto tpl = cyng::tuple_cast<
+			std::string,			//	[0] table name
+			cyng::table::key_type,	//	[1] table key
+			boost::uuids::uuid		//	[2] source
+		>(frame);
+
+		if (boost::algorithm::equals(std::get<0>(tpl), "TDevice") && std::get<1>(tpl).size() == 1) {
+			cache_.remove(cyng::value_cast(std::get<1>(tpl).at(0), boost::uuids::nil_uuid()));
+		}
+	}
+
+	void cluster::db_req_modify_by_param(cyng::context& ctx)
+	{
+		const cyng::vector_t frame = ctx.get_frame();
+		//
+		//	* table name
+		//	* record key
+		//	* param [column,value]
+		//	* generation
+		//	* source
+		//	
+		auto tpl = cyng::tuple_cast<
+			std::string,			//	[0] table name
+			cyng::table::key_type,	//	[1] table key
+			cyng::param_t,			//	[2] parameter
+			std::uint64_t,			//	[3] generation
+			boost::uuids::uuid		//	[4] source
+		>(frame);
+
+		if (boost::algorithm::equals(std::get<0>(tpl), "TDevice") && std::get<1>(tpl).size() == 1) {
+			cache_.modify(cyng::value_cast(std::get<1>(tpl).at(0), boost::uuids::nil_uuid()), std::get<2>(tpl));
+		}
+	}
+
+	void cluster::db_clear(cyng::context& ctx)
+	{
+		const cyng::vector_t frame = ctx.get_frame();
+		if (boost::algorithm::equals(cyng::value_cast<std::string>(frame.at(0), ""), "TDevice")) {
+			cache_.clear();
+		}
+	}
+
+	void cluster::insert(std::string const& table
+		, cyng::table::key_type const& key
+		, cyng::table::data_type const& data)
+	{
+		if (boost::algorithm::equals(table, "TDevice") && key.size() == 1 && data.size() == 9) {
+
+			//
+			//	[name, pwd, msisdn, descr, id, vFirmware, enabled, creationTime, query]
+			//
+			cache_.insert(cyng::value_cast(key.at(0), boost::uuids::nil_uuid())
+				, cyng::value_cast<std::string>(data.at(0), "")
+				, cyng::value_cast<std::string>(data.at(1), "")
+				, cyng::value_cast<std::uint32_t>(data.at(8), 6u));
+		}
+	}
+
 }
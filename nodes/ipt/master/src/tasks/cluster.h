@@ -11,6 +11,8 @@
 #include <smf/cluster/bus.h>
 #include <smf/cluster/config.h>
 #include "../server.h"
+#include "../credential_cache.h"
+#include "../admission.h"
 #include <cyng/log.h>
 #include <cyng/async/mux.h>
 #include <cyng/async/policy.h>
@@ -35,7 +37,11 @@ namespace node
 			, ipt::scramble_key const& sk
 			, uint16_t watchdog
 			, int timeout
-			, bool sml_log);
+			, bool sml_log
+			, std::size_t proxy_batch
+			, bool login_cache
+			, std::uint32_t login_rate
+			, std::uint32_t login_burst);
 		cyng::continuation run();
 		void stop();
 
@@ -59,6 +65,18 @@ namespace node
 		void reconfigure(cyng::context& ctx);
 		void reconfigure_impl();
 
+		/**
+		 * TDevice synchronization
+		 */
+		void res_subscribe(cyng::context& ctx);
+		void db_req_insert(cyng::context& ctx);
+		void db_req_remove(cyng::context& ctx);
+		void db_req_modify_by_param(cyng::context& ctx);
+		void db_clear(cyng::context& ctx);
+		void insert(std::string const& table
+			, cyng::table::key_type const& key
+			, cyng::table::data_type const& data);
+
 	private:
 		cyng::async::base_task& base_;
 		bus::shared_type bus_;
@@ -66,6 +84,14 @@ namespace node
 		const cluster_redundancy	config_;
 		const std::string ipt_address_;
 		const std::string ipt_service_;
+
+		/**
+		 * Hashed credentials from TDevice to answer
+		 * logins without a round trip to the master.
+		 */
+		ipt::credential_cache cache_;
+		ipt::admission admission_;
+
 		ipt::server	server_;
 	};
 	
@@ -28,12 +28,36 @@
 
 namespace node
 {
+	namespace
+	{
+		/**
+		 * Transaction ids are generated as "value-n" with an ascending number n.
+		 *
+		 * @return all transaction ids after "first" up to and including "last"
+		 */
+		std::vector<std::string> trx_range(std::string const& first, std::string const& last)
+		{
+			std::vector<std::string> r;
+			auto const pos = last.rfind('-');
+			if (pos == std::string::npos || first.size() <= pos)	return r;
+
+			auto const prefix = last.substr(0, pos + 1);
+			auto const from = std::stoul(first.substr(pos + 1));
+			auto const to = std::stoul(last.substr(pos + 1));
+			for (auto n = from + 1; n <= to; ++n) {
+				r.push_back(prefix + std::to_string(n));
+			}
+			return r;
+		}
+	}
+
 	gateway_proxy::gateway_proxy(cyng::async::base_task* btp
 		, cyng::logging::log_ptr logger
 		, bus::shared_type bus
 		, cyng::controller& vm
 		, std::chrono::seconds timeout
-		, bool sml_log)
+		, bool sml_log
+		, std::size_t batch)
 	: base_(*btp)
 		, logger_(logger)
 		, bus_(bus)
@@ -54,18 +78,22 @@ namespace node
 			vm_.async_run(std::move(prg));
 
 		}, false, sml_log)	//	not verbose, no log instructions
+		, batch_((batch == 0) ? 1 : batch)
 		, queue_()
+		, active_()
+		, trx_()
 	{
 		CYNG_LOG_INFO(logger_, "task #"
 			<< base_.get_id()
 			<< " <"
 			<< base_.get_class_name()
-			<< "> is running");
+			<< "> is running - batch size "
+			<< batch_);
 	}
 
 	cyng::continuation gateway_proxy::run()
 	{	
-		if (!queue_.empty() && queue_.front().is_waiting()) {
+		if (!queue_.empty() && active_.empty()) {
 
 			CYNG_LOG_INFO(logger_, "task #"
 				<< base_.get_id()
@@ -92,12 +120,17 @@ namespace node
 	//	slot 0 - ack
 	cyng::continuation gateway_proxy::process()
 	{
-		if (!queue_.empty()) {
+		if (!active_.empty()) {
 
-			//
-			//	update data state
-			//
-			queue_.front().next();
+			CYNG_LOG_WARNING(logger_, "task #"
+				<< base_.get_id()
+				<< " <"
+				<< base_.get_class_name()
+				<< "> got acknowledge but "
+				<< active_.size()
+				<< " requests are pending");
+		}
+		else if (!queue_.empty()) {
 
 			CYNG_LOG_INFO(logger_, "task #"
 				<< base_.get_id()
@@ -189,13 +222,23 @@ namespace node
 			<< " <"
 			<< base_.get_class_name()
 			<< "> sml.public.close.response "
-			<< std::string(trx.begin(), trx.end()));
+			<< std::string(trx.begin(), trx.end())
+			<< " - "
+			<< active_.size()
+			<< " request(s) complete");
 
 		//
-		//	current SML request is complete
+		//	current SML transaction is complete
 		//
+		active_.clear();
+		trx_.clear();
+
 		if (!queue_.empty()) {
-			queue_.pop();
+
+			//
+			//	next transaction
+			//
+			vm_.async_run(cyng::generate_invoke("session.redirect", base_.get_id()));
 		}
 
 		return cyng::continuation::TASK_CONTINUE;
@@ -208,30 +251,42 @@ namespace node
 		cyng::buffer_t code,
 		cyng::param_map_t params)
 	{
-		BOOST_ASSERT(!queue_.empty());
+		auto const pd = lookup(trx);
+		if (pd == nullptr) {
+
+			CYNG_LOG_WARNING(logger_, "task #"
+				<< base_.get_id()
+				<< " <"
+				<< base_.get_class_name()
+				<< "> response "
+				<< trx
+				<< " from "
+				<< server_id
+				<< " without request");
+			return cyng::continuation::TASK_CONTINUE;
+		}
 
 		CYNG_LOG_INFO(logger_, "task #"
 			<< base_.get_id()
 			<< " <"
 			<< base_.get_class_name()
 			<< "> response #"
-			<< queue_.front().get_sequence()
+			<< pd->get_sequence()
 			<< " from "
 			<< server_id
 			<< "/"
-			<< sml::from_server_id(queue_.front().get_srv()));
+			<< sml::from_server_id(pd->get_srv()));
 
-		//BOOST_ASSERT(sml::from_server_id(queue_.front().get_srv()) == server_id);
 		if (server_id.empty()) {
-			server_id = sml::from_server_id(queue_.front().get_srv());
+			server_id = sml::from_server_id(pd->get_srv());
 		}
 
-		bus_->vm_.async_run(bus_res_gateway_proxy(queue_.front().get_ident_tag()
-			, queue_.front().get_source_tag()
-			, queue_.front().get_sequence()
-			, queue_.front().get_key()
-			, queue_.front().get_ws_tag()
-			, queue_.front().get_channel()
+		bus_->vm_.async_run(bus_res_gateway_proxy(pd->get_ident_tag()
+			, pd->get_source_tag()
+			, pd->get_sequence()
+			, pd->get_key()
+			, pd->get_ws_tag()
+			, pd->get_channel()
 			, server_id
 			, sml::get_name(code)
 			, params));
@@ -239,26 +294,42 @@ namespace node
 		return cyng::continuation::TASK_CONTINUE;
 	}
 
-	cyng::continuation gateway_proxy::process(std::string srv
+	cyng::continuation gateway_proxy::process(std::string trx
+		, std::string srv
 		, cyng::buffer_t const& code)
 	{
 		sml::obis attention(code);
 
+		auto const pd = lookup(trx);
+		if (pd == nullptr) {
+
+			CYNG_LOG_WARNING(logger_, "task #"
+				<< base_.get_id()
+				<< " <"
+				<< base_.get_class_name()
+				<< "> attention code "
+				<< sml::get_attention_name(attention)
+				<< " from "
+				<< srv
+				<< " without request");
+			return cyng::continuation::TASK_CONTINUE;
+		}
+
 		CYNG_LOG_INFO(logger_, "task #"
 			<< base_.get_id()
 			<< " <"
 			<< base_.get_class_name()
 			<< "> response #"
-			<< queue_.front().get_sequence()
+			<< pd->get_sequence()
 			<< " from "
 			<< srv
 			<< " attention code "
 			<< sml::get_attention_name(attention));
 
-		bus_->vm_.async_run(bus_res_attention_code(queue_.front().get_ident_tag()
-			, queue_.front().get_source_tag()
-			, queue_.front().get_sequence()
-			, queue_.front().get_ws_tag()
+		bus_->vm_.async_run(bus_res_attention_code(pd->get_ident_tag()
+			, pd->get_source_tag()
+			, pd->get_sequence()
+			, pd->get_ws_tag()
 			, srv
 			, code
 			, sml::get_attention_name(attention)));
@@ -288,7 +359,7 @@ namespace node
 			<< "> queue size "
 			<< queue_.size());
 
-		if (queue_.size() == 1) {
+		if (queue_.size() == 1 && active_.empty()) {
 
 			//
 			//	waiting for an opportunity to open a connection.If session is ready
@@ -300,6 +371,84 @@ namespace node
 
 
 	void gateway_proxy::execute_cmd()
+	{
+		BOOST_ASSERT(active_.empty());
+		BOOST_ASSERT(!queue_.empty());
+
+		//
+		//	generate public open request
+		//
+		node::sml::req_generator sml_gen;
+
+		auto const srv = queue_.front().get_srv();
+		auto const user = queue_.front().get_user();
+		auto const pwd = queue_.front().get_pwd();
+		auto const source_tag = queue_.front().get_source_tag();
+		sml_gen.public_open(get_mac(), srv, user, pwd);
+
+		//
+		//	add all queued requests with the same credentials
+		//
+		while (!queue_.empty()
+			&& (active_.size() < batch_)
+			&& (queue_.front().get_srv() == srv)
+			&& boost::algorithm::equals(queue_.front().get_user(), user)
+			&& boost::algorithm::equals(queue_.front().get_pwd(), pwd)) {
+
+			active_.push_back(queue_.front());
+			queue_.pop();
+
+			auto const first = sml_gen.get_trx();
+			execute_cmd(active_.back(), sml_gen);
+			for (auto const& trx : trx_range(first, sml_gen.get_trx())) {
+				trx_.emplace(trx, active_.size() - 1);
+			}
+		}
+
+		CYNG_LOG_INFO(logger_, "task #"
+			<< base_.get_id()
+			<< " <"
+			<< base_.get_class_name()
+			<< "> send "
+			<< active_.size()
+			<< " request(s) with "
+			<< trx_.size()
+			<< " message(s) - queue size "
+			<< queue_.size());
+
+		//
+		//	generate close request
+		//
+		sml_gen.public_close();
+		cyng::buffer_t msg = sml_gen.boxing();
+
+		//
+		//	update data throughput (outgoing)
+		//
+		bus_->vm_.async_run(client_inc_throughput(vm_.tag()
+			, source_tag
+			, msg.size()));
+
+#ifdef SMF_IO_LOG
+		cyng::io::hex_dump hd;
+		hd(std::cerr, msg.begin(), msg.end());
+#else
+		CYNG_LOG_DEBUG(logger_, "task #"
+			<< base_.get_id()
+			<< " <"
+			<< base_.get_class_name()
+			<< "> \n"
+			<< cyng::io::to_hex(msg, ' '))
+#endif
+
+		//
+		//	send to gateway
+		//
+		vm_.async_run({ cyng::generate_invoke("ipt.transfer.data", std::move(msg))
+			, cyng::generate_invoke("stream.flush") });
+	}
+
+	void gateway_proxy::execute_cmd(ipt::proxy_data const& pd, sml::req_generator& sml_gen)
 	{
 		//	[{("section":[op-log-status-word,root-visible-devices,root-active-devices,firmware,memory,root-wMBus-status,IF_wMBUS,root-ipt-state,root-ipt-param])}]
 		//	[{("name":smf-form-gw-ipt-srv),("value":0500153B022980)},{("name":smf-gw-ipt-host-1),("value":waiting...)},{("name":smf-gw-ipt-local-1),("value":4)},{("name":smf-gw-ipt-remote-1),("value":3)},{("name":smf-gw-ipt-name-1),("value":waiting...)},{("name":smf-gw-ipt-pwd-1),("value":asdasd)},{("name":smf-gw-ipt-host-2),("value":waiting...)},{("name":smf-gw-ipt-local-2),("value":3)},{("name":smf-gw-ipt-remote-2),("value":3)},{("name":smf-gw-ipt-name-2),("value":holgr)},{("name":smf-gw-ipt-pwd-2),("value":asdasd)}]
@@ -309,19 +458,19 @@ namespace node
 			<< " <"
 			<< base_.get_class_name()
 			<< "> execute channel "
-			<< queue_.front().get_channel());
+			<< pd.get_channel());
 		
-		if (boost::algorithm::equals(queue_.front().get_channel(), "get.proc.param")) {
+		if (boost::algorithm::equals(pd.get_channel(), "get.proc.param")) {
 
-			execute_cmd_get_proc_param();
+			execute_cmd_get_proc_param(pd, sml_gen);
 		}
-		else if (boost::algorithm::equals(queue_.front().get_channel(), "set.proc.param")) {
+		else if (boost::algorithm::equals(pd.get_channel(), "set.proc.param")) {
 
-			execute_cmd_set_proc_param();
+			execute_cmd_set_proc_param(pd, sml_gen);
 		}
-		else if (boost::algorithm::equals(queue_.front().get_channel(), "get.list.request")) {
+		else if (boost::algorithm::equals(pd.get_channel(), "get.list.request")) {
 
-			execute_cmd_get_list_request();
+			execute_cmd_get_list_request(pd, sml_gen);
 		}
 		else {
 			CYNG_LOG_ERROR(logger_, "task #"
@@ -329,31 +478,16 @@ namespace node
 				<< " <"
 				<< base_.get_class_name()
 				<< "> unknown channel "
-				<< queue_.front().get_channel());
-
-			//
-			//	remove queue entry
-			//
-			queue_.pop();
+				<< pd.get_channel());
 		}
 	}
 
-	void gateway_proxy::execute_cmd_get_proc_param()
+	void gateway_proxy::execute_cmd_get_proc_param(ipt::proxy_data const& pd, sml::req_generator& sml_gen)
 	{
-		//
-		//	generate public open request
-		//
-		node::sml::req_generator sml_gen;
-
-		sml_gen.public_open(get_mac()
-			, queue_.front().get_srv()
-			, queue_.front().get_user()
-			, queue_.front().get_pwd());
-
 		//
 		//	generate get process parameter requests
 		//
-		auto const sections = queue_.front().get_section_names();
+		auto const sections = pd.get_section_names();
 		for (auto const& sec : sections) {
 
 			CYNG_LOG_TRACE(logger_, "task #"
@@ -364,32 +498,32 @@ namespace node
 				<< sec);
 
 			if (boost::algorithm::equals("op-log-status-word", sec)) {
-				sml_gen.get_proc_status_word(queue_.front().get_srv(), queue_.front().get_user(), queue_.front().get_pwd());
+				sml_gen.get_proc_status_word(pd.get_srv(), pd.get_user(), pd.get_pwd());
 			}
 			else if (boost::algorithm::equals("root-visible-devices", sec)) {
-				sml_gen.get_proc_parameter_srv_visible(queue_.front().get_srv(), queue_.front().get_user(), queue_.front().get_pwd());
+				sml_gen.get_proc_parameter_srv_visible(pd.get_srv(), pd.get_user(), pd.get_pwd());
 			}
 			else if (boost::algorithm::equals("root-active-devices", sec)) {
 				//	send 81 81 11 06 FF FF
-				sml_gen.get_proc_parameter_srv_active(queue_.front().get_srv(), queue_.front().get_user(), queue_.front().get_pwd());
+				sml_gen.get_proc_parameter_srv_active(pd.get_srv(), pd.get_user(), pd.get_pwd());
 			}
 			else if (boost::algorithm::equals("root-device-id", sec)) {
-				sml_gen.get_proc_parameter_firmware(queue_.front().get_srv(), queue_.front().get_user(), queue_.front().get_pwd());
+				sml_gen.get_proc_parameter_firmware(pd.get_srv(), pd.get_user(), pd.get_pwd());
 			}
 			else if (boost::algorithm::equals("root-memory-usage", sec)) {
-				sml_gen.get_proc_parameter_memory(queue_.front().get_srv(), queue_.front().get_user(), queue_.front().get_pwd());
+				sml_gen.get_proc_parameter_memory(pd.get_srv(), pd.get_user(), pd.get_pwd());
 			}
 			else if (boost::algorithm::equals("root-wMBus-status", sec)) {
-				sml_gen.get_proc_parameter_wireless_mbus_status(queue_.front().get_srv(), queue_.front().get_user(), queue_.front().get_pwd());
+				sml_gen.get_proc_parameter_wireless_mbus_status(pd.get_srv(), pd.get_user(), pd.get_pwd());
 			}
 			else if (boost::algorithm::equals("IF_wMBUS", sec)) {
-				sml_gen.get_proc_parameter_wireless_mbus_config(queue_.front().get_srv(), queue_.front().get_user(), queue_.front().get_pwd());
+				sml_gen.get_proc_parameter_wireless_mbus_config(pd.get_srv(), pd.get_user(), pd.get_pwd());
 			}
 			else if (boost::algorithm::equals("root-ipt-state", sec)) {
-				sml_gen.get_proc_parameter_ipt_status(queue_.front().get_srv(), queue_.front().get_user(), queue_.front().get_pwd());
+				sml_gen.get_proc_parameter_ipt_status(pd.get_srv(), pd.get_user(), pd.get_pwd());
 			}
 			else if (boost::algorithm::equals("root-ipt-param", sec)) {
-				sml_gen.get_proc_parameter_ipt_config(queue_.front().get_srv(), queue_.front().get_user(), queue_.front().get_pwd());
+				sml_gen.get_proc_parameter_ipt_config(pd.get_srv(), pd.get_user(), pd.get_pwd());
 			}
 			else {
 				CYNG_LOG_WARNING(logger_, "task #"
@@ -400,78 +534,36 @@ namespace node
 					<< sec);
 			}
 		}
-
-		//
-		//	generate close request
-		//
-		sml_gen.public_close();
-		cyng::buffer_t msg = sml_gen.boxing();
-
-		//
-		//	update data throughput (outgoing)
-		//
-		bus_->vm_.async_run(client_inc_throughput(vm_.tag()
-			, queue_.front().get_source_tag()
-			, msg.size()));
-
-#ifdef SMF_IO_LOG
-		cyng::io::hex_dump hd;
-		hd(std::cerr, msg.begin(), msg.end());
-#else
-		CYNG_LOG_DEBUG(logger_, "task #"
-			<< base_.get_id()
-			<< " <"
-			<< base_.get_class_name()
-			<< "> \n"
-			<< cyng::io::to_hex(msg, ' '))
-#endif
-
-		//
-		//	send to gateway
-		//
-		vm_.async_run({ cyng::generate_invoke("ipt.transfer.data", std::move(msg))
-			, cyng::generate_invoke("stream.flush") });
-
 	}
 
-	void gateway_proxy::execute_cmd_set_proc_param()
+	void gateway_proxy::execute_cmd_set_proc_param(ipt::proxy_data const& pd, sml::req_generator& sml_gen)
 	{
-		//
-		//	generate public open request
-		//
-		node::sml::req_generator sml_gen;
-
-		sml_gen.public_open(get_mac()
-			, queue_.front().get_srv()
-			, queue_.front().get_user()
-			, queue_.front().get_pwd());
-
 		//
 		//	generate get process parameter requests
 		//
-		auto const sections = queue_.front().get_section_names();
+		auto const sections = pd.get_section_names();
 		BOOST_ASSERT_MSG(sections.size() == 1, "one section expected");
 		for (auto const& sec : sections) {
 
 			if (boost::algorithm::equals(sec, "ipt")) {
-				execute_cmd_set_proc_param_ipt(sml_gen);
+				execute_cmd_set_proc_param_ipt(pd, sml_gen);
 			}
 			else if (boost::algorithm::equals(sec, "wmbus")) {
-				execute_cmd_set_proc_param_wmbus(sml_gen);
+				execute_cmd_set_proc_param_wmbus(pd, sml_gen);
 			}
 			else if (boost::algorithm::equals(sec, "reboot")) {
-				sml_gen.set_proc_parameter_restart(queue_.front().get_srv()
-					, queue_.front().get_user()
-					, queue_.front().get_pwd());
+				sml_gen.set_proc_parameter_restart(pd.get_srv()
+					, pd.get_user()
+					, pd.get_pwd());
 			}
 			else if (boost::algorithm::equals(sec, "activate")) {
-				execute_cmd_set_proc_param_activate(sml_gen);
+				execute_cmd_set_proc_param_activate(pd, sml_gen);
 			}
 			else if (boost::algorithm::equals(sec, "deactivate")) {
-				execute_cmd_set_proc_param_deactivate(sml_gen);
+				execute_cmd_set_proc_param_deactivate(pd, sml_gen);
 			}
 			else if (boost::algorithm::equals(sec, "delete")) {
-				execute_cmd_set_proc_param_delete(sml_gen);
+				execute_cmd_set_proc_param_delete(pd, sml_gen);
 			}
 			else {
 				CYNG_LOG_WARNING(logger_, "task #"
@@ -482,60 +574,19 @@ namespace node
 					<< sec);
 			}
 		}
-
-		//	generate close request
-		//
-		sml_gen.public_close();
-		cyng::buffer_t msg = sml_gen.boxing();
-
-		//
-		//	update data throughput (outgoing)
-		//
-		bus_->vm_.async_run(client_inc_throughput(vm_.tag()
-			, queue_.front().get_source_tag()
-			, msg.size()));
-
-#ifdef SMF_IO_LOG
-		cyng::io::hex_dump hd;
-		hd(std::cerr, msg.begin(), msg.end());
-#else
-		CYNG_LOG_DEBUG(logger_, "task #"
-			<< base_.get_id()
-			<< " <"
-			<< base_.get_class_name()
-			<< "> emits \n"
-			<< cyng::io::to_hex(msg, ' '))
-#endif
-
-		//
-		//	send to gateway
-		//
-		vm_.async_run({ cyng::generate_invoke("ipt.transfer.data", std::move(msg))
-			, cyng::generate_invoke("stream.flush") });
-
 	}
 
-	void gateway_proxy::execute_cmd_get_list_request()
+	void gateway_proxy::execute_cmd_get_list_request(ipt::proxy_data const& pd, sml::req_generator& sml_gen)
 	{
-		//
-		//	generate public open request
-		//
-		node::sml::req_generator sml_gen;
-
-		sml_gen.public_open(get_mac()
-			, queue_.front().get_srv()
-			, queue_.front().get_user()
-			, queue_.front().get_pwd());
-
 		//
 		//	generate get process parameter requests
 		//
-		auto const sections = queue_.front().get_section_names();
+		auto const sections = pd.get_section_names();
 		BOOST_ASSERT_MSG(sections.size() == 1, "one section expected");
 		for (auto const& sec : sections) {
 
 			if (boost::algorithm::equals(sec, "list-current-data-record")) {
-				execute_cmd_get_list_req_last_data_set(sml_gen);
+				execute_cmd_get_list_req_last_data_set(pd, sml_gen);
 			}
 			else {
 				CYNG_LOG_WARNING(logger_, "task #"
@@ -546,46 +597,15 @@ namespace node
 					<< sec);
 			}
 		}
-
-		//	generate close request
-		//
-		sml_gen.public_close();
-		cyng::buffer_t msg = sml_gen.boxing();
-
-		//
-		//	update data throughput (outgoing)
-		//
-		bus_->vm_.async_run(client_inc_throughput(vm_.tag()
-			, queue_.front().get_source_tag()
-			, msg.size()));
-
-#ifdef SMF_IO_LOG
-		cyng::io::hex_dump hd;
-		hd(std::cerr, msg.begin(), msg.end());
-#else
-		CYNG_LOG_DEBUG(logger_, "task #"
-			<< base_.get_id()
-			<< " <"
-			<< base_.get_class_name()
-			<< "> \n"
-			<< cyng::io::to_hex(msg, ' '))
-#endif
-
-			//
-			//	send to gateway
-			//
-			vm_.async_run({ cyng::generate_invoke("ipt.transfer.data", std::move(msg))
-				, cyng::generate_invoke("stream.flush") });
-
 	}
 
 
-	void gateway_proxy::execute_cmd_set_proc_param_ipt(sml::req_generator& sml_gen)
+	void gateway_proxy::execute_cmd_set_proc_param_ipt(ipt::proxy_data const& pd, sml::req_generator& sml_gen)
 	{
 		//	("smf-gw-ipt-host-1":192.168.1.21),("smf-gw-ipt-host-2":192.168.1.21),("smf-gw-ipt-local-1":68ee),("smf-gw-ipt-local-2":68ef),("smf-gw-ipt-name-1":LSMTest5),("smf-gw-ipt-name-2":werwer),("smf-gw-ipt-pwd-1":LSMTest5),("smf-gw-ipt-pwd-2":LSMTest5),("smf-gw-ipt-remote-1":0),("smf-gw-ipt-remote-2":0))]
 		//	{("name":smf-form-gw-ipt-srv),("value":0500153B022980)},{("name":smf-gw-ipt-host-1),("value":waiting...)},{("name":smf-gw-ipt-local-1),("value":4)},{("name":smf-gw-ipt-remote-1),("value":3)},{("name":smf-gw-ipt-name-1),("value":waiting...)},{("name":smf-gw-ipt-pwd-1),("value":asdasd)},{("name":smf-gw-ipt-host-2),("value":waiting...)},{("name":smf-gw-ipt-local-2),("value":3)},{("name":smf-gw-ipt-remote-2),("value":3)},{("name":smf-gw-ipt-name-2),("value":holgr)},{("name":smf-gw-ipt-pwd-2),("value":asdasd)},{("section":[ipt])}
 
-		auto const params  = queue_.front().get_params();
+		auto const params  = pd.get_params();
 		for (auto const& p : params) {
 
 			if (boost::algorithm::equals(p.first, "smf-gw-ipt-host-1")) {
@@ -593,9 +613,9 @@ namespace node
 				//	send host name as it is - string
 				//boost::asio::ip::address address;
 				auto address = cyng::value_cast<std::string>(p.second, "0.0.0.0");
-				sml_gen.set_proc_parameter_ipt_host(queue_.front().get_srv()
-					, queue_.front().get_user()
-					, queue_.front().get_pwd()
+				sml_gen.set_proc_parameter_ipt_host(pd.get_srv()
+					, pd.get_user()
+					, pd.get_pwd()
 					, 1
 					, address);
 
@@ -603,82 +623,82 @@ namespace node
 			else if (boost::algorithm::equals(p.first, "smf-gw-ipt-host-2")) {
 
 				auto address = cyng::value_cast<std::string>(p.second, "0.0.0.0");
-				sml_gen.set_proc_parameter_ipt_host(queue_.front().get_srv()
-					, queue_.front().get_user()
-					, queue_.front().get_pwd()
+				sml_gen.set_proc_parameter_ipt_host(pd.get_srv()
+					, pd.get_user()
+					, pd.get_pwd()
 					, 2
 					, address);
 			}
 			else if (boost::algorithm::equals(p.first, "smf-gw-ipt-local-1")) {
 				auto port = cyng::value_cast<std::uint16_t>(p.second, 26862u);
-				sml_gen.set_proc_parameter_ipt_port_local(queue_.front().get_srv()
-					, queue_.front().get_user()
-					, queue_.front().get_pwd()
+				sml_gen.set_proc_parameter_ipt_port_local(pd.get_srv()
+					, pd.get_user()
+					, pd.get_pwd()
 					, 1
 					, port);
 			}
 			else if (boost::algorithm::equals(p.first, "smf-gw-ipt-local-2")) {
 				auto port = cyng::value_cast<std::uint16_t>(p.second, 26862u);
-				sml_gen.set_proc_parameter_ipt_port_local(queue_.front().get_srv()
-					, queue_.front().get_user()
-					, queue_.front().get_pwd()
+				sml_gen.set_proc_parameter_ipt_port_local(pd.get_srv()
+					, pd.get_user()
+					, pd.get_pwd()
 					, 2
 					, port);
 			}
 			else if (boost::algorithm::equals(p.first, "smf-gw-ipt-remote-1")) {
 				auto port = cyng::value_cast<std::uint16_t>(p.second, 26862u);
-				sml_gen.set_proc_parameter_ipt_port_remote(queue_.front().get_srv()
-					, queue_.front().get_user()
-					, queue_.front().get_pwd()
+				sml_gen.set_proc_parameter_ipt_port_remote(pd.get_srv()
+					, pd.get_user()
+					, pd.get_pwd()
 					, 1
 					, port);
 			}
 			else if (boost::algorithm::equals(p.first, "smf-gw-ipt-remote-2")) {
 				auto port = cyng::value_cast<std::uint16_t>(p.second, 26862u);
-				sml_gen.set_proc_parameter_ipt_port_remote(queue_.front().get_srv()
-					, queue_.front().get_user()
-					, queue_.front().get_pwd()
+				sml_gen.set_proc_parameter_ipt_port_remote(pd.get_srv()
+					, pd.get_user()
+					, pd.get_pwd()
 					, 2
 					, port);
 			}
 			else if (boost::algorithm::equals(p.first, "smf-gw-ipt-name-1")) {
 				auto str = cyng::value_cast<std::string>(p.second, "");
-				sml_gen.set_proc_parameter_ipt_user(queue_.front().get_srv()
-					, queue_.front().get_user()
-					, queue_.front().get_pwd()
+				sml_gen.set_proc_parameter_ipt_user(pd.get_srv()
+					, pd.get_user()
+					, pd.get_pwd()
 					, 1
 					, str);
 			}
 			else if (boost::algorithm::equals(p.first, "smf-gw-ipt-name-2")) {
 				auto str = cyng::value_cast<std::string>(p.second, "");
-				sml_gen.set_proc_parameter_ipt_user(queue_.front().get_srv()
-					, queue_.front().get_user()
-					, queue_.front().get_pwd()
+				sml_gen.set_proc_parameter_ipt_user(pd.get_srv()
+					, pd.get_user()
+					, pd.get_pwd()
 					, 2
 					, str);
 			}
 			else if (boost::algorithm::equals(p.first, "smf-gw-ipt-pwd-1")) {
 				auto str = cyng::value_cast<std::string>(p.second, "");
-				sml_gen.set_proc_parameter_ipt_pwd(queue_.front().get_srv()
-					, queue_.front().get_user()
-					, queue_.front().get_pwd()
+				sml_gen.set_proc_parameter_ipt_pwd(pd.get_srv()
+					, pd.get_user()
+					, pd.get_pwd()
 					, 1
 					, str);
 			}
 			else if (boost::algorithm::equals(p.first, "smf-gw-ipt-pwd-2")) {
 				auto str = cyng::value_cast<std::string>(p.second, "");
-				sml_gen.set_proc_parameter_ipt_pwd(queue_.front().get_srv()
-					, queue_.front().get_user()
-					, queue_.front().get_pwd()
+				sml_gen.set_proc_parameter_ipt_pwd(pd.get_srv()
+					, pd.get_user()
+					, pd.get_pwd()
 					, 2
 					, str);
 			}
 		}
 	}
 
-	void gateway_proxy::execute_cmd_set_proc_param_wmbus(sml::req_generator& sml_gen)
+	void gateway_proxy::execute_cmd_set_proc_param_wmbus(ipt::proxy_data const& pd, sml::req_generator& sml_gen)
 	{
-		auto const params = queue_.front().get_params();
+		auto const params = pd.get_params();
 		for (auto const& p : params) {
 			CYNG_LOG_DEBUG(logger_, "task #"
 				<< base_.get_id()
@@ -700,38 +720,38 @@ namespace node
 			if (boost::algorithm::equals(p.first, "smf-gw-wmbus-install")) {
 
 				const auto b = cyng::value_cast(p.second, false);
-				sml_gen.set_proc_parameter_wmbus_install(queue_.front().get_srv()
-					, queue_.front().get_user()
-					, queue_.front().get_pwd()
+				sml_gen.set_proc_parameter_wmbus_install(pd.get_srv()
+					, pd.get_user()
+					, pd.get_pwd()
 					, b);
 			}
 			else if (boost::algorithm::equals(p.first, "smf-gw-wmbus-power")) {
 				const auto val = cyng::value_cast<std::uint8_t>(p.second, 0u);
-				sml_gen.set_proc_parameter_wmbus_power(queue_.front().get_srv()
-					, queue_.front().get_user()
-					, queue_.front().get_pwd()
+				sml_gen.set_proc_parameter_wmbus_power(pd.get_srv()
+					, pd.get_user()
+					, pd.get_pwd()
 					, val);
 			}
 			else if (boost::algorithm::equals(p.first, "smf-gw-wmbus-protocol")) {
 				const auto val = cyng::value_cast<std::uint8_t>(p.second, 0u);
-				sml_gen.set_proc_parameter_wmbus_protocol(queue_.front().get_srv()
-					, queue_.front().get_user()
-					, queue_.front().get_pwd()
+				sml_gen.set_proc_parameter_wmbus_protocol(pd.get_srv()
+					, pd.get_user()
+					, pd.get_pwd()
 					, val);
 			}
 			else if (boost::algorithm::equals(p.first, "smf-gw-wmbus-reboot")) {
 				const auto val = cyng::value_cast<std::uint64_t>(p.second, 0u);
-				sml_gen.set_proc_parameter_wmbus_reboot(queue_.front().get_srv()
-					, queue_.front().get_user()
-					, queue_.front().get_pwd()
+				sml_gen.set_proc_parameter_wmbus_reboot(pd.get_srv()
+					, pd.get_user()
+					, pd.get_pwd()
 					, val);
 			}
 		}
 	}
 
-	void gateway_proxy::execute_cmd_get_list_req_last_data_set(sml::req_generator& sml_gen)
+	void gateway_proxy::execute_cmd_get_list_req_last_data_set(ipt::proxy_data const& pd, sml::req_generator& sml_gen)
 	{
-		auto const params = queue_.front().get_params();
+		auto const params = pd.get_params();
 		//CYNG_LOG_DEBUG(logger_, "task #"
 		//	<< base_.get_id()
 		//	<< " <"
@@ -769,8 +789,8 @@ namespace node
 
 				sml_gen.get_list_last_data_record(get_mac().to_buffer()	
 					, r.first	//	meter
-					, queue_.front().get_user()
-					, queue_.front().get_pwd());
+					, pd.get_user()
+					, pd.get_pwd());
 			}
 			else {
 
@@ -791,23 +811,23 @@ namespace node
 				<< " <"
 				<< base_.get_class_name()
 				<< "> get last data set from "
-				<< sml::from_server_id(queue_.front().get_srv())
+				<< sml::from_server_id(pd.get_srv())
 				<< " has no 'meter-id' parameter");
 
 		}
 	}
 
-	void gateway_proxy::execute_cmd_set_proc_param_activate(sml::req_generator& sml_gen)
+	void gateway_proxy::execute_cmd_set_proc_param_activate(ipt::proxy_data const& pd, sml::req_generator& sml_gen)
 	{
-		auto const params = queue_.front().get_params();
+		auto const params = pd.get_params();
 		auto const pos = params.find("smf-form-gw-srv-visible-meter");
 		if (pos != params.end()) {
 			cyng::buffer_t meter;
 			meter = cyng::value_cast(pos->second, meter);
-			sml_gen.set_proc_parameter_activate(queue_.front().get_srv()
+			sml_gen.set_proc_parameter_activate(pd.get_srv()
 				, meter
-				, queue_.front().get_user()
-				, queue_.front().get_pwd());
+				, pd.get_user()
+				, pd.get_pwd());
 		}
 		else {
 			CYNG_LOG_ERROR(logger_, "task #"
@@ -815,21 +835,21 @@ namespace node
 				<< " <"
 				<< base_.get_class_name()
 				<< "> [deactivate] has no parameters - "
-				<< sml::from_server_id(queue_.front().get_srv()));
+				<< sml::from_server_id(pd.get_srv()));
 		}
 	}
 
-	void gateway_proxy::execute_cmd_set_proc_param_deactivate(sml::req_generator& sml_gen)
+	void gateway_proxy::execute_cmd_set_proc_param_deactivate(ipt::proxy_data const& pd, sml::req_generator& sml_gen)
 	{
-		auto const params = queue_.front().get_params();
+		auto const params = pd.get_params();
 		auto const pos = params.find("smf-form-gw-srv-active-meter");
 		if (pos != params.end()) {
 			cyng::buffer_t meter;
 			meter = cyng::value_cast(pos->second, meter);
-			sml_gen.set_proc_parameter_deactivate(queue_.front().get_srv()
+			sml_gen.set_proc_parameter_deactivate(pd.get_srv()
 				, meter
-				, queue_.front().get_user()
-				, queue_.front().get_pwd());
+				, pd.get_user()
+				, pd.get_pwd());
 		}
 		else {
 			CYNG_LOG_ERROR(logger_, "task #"
@@ -837,31 +857,31 @@ namespace node
 				<< " <"
 				<< base_.get_class_name()
 				<< "> [activate] has no parameters - "
-				<< sml::from_server_id(queue_.front().get_srv()));
+				<< sml::from_server_id(pd.get_srv()));
 		}
 	}
 
-	void gateway_proxy::execute_cmd_set_proc_param_delete(sml::req_generator& sml_gen)
+	void gateway_proxy::execute_cmd_set_proc_param_delete(ipt::proxy_data const& pd, sml::req_generator& sml_gen)
 	{
-		auto const params = queue_.front().get_params();
+		auto const params = pd.get_params();
 		auto const pos = params.find("smf-form-gw-srv-visible-meter");
 		if (pos != params.end()) {
 			cyng::buffer_t meter;
 			meter = cyng::value_cast(pos->second, meter);
-			sml_gen.set_proc_parameter_delete(queue_.front().get_srv()
+			sml_gen.set_proc_parameter_delete(pd.get_srv()
 				, meter
-				, queue_.front().get_user()
-				, queue_.front().get_pwd());
+				, pd.get_user()
+				, pd.get_pwd());
 		}
 		else {
 			auto const pos = params.find("smf-form-gw-srv-active-meter");
 			if (pos != params.end()) {
 				cyng::buffer_t meter;
 				meter = cyng::value_cast(pos->second, meter);
-				sml_gen.set_proc_parameter_delete(queue_.front().get_srv()
+				sml_gen.set_proc_parameter_delete(pd.get_srv()
 					, meter
-					, queue_.front().get_user()
-					, queue_.front().get_pwd());
+					, pd.get_user()
+					, pd.get_pwd());
 			}
 			else {
 				CYNG_LOG_ERROR(logger_, "task #"
@@ -869,11 +889,27 @@ namespace node
 					<< " <"
 					<< base_.get_class_name()
 					<< "> [delete] has no parameters - "
-					<< sml::from_server_id(queue_.front().get_srv()));
+					<< sml::from_server_id(pd.get_srv()));
 			}
 		}
 	}
 
+	ipt::proxy_data const* gateway_proxy::lookup(std::string const& trx) const
+	{
+		auto const pos = trx_.find(trx);
+		if (pos != trx_.end()) {
+			return &active_.at(pos->second);
+		}
+
+		//
+		//	unambiguous
+		//
+		return (active_.size() == 1)
+			? &active_.front()
+			: nullptr
+			;
+	}
+
 	void gateway_proxy::stop()
 	{
 		//
@@ -16,6 +16,7 @@
 #include <cyng/async/mux.h>
 #include <cyng/vm/controller.h>
 #include <queue>
+#include <map>
 #include <boost/predef.h>	//	requires Boost 1.55
 
 namespace node
@@ -23,6 +24,11 @@ namespace node
 	namespace sml {
 		class req_generator;
 	}
+	/**
+	 * Queued requests for the same gateway are packed into one
+	 * SML transaction (public open, n requests, public close).
+	 * Responses are assigned to requests by transaction id.
+	 */
 	class gateway_proxy
 	{
 		using proxy_queue = std::queue< ipt::proxy_data >;
@@ -42,7 +48,7 @@ namespace node
 			cyng::param_map_t	//	params
 		>;
 
-		using msg_6 = std::tuple<std::string, cyng::buffer_t>;
+		using msg_6 = std::tuple<std::string, std::string, cyng::buffer_t>;
 
 		using msg_7 = std::tuple <
 			boost::uuids::uuid,		//	[0] ident tag
@@ -66,7 +72,8 @@ namespace node
 			, bus::shared_type bus
 			, cyng::controller& vm
 			, std::chrono::seconds timeout
-			, bool sml_log);
+			, bool sml_log
+			, std::size_t batch);
 		cyng::continuation run();
 		void stop();
 
@@ -121,7 +128,8 @@ namespace node
 		 *
 		 * attention code
 		 */
-		cyng::continuation process(std::string
+		cyng::continuation process(std::string trx
+			, std::string srv
 			, cyng::buffer_t const&);
 
 		/**
@@ -142,16 +150,26 @@ namespace node
 			std::string	pwd				//	[10] pwd
 		);
 	private:
+		/**
+		 * Move up to batch_ queued requests for the same gateway into
+		 * the active transaction and send them.
+		 */
 		void execute_cmd();
-		void execute_cmd_get_proc_param();
-		void execute_cmd_set_proc_param();
-		void execute_cmd_get_list_request();
-		void execute_cmd_set_proc_param_ipt(sml::req_generator& sml_gen);
-		void execute_cmd_set_proc_param_wmbus(sml::req_generator& sml_gen);
-		void execute_cmd_get_list_req_last_data_set(sml::req_generator& sml_gen);
-		void execute_cmd_set_proc_param_activate(sml::req_generator& sml_gen);
-		void execute_cmd_set_proc_param_deactivate(sml::req_generator& sml_gen);
-		void execute_cmd_set_proc_param_delete(sml::req_generator& sml_gen);
+		void execute_cmd(ipt::proxy_data const&, sml::req_generator& sml_gen);
+		void execute_cmd_get_proc_param(ipt::proxy_data const&, sml::req_generator& sml_gen);
+		void execute_cmd_set_proc_param(ipt::proxy_data const&, sml::req_generator& sml_gen);
+		void execute_cmd_get_list_request(ipt::proxy_data const&, sml::req_generator& sml_gen);
+		void execute_cmd_set_proc_param_ipt(ipt::proxy_data const&, sml::req_generator& sml_gen);
+		void execute_cmd_set_proc_param_wmbus(ipt::proxy_data const&, sml::req_generator& sml_gen);
+		void execute_cmd_get_list_req_last_data_set(ipt::proxy_data const&, sml::req_generator& sml_gen);
+		void execute_cmd_set_proc_param_activate(ipt::proxy_data const&, sml::req_generator& sml_gen);
+		void execute_cmd_set_proc_param_deactivate(ipt::proxy_data const&, sml::req_generator& sml_gen);
+		void execute_cmd_set_proc_param_delete(ipt::proxy_data const&, sml::req_generator& sml_gen);
+
+		/**
+		 * @return request of the active transaction with the specified trx
+		 */
+		ipt::proxy_data const* lookup(std::string const& trx) const;
 
 		cyng::mac48 get_mac() const;
 
@@ -163,7 +181,23 @@ namespace node
 		const std::chrono::seconds timeout_;
 		const std::chrono::system_clock::time_point start_;
 		sml::parser parser_;
+
+		/**
+		 * max. number of requests in one transaction
+		 */
+		std::size_t const batch_;
+
+		/**
+		 * requests waiting for the next transaction
+		 */
 		proxy_queue queue_;
+
+		/**
+		 * requests of the current transaction and
+		 * the index of the request for each trx
+		 */
+		std::vector<ipt::proxy_data> active_;
+		std::map<std::string, std::size_t> trx_;
 	};
 
 
@@ -5,12 +5,18 @@ set (node_ipt_store_cpp
 
 	nodes/ipt/store/src/main.cpp
 	nodes/ipt/store/src/controller.cpp
+	nodes/ipt/store/src/spill_queue.cpp
+	nodes/ipt/store/src/reimport.cpp
+	nodes/ipt/store/src/raw_file_name.cpp
 )
 
 set (node_ipt_store_h
 
 	nodes/ipt/store/src/controller.h
 	nodes/ipt/store/src/message_ids.h
+	nodes/ipt/store/src/spill_queue.h
+	nodes/ipt/store/src/reimport.h
+	nodes/ipt/store/src/raw_file_name.h
 
 )
 
@@ -53,6 +59,8 @@ set (node_ipt_store_tasks
 	nodes/ipt/store/src/tasks/sml_to_log_consumer.cpp
 	nodes/ipt/store/src/tasks/sml_to_csv_consumer.h
 	nodes/ipt/store/src/tasks/sml_to_csv_consumer.cpp
+	nodes/ipt/store/src/tasks/sml_to_archive_consumer.h
+	nodes/ipt/store/src/tasks/sml_to_archive_consumer.cpp
 	nodes/ipt/store/src/tasks/binary_consumer.h
 	nodes/ipt/store/src/tasks/binary_consumer.cpp
 	nodes/ipt/store/src/tasks/iec_to_db_consumer.h
@@ -77,6 +85,12 @@ set (node_ipt_store_exporter
 	lib/sml/exporter/src/db_iec_exporter.cpp
 	src/main/include/smf/sml/exporter/abl_sml_exporter.h
 	lib/sml/exporter/src/abl_sml_exporter.cpp
+	src/main/include/smf/sml/exporter/output_files.h
+	lib/sml/exporter/src/output_files.cpp
+	src/main/include/smf/sml/exporter/archive_format.h
+	lib/sml/exporter/src/archive_format.cpp
+	src/main/include/smf/sml/exporter/archive_sml_exporter.h
+	lib/sml/exporter/src/archive_sml_exporter.cpp
 
 )
 	
@@ -14,8 +14,10 @@
 #include "tasks/sml_to_json_consumer.h"
 #include "tasks/sml_to_log_consumer.h"
 #include "tasks/sml_to_csv_consumer.h"
+#include "tasks/sml_to_archive_consumer.h"
 #include "tasks/iec_to_db_consumer.h"
 #include "tasks/network.h"
+#include "reimport.h"
 #include <cyng/log.h>
 #include <cyng/async/mux.h>
 #include <cyng/async/task/task_builder.hpp>
@@ -42,6 +44,7 @@
 #include <boost/uuid/random_generator.hpp>
 #include <boost/filesystem.hpp>
 #include <fstream>
+#include <thread>
 
 namespace node 
 {
@@ -216,7 +219,12 @@ namespace node
 					cyng::param_factory("watchdog", 30),	//	for database connection
 					cyng::param_factory("pool-size", 1),	//	no pooling for SQLite
 					cyng::param_factory("db-schema", NODE_SUFFIX),		//	use "v4.0" for compatibility to version 4.x
-					cyng::param_factory("period", rng())	//	seconds
+					cyng::param_factory("period", rng()),	//	seconds
+					cyng::param_factory("queue-size", 4096),	//	messages in memory
+					cyng::param_factory("spill-dir", (pwd / "spill").string()),
+					cyng::param_factory("spill-segment-size", 4 * 1024 * 1024),	//	bytes
+					cyng::param_factory("spill-limit", 256 * 1024 * 1024),	//	bytes - throttle input if exceeded
+					cyng::param_factory("max-retries", 0)	//	move message to dead letter file after this number of failed writes (0 = never)
 				))
 				, cyng::param_factory("IEC:DB", cyng::tuple_factory(
 					cyng::param_factory("type", "SQLite"),
@@ -226,12 +234,20 @@ namespace node
 					cyng::param_factory("pool-size", 1),	//	no pooling for SQLite
 					cyng::param_factory("db-schema", NODE_SUFFIX),
 					cyng::param_factory("period", rng()),	//	seconds
-					cyng::param_factory("ignore-null", false)	//	don't write values equal 0
+					cyng::param_factory("ignore-null", false),	//	don't write values equal 0
+					cyng::param_factory("queue-size", 4096),	//	messages in memory
+					cyng::param_factory("spill-dir", (pwd / "spill").string()),
+					cyng::param_factory("spill-segment-size", 4 * 1024 * 1024),	//	bytes
+					cyng::param_factory("spill-limit", 256 * 1024 * 1024),	//	bytes - throttle input if exceeded
+					cyng::param_factory("max-retries", 0)	//	move message to dead letter file after this number of failed writes (0 = never)
 				))
 				, cyng::param_factory("SML:XML", cyng::tuple_factory(
 					cyng::param_factory("root-dir", (pwd / "xml").string()),
 					cyng::param_factory("root-name", "SML"),
 					cyng::param_factory("endcoding", "UTF-8"),
+					cyng::param_factory("max-open-files", 64),
+					cyng::param_factory("write-buffer", 128 * 1024),	//	bytes per open file
+					cyng::param_factory("sync-interval", 60),	//	seconds (0 = off)
 					cyng::param_factory("period", rng())	//	seconds
 				))
 				, cyng::param_factory("SML:JSON", cyng::tuple_factory(
@@ -246,6 +262,9 @@ namespace node
 					cyng::param_factory("prefix", "smf"),
 					cyng::param_factory("suffix", "abl"),
 					cyng::param_factory("version", NODE_SUFFIX),
+					cyng::param_factory("max-open-files", 64),
+					cyng::param_factory("write-buffer", 128 * 1024),	//	bytes per open file
+					cyng::param_factory("sync-interval", 60),	//	seconds (0 = off)
 					cyng::param_factory("period", rng()),	//	seconds
 					cyng::param_factory("line-ending", "DOS")	//	DOS/UNIX
 				))
@@ -275,9 +294,23 @@ namespace node
 					cyng::param_factory("prefix", "smf"),
 					cyng::param_factory("suffix", "csv"),
 					cyng::param_factory("header", true),
+					cyng::param_factory("max-open-files", 64),
+					cyng::param_factory("write-buffer", 128 * 1024),	//	bytes per open file
+					cyng::param_factory("sync-interval", 60),	//	seconds (0 = off)
 					cyng::param_factory("version", NODE_SUFFIX),
 					cyng::param_factory("period", rng())	//	seconds
 				))
+				, cyng::param_factory("SML:ARCHIVE", cyng::tuple_factory(
+					cyng::param_factory("root-dir", (pwd / "archive").string()),
+					cyng::param_factory("prefix", "smf"),
+					cyng::param_factory("suffix", "sma"),
+					cyng::param_factory("chunk-size", 4096),	//	records
+					cyng::param_factory("max-age", 900),	//	seconds until a chunk is written
+					cyng::param_factory("max-open-files", 64),
+					cyng::param_factory("write-buffer", 128 * 1024),	//	bytes per open file
+					cyng::param_factory("sync-interval", 60),	//	seconds (0 = off)
+					cyng::param_factory("period", rng())	//	seconds
+				))
 				, cyng::param_factory("ipt", cyng::vector_factory({
 					cyng::tuple_factory(
 						cyng::param_factory("host", "127.0.0.1"),
@@ -339,6 +372,46 @@ namespace node
 		return EXIT_FAILURE;
 	}
 
+	int controller::import_raw_data()
+	{
+		//
+		//	read configuration file
+		//
+		cyng::object config = cyng::json::read_file(json_path_);
+
+		cyng::vector_t vec;
+		vec = cyng::value_cast(config, vec);
+		BOOST_ASSERT_MSG(!vec.empty(), "invalid configuration");
+
+		if (!vec.empty())
+		{
+			//
+			//	the VMs of the decoders run on this pool
+			//
+			cyng::async::mux mux{ this->pool_size_ };
+			auto logger = cyng::logging::make_console_logger(mux.get_io_service(), "ipt:store");
+
+			auto dom = cyng::make_reader(vec[0]);
+			const boost::filesystem::path pwd = boost::filesystem::current_path();
+			cyng::tuple_t tpl;
+
+			reimport ri(logger
+				, mux.get_io_service()
+				, cyng::value_cast(dom["ALL:BIN"].get("root-dir"), (pwd / "sml").string())
+				, cyng::value_cast<std::string>(dom["ALL:BIN"].get("prefix"), "sml")
+				, cyng::value_cast<std::string>(dom["ALL:BIN"].get("suffix"), "sml")
+				, cyng::to_param_map(cyng::value_cast(dom.get("SML:DB"), tpl))
+				, cyng::to_param_map(cyng::value_cast(dom.get("IEC:DB"), tpl))
+				, std::thread::hardware_concurrency());
+
+			auto const rc = ri.run();
+
+			mux.shutdown();
+			return rc;
+		}
+		return EXIT_FAILURE;
+	}
+
 #if BOOST_OS_WINDOWS
 	int controller::run_as_service(controller&& ctrl, std::string const& srv_name)
 	{
@@ -554,6 +627,9 @@ namespace node
 				auto root_name = cyng::value_cast<std::string>(dom[config_type].get("root-name"), "SML");
 				auto encoding = cyng::value_cast<std::string>(dom[config_type].get("endcoding"), "UTF-8");
 				auto period = cyng::value_cast(dom[config_type].get("period"), 16);	//	seconds
+				auto max_open_files = cyng::value_cast(dom[config_type].get("max-open-files"), 64);
+				auto write_buffer = cyng::value_cast(dom[config_type].get("write-buffer"), 128 * 1024);	//	bytes
+				auto sync_interval = cyng::value_cast(dom[config_type].get("sync-interval"), 60);	//	seconds
 
 				tsks.push_back(cyng::async::start_task_delayed<sml_xml_consumer>(mux
 					, std::chrono::seconds(1)
@@ -562,7 +638,10 @@ namespace node
 					, root_dir
 					, root_name
 					, encoding
-					, std::chrono::seconds(period)).first);
+					, std::chrono::seconds(period)
+					, static_cast<std::size_t>(max_open_files)
+					, static_cast<std::size_t>(write_buffer)
+					, std::chrono::seconds(sync_interval)).first);
 			}
 			else if (boost::algorithm::iequals(config_type, "SML:JSON"))
 			{
@@ -595,7 +674,10 @@ namespace node
 				auto r = cyng::parse_ver(version);
 				auto period = cyng::value_cast(dom[config_type].get("period"), 16);	//	seconds
 				auto eol = cyng::value_cast<std::string>(dom[config_type].get("line-ending"), "DOS");
-				
+				auto max_open_files = cyng::value_cast(dom[config_type].get("max-open-files"), 64);
+				auto write_buffer = cyng::value_cast(dom[config_type].get("write-buffer"), 128 * 1024);	//	bytes
+				auto sync_interval = cyng::value_cast(dom[config_type].get("sync-interval"), 60);	//	seconds
+
 
 				tsks.push_back(cyng::async::start_task_delayed<sml_abl_consumer>(mux
 					, std::chrono::seconds(1)
@@ -606,7 +688,10 @@ namespace node
 					, suffix
 					, std::chrono::seconds(period)
 					, boost::algorithm::equals(eol, "DOS")
-					, r.second ? r.first : cyng::make_object<cyng::version>(NODE_VERSION_MAJOR, NODE_VERSION_MINOR)).first);
+					, r.second ? r.first : cyng::make_object<cyng::version>(NODE_VERSION_MAJOR, NODE_VERSION_MINOR)
+					, static_cast<std::size_t>(max_open_files)
+					, static_cast<std::size_t>(write_buffer)
+					, std::chrono::seconds(sync_interval)).first);
 			}
 			else if (boost::algorithm::iequals(config_type, "ALL:BIN"))
 			{
@@ -648,6 +733,9 @@ namespace node
 				auto suffix = cyng::value_cast<std::string>(dom[config_type].get("suffix"), "csv");
 				auto header = cyng::value_cast(dom[config_type].get("header"), true);
 				auto period = cyng::value_cast(dom[config_type].get("period"), 16);	//	seconds
+				auto max_open_files = cyng::value_cast(dom[config_type].get("max-open-files"), 64);
+				auto write_buffer = cyng::value_cast(dom[config_type].get("write-buffer"), 128 * 1024);	//	bytes
+				auto sync_interval = cyng::value_cast(dom[config_type].get("sync-interval"), 60);	//	seconds
 
 				tsks.push_back(cyng::async::start_task_delayed<sml_csv_consumer>(mux
 					, std::chrono::seconds(1)
@@ -657,7 +745,38 @@ namespace node
 					, prefix
 					, suffix
 					, header
-					, std::chrono::seconds(period)).first);
+					, std::chrono::seconds(period)
+					, static_cast<std::size_t>(max_open_files)
+					, static_cast<std::size_t>(write_buffer)
+					, std::chrono::seconds(sync_interval)).first);
+			}
+			else if (boost::algorithm::iequals(config_type, "SML:ARCHIVE"))
+			{
+				CYNG_LOG_INFO(logger, "start SML:ARCHIVE storage");
+
+				boost::filesystem::path root_dir = cyng::value_cast(dom[config_type].get("root-dir"), (pwd / "archive").string());
+				auto prefix = cyng::value_cast<std::string>(dom[config_type].get("prefix"), "smf");
+				auto suffix = cyng::value_cast<std::string>(dom[config_type].get("suffix"), "sma");
+				auto chunk_size = cyng::value_cast(dom[config_type].get("chunk-size"), 4096);	//	records
+				auto max_age = cyng::value_cast(dom[config_type].get("max-age"), 900);	//	seconds
+				auto period = cyng::value_cast(dom[config_type].get("period"), 16);	//	seconds
+				auto max_open_files = cyng::value_cast(dom[config_type].get("max-open-files"), 64);
+				auto write_buffer = cyng::value_cast(dom[config_type].get("write-buffer"), 128 * 1024);	//	bytes
+				auto sync_interval = cyng::value_cast(dom[config_type].get("sync-interval"), 60);	//	seconds
+
+				tsks.push_back(cyng::async::start_task_delayed<sml_archive_consumer>(mux
+					, std::chrono::seconds(1)
+					, logger
+					, ntid
+					, root_dir
+					, prefix
+					, suffix
+					, static_cast<std::size_t>(chunk_size)
+					, std::chrono::seconds(max_age)
+					, std::chrono::seconds(period)
+					, static_cast<std::size_t>(max_open_files)
+					, static_cast<std::size_t>(write_buffer)
+					, std::chrono::seconds(sync_interval)).first);
 			}
 			else
 			{
@@ -49,6 +49,14 @@ namespace node
 		 */
 		int init_db();
 
+		/**
+		 * Read the JSON configuration and import all raw data files
+		 * of the ALL:BIN consumer into the SML:DB and IEC:DB databases.
+		 *
+		 * @return EXIT_FAILURE in case of an error, otherwise EXIT_SUCCESS.
+		 */
+		int import_raw_data();
+
 #if BOOST_OS_WINDOWS
 		/**
 		* run as windows service
@@ -39,6 +39,7 @@ int main(int argc, char **argv)
 		("config,C", boost::program_options::value<std::string>(&config_file)->default_value(node::get_cfg_name("store")), "specify the configuration file")
 		("default,D", boost::program_options::bool_switch()->default_value(false), "generate a default configuration and exit")
 		("init,I", boost::program_options::bool_switch()->default_value(false), "initialize database and exit")
+		("reimport,R", boost::program_options::bool_switch()->default_value(false), "import raw data files (ALL:BIN) into database and exit")
 		("ip,N", boost::program_options::bool_switch()->default_value(false), "show local IP address and exit")
 		("fs,F", boost::program_options::bool_switch()->default_value(false), "show available drives")
 		("show", boost::program_options::bool_switch()->default_value(false), "show configuration")
@@ -157,6 +158,12 @@ int main(int argc, char **argv)
  			return ctrl.init_db();
 		}
 
+		if (vm["reimport"].as< bool >())
+		{
+			//	import raw data files
+ 			return ctrl.import_raw_data();
+		}
+
 		if (vm["show"].as< bool >())
 		{
 			//	show configuration
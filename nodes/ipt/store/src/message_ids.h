@@ -12,6 +12,7 @@ namespace node
 {
 	constexpr std::size_t STORE_EVENT_REGISTER_CONSUMER = 0u;
 	constexpr std::size_t STORE_EVENT_REMOVE_PROCESSOR = 1u;
+	constexpr std::size_t STORE_EVENT_BACKPRESSURE = 2u;
 
 	constexpr std::size_t CONSUMER_CREATE_LINE = 0;
 	constexpr std::size_t CONSUMER_PUSH_DATA = 1;
@@ -0,0 +1,93 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#include "raw_file_name.h"
+#include <boost/algorithm/string/predicate.hpp>
+
+namespace node
+{
+	namespace
+	{
+		/**
+		 * min. number of hex digits of channel and source
+		 */
+		std::size_t const hex_width = 4;
+
+		/**
+		 * @return true if the string is a hex number
+		 */
+		bool parse_hex(std::string const& str, std::uint32_t& value)
+		{
+			if (str.empty() || str.size() > 8)	return false;
+			if (str.find_first_not_of("0123456789abcdefABCDEF") != std::string::npos)	return false;
+			value = static_cast<std::uint32_t>(std::stoul(str, nullptr, 16));
+			return true;
+		}
+
+		/**
+		 * @return true if the string is written with std::setw(4) and '0' as fill
+		 */
+		bool is_padded_hex(std::string const& str)
+		{
+			if (str.size() < hex_width)	return false;
+			if (str.size() > hex_width && str.at(0) == '0')	return false;
+			std::uint32_t value{ 0 };
+			return parse_hex(str, value);
+		}
+	}
+
+	bool parse_raw_file_name(std::string const& name
+		, std::string const& prefix
+		, std::string const& suffix
+		, std::string& protocol
+		, std::string& target
+		, std::uint32_t& channel
+		, std::uint32_t& source)
+	{
+		auto const head = prefix + "--";
+		auto const tail = "." + suffix;
+		if (!boost::algorithm::starts_with(name, head) || !boost::algorithm::ends_with(name, tail))	return false;
+		if (name.size() <= head.size() + tail.size())	return false;
+
+		auto const str = name.substr(head.size(), name.size() - head.size() - tail.size());
+
+		//	protocol
+		auto const p1 = str.find('-');
+		if (p1 == std::string::npos)	return false;
+		protocol = str.substr(0, p1);
+
+		//	skip timestamp
+		auto const p2 = str.find('-', p1 + 1);
+		if (p2 == std::string::npos)	return false;
+
+		//	source
+		auto const p4 = str.rfind('-');
+		if (p4 == std::string::npos || p4 <= p2 + 1)	return false;
+		if (!is_padded_hex(str.substr(p4 + 1)) || !parse_hex(str.substr(p4 + 1), source))	return false;
+
+		//
+		//	The target name may contain '-', so the channel is taken
+		//	from the end.
+		//
+		auto const p3 = str.rfind('-', p4 - 1);
+		if (p3 != std::string::npos && p3 > p2 + 1) {
+			auto const field = str.substr(p3 + 1, p4 - p3 - 1);
+			if (is_padded_hex(field) && parse_hex(field, channel)) {
+				target = str.substr(p2 + 1, p3 - p2 - 1);
+				return true;
+			}
+		}
+
+		//
+		//	legacy layout: <target><channel>
+		//
+		if (p4 < p2 + 2 + hex_width)	return false;
+		if (!parse_hex(str.substr(p4 - hex_width, hex_width), channel))	return false;
+		target = str.substr(p2 + 1, p4 - hex_width - p2 - 1);
+		return true;
+	}
+}
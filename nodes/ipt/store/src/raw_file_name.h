@@ -0,0 +1,40 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#ifndef NODE_IPT_STORE_RAW_FILE_NAME_H
+#define NODE_IPT_STORE_RAW_FILE_NAME_H
+
+#include <cstdint>
+#include <string>
+
+namespace node
+{
+	/**
+	 * Decode the name of a file written by the binary consumer:
+	 * @code
+	 * <prefix>--<protocol>-<YYYYMMTddhhmm>-<target>-<channel>-<source>.<suffix>
+	 * @endcode
+	 * Channel and source are hex numbers with at least 4 digits.
+	 * Files of earlier versions have no '-' between target and channel:
+	 * @code
+	 * <prefix>--<protocol>-<YYYYMMTddhhmm>-<target><channel>-<source>.<suffix>
+	 * @endcode
+	 * In this case the channel is taken from the last 4 hex digits
+	 * in front of the source (channels above 0xFFFF are ambiguous).
+	 *
+	 * @return false if the name doesn't match
+	 */
+	bool parse_raw_file_name(std::string const& name
+		, std::string const& prefix
+		, std::string const& suffix
+		, std::string& protocol
+		, std::string& target
+		, std::uint32_t& channel
+		, std::uint32_t& source);
+}
+
+#endif
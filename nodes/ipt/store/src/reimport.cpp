@@ -0,0 +1,563 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#include "reimport.h"
+#include "raw_file_name.h"
+#include "tasks/sml_to_db_consumer.h"
+#include "tasks/iec_to_db_consumer.h"
+#include <NODE_project_info.h>
+#include <smf/sml/protocol/parser.h>
+#include <smf/sml/exporter/db_sml_exporter.h>
+#include <smf/sml/exporter/db_iec_exporter.h>
+#include <smf/sml/obis_db.h>
+#include <smf/iec/parser.h>
+
+#include <cyng/db/connection_types.h>
+#include <cyng/db/interface_session.h>
+#include <cyng/db/sql_table.h>
+#include <cyng/sql.h>
+#include <cyng/table/meta.hpp>
+#include <cyng/io/io_bytes.hpp>
+#include <cyng/value_cast.hpp>
+#include <cyng/numeric_cast.hpp>
+#include <cyng/tuple_cast.hpp>
+#include <cyng/vm/domain/log_domain.h>
+
+#include <algorithm>
+#include <cctype>
+#include <iomanip>
+#include <thread>
+#include <tuple>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/uuid/random_generator.hpp>
+#include <boost/uuid/nil_generator.hpp>
+
+namespace node
+{
+	namespace
+	{
+		/**
+		 * decoded VM calls
+		 */
+		enum record : std::uint32_t {
+			RECORD_SML_MSG,		//!<	msg, idx
+			RECORD_IEC_START,	//!<	pk
+			RECORD_IEC_LINE,	//!<	pk, obis, value, unit, status, idx
+			RECORD_IEC_BCC,		//!<	pk, bcc
+			RECORD_IEC_EOF,		//!<	pk, size
+		};
+
+		/**
+		 * Imported files - stored in the target database.
+		 */
+		cyng::table::meta_table_ptr make_progress_meta()
+		{
+			return cyng::table::make_meta_table<1, 1>("TReimport", { "name"	//	file name
+				, "size"	//	file size
+				},
+				{ cyng::TC_STRING, cyng::TC_UINT64 },
+				{ 128, 0 });
+		}
+
+		/**
+		 * ROLLBACK fails if the connection is lost. The error
+		 * of the transaction is reported already.
+		 */
+		void rollback(cyng::db::session& s, cyng::logging::log_ptr logger)
+		{
+			try {
+				s.execute("ROLLBACK");
+			}
+			catch (std::exception const& ex) {
+				CYNG_LOG_ERROR(logger, "rollback failed: " << ex.what());
+			}
+		}
+	}
+
+	reimport::reimport(cyng::logging::log_ptr logger
+		, cyng::io_service_t& ios
+		, boost::filesystem::path const& root_dir
+		, std::string const& prefix
+		, std::string const& suffix
+		, cyng::param_map_t sml_cfg
+		, cyng::param_map_t iec_cfg
+		, std::size_t threads)
+	: logger_(logger)
+		, ios_(ios)
+		, root_dir_(root_dir)
+		, prefix_(prefix)
+		, suffix_(suffix)
+		, threads_(std::max<std::size_t>(threads, 1u))
+		, progress_meta_(make_progress_meta())
+		, sml_cfg_(sml_cfg)
+		, iec_cfg_(iec_cfg)
+		, sml_schema_(cyng::value_cast<std::string>(sml_cfg_["db-schema"], NODE_SUFFIX))
+		, iec_schema_(cyng::value_cast<std::string>(iec_cfg_["db-schema"], NODE_SUFFIX))
+		, sml_meta_(sml_db_consumer::init_meta_map(sml_schema_))
+		, iec_meta_(iec_db_consumer::init_meta_map(iec_schema_))
+		, ignore_null_(cyng::value_cast(iec_cfg_["ignore-null"], false))
+		, sml_db_(cyng::db::get_connection_type(cyng::value_cast<std::string>(sml_cfg_["type"], "SQLite")))
+		, iec_db_(cyng::db::get_connection_type(cyng::value_cast<std::string>(iec_cfg_["type"], "SQLite")))
+		, sml_connected_(false)
+		, iec_connected_(false)
+		, lines_()
+		, files_(0)
+		, next_(0)
+		, iec_state_()
+		, mutex_()
+		, cv_ready_()
+		, cv_space_()
+		, ready_()
+		, decoders_(0)
+		, start_(std::chrono::steady_clock::now())
+		, last_report_(start_)
+		, imported_(0)
+		, failed_(0)
+		, bytes_(0)
+	{}
+
+	int reimport::run()
+	{
+		auto files = collect();
+
+		//
+		//	connect only databases that are required
+		//
+		auto const has = [&files](std::string const& protocol) {
+			return std::any_of(files.begin(), files.end(), [&protocol](archive const& f) {
+				return boost::algorithm::equals(f.protocol_, protocol);
+			});
+		};
+		std::set<std::string> done;
+		if (has("SML")) {
+			if (!connect(sml_db_, sml_cfg_, "SML:DB"))	return EXIT_FAILURE;
+			sml_connected_ = true;
+			load_progress(sml_db_, done);
+		}
+		if (has("IEC")) {
+			if (!connect(iec_db_, iec_cfg_, "IEC:DB"))	return EXIT_FAILURE;
+			iec_connected_ = true;
+			load_progress(iec_db_, done);
+		}
+		if (!done.empty()) {
+			CYNG_LOG_INFO(logger_, "skip " << done.size() << " file(s) of previous runs");
+		}
+
+		arrange(std::move(files), done);
+		if (lines_.empty()) {
+			CYNG_LOG_INFO(logger_, "no files to import in " << root_dir_);
+			return EXIT_SUCCESS;
+		}
+
+		std::uintmax_t total{ 0 };
+		for (auto const& line : lines_) {
+			for (auto const& f : line) {
+				total += f.size_;
+			}
+		}
+		CYNG_LOG_INFO(logger_, "import "
+			<< files_
+			<< " file(s) of "
+			<< lines_.size()
+			<< " line(s) with "
+			<< cyng::bytes_to_str(total)
+			<< " from "
+			<< root_dir_);
+
+		//
+		//	start decoders
+		//
+		decoders_ = std::min(threads_, lines_.size());
+		std::vector<std::thread> pool;
+		for (std::size_t idx = 0; idx < decoders_; ++idx) {
+			pool.emplace_back([this]() { decode(); });
+		}
+
+		//
+		//	single writer - SQLite allows only one writer anyway
+		//
+		for (;;) {
+			cyng::async::unique_lock<cyng::async::mutex> lk(mutex_);
+			cv_ready_.wait(lk, [this] {
+				return !ready_.empty() || decoders_ == 0;
+			});
+			if (ready_.empty())	break;
+
+			auto b = std::move(ready_.front());
+			ready_.pop_front();
+			lk.unlock();
+			cv_space_.notify_one();
+
+			bool const success = b.valid_ && (boost::algorithm::equals(b.file_.protocol_, "SML")
+				? write_sml(b)
+				: write_iec(b));
+			if (b.last_) {
+				iec_state_.erase(b.line_);
+			}
+
+			if (success) {
+				++imported_;
+			}
+			else {
+				CYNG_LOG_ERROR(logger_, "import of " << b.file_.path_ << " failed");
+				++failed_;
+			}
+			bytes_ += b.file_.size_;
+			report(false);
+		}
+
+		for (auto& t : pool) {
+			t.join();
+		}
+		report(true);
+
+		return (failed_ == 0)
+			? EXIT_SUCCESS
+			: EXIT_FAILURE;
+	}
+
+	std::vector<reimport::archive> reimport::collect()
+	{
+		std::vector<archive> files;
+
+		boost::system::error_code ec;
+		if (!boost::filesystem::is_directory(root_dir_, ec)) {
+			CYNG_LOG_ERROR(logger_, root_dir_ << " is not a directory");
+			return files;
+		}
+
+		for (auto const& entry : boost::filesystem::directory_iterator(root_dir_, ec)) {
+			if (!boost::filesystem::is_regular_file(entry.status()))	continue;
+
+			auto const name = entry.path().filename().string();
+
+			archive f;
+			if (!parse_raw_file_name(name, prefix_, suffix_, f.protocol_, f.target_, f.channel_, f.source_)) {
+				if (boost::algorithm::starts_with(name, prefix_ + "--")) {
+					CYNG_LOG_WARNING(logger_, "skip " << name << " - invalid file name");
+				}
+				continue;
+			}
+
+			if (!boost::algorithm::equals(f.protocol_, "SML") && !boost::algorithm::equals(f.protocol_, "IEC")) {
+				CYNG_LOG_WARNING(logger_, "skip " << name << " - unknown protocol " << f.protocol_);
+				continue;
+			}
+
+			f.path_ = entry.path();
+			f.size_ = boost::filesystem::file_size(f.path_, ec);
+			if (!ec && f.size_ != 0)	files.push_back(std::move(f));
+		}
+
+		return files;
+	}
+
+	void reimport::arrange(std::vector<archive>&& files, std::set<std::string> const& done)
+	{
+		using line_t = std::tuple<std::string, std::string, std::uint32_t, std::uint32_t>;
+		std::map<line_t, std::vector<archive>> lines;
+		for (auto& f : files) {
+			if (done.count(f.path_.filename().string()) != 0)	continue;
+			lines[line_t(f.protocol_, f.target_, f.channel_, f.source_)].push_back(std::move(f));
+		}
+
+		lines_.clear();
+		files_ = 0;
+		for (auto& line : lines) {
+
+			//
+			//	the file names of a line differ only by the timestamp
+			//
+			std::sort(line.second.begin(), line.second.end(), [](archive const& a, archive const& b) {
+				return a.path_.filename() < b.path_.filename();
+			});
+			files_ += line.second.size();
+			lines_.push_back(std::move(line.second));
+		}
+	}
+
+	void reimport::decode()
+	{
+		batch b{};
+		cyng::controller vm(ios_, boost::uuids::random_generator()());
+
+		auto const append = [&b](std::uint32_t op, cyng::context& ctx) {
+			auto frame = ctx.get_frame();
+			frame.insert(frame.begin(), cyng::make_object(op));
+			b.records_.push_back(std::move(frame));
+		};
+
+		vm.register_function("sml.msg", 2, std::bind(append, RECORD_SML_MSG, std::placeholders::_1));
+		vm.register_function("sml.eom", 2, [](cyng::context&) {});
+		vm.register_function("sml.log", 1, [](cyng::context&) {});
+		vm.register_function("iec.data.start", 1, std::bind(append, RECORD_IEC_START, std::placeholders::_1));
+		vm.register_function("iec.data.line", 5, std::bind(append, RECORD_IEC_LINE, std::placeholders::_1));
+		vm.register_function("iec.data.bcc", 1, std::bind(append, RECORD_IEC_BCC, std::placeholders::_1));
+		vm.register_function("iec.data.eof", 1, std::bind(append, RECORD_IEC_EOF, std::placeholders::_1));
+		cyng::register_logger(logger_, vm);
+
+		//
+		//	vm.run() is synchronous since this thread doesn't belong to the VM
+		//
+		auto const cb = [&vm](cyng::vector_t&& prg) {
+			vm.run(std::move(prg));
+		};
+
+		for (;;) {
+			auto const idx = next_++;
+			if (idx >= lines_.size())	break;
+
+			//
+			//	one parser for all files of a line - a message can
+			//	span two files
+			//
+			auto const& line = lines_.at(idx);
+			sml::parser sml_parser(cb, false, false);
+			iec::parser iec_parser(cb, false);
+
+			for (std::size_t pos = 0; pos < line.size(); ++pos) {
+
+				b.file_ = line.at(pos);
+				b.line_ = idx;
+				b.last_ = (pos + 1 == line.size());
+				b.records_.clear();
+
+				if (boost::algorithm::equals(b.file_.protocol_, "SML")) {
+					b.valid_ = read(b.file_, [&sml_parser](char const* begin, char const* end) {
+						sml_parser.read(begin, end);
+					});
+					if (!b.valid_)	sml_parser.reset();
+				}
+				else {
+					b.valid_ = read(b.file_, [&iec_parser](char const* begin, char const* end) {
+						iec_parser.read(begin, end);
+					});
+					if (!b.valid_)	iec_parser.reset();
+				}
+
+				cyng::async::unique_lock<cyng::async::mutex> lk(mutex_);
+				cv_space_.wait(lk, [this] {
+					return ready_.size() < 2 * threads_;
+				});
+				ready_.push_back(std::move(b));
+				lk.unlock();
+				cv_ready_.notify_one();
+			}
+		}
+
+		vm.halt();
+		vm.wait(12, std::chrono::milliseconds(10));
+
+		{
+			cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+			--decoders_;
+		}
+		cv_ready_.notify_one();
+	}
+
+	bool reimport::read(archive const& f, std::function<void(char const*, char const*)> cb)
+	{
+		try {
+			boost::interprocess::file_mapping fm(f.path_.string().c_str(), boost::interprocess::read_only);
+			boost::interprocess::mapped_region region(fm, boost::interprocess::read_only);
+			region.advise(boost::interprocess::mapped_region::advice_sequential);
+
+			auto const begin = static_cast<char const*>(region.get_address());
+			cb(begin, begin + region.get_size());
+			return true;
+		}
+		catch (std::exception const& ex) {
+			CYNG_LOG_ERROR(logger_, "cannot decode " << f.path_ << ": " << ex.what());
+		}
+		return false;
+	}
+
+	bool reimport::write_sml(batch const& b)
+	{
+		if (!sml_connected_)	return false;
+
+		//
+		//	same argument order as the SML:DB consumer
+		//
+		sml::db_exporter exporter(sml_meta_, sml_schema_, b.file_.channel_, b.file_.source_, b.file_.target_);
+
+		try {
+			sml_db_.execute("BEGIN TRANSACTION");
+			for (auto const& rec : b.records_) {
+				if (cyng::numeric_cast<std::uint32_t>(rec.at(0), 0u) == RECORD_SML_MSG) {
+					cyng::tuple_t msg;
+					msg = cyng::value_cast(rec.at(1), msg);
+					exporter.write(sml_db_, msg, cyng::value_cast<std::size_t>(rec.at(2), 0));
+				}
+			}
+			commit(sml_db_, b.file_);
+			sml_db_.execute("COMMIT");
+			return true;
+		}
+		catch (std::exception const& ex) {
+			CYNG_LOG_ERROR(logger_, "write " << b.file_.path_ << " failed: " << ex.what());
+			rollback(sml_db_, logger_);
+		}
+		return false;
+	}
+
+	bool reimport::write_iec(batch const& b)
+	{
+		if (!iec_connected_)	return false;
+
+		//
+		//	same argument order as the IEC:DB consumer
+		//
+		iec::db_exporter exporter(iec_meta_, iec_schema_, b.file_.channel_, b.file_.source_, b.file_.target_);
+
+		//
+		//	state of the IEC processor - a readout can span two files
+		//
+		auto& state = iec_state_[b.line_];
+
+		try {
+			iec_db_.execute("BEGIN TRANSACTION");
+			for (auto const& rec : b.records_) {
+				switch (cyng::numeric_cast<std::uint32_t>(rec.at(0), 0u)) {
+				case RECORD_IEC_START:
+					state.meter_.clear();
+					state.status_.clear();
+					state.bcc_ = false;
+					break;
+				case RECORD_IEC_LINE:
+				{
+					auto const tpl = cyng::tuple_cast<
+						std::uint32_t,		//	[0] record
+						boost::uuids::uuid,	//	[1] pk
+						cyng::buffer_t,		//	[2] obis
+						std::string,		//	[3] value
+						std::string,		//	[4] unit
+						std::string,		//	[5] status
+						std::size_t			//	[6] counter
+					>(rec);
+
+					auto const code = sml::obis(std::get<2>(tpl));
+					if (code == sml::OBIS_METER_ADDRESS) {
+						state.meter_ = std::get<5>(tpl);
+					}
+					else if (code == sml::OBIS_MBUS_STATE) {
+						state.status_ = std::get<5>(tpl);
+					}
+
+					//
+					//	skip null values like the IEC:DB consumer
+					//
+					if (ignore_null_
+						&& std::get<5>(tpl).empty()
+						&& (std::get<3>(tpl).find_first_not_of("0.", 0) == std::string::npos)) {
+						break;
+					}
+					exporter.write_data(iec_db_, std::get<1>(tpl), std::get<6>(tpl), std::get<2>(tpl), std::get<3>(tpl), std::get<4>(tpl), std::get<5>(tpl));
+				}
+					break;
+				case RECORD_IEC_BCC:
+					state.bcc_ = cyng::value_cast(rec.at(2), false);
+					break;
+				case RECORD_IEC_EOF:
+					exporter.write_meta(iec_db_
+						, cyng::value_cast(rec.at(1), boost::uuids::nil_uuid())
+						, state.meter_
+						, state.status_
+						, state.bcc_
+						, cyng::numeric_cast<std::size_t>(rec.at(2), 0u));
+					break;
+				default:
+					break;
+				}
+			}
+			commit(iec_db_, b.file_);
+			iec_db_.execute("COMMIT");
+			return true;
+		}
+		catch (std::exception const& ex) {
+			CYNG_LOG_ERROR(logger_, "write " << b.file_.path_ << " failed: " << ex.what());
+			rollback(iec_db_, logger_);
+		}
+		return false;
+	}
+
+	bool reimport::connect(cyng::db::session& s, cyng::param_map_t& cfg, std::string const& name)
+	{
+		auto const r = s.connect(cfg);
+		if (!r.second) {
+			CYNG_LOG_FATAL(logger_, "connect to " << name << " database failed");
+			return false;
+		}
+		CYNG_LOG_INFO(logger_, name << " database " << r.first);
+		return true;
+	}
+
+	void reimport::load_progress(cyng::db::session& s, std::set<std::string>& done)
+	{
+		//
+		//	fails if the table exists already
+		//
+		cyng::sql::command cmd(progress_meta_, s.get_dialect());
+		cmd.create();
+		s.execute(cmd.to_str());
+
+		cmd.select().all();
+		auto stmt = s.create_statement();
+		std::pair<int, bool> const r = stmt->prepare(cmd.to_str());
+		if (!r.second) {
+			CYNG_LOG_WARNING(logger_, "cannot read table TReimport");
+			return;
+		}
+		while (auto res = stmt->get_result()) {
+			auto const rec = cyng::to_record(progress_meta_, res);
+			done.insert(cyng::value_cast<std::string>(rec.key().at(0), ""));
+		}
+	}
+
+	void reimport::commit(cyng::db::session& s, archive const& f)
+	{
+		cyng::sql::command cmd(progress_meta_, s.get_dialect());
+		cmd.insert();
+		auto stmt = s.create_statement();
+		std::pair<int, bool> const r = stmt->prepare(cmd.to_str());
+		if (!r.second)	throw std::runtime_error("cannot prepare insert into TReimport");
+
+		stmt->push(cyng::make_object(f.path_.filename().string()), 128)
+			.push(cyng::make_object(static_cast<std::uint64_t>(f.size_)), 0);
+		if (!stmt->execute())	throw std::runtime_error("cannot insert into TReimport");
+		stmt->clear();
+	}
+
+	void reimport::report(bool final)
+	{
+		auto const now = std::chrono::steady_clock::now();
+		if (!final && (now - last_report_) < std::chrono::seconds(5))	return;
+		last_report_ = now;
+
+		auto const ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - start_).count();
+		auto const rate = (ms == 0)
+			? 0.0
+			: (bytes_ * 1000.0) / (ms * 1024.0 * 1024.0);
+
+		CYNG_LOG_INFO(logger_, (final ? "import complete: " : "import: ")
+			<< (imported_ + failed_)
+			<< '/'
+			<< files_
+			<< " file(s), "
+			<< failed_
+			<< " failed, "
+			<< cyng::bytes_to_str(bytes_)
+			<< ", "
+			<< std::fixed
+			<< std::setprecision(1)
+			<< rate
+			<< " MB/s");
+	}
+}
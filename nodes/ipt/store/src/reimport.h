@@ -0,0 +1,183 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#ifndef NODE_IPT_STORE_REIMPORT_H
+#define NODE_IPT_STORE_REIMPORT_H
+
+#include <cyng/log.h>
+#include <cyng/intrinsics/sets.h>
+#include <cyng/compatibility/io_service.h>
+#include <cyng/compatibility/async.h>
+#include <cyng/db/session.h>
+#include <cyng/table/meta_interface.h>
+#include <cyng/vm/controller.h>
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
+#include <set>
+
+#include <boost/filesystem.hpp>
+
+namespace node
+{
+	/**
+	 * Offline import of the raw push data files written by the
+	 * binary consumer (ALL:BIN) into the SML:DB and IEC:DB databases.
+	 *
+	 * Files of the same line (protocol, target, channel and source)
+	 * are decoded in time order by the same parser, since a message
+	 * can span two files. The lines are decoded in parallel, one line
+	 * per thread. Decoded files are written by a single writer, each
+	 * file in one transaction. The name of each imported file is
+	 * stored in the table TReimport of the target database within
+	 * the same transaction. A subsequent run skips these files (resume).
+	 * Delete the rows of TReimport to import all files again.
+	 */
+	class reimport
+	{
+		/**
+		 * raw data file
+		 */
+		struct archive
+		{
+			boost::filesystem::path path_;
+			std::uintmax_t size_;
+			std::string protocol_;	//!<	SML or IEC
+			std::string target_;
+			std::uint32_t channel_;
+			std::uint32_t source_;
+		};
+
+		/**
+		 * decoded file
+		 */
+		struct batch
+		{
+			archive file_;
+			std::size_t line_;	//!<	index in lines_
+			bool last_;	//!<	last file of the line
+			bool valid_;
+			std::vector<cyng::vector_t> records_;
+		};
+
+		/**
+		 * state of the IEC processor of a line
+		 */
+		struct iec_state
+		{
+			std::string meter_;
+			std::string status_;
+			bool bcc_;
+		};
+
+	public:
+		reimport(cyng::logging::log_ptr
+			, cyng::io_service_t&
+			, boost::filesystem::path const& root_dir
+			, std::string const& prefix
+			, std::string const& suffix
+			, cyng::param_map_t sml_cfg	//	SML:DB
+			, cyng::param_map_t iec_cfg	//	IEC:DB
+			, std::size_t threads);
+
+		/**
+		 * Import all files that are not imported yet.
+		 *
+		 * @return EXIT_FAILURE if at least one file couldn't be imported
+		 */
+		int run();
+
+	private:
+		/**
+		 * @return all archive files in the root directory
+		 */
+		std::vector<archive> collect();
+
+		/**
+		 * Group files by line in time order and skip all files
+		 * that are already imported.
+		 */
+		void arrange(std::vector<archive>&&, std::set<std::string> const& done);
+
+		/**
+		 * decoder thread
+		 */
+		void decode();
+
+		/**
+		 * Map the file into memory and feed the parser
+		 */
+		bool read(archive const&, std::function<void(char const*, char const*)>);
+
+		bool write_sml(batch const&);
+		bool write_iec(batch const&);
+
+		bool connect(cyng::db::session&, cyng::param_map_t&, std::string const& name);
+
+		/**
+		 * Create table TReimport if required and read the names
+		 * of all imported files.
+		 */
+		void load_progress(cyng::db::session&, std::set<std::string>&);
+
+		/**
+		 * Insert the file name into TReimport. Part of the
+		 * transaction of the file.
+		 */
+		void commit(cyng::db::session&, archive const&);
+		void report(bool);
+
+	private:
+		cyng::logging::log_ptr logger_;
+		cyng::io_service_t& ios_;
+		boost::filesystem::path const root_dir_;
+		std::string const prefix_;
+		std::string const suffix_;
+		std::size_t const threads_;
+		cyng::table::meta_table_ptr const progress_meta_;
+
+		cyng::param_map_t sml_cfg_, iec_cfg_;
+		std::string const sml_schema_, iec_schema_;
+		cyng::table::mt_table const sml_meta_, iec_meta_;
+		bool const ignore_null_;
+		cyng::db::session sml_db_, iec_db_;
+		bool sml_connected_, iec_connected_;
+
+		/**
+		 * files to import grouped by line
+		 */
+		std::vector<std::vector<archive>> lines_;
+		std::size_t files_;
+		std::atomic<std::size_t> next_;
+
+		/**
+		 * IEC processor state by line (writer only)
+		 */
+		std::map<std::size_t, iec_state> iec_state_;
+
+		/**
+		 * decoded files - bounded to 2 files per thread
+		 */
+		cyng::async::mutex mutex_;
+		cyng::async::condition_variable cv_ready_, cv_space_;
+		std::deque<batch> ready_;
+		std::size_t decoders_;
+
+		/**
+		 * progress
+		 */
+		std::chrono::steady_clock::time_point const start_;
+		std::chrono::steady_clock::time_point last_report_;
+		std::size_t imported_, failed_;
+		std::uintmax_t bytes_;
+	};
+}
+
+#endif
@@ -0,0 +1,557 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#include "spill_queue.h"
+#include <cyng/io/serializer.h>
+#include <cyng/numeric_cast.hpp>
+
+#include <algorithm>
+#include <array>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#include <boost/algorithm/string/predicate.hpp>
+
+namespace node
+{
+	namespace
+	{
+		/**
+		 * Sequence number of the first segment. Segments written at
+		 * shutdown get a lower number than all existing segments.
+		 */
+		std::uint64_t const initial_seq = 1000000000ull;
+
+		std::string const suffix = ".spill";
+
+		/**
+		 * bytes read from a segment at once
+		 */
+		std::size_t const chunk_size = 64 * 1024;
+
+		/**
+		 * max. number of replayed messages in memory
+		 */
+		std::size_t const replay_batch = 256;
+
+		void write_values(std::ostream& os, cyng::vector_t const& vec)
+		{
+			cyng::io::serialize_binary(os, cyng::make_object(static_cast<std::uint32_t>(vec.size())));
+			for (auto const& obj : vec) {
+				cyng::io::serialize_binary(os, obj);
+			}
+		}
+
+		/**
+		 * Read a size prefixed sequence of objects.
+		 *
+		 * @return false if the sequence is incomplete
+		 */
+		bool read_values(cyng::vector_t const& objs, std::size_t& pos, cyng::vector_t& vec)
+		{
+			if (pos >= objs.size())	return false;
+			auto const size = cyng::numeric_cast<std::uint32_t>(objs.at(pos), 0u);
+			if (pos + 1 + size > objs.size())	return false;
+			vec.assign(objs.begin() + pos + 1, objs.begin() + pos + 1 + size);
+			pos += 1 + size;
+			return true;
+		}
+	}
+
+	spill_queue::spill_queue(cyng::logging::log_ptr logger
+		, boost::filesystem::path const& dir
+		, std::string const& name
+		, std::size_t capacity
+		, std::uint64_t segment_size
+		, std::uint64_t max_log_size
+		, std::chrono::seconds retry_delay
+		, std::size_t max_retries)
+	: logger_(logger)
+		, dir_(dir)
+		, name_(name)
+		, capacity_(capacity)
+		, segment_size_(segment_size)
+		, max_log_size_(max_log_size)
+		, retry_delay_(retry_delay)
+		, max_retries_(max_retries)
+		, mutex_()
+		, cv_()
+		, worker_()
+		, stopped_(false)
+		, exec_()
+		, throttle_()
+		, memory_()
+		, replay_()
+		, replay_file_()
+		, replay_size_(0)
+		, reader_()
+		, parser_()
+		, objs_()
+		, segments_()
+		, writer_()
+		, writer_seq_(0)
+		, writer_size_(0)
+		, next_seq_(initial_seq)
+		, metrics_{ 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, false }
+		, attempts_(0)
+	{}
+
+	spill_queue::~spill_queue()
+	{
+		stop();
+	}
+
+	std::size_t spill_queue::load()
+	{
+		cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+
+		boost::system::error_code ec;
+		for (auto pos = boost::filesystem::directory_iterator(dir_, ec); !ec && pos != boost::filesystem::directory_iterator(); pos.increment(ec)) {
+			auto const name = pos->path().filename().string();
+			if (boost::algorithm::starts_with(name, name_ + "-") && boost::algorithm::ends_with(name, suffix)) {
+				try {
+					auto const n = std::stoull(name.substr(name_.size() + 1, name.size() - name_.size() - 1 - suffix.size()));
+					segments_.emplace(n, pos->path());
+					next_seq_ = std::max(next_seq_, n + 1);
+
+					boost::system::error_code ec_size;
+					auto const size = boost::filesystem::file_size(pos->path(), ec_size);
+					if (!ec_size)	metrics_.log_size_ += size;
+				}
+				catch (std::exception const&) {}
+			}
+		}
+
+		if (!segments_.empty()) {
+			CYNG_LOG_INFO(logger_, name_
+				<< " takes over "
+				<< segments_.size()
+				<< " spill segment(s) with "
+				<< metrics_.log_size_
+				<< " bytes");
+		}
+		return segments_.size();
+	}
+
+	void spill_queue::start(exec_f exec, throttle_f throttle)
+	{
+		cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+		BOOST_ASSERT(!worker_.joinable());
+		exec_ = exec;
+		throttle_ = throttle;
+		stopped_ = false;
+		worker_ = std::thread(&spill_queue::run, this);
+	}
+
+	void spill_queue::stop()
+	{
+		{
+			cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+			stopped_ = true;
+		}
+		cv_.notify_all();
+		if (worker_.joinable())	worker_.join();
+
+		cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+		close_writer();
+	}
+
+	std::size_t spill_queue::close(std::vector<cyng::vector_t> const& prologue)
+	{
+		cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+		if (memory_.empty() && replay_.empty())	return 0;
+
+		close_writer();
+
+		//
+		//	the unread rest of the replay segment is pending too
+		//
+		if (reader_.is_open()) {
+			read_segment(std::numeric_limits<std::size_t>::max());
+		}
+
+		//
+		//	pending messages are older than all segments
+		//
+		auto const seq = (segments_.empty())
+			? next_seq_++
+			: segments_.begin()->first - 1
+			;
+		auto const p = get_path(seq);
+
+		boost::system::error_code ec;
+		boost::filesystem::create_directories(dir_, ec);
+
+		bool written = false;
+		std::ofstream ofs(p.string(), std::ios::binary | std::ios::trunc);
+		if (ofs.is_open()) {
+			for (auto const& msg : prologue)	write_values(ofs, msg);
+			for (auto const& msg : replay_)	write_values(ofs, msg);
+			for (auto const& msg : memory_)	write_values(ofs, msg);
+			ofs.close();
+			written = !ofs.fail();
+		}
+
+		if (written) {
+
+			auto const count = replay_.size() + memory_.size();
+			if (!replay_file_.empty() && replay_file_ != p) {
+				remove_segment();
+			}
+			replay_file_.clear();
+			replay_.clear();
+			memory_.clear();
+
+			CYNG_LOG_INFO(logger_, name_
+				<< " saved "
+				<< count
+				<< " pending message(s) in "
+				<< p);
+			return count;
+		}
+
+		CYNG_LOG_ERROR(logger_, name_
+			<< " cannot save "
+			<< (replay_.size() + memory_.size())
+			<< " pending message(s) in "
+			<< p);
+		return 0;
+	}
+
+	spill_queue::result spill_queue::push(cyng::vector_t&& msg)
+	{
+		result r = QUEUED;
+		{
+			cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+			if (segments_.empty() && memory_.size() < capacity_) {
+				memory_.push_back(std::move(msg));
+				metrics_.high_water_ = std::max(metrics_.high_water_, memory_.size());
+			}
+			else if (append(msg)) {
+				++metrics_.spilled_;
+				r = (metrics_.log_size_ > max_log_size_)
+					? FULL
+					: SPILLED
+					;
+			}
+			else {
+
+				//
+				//	Keep the message in any case. Messages are
+				//	processed out of order if there are segments.
+				//
+				memory_.push_back(std::move(msg));
+				metrics_.high_water_ = std::max(metrics_.high_water_, memory_.size());
+				r = FULL;
+			}
+
+			if (r == FULL && !metrics_.throttled_) {
+				metrics_.throttled_ = true;
+				CYNG_LOG_WARNING(logger_, name_
+					<< " spill log is full with "
+					<< metrics_.log_size_
+					<< " bytes - throttle input");
+				if (throttle_)	throttle_(true);
+			}
+		}
+		cv_.notify_one();
+		return r;
+	}
+
+	spill_queue::metrics spill_queue::get_metrics() const
+	{
+		cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+		auto m = metrics_;
+		m.queued_ = memory_.size() + replay_.size();
+		m.segments_ = segments_.size() + (replay_file_.empty() ? 0u : 1u);
+		return m;
+	}
+
+	void spill_queue::run()
+	{
+		cyng::async::unique_lock<cyng::async::mutex> lk(mutex_);
+		while (!stopped_) {
+
+			cyng::vector_t msg;
+			if (!front(msg)) {
+				cv_.wait(lk, [this] {
+					return stopped_ || !memory_.empty() || !segments_.empty();
+				});
+				continue;
+			}
+
+			//
+			//	the database may block for a long time
+			//
+			lk.unlock();
+			auto const success = exec_(msg);
+			lk.lock();
+
+			if (success) {
+				++metrics_.processed_;
+				attempts_ = 0;
+				pop();
+			}
+			else {
+				++metrics_.retries_;
+				if (max_retries_ != 0 && ++attempts_ > max_retries_ && dead_letter(msg)) {
+					CYNG_LOG_ERROR(logger_, name_
+						<< " moves message to dead letter file after "
+						<< max_retries_
+						<< " retries");
+					++metrics_.dead_;
+					attempts_ = 0;
+					pop();
+				}
+				else {
+					cv_.wait_for(lk, retry_delay_, [this] {
+						return stopped_;
+					});
+					continue;
+				}
+			}
+
+			if (metrics_.throttled_ && metrics_.log_size_ < max_log_size_ / 2) {
+				metrics_.throttled_ = false;
+				CYNG_LOG_INFO(logger_, name_
+					<< " spill log is down to "
+					<< metrics_.log_size_
+					<< " bytes - release input");
+				if (throttle_)	throttle_(false);
+			}
+		}
+	}
+
+	bool spill_queue::front(cyng::vector_t& msg)
+	{
+		if (replay_.empty() && memory_.empty()) {
+			load_segment();
+		}
+
+		if (!replay_.empty()) {
+			msg = replay_.front();
+			return true;
+		}
+		if (!memory_.empty()) {
+			msg = memory_.front();
+			return true;
+		}
+		return false;
+	}
+
+	void spill_queue::pop()
+	{
+		if (!replay_.empty()) {
+			replay_.pop_front();
+			if (replay_.empty()) {
+				read_segment(replay_batch);
+				if (replay_.empty()) {
+
+					//
+					//	segment completely processed
+					//
+					remove_segment();
+				}
+			}
+		}
+		else if (!memory_.empty()) {
+			memory_.pop_front();
+		}
+	}
+
+	bool spill_queue::append(cyng::vector_t const& msg)
+	{
+		if (!writer_.is_open()) {
+
+			boost::system::error_code ec;
+			boost::filesystem::create_directories(dir_, ec);
+
+			writer_seq_ = next_seq_++;
+			auto const p = get_path(writer_seq_);
+			writer_.open(p.string(), std::ios::binary | std::ios::trunc);
+			if (!writer_.is_open()) {
+				CYNG_LOG_ERROR(logger_, name_ << " cannot open spill segment " << p);
+				writer_seq_ = 0;
+				return false;
+			}
+			segments_.emplace(writer_seq_, p);
+			writer_size_ = 0;
+		}
+
+		auto const pos = writer_.tellp();
+		write_values(writer_, msg);
+		writer_.flush();
+		if (writer_.fail()) {
+			CYNG_LOG_ERROR(logger_, name_ << " cannot write spill segment #" << writer_seq_);
+			close_writer();
+			return false;
+		}
+
+		auto const size = static_cast<std::uint64_t>(writer_.tellp() - pos);
+		writer_size_ += size;
+		metrics_.log_size_ += size;
+		if (writer_size_ >= segment_size_) {
+			close_writer();
+		}
+		return true;
+	}
+
+	void spill_queue::load_segment()
+	{
+		while (replay_.empty() && !segments_.empty()) {
+
+			auto pos = segments_.begin();
+			if (pos->first == writer_seq_) {
+				close_writer();
+			}
+			auto const p = pos->second;
+			segments_.erase(pos);
+
+			boost::system::error_code ec;
+			replay_size_ = boost::filesystem::file_size(p, ec);
+			if (ec)	replay_size_ = 0;
+
+			reader_.open(p.string(), std::ios::binary);
+			if (!reader_.is_open()) {
+
+				//
+				//	keep the file - it's taken over at the next start
+				//
+				CYNG_LOG_ERROR(logger_, name_ << " cannot open spill segment " << p);
+				reader_.clear();
+				metrics_.log_size_ -= std::min(metrics_.log_size_, replay_size_);
+				continue;
+			}
+
+			replay_file_ = p;
+			objs_.clear();
+			parser_.reset(new cyng::parser([this](cyng::vector_t&& prg) {
+				objs_.insert(objs_.end(), std::make_move_iterator(prg.begin()), std::make_move_iterator(prg.end()));
+			}));
+
+			read_segment(replay_batch);
+			if (replay_.empty()) {
+				remove_segment();
+			}
+		}
+	}
+
+	void spill_queue::read_segment(std::size_t count)
+	{
+		std::array<char, chunk_size> buffer;
+		std::size_t pos = 0;
+		cyng::vector_t msg;
+		while (replay_.size() < count) {
+
+			if (read_values(objs_, pos, msg)) {
+				replay_.push_back(std::move(msg));
+				++metrics_.replayed_;
+				continue;
+			}
+
+			if (!reader_.is_open() || !reader_.good())	break;
+
+			objs_.erase(objs_.begin(), objs_.begin() + pos);
+			pos = 0;
+
+			reader_.read(buffer.data(), buffer.size());
+			auto const size = reader_.gcount();
+			if (size > 0) {
+				try {
+					parser_->read(buffer.data(), buffer.data() + size);
+				}
+				catch (std::exception const& ex) {
+					CYNG_LOG_ERROR(logger_, name_ << " cannot read spill segment " << replay_file_ << ": " << ex.what());
+					reader_.close();
+				}
+			}
+		}
+		objs_.erase(objs_.begin(), objs_.begin() + pos);
+	}
+
+	void spill_queue::remove_segment()
+	{
+		if (!objs_.empty()) {
+			CYNG_LOG_WARNING(logger_, name_ << " spill segment " << replay_file_ << " is truncated");
+		}
+
+		reader_.close();
+		reader_.clear();
+		parser_.reset();
+		objs_.clear();
+
+		boost::system::error_code ec;
+		boost::filesystem::remove(replay_file_, ec);
+		replay_file_.clear();
+		metrics_.log_size_ -= std::min(metrics_.log_size_, replay_size_);
+	}
+
+	bool spill_queue::dead_letter(cyng::vector_t const& msg)
+	{
+		boost::system::error_code ec;
+		boost::filesystem::create_directories(dir_, ec);
+
+		auto const p = dir_ / (name_ + ".dead");
+		std::ofstream ofs(p.string(), std::ios::binary | std::ios::app);
+		if (ofs.is_open()) {
+			write_values(ofs, msg);
+			ofs.close();
+			if (!ofs.fail())	return true;
+		}
+
+		CYNG_LOG_ERROR(logger_, name_ << " cannot write dead letter file " << p);
+		return false;
+	}
+
+	void spill_queue::close_writer()
+	{
+		if (writer_.is_open())	writer_.close();
+		writer_seq_ = 0;
+		writer_size_ = 0;
+	}
+
+	boost::filesystem::path spill_queue::get_path(std::uint64_t seq) const
+	{
+		std::stringstream ss;
+		ss
+			<< name_
+			<< '-'
+			<< std::setw(12)
+			<< std::setfill('0')
+			<< seq
+			<< suffix
+			;
+		return dir_ / ss.str();
+	}
+
+	std::ostream& operator<<(std::ostream& os, spill_queue::metrics const& m)
+	{
+		os
+			<< "queue: "
+			<< m.queued_
+			<< " (max. "
+			<< m.high_water_
+			<< "), spill log: "
+			<< m.segments_
+			<< " segment(s) with "
+			<< m.log_size_
+			<< " bytes, spilled: "
+			<< m.spilled_
+			<< ", replayed: "
+			<< m.replayed_
+			<< ", processed: "
+			<< m.processed_
+			<< ", retries: "
+			<< m.retries_
+			<< ", dead letters: "
+			<< m.dead_
+			;
+		if (m.throttled_)	os << " - throttled";
+		return os;
+	}
+}
@@ -0,0 +1,221 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#ifndef NODE_IPT_STORE_SPILL_QUEUE_H
+#define NODE_IPT_STORE_SPILL_QUEUE_H
+
+#include <cyng/log.h>
+#include <cyng/intrinsics/sets.h>
+#include <cyng/compatibility/async.h>
+#include <cyng/io/parser/parser.h>
+
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <thread>
+
+#include <boost/filesystem.hpp>
+
+namespace node
+{
+	/**
+	 * Bounded message queue between a consumer task and the database.
+	 *
+	 * Messages are kept in memory up to the configured capacity. Then
+	 * they are appended to a log of segment files on local disk. As long
+	 * as the log is not empty all new messages are appended too, so the
+	 * order of the messages is preserved. Segments are replayed one by one
+	 * after the in-memory messages are processed. A segment is read in
+	 * chunks, so only a limited number of its messages is in memory.
+	 * A segment file is removed after all its messages are processed.
+	 *
+	 * A worker thread processes the messages in order, so a stalled
+	 * database never blocks the task that feeds the queue. A message that
+	 * couldn't be processed is retried after a delay. After max retries
+	 * (0 means never) it's moved to the dead letter file "<name>.dead",
+	 * which has the same format as a segment file. No message is lost.
+	 *
+	 * If the log grows beyond its limit the throttle callback is called
+	 * with true. It's called with false after the log size dropped below
+	 * half of the limit.
+	 *
+	 * Segment file: (size obj*)*
+	 */
+	class spill_queue
+	{
+	public:
+		/**
+		 * @return false to process the same message again later
+		 */
+		using exec_f = std::function<bool(cyng::vector_t const&)>;
+		using throttle_f = std::function<void(bool)>;
+
+		enum result {
+			QUEUED,		//!<	kept in memory
+			SPILLED,	//!<	appended to the log
+			FULL,		//!<	appended to the log but the log exceeds its limit
+		};
+
+		struct metrics
+		{
+			std::size_t queued_;		//!<	messages in memory
+			std::size_t high_water_;	//!<	max. messages in memory
+			std::size_t segments_;		//!<	log files
+			std::uint64_t log_size_;	//!<	bytes in log files
+			std::uint64_t spilled_;		//!<	messages appended to the log
+			std::uint64_t replayed_;	//!<	messages read from the log
+			std::uint64_t processed_;	//!<	messages successfully processed
+			std::uint64_t retries_;		//!<	failed attempts
+			std::uint64_t dead_;		//!<	messages moved to the dead letter file after max retries
+			bool throttled_;
+		};
+
+	public:
+		spill_queue(cyng::logging::log_ptr
+			, boost::filesystem::path const& dir
+			, std::string const& name
+			, std::size_t capacity
+			, std::uint64_t segment_size
+			, std::uint64_t max_log_size
+			, std::chrono::seconds retry_delay
+			, std::size_t max_retries);
+
+		~spill_queue();
+
+		/**
+		 * Take over segments of a previous run.
+		 *
+		 * @return number of segments
+		 */
+		std::size_t load();
+
+		/**
+		 * Start worker thread
+		 */
+		void start(exec_f, throttle_f);
+
+		/**
+		 * Stop worker thread. Waits until the current message is processed.
+		 */
+		void stop();
+
+		/**
+		 * Write all messages that are not processed yet to the log. The
+		 * prologue is written in front of them to restore the state of the
+		 * consumer at the next start. Call after stop().
+		 *
+		 * @return number of messages saved
+		 */
+		std::size_t close(std::vector<cyng::vector_t> const& prologue);
+
+		/**
+		 * Add a message. Thread safe.
+		 */
+		result push(cyng::vector_t&&);
+
+		metrics get_metrics() const;
+
+	private:
+		void run();
+
+		/**
+		 * Get the next message. Requires lock.
+		 */
+		bool front(cyng::vector_t&);
+
+		/**
+		 * Remove the next message. Requires lock.
+		 */
+		void pop();
+
+		/**
+		 * Append message to log. Requires lock.
+		 */
+		bool append(cyng::vector_t const&);
+
+		/**
+		 * Open the oldest segment for replay. Requires lock.
+		 */
+		void load_segment();
+
+		/**
+		 * Read the replay segment until the replay buffer contains
+		 * the specified number of messages or the segment is completely
+		 * read. Requires lock.
+		 *
+		 */
+		void read_segment(std::size_t count);
+
+		/**
+		 * Close and remove the replay segment. Requires lock.
+		 */
+		void remove_segment();
+
+		/**
+		 * Append message to the dead letter file. Requires lock.
+		 */
+		bool dead_letter(cyng::vector_t const&);
+
+		void close_writer();
+
+		boost::filesystem::path get_path(std::uint64_t seq) const;
+
+	private:
+		cyng::logging::log_ptr logger_;
+		boost::filesystem::path const dir_;
+		std::string const name_;
+		std::size_t const capacity_;
+		std::uint64_t const segment_size_;
+		std::uint64_t const max_log_size_;
+		std::chrono::seconds const retry_delay_;
+		std::size_t const max_retries_;
+
+		mutable cyng::async::mutex mutex_;
+		cyng::async::condition_variable cv_;
+		std::thread worker_;
+		bool stopped_;
+		exec_f exec_;
+		throttle_f throttle_;
+
+		/**
+		 * messages in memory - older than all segments
+		 */
+		std::deque<cyng::vector_t> memory_;
+
+		/**
+		 * messages of the oldest segment - older than all messages in memory
+		 */
+		std::deque<cyng::vector_t> replay_;
+		boost::filesystem::path replay_file_;
+		std::uint64_t replay_size_;
+		std::ifstream reader_;
+		std::unique_ptr<cyng::parser> parser_;
+		cyng::vector_t objs_;	//!<	decoded objects of an incomplete message
+
+		/**
+		 * segment files by sequence number
+		 */
+		std::map<std::uint64_t, boost::filesystem::path> segments_;
+		std::ofstream writer_;
+		std::uint64_t writer_seq_;
+		std::uint64_t writer_size_;
+		std::uint64_t next_seq_;
+
+		metrics metrics_;
+		std::size_t attempts_;	//!<	failed attempts of the current message
+	};
+
+	/**
+	 * one line summary of the queue metrics
+	 */
+	std::ostream& operator<<(std::ostream&, spill_queue::metrics const&);
+}
+
+#endif
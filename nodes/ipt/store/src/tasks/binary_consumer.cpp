@@ -15,12 +15,18 @@
 #include <cyng/set_cast.h>
 #include <cyng/chrono.h>
 #include <cyng/factory/set_factory.h>
-#include <fstream>
 #include <sstream>
 #include <boost/filesystem.hpp>
 
 namespace node
 {
+	namespace
+	{
+		/**
+		 * write buffer of each open file
+		 */
+		constexpr std::size_t buffer_size = 64 * 1024;
+	}
 
 	binary_consumer::binary_consumer(cyng::async::base_task* btp
 		, cyng::logging::log_ptr logger
@@ -38,6 +44,7 @@ namespace node
 		, period_(period)
 		, task_state_(TASK_STATE_INITIAL)
 		, total_bytes_(0)
+		, files_()
 	{
 		CYNG_LOG_INFO(logger_, "task #"
 			<< base_.get_id()
@@ -63,9 +70,29 @@ namespace node
 			task_state_ = TASK_STATE_REGISTERED;
 			break;
 		default:
-			//CYNG_LOG_INFO(logger_, base_.get_class_name()
-			//	<< " has processed "
-			//	<< cyng::bytes_to_str(total_bytes_));
+		{
+			//
+			//	flush all files and close idle files
+			//
+			auto const now = std::chrono::steady_clock::now();
+			for (auto pos = files_.begin(); pos != files_.end(); ) {
+				if (now - pos->second.last_use_ > period_) {
+					close(pos->second);
+					pos = files_.erase(pos);
+				}
+				else {
+					if (pos->second.stream_)	pos->second.stream_->flush();
+					++pos;
+				}
+			}
+
+			CYNG_LOG_TRACE(logger_, base_.get_class_name()
+				<< " has processed "
+				<< cyng::bytes_to_str(total_bytes_)
+				<< " - "
+				<< files_.size()
+				<< " open file(s)");
+		}
 			break;
 		}
 		base_.suspend(period_);
@@ -74,6 +101,14 @@ namespace node
 
 	void binary_consumer::stop()
 	{
+		//
+		//	flush and close all files
+		//
+		for (auto& file : files_) {
+			close(file.second);
+		}
+		files_.clear();
+
 		CYNG_LOG_INFO(logger_, "task #"
 			<< base_.get_id()
 			<< " <"
@@ -119,6 +154,7 @@ namespace node
 			<< cyng::chrono::minute(time)
 			<< '-'
 			<< target
+			<< '-'
 			<< std::hex
 			<< std::setw(4)
 			<< channel
@@ -129,10 +165,17 @@ namespace node
 			<< suffix_
 			;
 
-		boost::filesystem::path file = boost::filesystem::path(root_dir_) / ss.str();
+		auto const file = (boost::filesystem::path(root_dir_) / ss.str()).string();
+
+		//
+		//	reopen only if the file name changed
+		//
+		auto& out = files_[std::make_pair(channel, source)];
+		if (!out.stream_ || !out.stream_->is_open() || out.file_ != file) {
+			open(out, file);
+		}
 
-		std::ofstream of(file.string(), std::ios::out | std::ios::binary | std::ios::app);
-		if (of.is_open())
+		if (out.stream_->is_open())
 		{
 			CYNG_LOG_TRACE(logger_, "task #"
 				<< base_.get_id()
@@ -143,7 +186,8 @@ namespace node
 				<< " bytes to "
 				<< file);
 
-			of.write(data.data(), data.size());
+			out.stream_->write(data.data(), data.size());
+			out.last_use_ = std::chrono::steady_clock::now();
 			total_bytes_ += data.size();
 		}
 		else
@@ -157,13 +201,35 @@ namespace node
 
 		}
 
-		CYNG_LOG_INFO(logger_, base_.get_class_name()
-			<< " has processed "
-			<< cyng::bytes_to_str(total_bytes_));
-
 		return cyng::continuation::TASK_CONTINUE;
 	}
 
+	void binary_consumer::open(output& out, std::string const& file)
+	{
+		//
+		//	close previous file before the buffer is reused
+		//
+		close(out);
+		out.buffer_.resize(buffer_size);
+		out.file_ = file;
+		out.last_use_ = std::chrono::steady_clock::now();
+
+		//
+		//	the buffer must be set before the file is opened
+		//
+		out.stream_.reset(new std::ofstream());
+		out.stream_->rdbuf()->pubsetbuf(out.buffer_.data(), out.buffer_.size());
+		out.stream_->open(file, std::ios::out | std::ios::binary | std::ios::app);
+	}
+
+	void binary_consumer::close(output& out)
+	{
+		if (out.stream_) {
+			out.stream_->close();
+			out.stream_.reset();
+		}
+	}
+
 	void binary_consumer::register_consumer()
 	{
 		base_.mux_.post(ntid_, STORE_EVENT_REGISTER_CONSUMER, cyng::tuple_factory("ALL:RAW", base_.get_id()));
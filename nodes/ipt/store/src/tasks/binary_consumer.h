@@ -12,6 +12,9 @@
 #include <cyng/async/mux.h>
 #include <cyng/async/policy.h>
 #include <cyng/intrinsics/buffer.h>
+#include <fstream>
+#include <map>
+#include <memory>
 
 namespace node
 {
@@ -46,6 +49,24 @@ namespace node
 	private:
 		void register_consumer();
 
+		/**
+		 * output file of a line. The buffer is used by the stream and
+		 * must be declared (and therefore destroyed) before the stream.
+		 */
+		struct output
+		{
+			std::string file_;
+			std::vector<char> buffer_;
+			std::unique_ptr<std::ofstream> stream_;
+			std::chrono::steady_clock::time_point last_use_;
+		};
+		void open(output&, std::string const& file);
+
+		/**
+		 * flush and close the file while the buffer is still valid
+		 */
+		void close(output&);
+
 	private:
 		cyng::async::base_task& base_;
 		cyng::logging::log_ptr logger_;
@@ -59,6 +80,12 @@ namespace node
 			TASK_STATE_REGISTERED,
 		} task_state_;
 		std::size_t total_bytes_;
+
+		/**
+		 * Open files by channel and source. A file is kept open until
+		 * the file name changes or the line is idle for one period.
+		 */
+		std::map<std::pair<std::uint32_t, std::uint32_t>, output> files_;
 	};
 }
 
@@ -20,6 +20,7 @@
 #include <cyng/db/interface_session.h>
 #include <cyng/db/sql_table.h>
 #include <cyng/value_cast.hpp>
+#include <cyng/numeric_cast.hpp>
 #include <cyng/set_cast.h>
 #include <cyng/sql.h>
 #include <cyng/table/meta.hpp>
@@ -47,6 +48,15 @@ namespace node
 		, meta_map_(init_meta_map(schema_))
 		, task_state_(TASK_STATE_INITIAL)
 		, lines_()
+		, targets_()
+		, queue_(logger
+			, cyng::value_cast<std::string>(cfg["spill-dir"], (boost::filesystem::current_path() / "spill").string())
+			, "iec-db"
+			, cyng::numeric_cast<std::size_t>(cfg["queue-size"], 4096u)
+			, cyng::numeric_cast<std::uint64_t>(cfg["spill-segment-size"], 4u * 1024u * 1024u)
+			, cyng::numeric_cast<std::uint64_t>(cfg["spill-limit"], 256u * 1024u * 1024u)
+			, period_
+			, cyng::numeric_cast<std::size_t>(cfg["max-retries"], 0u))
 	{
 		CYNG_LOG_INFO(logger_, "initialize task #"
 			<< base_.get_id()
@@ -84,6 +94,13 @@ namespace node
 				CYNG_LOG_FATAL(logger_, "DB connection pool is empty");
 				return cyng::continuation::TASK_STOP;
 			}
+
+			//
+			//	replay messages of last run first
+			//
+			queue_.load();
+			queue_.start(std::bind(&iec_db_consumer::execute, this, std::placeholders::_1)
+				, std::bind(&iec_db_consumer::throttle, this, std::placeholders::_1));
 			task_state_ = TASK_STATE_DB_OK;
 			break;
 
@@ -97,10 +114,12 @@ namespace node
 			break;
 
 		default:
-			//CYNG_LOG_TRACE(logger_, base_.get_class_name()
-			//	<< " processed "
-			//	<< msg_counter_
-			//	<< " messages");
+			CYNG_LOG_TRACE(logger_, "task #"
+				<< base_.get_id()
+				<< " <"
+				<< base_.get_class_name()
+				<< "> "
+				<< queue_.get_metrics());
 			break;
 		}
 
@@ -110,10 +129,21 @@ namespace node
 
 	void iec_db_consumer::stop()
 	{
+		//
+		//	save pending messages and the lines they refer to
+		//
+		queue_.stop();
+		std::vector<cyng::vector_t> prologue;
+		for (auto const& target : targets_) {
+			prologue.push_back(cyng::vector_t{ cyng::make_object(CONSUMER_CREATE_LINE), cyng::make_object(target.first), cyng::make_object(target.second) });
+		}
+		queue_.close(prologue);
+
 		//
 		//	remove all open lines
 		//
 		lines_.clear();
+		targets_.clear();
 
 		CYNG_LOG_INFO(logger_, "task #"
 			<< base_.get_id()
@@ -124,6 +154,61 @@ namespace node
 
 	cyng::continuation iec_db_consumer::process(std::uint64_t line
 		, std::string target)
+	{
+		queue_.push(cyng::vector_t{ cyng::make_object(CONSUMER_CREATE_LINE), cyng::make_object(line), cyng::make_object(target) });
+		return cyng::continuation::TASK_CONTINUE;
+	}
+
+	cyng::continuation iec_db_consumer::process(std::uint64_t line
+		, boost::uuids::uuid pk
+		, cyng::buffer_t const& code
+		, std::size_t idx	//	message index
+		, cyng::param_map_t params
+	)
+	{
+		queue_.push(cyng::vector_t{ cyng::make_object(CONSUMER_PUSH_DATA), cyng::make_object(line), cyng::make_object(pk), cyng::make_object(code), cyng::make_object(idx), cyng::make_object(params) });
+		return cyng::continuation::TASK_CONTINUE;
+	}
+
+	cyng::continuation iec_db_consumer::process(std::uint64_t line
+		, boost::uuids::uuid pk
+		, std::string meter
+		, std::string status
+		, bool bcc
+		, std::size_t size)
+	{
+		queue_.push(cyng::vector_t{ cyng::make_object(CONSUMER_REMOVE_LINE), cyng::make_object(line), cyng::make_object(pk), cyng::make_object(meter), cyng::make_object(status), cyng::make_object(bcc), cyng::make_object(size) });
+		return cyng::continuation::TASK_CONTINUE;
+	}
+
+	bool iec_db_consumer::execute(cyng::vector_t const& msg)
+	{
+		switch (cyng::numeric_cast<std::size_t>(msg.at(0), CONSUMER_EOM)) {
+		case CONSUMER_CREATE_LINE:
+			create_line(cyng::numeric_cast<std::uint64_t>(msg.at(1), 0u)
+				, cyng::value_cast<std::string>(msg.at(2), ""));
+			break;
+		case CONSUMER_PUSH_DATA:
+			return write_data(cyng::numeric_cast<std::uint64_t>(msg.at(1), 0u)
+				, cyng::value_cast(msg.at(2), boost::uuids::nil_uuid())
+				, cyng::value_cast(msg.at(3), cyng::buffer_t())
+				, cyng::numeric_cast<std::size_t>(msg.at(4), 0u)
+				, cyng::value_cast(msg.at(5), cyng::param_map_t()));
+		case CONSUMER_REMOVE_LINE:
+			return write_meta(cyng::numeric_cast<std::uint64_t>(msg.at(1), 0u)
+				, cyng::value_cast(msg.at(2), boost::uuids::nil_uuid())
+				, cyng::value_cast<std::string>(msg.at(3), "")
+				, cyng::value_cast<std::string>(msg.at(4), "")
+				, cyng::value_cast(msg.at(5), false)
+				, cyng::numeric_cast<std::size_t>(msg.at(6), 0u));
+		default:
+			break;
+		}
+		return true;
+	}
+
+	void iec_db_consumer::create_line(std::uint64_t line
+		, std::string const& target)
 	{
 		CYNG_LOG_INFO(logger_, "task #"
 			<< base_.get_id()
@@ -141,6 +226,7 @@ namespace node
 				, (std::uint32_t)((line & 0xFFFFFFFF00000000LL) >> 32)
 				, (std::uint32_t)(line & 0xFFFFFFFFLL)
 				, target));
+		targets_.emplace(line, target);
 
 		CYNG_LOG_TRACE(logger_, "task #"
 			<< base_.get_id()
@@ -149,16 +235,13 @@ namespace node
 			<< "> has "
 			<< lines_.size()
 			<< " active lines");
-
-		return cyng::continuation::TASK_CONTINUE;
 	}
 
-	cyng::continuation iec_db_consumer::process(std::uint64_t line
+	bool iec_db_consumer::write_data(std::uint64_t line
 		, boost::uuids::uuid pk
 		, cyng::buffer_t const& code
 		, std::size_t idx	//	message index
-		, cyng::param_map_t params
-	)
+		, cyng::param_map_t const& params)
 	{
 		CYNG_LOG_TRACE(logger_, "task #"
 			<< base_.get_id()
@@ -221,6 +304,19 @@ namespace node
 					}
 				}
 			}
+			catch (std::out_of_range const& ex) {
+
+				CYNG_LOG_ERROR(logger_, "task #"
+					<< base_.get_id()
+					<< " <"
+					<< base_.get_class_name()
+					<< "> line "
+					<< line
+					<< " incomplete data #"
+					<< idx
+					<< ": "
+					<< ex.what());
+			}
 			catch (std::exception const& ex) {
 
 				CYNG_LOG_ERROR(logger_, "task #"
@@ -231,6 +327,12 @@ namespace node
 					<< line
 					<< " error: "
 					<< ex.what());
+
+				//
+				//	try again later
+				//
+				--total_count_;
+				return false;
 			}
 		}
 		else {
@@ -244,13 +346,13 @@ namespace node
 				<< " not found");
 		}
 
-		return cyng::continuation::TASK_CONTINUE;
+		return true;
 	}
 
-	cyng::continuation iec_db_consumer::process(std::uint64_t line
+	bool iec_db_consumer::write_meta(std::uint64_t line
 		, boost::uuids::uuid pk
-		, std::string meter
-		, std::string status
+		, std::string const& meter
+		, std::string const& status
 		, bool bcc
 		, std::size_t size)
 	{
@@ -264,10 +366,23 @@ namespace node
 		auto pos = lines_.find(line);
 		if (pos != lines_.end()) {
 
-			//
-			//	write IEC meta data to DB
-			//
-			if (!pos->second.write_meta(pool_.get_session(), pk, meter, status, bcc, size)) {
+			try {
+				//
+				//	write IEC meta data to DB
+				//
+				if (!pos->second.write_meta(pool_.get_session(), pk, meter, status, bcc, size)) {
+
+					CYNG_LOG_ERROR(logger_, "task #"
+						<< base_.get_id()
+						<< " <"
+						<< base_.get_class_name()
+						<< "> line "
+						<< line
+						<< " db meta write error: "
+						<< meter);
+				}
+			}
+			catch (std::exception const& ex) {
 
 				CYNG_LOG_ERROR(logger_, "task #"
 					<< base_.get_id()
@@ -275,14 +390,20 @@ namespace node
 					<< base_.get_class_name()
 					<< "> line "
 					<< line
-					<< " db meta write error: "
-					<< meter);
+					<< " error: "
+					<< ex.what());
+
+				//
+				//	try again later
+				//
+				return false;
 			}
 
 			//
 			//	remove this line
 			//
 			lines_.erase(pos);
+			targets_.erase(line);
 		}
 		else {
 
@@ -303,7 +424,12 @@ namespace node
 			<< lines_.size()
 			<< " active lines");
 
-		return cyng::continuation::TASK_CONTINUE;
+		return true;
+	}
+
+	void iec_db_consumer::throttle(bool on)
+	{
+		base_.mux_.post(ntid_, STORE_EVENT_BACKPRESSURE, cyng::tuple_factory(base_.get_id(), on));
 	}
 
 	int iec_db_consumer::init_db(cyng::tuple_t tpl)
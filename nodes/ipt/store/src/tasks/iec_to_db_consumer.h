@@ -8,6 +8,7 @@
 #ifndef NODE_IPT_STORE_TASK_IEC_DB_CONSUMER_H
 #define NODE_IPT_STORE_TASK_IEC_DB_CONSUMER_H
 
+#include "../spill_queue.h"
 #include <smf/sml/exporter/db_iec_exporter.h>
 #include <cyng/log.h>
 #include <cyng/async/mux.h>
@@ -19,6 +20,11 @@
 
 namespace node
 {
+	/**
+	 * All messages are queued and written to the database by the
+	 * worker thread of the spill queue. Open lines are accessed by
+	 * this thread only.
+	 */
 	class iec_db_consumer
 	{
 	public:
@@ -75,6 +81,31 @@ namespace node
 	private:
 		void register_consumer();
 
+		/**
+		 * Called from worker thread of the spill queue.
+		 *
+		 * @return false if message should be processed again
+		 */
+		bool execute(cyng::vector_t const&);
+
+		void create_line(std::uint64_t line, std::string const& target);
+		bool write_data(std::uint64_t line
+			, boost::uuids::uuid
+			, cyng::buffer_t const&
+			, std::size_t
+			, cyng::param_map_t const&);
+		bool write_meta(std::uint64_t line
+			, boost::uuids::uuid
+			, std::string const& meter
+			, std::string const& status
+			, bool bcc
+			, std::size_t);
+
+		/**
+		 * ask network task to stop/continue reading
+		 */
+		void throttle(bool);
+
 	private:
 		cyng::async::base_task& base_;
 		cyng::logging::log_ptr logger_;
@@ -91,6 +122,8 @@ namespace node
 			TASK_STATE_REGISTERED,
 		} task_state_;
 		std::unordered_map<std::uint64_t, iec::db_exporter>	lines_;
+		std::unordered_map<std::uint64_t, std::string>	targets_;
+		spill_queue	queue_;
 	};
 }
 
@@ -38,6 +38,7 @@ namespace node
 			, config_(cfg)
 			, targets_(targets)
 			, channel_protocol_map_()
+			, throttled_()
 			, sml_lines_()
 			, iec_lines_()
 			, uidgen_()
@@ -326,6 +327,34 @@ namespace node
 			return cyng::continuation::TASK_CONTINUE;
 		}
 
+		//	slot [2] - consumer backpressure
+		cyng::continuation network::process(std::size_t tid, bool on)
+		{
+			if (on) {
+				throttled_.insert(tid);
+			}
+			else {
+				throttled_.erase(tid);
+			}
+
+			CYNG_LOG_WARNING(logger_, "consumer task #"
+				<< tid
+				<< (on ? " is overloaded" : " is ready")
+				<< " - "
+				<< throttled_.size()
+				<< " overloaded consumer(s)");
+
+			//
+			//	pause/resume reading from master
+			//
+			bus::throttle(!throttled_.empty());
+
+			//
+			//	continue task
+			//
+			return cyng::continuation::TASK_CONTINUE;
+		}
+
 		void network::distribute(std::uint32_t channel
 			, std::uint32_t source
 			, std::string const& protocol
@@ -530,9 +559,14 @@ namespace node
 		void network::reconfigure_impl()
 		{
 			//
-			//	switch to other master
+			//	sharded cluster: reconnect to the IP-T node of
+			//	the redirect - otherwise switch to other master
 			//
-			if (config_.next())
+			if (config_.redirect(get_redirect()))
+			{
+				CYNG_LOG_INFO(logger_, "redirected to " << config_.get_address());
+			}
+			else if (config_.next())
 			{
 				CYNG_LOG_INFO(logger_, "switch to redundancy ["
 					<< config_.master_
@@ -16,6 +16,7 @@
 #include <cyng/async/mux.h>
 #include <cyng/async/policy.h>
 #include <boost/uuid/random_generator.hpp>
+#include <set>
 
 namespace node
 {
@@ -31,7 +32,10 @@ namespace node
 			//	[1] remove data consumer
 			using msg_1 = std::tuple<std::string, std::uint64_t, boost::uuids::uuid>;
 
-			using signatures_t = std::tuple<msg_0, msg_1>;
+			//	[2] consumer backpressure
+			using msg_2 = std::tuple<std::size_t, bool>;
+
+			using signatures_t = std::tuple<msg_0, msg_1, msg_2>;
 
 		public:
 			network(cyng::async::base_task* bt
@@ -168,6 +172,14 @@ namespace node
 			 */
 			cyng::continuation process(std::string, std::uint64_t line, boost::uuids::uuid);
 
+			/**
+			 * @brief slot [2] - spill log of a consumer is full/drained (STORE_EVENT_BACKPRESSURE)
+			 *
+			 * Stop reading from the master as long as at least one consumer
+			 * cannot take more data. TCP flow control delays the gateways.
+			 */
+			cyng::continuation process(std::size_t tid, bool);
+
 		private:
 			void reconfigure(cyng::context& ctx);
 			void reconfigure_impl();
@@ -255,6 +267,11 @@ namespace node
 			 */
 			std::multimap<std::string, std::size_t>	consumers_;
 
+			/**
+			 * consumers that cannot take more data
+			 */
+			std::set<std::size_t>	throttled_;
+
 			/**
 			 * line => parser relation.
 			 * Each line has it's own parser instance.
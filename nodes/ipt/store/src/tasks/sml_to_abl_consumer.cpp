@@ -30,7 +30,10 @@ namespace node
 		, std::string suffix
 		, std::chrono::seconds period
 		, bool eol
-		, cyng::object obj)
+		, cyng::object obj
+		, std::size_t max_open_files
+		, std::size_t write_buffer
+		, std::chrono::seconds sync_interval)
 	: base_(*btp)
 		, logger_(logger)
 		, ntid_(ntid)
@@ -41,6 +44,7 @@ namespace node
 		, eol_(eol)
 		, version_(cyng::value_cast(obj, cyng::version(NODE_VERSION_MAJOR, NODE_VERSION_MINOR)))
 		, task_state_(TASK_STATE_INITIAL)
+		, files_(max_open_files, write_buffer, period, sync_interval)
 		, lines_()
 	{
 		CYNG_LOG_INFO(logger_, "initialize task #"
@@ -76,6 +80,7 @@ namespace node
 			break;
 
 		default:
+			files_.flush();
 			break;
 		}
 
@@ -86,6 +91,12 @@ namespace node
 
 	void sml_abl_consumer::stop()
 	{
+		//
+		//	remove all open lines and close all files
+		//
+		lines_.clear();
+		files_.clear();
+
 		CYNG_LOG_INFO(logger_, "task #"
 			<< base_.get_id()
 			<< " <"
@@ -110,7 +121,8 @@ namespace node
 
 		lines_.emplace(std::piecewise_construct,
 			std::forward_as_tuple(line),
-			std::forward_as_tuple(root_dir_
+			std::forward_as_tuple(files_
+				, root_dir_
 				, prefix_
 				, suffix_
 				, eol_
@@ -36,7 +36,10 @@ namespace node
 			, std::string suffix
 			, std::chrono::seconds 
 			, bool eol
-			, cyng::object);
+			, cyng::object
+			, std::size_t max_open_files
+			, std::size_t write_buffer
+			, std::chrono::seconds sync_interval);
 		cyng::continuation run();
 		void stop();
 
@@ -89,6 +92,11 @@ namespace node
 			TASK_STATE_INITIAL,
 			TASK_STATE_REGISTERED,
 		} task_state_;
+
+		/**
+		 * open output files of all lines
+		 */
+		sml::output_files files_;
 		std::unordered_map<std::uint64_t, sml::abl_exporter>	lines_;
 	};
 }
@@ -0,0 +1,179 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#include "sml_to_archive_consumer.h"
+#include "../message_ids.h"
+#include <smf/sml/defs.h>
+#include <cyng/async/task/base_task.h>
+#include <cyng/factory/set_factory.h>
+#include <algorithm>
+
+namespace node
+{
+	sml_archive_consumer::sml_archive_consumer(cyng::async::base_task* btp
+		, cyng::logging::log_ptr logger
+		, std::size_t ntid	//	network task id
+		, boost::filesystem::path root_dir
+		, std::string prefix
+		, std::string suffix
+		, std::size_t chunk_size
+		, std::chrono::seconds max_age
+		, std::chrono::seconds period
+		, std::size_t max_open_files
+		, std::size_t write_buffer
+		, std::chrono::seconds sync_interval)
+	: base_(*btp)
+		, logger_(logger)
+		, ntid_(ntid)
+		, root_dir_(root_dir)
+		, max_age_(max_age)
+		, period_(period)
+		, task_state_(TASK_STATE_INITIAL)
+		, files_(max_open_files, write_buffer, std::max(period, max_age), sync_interval)
+		, exporter_(files_, root_dir, prefix, suffix, chunk_size)
+	{
+		CYNG_LOG_INFO(logger_, "task #"
+			<< base_.get_id()
+			<< " <"
+			<< base_.get_class_name()
+			<< "> initialized");
+	}
+
+	cyng::continuation sml_archive_consumer::run()
+	{
+		switch (task_state_) {
+		case TASK_STATE_INITIAL:
+			if (!boost::filesystem::exists(root_dir_)) {
+
+				CYNG_LOG_FATAL(logger_, "task #"
+					<< base_.get_id()
+					<< " <"
+					<< base_.get_class_name()
+					<< "> out path "
+					<< root_dir_
+					<< " does not exists");
+
+				return cyng::continuation::TASK_STOP;
+			}
+
+			//
+			//	register as SML:ARCHIVE consumer 
+			//
+			register_consumer();
+			task_state_ = TASK_STATE_REGISTERED;
+			break;
+		default:
+			//
+			//	write chunks older than max age
+			//
+			exporter_.flush(max_age_);
+			files_.flush();
+
+			CYNG_LOG_TRACE(logger_, "task #"
+				<< base_.get_id()
+				<< " <"
+				<< base_.get_class_name()
+				<< "> has "
+				<< exporter_.size()
+				<< " pending records in "
+				<< files_.size()
+				<< " open files");
+			break;
+		}
+
+		base_.suspend(period_);
+		return cyng::continuation::TASK_CONTINUE;
+	}
+
+	void sml_archive_consumer::stop()
+	{
+		//
+		//	write all pending chunks and close all files
+		//
+		exporter_.flush();
+		files_.clear();
+
+		CYNG_LOG_INFO(logger_, "task #"
+			<< base_.get_id()
+			<< " <"
+			<< base_.get_class_name()
+			<< " stopped");
+	}
+
+	cyng::continuation sml_archive_consumer::process(std::uint64_t line
+		, std::string target)
+	{
+		CYNG_LOG_INFO(logger_, "task #"
+			<< base_.get_id()
+			<< " <"
+			<< base_.get_class_name()
+			<< " create line "
+			<< line
+			<< ':'
+			<< target);
+
+		return cyng::continuation::TASK_CONTINUE;
+	}
+
+	cyng::continuation sml_archive_consumer::process(std::uint64_t line
+		, std::uint16_t code
+		, std::size_t idx
+		, cyng::tuple_t msg)
+	{
+		CYNG_LOG_DEBUG(logger_, "task #"
+			<< base_.get_id()
+			<< " <"
+			<< base_.get_class_name()
+			<< " line "
+			<< line
+			<< " received #"
+			<< idx
+			<< ':'
+			<< sml::messages::name(code));
+
+		try {
+			exporter_.read(msg, idx);
+		}
+		catch (std::exception const& ex) {
+
+			CYNG_LOG_ERROR(logger_, "task #"
+				<< base_.get_id()
+				<< " <"
+				<< base_.get_class_name()
+				<< " line "
+				<< line
+				<< " error: "
+				<< ex.what());
+		}
+
+		return cyng::continuation::TASK_CONTINUE;
+	}
+
+	cyng::continuation sml_archive_consumer::process(std::uint64_t line)
+	{
+		CYNG_LOG_INFO(logger_, "task #"
+			<< base_.get_id()
+			<< " <"
+			<< base_.get_class_name()
+			<< " close line "
+			<< line);
+
+		return cyng::continuation::TASK_CONTINUE;
+	}
+
+	//	EOM
+	cyng::continuation sml_archive_consumer::process(std::uint64_t line, std::size_t idx, std::uint16_t crc)
+	{
+		return cyng::continuation::TASK_CONTINUE;
+	}
+
+	void sml_archive_consumer::register_consumer()
+	{
+		base_.mux_.post(ntid_, STORE_EVENT_REGISTER_CONSUMER, cyng::tuple_factory("SML:ARCHIVE", base_.get_id()));
+	}
+
+}
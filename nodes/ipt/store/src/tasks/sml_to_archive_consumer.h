@@ -0,0 +1,108 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#ifndef NODE_IPT_STORE_TASK_SML_ARCHIVE_CONSUMER_H
+#define NODE_IPT_STORE_TASK_SML_ARCHIVE_CONSUMER_H
+
+#include <smf/sml/exporter/archive_sml_exporter.h>
+#include <smf/sml/exporter/output_files.h>
+#include <cyng/log.h>
+#include <cyng/async/mux.h>
+#include <cyng/async/policy.h>
+#include <cyng/intrinsics/buffer.h>
+
+namespace node
+{
+	/**
+	 * Write the readings of all lines into a columnar archive
+	 * (one file per profile and day).
+	 */
+	class sml_archive_consumer
+	{
+	public:
+		using msg_0 = std::tuple<std::uint64_t, std::string>;
+		using msg_1 = std::tuple<std::uint64_t, std::uint16_t, std::size_t, cyng::tuple_t>;
+		using msg_2 = std::tuple<std::uint64_t>;
+		using msg_3 = std::tuple<std::uint64_t, std::size_t, std::uint16_t>;
+		using signatures_t = std::tuple<msg_0, msg_1, msg_2, msg_3>;
+
+	public:
+		sml_archive_consumer(cyng::async::base_task* bt
+			, cyng::logging::log_ptr
+			, std::size_t ntid	//	network task id
+			, boost::filesystem::path root_dir
+			, std::string prefix
+			, std::string suffix
+			, std::size_t chunk_size
+			, std::chrono::seconds max_age
+			, std::chrono::seconds period
+			, std::size_t max_open_files
+			, std::size_t write_buffer
+			, std::chrono::seconds sync_interval);
+		cyng::continuation run();
+		void stop();
+
+		/**
+		 * @brief slot [0] - CONSUMER_CREATE_LINE
+		 *
+		 * create a new line
+		 */
+		cyng::continuation process(std::uint64_t line, std::string);
+
+		/**
+		 * @brief slot [1] - CONSUMER_PUSH_DATA
+		 *
+		 * receive push data
+		 */
+		cyng::continuation process(std::uint64_t line
+			, std::uint16_t code
+			, std::size_t idx
+			, cyng::tuple_t msg);
+
+		/**
+		 * @brief slot [2] - CONSUMER_REMOVE_LINE
+		 *
+		 * close line
+		 */
+		cyng::continuation process(std::uint64_t line);
+
+		/**
+		 * @brief slot [3] - CONSUMER_EOM
+		 *
+		 * received End Of Message
+		 */
+		cyng::continuation process(std::uint64_t line, std::size_t idx, std::uint16_t crc);
+
+	private:
+		void register_consumer();
+
+	private:
+		cyng::async::base_task& base_;
+		cyng::logging::log_ptr logger_;
+		const std::size_t ntid_;
+		const boost::filesystem::path root_dir_;
+		const std::chrono::seconds max_age_;
+		const std::chrono::seconds period_;
+		enum task_state {
+			TASK_STATE_INITIAL,
+			TASK_STATE_REGISTERED,
+		} task_state_;
+
+		/**
+		 * open archive files
+		 */
+		sml::output_files files_;
+
+		/**
+		 * The archive files are independent from the lines.
+		 * All lines share the same exporter.
+		 */
+		sml::archive_exporter exporter_;
+	};
+}
+
+#endif
@@ -27,7 +27,10 @@ namespace node
 		, std::string prefix
 		, std::string suffix
 		, bool header
-		, std::chrono::seconds period)
+		, std::chrono::seconds period
+		, std::size_t max_open_files
+		, std::size_t write_buffer
+		, std::chrono::seconds sync_interval)
 	: base_(*btp)
 		, logger_(logger)
 		, ntid_(ntid)
@@ -37,6 +40,8 @@ namespace node
 		, header_(header)
 		, period_(period)
 		, task_state_(TASK_STATE_INITIAL)
+		, files_(max_open_files, write_buffer, period, sync_interval)
+		, lines_()
 	{
 		CYNG_LOG_INFO(logger_, "initialize task #"
 			<< base_.get_id()
@@ -74,6 +79,7 @@ namespace node
 			//	<< " processed "
 			//	<< msg_counter_
 			//	<< " messages");
+			files_.flush();
 			break;
 		}
 
@@ -83,6 +89,12 @@ namespace node
 
 	void sml_csv_consumer::stop()
 	{
+		//
+		//	remove all open lines and close all files
+		//
+		lines_.clear();
+		files_.clear();
+
 		CYNG_LOG_INFO(logger_, "task #"
 			<< base_.get_id()
 			<< " <"
@@ -106,7 +118,8 @@ namespace node
 
 			lines_.emplace(std::piecewise_construct,
 				std::forward_as_tuple(line),
-				std::forward_as_tuple(root_dir_
+				std::forward_as_tuple(files_
+					, root_dir_
 					, prefix_
 					, suffix_
 					, header_
@@ -34,7 +34,10 @@ namespace node
 			, std::string prefix
 			, std::string suffix
 			, bool header
-			, std::chrono::seconds period);
+			, std::chrono::seconds period
+			, std::size_t max_open_files
+			, std::size_t write_buffer
+			, std::chrono::seconds sync_interval);
 		cyng::continuation run();
 		void stop();
 
@@ -91,6 +94,11 @@ namespace node
 			TASK_STATE_INITIAL,
 			TASK_STATE_REGISTERED,
 		} task_state_;
+
+		/**
+		 * open output files of all lines
+		 */
+		sml::output_files files_;
 		std::unordered_map<std::uint64_t, sml::csv_exporter>	lines_;
 	};
 }
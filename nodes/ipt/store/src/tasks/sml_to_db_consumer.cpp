@@ -20,6 +20,7 @@
 #include <cyng/db/interface_session.h>
 #include <cyng/db/sql_table.h>
 #include <cyng/value_cast.hpp>
+#include <cyng/numeric_cast.hpp>
 #include <cyng/set_cast.h>
 #include <cyng/sql.h>
 #include <cyng/table/meta.hpp>
@@ -44,6 +45,15 @@ namespace node
 		, meta_map_(init_meta_map(schema_))
 		, task_state_(TASK_STATE_INITIAL)
 		, lines_()
+		, targets_()
+		, queue_(logger
+			, cyng::value_cast<std::string>(cfg["spill-dir"], (boost::filesystem::current_path() / "spill").string())
+			, "sml-db"
+			, cyng::numeric_cast<std::size_t>(cfg["queue-size"], 4096u)
+			, cyng::numeric_cast<std::uint64_t>(cfg["spill-segment-size"], 4u * 1024u * 1024u)
+			, cyng::numeric_cast<std::uint64_t>(cfg["spill-limit"], 256u * 1024u * 1024u)
+			, period_
+			, cyng::numeric_cast<std::size_t>(cfg["max-retries"], 0u))
 	{
 		CYNG_LOG_INFO(logger_, "initialize task #"
 			<< base_.get_id()
@@ -86,6 +96,13 @@ namespace node
 				CYNG_LOG_FATAL(logger_, "DB connection pool is empty");
 				return cyng::continuation::TASK_STOP;
 			}
+
+			//
+			//	replay messages of last run first
+			//
+			queue_.load();
+			queue_.start(std::bind(&sml_db_consumer::execute, this, std::placeholders::_1)
+				, std::bind(&sml_db_consumer::throttle, this, std::placeholders::_1));
 			task_state_ = TASK_STATE_DB_OK;
 			break;
 
@@ -99,10 +116,12 @@ namespace node
 			break;
 
 		default:
-			//CYNG_LOG_TRACE(logger_, base_.get_class_name()
-			//	<< " processed "
-			//	<< msg_counter_
-			//	<< " messages");
+			CYNG_LOG_TRACE(logger_, "task #"
+				<< base_.get_id()
+				<< " <"
+				<< base_.get_class_name()
+				<< "> "
+				<< queue_.get_metrics());
 			break;
 		}
 
@@ -112,10 +131,21 @@ namespace node
 
 	void sml_db_consumer::stop()
 	{
+		//
+		//	save pending messages and the lines they refer to
+		//
+		queue_.stop();
+		std::vector<cyng::vector_t> prologue;
+		for (auto const& target : targets_) {
+			prologue.push_back(cyng::vector_t{ cyng::make_object(CONSUMER_CREATE_LINE), cyng::make_object(target.first), cyng::make_object(target.second) });
+		}
+		queue_.close(prologue);
+
 		//
 		//	remove all open lines
 		//
 		lines_.clear();
+		targets_.clear();
 
 		CYNG_LOG_INFO(logger_, "task #"
 			<< base_.get_id()
@@ -126,6 +156,56 @@ namespace node
 
 	cyng::continuation sml_db_consumer::process(std::uint64_t line
 		, std::string target)
+	{
+		queue_.push(cyng::vector_t{ cyng::make_object(CONSUMER_CREATE_LINE), cyng::make_object(line), cyng::make_object(target) });
+		return cyng::continuation::TASK_CONTINUE;
+	}
+
+	cyng::continuation sml_db_consumer::process(std::uint64_t line
+		, std::uint16_t code
+		, std::size_t idx
+		, cyng::tuple_t msg)
+	{
+		queue_.push(cyng::vector_t{ cyng::make_object(CONSUMER_PUSH_DATA), cyng::make_object(line), cyng::make_object(code), cyng::make_object(idx), cyng::make_object(msg) });
+		return cyng::continuation::TASK_CONTINUE;
+	}
+
+	//	slot [2] - CONSUMER_REMOVE_LINE
+	cyng::continuation sml_db_consumer::process(std::uint64_t line)
+	{
+		queue_.push(cyng::vector_t{ cyng::make_object(CONSUMER_REMOVE_LINE), cyng::make_object(line) });
+		return cyng::continuation::TASK_CONTINUE;
+	}
+
+	//	EOM
+	cyng::continuation sml_db_consumer::process(std::uint64_t line, std::size_t idx, std::uint16_t crc)
+	{
+		return cyng::continuation::TASK_CONTINUE;
+	}
+
+	bool sml_db_consumer::execute(cyng::vector_t const& msg)
+	{
+		switch (cyng::numeric_cast<std::size_t>(msg.at(0), CONSUMER_EOM)) {
+		case CONSUMER_CREATE_LINE:
+			create_line(cyng::numeric_cast<std::uint64_t>(msg.at(1), 0u)
+				, cyng::value_cast<std::string>(msg.at(2), ""));
+			break;
+		case CONSUMER_PUSH_DATA:
+			return write(cyng::numeric_cast<std::uint64_t>(msg.at(1), 0u)
+				, cyng::numeric_cast<std::uint16_t>(msg.at(2), 0u)
+				, cyng::numeric_cast<std::size_t>(msg.at(3), 0u)
+				, cyng::value_cast(msg.at(4), cyng::tuple_t()));
+		case CONSUMER_REMOVE_LINE:
+			remove_line(cyng::numeric_cast<std::uint64_t>(msg.at(1), 0u));
+			break;
+		default:
+			break;
+		}
+		return true;
+	}
+
+	void sml_db_consumer::create_line(std::uint64_t line
+		, std::string const& target)
 	{
 		CYNG_LOG_INFO(logger_, "task #"
 			<< base_.get_id()
@@ -143,6 +223,7 @@ namespace node
 				, (std::uint32_t)((line & 0xFFFFFFFF00000000LL) >> 32)
 				, (std::uint32_t)(line & 0xFFFFFFFFLL)
 				, target));
+		targets_.emplace(line, target);
 
 		CYNG_LOG_TRACE(logger_, "task #"
 			<< base_.get_id()
@@ -151,14 +232,12 @@ namespace node
 			<< "> has "
 			<< lines_.size()
 			<< " active lines");
-
-		return cyng::continuation::TASK_CONTINUE;
 	}
 
-	cyng::continuation sml_db_consumer::process(std::uint64_t line
+	bool sml_db_consumer::write(std::uint64_t line
 		, std::uint16_t code
 		, std::size_t idx
-		, cyng::tuple_t msg)
+		, cyng::tuple_t const& msg)
 	{
 		CYNG_LOG_TRACE(logger_, "task #"
 			<< base_.get_id()
@@ -174,11 +253,19 @@ namespace node
 		auto pos = lines_.find(line);
 		if (pos != lines_.end()) {
 
+			//
+			//	A message can produce several rows. Write them in one
+			//	transaction, so a retry doesn't duplicate rows.
+			//
+			auto s = pool_.get_session();
 			try {
+				s.execute("BEGIN TRANSACTION");
+
 				//
 				//	write to DB
 				//
-				pos->second.write(pool_.get_session(), msg, idx);
+				pos->second.write(s, msg, idx);
+				s.execute("COMMIT");
 			}
 			catch (std::exception const& ex) {
 
@@ -190,6 +277,16 @@ namespace node
 					<< line
 					<< " error: "
 					<< ex.what());
+
+				try {
+					s.execute("ROLLBACK");
+				}
+				catch (std::exception const&) {}
+
+				//
+				//	try again later
+				//
+				return false;
 			}
 		}
 		else {
@@ -203,11 +300,10 @@ namespace node
 				<< " not found");
 		}
 
-		return cyng::continuation::TASK_CONTINUE;
+		return true;
 	}
 
-	//	slot [2] - CONSUMER_REMOVE_LINE
-	cyng::continuation sml_db_consumer::process(std::uint64_t line)
+	void sml_db_consumer::remove_line(std::uint64_t line)
 	{
 		CYNG_LOG_INFO(logger_, "task #"
 			<< base_.get_id()
@@ -223,6 +319,7 @@ namespace node
 			//	remove this line
 			//
 			lines_.erase(pos);
+			targets_.erase(line);
 		}
 		else {
 
@@ -242,14 +339,11 @@ namespace node
 			<< "> has "
 			<< lines_.size()
 			<< " active lines");
-
-		return cyng::continuation::TASK_CONTINUE;
 	}
 
-	//	EOM
-	cyng::continuation sml_db_consumer::process(std::uint64_t line, std::size_t idx, std::uint16_t crc)
+	void sml_db_consumer::throttle(bool on)
 	{
-		return cyng::continuation::TASK_CONTINUE;
+		base_.mux_.post(ntid_, STORE_EVENT_BACKPRESSURE, cyng::tuple_factory(base_.get_id(), on));
 	}
 
 	int sml_db_consumer::init_db(cyng::tuple_t tpl)
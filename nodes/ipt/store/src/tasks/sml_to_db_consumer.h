@@ -8,6 +8,7 @@
 #ifndef NODE_IPT_STORE_TASK_SML_DB_CONSUMER_H
 #define NODE_IPT_STORE_TASK_SML_DB_CONSUMER_H
 
+#include "../spill_queue.h"
 #include <smf/sml/exporter/db_sml_exporter.h>
 #include <cyng/log.h>
 #include <cyng/async/mux.h>
@@ -19,6 +20,11 @@
 
 namespace node
 {
+	/**
+	 * All messages except EOM are queued and written to the database
+	 * by the worker thread of the spill queue. Open lines are accessed
+	 * by this thread only.
+	 */
 	class sml_db_consumer
 	{
 	public:
@@ -76,6 +82,22 @@ namespace node
 	private:
 		void register_consumer();
 
+		/**
+		 * Called from worker thread of the spill queue.
+		 *
+		 * @return false if message should be processed again
+		 */
+		bool execute(cyng::vector_t const&);
+
+		void create_line(std::uint64_t line, std::string const& target);
+		bool write(std::uint64_t line, std::uint16_t code, std::size_t idx, cyng::tuple_t const& msg);
+		void remove_line(std::uint64_t line);
+
+		/**
+		 * ask network task to stop/continue reading
+		 */
+		void throttle(bool);
+
 	private:
 		cyng::async::base_task& base_;
 		cyng::logging::log_ptr logger_;
@@ -90,6 +112,8 @@ namespace node
 			TASK_STATE_REGISTERED,
 		} task_state_;
 		std::unordered_map<std::uint64_t, sml::db_exporter>	lines_;
+		std::unordered_map<std::uint64_t, std::string>	targets_;
+		spill_queue	queue_;
 	};
 }
 
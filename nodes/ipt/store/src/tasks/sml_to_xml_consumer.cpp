@@ -28,7 +28,10 @@ namespace node
 		, boost::filesystem::path root_dir
 		, std::string root_name
 		, std::string endocing
-		, std::chrono::seconds period)
+		, std::chrono::seconds period
+		, std::size_t max_open_files
+		, std::size_t write_buffer
+		, std::chrono::seconds sync_interval)
 	: base_(*btp)
 		, logger_(logger)
 		, ntid_(ntid)
@@ -37,6 +40,7 @@ namespace node
 		, endcoding_(endocing)
 		, period_(period)
 		, task_state_(TASK_STATE_INITIAL)
+		, files_(max_open_files, write_buffer, period, sync_interval)
 		, lines_()
 	{
 		CYNG_LOG_INFO(logger_, "task #"
@@ -74,6 +78,7 @@ namespace node
 			//	<< " processed "
 			//	<< msg_counter_
 			//	<< " messages");
+			files_.flush();
 			break;
 		}
 
@@ -84,9 +89,13 @@ namespace node
 	void sml_xml_consumer::stop()
 	{
 		//
-		//	remove all open lines
+		//	complete all open lines and close all files
 		//
+		for (auto& line : lines_) {
+			close(line.second);
+		}
 		lines_.clear();
+		files_.clear();
 
 		CYNG_LOG_INFO(logger_, "task #"
 			<< base_.get_id()
@@ -107,13 +116,30 @@ namespace node
 			<< ':'
 			<< target);
 
-		lines_.emplace(std::piecewise_construct,
+		auto res = lines_.emplace(std::piecewise_construct,
 			std::forward_as_tuple(line),
 			std::forward_as_tuple(endcoding_
 				, root_name_
 				, (std::uint32_t)((line & 0xFFFFFFFF00000000LL) >> 32)
 				, (std::uint32_t)(line & 0xFFFFFFFFLL)
-				, target));
+				, target
+				, root_dir_));
+
+		if (res.second) {
+			auto& out = res.first->second;
+			auto& os = files_.open(out.file_, true);
+			if (os.is_open()) {
+				out.exporter_.write_header(os);
+			}
+			else {
+				CYNG_LOG_ERROR(logger_, "task #"
+					<< base_.get_id()
+					<< " <"
+					<< base_.get_class_name()
+					<< " cannot open "
+					<< out.file_);
+			}
+		}
 
 		CYNG_LOG_TRACE(logger_, "task #"
 			<< base_.get_id()
@@ -144,8 +170,35 @@ namespace node
 
 		auto pos = lines_.find(line);
 		if (pos != lines_.end()) {
-	
-			pos->second.read(msg, idx);
+
+			try {
+				//
+				//	append message to XML file
+				//
+				auto& os = files_.open(pos->second.file_);
+				if (os.is_open()) {
+					pos->second.exporter_.write(os, msg, idx);
+				}
+				else {
+					CYNG_LOG_ERROR(logger_, "task #"
+						<< base_.get_id()
+						<< " <"
+						<< base_.get_class_name()
+						<< " cannot open "
+						<< pos->second.file_);
+				}
+			}
+			catch (std::exception const& ex) {
+
+				CYNG_LOG_ERROR(logger_, "task #"
+					<< base_.get_id()
+					<< " <"
+					<< base_.get_class_name()
+					<< " line "
+					<< line
+					<< " error: "
+					<< ex.what());
+			}
 		}
 		else {
 			CYNG_LOG_ERROR(logger_, "task #"
@@ -173,8 +226,6 @@ namespace node
 		auto pos = lines_.find(line);
 		if (pos != lines_.end()) {
 
-			auto filename = root_dir_ / pos->second.get_filename();
-
 			CYNG_LOG_INFO(logger_, "task #"
 				<< base_.get_id()
 				<< " <"
@@ -182,25 +233,9 @@ namespace node
 				<< " write "
 				<< line
 				<< " => "
-				<< filename);
+				<< pos->second.file_);
 
-			try {
-				//
-				//	write XML file
-				//
-				pos->second.write(filename);
-			}
-			catch (std::exception const& ex) {
-
-				CYNG_LOG_ERROR(logger_, "task #"
-					<< base_.get_id()
-					<< " <"
-					<< base_.get_class_name()
-					<< " line "
-					<< line
-					<< " error: "
-					<< ex.what());
-			}
+			close(pos->second);
 
 			//
 			//	remove this line
@@ -241,4 +276,23 @@ namespace node
 		base_.mux_.post(ntid_, STORE_EVENT_REGISTER_CONSUMER, cyng::tuple_factory("SML:XML", base_.get_id()));
 	}
 
+	void sml_xml_consumer::close(output& out)
+	{
+		auto& os = files_.open(out.file_);
+		if (os.is_open()) {
+			out.exporter_.write_footer(os);
+		}
+		files_.close(out.file_);
+	}
+
+	sml_xml_consumer::output::output(std::string const& encoding
+		, std::string const& root_name
+		, std::uint32_t source
+		, std::uint32_t channel
+		, std::string const& target
+		, boost::filesystem::path const& root_dir)
+	: exporter_(encoding, root_name, source, channel, target)
+		, file_(root_dir / exporter_.get_filename())
+	{}
+
 }
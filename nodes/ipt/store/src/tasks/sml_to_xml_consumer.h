@@ -9,6 +9,7 @@
 #define NODE_IPT_STORE_TASK_SML_XML_CONSUMER_H
 
 #include <smf/sml/exporter/xml_sml_exporter.h>
+#include <smf/sml/exporter/output_files.h>
 #include <cyng/log.h>
 #include <cyng/async/mux.h>
 #include <cyng/async/policy.h>
@@ -34,7 +35,10 @@ namespace node
 			, boost::filesystem::path
 			, std::string
 			, std::string
-			, std::chrono::seconds);
+			, std::chrono::seconds
+			, std::size_t max_open_files
+			, std::size_t write_buffer
+			, std::chrono::seconds sync_interval);
 		cyng::continuation run();
 		void stop();
 
@@ -71,8 +75,30 @@ namespace node
 
 
 	private:
+		/**
+		 * XML output of a line. The messages are written to the file
+		 * as they arrive.
+		 */
+		struct output
+		{
+			output(std::string const& encoding
+				, std::string const& root_name
+				, std::uint32_t source
+				, std::uint32_t channel
+				, std::string const& target
+				, boost::filesystem::path const& root_dir);
+
+			sml::xml_exporter exporter_;
+			boost::filesystem::path const file_;
+		};
+
 		void register_consumer();
 
+		/**
+		 * complete XML file
+		 */
+		void close(output&);
+
 	private:
 		cyng::async::base_task& base_;
 		cyng::logging::log_ptr logger_;
@@ -85,7 +111,12 @@ namespace node
 			TASK_STATE_INITIAL,
 			TASK_STATE_REGISTERED,
 		} task_state_;
-		std::unordered_map<std::uint64_t, sml::xml_exporter>	lines_;
+
+		/**
+		 * open output files of all lines
+		 */
+		sml::output_files files_;
+		std::unordered_map<std::uint64_t, output>	lines_;
 	};
 }
 
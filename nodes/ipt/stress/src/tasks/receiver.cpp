@@ -354,9 +354,14 @@ namespace node
 		void receiver::reconfigure_impl()
 		{
 			//
-			//	switch to other master
+			//	sharded cluster: reconnect to the IP-T node of
+			//	the redirect - otherwise switch to other master
 			//
-			if (config_.next())
+			if (config_.redirect(get_redirect()))
+			{
+				CYNG_LOG_INFO(logger_, "redirected to " << config_.get_address());
+			}
+			else if (config_.next())
 			{
 				CYNG_LOG_INFO(logger_, "switch to redundancy "
 					<< config_.get().host_
@@ -8,6 +8,8 @@
 #include "processor.h"
 #include <smf/cluster/generator.h>
 #include <smf/lora/payload/parser.h>
+#include <smf/mbus/data_record.h>
+#include <smf/mbus/header.h>
 
 #include <cyng/vm/generator.h>
 #include <cyng/table/key.hpp>
@@ -413,6 +415,20 @@ namespace node
 			CYNG_LOG_TRACE(logger_, "meter ID: " << meter);
 			CYNG_LOG_TRACE(logger_, "value: " << value);
 			CYNG_LOG_TRACE(logger_, "CRC: " << (node::lora::crc_ok(payload) ? "OK" : "ERROR"));
+
+			//
+			//	publish reading to all MQTT bridges
+			//
+			bus_->vm_.async_run(bus_req_push_data("mqtt"
+				, "water"
+				, true		//	all
+				, cyng::table::key_generator(meter)
+				, cyng::table::data_generator(dev_eui
+					, value
+					, node::lora::manufacturer(payload)
+					, node::lora::crc_ok(payload))
+				, bus_->vm_.tag()));
+
 			if (keep_xml_files_)
 			{
 				pugi::xpath_node_set pos = doc.select_nodes("/DevEUI_uplink");
@@ -482,7 +498,62 @@ namespace node
 
 	void processor::decode_mbus(pugi::xml_document& doc, std::string const& dev_eui, std::string const& raw)
 	{
-		CYNG_LOG_ERROR(logger_, "decode DevEUI " << dev_eui << " with driver M-Bus not implemented yet");
+		const std::pair<cyng::buffer_t, bool > r = cyng::parse_hex_string(raw);
+		if (!r.second || r.first.empty()) {
+			CYNG_LOG_WARNING(logger_, "DevEUI " << dev_eui << " has invalid M-Bus payload: " << raw);
+			return;
+		}
+
+		//
+		//	skip transport layer header (if any)
+		//
+		std::size_t offset{ 0 };
+		wmbus::header h;
+		if (wmbus::read_header(static_cast<std::uint8_t>(r.first.at(0)), cyng::buffer_t(r.first.begin() + 1, r.first.end()), h)) {
+			offset = h.get_offset() + 1;
+		}
+
+		//
+		//	LoRa payload is limited to 242 bytes
+		//
+		std::array<mbus::data_record, 128> records;
+		std::size_t count{ 0 };
+		mbus::decode_records(r.first.data() + offset
+			, r.first.size() - offset
+			, records.data()
+			, records.size()
+			, count);
+
+		CYNG_LOG_TRACE(logger_, "DevEUI " << dev_eui << " contains " << count << " M-Bus record(s)");
+
+		if (keep_xml_files_) {
+
+			pugi::xpath_node_set pos = doc.select_nodes("/DevEUI_uplink");
+			if (pos.begin() != pos.end()) {
+				pugi::xpath_node node = pos.first();
+				for (std::size_t idx = 0; idx < count; ++idx) {
+					auto const& rec = records.at(idx);
+					auto vnode = node.node().append_child("value");
+					auto const value = (rec.type_ == mbus::RECORD_REAL)
+						? std::to_string(rec.value_.f_)
+						: std::to_string(rec.value_.i_)
+						;
+					vnode.append_child(pugi::node_pcdata).set_value(value.c_str());
+					vnode.append_attribute("scaler").set_value(rec.scaler_);
+					vnode.append_attribute("unit").set_value(mbus::get_unit_name(rec.unit_));
+					vnode.append_attribute("storage").set_value(static_cast<unsigned long long>(rec.storage_nr_));
+					vnode.append_attribute("tariff").set_value(rec.tariff_);
+					vnode.append_attribute("type").set_value("mbus");
+				}
+			}
+
+			//
+			//	write XML file to disk
+			//
+			std::string file_name_pattern = dev_eui + "--MBUS--%%%%-%%%%-%%%%-%%%%.xml";
+			const auto p = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path(file_name_pattern);
+			doc.save_file(p.c_str(), PUGIXML_TEXT("  "));
+		}
 	}
 
 	void processor::decode_raw(pugi::xml_document& doc, std::string const& dev_eui, std::string const& raw)
@@ -25,7 +25,9 @@ namespace node
 		, boost::asio::ip::tcp::endpoint ep
 		, std::string const& doc_root
 		, auth_dirs const& ad
-		, std::set<boost::asio::ip::address> const& blacklist)
+		, std::set<boost::asio::ip::address> const& blacklist
+		, std::uint64_t body_limit
+		, std::size_t spool_threshold)
 	: base_(*btp)
 		, bus_(bus_factory(btp->mux_, logger, boost::uuids::random_generator()(), btp->get_id()))
 		, logger_(logger)
@@ -37,7 +39,9 @@ namespace node
 			, doc_root
 			, ad
 			, blacklist
-			, bus_->vm_)
+			, bus_->vm_
+			, body_limit
+			, spool_threshold)
 		, cache_()
 		, processor_(logger, keep_xml_files, cache_, btp->mux_.get_io_service(), tag, bus_)
 		, dispatcher_(logger, cache_)
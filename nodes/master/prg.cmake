@@ -11,6 +11,9 @@ set (node_master_cpp
 	nodes/master/src/session.cpp
 	nodes/master/src/client.cpp
 	nodes/master/src/cluster.cpp
+	nodes/master/src/snapshot.cpp
+	nodes/master/src/stat_queue.cpp
+	nodes/shared/net/buffer_pool.cpp
 )
 
 set (node_master_h
@@ -22,6 +25,9 @@ set (node_master_h
 	nodes/master/src/session.h
 	nodes/master/src/client.h
 	nodes/master/src/cluster.h
+	nodes/master/src/snapshot.h
+	nodes/master/src/stat_queue.h
+	src/main/include/smf/cluster/buffer_pool.h
 )
 
 set (node_master_info
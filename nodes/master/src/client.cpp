@@ -30,18 +30,30 @@
 
 namespace node 
 {
+	namespace
+	{
+		/**
+		 * Number of push data blocks a source may send without waiting
+		 * for the response. The master forwards all blocks of a channel
+		 * in order, so the window only limits the data in flight per channel.
+		 */
+		constexpr std::uint8_t push_window_size = 16;
+	}
+
 	client::client(cyng::async::mux& mux
 		, cyng::logging::log_ptr logger
 		, cyng::store::db& db
 		, std::atomic<std::uint64_t>& global_configuration
 		, boost::uuids::uuid stag
-		, boost::filesystem::path stat_dir)
+		, boost::filesystem::path stat_dir
+		, stat_queue& stats)
 	: mux_(mux)
 		, logger_(logger)
 		, db_(db)
 		, global_configuration_(global_configuration)
-		, stat_dir_(stat_dir)
 		, stag_(stag)
+		, stat_dir_(stat_dir)
+		, stats_(stats)
 		, node_class_("undefined")
 		, rng_(std::numeric_limits<std::uint32_t>::min(), std::numeric_limits<std::uint32_t>::max())
 		, uuid_gen_()
@@ -112,6 +124,11 @@ namespace node
 		return node_class_;
 	}
 
+	void client::write_msg(cyng::logging::severity level, std::string const& msg, boost::uuids::uuid tag)
+	{
+		stats_.insert_msg(level, msg, tag);
+	}
+
 	void client::req_login(cyng::context& ctx)
 	{
 		//	[1cea6ddf-5044-478b-9fba-67fa23997ba6,65d9eb67-2187-481b-8770-5ce41801eaa6,1,data-store,secret,plain,%(("security":scrambled),("tp-layer":ipt)),<!259:session>]
@@ -164,13 +181,42 @@ namespace node
 		//
 		bool found{ false };
 		bool wrong_pwd{ false };
-		db_.access([&](const cyng::store::table* tbl_device, cyng::store::table* tbl_session, cyng::store::table* tbl_cluster, cyng::store::table* tbl_tsdb)->void {
+		bool login{ false };
+		boost::uuids::uuid dev_tag{ boost::uuids::nil_uuid() };
+		std::uint32_t query{ 6 };
+
+		//
+		//	Scanning the device table is the expensive part. This runs
+		//	under read locks only, so logins can proceed in parallel.
+		//
+		db_.access([&](cyng::store::table const* tbl_device, cyng::store::table const* tbl_session, cyng::store::table const* tbl_cfg)->void {
+
+			//
+			//	sharded mode: account is served by another master
+			//
+			auto const redirect = get_shard_redirect(tbl_cfg, account);
 
 			//
 			// check if session is already authorized
 			//
 			const bool auth = check_auth_state(tbl_session, tag);
-			if (auth)
+			if (!redirect.empty())
+			{
+				found = true;
+
+				ctx.queue(cyng::generate_invoke("log.msg.info", "[" + account + "] redirect to shard", redirect));
+
+				auto bag_redirect = bag;
+				bag_redirect["redirect"] = cyng::make_object(redirect);
+				ctx.queue(client_res_login(tag
+					, seq
+					, false
+					, account
+					, "redirect"
+					, 0
+					, bag_redirect));
+			}
+			else if (auth)
 			{
 				ctx.queue(cyng::generate_invoke("log.msg.warning", "[" + account + "] already authorized", tag));
 				ctx.queue(client_res_login(tag
@@ -192,84 +238,58 @@ namespace node
 				if (!online)
 				{
 					//
-					//	test credentials
+					//	test credentials.
+					//	An IP-T node with a credential cache sends the primary key
+					//	of the account, so the device table has not to be scanned.
 					//
-					boost::uuids::uuid dev_tag{ boost::uuids::nil_uuid() };
-					std::uint32_t query{ 6 };
-					std::tie(found, wrong_pwd, dev_tag, query) = test_credential(ctx, tbl_device, account, pwd);
+					auto dom = cyng::make_reader(bag);
+					auto const pk = cyng::value_cast(dom.get("pk"), boost::uuids::nil_uuid());
+					std::tie(found, wrong_pwd, dev_tag, query) = test_credential(ctx, tbl_device, account, pwd, pk);
+					login = found && !wrong_pwd;
+				}
+				else
+				{
+					found = true;
 
-					if (found && !wrong_pwd)
-					{
-						//	bag
-						//	%(("security":scrambled),("tp-layer":ipt))
-						auto dom = cyng::make_reader(bag);
-
-						if (tbl_session->insert(cyng::table::key_generator(tag)
-							, cyng::table::data_generator(self	//	local
-								, cyng::make_object()			//	remote
-								, cluster_tag					//	peer
-								, dev_tag						//	device
-								, account						//	name
-								, rng_()			//	source id
-								, std::chrono::system_clock::now()
-								, boost::uuids::nil_uuid()
-								, cyng::value_cast<std::string>(dom.get("tp-layer"), "tcp/ip")
-								, 0u, 0u, 0u)
-							, 1
-							, tag))
-						{
-							ctx.queue(client_res_login(tag
-								, seq
-								, true
-								, account
-								, "OK"
-								, query
-								, bag));
+					ctx.queue(client_res_login(tag
+						, seq
+						, false
+						, account
+						, "already online"
+						, 0
+						, bag));
 
-							ctx.queue(cyng::generate_invoke("log.msg.info", "[" + account + "] has session tag", tag));
+					//
+					//	write statistics
+					//
+					write_stat(tag, account, "login", "already online");
 
-							//
-							//	write statistics
-							//
-							write_stat(tbl_tsdb, tag, account, "login", "OK");
+				}
+			}
+		}	, cyng::store::read_access("TDevice")
+			, cyng::store::read_access("_Session")
+			, cyng::store::read_access("_Config"));
 
-							//
-							//	update cluster table
-							//
-							//auto tag_cluster = cyng::object_cast<session>(self)->vm_.tag();
-							auto key_cluster = cyng::table::key_generator(cluster_tag);
-							auto list = get_clients_by_peer(tbl_session, cluster_tag);
-							tbl_cluster->modify(key_cluster, cyng::param_factory("clients", static_cast<std::uint64_t>(list.size())), tag);
+		if (login)
+		{
+			//	bag
+			//	%(("security":scrambled),("tp-layer":ipt))
+			auto dom = cyng::make_reader(bag);
 
-						}
-						else
-						{
-							ctx.queue(client_res_login(tag
-								, seq
-								, false
-								, account
-								, "cannot create session"
-								, query
-								, bag));
-
-							ctx.queue(cyng::generate_invoke("log.msg.error"
-								, "cannot insert new session of account "
-								, account
-								, " with pk "
-								, tag));
+			db_.access([&](cyng::store::table* tbl_session)->void {
 
-							//
-							//	write statistics
-							//
-							write_stat(tbl_tsdb, tag, account, "login", "internal error");
+				//
+				//	another login of the same account could have been
+				//	completed in the meantime
+				//
+				bool online{ false };
+				tbl_session->loop([&](cyng::table::record const& rec) -> bool {
+					online = boost::algorithm::equals(account, cyng::value_cast<std::string>(rec["name"], ""));
+					return !online;
+				});
 
-						}
-					}
-				}
-				else
+				if (online)
 				{
-					found = true;
-
 					ctx.queue(client_res_login(tag
 						, seq
 						, false
@@ -278,17 +298,75 @@ namespace node
 						, 0
 						, bag));
 
+					write_stat(tag, account, "login", "already online");
+					login = false;
+				}
+				else if (tbl_session->insert(cyng::table::key_generator(tag)
+					, cyng::table::data_generator(self	//	local
+						, cyng::make_object()			//	remote
+						, cluster_tag					//	peer
+						, dev_tag						//	device
+						, account						//	name
+						, rng_()			//	source id
+						, std::chrono::system_clock::now()
+						, boost::uuids::nil_uuid()
+						, cyng::value_cast<std::string>(dom.get("tp-layer"), "tcp/ip")
+						, 0u, 0u, 0u)
+					, 1
+					, tag))
+				{
+					ctx.queue(client_res_login(tag
+						, seq
+						, true
+						, account
+						, "OK"
+						, query
+						, bag));
+
+					ctx.queue(cyng::generate_invoke("log.msg.info", "[" + account + "] has session tag", tag));
+
 					//
 					//	write statistics
 					//
-					write_stat(tbl_tsdb, tag, account, "login", "already online");
+					write_stat(tag, account, "login", "OK");
+				}
+				else
+				{
+					ctx.queue(client_res_login(tag
+						, seq
+						, false
+						, account
+						, "cannot create session"
+						, query
+						, bag));
 
+					ctx.queue(cyng::generate_invoke("log.msg.error"
+						, "cannot insert new session of account "
+						, account
+						, " with pk "
+						, tag));
+
+					//
+					//	write statistics
+					//
+					write_stat(tag, account, "login", "internal error");
+					login = false;
 				}
-			}
-		}	, cyng::store::read_access("TDevice")
-			, cyng::store::write_access("_Session")
-			, cyng::store::write_access("_Cluster")
-			, cyng::store::write_access("_TimeSeries"));
+			}, cyng::store::write_access("_Session"));
+		}
+
+		if (login)
+		{
+			//
+			//	update cluster table
+			//
+			db_.access([&](cyng::store::table const* tbl_session, cyng::store::table* tbl_cluster)->void {
+				auto key_cluster = cyng::table::key_generator(cluster_tag);
+				auto list = get_clients_by_peer(tbl_session, cluster_tag);
+				tbl_cluster->modify(key_cluster, cyng::param_factory("clients", static_cast<std::uint64_t>(list.size())), tag);
+			}	, cyng::store::read_access("_Session")
+				, cyng::store::write_access("_Cluster"));
+		}
 
 		if (!found)
 		{
@@ -339,17 +417,22 @@ namespace node
 
 			}
 
+			//
+			//	write statistics
+			//
+			write_stat(tag, account, "login", wrong_pwd ? "incorrect password" : "unknown device");
+
 			//
 			//	system message
 			//
 			if (wrong_pwd)
 			{
-				insert_msg(db_, cyng::logging::severity::LEVEL_WARNING
+				write_msg(cyng::logging::severity::LEVEL_WARNING
 					, "login of [" + account + "] failed (cause: incorrect password)"
 					, tag);
 			}
 			else {
-				insert_msg(db_, cyng::logging::severity::LEVEL_WARNING
+				write_msg(cyng::logging::severity::LEVEL_WARNING
 					, "login of [" + account + "] failed (cause: unknown device)"
 					, tag);
 			}
@@ -357,13 +440,34 @@ namespace node
 	}
 
 	std::tuple<bool, bool, boost::uuids::uuid, std::uint32_t> 
-		client::test_credential(cyng::context& ctx, const cyng::store::table* tbl, std::string const& account, std::string const& pwd)
+		client::test_credential(cyng::context& ctx
+			, const cyng::store::table* tbl
+			, std::string const& account
+			, std::string const& pwd
+			, boost::uuids::uuid pk)
 	{
 		bool found{ false };
 		bool wrong_pwd{ false };
 		boost::uuids::uuid dev_tag{ boost::uuids::nil_uuid() };
 		std::uint32_t query{ 6 };
 
+		if (!pk.is_nil()) {
+
+			//
+			//	direct lookup - fall back to a scan if the hint is outdated
+			//
+			auto const rec = tbl->lookup(cyng::table::key_generator(pk));
+			if (!rec.empty() && boost::algorithm::equals(account, cyng::value_cast<std::string>(rec["name"], ""))) {
+
+				if (boost::algorithm::equals(pwd, cyng::value_cast<std::string>(rec["pwd"], ""))) {
+					ctx.queue(cyng::generate_invoke("log.msg.info", "password match [", account, "] OK"));
+					dev_tag = pk;
+					query = cyng::value_cast<std::uint32_t>(rec["query"], 6);
+					return std::make_tuple(true, false, dev_tag, query);
+				}
+			}
+		}
+
 		tbl->loop([&](cyng::table::record const& rec) -> bool {
 
 			const auto rec_account = cyng::value_cast<std::string>(rec["name"], "");
@@ -426,7 +530,7 @@ namespace node
 		return std::make_tuple(found, wrong_pwd, dev_tag, query);
 	}
 
-	bool client::check_auth_state(cyng::store::table* tbl, boost::uuids::uuid tag)
+	bool client::check_auth_state(cyng::store::table const* tbl, boost::uuids::uuid tag)
 	{
 		//
 		//	generate table key
@@ -435,7 +539,7 @@ namespace node
 		return tbl->exist(key);
 	}
 
-	bool client::check_online_state(cyng::context& ctx, cyng::store::table* tbl, std::string const& account)
+	bool client::check_online_state(cyng::context& ctx, cyng::store::table const* tbl, std::string const& account)
 	{
 		bool online{ false };
 		tbl->loop([&](cyng::table::record const& rec) -> bool {
@@ -547,7 +651,7 @@ namespace node
 			, cyng::store::table* tbl_target
 			, cyng::store::table* tbl_cluster
 			, cyng::store::table* tbl_connection
-			, cyng::store::table* tbl_tsdb)->void {
+			)->void {
 
 			//
 			//	generate table key for
@@ -607,7 +711,7 @@ namespace node
 						//
 						//	write stats
 						//
-						write_stat(tbl_tsdb, rtag, account, "close connection", "local");
+						write_stat(rtag, account, "close connection", "local");
 
 					}
 					else
@@ -622,7 +726,7 @@ namespace node
 							, rtag));
 						remote_peer->vm_.async_run(client_req_close_connection_forward(rtag, tag, seq, true, cyng::param_map_factory("local-connect", false), bag));
 
-						write_stat(tbl_tsdb, rtag, account, "close connection", "remote");
+						write_stat(rtag, account, "close connection", "remote");
 					}
 
 					//
@@ -653,7 +757,7 @@ namespace node
 					, "removed"));
 
 				if (count_targets != 0u) {
-					write_stat(tbl_tsdb, tag, account, "remove targets", count_targets);
+					write_stat(tag, account, "remove targets", count_targets);
 				}
 
 				//
@@ -670,7 +774,7 @@ namespace node
 
 				const auto now = std::chrono::system_clock::now();
 				auto uptime = std::chrono::duration_cast<std::chrono::seconds>(now - cyng::value_cast(rec["loginTime"], now));
-				write_stat(tbl_tsdb, tag, account, "offline", uptime);
+				write_stat(tag, account, "offline", uptime);
 
 				//
 				//	update cluster table
@@ -690,8 +794,7 @@ namespace node
 		}	, cyng::store::write_access("_Session")
 			, cyng::store::write_access("_Target")
 			, cyng::store::write_access("_Cluster")
-			, cyng::store::write_access("_Connection")
-			, cyng::store::write_access("_TimeSeries"));
+			, cyng::store::write_access("_Connection"));
 
 		if (req)
 		{
@@ -752,7 +855,8 @@ namespace node
 		options["local-peer"] = cyng::make_object(peer);	//	and this peer
 															
 		bool success{ false };
-		db_.access([&](cyng::store::table const* tbl_device, cyng::store::table* tbl_session, cyng::store::table* tbl_tsdb)->void {
+		std::string redirect;	//	device is served by another shard
+		db_.access([&](cyng::store::table const* tbl_device, cyng::store::table* tbl_session, cyng::store::table const* tbl_cfg)->void {
 
 			//
 			//	generate statistics
@@ -816,7 +920,7 @@ namespace node
 						//
 						//	write statistics
 						//
-						write_stat(tbl_tsdb, tag, account, "dialup " + dev_number, "disabled");
+						write_stat(tag, account, "dialup " + dev_number, "disabled");
 
 						//
 						//	abort loop
@@ -888,8 +992,8 @@ namespace node
 							//	write statistics
 							//
 							if (is_generate_time_series()) {
-								write_stat(tbl_tsdb, tag, account, "dialup", dev_number.c_str());
-								write_stat(tbl_tsdb, tag, callee, "called by", account.c_str());
+								write_stat(tag, account, "dialup", dev_number.c_str());
+								write_stat(tag, callee, "called by", account.c_str());
 							}
 
 							success = true;
@@ -899,6 +1003,13 @@ namespace node
 						return true;
 					});
 
+					//
+					//	sharded mode: the session of the callee is on another master
+					//
+					if (!success) {
+						redirect = get_shard_redirect(tbl_cfg, callee);
+					}
+
 					//	continue loop in TDevice
 					return false;
 				}
@@ -907,14 +1018,20 @@ namespace node
 
 		}	, cyng::store::read_access("TDevice")
 			, cyng::store::write_access("_Session")
-			, cyng::store::write_access("_TimeSeries"));
+			, cyng::store::read_access("_Config"));
 
 		if (!success)
 		{
 			options["response-code"] = cyng::make_object<std::uint8_t>(ipt::tp_res_open_connection_policy::DIALUP_FAILED);
-			CYNG_LOG_WARNING(logger_, "cannot open connection: device #"
-				<< number
-				<< " not found");
+
+			//
+			//	connections are not forwarded between shards
+			//
+			auto const msg = redirect.empty()
+				? ("cannot open connection: device #" + number + " not found")
+				: ("cannot open connection: device #" + number + " is served by shard " + redirect)
+				;
+			CYNG_LOG_WARNING(logger_, msg);
 
 			ctx.queue(client_res_open_connection_forward(tag
 				, seq
@@ -925,8 +1042,8 @@ namespace node
 			//
 			//	place a system message
 			//
-			insert_msg(db_, cyng::logging::severity::LEVEL_WARNING
-				, "cannot open connection: device #" + number + " not found"
+			write_msg(cyng::logging::severity::LEVEL_WARNING
+				, msg
 				, tag);
 		}
 	}
@@ -987,7 +1104,7 @@ namespace node
 		//
 		//	insert connection record
 		//
-		db_.access([&](cyng::store::table* tbl_session, cyng::store::table* tbl_connection, cyng::store::table* tbl_tsdb)->void {
+		db_.access([&](cyng::store::table* tbl_session, cyng::store::table* tbl_connection)->void {
 
 			//
 			//	generate statistics
@@ -1056,7 +1173,7 @@ namespace node
 					//
 					//	write statistics
 					//
-					write_stat(tbl_tsdb, tag, account, "answer from " + callee, "OK");
+					write_stat(tag, account, "answer from " + callee, "OK");
 
 				}
 				else
@@ -1064,7 +1181,7 @@ namespace node
 					//
 					//	write statistics
 					//
-					write_stat(tbl_tsdb, tag, account, "answer from " + callee, "failed");
+					write_stat(tag, account, "answer from " + callee, "failed");
 				}
 
 				if (local)
@@ -1113,8 +1230,7 @@ namespace node
 			}
 
 		}	, cyng::store::write_access("_Session")
-			, cyng::store::write_access("_Connection")
-			, cyng::store::write_access("_TimeSeries"));
+			, cyng::store::write_access("_Connection"));
 
 	}
 
@@ -1566,7 +1682,7 @@ namespace node
 						, options
 						, bag));
 
-					insert_msg(db_, cyng::logging::severity::LEVEL_WARNING
+					write_msg(cyng::logging::severity::LEVEL_WARNING
 						, "[" + name + "] has no open connection to close"
 						, tag);
 				}
@@ -1639,7 +1755,7 @@ namespace node
 	{
 		if (name.empty())
 		{
-			insert_msg(db_, cyng::logging::severity::LEVEL_WARNING
+			write_msg(cyng::logging::severity::LEVEL_WARNING
 				, "no target specified"
 				, tag);
 			req_open_push_channel_empty(ctx, tag, seq, bag);
@@ -1652,9 +1768,9 @@ namespace node
 		db_.access([&](const cyng::store::table* tbl_target
 			, cyng::store::table* tbl_channel
 			, const cyng::store::table* tbl_session
-			, cyng::store::table* tbl_msg
 			, const cyng::store::table* tbl_device
-			, cyng::store::table* tbl_tsdb)->void {
+			, const cyng::store::table* tbl_cfg
+			)->void {
 
 
 			//
@@ -1679,11 +1795,9 @@ namespace node
 					, "is not enabled"));
 				req_open_push_channel_empty(ctx, tag, seq, bag);
 
-				insert_msg(tbl_msg
-					, cyng::logging::severity::LEVEL_INFO
+				write_msg(cyng::logging::severity::LEVEL_INFO
 					, "open push channel - device [" + account + "] is not enabled"
-					, tag
-					, 1000u);
+					, tag);
 
 				return;
 			}
@@ -1706,16 +1820,19 @@ namespace node
 
 			if (r.first.empty())
 			{
-				insert_msg(tbl_msg
-					, cyng::logging::severity::LEVEL_WARNING
-					, "no target [" + name + "] registered"
-					, tag
-					, 1000u);
+				//
+				//	push channels are not forwarded between shards
+				//
+				write_msg(cyng::logging::severity::LEVEL_WARNING
+					, is_sharded(tbl_cfg)
+						? ("no target [" + name + "] registered on this shard")
+						: ("no target [" + name + "] registered")
+					, tag);
 
 				//
 				//	write statistics
 				//
-				write_stat(tbl_tsdb, tag, account, "no target", name.c_str());
+				write_stat(tag, account, "no target", name.c_str());
 
 			}
 
@@ -1735,7 +1852,6 @@ namespace node
 				if (create_channel(ctx
 					, tbl_channel
 					, tbl_session
-					, tbl_msg
 					, name
 					, account
 					, source_channel
@@ -1757,7 +1873,7 @@ namespace node
 						<< channel
 						<< ")"
 						;
-					write_stat(tbl_tsdb, tag, account, "open push channel", ss.str());
+					write_stat(tag, account, "open push channel", ss.str());
 				}
 
 			}
@@ -1766,7 +1882,7 @@ namespace node
 			options["response-code"] = cyng::make_object<std::uint8_t>(r.first.empty() ? ipt::tp_res_close_push_channel_policy::UNDEFINED : ipt::tp_res_close_push_channel_policy::SUCCESS);
 			options["channel-status"] = cyng::make_object<std::uint8_t>(0); //	always 0
 			options["packet-size"] = cyng::make_object(r.second);
-			options["window-size"] = cyng::make_object<std::uint8_t>(1); //	always 1
+			options["window-size"] = cyng::make_object<std::uint8_t>(push_window_size);
 
 			ctx.queue(client_res_open_push_channel(tag
 				, seq
@@ -1780,15 +1896,13 @@ namespace node
 		}	, cyng::store::read_access("_Target")
 			, cyng::store::write_access("_Channel")
 			, cyng::store::read_access("_Session")
-			, cyng::store::write_access("_SysMsg")
 			, cyng::store::read_access("TDevice")
-			, cyng::store::write_access("_TimeSeries"));
+			, cyng::store::read_access("_Config"));
 	}
 
 	bool client::create_channel(cyng::context& ctx
 		, cyng::store::table* tbl_channel
 		, const cyng::store::table* tbl_session
-		, cyng::store::table* tbl_msg
 		, std::string const& target_name
 		, std::string const& account
 		, std::uint32_t source_channel
@@ -1841,11 +1955,9 @@ namespace node
 					, "open push channel - failed"
 					, channel, source_channel, target));
 
-				insert_msg(tbl_msg
-					, cyng::logging::severity::LEVEL_WARNING
+				write_msg(cyng::logging::severity::LEVEL_WARNING
 					, "open push channel - [" + target_name + "] failed"
-					, tag
-					, 1000u);
+					, tag);
 
 			}
 		}
@@ -1855,11 +1967,9 @@ namespace node
 				, "open push channel - no target session"
 				, target_session_tag));
 
-			insert_msg(tbl_msg
-				, cyng::logging::severity::LEVEL_WARNING
+			write_msg(cyng::logging::severity::LEVEL_WARNING
 				, "open push channel - no target [" + target_name + "] session"
-				, tag
-				, 1000u);
+				, tag);
 
 		}
 		return false;
@@ -1931,7 +2041,7 @@ namespace node
 	{
 		cyng::table::key_list_t pks;
 
-		db_.access([&](cyng::store::table* tbl_channel, cyng::store::table* tbl_tsdb)->void {
+		db_.access([&](cyng::store::table* tbl_channel)->void {
 			tbl_channel->loop([&](cyng::table::record const& rec) -> bool {
 				if (channel == cyng::value_cast<std::uint32_t>(rec["channel"], 0u))
 				{ 
@@ -1959,7 +2069,7 @@ namespace node
 						<< channel
 						<< ")"
 						;
-					write_stat(tbl_tsdb, tag, account, "close push channel", ss.str());
+					write_stat(tag, account, "close push channel", ss.str());
 				}
 				//	continue
 				return true;
@@ -1970,8 +2080,7 @@ namespace node
 			//
 			cyng::erase(tbl_channel, pks, tag);
 
-		}	, cyng::store::write_access("_Channel")
-			, cyng::store::write_access("_TimeSeries"));
+		}	, cyng::store::write_access("_Channel"));
 
 		//
 		//	send response
@@ -2036,7 +2145,7 @@ namespace node
 		//	push data to target(s)
 		//
 		std::size_t counter{ 0 };
-		db_.access([&](cyng::store::table* tbl_channel)->void {
+		db_.access([&](cyng::store::table const* tbl_channel)->void {
 
 			tbl_channel->loop([&](cyng::table::record const& rec) -> bool {
 
@@ -2116,7 +2225,7 @@ namespace node
 				return true;
 			});
 
-		}, cyng::store::write_access("_Channel"));
+		}, cyng::store::read_access("_Channel"));
 
 		if (counter == 0)
 		{
@@ -2128,8 +2237,7 @@ namespace node
 				<< source
 				<< "==> no target ");
 
-			insert_msg(db_
-				, cyng::logging::severity::LEVEL_WARNING
+			write_msg(cyng::logging::severity::LEVEL_WARNING
 				, "transfer.push.data without target"
 				, tag);
 		}
@@ -9,6 +9,7 @@
 #define NODE_MASTER_CLIENT_H
 
 #include "db.h"
+#include "stat_queue.h"
 
 #include <cyng/async/mux.h>
 #include <cyng/log.h>
@@ -43,7 +44,8 @@ namespace node
 			, cyng::store::db&
 			, std::atomic<std::uint64_t>& global_configuration
 			, boost::uuids::uuid stag
-			, boost::filesystem::path stat_dir);
+			, boost::filesystem::path stat_dir
+			, stat_queue&);
 
 		client(client const&) = delete;
 		client& operator=(client const&) = delete;
@@ -205,31 +207,26 @@ namespace node
 		void set_class(std::string const&);
 		std::string get_class();
 
+		/**
+		 * Statistics are queued and written in batches.
+		 * No table lock required.
+		 */
 		template <typename T>
 		void write_stat(boost::uuids::uuid tag, std::string const& account, std::string const& evt, T&& value)
 		{
 			if (is_generate_time_series())
 			{
-				node::insert_ts_event(db_
-					, tag
+				stats_.write_stat(tag
 					, account
 					, evt
 					, cyng::make_object(value));
 			}
 		}
 
-		template <typename T>
-		void write_stat(cyng::store::table* tbl, boost::uuids::uuid tag, std::string const& account, std::string const& evt, T&& value)
-		{
-			if (is_generate_time_series())
-			{
-				insert_ts_event(tbl
-					, tag
-					, account
-					, evt
-					, cyng::make_object(value));
-			}
-		}
+		/**
+		 * Queue a system message. No table lock required.
+		 */
+		void write_msg(cyng::logging::severity, std::string const&, boost::uuids::uuid tag);
 
 	private:
 		void req_open_push_channel_empty(cyng::context& ctx
@@ -237,16 +234,22 @@ namespace node
 			, std::uint64_t seq
 			, cyng::param_map_t const& bag);
 
-		bool check_auth_state(cyng::store::table*, boost::uuids::uuid);
-		bool check_online_state(cyng::context& ctx, cyng::store::table*, std::string const&);
-		std::tuple<bool, bool, boost::uuids::uuid, std::uint32_t> test_credential(cyng::context& ctx, const cyng::store::table*, std::string const&, std::string const&);
+		bool check_auth_state(cyng::store::table const*, boost::uuids::uuid);
+		bool check_online_state(cyng::context& ctx, cyng::store::table const*, std::string const&);
+		/**
+		 * @param pk primary key of the account if known (nil otherwise)
+		 */
+		std::tuple<bool, bool, boost::uuids::uuid, std::uint32_t> test_credential(cyng::context& ctx
+			, const cyng::store::table*
+			, std::string const&
+			, std::string const&
+			, boost::uuids::uuid pk);
 
 		cyng::table::key_list_t get_clients_by_peer(const cyng::store::table* tbl_session, boost::uuids::uuid);
 
 		bool create_channel(cyng::context& ctx
 			, cyng::store::table* tbl_channel
 			, const cyng::store::table* tbl_session
-			, cyng::store::table* tbl_msg
 			, std::string const& target_name
 			, std::string const& account
 			, std::uint32_t source_channel
@@ -265,6 +268,7 @@ namespace node
 		std::atomic<std::uint64_t>& global_configuration_;
 		boost::uuids::uuid const stag_;
 		boost::filesystem::path const stat_dir_;
+		stat_queue& stats_;
 
 		/**
 		 * transport layer
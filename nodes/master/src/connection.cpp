@@ -26,10 +26,11 @@ namespace node
 		, boost::uuids::uuid stag
 		, std::chrono::seconds monitor //	cluster watchdog
 		, std::atomic<std::uint64_t>& global_configuration
-		, boost::filesystem::path stat_dir)
+		, boost::filesystem::path stat_dir
+		, stat_queue& stats
+		, snapshot& snap)
 	: socket_(std::move(socket))
 		, logger_(logger)
-		, buffer_()
 		, session_(make_session(mux
 			, logger
 			, mtag
@@ -39,7 +40,9 @@ namespace node
 			, stag
 			, monitor
 			, global_configuration
-			, stat_dir))
+			, stat_dir
+			, stats
+			, snap))
 		, serializer_(socket_, this->get_session()->vm_)
 	{
 		//
@@ -67,8 +70,8 @@ namespace node
 	{
 		//CYNG_LOG_TRACE(logger_, "DO READ");
 		auto self(shared_from_this());
-		socket_.async_read_some(boost::asio::buffer(buffer_),
-			[this, self](boost::system::error_code ec, std::size_t bytes_transferred)
+		async_read_pooled(socket_,
+			[this, self](boost::system::error_code ec, buffer_pool::buffer const& buffer, std::size_t bytes_transferred)
 			{
 				//CYNG_LOG_TRACE(logger_, "READ SOME");
 				if (!ec)
@@ -76,11 +79,11 @@ namespace node
 #ifdef SMF_IO_DEBUG
 					cyng::io::hex_dump hd;
 					std::stringstream ss;
-					hd(ss, buffer_.data(), buffer_.data() + bytes_transferred);
+					hd(ss, buffer.data(), buffer.data() + bytes_transferred);
 					CYNG_LOG_TRACE(logger_, "cluster connection received " << ss.str());
 #endif
 
-					const std::size_t count = get_session()->parser_.read(buffer_.data(), buffer_.data() + bytes_transferred);
+					const std::size_t count = get_session()->parser_.read(buffer.data(), buffer.data() + bytes_transferred);
 					CYNG_LOG_TRACE(logger_, "cluster connection "
 						<< get_session()->vm_.tag()
 						<< " received "
@@ -10,6 +10,7 @@
 
 #include "session.h"
 #include <smf/cluster/serializer.h>
+#include <smf/cluster/buffer_pool.h>
 #include <NODE_project_info.h>
 #include <cyng/log.h>
 #include <array>
@@ -39,7 +40,9 @@ namespace node
 			, boost::uuids::uuid stag
 			, std::chrono::seconds monitor
 			, std::atomic<std::uint64_t>& global_configuration
-			, boost::filesystem::path);
+			, boost::filesystem::path
+			, stat_queue&
+			, snapshot&);
 		
 		/**
 		 * Start the first asynchronous operation for the connection.
@@ -76,11 +79,6 @@ namespace node
 		 */
 		cyng::logging::log_ptr logger_;
 		
-		/**
-		 * Buffer for incoming data.
-		 */
-		std::array<char, NODE::PREFERRED_BUFFER_SIZE> buffer_;
-		
 		/**
 		 * Implements the session logic
 		 */
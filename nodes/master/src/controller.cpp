@@ -179,11 +179,16 @@ namespace node
 						cyng::param_factory("auto-login", false),
 						cyng::param_factory("auto-enabled", true),
 						cyng::param_factory("supersede", true),
-						cyng::param_factory("generate-time-series", false),
+						cyng::param_factory("generate-time-series", true),	//	required by the stat task
 						cyng::param_factory("catch-meters", false),
 						cyng::param_factory("catch-lora", true),
 						cyng::param_factory("stat-dir", tmp.string()),	//	store statistics
-						cyng::param_factory("max-messages", 1000)
+						cyng::param_factory("max-messages", 1000),
+						cyng::param_factory("snapshot-dir", (tmp / "smf-master").string()),	//	empty to disable
+						cyng::param_factory("snapshot-interval", 300),	//	seconds
+						cyng::param_factory("shard-index", 0),	//	sharded mode
+						cyng::param_factory("shard-redirect", cyng::vector_factory({})),	//	IP-T address of each shard (host:port)
+						cyng::param_factory("shard-global", cyng::vector_factory({}))	//	accounts served by all shards
 						//cyng::param_factory("auto-gw", true)	//	insert gateways automatically
 					))
 					, cyng::param_factory("cluster", cyng::tuple_factory(
@@ -13,6 +13,8 @@
 #include <cyng/intrinsics/traits/tag.hpp>
 #include <cyng/intrinsics/traits.hpp>
 #include <cyng/io/serializer.h>
+#include <cyng/value_cast.hpp>
+#include <cyng/numeric_cast.hpp>
 
 #include <algorithm>
 
@@ -32,7 +34,10 @@ namespace node
 		, boost::asio::ip::tcp::endpoint ep
 		, std::uint64_t global_config
 		, boost::filesystem::path stat_dir
-		, std::uint64_t max_messages)
+		, std::uint64_t max_messages
+		, std::uint32_t shard_index
+		, cyng::vector_t const& shard_redirect
+		, cyng::vector_t const& shard_global)
 	{
 		CYNG_LOG_INFO(logger, "initialize database as node " << tag);
 
@@ -270,6 +275,13 @@ namespace node
 			db.insert("_Config", cyng::table::key_generator("country-code"), cyng::table::data_generator(country_code), 1, tag);
 			db.insert("_Config", cyng::table::key_generator("max-messages"), cyng::table::data_generator(max_messages), 1, tag);
 
+			//
+			//	sharded mode is enabled with more than one redirect address
+			//
+			db.insert("_Config", cyng::table::key_generator("shard-index"), cyng::table::data_generator(shard_index), 1, tag);
+			db.insert("_Config", cyng::table::key_generator("shard-redirect"), cyng::table::data_generator(shard_redirect), 1, tag);
+			db.insert("_Config", cyng::table::key_generator("shard-global"), cyng::table::data_generator(shard_global), 1, tag);
+
 
 			//	get hostname
 			boost::system::error_code ec;
@@ -337,6 +349,14 @@ namespace node
 			CYNG_LOG_FATAL(logger, "cannot create table _TimeSeries");
 		}
 
+		//
+		//	aggregated statistics (stat task)
+		//
+		if (!create_table(db, "_Statistics"))
+		{
+			CYNG_LOG_FATAL(logger, "cannot create table _Statistics");
+		}
+
 	}
 
 	cyng::object get_config(cyng::store::db& db, std::string key)
@@ -357,6 +377,48 @@ namespace node
 		return cyng::make_object();
 	}
 
+	std::uint32_t get_shard(std::string const& account, std::uint32_t count)
+	{
+		if (count < 2)	return 0;
+
+		std::uint32_t h = 0x811c9dc5;
+		for (auto const c : account) {
+			h ^= static_cast<std::uint8_t>(c);
+			h *= 0x01000193;
+		}
+		return h % count;
+	}
+
+	std::string get_shard_redirect(cyng::store::table const* tbl_cfg, std::string const& account)
+	{
+		cyng::vector_t redirect;
+		redirect = cyng::value_cast(get_config(tbl_cfg, "shard-redirect"), redirect);
+		if (redirect.size() < 2)	return "";
+
+		//
+		//	accounts that are served by all shards (i.e. push targets)
+		//
+		cyng::vector_t global;
+		global = cyng::value_cast(get_config(tbl_cfg, "shard-global"), global);
+		for (auto const& obj : global) {
+			if (boost::algorithm::equals(cyng::value_cast<std::string>(obj, ""), account))	return "";
+		}
+
+		auto const index = cyng::numeric_cast<std::uint32_t>(get_config(tbl_cfg, "shard-index"), 0u);
+		auto const shard = get_shard(account, static_cast<std::uint32_t>(redirect.size()));
+		return (shard == index)
+			? ""
+			: cyng::value_cast<std::string>(redirect.at(shard), "")
+			;
+	}
+
+	bool is_sharded(cyng::store::table const* tbl_cfg)
+	{
+		cyng::vector_t redirect;
+		redirect = cyng::value_cast(get_config(tbl_cfg, "shard-redirect"), redirect);
+		return redirect.size() > 1;
+	}
+
 	void insert_msg(cyng::store::db& db
 		, cyng::logging::severity level
 		, std::string const& msg
@@ -379,7 +441,8 @@ namespace node
 		, cyng::logging::severity level
 		, std::string const& msg
 		, boost::uuids::uuid tag
-		, std::uint64_t max_messages)
+		, std::uint64_t max_messages
+		, std::chrono::system_clock::time_point tp)
 	{
 		//
 		//	upper limit is 1000 messages
@@ -393,7 +456,7 @@ namespace node
 				auto next_idx = cyng::value_cast<std::uint64_t>(max_rec["id"], 0u);
 
 				tbl->insert(cyng::table::key_generator(++next_idx)
-					, cyng::table::data_generator(std::chrono::system_clock::now()
+					, cyng::table::data_generator(tp
 						, static_cast<std::uint8_t>(level), msg)
 					, 1, tag);
 			}
@@ -408,7 +471,7 @@ namespace node
 		}
 		else {
 			tbl->insert(cyng::table::key_generator(static_cast<std::uint64_t>(tbl->size()))
-				, cyng::table::data_generator(std::chrono::system_clock::now()
+				, cyng::table::data_generator(tp
 					, static_cast<std::uint8_t>(level), msg)
 				, 1, tag);
 		}
@@ -429,7 +492,8 @@ namespace node
 		, boost::uuids::uuid tag
 		, std::string const& account
 		, std::string const& evt
-		, cyng::object obj)
+		, cyng::object obj
+		, std::chrono::system_clock::time_point tp)
 	{
 		//
 		//	upper limit is 256 entries
@@ -443,7 +507,7 @@ namespace node
 				auto next_idx = cyng::value_cast<std::uint64_t>(max_rec["id"], 0u);
 
 				tbl->insert(cyng::table::key_generator(++next_idx)
-					, cyng::table::data_generator(std::chrono::system_clock::now()
+					, cyng::table::data_generator(tp
 						, tag
 						, account
 						, evt
@@ -461,7 +525,7 @@ namespace node
 		}
 		else {
 			tbl->insert(cyng::table::key_generator(static_cast<std::uint64_t>(tbl->size()))
-				, cyng::table::data_generator(std::chrono::system_clock::now()
+				, cyng::table::data_generator(tp
 					, tag
 					, account
 					, evt
@@ -11,6 +11,7 @@
 #include <cyng/log.h>
 #include <cyng/store/db.h>
 #include <boost/uuid/uuid.hpp>
+#include <chrono>
 
 namespace node 
 {
@@ -21,7 +22,10 @@ namespace node
 		, boost::asio::ip::tcp::endpoint
 		, std::uint64_t global_config
 		, boost::filesystem::path stat_dir
-		, std::uint64_t max_messages);
+		, std::uint64_t max_messages
+		, std::uint32_t shard_index
+		, cyng::vector_t const& shard_redirect
+		, cyng::vector_t const& shard_global);
 
 	void insert_msg(cyng::store::db&
 		, cyng::logging::severity
@@ -32,13 +36,15 @@ namespace node
 		, cyng::logging::severity
 		, std::string const&
 		, boost::uuids::uuid tag
-		, std::uint64_t max_messages);
+		, std::uint64_t max_messages
+		, std::chrono::system_clock::time_point tp = std::chrono::system_clock::now());
 
 	void insert_ts_event(cyng::store::table* tbl
 		, boost::uuids::uuid tag
 		, std::string const& account
 		, std::string const& evt
-		, cyng::object);
+		, cyng::object
+		, std::chrono::system_clock::time_point tp = std::chrono::system_clock::now());
 
 	void insert_ts_event(cyng::store::db&
 		, boost::uuids::uuid tag
@@ -83,6 +89,31 @@ namespace node
 	cyng::object get_config(cyng::store::db& db, std::string key);
 	cyng::object get_config(cyng::store::table const* tbl, std::string key);
 
+	/**
+	 * In sharded mode accounts are distributed over several
+	 * master nodes by a stable hash (FNV-1a).
+	 *
+	 * @return index of the shard that serves the specified account
+	 */
+	std::uint32_t get_shard(std::string const& account, std::uint32_t count);
+
+	/**
+	 * Uses "shard-index", "shard-redirect" and "shard-global" from "_Config" table.
+	 *
+	 * @return IP-T address (host:port) of the shard that serves the specified
+	 * account or an empty string if the account is served by this master.
+	 */
+	std::string get_shard_redirect(cyng::store::table const* tbl_cfg, std::string const& account);
+
+	/**
+	 * Sessions, targets and channels of other shards are unknown to this
+	 * master. Connections and push channels are not forwarded between
+	 * shards.
+	 *
+	 * @return true if "shard-redirect" contains more than one shard
+	 */
+	bool is_sharded(cyng::store::table const* tbl_cfg);
+
 	/**
 	 * Define configuration bits
 	 */
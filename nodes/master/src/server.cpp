@@ -10,6 +10,8 @@
 #include "db.h"
 #include "connection.h"
 #include <cyng/dom/reader.h>
+#include <cyng/value_cast.hpp>
+#include <cyng/numeric_cast.hpp>
 
 namespace node 
 {
@@ -31,11 +33,21 @@ namespace node
 		, global_configuration_(0)
 		, stat_dir_()
 		, max_messages_(1000u)
+		, shard_index_(0u)
+		, shard_redirect_()
+		, shard_global_()
 		, acceptor_(mux.get_io_service())
 #if (BOOST_VERSION < 106600)
 		, socket_(io_ctx_)
 #endif
 		, db_()
+		, snapshot_(logger
+			, db_
+			, mux.get_io_service()
+			, cyng::value_cast(cyng::make_reader(cfg_session).get("snapshot-dir"), std::string())
+			, std::chrono::seconds(cyng::value_cast(cyng::make_reader(cfg_session).get("snapshot-interval"), 300))
+			, tag)
+		, stats_(logger, db_, mux.get_io_service())
 		, uidgen_()
 	{
 		//
@@ -49,7 +61,7 @@ namespace node
 		set_connection_auto_login(global_configuration_, cyng::value_cast(dom.get("auto-login"), false));
 		set_connection_auto_enabled(global_configuration_, cyng::value_cast(dom.get("auto-enabled"), true));
 		set_connection_superseed(global_configuration_, cyng::value_cast(dom.get("supersede"), true));
-		set_generate_time_series(global_configuration_, cyng::value_cast(dom.get("generate-time-series"), false));
+		set_generate_time_series(global_configuration_, cyng::value_cast(dom.get("generate-time-series"), true));
 		set_catch_meters(global_configuration_, cyng::value_cast(dom.get("catch-meters"), false));
 		set_catch_lora(global_configuration_, cyng::value_cast(dom.get("catch-lora"), false));
 
@@ -64,6 +76,16 @@ namespace node
 		max_messages_ = cyng::value_cast<std::uint64_t>(dom.get("ax-messages"), max_messages_);
 		CYNG_LOG_INFO(logger_, "store max. " << max_messages_ << " messages");
 
+		//
+		//	sharded mode
+		//
+		shard_index_ = cyng::numeric_cast<std::uint32_t>(dom.get("shard-index"), shard_index_);
+		shard_redirect_ = cyng::value_cast(dom.get("shard-redirect"), shard_redirect_);
+		shard_global_ = cyng::value_cast(dom.get("shard-global"), shard_global_);
+		if (shard_redirect_.size() > 1) {
+			CYNG_LOG_INFO(logger_, "shard #" << shard_index_ << " of " << shard_redirect_.size());
+		}
+
 	}
 	
 	void server::run(std::string const& address, std::string const& service)
@@ -98,7 +120,16 @@ namespace node
 				, acceptor_.local_endpoint()
 				, global_configuration_.load()
 				, stat_dir_
-				, max_messages_);
+				, max_messages_
+				, shard_index_
+				, shard_redirect_
+				, shard_global_);
+
+			//
+			//	restore configuration tables
+			//
+			snapshot_.load();
+			snapshot_.start();
 
 			do_accept();
 		}
@@ -148,7 +179,9 @@ namespace node
 					, tag
 					, monitor_ // cluster watchdog
 					, global_configuration_
-					, stat_dir_)->start();
+					, stat_dir_
+					, stats_
+					, snapshot_)->start();
 
 				do_accept();
 			}
@@ -202,6 +235,17 @@ namespace node
 		//
 		mux_.post("node::watchdog", 0, cyng::tuple_factory(tag_));
 
+		//
+		//	drain the stat queue: waits for a scheduled drain
+		//	and writes all pending statistics
+		//
+		stats_.stop();
+
+		//
+		//	write final snapshot
+		//
+		snapshot_.stop();
+
 		// The server is stopped by cancelling all outstanding asynchronous
         // operations. Once all operations have finished the io_context::run()
         // call will exit.
@@ -11,6 +11,8 @@
 #include <cyng/async/mux.h>
 #include <cyng/log.h>
 #include <cyng/store/db.h>
+#include "snapshot.h"
+#include "stat_queue.h"
 #include <unordered_map>
 #include <atomic>
 #include <boost/version.hpp>
@@ -69,6 +71,11 @@ namespace node
 		boost::filesystem::path stat_dir_;
 		std::uint64_t max_messages_;
 
+		//	sharded mode
+		std::uint32_t shard_index_;
+		cyng::vector_t shard_redirect_;	//!<	IP-T address of all shards
+		cyng::vector_t shard_global_;	//!<	accounts served by all shards
+
 		/// Acceptor used to listen for incoming connections.
 		boost::asio::ip::tcp::acceptor acceptor_;		
 
@@ -81,6 +88,16 @@ namespace node
 		 */
 		cyng::store::db	db_;
 
+		/**
+		 * persistence of configuration tables
+		 */
+		snapshot snapshot_;
+
+		/**
+		 * batched writes of statistics and system messages
+		 */
+		stat_queue stats_;
+
 		/**
 		 * generate session tags
 		 */
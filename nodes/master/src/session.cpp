@@ -9,9 +9,11 @@
 #include "session.h"
 #include "client.h"
 #include "db.h"
+#include "snapshot.h"
 #include "tasks/watchdog.h"
 #include <NODE_project_info.h>
 #include <smf/cluster/generator.h>
+#include <smf/cluster/serializer.h>
 #include <smf/ipt/response.hpp>
 
 #include <cyng/vm/domain/log_domain.h>
@@ -40,7 +42,9 @@ namespace node
 		, boost::uuids::uuid stag
 		, std::chrono::seconds monitor
 		, std::atomic<std::uint64_t>& global_configuration
-		, boost::filesystem::path stat_dir )
+		, boost::filesystem::path stat_dir
+		, stat_queue& stats
+		, snapshot& snap)
 	: mux_(mux)
 		, logger_(logger)
 		, mtag_(mtag)
@@ -58,12 +62,13 @@ namespace node
 		, pwd_(pwd)
 		, cluster_monitor_(monitor)
 		, seq_(0)
-		, client_(mux, logger, db, global_configuration, stag, stat_dir)
+		, client_(mux, logger, db, global_configuration, stag, stat_dir, stats)
 		, cluster_(mux, logger, db, global_configuration)
 		, subscriptions_()
 		, tsk_watchdog_(cyng::async::NO_TASK)
 		, group_(0)
 		, cluster_tag_(boost::uuids::nil_uuid())
+		, snapshot_(snap)
 	{
 		//
 		//	register logger domain
@@ -396,7 +401,8 @@ namespace node
 				, std::get<8>(tpl)
 				, std::get<9>(tpl)
 				, "unknown"
-				, 0);
+				, 0
+				, "");
 		}
 		else
 		{
@@ -415,7 +421,8 @@ namespace node
 				std::uint32_t,			//	[8] group
 				boost::asio::ip::tcp::endpoint,	//	[9] remote ep
 				std::string,				//	[10] platform
-				boost::process::pid_t		//	[11] process id
+				boost::process::pid_t,		//	[11] process id
+				std::string					//	[12] compression (optional)
 			>(frame);
 
 			BOOST_ASSERT_MSG(std::get<0>(tpl) > cyng::version(0, 3), "version 0.4 or higher expected");
@@ -432,7 +439,8 @@ namespace node
 				, std::get<8>(tpl)
 				, std::get<9>(tpl)
 				, std::get<10>(tpl)
-				, std::get<11>(tpl));
+				, std::get<11>(tpl)
+				, std::get<12>(tpl));
 		}
 	}
 
@@ -448,7 +456,8 @@ namespace node
 		, std::uint32_t group
 		, boost::asio::ip::tcp::endpoint ep
 		, std::string platform
-		, boost::process::pid_t pid)
+		, boost::process::pid_t pid
+		, std::string const& compression)
 	{
 		//
 		//	ToDo: check for duplicate tags
@@ -490,6 +499,8 @@ namespace node
 			//
 			ctx.queue(cyng::register_function("bus.req.subscribe", 3, std::bind(&session::bus_req_subscribe, this, std::placeholders::_1)));
 			ctx.queue(cyng::register_function("bus.req.unsubscribe", 2, std::bind(&session::bus_req_unsubscribe, this, std::placeholders::_1)));
+			ctx.queue(cyng::register_function("bus.req.db.merge", 5, std::bind(&session::bus_req_db_merge, this, std::placeholders::_1)));
+			ctx.queue(cyng::register_function("bus.req.db.reconcile", 1, std::bind(&session::bus_req_db_reconcile, this, std::placeholders::_1)));
 			ctx.queue(cyng::register_function("bus.start.watchdog", 7, std::bind(&session::bus_start_watchdog, this, std::placeholders::_1)));
 
 			//
@@ -512,10 +523,18 @@ namespace node
 				, ep
 				, pid));
 
+			//
+			//	compress large frames if supported by the client
+			//
+			bool const compress = boost::algorithm::contains(compression, cluster_compression);
+
 			//
 			//	send reply
 			//
-			ctx.queue(reply(ts, true));
+			ctx.queue(reply(ts, true, compress ? cluster_compression : ""));
+			if (compress) {
+				ctx.queue(cyng::generate_invoke("stream.compress", static_cast<std::uint64_t>(cluster_compression_threshold)));
+			}
 
 		}
 		else
@@ -530,7 +549,7 @@ namespace node
 			//
 			//	send reply
 			//
-			ctx.queue(reply(ts, false));
+			ctx.queue(reply(ts, false, ""));
 
 			//
 			//	emit system message
@@ -915,11 +934,25 @@ namespace node
 
 		ctx.queue(cyng::generate_invoke("log.msg.info", "bus.req.subscribe", std::get<0>(tpl), std::get<1>(tpl)));
 
+		//
+		//	The setup node owns the configuration tables. Records restored
+		//	from the snapshot are not sent to the setup node. Otherwise records
+		//	that were deleted in the meantime would be written back into the
+		//	database of the setup node. The setup node uploads them with the
+		//	current values (bus.req.db.merge) and the remaining records are
+		//	removed after the upload (bus.req.db.reconcile).
+		//
+		bool const setup = boost::algorithm::equals(client_.get_class(), "setup");
+
 		db_.access([&](cyng::store::table const* tbl)->void {
 
 			CYNG_LOG_INFO(logger_, tbl->meta().get_name() << "->size(" << tbl->size() << ")");
 			tbl->loop([&](cyng::table::record const& rec) -> bool {
 
+				if (setup && snapshot_.is_restored(tbl->meta().get_name(), rec.key())) {
+					return true;
+				}
+
 #ifdef _DEBUG
 				if (boost::algorithm::equals(tbl->meta().get_name(), "TLoRaDevice")) {
 					BOOST_ASSERT_MSG(rec.data().at(0).get_class().tag() == cyng::TC_MAC64, "DevEUI has wrong data type");
@@ -954,6 +987,54 @@ namespace node
 
 	}
 
+	void session::bus_req_db_merge(cyng::context& ctx)
+	{
+		const cyng::vector_t frame = ctx.get_frame();
+
+		auto const tpl = cyng::tuple_cast<
+			std::string,			//	[0] table name
+			cyng::table::key_type,	//	[1] table key
+			cyng::table::data_type,	//	[2] record
+			std::uint64_t,			//	[3] generation
+			boost::uuids::uuid		//	[4] source
+		>(frame);
+
+		db_.access([&](cyng::store::table* tbl)->void {
+
+			if (!tbl->insert(std::get<1>(tpl), std::get<2>(tpl), std::get<3>(tpl), std::get<4>(tpl))) {
+
+				//
+				//	record exists (restored from snapshot) - update changed columns only
+				//
+				auto const rec = tbl->lookup(std::get<1>(tpl));
+				auto const& data = std::get<2>(tpl);
+				if (!rec.empty() && rec.data().size() == data.size()) {
+					for (std::size_t idx = 0; idx < data.size(); ++idx) {
+						if (cyng::io::to_str(rec.data().at(idx)) != cyng::io::to_str(data.at(idx))) {
+							tbl->modify(std::get<1>(tpl), cyng::attr_t(idx, data.at(idx)), std::get<4>(tpl));
+						}
+					}
+				}
+			}
+		}, cyng::store::write_access(std::get<0>(tpl)));
+
+		snapshot_.confirm(std::get<0>(tpl), std::get<1>(tpl));
+	}
+
+	void session::bus_req_db_reconcile(cyng::context& ctx)
+	{
+		const cyng::vector_t frame = ctx.get_frame();
+		auto const table = cyng::value_cast<std::string>(frame.at(0), "");
+
+		//
+		//	upload of the setup node is complete
+		//
+		auto const count = snapshot_.reconcile(table);
+		if (count != 0) {
+			CYNG_LOG_INFO(logger_, "setup node removed " << count << " restored records of table " << table);
+		}
+	}
+
 	void session::bus_req_unsubscribe(cyng::context& ctx)
 	{
 		const cyng::vector_t frame = ctx.get_frame();
@@ -967,7 +1048,7 @@ namespace node
 		cyng::store::close_subscription(subscriptions_, std::get<0>(tpl));
 	}
 
-	cyng::vector_t session::reply(std::chrono::system_clock::time_point ts, bool success)
+	cyng::vector_t session::reply(std::chrono::system_clock::time_point ts, bool success, std::string const& compression)
 	{
 		cyng::vector_t prg;
 		prg << cyng::generate_invoke_unwinded("stream.serialize"
@@ -976,7 +1057,8 @@ namespace node
 				, cyng::code::IDENT
 				, cyng::version(NODE_VERSION_MAJOR, NODE_VERSION_MINOR)
 				, ts	//	timestamp of sender
-				, std::chrono::system_clock::now()));
+				, std::chrono::system_clock::now()
+				, compression));
 		prg
 			<< cyng::generate_invoke_unwinded("stream.flush")
 			;
@@ -1000,8 +1082,7 @@ namespace node
 			std::string					//	[2] msg
 		>(frame);
 
-		insert_msg(db_
-			, std::get<1>(tpl)
+		client_.write_msg(std::get<1>(tpl)
 			, std::get<2>(tpl)
 			, ctx.tag());
 	}
@@ -1119,10 +1200,12 @@ namespace node
 		, boost::uuids::uuid stag
 		, std::chrono::seconds monitor //	cluster watchdog
 		, std::atomic<std::uint64_t>& global_configuration
-		, boost::filesystem::path stat_dir)
+		, boost::filesystem::path stat_dir
+		, stat_queue& stats
+		, snapshot& snap)
 	{
 		return cyng::make_object<session>(mux, logger, mtag, db, account, pwd, stag, monitor
-			, global_configuration, stat_dir);
+			, global_configuration, stat_dir, stats, snap);
 	}
 
 }
@@ -22,6 +22,7 @@ namespace node
 {
 	class connection;
 	class watchdog;
+	class snapshot;
 	class session
 	{
 		friend class connection;
@@ -39,7 +40,9 @@ namespace node
 			, boost::uuids::uuid stag
 			, std::chrono::seconds monitor
 			, std::atomic<std::uint64_t>& global_configuration
-			, boost::filesystem::path);
+			, boost::filesystem::path
+			, stat_queue&
+			, snapshot&);
 
 		session(session const&) = delete;
 		session& operator=(session const&) = delete;
@@ -72,9 +75,12 @@ namespace node
 			, std::uint32_t			//	[8] group
 			, boost::asio::ip::tcp::endpoint	//	[9] remote ep
 			, std::string				//	[10] platform
-			, boost::process::pid_t);
+			, boost::process::pid_t		//	[11] process id
+			, std::string const&);		//	[12] compression
 		void bus_req_subscribe(cyng::context& ctx);
 		void bus_req_unsubscribe(cyng::context& ctx);
+		void bus_req_db_merge(cyng::context& ctx);
+		void bus_req_db_reconcile(cyng::context& ctx);
 		void bus_start_watchdog(cyng::context& ctx);
 		void res_watchdog(cyng::context& ctx);
 		void bus_req_stop_client_impl(cyng::context& ctx);
@@ -85,7 +91,10 @@ namespace node
 		void bus_req_push_data(cyng::context& ctx);
 		void bus_insert_lora_uplink(cyng::context& ctx);
 
-		cyng::vector_t reply(std::chrono::system_clock::time_point, bool);
+		/**
+		 * @param compression accepted compression method or empty
+		 */
+		cyng::vector_t reply(std::chrono::system_clock::time_point, bool, std::string const& compression);
 
 		void sig_ins(cyng::store::table const*
 			, cyng::table::key_type const&
@@ -156,6 +165,11 @@ namespace node
 		 */
 		boost::uuids::uuid cluster_tag_;
 
+		/**
+		 * restored records of the configuration tables
+		 */
+		snapshot& snapshot_;
+
 	};
 
 	cyng::object make_session(cyng::async::mux& mux
@@ -167,7 +181,9 @@ namespace node
 		, boost::uuids::uuid stag
 		, std::chrono::seconds monitor //	cluster watchdog
 		, std::atomic<std::uint64_t>& global_configuration
-		, boost::filesystem::path);
+		, boost::filesystem::path
+		, stat_queue&
+		, snapshot&);
 }
 
 #include <cyng/intrinsics/traits.hpp>
@@ -0,0 +1,678 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#include "snapshot.h"
+#include <cyng/io/serializer.h>
+#include <cyng/io/parser/parser.h>
+#include <cyng/value_cast.hpp>
+#include <cyng/numeric_cast.hpp>
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/algorithm/string/predicate.hpp>
+
+namespace node
+{
+	namespace
+	{
+		std::string const magic = "smf-snapshot";
+		std::uint32_t const format_version = 1;
+
+		/**
+		 * log entry types
+		 */
+		enum op : std::uint8_t
+		{
+			OP_INSERT = 1,
+			OP_MODIFY = 2,
+			OP_ERASE = 3,
+			OP_CLEAR = 4,
+		};
+
+		template <typename T>
+		void write_value(std::ostream& os, T&& v)
+		{
+			cyng::io::serialize_binary(os, cyng::make_object(std::forward<T>(v)));
+		}
+
+		void write_values(std::ostream& os, cyng::vector_t const& vec)
+		{
+			write_value(os, static_cast<std::uint32_t>(vec.size()));
+			for (auto const& obj : vec) {
+				cyng::io::serialize_binary(os, obj);
+			}
+		}
+
+		/**
+		 * chunk size to decode mapped files
+		 */
+		std::size_t const chunk_size = 64 * 1024;
+
+		/**
+		 * Map the file into memory and decode it in chunks. After each
+		 * chunk the consumer is called with all decoded objects that are
+		 * not consumed yet. The consumer advances the position behind the
+		 * last complete entry. Consumed objects are discarded.
+		 *
+		 * @return objects of an incomplete entry at the end of the file
+		 */
+		template <typename F>
+		std::size_t read_objects(boost::filesystem::path const& p, F consume)
+		{
+			boost::system::error_code ec;
+			if (boost::filesystem::file_size(p, ec) == 0 || ec)	return 0;
+
+			boost::interprocess::file_mapping fm(p.string().c_str(), boost::interprocess::read_only);
+			boost::interprocess::mapped_region region(fm, boost::interprocess::read_only);
+			region.advise(boost::interprocess::mapped_region::advice_sequential);
+
+			cyng::vector_t objs;
+			cyng::parser parser([&objs](cyng::vector_t&& prg) {
+				objs.insert(objs.end(), std::make_move_iterator(prg.begin()), std::make_move_iterator(prg.end()));
+			});
+
+			auto const begin = static_cast<char const*>(region.get_address());
+			auto const size = region.get_size();
+			for (std::size_t offset = 0; offset < size; offset += chunk_size) {
+				parser.read(begin + offset, begin + std::min(offset + chunk_size, size));
+
+				std::size_t pos = 0;
+				bool const proceed = consume(objs, pos);
+				objs.erase(objs.begin(), objs.begin() + pos);
+				if (!proceed)	break;
+			}
+			return objs.size();
+		}
+
+		/**
+		 * Read a size prefixed sequence of objects.
+		 *
+		 * @return false if the sequence is incomplete
+		 */
+		bool read_values(cyng::vector_t const& objs, std::size_t& pos, cyng::vector_t& vec)
+		{
+			if (pos >= objs.size())	return false;
+			auto const size = cyng::numeric_cast<std::uint32_t>(objs.at(pos), 0u);
+			if (pos + 1 + size > objs.size())	return false;
+			vec.assign(objs.begin() + pos + 1, objs.begin() + pos + 1 + size);
+			pos += 1 + size;
+			return true;
+		}
+
+		std::string log_name(std::uint64_t seq)
+		{
+			std::stringstream ss;
+			ss
+				<< "master-"
+				<< std::setw(8)
+				<< std::setfill('0')
+				<< seq
+				<< ".wal"
+				;
+			return ss.str();
+		}
+	}
+
+	snapshot::snapshot(cyng::logging::log_ptr logger
+		, cyng::store::db& db
+		, cyng::io_service_t& ios
+		, boost::filesystem::path const& dir
+		, std::chrono::seconds interval
+		, boost::uuids::uuid tag)
+	: logger_(logger)
+		, db_(db)
+		, timer_(ios)
+		, flush_timer_(ios)
+		, dir_(dir)
+		, interval_(interval)
+		, tag_(tag)
+		, subscriptions_()
+		, log_()
+		, seq_(0)
+		, changes_(0)
+		, dirty_(false)
+		, writing_(false)
+		, stopped_(false)
+		, restored_()
+		, mutex_()
+	{}
+
+	std::size_t snapshot::load()
+	{
+		if (dir_.empty())	return 0;
+
+		boost::system::error_code ec;
+		boost::filesystem::create_directories(dir_, ec);
+		if (ec) {
+			CYNG_LOG_ERROR(logger_, "cannot create snapshot directory " << dir_ << ": " << ec.message());
+			return 0;
+		}
+
+		auto const start = std::chrono::steady_clock::now();
+
+		std::uint64_t seq = 0;
+		std::size_t count = 0;
+		auto const path = dir_ / "master.snapshot";
+		if (boost::filesystem::exists(path, ec)) {
+			count = load_snapshot(path, seq);
+		}
+
+		std::size_t replayed = 0;
+		for (auto const& log : get_logs(seq)) {
+			replayed += replay_log(log.second);
+			seq = log.first;
+		}
+
+		CYNG_LOG_INFO(logger_, "restored "
+			<< count
+			<< " records and "
+			<< replayed
+			<< " changes from "
+			<< dir_
+			<< " in "
+			<< std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count()
+			<< " ms");
+
+		cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+		seq_ = seq;
+		changes_ = replayed;
+		return count + replayed;
+	}
+
+	void snapshot::start()
+	{
+		if (dir_.empty())	return;
+
+		for (auto const& name : journaled_tables()) {
+			db_.access([&](cyng::store::table* tbl)->void {
+				cyng::store::add_subscription(subscriptions_
+					, name
+					, tbl->get_listener(std::bind(&snapshot::sig_ins, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4, std::placeholders::_5)
+						, std::bind(&snapshot::sig_del, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3)
+						, std::bind(&snapshot::sig_clr, this, std::placeholders::_1, std::placeholders::_2)
+						, std::bind(&snapshot::sig_mod, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4, std::placeholders::_5)));
+			}, cyng::store::write_access(name));
+		}
+
+		bool compact = false;
+		{
+			cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+			compact = (changes_ != 0);
+			if (!compact) {
+				open_log(++seq_);
+			}
+		}
+
+		//
+		//	merge replayed changes into a new snapshot
+		//
+		if (compact) {
+			write();
+		}
+		set_timer();
+		set_flush_timer();
+	}
+
+	void snapshot::stop()
+	{
+		if (dir_.empty())	return;
+
+		{
+			cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+			if (stopped_)	return;
+			boost::system::error_code ec;
+			timer_.cancel(ec);
+			flush_timer_.cancel(ec);
+		}
+
+		cyng::store::close_subscription(subscriptions_);
+
+		//
+		//	next start doesn't need to replay anything
+		//
+		write();
+
+		cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+		stopped_ = true;
+		log_.close();
+	}
+
+	void snapshot::write()
+	{
+		std::uint64_t seq = 0;
+		{
+			cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+			if (writing_ || stopped_)	return;
+			writing_ = true;
+
+			//
+			//	all changes from now on go into the next log file
+			//
+			seq = ++seq_;
+			open_log(seq);
+			changes_ = 0;
+		}
+
+		auto const start = std::chrono::steady_clock::now();
+		auto const tmp = dir_ / "master.snapshot.tmp";
+		std::size_t count = 0;
+
+		std::ofstream ofs(tmp.string(), std::ios::binary | std::ios::trunc);
+		if (ofs.is_open()) {
+
+			write_value(ofs, magic);
+			write_value(ofs, format_version);
+			write_value(ofs, seq);
+
+			//
+			//	Records modified while the snapshot is written are also
+			//	in the new log. Replaying them is idempotent.
+			//
+			for (auto const& name : journaled_tables()) {
+				db_.access([&](cyng::store::table const* tbl)->void {
+					write_value(ofs, name);
+					write_value(ofs, static_cast<std::uint64_t>(tbl->size()));
+					tbl->loop([&](cyng::table::record const& rec) -> bool {
+						write_values(ofs, rec.key());
+						write_values(ofs, rec.data());
+						write_value(ofs, rec.get_generation());
+						++count;
+						return true;
+					});
+				}, cyng::store::read_access(name));
+			}
+			ofs.close();
+		}
+
+		boost::system::error_code ec;
+		if (!ofs.fail()) {
+			boost::filesystem::rename(tmp, dir_ / "master.snapshot", ec);
+		}
+		else {
+			CYNG_LOG_ERROR(logger_, "cannot write snapshot " << tmp);
+			boost::filesystem::remove(tmp, ec);
+		}
+
+		if (!ec && !ofs.fail()) {
+
+			//
+			//	remove obsolete log files
+			//
+			for (auto const& log : get_logs(0)) {
+				if (log.first < seq) {
+					boost::filesystem::remove(log.second, ec);
+				}
+			}
+
+			CYNG_LOG_INFO(logger_, "snapshot #"
+				<< seq
+				<< " with "
+				<< count
+				<< " records written in "
+				<< std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count()
+				<< " ms");
+		}
+
+		cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+		writing_ = false;
+	}
+
+	void snapshot::on_timer(boost::system::error_code const& ec)
+	{
+		if (ec == boost::asio::error::operation_aborted)	return;
+
+		bool pending = false;
+		{
+			cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+			if (stopped_)	return;
+			pending = (changes_ != 0);
+		}
+
+		if (pending) {
+			write();
+		}
+		set_timer();
+	}
+
+	void snapshot::set_timer()
+	{
+		timer_.expires_after(interval_);
+		timer_.async_wait(std::bind(&snapshot::on_timer, this, std::placeholders::_1));
+	}
+
+	void snapshot::on_flush(boost::system::error_code const& ec)
+	{
+		if (ec == boost::asio::error::operation_aborted)	return;
+
+		{
+			cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+			if (stopped_)	return;
+			if (dirty_) {
+				log_.flush();
+				dirty_ = false;
+			}
+		}
+		set_flush_timer();
+	}
+
+	void snapshot::set_flush_timer()
+	{
+		flush_timer_.expires_after(std::chrono::seconds(1));
+		flush_timer_.async_wait(std::bind(&snapshot::on_flush, this, std::placeholders::_1));
+	}
+
+	bool snapshot::is_restored(std::string const& table, cyng::table::key_type const& key)
+	{
+		cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+		auto pos = restored_.find(table);
+		return (pos != restored_.end())
+			&& (pos->second.find(cyng::io::to_str(key)) != pos->second.end())
+			;
+	}
+
+	void snapshot::confirm(std::string const& table, cyng::table::key_type const& key)
+	{
+		cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+		restored(table, key, false);
+	}
+
+	std::size_t snapshot::reconcile(std::string const& table)
+	{
+		std::map<std::string, cyng::table::key_type> keys;
+		{
+			cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+			auto pos = restored_.find(table);
+			if (pos == restored_.end())	return 0;
+			keys.swap(pos->second);
+			restored_.erase(pos);
+		}
+
+		std::size_t count = 0;
+		db_.access([&](cyng::store::table* tbl)->void {
+			for (auto const& key : keys) {
+				if (tbl->erase(key.second, tag_))	++count;
+			}
+		}, cyng::store::write_access(table));
+		return count;
+	}
+
+	void snapshot::restored(std::string const& table, cyng::table::key_type const& key, bool b)
+	{
+		if (b) {
+			restored_[table].emplace(cyng::io::to_str(key), key);
+		}
+		else {
+			auto pos = restored_.find(table);
+			if (pos != restored_.end())	pos->second.erase(cyng::io::to_str(key));
+		}
+	}
+
+	void snapshot::open_log(std::uint64_t seq)
+	{
+		if (log_.is_open())	log_.close();
+		dirty_ = false;
+		auto const p = dir_ / log_name(seq);
+		log_.open(p.string(), std::ios::binary | std::ios::app);
+		if (!log_.is_open()) {
+			CYNG_LOG_ERROR(logger_, "cannot open snapshot log " << p);
+		}
+	}
+
+	std::size_t snapshot::load_snapshot(boost::filesystem::path const& p, std::uint64_t& seq)
+	{
+		bool header = false;
+		bool valid = true;
+		std::string name;
+		std::uint64_t remaining = 0;
+		std::size_t total = 0;
+		cyng::table::key_type key;
+		cyng::table::data_type data;
+
+		auto const consume = [&](cyng::vector_t const& objs, std::size_t& pos) -> bool {
+
+			if (!header) {
+				if (objs.size() < 3)	return true;
+				if (cyng::value_cast(objs.at(0), std::string()) != magic) {
+					CYNG_LOG_ERROR(logger_, "invalid snapshot " << p);
+					valid = false;
+					return false;
+				}
+				auto const version = cyng::numeric_cast<std::uint32_t>(objs.at(1), 0u);
+				if (version != format_version) {
+					CYNG_LOG_WARNING(logger_, "snapshot " << p << " has unsupported version " << version);
+					valid = false;
+					return false;
+				}
+				seq = cyng::numeric_cast<std::uint64_t>(objs.at(2), 0u);
+				pos = 3;
+				header = true;
+			}
+
+			for (;;) {
+				if (remaining == 0) {
+					if (pos + 2 > objs.size())	return true;
+					name = cyng::value_cast(objs.at(pos), std::string());
+					remaining = cyng::numeric_cast<std::uint64_t>(objs.at(pos + 1), 0u);
+					pos += 2;
+					continue;
+				}
+
+				//
+				//	bulk insert of all complete records with one lock
+				//
+				db_.access([&](cyng::store::table* tbl)->void {
+					while (remaining != 0) {
+						auto next = pos;
+						if (!read_values(objs, next, key) || !read_values(objs, next, data) || next >= objs.size())	break;
+						auto const gen = cyng::numeric_cast<std::uint64_t>(objs.at(next++), 0u);
+						if (!tbl->insert(key, data, gen, tag_)) {
+
+							//
+							//	replace records from initialization
+							//
+							tbl->erase(key, tag_);
+							tbl->insert(key, data, gen, tag_);
+						}
+						restored(name, key, true);
+						pos = next;
+						--remaining;
+						++total;
+					}
+				}, cyng::store::write_access(name));
+
+				if (remaining != 0)	return true;
+				CYNG_LOG_TRACE(logger_, "table " << name << " restored");
+			}
+		};
+
+		std::size_t rest = 0;
+		try {
+			rest = read_objects(p, consume);
+		}
+		catch (std::exception const& ex) {
+			CYNG_LOG_ERROR(logger_, "cannot map snapshot " << p << ": " << ex.what());
+			return total;
+		}
+
+		if (!valid)	return 0;
+		if (!header) {
+			CYNG_LOG_ERROR(logger_, "invalid snapshot " << p);
+		}
+		else if (rest != 0 || remaining != 0) {
+			CYNG_LOG_WARNING(logger_, "snapshot " << p << " is truncated at table " << name);
+		}
+		return total;
+	}
+
+	std::size_t snapshot::replay_log(boost::filesystem::path const& p)
+	{
+		std::size_t count = 0;
+		cyng::table::key_type key;
+		cyng::table::data_type data;
+
+		auto const consume = [&](cyng::vector_t const& objs, std::size_t& pos) -> bool {
+
+			for (;;) {
+				auto next = pos;
+				if (next + 2 > objs.size())	return true;
+
+				auto const code = cyng::numeric_cast<std::uint8_t>(objs.at(next), 0u);
+				auto const name = cyng::value_cast(objs.at(next + 1), std::string());
+				next += 2;
+
+				if (code == OP_CLEAR) {
+					db_.access([&](cyng::store::table* tbl)->void {
+						tbl->clear(tag_);
+					}, cyng::store::write_access(name));
+					restored_.erase(name);
+				}
+				else {
+					if (!read_values(objs, next, key))	return true;
+
+					if (code == OP_INSERT) {
+						if (!read_values(objs, next, data) || next >= objs.size())	return true;
+						auto const gen = cyng::numeric_cast<std::uint64_t>(objs.at(next++), 0u);
+						db_.access([&](cyng::store::table* tbl)->void {
+							if (!tbl->insert(key, data, gen, tag_)) {
+								tbl->erase(key, tag_);
+								tbl->insert(key, data, gen, tag_);
+							}
+						}, cyng::store::write_access(name));
+						restored(name, key, true);
+					}
+					else if (code == OP_MODIFY) {
+						if (next + 3 > objs.size())	return true;
+						auto const idx = cyng::numeric_cast<std::uint64_t>(objs.at(next), 0u);
+						auto const value = objs.at(next + 1);
+						next += 3;	//	generation is maintained by the table
+						db_.access([&](cyng::store::table* tbl)->void {
+							tbl->modify(key, cyng::attr_t(static_cast<std::size_t>(idx), value), tag_);
+						}, cyng::store::write_access(name));
+					}
+					else if (code == OP_ERASE) {
+						db_.access([&](cyng::store::table* tbl)->void {
+							tbl->erase(key, tag_);
+						}, cyng::store::write_access(name));
+						restored(name, key, false);
+					}
+					else {
+						CYNG_LOG_ERROR(logger_, "snapshot log " << p << " contains invalid entry #" << count);
+						return false;
+					}
+				}
+				pos = next;
+				++count;
+			}
+		};
+
+		std::size_t rest = 0;
+		try {
+			rest = read_objects(p, consume);
+		}
+		catch (std::exception const& ex) {
+			CYNG_LOG_ERROR(logger_, "cannot map snapshot log " << p << ": " << ex.what());
+			return count;
+		}
+
+		if (rest != 0) {
+			CYNG_LOG_WARNING(logger_, "snapshot log " << p << " is truncated after " << count << " entries");
+		}
+		return count;
+	}
+
+	std::vector<std::pair<std::uint64_t, boost::filesystem::path>> snapshot::get_logs(std::uint64_t seq) const
+	{
+		std::vector<std::pair<std::uint64_t, boost::filesystem::path>> logs;
+
+		boost::system::error_code ec;
+		for (auto pos = boost::filesystem::directory_iterator(dir_, ec); !ec && pos != boost::filesystem::directory_iterator(); pos.increment(ec)) {
+			auto const name = pos->path().filename().string();
+			if (boost::algorithm::starts_with(name, "master-") && boost::algorithm::ends_with(name, ".wal")) {
+				try {
+					auto const n = std::stoull(name.substr(7, name.size() - 11));
+					if (n >= seq) {
+						logs.emplace_back(n, pos->path());
+					}
+				}
+				catch (std::exception const&) {}
+			}
+		}
+		std::sort(logs.begin(), logs.end());
+		return logs;
+	}
+
+	void snapshot::sig_ins(cyng::store::table const* tbl
+		, cyng::table::key_type const& key
+		, cyng::table::data_type const& data
+		, std::uint64_t gen
+		, boost::uuids::uuid)
+	{
+		cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+		if (!log_.is_open())	return;
+		write_value(log_, static_cast<std::uint8_t>(OP_INSERT));
+		write_value(log_, tbl->meta().get_name());
+		write_values(log_, key);
+		write_values(log_, data);
+		write_value(log_, gen);
+		dirty_ = true;
+		++changes_;
+	}
+
+	void snapshot::sig_del(cyng::store::table const* tbl, cyng::table::key_type const& key, boost::uuids::uuid)
+	{
+		cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+		if (!log_.is_open())	return;
+		write_value(log_, static_cast<std::uint8_t>(OP_ERASE));
+		write_value(log_, tbl->meta().get_name());
+		write_values(log_, key);
+		dirty_ = true;
+		++changes_;
+	}
+
+	void snapshot::sig_clr(cyng::store::table const* tbl, boost::uuids::uuid)
+	{
+		cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+		if (!log_.is_open())	return;
+		write_value(log_, static_cast<std::uint8_t>(OP_CLEAR));
+		write_value(log_, tbl->meta().get_name());
+		dirty_ = true;
+		++changes_;
+	}
+
+	void snapshot::sig_mod(cyng::store::table const* tbl
+		, cyng::table::key_type const& key
+		, cyng::attr_t const& attr
+		, std::uint64_t gen
+		, boost::uuids::uuid)
+	{
+		cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+		if (!log_.is_open())	return;
+		write_value(log_, static_cast<std::uint8_t>(OP_MODIFY));
+		write_value(log_, tbl->meta().get_name());
+		write_values(log_, key);
+		write_value(log_, static_cast<std::uint64_t>(attr.first));
+		cyng::io::serialize_binary(log_, attr.second);
+		write_value(log_, gen);
+		dirty_ = true;
+		++changes_;
+	}
+
+	std::vector<std::string> const& journaled_tables()
+	{
+		//
+		//	Configuration data uploaded by the setup node.
+		//	Runtime tables like _Session reference live cluster
+		//	sessions and are rebuilt by the cluster members.
+		//
+		static std::vector<std::string> const tables{ "TDevice", "TGateway", "TMeter", "TLoRaDevice", "TLL" };
+		return tables;
+	}
+}
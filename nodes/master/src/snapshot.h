@@ -0,0 +1,190 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#ifndef NODE_MASTER_SNAPSHOT_H
+#define NODE_MASTER_SNAPSHOT_H
+
+#include <cyng/log.h>
+#include <cyng/store/db.h>
+#include <cyng/compatibility/io_service.h>
+#include <cyng/compatibility/async.h>
+
+#include <chrono>
+#include <fstream>
+#include <map>
+
+#include <boost/filesystem.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+namespace node
+{
+	/**
+	 * Persists tables of the master store in a compact binary format.
+	 *
+	 * A snapshot file contains all records of the journaled tables.
+	 * All changes after a snapshot are appended to a write-ahead log.
+	 * Each snapshot starts a new log file, older log files are removed
+	 * after the snapshot was written.
+	 *
+	 * Both file types are sequences of binary serialized objects:
+	 * <pre>
+	 * snapshot: "smf-snapshot" version seq (table count (key-size key* body-size data* gen)*)*
+	 * log:      (op table [key-size key* [body-size data* gen | idx value gen]])*
+	 * </pre>
+	 * At startup the snapshot is memory mapped and decoded in chunks.
+	 * Complete records are inserted after each chunk, so only a chunk
+	 * and an incomplete record are held in memory. Then the log files
+	 * are replayed the same way.
+	 *
+	 * Changes are buffered and the log is flushed once per second.
+	 *
+	 * Restored records are remembered until the setup node has uploaded
+	 * the table. They are not sent to the setup node when it subscribes,
+	 * so the setup node uploads all records of its database. Uploaded
+	 * records replace the restored values. After the upload is complete
+	 * all restored records that were not uploaded are removed.
+	 *
+	 * Only configuration tables are journaled. Runtime tables like _Session,
+	 * _Target and _Channel refer to live sessions of the cluster members
+	 * and are rebuilt when the members log in again.
+	 */
+	class snapshot
+	{
+	public:
+		snapshot(cyng::logging::log_ptr
+			, cyng::store::db&
+			, cyng::io_service_t&
+			, boost::filesystem::path const& dir
+			, std::chrono::seconds interval
+			, boost::uuids::uuid tag);
+
+		/**
+		 * Load snapshot and replay log files.
+		 *
+		 * @return number of restored records
+		 */
+		std::size_t load();
+
+		/**
+		 * Subscribe journaled tables and start timer.
+		 * Call after load().
+		 */
+		void start();
+
+		/**
+		 * Write a final snapshot and close subscriptions.
+		 */
+		void stop();
+
+		/**
+		 * Write a snapshot of all journaled tables now.
+		 */
+		void write();
+
+		/**
+		 * @return true if the record was restored at startup and
+		 * not uploaded by the setup node yet.
+		 */
+		bool is_restored(std::string const& table, cyng::table::key_type const&);
+
+		/**
+		 * The setup node uploaded the specified record.
+		 */
+		void confirm(std::string const& table, cyng::table::key_type const&);
+
+		/**
+		 * Remove all records of the specified table that were restored
+		 * at startup and not uploaded by the setup node. Call after the
+		 * upload is complete.
+		 *
+		 * @return number of removed records
+		 */
+		std::size_t reconcile(std::string const& table);
+
+	private:
+		void on_timer(boost::system::error_code const&);
+		void set_timer();
+		void on_flush(boost::system::error_code const&);
+		void set_flush_timer();
+
+		/**
+		 * Open a new log file with the specified sequence number. Requires lock.
+		 */
+		void open_log(std::uint64_t seq);
+
+		std::size_t load_snapshot(boost::filesystem::path const&, std::uint64_t& seq);
+		std::size_t replay_log(boost::filesystem::path const&);
+
+		/**
+		 * Bookkeeping of restored records. Requires lock
+		 * after the tables are subscribed.
+		 */
+		void restored(std::string const& table, cyng::table::key_type const&, bool);
+
+		/**
+		 * @return all log files with a sequence number equal or
+		 * higher than the specified value - in ascending order
+		 */
+		std::vector<std::pair<std::uint64_t, boost::filesystem::path>> get_logs(std::uint64_t seq) const;
+
+		void sig_ins(cyng::store::table const*
+			, cyng::table::key_type const&
+			, cyng::table::data_type const&
+			, std::uint64_t
+			, boost::uuids::uuid);
+		void sig_del(cyng::store::table const*, cyng::table::key_type const&, boost::uuids::uuid);
+		void sig_clr(cyng::store::table const*, boost::uuids::uuid);
+		void sig_mod(cyng::store::table const*
+			, cyng::table::key_type const&
+			, cyng::attr_t const&
+			, std::uint64_t
+			, boost::uuids::uuid);
+
+	private:
+		cyng::logging::log_ptr logger_;
+		cyng::store::db& db_;
+		boost::asio::steady_timer timer_;
+		boost::asio::steady_timer flush_timer_;
+		boost::filesystem::path const dir_;
+		std::chrono::seconds const interval_;
+		boost::uuids::uuid const tag_;
+
+		cyng::store::subscriptions_t subscriptions_;
+
+		/**
+		 * current log file
+		 */
+		std::ofstream log_;
+		std::uint64_t seq_;
+
+		/**
+		 * changes since last snapshot
+		 */
+		std::size_t changes_;
+
+		/**
+		 * log contains unflushed changes
+		 */
+		bool dirty_;
+		bool writing_;
+		bool stopped_;
+
+		/**
+		 * restored keys by table - not reconciled yet
+		 */
+		std::map<std::string, std::map<std::string, cyng::table::key_type>> restored_;
+
+		cyng::async::mutex mutex_;
+	};
+
+	/**
+	 * @return names of all tables that are written into snapshots
+	 */
+	std::vector<std::string> const& journaled_tables();
+}
+
+#endif
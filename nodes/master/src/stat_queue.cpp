@@ -0,0 +1,173 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#include "stat_queue.h"
+#include "db.h"
+#include <cyng/value_cast.hpp>
+#include <cyng/table/key.hpp>
+
+#include <boost/asio/post.hpp>
+#include <thread>
+
+namespace node
+{
+	stat_queue::stat_queue(cyng::logging::log_ptr logger, cyng::store::db& db, cyng::io_service_t& ios)
+		: logger_(logger)
+		, db_(db)
+		, ios_(ios)
+		, head_(nullptr)
+		, scheduled_(false)
+		, stopped_(false)
+	{}
+
+	stat_queue::~stat_queue()
+	{
+		//
+		//	entries of sessions that were closed after stop()
+		//
+		auto const count = write(head_.exchange(nullptr));
+		if (count != 0) {
+			CYNG_LOG_INFO(logger_, "stat queue wrote " << count << " entries after stop");
+		}
+	}
+
+	void stat_queue::write_stat(boost::uuids::uuid tag
+		, std::string const& account
+		, std::string const& evt
+		, cyng::object obj)
+	{
+		push(new entry(std::chrono::system_clock::now(), tag, account, evt, obj));
+	}
+
+	void stat_queue::insert_msg(cyng::logging::severity level
+		, std::string const& msg
+		, boost::uuids::uuid tag)
+	{
+		push(new entry(std::chrono::system_clock::now(), tag, level, msg));
+	}
+
+	void stat_queue::stop()
+	{
+		//
+		//	Wait until a scheduled drain has written its entries.
+		//	Taking over the scheduled flag excludes any further drain
+		//	and keeps push() from scheduling a new one.
+		//
+		while (scheduled_.exchange(true, std::memory_order_acq_rel)) {
+			std::this_thread::yield();
+		}
+		stopped_.store(true);
+
+		auto const count = write(head_.exchange(nullptr, std::memory_order_acquire));
+		CYNG_LOG_INFO(logger_, "stat queue stopped - " << count << " pending entries written");
+	}
+
+	void stat_queue::push(entry* ep)
+	{
+		ep->next_ = head_.load(std::memory_order_relaxed);
+		while (!head_.compare_exchange_weak(ep->next_, ep, std::memory_order_release, std::memory_order_relaxed))
+			;
+
+		//
+		//	schedule a drain if there is none
+		//
+		if (!stopped_.load(std::memory_order_relaxed) && !scheduled_.exchange(true, std::memory_order_acq_rel)) {
+			boost::asio::post(ios_, std::bind(&stat_queue::drain, this));
+		}
+	}
+
+	void stat_queue::drain()
+	{
+		for (;;) {
+			write(head_.exchange(nullptr, std::memory_order_acquire));
+
+			//
+			//	Entries pushed after the exchange above have seen
+			//	"scheduled_ == true" and rely on this consumer.
+			//
+			scheduled_.store(false, std::memory_order_release);
+			if (head_.load(std::memory_order_acquire) == nullptr)	break;
+			if (stopped_.load() || scheduled_.exchange(true, std::memory_order_acq_rel))	break;
+		}
+	}
+
+	std::size_t stat_queue::write(entry* ep)
+	{
+		if (ep == nullptr)	return 0;
+
+		//
+		//	restore insertion order
+		//
+		entry* fifo = nullptr;
+		while (ep != nullptr) {
+			auto next = ep->next_;
+			ep->next_ = fifo;
+			fifo = ep;
+			ep = next;
+		}
+
+		std::size_t count{ 0 };
+		db_.access([&](cyng::store::table* tbl_ts, cyng::store::table* tbl_msg, cyng::store::table const* tbl_cfg)->void {
+
+			auto rec = tbl_cfg->lookup(cyng::table::key_generator("max-messages"));
+			const std::uint64_t max_messages = (!rec.empty())
+				? cyng::value_cast<std::uint64_t>(rec["value"], 1000u)
+				: 1000u
+				;
+
+			for (auto pos = fifo; pos != nullptr; pos = pos->next_, ++count) {
+				if (pos->is_msg_) {
+					node::insert_msg(tbl_msg, pos->level_, pos->evt_, pos->tag_, max_messages, pos->tp_);
+				}
+				else {
+					insert_ts_event(tbl_ts, pos->tag_, pos->account_, pos->evt_, pos->value_, pos->tp_);
+				}
+			}
+
+		}	, cyng::store::write_access("_TimeSeries")
+			, cyng::store::write_access("_SysMsg")
+			, cyng::store::read_access("_Config"));
+
+		while (fifo != nullptr) {
+			auto next = fifo->next_;
+			delete fifo;
+			fifo = next;
+		}
+
+		CYNG_LOG_TRACE(logger_, "stat queue wrote " << count << " entries");
+		return count;
+	}
+
+	stat_queue::entry::entry(std::chrono::system_clock::time_point tp
+		, boost::uuids::uuid tag
+		, std::string const& account
+		, std::string const& evt
+		, cyng::object obj)
+	: next_(nullptr)
+		, tp_(tp)
+		, tag_(tag)
+		, is_msg_(false)
+		, level_(cyng::logging::severity::LEVEL_TRACE)
+		, account_(account)
+		, evt_(evt)
+		, value_(obj)
+	{}
+
+	stat_queue::entry::entry(std::chrono::system_clock::time_point tp
+		, boost::uuids::uuid tag
+		, cyng::logging::severity level
+		, std::string const& msg)
+	: next_(nullptr)
+		, tp_(tp)
+		, tag_(tag)
+		, is_msg_(true)
+		, level_(level)
+		, account_()
+		, evt_(msg)
+		, value_()
+	{}
+}
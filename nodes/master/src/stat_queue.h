@@ -0,0 +1,114 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#ifndef NODE_MASTER_STAT_QUEUE_H
+#define NODE_MASTER_STAT_QUEUE_H
+
+#include <cyng/log.h>
+#include <cyng/store/db.h>
+#include <cyng/compatibility/io_service.h>
+
+#include <atomic>
+#include <chrono>
+#include <boost/uuid/uuid.hpp>
+
+namespace node
+{
+	/**
+	 * Append-only queue for statistics (_TimeSeries) and system
+	 * messages (_SysMsg).
+	 *
+	 * Producers never take a table lock. Entries are pushed onto a
+	 * lock-free stack and a single consumer drains all pending entries
+	 * in one batch under one write lock.
+	 */
+	class stat_queue
+	{
+		struct entry
+		{
+			entry(std::chrono::system_clock::time_point
+				, boost::uuids::uuid
+				, std::string const& account
+				, std::string const& evt
+				, cyng::object);
+			entry(std::chrono::system_clock::time_point
+				, boost::uuids::uuid
+				, cyng::logging::severity
+				, std::string const& msg);
+
+			entry* next_;
+			std::chrono::system_clock::time_point const tp_;
+			boost::uuids::uuid const tag_;
+			bool const is_msg_;
+			cyng::logging::severity const level_;
+			std::string const account_;
+			std::string const evt_;	//!< event or message text
+			cyng::object const value_;
+		};
+
+	public:
+		stat_queue(cyng::logging::log_ptr, cyng::store::db&, cyng::io_service_t&);
+		~stat_queue();
+
+		stat_queue(stat_queue const&) = delete;
+		stat_queue& operator=(stat_queue const&) = delete;
+
+		/**
+		 * append an entry to table _TimeSeries
+		 */
+		void write_stat(boost::uuids::uuid tag
+			, std::string const& account
+			, std::string const& evt
+			, cyng::object);
+
+		/**
+		 * append an entry to table _SysMsg
+		 */
+		void insert_msg(cyng::logging::severity
+			, std::string const&
+			, boost::uuids::uuid tag);
+
+		/**
+		 * Wait for a scheduled drain to complete and write all pending
+		 * entries synchronously. No more drains are scheduled. Entries
+		 * pushed after stop() are written by the destructor.
+		 * Must not be called from a thread of the I/O service.
+		 */
+		void stop();
+
+	private:
+		void push(entry*);
+
+		/**
+		 * single consumer
+		 */
+		void drain();
+
+		/**
+		 * @return number of written entries
+		 */
+		std::size_t write(entry*);
+
+	private:
+		cyng::logging::log_ptr logger_;
+		cyng::store::db& db_;
+		cyng::io_service_t& ios_;
+
+		/**
+		 * LIFO list of pending entries
+		 */
+		std::atomic<entry*> head_;
+
+		/**
+		 * true while a drain is scheduled or running
+		 */
+		std::atomic<bool> scheduled_;
+		std::atomic<bool> stopped_;
+	};
+}
+
+#endif
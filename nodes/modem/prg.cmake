@@ -7,6 +7,7 @@ set (node_modem_cpp
 	nodes/modem/src/controller.cpp
 	nodes/shared/net/server_stub.cpp
 	nodes/shared/net/session_stub.cpp
+	nodes/shared/net/buffer_pool.cpp
 	nodes/modem/src/server.cpp
 	nodes/modem/src/session.cpp
 	nodes/modem/src/session_state.cpp
@@ -18,6 +19,7 @@ set (node_modem_h
 	src/main/include/smf/cluster/server_stub.h
 	nodes/modem/src/server.h
 	src/main/include/smf/cluster/session_stub.h
+	src/main/include/smf/cluster/buffer_pool.h
 	nodes/modem/src/session.h
 	nodes/modem/src/session_state.h
 )
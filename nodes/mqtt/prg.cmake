@@ -6,12 +6,14 @@ set (node_mqtt_cpp
 	nodes/mqtt/src/main.cpp	
 	nodes/mqtt/src/controller.cpp
 	nodes/mqtt/src/server.cpp
+	nodes/mqtt/src/topic_tree.cpp
 )
 
 set (node_mqtt_h
 
 	nodes/mqtt/src/controller.h
 	nodes/mqtt/src/server.h
+	nodes/mqtt/src/topic_tree.h
 )
 
 set (node_mqtt_info
@@ -17,6 +17,7 @@
 #include <cyng/json.h>
 #include <cyng/dom/reader.h>
 #include <cyng/dom/tree_walker.h>
+#include <cyng/numeric_cast.hpp>
 #if BOOST_OS_WINDOWS
 #include <cyng/scm/service.hpp>
 #endif
@@ -37,7 +38,9 @@ namespace node
 	void join_cluster(cyng::async::mux&
 		, cyng::logging::log_ptr
 		, boost::uuids::uuid cluster_tag
-		, cyng::vector_t const&);
+		, cyng::vector_t const&
+		, cyng::tuple_t const& srv
+		, cyng::tuple_t const& bridge);
 
 	controller::controller(unsigned int pool_size, std::string const& json_path)
 	: pool_size_(pool_size)
@@ -183,8 +186,15 @@ namespace node
 					, cyng::param_factory("server", cyng::tuple_factory(
 						cyng::param_factory("address", "0.0.0.0"),
                         cyng::param_factory("service", "1883"),	//	without encryption
-                        cyng::param_factory("ssl", "8883")	//	port 8883 for SSL encrypion
+                        cyng::param_factory("ssl", "8883"),	//	port 8883 for SSL encrypion
+						cyng::param_factory("max-pending", 4096),	//	QoS 0 messages per connection
+						cyng::param_factory("max-retained", 1024)	//	retained messages
                     ))
+					, cyng::param_factory("bridge", cyng::tuple_factory(
+						cyng::param_factory("prefix", "smf"),	//	topic: prefix/channel/key...
+						cyng::param_factory("qos", 0),
+						cyng::param_factory("retain", false)	//	keep last reading (limited by max-retained)
+					))
 					, cyng::param_factory("cluster", cyng::vector_factory({ cyng::tuple_factory(
 						cyng::param_factory("host", "127.0.0.1"),
 						cyng::param_factory("service", "7701"),
@@ -299,11 +309,14 @@ namespace node
 		//
 		//	connect to cluster
 		//
-		cyng::vector_t tmp;
+		cyng::vector_t tmp_vec;
+		cyng::tuple_t tmp_tpl;
 		join_cluster(mux
 			, logger
 			, cluster_tag
-			, cyng::value_cast(dom.get("cluster"), tmp));
+			, cyng::value_cast(dom.get("cluster"), tmp_vec)
+			, cyng::value_cast(dom.get("server"), tmp_tpl)
+			, cyng::value_cast(dom.get("bridge"), tmp_tpl));
 
 		//
 		//	wait for system signals
@@ -357,15 +370,38 @@ namespace node
 	void join_cluster(cyng::async::mux& mux
 		, cyng::logging::log_ptr logger
 		, boost::uuids::uuid cluster_tag
-		, cyng::vector_t const& cfg)
+		, cyng::vector_t const& cfg
+		, cyng::tuple_t const& srv
+		, cyng::tuple_t const& bridge)
 	{
 		CYNG_LOG_TRACE(logger, "cluster redundancy: " << cfg.size());
 
+		auto dom_srv = cyng::make_reader(srv);
+		auto dom_bridge = cyng::make_reader(bridge);
+
+		auto const qos = cyng::numeric_cast<std::uint32_t>(dom_bridge.get("qos"), 0u);
+		if (qos > 2) {
+			CYNG_LOG_WARNING(logger, "invalid bridge QoS " << qos << " - use 0");
+		}
+
+		auto prefix = cyng::value_cast<std::string>(dom_bridge.get("prefix"), "smf");
+		if (!topic_tree::is_valid_topic(prefix)) {
+			CYNG_LOG_WARNING(logger, "invalid bridge prefix " << prefix << " - use smf");
+			prefix = "smf";
+		}
+
 		cyng::async::start_task_delayed<cluster>(mux
 			, std::chrono::seconds(1)
 			, logger
 			, cluster_tag
-			, load_cluster_cfg(cfg));
+			, load_cluster_cfg(cfg)
+			, cyng::value_cast<std::string>(dom_srv.get("address"), "0.0.0.0")
+			, cyng::value_cast<std::string>(dom_srv.get("service"), "1883")
+			, cyng::numeric_cast<std::size_t>(dom_srv.get("max-pending"), 4096u)
+			, cyng::numeric_cast<std::size_t>(dom_srv.get("max-retained"), 1024u)
+			, prefix
+			, static_cast<std::uint8_t>((qos > 2) ? 0 : qos)
+			, cyng::value_cast(dom_bridge.get("retain"), false));
 
 	}
 }
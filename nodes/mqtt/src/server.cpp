@@ -9,16 +9,25 @@
 #include "server.h"
 #include <mqtt/str_qos.hpp>
 
+#include <boost/asio/post.hpp>
+
 namespace node 
 {
 	server::server(cyng::async::mux& mux
 		, cyng::logging::log_ptr logger
-		, bus::shared_type bus)
+		, bus::shared_type bus
+		, std::size_t max_pending
+		, std::size_t max_retained)
 	: mux_(mux)
 		, logger_(logger)
 		, bus_(bus)
+		, max_pending_(max_pending)
 		, acceptor_(mux.get_io_service())
 		, socket_(new socket_t(mux_.get_io_service()))
+		, connections_()
+		, next_id_(0)
+		, topics_(max_retained)
+		, mutex_()
 	{
 	}
 
@@ -66,20 +75,18 @@ namespace node
 			{
 				CYNG_LOG_TRACE(logger_, "accept " << socket_->lowest_layer().remote_endpoint());
 
-				//
-				//  ToDo: call accept handler
-				//
 				auto sp = std::make_shared<endpoint_t>(std::move(socket_));
 
-//				//
-//				//	bus is synchronizing access to client_map_
-//				//
-//				bus_->vm_.async_run(cyng::generate_invoke("server.insert.client", tag, conn));
-				
 				//
 				//	set connection callbacks
 				//
-				set_callbacks(sp->shared_from_this());
+				std::uint64_t sid{ 0 };
+				{
+					cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+					sid = ++next_id_;
+					connections_.emplace(sid, connection(sp));
+				}
+				set_callbacks(sp, sid);
 
 				//
 				//	new socket
@@ -121,129 +128,308 @@ namespace node
 
 	}
 
-	void server::set_callbacks(shared_ep sp)
+	void server::set_callbacks(shared_ep sp, std::uint64_t sid)
 	{
+		//
+		//	handlers are owned by the endpoint and must not keep it alive
+		//
+		std::weak_ptr<endpoint_t> wp(sp);
+
+		//
+		//	acknowledge QoS 1 and 2 publishes without blocking the strand
+		//
+		sp->set_auto_pub_response(true, true);
+
 		sp->start_session(
-			[sp] // keeping ep's lifetime as sp until session finished
+			[this, sp, sid] // keeping ep's lifetime as sp until session finished
 			(boost::system::error_code const& ec) {
-				std::cout << "session end: " << ec.message() << std::endl;
+				CYNG_LOG_TRACE(logger_, "session #" << sid << " end: " << ec.message());
 			}
 		);
 		
 		// set connection (lower than MQTT) level handlers
-		sp->set_close_handler([&](){
-				std::cout << "closed." << std::endl;
-				close_proc(sp->shared_from_this());
-			});
-		sp->set_error_handler([&](boost::system::error_code const& ec) {
-				std::cout << "error: " << ec.message() << std::endl;
-				close_proc(sp->shared_from_this());
-			});
+		sp->set_close_handler([this, sid]() {
+			CYNG_LOG_TRACE(logger_, "session #" << sid << " closed");
+			close_proc(sid);
+		});
+		sp->set_error_handler([this, sid](boost::system::error_code const& ec) {
+			CYNG_LOG_WARNING(logger_, "session #" << sid << " error: " << ec.message());
+			close_proc(sid);
+		});
 		
 		// set MQTT level handlers
-		sp->set_connect_handler([&](std::string const& client_id,
-			 boost::optional<std::string> const& username,
-			boost::optional<std::string> const& password,
+		sp->set_connect_handler([this, wp, sid](std::string const& client_id,
+			boost::optional<std::string> const& username,
+			boost::optional<std::string> const&,
 			boost::optional<mqtt::will>,
 			bool clean_session,
 			std::uint16_t keep_alive) {
 			
-				std::cout << "client_id    : " << client_id << std::endl;
-				std::cout << "username     : " << (username ? username.get() : "none") << std::endl;
-				std::cout << "password     : " << (password ? password.get() : "none") << std::endl;
-				std::cout << "clean_session: " << std::boolalpha << clean_session << std::endl;
-				std::cout << "keep_alive   : " << keep_alive << std::endl;
-				connections.insert(sp->shared_from_this());
-				sp->connack(false, mqtt::connect_return_code::accepted);
-				return true;
-	}
-		);
-		sp->set_disconnect_handler([&]() {
-			std::cout << "disconnect received." << std::endl;
-			close_proc(sp->shared_from_this());
+			auto sp = wp.lock();
+			if (!sp)	return false;
+
+			CYNG_LOG_INFO(logger_, "session #"
+				<< sid
+				<< " connect "
+				<< client_id
+				<< " user: "
+				<< (username ? username.get() : "none")
+				<< ", clean session: "
+				<< std::boolalpha
+				<< clean_session
+				<< ", keep alive: "
+				<< keep_alive);
+
+			//
+			//	A second connection with the same client id
+			//	takes over (3.1.4).
+			//
+			shared_ep prev;
+			{
+				cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+				for (auto& con : connections_) {
+					if (con.first != sid && !client_id.empty() && con.second.client_id_ == client_id) {
+						prev = con.second.ep_;
+						break;
+					}
+				}
+				auto pos = connections_.find(sid);
+				if (pos != connections_.end())	pos->second.client_id_ = client_id;
+			}
+
+			if (prev) {
+				CYNG_LOG_WARNING(logger_, "session #" << sid << " takes over client " << client_id);
+				prev->force_disconnect();
+			}
+
+			//
+			//	sessions are not persisted
+			//
+			sp->async_connack(false, mqtt::connect_return_code::accepted);
+			return true;
+		});
+
+		sp->set_disconnect_handler([this, sid]() {
+			CYNG_LOG_TRACE(logger_, "session #" << sid << " disconnect received");
+			close_proc(sid);
 		});
 		
-		sp->set_puback_handler([&](std::uint16_t packet_id) {
-			std::cout << "puback received. packet_id: " << packet_id << std::endl;
+		sp->set_puback_handler([](std::uint16_t) {
 			return true;
 		});
 		
-		sp->set_pubrec_handler([&](std::uint16_t packet_id) {
-			std::cout << "pubrec received. packet_id: " << packet_id << std::endl;
+		sp->set_pubrec_handler([](std::uint16_t) {
 			return true;
 		});
 		
-		sp->set_pubrel_handler([&](std::uint16_t packet_id) {
-			std::cout << "pubrel received. packet_id: " << packet_id << std::endl;
+		sp->set_pubrel_handler([](std::uint16_t) {
 			return true;
 		});
 		
-		sp->set_pubcomp_handler([&](std::uint16_t packet_id) {
-			std::cout << "pubcomp received. packet_id: " << packet_id << std::endl;
+		sp->set_pubcomp_handler([](std::uint16_t) {
 			return true;
 		});
 		
-		sp->set_publish_handler([&](std::uint8_t header,
-			 boost::optional<std::uint16_t> packet_id,
+		sp->set_publish_handler([this, sid](std::uint8_t header,
+			boost::optional<std::uint16_t> packet_id,
 			std::string topic_name,
 			std::string contents) {
-				std::uint8_t qos = mqtt::publish::get_qos(header);
-				bool retain = mqtt::publish::is_retain(header);
-				std::cout << "publish received."
-				<< " dup: " << std::boolalpha << mqtt::publish::is_dup(header)
-				<< " qos: " << mqtt::qos::to_str(qos)
-				<< " retain: " << retain << std::endl;
-				if (packet_id)
-					std::cout << "packet_id: " << *packet_id << std::endl;
-				std::cout << "topic_name: " << topic_name << std::endl;
-				std::cout << "contents: " << contents << std::endl;
-				auto const& idx = subs.get<tag_topic>();
-				auto r = idx.equal_range(topic_name);
-				for (; r.first != r.second; ++r.first) {
-					r.first->con->publish(
-						topic_name,
-						contents,
-						std::min(r.first->qos, qos),
-										  retain
-					);
-				}
+
+			std::uint8_t const qos = mqtt::publish::get_qos(header);
+			bool const retain = mqtt::publish::is_retain(header);
+
+			if (!topic_tree::is_valid_topic(topic_name)) {
+				CYNG_LOG_WARNING(logger_, "session #" << sid << " publish with invalid topic: " << topic_name);
+				return true;
+			}
+
+			//
+			//	one buffer for all receivers
+			//
+			auto const count = publish(topic_name
+				, std::make_shared<std::string const>(std::move(contents))
+				, qos
+				, retain);
+
+			CYNG_LOG_TRACE(logger_, "session #"
+				<< sid
+				<< " publish "
+				<< topic_name
+				<< " qos: "
+				<< mqtt::qos::to_str(qos)
+				<< (retain ? " retained" : "")
+				<< " - "
+				<< count
+				<< " receiver(s)");
+
 			return true;
 		});
 		
-		sp->set_subscribe_handler([&](std::uint16_t packet_id,
-			 std::vector<std::tuple<std::string, std::uint8_t>> entries) {
-				std::cout << "subscribe received. packet_id: " << packet_id << std::endl;
-				std::vector<std::uint8_t> res;
-				res.reserve(entries.size());
-				for (auto const& e : entries) {
-					std::string const& topic = std::get<0>(e);
-					std::uint8_t qos = std::get<1>(e);
-					std::cout << "topic: " << topic  << " qos: " << static_cast<int>(qos) << std::endl;
-					res.emplace_back(qos);
-					subs.emplace(topic, sp->shared_from_this(), qos);
+		sp->set_subscribe_handler([this, wp, sid](std::uint16_t packet_id,
+			std::vector<std::tuple<std::string, std::uint8_t>> entries) {
+
+			auto sp = wp.lock();
+			if (!sp)	return false;
+
+			std::vector<std::uint8_t> res;
+			res.reserve(entries.size());
+
+			cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+			auto pos = connections_.find(sid);
+			for (auto const& e : entries) {
+				std::string const& filter = std::get<0>(e);
+				std::uint8_t const qos = std::get<1>(e);
+
+				if (!topic_tree::is_valid_filter(filter)) {
+					CYNG_LOG_WARNING(logger_, "session #" << sid << " invalid topic filter: " << filter);
+					res.emplace_back(0x80);	//	failure
+					continue;
 				}
-				sp->suback(packet_id, res);
-				return true;
+
+				CYNG_LOG_TRACE(logger_, "session #" << sid << " subscribe " << filter << " qos: " << mqtt::qos::to_str(qos));
+				topics_.subscribe(filter, sid, qos);
+				res.emplace_back(qos);
+
+				//
+				//	send retained messages after suback
+				//
+				if (pos != connections_.end()) {
+					for (auto const& r : topics_.get_retained(filter)) {
+						enqueue(sid, pos->second, message{ std::make_shared<std::string const>(r.topic_), r.payload_, std::min(r.qos_, qos), true });
+					}
+				}
+			}
+			sp->async_suback(packet_id, res);
+			return true;
 		});
 		
-		sp->set_unsubscribe_handler([&](std::uint16_t packet_id,
-			 std::vector<std::string> topics) {
-				std::cout << "unsubscribe received. packet_id: " << packet_id << std::endl;
+		sp->set_unsubscribe_handler([this, wp, sid](std::uint16_t packet_id,
+			std::vector<std::string> topics) {
+
+			auto sp = wp.lock();
+			if (!sp)	return false;
+
+			{
+				cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
 				for (auto const& topic : topics) {
-					subs.erase(topic);
+					topics_.unsubscribe(topic, sid);
 				}
-				sp->unsuback(packet_id);
-				return true;
+			}
+			sp->async_unsuback(packet_id);
+			return true;
 		});
 	}
 	
-	void server::close_proc(shared_ep con)
+	std::size_t server::publish(std::string const& topic
+		, topic_tree::payload_t payload
+		, std::uint8_t qos
+		, bool retain)
 	{
-		connections.erase(con);
-		
-		auto& idx = subs.get<tag_con>();
-		auto r = idx.equal_range(con);
-		idx.erase(r.first, r.second);		
+		cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+		if (retain && !topics_.retain(topic, payload, qos)) {
+			CYNG_LOG_WARNING(logger_, "retained message store is full ("
+				<< topics_.retained_count()
+				<< ") - "
+				<< topic
+				<< " is not retained");
+		}
+
+		topic_tree::receivers_t receivers;
+		if (topics_.match(topic, receivers) == 0)	return 0;
+
+		//
+		//	topic and payload are shared by all receivers
+		//
+		auto const msg = message{ std::make_shared<std::string const>(topic), payload, qos, false };
+		for (auto const& r : receivers) {
+			auto pos = connections_.find(r.first);
+			if (pos != connections_.end()) {
+				enqueue(r.first, pos->second, message{ msg.topic_, msg.payload_, std::min(r.second, qos), false });
+			}
+		}
+		return receivers.size();
+	}
+
+	void server::enqueue(std::uint64_t sid, connection& con, message const& msg)
+	{
+		if (msg.qos_ == mqtt::qos::at_most_once && (con.outbox_.size() + con.inflight_) >= max_pending_) {
+			if ((con.dropped_++ % 1000) == 0) {
+				CYNG_LOG_WARNING(logger_, "session #"
+					<< sid
+					<< " outbox is full - "
+					<< con.dropped_
+					<< " message(s) dropped");
+			}
+			return;
+		}
+
+		con.outbox_.push_back(msg);
+
+		//
+		//	first message since last flush - if a batch is still
+		//	in flight the flush is triggered by its last message
+		//
+		if (con.outbox_.size() == 1 && con.inflight_ == 0) {
+			boost::asio::post(mux_.get_io_service(), std::bind(&server::flush, this, sid));
+		}
+	}
+
+	void server::flush(std::uint64_t sid)
+	{
+		shared_ep sp;
+		std::deque<message> batch;
+		{
+			cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+			auto pos = connections_.find(sid);
+			if (pos == connections_.end() || pos->second.inflight_ != 0)	return;
+			sp = pos->second.ep_;
+			batch.swap(pos->second.outbox_);
+			pos->second.inflight_ = batch.size();
+		}
+
+		//
+		//	The endpoint writes the packets of a batch back to back.
+		//	Nagle's algorithm is not disabled so small packets share
+		//	TCP segments.
+		//
+		for (auto const& msg : batch) {
+			auto const topic = msg.topic_;
+			auto const payload = msg.payload_;
+			sp->async_publish(boost::asio::buffer(*topic)
+				, boost::asio::buffer(*payload)
+				, [topic, payload]() {}	//	life keeper
+				, msg.qos_
+				, msg.retain_
+				, [this, sid](boost::system::error_code const&) {
+					written(sid);
+				});
+		}
+	}
+
+	void server::written(std::uint64_t sid)
+	{
+		cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+		auto pos = connections_.find(sid);
+		if (pos == connections_.end() || pos->second.inflight_ == 0)	return;
+
+		if (--pos->second.inflight_ == 0 && !pos->second.outbox_.empty()) {
+			boost::asio::post(mux_.get_io_service(), std::bind(&server::flush, this, sid));
+		}
+	}
+
+	void server::close_proc(std::uint64_t sid)
+	{
+		cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+		if (connections_.erase(sid) != 0) {
+			auto const count = topics_.remove(sid);
+			CYNG_LOG_INFO(logger_, "session #"
+				<< sid
+				<< " removed with "
+				<< count
+				<< " subscription(s) - "
+				<< connections_.size()
+				<< " connection(s) open");
+		}
 	}
 	
 	void server::close()
@@ -261,10 +447,32 @@ namespace node
 		//
 		// close all clients
 		//
+		std::vector<shared_ep> eps;
+		{
+			cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+			for (auto const& con : connections_) {
+				eps.push_back(con.second.ep_);
+			}
+		}
 
+		CYNG_LOG_INFO(logger_, "close " << eps.size() << " connection(s)");
+		for (auto sp : eps) {
+			sp->force_disconnect();
+		}
+	}
 
+	bool server::is_open() const
+	{
+		return acceptor_.is_open();
 	}
-}
 
+	server::connection::connection(shared_ep sp)
+		: ep_(sp)
+		, client_id_()
+		, outbox_()
+		, inflight_(0)
+		, dropped_(0)
+	{}
+}
 
 
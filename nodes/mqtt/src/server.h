@@ -8,60 +8,80 @@
 #ifndef NODE_MQTT_SERVER_H
 #define NODE_MQTT_SERVER_H
 
+#include "topic_tree.h"
 #include <smf/cluster/bus.h>
 
 #include <mqtt/tcp_endpoint.hpp>
 #include <mqtt/endpoint.hpp>
 
 #include <cyng/async/mux.h>
+#include <cyng/compatibility/async.h>
 #include <cyng/log.h>
 
 #include <memory>
-#include <set>
-
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index/member.hpp>
+#include <map>
+#include <deque>
 
 namespace node 
 {
+	/**
+	 * MQTT broker.
+	 *
+	 * Subscriptions and retained messages are managed by a topic tree.
+	 * A published payload is allocated once and shared by all receivers.
+	 * Outgoing messages are collected per connection and flushed in batches.
+	 * The next batch is handed over to the endpoint not before all
+	 * messages of the previous batch are written. So messages of a slow
+	 * connection pile up in the outbox where QoS 0 messages can be dropped.
+	 */
 	class server
 	{
 		//  import mqtt classes
         using socket_t = mqtt::tcp_endpoint<boost::asio::ip::tcp::socket, boost::asio::io_context::strand>;
 		using endpoint_t = mqtt::endpoint<socket_t, std::mutex, std::lock_guard>;
 		using shared_ep = std::shared_ptr<endpoint_t>;
-//  		using accept_handler = std::function<void(endpoint_t& ep)>;
-
-		struct sub_con {
-			sub_con(std::string const& topic, shared_ep const& con, std::uint8_t qos)
-			:topic(topic), con(con), qos(qos) {}
-			std::string topic;
-			shared_ep con;
-			std::uint8_t qos;
+		using topic_t = std::shared_ptr<std::string const>;
+
+		struct message
+		{
+			topic_t topic_;
+			topic_tree::payload_t payload_;
+			std::uint8_t qos_;
+			bool retain_;
+		};
+
+		/**
+		 * state of a single connection
+		 */
+		struct connection
+		{
+			connection(shared_ep);
+
+			shared_ep ep_;
+			std::string client_id_;
+
+			/**
+			 * pending messages
+			 */
+			std::deque<message> outbox_;
+
+			/**
+			 * messages handed over to the endpoint and not yet written
+			 */
+			std::size_t inflight_;
+
+			/**
+			 * number of messages dropped due to a full outbox
+			 */
+			std::size_t dropped_;
 		};
-		
-		struct tag_topic {};
-		struct tag_con {};
-
-		using mi_sub_con = boost::multi_index::multi_index_container<
-			sub_con,
-			boost::multi_index::indexed_by<
-				boost::multi_index::ordered_non_unique<
-					boost::multi_index::tag<tag_topic>,
-					BOOST_MULTI_INDEX_MEMBER(sub_con, std::string, topic)
-				>,
-				boost::multi_index::ordered_non_unique<
-					boost::multi_index::tag<tag_con>,
-					BOOST_MULTI_INDEX_MEMBER(sub_con, shared_ep, con)
-				>
-			>
-		>;
 
 	public:
 		server(cyng::async::mux&
 			, cyng::logging::log_ptr logger
-			, bus::shared_type);
+			, bus::shared_type
+			, std::size_t max_pending
+			, std::size_t max_retained);
 
 		/**
 		 * start listening
@@ -69,19 +89,50 @@ namespace node
 		void run(std::string const&, std::string const&);
 
 		/**
-		 * close acceptor
+		 * close acceptor and all connections
 		 */
 		void close();
 
+		/**
+		 * @return true if acceptor is open
+		 */
+		bool is_open() const;
+
+		/**
+		 * Deliver a message to all matching subscriptions.
+		 * Thread safe.
+		 *
+		 * @return number of receivers
+		 */
+		std::size_t publish(std::string const& topic
+			, topic_tree::payload_t
+			, std::uint8_t qos
+			, bool retain);
+
 	private:
 		/**
 		 * Perform an asynchronous accept operation.
 		 */
 		void do_accept();
 
-		void set_callbacks(shared_ep);
-		void close_proc(shared_ep con);
-		
+		void set_callbacks(shared_ep, std::uint64_t);
+		void close_proc(std::uint64_t);
+
+		/**
+		 * append to outbox and schedule a flush. Requires lock.
+		 */
+		void enqueue(std::uint64_t, connection&, message const&);
+
+		/**
+		 * write all pending messages of the specified connection
+		 */
+		void flush(std::uint64_t);
+
+		/**
+		 * a message of the current batch is written
+		 */
+		void written(std::uint64_t);
+
 	private:
 		/*
 		 * task manager and running I/O context
@@ -98,6 +149,12 @@ namespace node
 		 */
 		bus::shared_type bus_;
 
+		/**
+		 * Messages with QoS 0 are dropped if a (slow) connection
+		 * has more unwritten messages (outbox and current batch).
+		 */
+		std::size_t const max_pending_;
+
 		/*
 		 * Acceptor used to listen for incoming connections.
 		 */
@@ -108,11 +165,15 @@ namespace node
 		/**
 		 * connection management
 		 */
-		std::set<shared_ep> connections;
-		mi_sub_con subs;
-		
+		std::map<std::uint64_t, connection> connections_;
+		std::uint64_t next_id_;
+		topic_tree topics_;
+
+		/**
+		 * protects connections_ and topics_
+		 */
+		mutable cyng::async::mutex mutex_;
 	};
 }
 
 #endif
-
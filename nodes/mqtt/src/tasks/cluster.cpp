@@ -10,17 +10,49 @@
 #include <cyng/async/task/task_builder.hpp>
 #include <cyng/io/serializer.h>
 #include <cyng/vm/generator.h>
+#include <cyng/json.h>
+#include <cyng/value_cast.hpp>
+
+#include <sstream>
+#include <algorithm>
 
 namespace node
 {
+	namespace
+	{
+		/**
+		 * Separators and wildcards are not allowed in topic levels
+		 */
+		std::string make_level(std::string level)
+		{
+			std::replace_if(level.begin(), level.end(), [](char c) {
+				return c == '/' || c == '+' || c == '#';
+			}, '_');
+			return level;
+		}
+	}
+
 	cluster::cluster(cyng::async::base_task* btp
 		, cyng::logging::log_ptr logger
 		, boost::uuids::uuid cluster_tag
-		, cluster_config_t const& cfg)
+		, cluster_config_t const& cfg
+		, std::string const& address
+		, std::string const& service
+		, std::size_t max_pending
+		, std::size_t max_retained
+		, std::string const& prefix
+		, std::uint8_t qos
+		, bool retain)
 	: base_(*btp)
 	, bus_(bus_factory(btp->mux_, logger, cluster_tag, btp->get_id()))
 	, logger_(logger)
 	, config_(cfg)
+	, address_(address)
+	, service_(service)
+	, prefix_(prefix)
+	, qos_(qos)
+	, retain_(retain)
+	, server_(btp->mux_, logger, bus_, max_pending, max_retained)
 	{
 		CYNG_LOG_INFO(logger_, "initialize task #"
 			<< base_.get_id()
@@ -32,6 +64,7 @@ namespace node
 		//	implement request handler
 		//
 		bus_->vm_.register_function("bus.reconfigure", 1, std::bind(&cluster::reconfigure, this, std::placeholders::_1));
+		bus_->vm_.register_function("bus.req.push.data", 0, std::bind(&cluster::bus_req_push_data, this, std::placeholders::_1));
 		bus_->vm_.async_run(cyng::generate_invoke("log.msg.info", cyng::invoke("lib.size"), "callbacks registered"));
 
 	}
@@ -56,7 +89,7 @@ namespace node
 		//
 		//	stop server
 		//
-		//server_.close();
+		server_.close();
 
 		//
 		//	sign off from cloud
@@ -80,9 +113,11 @@ namespace node
 		}
 
 		//
-		//	start mqtt master
+		//	start mqtt broker
 		//
-		//server_.run(ipt_address_, ipt_service_);
+		if (!server_.is_open()) {
+			server_.run(address_, service_);
+		}
 
 		return cyng::continuation::TASK_CONTINUE;
 	}
@@ -95,9 +130,9 @@ namespace node
 		CYNG_LOG_WARNING(logger_, "lost connection to cluster");
 
 		//
-		//	stop server
+		//	The broker keeps running. Connected clients don't
+		//	depend on the cluster and retained messages survive.
 		//
-		//server_.close();
 
 		//
 		//	switch to other configuration
@@ -128,6 +163,47 @@ namespace node
 
 	}
 
+	void cluster::bus_req_push_data(cyng::context& ctx)
+	{
+		const cyng::vector_t frame = ctx.get_frame();
+		//
+		//	* seq (cluster)
+		//	* channel/table
+		//	* key
+		//	* data
+		//	* source
+		//
+		CYNG_LOG_TRACE(logger_, "bus.req.push.data - " << cyng::io::to_str(frame));
+
+		const std::string channel = cyng::value_cast<std::string>(frame.at(1), "");
+		cyng::vector_t key, data;
+		key = cyng::value_cast(frame.at(2), key);
+		data = cyng::value_cast(frame.at(3), data);
+
+		//
+		//	topic: prefix/channel/key...
+		//
+		std::string topic = prefix_ + '/' + make_level(channel);
+		for (auto const& obj : key) {
+			topic += '/';
+			topic += make_level(cyng::io::to_str(obj));
+		}
+
+		std::stringstream ss;
+		cyng::json::write(ss, cyng::make_object(data));
+
+		const auto count = server_.publish(topic
+			, std::make_shared<std::string const>(ss.str())
+			, qos_
+			, retain_);
+
+		CYNG_LOG_DEBUG(logger_, "bus.req.push.data - "
+			<< topic
+			<< " published to "
+			<< count
+			<< " receiver(s)");
+	}
+
 	void cluster::reconfigure(cyng::context& ctx)
 	{
 		reconfigure_impl();
@@ -10,6 +10,7 @@
 
 #include <smf/cluster/bus.h>
 #include <smf/cluster/config.h>
+#include "../server.h"
 #include <cyng/log.h>
 #include <cyng/async/mux.h>
 #include <cyng/async/policy.h>
@@ -28,7 +29,14 @@ namespace node
 		cluster(cyng::async::base_task* bt
 			, cyng::logging::log_ptr
 			, boost::uuids::uuid cluster_tag
-			, cluster_config_t const& cfg);
+			, cluster_config_t const& cfg
+			, std::string const& address
+			, std::string const& service
+			, std::size_t max_pending
+			, std::size_t max_retained
+			, std::string const& prefix
+			, std::uint8_t qos
+			, bool retain);
 		cyng::continuation run();
 		void stop();
 
@@ -51,11 +59,29 @@ namespace node
 		void reconfigure(cyng::context& ctx);
 		void reconfigure_impl();
 
+		/**
+		 * Bridge from cluster data bus to MQTT. Each record is published
+		 * as JSON array with the topic "prefix/channel/key..."
+		 * Readings are pushed by the LoRa node (channel "water").
+		 */
+		void bus_req_push_data(cyng::context& ctx);
+
 	private:
 		cyng::async::base_task& base_;
 		bus::shared_type bus_;
 		cyng::logging::log_ptr logger_;
 		const cluster_redundancy config_;
+		const std::string address_;
+		const std::string service_;
+
+		/**
+		 * bridge configuration
+		 */
+		const std::string prefix_;
+		const std::uint8_t qos_;
+		const bool retain_;
+
+		server	server_;
 
 	};	
 }
@@ -0,0 +1,313 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#include "topic_tree.h"
+#include <algorithm>
+#include <boost/assert.hpp>
+
+namespace node
+{
+	namespace
+	{
+		bool is_sys(std::string const& name)
+		{
+			return !name.empty() && name.front() == '$';
+		}
+
+		void add(topic_tree::receivers_t& receivers, topic_tree::receivers_t const& subscribers)
+		{
+			for (auto const& s : subscribers) {
+				auto r = receivers.emplace(s.first, s.second);
+				if (!r.second) {
+					r.first->second = std::max(r.first->second, s.second);
+				}
+			}
+		}
+	}
+
+	topic_tree::topic_tree(std::size_t max_retained)
+		: root_()
+		, filters_()
+		, max_retained_(max_retained)
+		, subscriptions_(0)
+		, retained_(0)
+	{}
+
+	bool topic_tree::subscribe(std::string const& filter, std::uint64_t sid, std::uint8_t qos)
+	{
+		if (!is_valid_filter(filter))	return false;
+
+		level* lp = &root_;
+		for (auto const& name : split(filter)) {
+			auto& child = lp->children_[name];
+			if (!child)	child.reset(new level());
+			lp = child.get();
+		}
+
+		if (lp->subscribers_.emplace(sid, qos).second) {
+			filters_[sid].insert(filter);
+			++subscriptions_;
+		}
+		else {
+			//
+			//	replace existing subscription (3.8.4)
+			//
+			lp->subscribers_[sid] = qos;
+		}
+		return true;
+	}
+
+	bool topic_tree::unsubscribe(std::string const& filter, std::uint64_t sid)
+	{
+		auto pos = filters_.find(sid);
+		if (pos == filters_.end() || pos->second.erase(filter) == 0)	return false;
+		if (pos->second.empty())	filters_.erase(pos);
+
+		return erase(&root_, split(filter), 0, sid);
+	}
+
+	std::size_t topic_tree::remove(std::uint64_t sid)
+	{
+		auto pos = filters_.find(sid);
+		if (pos == filters_.end())	return 0;
+
+		std::size_t count{ 0 };
+		for (auto const& filter : pos->second) {
+			if (erase(&root_, split(filter), 0, sid))	++count;
+		}
+		filters_.erase(pos);
+		return count;
+	}
+
+	std::size_t topic_tree::match(std::string const& topic, receivers_t& receivers) const
+	{
+		match(&root_, split(topic), 0, receivers);
+		return receivers.size();
+	}
+
+	bool topic_tree::retain(std::string const& topic, payload_t payload, std::uint8_t qos)
+	{
+		auto const levels = split(topic);
+		if (!payload || payload->empty()) {
+
+			//
+			//	remove retained message (3.3.1.3)
+			//
+			level* lp = &root_;
+			for (auto const& name : levels) {
+				auto pos = lp->children_.find(name);
+				if (pos == lp->children_.end())	return true;
+				lp = pos->second.get();
+			}
+			if (lp->payload_) {
+				lp->payload_.reset();
+				--retained_;
+				prune(&root_, levels, 0);
+			}
+			return true;
+		}
+
+		//
+		//	replacing an existing retained message is always possible
+		//
+		bool const full = (retained_ >= max_retained_);
+
+		level* lp = &root_;
+		for (auto const& name : levels) {
+			if (full) {
+				auto pos = lp->children_.find(name);
+				if (pos == lp->children_.end())	return false;
+				lp = pos->second.get();
+			}
+			else {
+				auto& child = lp->children_[name];
+				if (!child)	child.reset(new level());
+				lp = child.get();
+			}
+		}
+		if (!lp->payload_) {
+			if (full)	return false;
+			++retained_;
+		}
+		lp->payload_ = payload;
+		lp->qos_ = qos;
+		return true;
+	}
+
+	std::vector<topic_tree::retained> topic_tree::get_retained(std::string const& filter) const
+	{
+		std::vector<retained> result;
+		if (retained_ != 0 && is_valid_filter(filter)) {
+			collect(&root_, split(filter), 0, std::string(), result);
+		}
+		return result;
+	}
+
+	std::size_t topic_tree::size() const
+	{
+		return subscriptions_;
+	}
+
+	std::size_t topic_tree::retained_count() const
+	{
+		return retained_;
+	}
+
+	bool topic_tree::is_valid_filter(std::string const& filter)
+	{
+		if (filter.empty())	return false;
+
+		auto const levels = split(filter);
+		for (std::size_t idx = 0; idx < levels.size(); ++idx) {
+			auto const& name = levels.at(idx);
+			if (name == "#") {
+				//	must be the last level
+				if (idx + 1 != levels.size())	return false;
+			}
+			else if (name != "+" && name.find_first_of("+#") != std::string::npos) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool topic_tree::is_valid_topic(std::string const& topic)
+	{
+		return !topic.empty() && topic.find_first_of("+#") == std::string::npos;
+	}
+
+	std::vector<std::string> topic_tree::split(std::string const& topic)
+	{
+		std::vector<std::string> levels;
+		std::string::size_type start = 0;
+		for (;;) {
+			auto const pos = topic.find('/', start);
+			if (pos == std::string::npos) {
+				levels.emplace_back(topic.substr(start));
+				break;
+			}
+			levels.emplace_back(topic.substr(start, pos - start));
+			start = pos + 1;
+		}
+		return levels;
+	}
+
+	void topic_tree::match(level const* lp
+		, std::vector<std::string> const& levels
+		, std::size_t idx
+		, receivers_t& receivers) const
+	{
+		if (idx == levels.size()) {
+			add(receivers, lp->subscribers_);
+
+			//
+			//	"a/#" matches "a" too
+			//
+			auto pos = lp->children_.find("#");
+			if (pos != lp->children_.end())	add(receivers, pos->second->subscribers_);
+			return;
+		}
+
+		if (idx != 0 || !is_sys(levels.front())) {
+			auto pos = lp->children_.find("#");
+			if (pos != lp->children_.end())	add(receivers, pos->second->subscribers_);
+
+			pos = lp->children_.find("+");
+			if (pos != lp->children_.end())	match(pos->second.get(), levels, idx + 1, receivers);
+		}
+
+		auto pos = lp->children_.find(levels.at(idx));
+		if (pos != lp->children_.end())	match(pos->second.get(), levels, idx + 1, receivers);
+	}
+
+	void topic_tree::collect(level const* lp
+		, std::vector<std::string> const& levels
+		, std::size_t idx
+		, std::string const& path
+		, std::vector<retained>& result) const
+	{
+		if (idx == levels.size()) {
+			if (lp->payload_)	result.push_back(retained{ path, lp->payload_, lp->qos_ });
+			return;
+		}
+
+		auto const& name = levels.at(idx);
+		if (name == "#") {
+			//	"a/#" includes "a"
+			if (idx != 0 && lp->payload_)	result.push_back(retained{ path, lp->payload_, lp->qos_ });
+			for (auto const& child : lp->children_) {
+				if (idx == 0 && is_sys(child.first))	continue;
+				collect_all(child.second.get(), (idx == 0) ? child.first : path + '/' + child.first, result);
+			}
+		}
+		else if (name == "+") {
+			for (auto const& child : lp->children_) {
+				if (idx == 0 && is_sys(child.first))	continue;
+				collect(child.second.get(), levels, idx + 1, (idx == 0) ? child.first : path + '/' + child.first, result);
+			}
+		}
+		else {
+			auto pos = lp->children_.find(name);
+			if (pos != lp->children_.end()) {
+				collect(pos->second.get(), levels, idx + 1, (idx == 0) ? name : path + '/' + name, result);
+			}
+		}
+	}
+
+	void topic_tree::collect_all(level const* lp
+		, std::string const& path
+		, std::vector<retained>& result) const
+	{
+		if (lp->payload_)	result.push_back(retained{ path, lp->payload_, lp->qos_ });
+		for (auto const& child : lp->children_) {
+			collect_all(child.second.get(), path + '/' + child.first, result);
+		}
+	}
+
+	bool topic_tree::erase(level* lp
+		, std::vector<std::string> const& levels
+		, std::size_t idx
+		, std::uint64_t sid)
+	{
+		if (idx == levels.size()) {
+			if (lp->subscribers_.erase(sid) == 0)	return false;
+			BOOST_ASSERT(subscriptions_ != 0);
+			--subscriptions_;
+			return true;
+		}
+
+		auto pos = lp->children_.find(levels.at(idx));
+		if (pos == lp->children_.end())	return false;
+
+		bool const r = erase(pos->second.get(), levels, idx + 1, sid);
+		if (pos->second->empty())	lp->children_.erase(pos);
+		return r;
+	}
+
+	void topic_tree::prune(level* lp, std::vector<std::string> const& levels, std::size_t idx)
+	{
+		if (idx == levels.size())	return;
+
+		auto pos = lp->children_.find(levels.at(idx));
+		if (pos == lp->children_.end())	return;
+
+		prune(pos->second.get(), levels, idx + 1);
+		if (pos->second->empty())	lp->children_.erase(pos);
+	}
+
+	topic_tree::level::level()
+		: children_()
+		, subscribers_()
+		, payload_()
+		, qos_(0)
+	{}
+
+	bool topic_tree::level::empty() const
+	{
+		return children_.empty() && subscribers_.empty() && !payload_;
+	}
+}
@@ -0,0 +1,172 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#ifndef NODE_MQTT_TOPIC_TREE_H
+#define NODE_MQTT_TOPIC_TREE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <memory>
+
+namespace node
+{
+	/**
+	 * Subscriptions and retained messages organized as a trie of topic levels.
+	 *
+	 * Subscribers are identified by a session id. Topic filters support
+	 * the single level wildcard "+" and the multi level wildcard "#".
+	 * Topics starting with '$' are not matched by a wildcard on the
+	 * first level (MQTT 3.1.1 - 4.7.2).
+	 *
+	 * The number of retained messages is limited. A retained message
+	 * for a new topic is rejected if the limit is reached.
+	 *
+	 * The tree is not synchronized.
+	 */
+	class topic_tree
+	{
+	public:
+		/**
+		 * Payloads are shared between all receivers and
+		 * the retained message store.
+		 */
+		using payload_t = std::shared_ptr<std::string const>;
+
+		struct retained
+		{
+			std::string topic_;
+			payload_t payload_;
+			std::uint8_t qos_;
+		};
+
+		/**
+		 * session id and granted QoS
+		 */
+		using receivers_t = std::map<std::uint64_t, std::uint8_t>;
+
+	private:
+		struct level
+		{
+			level();
+
+			std::map<std::string, std::unique_ptr<level>> children_;
+			receivers_t subscribers_;
+			payload_t payload_;
+			std::uint8_t qos_;
+
+			bool empty() const;
+		};
+
+	public:
+		/**
+		 * @param max_retained max. number of retained messages
+		 */
+		explicit topic_tree(std::size_t max_retained);
+
+		/**
+		 * Add or replace a subscription.
+		 *
+		 * @return false if the topic filter is invalid
+		 */
+		bool subscribe(std::string const& filter, std::uint64_t sid, std::uint8_t qos);
+
+		/**
+		 * @return true if subscription was found and removed
+		 */
+		bool unsubscribe(std::string const& filter, std::uint64_t sid);
+
+		/**
+		 * Remove all subscriptions of the specified session.
+		 *
+		 * @return number of removed subscriptions
+		 */
+		std::size_t remove(std::uint64_t sid);
+
+		/**
+		 * Collect all sessions with a matching subscription. If a session
+		 * has overlapping subscriptions the maximum QoS is returned.
+		 *
+		 * @return number of receivers
+		 */
+		std::size_t match(std::string const& topic, receivers_t&) const;
+
+		/**
+		 * Store a retained message. An empty payload removes
+		 * the retained message of this topic.
+		 *
+		 * @return false if the limit of retained messages is reached
+		 */
+		bool retain(std::string const& topic, payload_t, std::uint8_t qos);
+
+		/**
+		 * @return all retained messages matching the topic filter
+		 */
+		std::vector<retained> get_retained(std::string const& filter) const;
+
+		/**
+		 * @return number of subscriptions
+		 */
+		std::size_t size() const;
+
+		/**
+		 * @return number of retained messages
+		 */
+		std::size_t retained_count() const;
+
+		/**
+		 * @return true if the filter has valid wildcards
+		 */
+		static bool is_valid_filter(std::string const&);
+
+		/**
+		 * @return true if the topic contains no wildcards
+		 */
+		static bool is_valid_topic(std::string const&);
+
+	private:
+		static std::vector<std::string> split(std::string const&);
+
+		void match(level const*
+			, std::vector<std::string> const& levels
+			, std::size_t idx
+			, receivers_t&) const;
+
+		void collect(level const*
+			, std::vector<std::string> const& levels
+			, std::size_t idx
+			, std::string const& path
+			, std::vector<retained>&) const;
+
+		void collect_all(level const*
+			, std::string const& path
+			, std::vector<retained>&) const;
+
+		bool erase(level*
+			, std::vector<std::string> const& levels
+			, std::size_t idx
+			, std::uint64_t sid);
+
+		void prune(level*, std::vector<std::string> const& levels, std::size_t idx);
+
+	private:
+		level root_;
+
+		/**
+		 * reverse index: topic filters of each session
+		 */
+		std::map<std::uint64_t, std::set<std::string>> filters_;
+
+		std::size_t const max_retained_;
+		std::size_t subscriptions_;
+		std::size_t retained_;
+	};
+}
+
+#endif
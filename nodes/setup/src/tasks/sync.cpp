@@ -115,10 +115,10 @@ namespace node
 #endif
 
 				//
-				//	upload	
+				//	upload - replaces records the master restored from a snapshot
 				//
 				CYNG_LOG_TRACE(logger_, cyng::io::to_str(rec[0]));
-				bus_->vm_.async_run(bus_req_db_insert(tbl->meta().get_name()
+				bus_->vm_.async_run(bus_req_db_merge(tbl->meta().get_name()
 					, rec.key()
 					, rec.data()
 					, rec.get_generation()
@@ -130,6 +130,12 @@ namespace node
 
 		}, cyng::store::read_access(table_));
 
+		//
+		//	upload complete - master removes restored records
+		//	that are not in the database anymore
+		//
+		bus_->vm_.async_run(bus_req_db_reconcile(table_));
+
 		//
 		//	clear table
 		//
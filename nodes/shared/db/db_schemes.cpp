@@ -359,6 +359,29 @@ namespace node
 				, 64		//	evt
 				, 128 });	//	obj
 		}
+		else if (boost::algorithm::equals(name, "_Statistics")) {
+
+			return cyng::table::make_meta_table<2, 7>(name, { "metric"	//	e.g. logins
+				, "label"	//	e.g. failure reason or gateway
+				, "ts"		//	last update
+				, "window"	//	[uint32] window size in seconds
+				, "count"	//	[uint64] events in window
+				, "rate"	//	[double] events per second
+				, "p50"		//	[double] median
+				, "p90"		//	[double] 90th percentile
+				, "p99"		//	[double] 99th percentile
+				},
+				{ cyng::TC_STRING
+				, cyng::TC_STRING
+				, cyng::TC_TIME_POINT
+				, cyng::TC_UINT32
+				, cyng::TC_UINT64
+				, cyng::TC_DOUBLE
+				, cyng::TC_DOUBLE
+				, cyng::TC_DOUBLE
+				, cyng::TC_DOUBLE },
+				{ 64, 64, 0, 0, 0, 0, 0, 0, 0 });
+		}
 
 		//
 		//	table name not defined
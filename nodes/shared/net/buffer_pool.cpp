@@ -0,0 +1,127 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#include <smf/cluster/buffer_pool.h>
+#include <boost/assert.hpp>
+#include <algorithm>
+
+namespace node
+{
+	buffer_pool::buffer::buffer()
+		: pool_(nullptr)
+		, data_(nullptr)
+	{}
+
+	buffer_pool::buffer::buffer(buffer_pool* pool, char* data)
+		: pool_(pool)
+		, data_(data)
+	{}
+
+	buffer_pool::buffer::buffer(buffer&& other)
+		: pool_(other.pool_)
+		, data_(other.data_)
+	{
+		other.pool_ = nullptr;
+		other.data_ = nullptr;
+	}
+
+	buffer_pool::buffer& buffer_pool::buffer::operator=(buffer&& other)
+	{
+		if (this != &other) {
+			reset();
+			std::swap(pool_, other.pool_);
+			std::swap(data_, other.data_);
+		}
+		return *this;
+	}
+
+	buffer_pool::buffer::~buffer()
+	{
+		reset();
+	}
+
+	char* buffer_pool::buffer::data() const
+	{
+		return data_;
+	}
+
+	std::size_t buffer_pool::buffer::size() const
+	{
+		return (pool_ != nullptr)
+			? pool_->block_size()
+			: 0u
+			;
+	}
+
+	void buffer_pool::buffer::reset()
+	{
+		if (pool_ != nullptr) {
+			pool_->release(data_);
+			pool_ = nullptr;
+			data_ = nullptr;
+		}
+	}
+
+	buffer_pool::buffer_pool(std::size_t block_size, std::size_t slab_size)
+		: block_size_(block_size)
+		, slab_size_(std::max<std::size_t>(slab_size, 1u))
+		, mutex_()
+		, slabs_()
+		, free_()
+	{}
+
+	buffer_pool::buffer buffer_pool::get()
+	{
+		cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+		if (free_.empty()) {
+
+			//
+			//	allocate a new slab
+			//
+			slabs_.emplace_back(new char[block_size_ * slab_size_]);
+			char* p = slabs_.back().get();
+			free_.reserve(slabs_.size() * slab_size_);
+			for (std::size_t idx = 0; idx < slab_size_; ++idx) {
+				free_.push_back(p + (idx * block_size_));
+			}
+		}
+
+		char* data = free_.back();
+		free_.pop_back();
+		return buffer(this, data);
+	}
+
+	std::size_t buffer_pool::block_size() const
+	{
+		return block_size_;
+	}
+
+	std::size_t buffer_pool::capacity() const
+	{
+		cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+		return slabs_.size() * slab_size_;
+	}
+
+	std::size_t buffer_pool::available() const
+	{
+		cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+		return free_.size();
+	}
+
+	void buffer_pool::release(char* data)
+	{
+		BOOST_ASSERT(data != nullptr);
+		cyng::async::lock_guard<cyng::async::mutex> lk(mutex_);
+		free_.push_back(data);
+	}
+
+	buffer_pool& get_buffer_pool()
+	{
+		static buffer_pool pool(NODE::PREFERRED_BUFFER_SIZE, 64u);
+		return pool;
+	}
+}
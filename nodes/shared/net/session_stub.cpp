@@ -25,7 +25,6 @@ namespace node
 		, boost::uuids::uuid tag
 		, std::chrono::seconds timeout)
 	: socket_(std::move(socket))
-		, buffer_()
 		, pending_(false)
 		, mux_(mux)
 		, logger_(logger)
@@ -145,8 +144,10 @@ namespace node
 
 	void session_stub::do_read()
 	{
-		socket_.async_read_some(boost::asio::buffer(buffer_),
-			[this](boost::system::error_code ec, std::size_t bytes_transferred)
+		//
+		//	no buffer is bound to an idle session
+		//
+		async_read_pooled(socket_, [this](boost::system::error_code ec, buffer_pool::buffer const& buffer, std::size_t bytes_transferred)
 		{
 			if (!ec && !pending_)
 			{
@@ -160,7 +161,7 @@ namespace node
 				//
 				//	buffer contains the unscrambled input
 				//
-				const auto buf = parse(buffer_.cbegin(), buffer_.cbegin() + bytes_transferred);
+				const auto buf = parse(buffer.data(), buffer.data() + bytes_transferred);
 
 #ifdef SMF_IO_DEBUG
 				cyng::io::hex_dump hd;
@@ -0,0 +1,154 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#ifndef NODE_CLUSTER_BUFFER_POOL_H
+#define NODE_CLUSTER_BUFFER_POOL_H
+
+#include <NODE_project_info.h>
+#include <cyng/compatibility/async.h>
+
+#include <boost/asio.hpp>
+#include <boost/version.hpp>
+
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+
+namespace node
+{
+	/**
+	 * Thread safe pool of fixed size I/O buffers.
+	 *
+	 * Memory is allocated in slabs of several blocks and never returned
+	 * to the heap. Sessions take a block only while a read is in progress
+	 * and hand it back immediately after the received data are parsed.
+	 * So the memory footprint depends on the number of concurrently
+	 * active connections and not on the number of open connections.
+	 */
+	class buffer_pool
+	{
+	public:
+		/**
+		 * Move-only handle of a pooled block. The block is
+		 * returned to the pool when the handle is destroyed.
+		 */
+		class buffer
+		{
+			friend class buffer_pool;
+
+		public:
+			buffer();
+			buffer(buffer&&);
+			buffer& operator=(buffer&&);
+			~buffer();
+
+			buffer(buffer const&) = delete;
+			buffer& operator=(buffer const&) = delete;
+
+			char* data() const;
+			std::size_t size() const;
+
+			/**
+			 * return block to pool
+			 */
+			void reset();
+
+		private:
+			buffer(buffer_pool*, char*);
+
+		private:
+			buffer_pool* pool_;
+			char* data_;
+		};
+
+	public:
+		/**
+		 * @param block_size size of each buffer
+		 * @param slab_size number of blocks allocated at once
+		 */
+		buffer_pool(std::size_t block_size, std::size_t slab_size);
+
+		buffer_pool(buffer_pool const&) = delete;
+		buffer_pool& operator=(buffer_pool const&) = delete;
+
+		/**
+		 * Take a block from the pool. Allocates a new slab
+		 * if no free block is available.
+		 */
+		buffer get();
+
+		std::size_t block_size() const;
+
+		/**
+		 * @return number of allocated blocks
+		 */
+		std::size_t capacity() const;
+
+		/**
+		 * @return number of free blocks
+		 */
+		std::size_t available() const;
+
+	private:
+		void release(char*);
+
+	private:
+		std::size_t const block_size_;
+		std::size_t const slab_size_;
+
+		mutable cyng::async::mutex mutex_;
+		std::vector<std::unique_ptr<char[]>> slabs_;
+		std::vector<char*> free_;
+	};
+
+	/**
+	 * @return process wide pool for session receive buffers
+	 * with blocks of NODE::PREFERRED_BUFFER_SIZE bytes.
+	 */
+	buffer_pool& get_buffer_pool();
+
+	/**
+	 * Wait until the socket is readable without holding any buffer.
+	 * Then read the available data into a pooled buffer. The socket
+	 * stays in blocking mode since the serializers write synchronously.
+	 * If no data are pending the readiness signals end of stream or an
+	 * error and read_some() returns immediately. The handler is called with
+	 * (error_code, buffer_pool::buffer const&, std::size_t).
+	 * The buffer is returned to the pool when the handler completes.
+	 */
+	template <typename S, typename H>
+	void async_read_pooled(S& socket, H handler)
+	{
+#if (BOOST_VERSION >= 106600)
+		socket.async_wait(boost::asio::socket_base::wait_read, [&socket, handler](boost::system::error_code ec) mutable {
+#else
+		socket.async_read_some(boost::asio::null_buffers(), [&socket, handler](boost::system::error_code ec, std::size_t) mutable {
+#endif
+			if (ec) {
+				handler(ec, buffer_pool::buffer(), 0u);
+				return;
+			}
+
+			//
+			//	never read more than pending, so read_some() cannot block
+			//
+			std::size_t const pending = socket.available(ec);
+			if (ec) {
+				handler(ec, buffer_pool::buffer(), 0u);
+				return;
+			}
+
+			auto buf = get_buffer_pool().get();
+			std::size_t const size = (pending == 0u) ? buf.size() : (std::min)(pending, buf.size());
+			auto const bytes_transferred = socket.read_some(boost::asio::buffer(buf.data(), size), ec);
+			handler(ec, buf, bytes_transferred);
+		});
+	}
+}
+
+#endif
@@ -58,6 +58,23 @@ namespace node
 		, cyng::vector_t const&
 		, std::uint64_t generation);
 
+	/**
+	 * Insert a record or replace the values of an existing record.
+	 * Used by the setup node to upload its records.
+	 */
+	cyng::vector_t bus_req_db_merge(std::string const&
+		, cyng::vector_t const&
+		, cyng::vector_t const&
+		, std::uint64_t generation
+		, boost::uuids::uuid source);
+
+	/**
+	 * All records of the specified table are uploaded.
+	 * The master removes all records that were restored from a
+	 * snapshot but not uploaded by the setup node.
+	 */
+	cyng::vector_t bus_req_db_reconcile(std::string const&);
+
 	cyng::vector_t bus_req_db_modify(std::string const&
 		, cyng::vector_t const&
 		, cyng::attr_t const&
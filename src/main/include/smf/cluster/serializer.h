@@ -11,19 +11,135 @@
 #include <NODE_project_info.h>
 #include <cyng/vm/controller.h>
 #include <cyng/io/serializer.h>
+#include <cyng/compatibility/async.h>
 #include <boost/asio.hpp>
+#include <deque>
+#include <memory>
+#include <vector>
 
 namespace node
 {
+	/**
+	 * Name of the compression method offered at cluster login
+	 */
+	constexpr char const* cluster_compression = "deflate";
+
+	/**
+	 * Frames smaller than this are sent uncompressed
+	 */
+	constexpr std::size_t cluster_compression_threshold = 16 * 1024;
+
+	/**
+	 * Default upper limit of the declared size of a compressed frame.
+	 * Larger frames are rejected before any memory is allocated.
+	 */
+	constexpr std::size_t cluster_inflate_limit = 64 * 1024 * 1024;
+
+	/**
+	 * Serializes VM instructions into the cluster stream.
+	 *
+	 * "stream.flush" doesn't block. Each flushed frame is appended to
+	 * an outbound queue and all queued frames are written with a single
+	 * gathered write. After "stream.compress" frames above the threshold
+	 * are deflated and wrapped into a "stream.inflate" call.
+	 */
 	class serializer
 	{
+		using buffer_ptr = std::unique_ptr<boost::asio::streambuf>;
+
 	public:
-		serializer(boost::asio::ip::tcp::socket& s, cyng::controller& vm);
+		serializer(boost::asio::ip::tcp::socket& s
+			, cyng::controller& vm
+			, std::size_t inflate_limit = cluster_inflate_limit);
+
+		/**
+		 * Detach pending writes from socket and VM. Completion
+		 * handlers of writes in flight only release their buffers.
+		 */
+		virtual ~serializer();
 
 	private:
-		boost::asio::streambuf buffer_;
+		/**
+		 * Outbound state. Shared with the completion handler of
+		 * the pending write, so it outlives the serializer.
+		 */
+		struct outbound
+		{
+			outbound(boost::asio::ip::tcp::socket&, cyng::controller&);
+
+			/**
+			 * Start a gathered write of all queued buffers. Requires lock.
+			 */
+			static void do_write(std::shared_ptr<outbound>);
+			static void on_write(std::shared_ptr<outbound>, boost::system::error_code const&);
+
+			/**
+			 * @return an empty buffer. Requires lock.
+			 */
+			buffer_ptr get_buffer();
+
+			/**
+			 * keep buffer for reuse. Requires lock.
+			 */
+			void recycle(buffer_ptr&&);
+
+			/**
+			 * null after the serializer was destroyed
+			 */
+			boost::asio::ip::tcp::socket* socket_;
+			cyng::controller* vm_;
+
+			/**
+			 * queued and pending frames
+			 */
+			std::deque<buffer_ptr> queue_;
+			std::vector<buffer_ptr> sending_;
+			std::vector<buffer_ptr> spare_;
+
+			/**
+			 * First write error. All following frames are dropped.
+			 */
+			boost::system::error_code ec_;
+
+			cyng::async::mutex mutex_;
+		};
+
+		/**
+		 * move content of current buffer into outbound queue
+		 */
+		void flush(cyng::context& ctx);
+
+		/**
+		 * enable compression for large frames
+		 */
+		void compress(cyng::context& ctx);
+
+		/**
+		 * decompress a frame and execute the content. Frames with a
+		 * declared size above the inflate limit or with a different
+		 * inflated length are dropped.
+		 */
+		void inflate(cyng::context& ctx);
+
+		/**
+		 * replace content of current buffer by a "stream.inflate" call
+		 */
+		void deflate_buffer();
+
+	private:
+		std::shared_ptr<outbound> out_;
+		buffer_ptr buffer_;
 		std::ostream ostream_;
 
+		/**
+		 * 0 if compression is off
+		 */
+		std::size_t threshold_;
+
+		/**
+		 * max. declared size of a compressed frame
+		 */
+		std::size_t const inflate_limit_;
 	};
 
 }
@@ -10,6 +10,7 @@
 
 #include <smf/cluster/bus.h>
 #include <smf/cluster/generator.h>
+#include <smf/cluster/buffer_pool.h>
 
 #include <cyng/log.h>
 #include <cyng/vm/generator.h>
@@ -23,9 +24,12 @@ namespace node
 	class session_stub
 	{
 	protected:
-		using read_buffer_t = std::array<char, NODE::PREFERRED_BUFFER_SIZE>;
-		using read_buffer_iterator = read_buffer_t::iterator;
-		using read_buffer_const_iterator = read_buffer_t::const_iterator;
+		/**
+		 * Receive buffers are taken from the shared buffer pool
+		 * only while data are read from the socket.
+		 */
+		using read_buffer_iterator = char*;
+		using read_buffer_const_iterator = char const*;
 
 		/**
 		 * connection socket
@@ -34,11 +38,6 @@ namespace node
 
 	private:
 
-		/**
-		 * Buffer for incoming data.
-		 */
-		read_buffer_t buffer_;
-
 		/**
 		 * session is in shutdown mode
 		 */
@@ -0,0 +1,197 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#ifndef NODE_LIB_HTTP_SRV_ASSET_CACHE_H
+#define NODE_LIB_HTTP_SRV_ASSET_CACHE_H
+
+#include <cyng/log.h>
+#include <cyng/compatibility/async.h>
+
+#include <string>
+#include <memory>
+#include <map>
+#include <chrono>
+#include <ctime>
+
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <boost/optional.hpp>
+
+namespace node
+{
+	namespace http
+	{
+		/**
+		 * Response body that shares the memory of a cached asset.
+		 * No copy of the content is made per response.
+		 */
+		struct asset_body
+		{
+			using value_type = std::shared_ptr<std::string const>;
+
+			static std::uint64_t size(value_type const& body)
+			{
+				return (body) ? body->size() : 0u;
+			}
+
+			class writer
+			{
+			public:
+				using const_buffers_type = boost::asio::const_buffer;
+
+				template<bool isRequest, class Fields>
+				writer(boost::beast::http::header<isRequest, Fields> const&, value_type const& body)
+					: body_(body)
+				{}
+
+				//	Boost < 1.70
+				template<bool isRequest, class Fields>
+				explicit writer(boost::beast::http::message<isRequest, asset_body, Fields> const& msg)
+					: body_(msg.body())
+				{}
+
+				void init(boost::beast::error_code& ec)
+				{
+					ec = {};
+				}
+
+				boost::optional<std::pair<const_buffers_type, bool>> get(boost::beast::error_code& ec)
+				{
+					ec = {};
+					if (!body_)	return boost::none;
+					return { { const_buffers_type{ body_->data(), body_->size() }, false } };
+				}
+
+			private:
+				value_type const& body_;
+			};
+		};
+
+		/**
+		 * Cache for static files below the document root.
+		 *
+		 * Files are loaded on first hit. Small files are kept in memory
+		 * together with a precomputed gzip variant (if compressible) and a
+		 * strong ETag. Each representation has its own ETag. Larger files are
+		 * served from disk but still get an ETag.
+		 * Entries are revalidated against the file system at most once
+		 * per check interval.
+		 *
+		 * The cache key is the request target without query and fragment.
+		 * The number of entries is limited. If the limit is reached the
+		 * entry that was validated least recently is dropped.
+		 */
+		class asset_cache
+		{
+		public:
+			struct entry
+			{
+				std::string path_;	//!<	file system path
+				std::string mime_;
+				std::string etag_;
+				std::string etag_gzip_;	//!<	ETag of the gzip variant
+				std::uint64_t size_;
+				std::time_t last_write_;
+				std::shared_ptr<std::string const> data_;	//!<	empty if not cached
+				std::shared_ptr<std::string const> gzip_;	//!<	empty if not compressible
+			};
+			using entry_ptr = std::shared_ptr<entry const>;
+
+		public:
+			asset_cache(cyng::logging::log_ptr
+				, std::string const& doc_root
+				, std::size_t max_entries
+				, std::size_t max_file_size
+				, std::size_t max_total_size
+				, std::chrono::seconds check_interval);
+
+			/**
+			 * Lookup a request target. Missing entries are loaded and
+			 * stale entries are reloaded.
+			 *
+			 * @return nullptr if file doesn't exist
+			 */
+			entry_ptr get(std::string const& target);
+
+			/**
+			 * remove all entries
+			 */
+			void clear();
+
+			/**
+			 * @return number of cached entries
+			 */
+			std::size_t size() const;
+
+			/**
+			 * @return number of cached bytes (including compressed variants)
+			 */
+			std::size_t bytes() const;
+
+		private:
+			/**
+			 * @param cached currently cached bytes
+			 */
+			entry_ptr load(std::string const& target, std::size_t cached);
+
+			/**
+			 * Remove the entry that was validated least recently.
+			 * Requires unique lock.
+			 */
+			void evict();
+
+		private:
+			struct slot
+			{
+				entry_ptr entry_;
+				std::chrono::steady_clock::time_point checked_;
+			};
+
+			cyng::logging::log_ptr logger_;
+			std::string const doc_root_;
+			std::size_t const max_entries_;
+			std::size_t const max_file_size_;
+			std::size_t const max_total_size_;
+			std::chrono::seconds const check_interval_;
+
+			std::map<std::string, slot> entries_;
+			std::size_t bytes_;
+			mutable cyng::async::shared_mutex mutex_;
+		};
+
+		/**
+		 * @return true if one of the entity tags in the If-None-Match
+		 * header value matches the specified ETag.
+		 */
+		bool match_etag(boost::beast::string_view if_none_match, std::string const& etag);
+
+		/**
+		 * @return true if Accept-Encoding contains gzip (or "*") with
+		 * a q-value above 0
+		 */
+		bool accepts_gzip(boost::beast::string_view accept_encoding);
+
+		/**
+		 * @return true if content of this MIME type benefits from compression
+		 */
+		bool is_compressible(boost::beast::string_view mime);
+
+		/**
+		 * Strip query and fragment and collapse repeated slashes.
+		 */
+		std::string normalize_target(std::string const&);
+
+		/**
+		 * Compress data in gzip format (RFC 1952)
+		 *
+		 * @return empty string on failure
+		 */
+		std::string gzip(std::string const&);
+	}
+}
+
+#endif
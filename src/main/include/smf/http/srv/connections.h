@@ -8,6 +8,7 @@
 #define NODE_HTTP_CONNECTIONS_H
 
 #include <smf/http/srv/cm_interface.h>
+#include <smf/http/srv/asset_cache.h>
 #ifdef NODE_SSL_INSTALLED
 #include <smf/http/srv/auth.h>
 #endif
@@ -47,6 +48,8 @@ namespace node
 				, auth_dirs const& ad
 #endif
 				, bool https_rewrite
+				, std::uint64_t body_limit
+				, std::size_t spool_threshold
 			);
 
 			/**
@@ -54,6 +57,11 @@ namespace node
 			 */
 			cyng::controller& vm();
 
+			/**
+			 * Provide access to static file cache
+			 */
+			asset_cache& assets();
+
 			/**
 			 * Add the specified connection to the manager and start it.
 			 * Called by server.
@@ -137,6 +145,21 @@ namespace node
 
 			bool const https_rewrite_;
 
+			/**
+			 * max. size of a request body in bytes
+			 */
+			std::uint64_t const body_limit_;
+
+			/**
+			 * uploaded files larger than this are spooled to disk
+			 */
+			std::size_t const spool_threshold_;
+
+			/**
+			 * static files below document root
+			 */
+			asset_cache assets_;
+
 			/**
 			 * Generate unique session tags
 			 */
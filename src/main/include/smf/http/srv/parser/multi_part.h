@@ -14,11 +14,19 @@
 #include <cyng/intrinsics/buffer.h>
 #include <boost/beast/core.hpp>
 #include <boost/uuid/uuid.hpp>
+#include <boost/filesystem.hpp>
+#include <fstream>
 
 namespace node
 {
 	namespace http
 	{
+		/**
+		 * Uploaded files larger than this are spooled to disk
+		 * if not configured otherwise.
+		 */
+		constexpr std::size_t default_spool_threshold = 1024 * 1024;
+
 		/**
 		 * parser for HTTP uploads and forms
 		 *	@see http://tools.ietf.org/html/rfc1867
@@ -38,16 +46,28 @@ namespace node
 				cyng::buffer_t			data_;
 				param_container_t		meta_;
 				mime_content_type		type_;
+				bool					file_;	//!<	part has a filename
 			};
 
 			friend 	void clear(typename multi_part_parser::multi_part& req);
 
 		public:
+			/**
+			 * @param spool_threshold file parts that grow larger than this
+			 * are written into a temporary file instead of being kept in memory.
+			 * A value of 0 disables spooling.
+			 */
 			multi_part_parser(std::function<void(cyng::vector_t&&)> cb
 				, cyng::logging::log_ptr
 				, std::uint64_t&
 				, boost::beast::string_view target
-				, boost::uuids::uuid tag);
+				, boost::uuids::uuid tag
+				, std::size_t spool_threshold);
+
+			/**
+			 * Removes an incomplete spool file
+			 */
+			~multi_part_parser();
 
 			/**
 			 * Put next available character into state machine
@@ -77,6 +97,17 @@ namespace node
 			 */
 			std::string lookup_filename(param_container_t const& phrases);
 
+			/**
+			 * Move collected data of the current part into the spool file.
+			 * Opens a new temporary file if required.
+			 */
+			void spool();
+
+			/**
+			 * close and remove spool file
+			 */
+			void discard_spool();
+
 		private:
 			//	chunk states (multipart)
 			enum chunk_enum
@@ -140,9 +171,9 @@ namespace node
 			std::uint64_t&	content_size_;
 
 			/**
-			 * Contains all HTTP header data
+			 * request target
 			 */
-			boost::beast::string_view target_;
+			std::string const target_;
 
 			/**
 			 * session tag
@@ -163,6 +194,17 @@ namespace node
 			 * current column
 			 */
 			std::size_t column_;
+
+			/**
+			 * file parts larger than this are spooled to disk
+			 */
+			std::size_t const spool_threshold_;
+
+			/**
+			 * temporary file of the current part
+			 */
+			std::ofstream spool_;
+			boost::filesystem::path spool_path_;
 		};
 
 	}
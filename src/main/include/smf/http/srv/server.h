@@ -41,7 +41,9 @@ namespace node
 #endif
 				, std::set<boost::asio::ip::address> const& blacklist
 				, cyng::controller& vm
-				, bool https_rewrite);
+				, bool https_rewrite
+				, std::uint64_t body_limit
+				, std::size_t spool_threshold);
 
 			// Start accepting incoming connections
 			bool run();
@@ -12,13 +12,17 @@
 #include <smf/http/srv/auth.h>
 #endif
 
+#include <smf/http/srv/asset_cache.h>
+
 #include <cyng/log.h>
 
 #include <memory>
+#include <array>
 
 #include <boost/beast/core.hpp>
 #include <boost/beast/http.hpp>
 #include <boost/asio.hpp>
+#include <boost/optional.hpp>
 
 namespace node
 {
@@ -26,6 +30,7 @@ namespace node
 	{
 		//	forward declaration(s):
 		class connections;
+		class multi_part_parser;
 
 		class session
 		{
@@ -111,11 +116,12 @@ namespace node
 				, connections& cm
 				, boost::uuids::uuid
 				, boost::asio::ip::tcp::socket socket
-				, std::string const& doc_root
 #ifdef NODE_SSL_INSTALLED
 				, auth_dirs const& ad
 #endif
 				, bool https_redirect
+				, std::uint64_t body_limit
+				, std::size_t spool_threshold
 			);
 			virtual ~session();
 
@@ -128,7 +134,9 @@ namespace node
 			// Called when the timer expires.
 			void on_timer(boost::system::error_code ec, cyng::object);
 
+			void on_read_header(boost::system::error_code ec);
 			void on_read(boost::system::error_code ec);
+			void on_read_chunk(boost::system::error_code ec);
 			void on_write(boost::system::error_code ec, bool close);
 			void do_close();
 
@@ -136,6 +144,18 @@ namespace node
 			void trigger_download(boost::filesystem::path const& filename, std::string const& attachment);
 
 		private:
+			/**
+			 * @return true if the session is still usable
+			 */
+			bool check_read_error(boost::system::error_code ec);
+
+			/**
+			 * Start incremental parsing of a multipart/form-data upload.
+			 * The body is read in chunks and never held completely in memory.
+			 */
+			void start_upload();
+			void do_read_chunk();
+
 			void handle_request(boost::beast::http::request<boost::beast::http::string_body>&&);
 			boost::beast::http::response<boost::beast::http::string_body> send_bad_request(std::uint32_t version
 				, bool
@@ -146,19 +166,27 @@ namespace node
 			boost::beast::http::response<boost::beast::http::string_body> send_server_error(std::uint32_t version
 				, bool
 				, boost::system::error_code ec);
+			boost::beast::http::response<boost::beast::http::string_body> send_payload_too_large(std::uint32_t version);
 			boost::beast::http::response<boost::beast::http::string_body> send_redirect(std::uint32_t version
 				, bool
 				, std::string host
 				, std::string target);
 			boost::beast::http::response<boost::beast::http::empty_body> send_head(std::uint32_t version
 				, bool
-				, std::string const& path
-				, std::uint64_t);
+				, asset_cache::entry const&
+				, bool compressed);
+			boost::beast::http::response<boost::beast::http::empty_body> send_not_modified(std::uint32_t version
+				, bool
+				, asset_cache::entry const&
+				, bool compressed);
+			boost::beast::http::response<asset_body> send_asset(std::uint32_t version
+				, bool
+				, asset_cache::entry const&
+				, bool compressed);
 			boost::beast::http::response<boost::beast::http::file_body> send_get(std::uint32_t version
 				, bool
 				, boost::beast::http::file_body::value_type&&
-				, std::string const& path
-				, std::uint64_t size);
+				, asset_cache::entry const&);
 #ifdef NODE_SSL_INSTALLED
 			boost::beast::http::response<boost::beast::http::string_body> send_not_authorized(std::uint32_t version
 				, bool keep_alive
@@ -171,18 +199,46 @@ namespace node
 		private:
 			cyng::logging::log_ptr logger_;
 			boost::uuids::uuid const tag_;
-			std::string const doc_root_;
 #ifdef NODE_SSL_INSTALLED
 			auth_dirs const& auth_dirs_;
 #endif
 			bool const https_rewrite_;
 
+			/**
+			 * max. size of a request body
+			 */
+			std::uint64_t const body_limit_;
+
+			/**
+			 * uploaded files larger than this are spooled to disk
+			 */
+			std::size_t const spool_threshold_;
+
 			boost::asio::ip::tcp::socket socket_;
 			connections& connection_manager_;
 			boost::asio::strand<boost::asio::io_context::executor_type> strand_;
 			boost::asio::steady_timer timer_;
 			boost::beast::flat_buffer buffer_;
-			boost::beast::http::request<boost::beast::http::string_body> req_;
+
+			/**
+			 * The header is read first. Depending on method and content type
+			 * the body is read completely (string_body) or streamed
+			 * in chunks (buffer_body).
+			 */
+			boost::optional<boost::beast::http::request_parser<boost::beast::http::empty_body>> header_parser_;
+			boost::optional<boost::beast::http::request_parser<boost::beast::http::string_body>> parser_;
+			boost::optional<boost::beast::http::request_parser<boost::beast::http::buffer_body>> stream_parser_;
+
+			/**
+			 * receive buffer for streamed uploads
+			 */
+			std::array<char, 16 * 1024> chunk_;
+
+			/**
+			 * incremental multipart parser of the running upload
+			 */
+			std::unique_ptr<multi_part_parser> mpp_;
+			std::uint64_t payload_size_;
 			queue queue_;
             bool shutdown_;
 			bool authorized_;
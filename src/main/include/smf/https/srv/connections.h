@@ -36,7 +36,9 @@ namespace node
 			connections(cyng::logging::log_ptr
 				, cyng::controller& vm
 				, std::string const& doc_root
-				, auth_dirs const& ad);
+				, auth_dirs const& ad
+				, std::uint64_t body_limit
+				, std::size_t spool_threshold);
 
 			/**
 			 * Provide access to vm controller
@@ -142,6 +144,16 @@ namespace node
 			const std::string doc_root_;
 			const auth_dirs auth_dirs_;
 
+			/**
+			 * max. size of a request body in bytes
+			 */
+			std::uint64_t const body_limit_;
+
+			/**
+			 * uploaded files larger than this are spooled to disk
+			 */
+			std::size_t const spool_threshold_;
+
 			/**
 			 * Generate unique session tags
 			 */
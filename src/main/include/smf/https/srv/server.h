@@ -34,7 +34,9 @@ namespace node
 				, std::string const& doc_root
 				, auth_dirs const& ad
 				, std::set<boost::asio::ip::address> const& blacklist
-				, cyng::controller& vm);
+				, cyng::controller& vm
+				, std::uint64_t body_limit
+				, std::size_t spool_threshold);
 
 			// Start accepting incoming connections
 			bool run();
@@ -33,7 +33,9 @@ namespace node
 				, boost::asio::ip::tcp::socket socket
 				, boost::beast::flat_buffer buffer
 				, std::string const& doc_root
-				, auth_dirs const& ad);
+				, auth_dirs const& ad
+				, std::uint64_t body_limit
+				, std::size_t spool_threshold);
 
 			virtual ~plain_session();
 
@@ -67,7 +69,9 @@ namespace node
 				, boost::asio::ssl::context& ctx
 				, boost::beast::flat_buffer buffer
 				, std::string const& doc_root
-				, auth_dirs const& ad);
+				, auth_dirs const& ad
+				, std::uint64_t body_limit
+				, std::size_t spool_threshold);
 
 			virtual ~ssl_session();
 
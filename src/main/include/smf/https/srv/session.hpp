@@ -17,6 +17,10 @@
 
 #include <cyng/object.h>
 #include <boost/beast/http.hpp>
+#include <boost/optional.hpp>
+
+#include <array>
+#include <memory>
 
 namespace node
 {
@@ -133,7 +137,9 @@ namespace node
 				, boost::asio::io_context& ioc
 				, boost::beast::flat_buffer buffer
 				, std::string const& doc_root
-				, auth_dirs const& ad)
+				, auth_dirs const& ad
+				, std::uint64_t body_limit
+				, std::size_t spool_threshold)
 			: logger_(logger)
 				, connection_manager_(cm)
 				, tag_(tag)
@@ -142,6 +148,14 @@ namespace node
 				, buffer_(std::move(buffer))
 				, doc_root_(doc_root)
 				, auth_dirs_(ad)
+				, body_limit_(body_limit)
+				, spool_threshold_(spool_threshold)
+				, header_parser_()
+				, parser_()
+				, stream_parser_()
+				, chunk_()
+				, mpp_()
+				, payload_size_(0)
 				, queue_(*this)
 				, authorized_(false)
 			{}
@@ -162,19 +176,21 @@ namespace node
 				// Set the timer
 				timer_.expires_after(std::chrono::seconds(15));
 
-				// Make the request empty before reading,
-				// otherwise the operation behavior is undefined.
-				req_ = {};
+				//
+				//	Read the header first. The body limit is checked
+				//	against the content length before any payload is read.
+				//
+				header_parser_.emplace();
+				header_parser_->body_limit(body_limit_);
 
-				// Read a request
-				boost::beast::http::async_read(
+				boost::beast::http::async_read_header(
 					derived().stream(),
 					buffer_,
-					req_,
+					*header_parser_,
 					boost::asio::bind_executor(
 						strand_,
 						std::bind(
-							&session::on_read,
+							&session::on_read_header,
 							&derived(),
 							obj,	//	reference
 							std::placeholders::_1)));
@@ -206,29 +222,69 @@ namespace node
 							std::placeholders::_1)));
 			}
 
-			void on_read(cyng::object obj, boost::system::error_code ec)
+			void on_read_header(cyng::object obj, boost::system::error_code ec)
 			{
-				// Happens when the timer closes the socket
-				if (ec == boost::asio::error::operation_aborted)	{
-					CYNG_LOG_WARNING(logger_, tag() << " - timer aborted session");
-					connection_manager_.stop_session(tag());
-					return;
-				}
+				if (!check_read_error(obj, ec))	return;
 
-				// This means they closed the connection
-				if (ec == boost::beast::http::error::end_of_stream)	{
-					CYNG_LOG_WARNING(logger_, tag() << " - session was closed");
-					return derived().do_eof(obj);
+				auto const& header = header_parser_->get();
+
+				//
+				//	Validate the target before any request handler (including
+				//	the upload) is selected. The body is not read, so the
+				//	connection is closed after the response.
+				//
+				if (!is_valid_target(header.target()))
+				{
+					auto const version = header.version();
+					header_parser_.reset();
+					return queue_(obj, send_bad_request(version
+						, false
+						, "Illegal request-target"));
 				}
 
-				if (ec)	{
-					CYNG_LOG_ERROR(logger_, tag() << " - read: " << ec.message());
-					connection_manager_.stop_session(tag());
+				if (header.method() == boost::beast::http::verb::post
+					&& boost::algorithm::starts_with(header[boost::beast::http::field::content_type], "multipart/form-data"))
+				{
+					//
+					//	stream upload in chunks
+					//
+					stream_parser_.emplace(std::move(*header_parser_));
+					header_parser_.reset();
+					stream_parser_->body_limit(body_limit_);
+					start_upload(obj);
 					return;
 				}
 
+				//
+				//	Read the remaining body into a string. The string_body
+				//	reader reserves the announced content length in advance.
+				//
+				parser_.emplace(std::move(*header_parser_));
+				header_parser_.reset();
+				parser_->body_limit(body_limit_);
+
+				boost::beast::http::async_read(
+					derived().stream(),
+					buffer_,
+					*parser_,
+					boost::asio::bind_executor(
+						strand_,
+						std::bind(
+							&session::on_read,
+							&derived(),
+							obj,	//	reference
+							std::placeholders::_1)));
+			}
+
+			void on_read(cyng::object obj, boost::system::error_code ec)
+			{
+				if (!check_read_error(obj, ec))	return;
+
+				auto req = parser_->release();
+				parser_.reset();
+
 				// See if it is a WebSocket Upgrade
-				if (boost::beast::websocket::is_upgrade(req_))
+				if (boost::beast::websocket::is_upgrade(req))
 				{
 					// Transfer the stream to a new WebSocket session
 					CYNG_LOG_TRACE(logger_, tag() << " -> upgrade");
@@ -236,7 +292,7 @@ namespace node
 					//
 					//	upgrade
 					//
-					connection_manager_.upgrade(tag(), derived().release_stream(), std::move(req_));
+					connection_manager_.upgrade(tag(), derived().release_stream(), std::move(req));
 					timer_.cancel();
 				}
 				else
@@ -246,7 +302,7 @@ namespace node
 					//
 					//	ToDo: substitute cb_
 					//
-					handle_request(obj, std::move(req_));
+					handle_request(obj, std::move(req));
 
 					// If we aren't at the queue limit, try to pipeline another request
 					if (!queue_.is_full()) {
@@ -255,6 +311,34 @@ namespace node
 				}
 			}
 
+			void on_read_chunk(cyng::object obj, boost::system::error_code ec)
+			{
+				//	buffer is full - not an error
+				if (ec == boost::beast::http::error::need_buffer)	ec = {};
+				if (!check_read_error(obj, ec))	return;
+
+				//
+				//	parse payload and generate program sequences
+				//
+				auto const size = chunk_.size() - stream_parser_->get().body().size;
+				mpp_->parse(chunk_.begin(), chunk_.begin() + size);
+
+				if (!stream_parser_->is_done())
+				{
+					return do_read_chunk(obj);
+				}
+
+				//
+				//	upload complete - response is generated by "http.upload.complete"
+				//
+				mpp_.reset();
+				stream_parser_.reset();
+
+				if (!queue_.is_full()) {
+					do_read(obj);
+				}
+			}
+
 			void on_write(cyng::object obj, boost::system::error_code ec, bool close)
 			{
 				// Happens when the timer closes the socket
@@ -361,6 +445,135 @@ namespace node
 
 
 		private:
+			/**
+			 * Request target must be absolute and must not leave the document root.
+			 */
+			static bool is_valid_target(boost::beast::string_view target)
+			{
+				return !target.empty()
+					&& target[0] == '/'
+					&& target.find("..") == boost::beast::string_view::npos
+					;
+			}
+
+			/**
+			 * @return true if the session is still usable
+			 */
+			bool check_read_error(cyng::object obj, boost::system::error_code ec)
+			{
+				// Happens when the timer closes the socket
+				if (ec == boost::asio::error::operation_aborted)	{
+					CYNG_LOG_WARNING(logger_, tag() << " - timer aborted session");
+					connection_manager_.stop_session(tag());
+					return false;
+				}
+
+				// This means they closed the connection
+				if (ec == boost::beast::http::error::end_of_stream)	{
+					CYNG_LOG_WARNING(logger_, tag() << " - session was closed");
+					derived().do_eof(obj);
+					return false;
+				}
+
+				//	content length exceeds configured limit
+				if (ec == boost::beast::http::error::body_limit)	{
+					CYNG_LOG_WARNING(logger_, tag() << " body limit of " << body_limit_ << " bytes exceeded");
+
+					//
+					//	answer with the HTTP version of the request
+					//
+					std::uint32_t version{ 11 };
+					if (stream_parser_)	version = stream_parser_->get().version();
+					else if (parser_)	version = parser_->get().version();
+					else if (header_parser_)	version = header_parser_->get().version();
+
+					mpp_.reset();
+					stream_parser_.reset();
+					parser_.reset();
+					header_parser_.reset();
+
+					//	413 - closes connection after sending
+					queue_(obj, send_payload_too_large(version));
+					return false;
+				}
+
+				if (ec)	{
+					CYNG_LOG_ERROR(logger_, tag() << " - read: " << ec.message());
+					connection_manager_.stop_session(tag());
+					return false;
+				}
+				return true;
+			}
+
+			/**
+			 * Start incremental parsing of a multipart/form-data upload.
+			 * The body is read in chunks and never held completely in memory.
+			 */
+			void start_upload(cyng::object obj)
+			{
+				auto const& header = stream_parser_->get();
+				auto const target = header.target();
+
+				//
+				//	without content length the progress cannot be calculated
+				//
+				auto const content_length = stream_parser_->content_length();
+				if (!content_length || (*content_length == 0)) {
+					CYNG_LOG_WARNING(logger_, "no payload for " << target);
+					auto const version = header.version();
+					stream_parser_.reset();
+					return queue_(obj, send_bad_request(version
+						, false
+						, "content length required"));
+				}
+
+				payload_size_ = *content_length;
+				CYNG_LOG_INFO(logger_, payload_size_ << " bytes posted to " << target);
+
+				mpp_ = std::unique_ptr<node::http::multi_part_parser>(new node::http::multi_part_parser([this](cyng::vector_t&& prg) {
+
+					//	executed by HTTPS session
+					connection_manager_.vm().async_run(std::move(prg));
+
+				}, logger_
+					, payload_size_
+					, target
+					, tag_
+					, spool_threshold_));
+
+				//
+				//	open new upload sequence
+				//
+				connection_manager_.vm().async_run(cyng::generate_invoke("http.upload.start"
+					, tag_
+					, header.version()
+					, std::string(target.begin(), target.end())
+					, payload_size_));
+
+				do_read_chunk(obj);
+			}
+
+			void do_read_chunk(cyng::object obj)
+			{
+				//	each chunk restarts the timer
+				timer_.expires_after(std::chrono::seconds(15));
+
+				stream_parser_->get().body().data = chunk_.data();
+				stream_parser_->get().body().size = chunk_.size();
+
+				boost::beast::http::async_read(
+					derived().stream(),
+					buffer_,
+					*stream_parser_,
+					boost::asio::bind_executor(
+						strand_,
+						std::bind(
+							&session::on_read_chunk,
+							&derived(),
+							obj,	//	reference
+							std::placeholders::_1)));
+			}
+
 			void handle_request(cyng::object obj, boost::beast::http::request<boost::beast::http::string_body>&& req)
 			{
 				if (req.method() != boost::beast::http::verb::get &&
@@ -372,9 +585,7 @@ namespace node
 						, "Unknown HTTP-method"));
 				}
 
-				if (req.target().empty() ||
-					req.target()[0] != '/' ||
-					req.target().find("..") != boost::beast::string_view::npos)
+				if (!is_valid_target(req.target()))
 				{
 					return queue_(obj, send_bad_request(req.version()
 						, req.keep_alive()
@@ -530,7 +741,7 @@ namespace node
 							, req.version()
 							, std::string(target.begin(), target.end())
 							, payload_size
-							, std::string(req.body().begin(), req.body().end())));
+							, std::move(req.body())));
 
 					}
 					//	Content-Type:application/json; charset=UTF-8
@@ -541,7 +752,7 @@ namespace node
 							, req.version()
 							, std::string(target.begin(), target.end())
 							, payload_size
-							, std::string(req.body().begin(), req.body().end())));
+							, std::move(req.body())));
 
 					}
 					else if (boost::algorithm::starts_with(content_type, "application/x-www-form-urlencoded"))
@@ -552,44 +763,10 @@ namespace node
 							, req.version()
 							, std::string(target.begin(), target.end())
 							, payload_size
-							, std::string(req.body().begin(), req.body().end())));
-
-					}
-					else if (boost::algorithm::starts_with(content_type, "multipart/form-data"))
-					{
-						//
-						//	payload parser
-						//
-						if (req.payload_size()) {
-
-							node::http::multi_part_parser mpp([&](cyng::vector_t&& prg) {
-
-								//	executed by HTTP/s session
-								connection_manager_.vm().async_run(std::move(prg));
+							, std::move(req.body())));
 
-							}	, logger_
-								, payload_size
-								, target
-								, tag_);
-
-							//
-							//	open new upload sequence
-							//
-							connection_manager_.vm().async_run(cyng::generate_invoke("http.upload.start"
-								, tag_
-								, req.version()
-								, std::string(target.begin(), target.end())
-								, payload_size));
-
-							//
-							//	parse payload and generate program sequences
-							//
-							mpp.parse(req.body().begin(), req.body().end());
-						}
-						else {
-							CYNG_LOG_WARNING(logger_, "no payload for " << target);
-						}
 					}
+					//	multipart/form-data is streamed (see start_upload())
 					else
 					{
 						CYNG_LOG_WARNING(logger_, "unknown MIME content type: " << content_type);
@@ -612,6 +789,18 @@ namespace node
 				return res;
 			}
 
+			boost::beast::http::response<boost::beast::http::string_body> send_payload_too_large(std::uint32_t version)
+			{
+				CYNG_LOG_WARNING(logger_, "413 - payload too large");
+				boost::beast::http::response<boost::beast::http::string_body> res{ boost::beast::http::status::payload_too_large, version };
+				res.set(boost::beast::http::field::server, NODE::version_string);
+				res.set(boost::beast::http::field::content_type, "text/html");
+				res.keep_alive(false);
+				res.body() = "Payload exceeds " + std::to_string(body_limit_) + " bytes";
+				res.prepare_payload();
+				return res;
+			}
+
 			boost::beast::http::response<boost::beast::http::string_body> send_not_found(std::uint32_t version
 				, bool keep_alive
 				, std::string target)
@@ -712,7 +901,36 @@ namespace node
 		private:
 			const std::string doc_root_;
 			const auth_dirs& auth_dirs_;
-			boost::beast::http::request<boost::beast::http::string_body> req_;
+
+			/**
+			 * max. size of a request body
+			 */
+			std::uint64_t const body_limit_;
+
+			/**
+			 * uploaded files larger than this are spooled to disk
+			 */
+			std::size_t const spool_threshold_;
+
+			/**
+			 * The header is read first. Depending on method and content type
+			 * the body is read completely (string_body) or streamed
+			 * in chunks (buffer_body).
+			 */
+			boost::optional<boost::beast::http::request_parser<boost::beast::http::empty_body>> header_parser_;
+			boost::optional<boost::beast::http::request_parser<boost::beast::http::string_body>> parser_;
+			boost::optional<boost::beast::http::request_parser<boost::beast::http::buffer_body>> stream_parser_;
+
+			/**
+			 * receive buffer for streamed uploads
+			 */
+			std::array<char, 16 * 1024> chunk_;
+
+			/**
+			 * incremental multipart parser of the running upload
+			 */
+			std::unique_ptr<node::http::multi_part_parser> mpp_;
+			std::uint64_t payload_size_;
 			queue queue_;
 			bool authorized_;
 
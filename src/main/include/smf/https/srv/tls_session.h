@@ -0,0 +1,60 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#ifndef NODE_HTTPS_TLS_SESSION_H
+#define NODE_HTTPS_TLS_SESSION_H
+
+#include <cyng/log.h>
+#include <cyng/intrinsics/sets.h>
+#include <boost/asio/ssl/context.hpp>
+
+#include <chrono>
+#include <string>
+
+namespace node
+{
+	namespace https
+	{
+		/**
+		 * Enable server side TLS session resumption. Clients that reconnect
+		 * can skip the full handshake.
+		 *
+		 * Sessions are kept in a server cache (session id) and issued as
+		 * session tickets. Ticket keys are random and owned by the context.
+		 * A new key is generated after the rotation interval. The previous
+		 * key is still accepted for one more interval. Tickets decrypted
+		 * with that key are renewed. Keys are rotated when a ticket is
+		 * issued or decrypted, but a key is never accepted longer than
+		 * two intervals after it was generated.
+		 *
+		 * @param id session id context, e.g. the node name
+		 * @param cache_size max number of cached sessions
+		 * @param timeout lifetime of a session
+		 * @param rotation ticket key lifetime
+		 * @return false if session tickets could not be configured
+		 */
+		bool enable_session_resumption(boost::asio::ssl::context& ctx
+			, std::string const& id
+			, std::size_t cache_size
+			, std::chrono::seconds timeout
+			, std::chrono::seconds rotation);
+
+		/**
+		 * Read "tls-session-cache" (0 disables resumption), "tls-session-timeout"
+		 * and "tls-ticket-rotation" (both in seconds) from the server
+		 * configuration and enable session resumption.
+		 *
+		 * @param id session id context, e.g. the node name
+		 */
+		void setup_session_resumption(boost::asio::ssl::context& ctx
+			, cyng::logging::log_ptr logger
+			, std::string const& id
+			, cyng::tuple_t const& cfg);
+	}
+}
+
+#endif
@@ -13,6 +13,8 @@
 #include <smf/ipt/config.h>
 #include <smf/ipt/parser.h>
 #include <smf/ipt/serializer.h>
+#include <smf/ipt/push_pool.h>
+#include <smf/ipt/push_reassembly.h>
 
 #include <cyng/log.h>
 #include <cyng/async/mux.h>
@@ -109,11 +111,45 @@ namespace node
 				, std::uint8_t window_size
 				, std::chrono::seconds);
 
+			/**
+			 * Transfer push data to the specified target.
+			 *
+			 * Push channels are kept open and reused for subsequent transfers
+			 * to the same target. A channel is opened on demand and closed
+			 * after an idle time of push_pool_idle_timeout. Large payloads are
+			 * split into blocks of the packet size of the channel and up to
+			 * window size blocks are sent without waiting for a response.
+			 * Failed blocks are sent again.
+			 *
+			 * @param tsk receives (bool success, std::string target) in slot 1
+			 * when all blocks are confirmed or the data are dropped.
+			 */
+			void req_transfer_push_data(std::string const& target
+				, cyng::buffer_t const& data
+				, std::size_t tsk = cyng::async::NO_TASK);
+
 			/**
 			 * @return a textual description of the bus/connection state
 			 */
 			std::string get_state() const;
 
+			/**
+			 * In a sharded cluster a login can be rejected with the
+			 * address of the responsible IP-T node.
+			 *
+			 * @return redirect address (host:port) of the last failed
+			 * login or an empty string.
+			 */
+			std::string const& get_redirect() const;
+
+			/**
+			 * Stop/continue reading from the master. Incoming data remain
+			 * in the socket buffers and TCP flow control slows down the
+			 * sender. All requests of the master (e.g. watchdog) are
+			 * delayed too. Thread safe.
+			 */
+			void throttle(bool);
+
 		private:
 			void do_read();
 
@@ -144,6 +180,32 @@ namespace node
 			void store_relation(cyng::context& ctx);
 			void remove_relation(cyng::context& ctx);
 
+			void pool_push_data(cyng::context& ctx);
+			void pool_track_open(cyng::context& ctx);
+			void pool_track_transfer(cyng::context& ctx);
+			void pool_expire(cyng::context& ctx);
+			void pool_clear(cyng::context& ctx);
+
+			/**
+			 * post the results of confirmed or dropped payloads to the tasks
+			 */
+			void pool_results();
+
+			/**
+			 * send open push channel request for a pooled channel
+			 */
+			void pool_open(cyng::context& ctx, std::string const& target);
+
+			/**
+			 * send blocks on a pooled channel until the window is full
+			 */
+			void pool_drain(cyng::context& ctx, std::string const& target);
+
+			/**
+			 * stop idle monitor of push channel pool
+			 */
+			void stop_pool_monitor();
+
 		protected:
 			/**
 			 * The logger instance
@@ -197,6 +259,11 @@ namespace node
 			 */
 			std::uint16_t watchdog_;
 
+			/**
+			 * redirect address of the last failed login
+			 */
+			std::string redirect_;
+
 			/**
 			 * session state
 			 */
@@ -212,11 +279,38 @@ namespace node
 			};
 			std::atomic<state>	state_;
 
+			/**
+			 * throttle() was called - don't read
+			 */
+			std::atomic<bool>	throttled_;
+
+			/**
+			 * no read operation pending because of throttle()
+			 */
+			std::atomic<bool>	read_suspended_;
+
 			/**
 			 * bookkeeping of ip-t sequence to task relation
 			 */
 			std::map<sequence_type, std::size_t>	task_db_;
 
+			/**
+			 * open push channels by target name.
+			 * Accessed by VM functions only.
+			 */
+			push_pool	pool_;
+
+			/**
+			 * task to close idle push channels
+			 */
+			std::atomic<std::size_t> tsk_pool_;
+
+			/**
+			 * payloads of incoming push channels.
+			 * Accessed by VM functions only.
+			 */
+			push_reassembly	reassembly_;
+
 			/**
 			 * Check if transition to new state is valid.
 			 */
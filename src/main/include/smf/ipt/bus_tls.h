@@ -114,6 +114,15 @@ namespace node
 			 */
 			std::string get_state() const;
 
+			/**
+			 * In a sharded cluster a login can be rejected with the
+			 * address of the responsible IP-T node.
+			 *
+			 * @return redirect address (host:port) of the last failed
+			 * login or an empty string.
+			 */
+			std::string const& get_redirect() const;
+
 		private:
 			void do_read();
 
@@ -197,6 +206,11 @@ namespace node
 			 */
 			std::uint16_t watchdog_;
 
+			/**
+			 * redirect address of the last failed login
+			 */
+			std::string redirect_;
+
 			/**
 			 * session state
 			 */
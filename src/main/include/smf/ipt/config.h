@@ -12,6 +12,7 @@
 #include <smf/ipt/scramble_key.h>
 #include <cyng/intrinsics/sets.h>
 #include <chrono>
+#include <memory>
 
 namespace node
 {
@@ -57,7 +58,17 @@ namespace node
 			bool next() const;
 
 			/**
-			 * get current reduncancy
+			 * Use the specified address (host:port) with the credentials
+			 * of the current redundancy for the next login. This is required
+			 * to follow a redirect of a sharded cluster. next() drops the
+			 * redirect.
+			 *
+			 * @return false if address is empty or invalid
+			 */
+			bool redirect(std::string const& address) const;
+
+			/**
+			 * get current reduncancy (or redirect)
 			 */
 			master_record const& get() const;
 
@@ -75,6 +86,11 @@ namespace node
 			 * index of current ipt master configuration
 			 */
 			mutable std::size_t master_;
+
+			/**
+			 * redirected master
+			 */
+			mutable std::shared_ptr<master_record const> redirect_;
 			 
 		};
 	}
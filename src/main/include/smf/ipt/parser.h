@@ -12,7 +12,7 @@
 #include <smf/ipt/scramble_key.h>
 
 #include <cyng/intrinsics/sets.h>
-#include <cyng/crypto/scrambler.hpp>
+#include <smf/ipt/scrambler.h>
 #include <cyng/vm/generator.h>
 
 #include <boost/asio.hpp>
@@ -36,7 +36,7 @@ namespace node
 		{
 		public:
 			using parser_callback = std::function<void(cyng::vector_t&&)>;
-			using scrambler_t = cyng::crypto::scrambler<char, scramble_key::SCRAMBLE_KEY_LENGTH>;
+			using scrambler_t = scrambler;
 
 		private:
 			/**
@@ -303,15 +303,35 @@ namespace node
 			template < typename I >
 			cyng::buffer_t read(I start, I end)
 			{
-				cyng::buffer_t buffer;
-				buffer.reserve(std::distance(start, end));
-				std::for_each(start, end, [this, &buffer](char c)
+				cyng::buffer_t buffer(start, end);
+				std::size_t const size = buffer.size();
+				std::size_t pos = 0;
+				while (pos < size)
 				{
 					//
-					//	Decode input stream
+					//	Decode remaining input stream in one pass
 					//
-					buffer.push_back(this->put(scrambler_[c]));
-				});
+					scrambler_t const prev = scrambler_;
+					scrambler_.apply(buffer.data() + pos, size - pos);
+
+					auto const gen = scrambler_.generation();
+					std::size_t const first = pos;
+					while (pos < size && scrambler_.generation() == gen)
+					{
+						this->put(buffer[pos++]);
+					}
+
+					if (pos < size)
+					{
+						//
+						//	Parser switched the scramble key (login). Restore the
+						//	rest of the input and decode it with the new key.
+						//
+						scrambler_t undo = prev;
+						undo.skip(pos - first);
+						undo.apply(buffer.data() + pos, size - pos);
+					}
+				}
 
 				if (read_counter_ == 0u && buffer.size() > 1) {
 					//BOOST_ASSERT_MSG((buffer.at(0) == 0x01 || buffer.at(0) == 0x02), "IP-T login expected (0)");
@@ -0,0 +1,250 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#ifndef NODE_IPT_PUSH_POOL_H
+#define NODE_IPT_PUSH_POOL_H
+
+#include <smf/ipt/defs.h>
+#include <cyng/intrinsics/buffer.h>
+
+#include <chrono>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace node
+{
+	namespace ipt
+	{
+		/**
+		 * Push channels are closed after this time without any transfer
+		 */
+		constexpr std::chrono::seconds push_pool_idle_timeout{ 60 };
+
+		/**
+		 * Number of retransmissions of a failed block. After that all
+		 * pending data of the target are dropped.
+		 */
+		constexpr std::size_t push_pool_max_retries = 3;
+
+		/**
+		 * Upper limit of blocks in flight. Block numbers are 8 bit
+		 * and the receiver has to tell retransmitted blocks from
+		 * duplicates.
+		 */
+		constexpr std::size_t push_pool_max_window = 127;
+
+		/**
+		 * Bookkeeping of push channels that are kept open across transfers.
+		 * One channel per target name.
+		 *
+		 * Data are queued while a channel is being opened. Payloads larger
+		 * than the packet size of the channel are split into blocks. Up to
+		 * window size blocks are sent without waiting for a response.
+		 * The first block of a payload is marked with SYN, all following blocks
+		 * with ACK and the last one with FIN. Block numbers are counted per
+		 * channel (modulo 256).
+		 * Each transfer sequence is tracked separately. A failed block is sent
+		 * again with the same block number and status on the same channel,
+		 * so the receiver can put it in place. Confirmed blocks are never
+		 * sent again.
+		 *
+		 * Not thread safe. The bus uses this class from its VM only.
+		 */
+		class push_pool
+		{
+		public:
+			/**
+			 * channel state of a target
+			 */
+			enum status {
+				POOL_CLOSED,	//!<	no channel - open request required
+				POOL_OPENING,	//!<	open request is pending
+				POOL_OPEN,		//!<	channel can be used
+			};
+
+			struct channel
+			{
+				std::uint32_t channel_;
+				std::uint32_t source_;
+			};
+
+			struct segment
+			{
+				std::uint8_t status_;	//!<	SYN, ACK, FIN and priority
+				std::uint8_t block_;	//!<	block number
+				cyng::buffer_t data_;
+			};
+
+			/**
+			 * outcome of a payload
+			 */
+			struct result
+			{
+				std::size_t tsk_;	//!<	task specified with enqueue()
+				std::string target_;
+				bool success_;	//!<	false if the payload was dropped
+			};
+
+		private:
+			struct payload
+			{
+				cyng::buffer_t data_;
+				std::size_t offset_;	//!<	bytes already sent
+				std::size_t unconfirmed_;	//!<	blocks sent but not confirmed
+				std::size_t tsk_;	//!<	receives the result
+			};
+
+			/**
+			 * a block that was sent but not confirmed
+			 */
+			struct flight
+			{
+				std::uint64_t serial_;	//!<	serial number of the payload
+				segment seg_;
+				std::size_t retries_;	//!<	number of retransmissions
+			};
+
+			struct entry
+			{
+				entry();
+
+				status status_;
+				channel channel_;
+				std::chrono::steady_clock::time_point last_use_;
+				std::size_t block_size_;	//!<	max payload of a single transfer
+				std::size_t window_;	//!<	max blocks in flight
+				std::uint8_t block_;	//!<	next block number
+				std::size_t in_flight_;	//!<	sent but not confirmed
+				std::deque<payload> pending_;	//!<	payloads not confirmed completely
+				std::size_t cut_;	//!<	index of the first payload with unsent data
+				std::uint64_t first_;	//!<	serial number of the first pending payload
+				std::deque<flight> sent_;	//!<	blocks waiting for the sequence number
+				std::deque<flight> resend_;	//!<	failed blocks
+			};
+
+		public:
+			push_pool(std::chrono::seconds idle_timeout, std::size_t max_retries);
+
+			/**
+			 * @param ch receives channel and source id if status is POOL_OPEN
+			 * @return channel status of the specified target
+			 */
+			status get_status(std::string const& target, channel& ch) const;
+
+			/**
+			 * Queue data. Creates an entry in state POOL_OPENING if the 
+			 * target is unknown.
+			 *
+			 * @param tsk is reported with the result of this payload
+			 */
+			void enqueue(std::string const& target, cyng::buffer_t const& data, std::size_t tsk);
+
+			/**
+			 * Assign the sequence of an open push channel request
+			 */
+			void track_open(sequence_type seq, std::string const& target);
+
+			/**
+			 * Open push channel response. Block size and window are derived
+			 * from the packet and window size of the channel.
+			 *
+			 * @param target receives the target name
+			 * @return false if sequence was not issued by this pool
+			 */
+			bool opened(sequence_type seq
+				, bool success
+				, std::uint32_t channel
+				, std::uint32_t source
+				, std::uint16_t packet_size
+				, std::uint8_t window_size
+				, std::string& target);
+
+			/**
+			 * Take the next block to send if the channel is open and the
+			 * window is not full. Failed blocks are sent first.
+			 * Every block returned has to be tracked with track_transfer().
+			 *
+			 * @param ch receives channel and source id
+			 * @return false if there is nothing to send
+			 */
+			bool next(std::string const& target, channel& ch, segment& seg);
+
+			/**
+			 * Assign the sequence of the oldest block returned by next()
+			 * that is not tracked yet.
+			 */
+			void track_transfer(sequence_type seq, std::string const& target);
+
+			/**
+			 * Push data transfer response. A failed block is queued
+			 * for retransmission. After more than max_retries retransmissions
+			 * of the same block the target is removed.
+			 *
+			 * @param target receives the target name
+			 * @return false if sequence was not issued by this pool
+			 */
+			bool transferred(sequence_type seq
+				, bool success
+				, std::string& target);
+
+			/**
+			 * Remove all open channels without any activity since
+			 * the idle timeout and without pending data.
+			 *
+			 * @return channels to close
+			 */
+			std::vector<channel> expire(std::chrono::steady_clock::time_point now);
+
+			/**
+			 * @return all open channels and clear the pool
+			 */
+			std::vector<channel> clear();
+
+			/**
+			 * @return number of targets
+			 */
+			std::size_t size() const;
+
+			/**
+			 * @return all payloads that are confirmed completely or dropped
+			 * since the last call - in order
+			 */
+			std::vector<result> get_results();
+
+		private:
+			void remove(std::map<std::string, entry>::iterator);
+
+			/**
+			 * ignore all responses of the specified target
+			 */
+			void forget(std::string const& target);
+
+			/**
+			 * report all pending payloads of the target as dropped
+			 */
+			void drop(std::string const& target, entry const&);
+
+		private:
+			std::chrono::seconds const idle_timeout_;
+			std::size_t const max_retries_;
+
+			std::map<std::string, entry> targets_;
+			std::map<sequence_type, std::string> open_requests_;
+
+			/**
+			 * transfer sequence => target and block
+			 */
+			std::map<sequence_type, std::pair<std::string, flight>> transfers_;
+
+			std::vector<result> results_;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,108 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#ifndef NODE_IPT_PUSH_REASSEMBLY_H
+#define NODE_IPT_PUSH_REASSEMBLY_H
+
+#include <cyng/intrinsics/buffer.h>
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace node
+{
+	namespace ipt
+	{
+		/**
+		 * Restores the payloads of a push channel from the received blocks.
+		 *
+		 * A SYN block starts a stream. Blocks are numbered per channel
+		 * (modulo 256). Blocks ahead of the expected one are parked until
+		 * the gap is closed. Blocks behind are duplicates and dropped.
+		 * A payload is complete with a FIN block. A stream is removed as
+		 * soon as nothing is pending, so only incomplete payloads take memory.
+		 * Streams without progress are removed by expire().
+		 *
+		 * Senders that send every payload as a single block (status 0xC1)
+		 * with a constant block number are supported too. Data without SYN
+		 * and without a stream in progress are passed through unchanged.
+		 *
+		 * Not thread safe. The bus uses this class from its VM only.
+		 */
+		class push_reassembly
+		{
+			struct stream
+			{
+				explicit stream(std::uint8_t block);
+
+				std::uint8_t expected_;	//!<	next block number
+				bool partial_;	//!<	payload in progress
+				cyng::buffer_t payload_;
+				std::map<std::uint8_t, std::pair<std::uint8_t, cyng::buffer_t>>	parked_;	//!<	block => status, data
+				std::chrono::steady_clock::time_point last_use_;
+			};
+
+		public:
+			/**
+			 * @param max_parked streams with more blocks waiting for
+			 * a missing block are reset.
+			 */
+			push_reassembly(std::size_t max_parked);
+
+			/**
+			 * Add a received block.
+			 *
+			 * @return all payloads completed by this block in order
+			 */
+			std::vector<cyng::buffer_t> put(std::uint32_t channel
+				, std::uint32_t source
+				, std::uint8_t status
+				, std::uint8_t block
+				, cyng::buffer_t const& data);
+
+			/**
+			 * Remove all streams without a block since the specified timeout.
+			 * The sender of these streams is gone (channel closed).
+			 *
+			 * @return number of removed streams
+			 */
+			std::size_t expire(std::chrono::steady_clock::time_point now, std::chrono::seconds timeout);
+
+			/**
+			 * remove all streams
+			 */
+			void clear();
+
+			/**
+			 * @return number of streams
+			 */
+			std::size_t size() const;
+
+		private:
+			/**
+			 * Append block with the expected number
+			 */
+			void append(stream&
+				, std::uint8_t status
+				, cyng::buffer_t const& data
+				, std::vector<cyng::buffer_t>&);
+
+		private:
+			std::size_t const max_parked_;
+
+			/**
+			 * channel and source => stream
+			 */
+			std::map<std::pair<std::uint32_t, std::uint32_t>, stream> streams_;
+		};
+	}
+}
+
+#endif
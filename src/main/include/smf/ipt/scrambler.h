@@ -0,0 +1,88 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#ifndef NODE_IPT_SCRAMBLER_H
+#define NODE_IPT_SCRAMBLER_H
+
+#include <smf/ipt/scramble_key.h>
+#include <cstdint>
+#include <cstddef>
+
+namespace node
+{
+	namespace ipt
+	{
+		/**
+		 * XOR stream cipher of the IP-T protocol.
+		 *
+		 * Same results as cyng::crypto::scrambler<char, 32> but with
+		 * an interface to scramble whole buffers. The key is rotated
+		 * to the current offset once per call and applied in blocks
+		 * of 32 bytes using vector registers if available.
+		 */
+		class scrambler
+		{
+		public:
+			using key_type = scramble_key::key_type;
+			enum { KEY_LENGTH = scramble_key::SCRAMBLE_KEY_LENGTH };
+
+		public:
+			/**
+			 * Initialized with a null key (no scrambling)
+			 */
+			scrambler();
+
+			/**
+			 * Set new key and start with offset 0
+			 */
+			scrambler& operator=(key_type const&);
+
+			/**
+			 * Set null key and offset 0
+			 */
+			void reset();
+
+			/**
+			 * scramble a single byte
+			 */
+			char operator[](char c);
+
+			/**
+			 * scramble buffer in place
+			 */
+			void apply(char* p, std::size_t size);
+
+			/**
+			 * scramble size bytes from src into dst
+			 */
+			void apply(char const* src, char* dst, std::size_t size);
+
+			/**
+			 * advance key offset without processing any data
+			 */
+			void skip(std::size_t size);
+
+			/**
+			 * @return current key offset
+			 */
+			std::size_t offset() const;
+
+			/**
+			 * @return number of key changes. Allows to detect
+			 * key changes during processing.
+			 */
+			std::uint64_t generation() const;
+
+		private:
+			key_type key_;
+			std::size_t offset_;
+			std::uint64_t generation_;
+		};
+	}
+}
+
+#endif
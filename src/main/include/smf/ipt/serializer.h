@@ -11,7 +11,7 @@
 #include <smf/ipt/defs.h>
 #include <smf/ipt/scramble_key.h>
 #include <NODE_project_info.h>
-#include <cyng/crypto/scrambler.hpp>
+#include <smf/ipt/scrambler.h>
 #include <cyng/vm/controller.h>
 #include <cyng/crypto/rotating_counter.hpp>
 #include <type_traits>
@@ -24,7 +24,7 @@ namespace node
 		class serializer
 		{
 		public:
-			using scrambler_t = cyng::crypto::scrambler<char, scramble_key::SCRAMBLE_KEY_LENGTH>;
+			using scrambler_t = scrambler;
 			using seq_generator = cyng::circular_counter< std::uint8_t, 1, 0xff >;
 
 		public:
@@ -0,0 +1,91 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#ifndef NODE_MBUS_AES_H
+#define NODE_MBUS_AES_H
+
+#include <cyng/intrinsics/buffer.h>
+#include <openssl/evp.h>
+#include <array>
+#include <map>
+#include <memory>
+#include <cstdint>
+
+namespace node
+{
+	namespace wmbus
+	{
+		/**
+		 * Decryption of wireless M-Bus telegrams (EN 13757-7).
+		 *
+		 * A cipher context with the expanded AES key of each meter
+		 * is cached, so the key expansion runs only once per meter
+		 * (and again when the key changes). Only the IV is set for
+		 * each telegram.
+		 */
+		class key_cache
+		{
+			using ctx_ptr = std::unique_ptr<EVP_CIPHER_CTX, decltype(&EVP_CIPHER_CTX_free)>;
+
+			struct entry
+			{
+				entry();
+
+				std::array<unsigned char, 16>	key_;
+				ctx_ptr	ctx_;
+			};
+
+		public:
+			/**
+			 * @param max_size max. number of cached cipher contexts
+			 */
+			explicit key_cache(std::size_t max_size);
+
+			/**
+			 * Security mode 5: AES-128-CBC with dynamic initialization vector.
+			 * Decryption takes place in place.
+			 *
+			 * @param server_id meter ID (key of the cache)
+			 * @param key 16 bytes AES key
+			 * @param iv initialization vector
+			 * @param data first encrypted byte
+			 * @param size size of encrypted data - must be a multiple of 16
+			 * @return false if key or data size is invalid or the decrypted data
+			 * don't start with the idle filler 0x2F2F
+			 */
+			bool decrypt_mode_5(cyng::buffer_t const& server_id
+				, cyng::buffer_t const& key
+				, std::array<unsigned char, 16> const& iv
+				, char* data
+				, std::size_t size);
+
+			/**
+			 * Remove the cached cipher context of the specified meter.
+			 */
+			void erase(cyng::buffer_t const& server_id);
+
+			/**
+			 * clear cache
+			 */
+			void clear();
+
+			/**
+			 * @return number of cached cipher contexts
+			 */
+			std::size_t size() const;
+
+		private:
+			EVP_CIPHER_CTX* lookup(cyng::buffer_t const& server_id, cyng::buffer_t const& key);
+
+		private:
+			std::size_t const max_size_;
+			std::map<cyng::buffer_t, entry>	cache_;
+		};
+	}
+}	//	node
+
+#endif
@@ -0,0 +1,87 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#ifndef NODE_MBUS_DATA_RECORD_H
+#define NODE_MBUS_DATA_RECORD_H
+
+#include <smf/mbus/vif_table.h>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+namespace node
+{
+	namespace mbus
+	{
+		/**
+		 * Data type of a decoded record
+		 */
+		enum record_type : std::uint8_t
+		{
+			RECORD_NONE = 0,	//	no data
+			RECORD_INTEGER,		//	value_.i_
+			RECORD_REAL,		//	value_.f_
+			RECORD_BCD,			//	value_.i_ (decoded BCD)
+			RECORD_DATE,		//	value_.i_ as YYYYMMDD
+			RECORD_DATE_TIME,	//	value_.i_ as YYYYMMDDhhmm
+			RECORD_STRING,		//	offset_/size_ refer to the input buffer
+			RECORD_INVALID,		//	invalid BCD digits or unsupported coding
+		};
+
+		/**
+		 * Plain record of a decoded variable data block.
+		 * There is no dynamic memory involved.
+		 */
+		struct data_record
+		{
+			record_type	type_;
+			vif_type	vif_;
+			unit_code	unit_;
+			std::int8_t	scaler_;
+			std::uint8_t func_;	//	0 - instantaneous, 1 - maximum, 2 - minimum, 3 - value during error state
+			std::uint8_t size_;	//	size of data field in bytes
+			std::uint16_t offset_;	//	offset of data field in input buffer
+			std::uint16_t sub_unit_;
+			std::uint32_t tariff_;
+			std::uint64_t storage_nr_;
+			union {
+				std::int64_t i_;
+				double f_;
+			} value_;
+		};
+
+		static_assert(std::is_trivial<data_record>::value, "data_record must be a POD");
+
+		/**
+		 * Decode all variable data blocks of the specified buffer.
+		 * Idle fillers (0x2F) are skipped. Decoding stops at manufacturer specific 
+		 * data (DIF 0x0F/0x1F), at the end of input or when the record array is full.
+		 *
+		 * @param data input buffer (decrypted)
+		 * @param size size of input buffer
+		 * @param records caller provided array
+		 * @param capacity size of record array
+		 * @param count number of decoded records
+		 * @return offset of first byte not decoded
+		 */
+		std::size_t decode_records(char const* data
+			, std::size_t size
+			, data_record* records
+			, std::size_t capacity
+			, std::size_t& count);
+
+		/**
+		 * Decode BCD encoded data field in one go.
+		 * A leading 0xF nibble indicates a negative value.
+		 *
+		 * @return false if the data field contains invalid digits
+		 */
+		bool decode_bcd(unsigned char const* p, std::size_t size, std::int64_t& value);
+	}
+}	//	node
+
+#endif
@@ -0,0 +1,95 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#ifndef NODE_MBUS_DEDUP_H
+#define NODE_MBUS_DEDUP_H
+
+#include <cstdint>
+#include <chrono>
+#include <deque>
+#include <unordered_set>
+
+namespace node
+{
+	namespace wmbus
+	{
+		/**
+		 * Drop telegrams that were already received within
+		 * a specified time window. In dense deployments the same
+		 * telegram arrives several times from different repeaters.
+		 *
+		 * A telegram is identified by manufacturer, device ID, access number
+		 * and CRC. Device IDs are unique per manufacturer only.
+		 * Entries expire in the order of insertion, so purging is
+		 * a simple walk from the front of the queue.
+		 */
+		class dedup
+		{
+		public:
+			using clock_t = std::chrono::steady_clock;
+
+		private:
+			struct key
+			{
+				std::uint16_t manufacturer_;
+				std::uint32_t id_;
+				std::uint8_t access_no_;
+				std::uint16_t crc_;
+
+				bool operator==(key const&) const;
+			};
+
+			struct key_hash
+			{
+				std::size_t operator()(key const&) const;
+			};
+
+			struct entry
+			{
+				key key_;
+				clock_t::time_point tp_;
+			};
+
+		public:
+			/**
+			 * @param window time span a telegram is remembered
+			 * @param max_size upper limit of remembered telegrams
+			 */
+			dedup(std::chrono::seconds window, std::size_t max_size);
+
+			/**
+			 * @return true if the telegram is new. false if it is a duplicate.
+			 */
+			bool test_and_set(std::uint16_t manufacturer, std::uint32_t id, std::uint8_t access_no, std::uint16_t crc);
+			bool test_and_set(std::uint16_t manufacturer, std::uint32_t id, std::uint8_t access_no, std::uint16_t crc, clock_t::time_point now);
+
+			/**
+			 * Remove all expired entries
+			 */
+			void purge(clock_t::time_point now);
+
+			/**
+			 * @return number of remembered telegrams
+			 */
+			std::size_t size() const;
+
+			/**
+			 * @return number of dropped duplicates since start
+			 */
+			std::uint64_t get_duplicates() const;
+
+		private:
+			std::chrono::seconds const window_;
+			std::size_t const max_size_;
+			std::unordered_set<key, key_hash> set_;
+			std::deque<entry>	queue_;
+			std::uint64_t duplicates_;
+		};
+	}
+}	//	node
+
+#endif
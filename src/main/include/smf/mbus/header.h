@@ -0,0 +1,112 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#ifndef NODE_MBUS_HEADER_H
+#define NODE_MBUS_HEADER_H
+
+#include <cyng/intrinsics/buffer.h>
+#include <cstdint>
+#include <array>
+
+namespace node
+{
+	namespace wmbus
+	{
+		//
+		//	CI fields of the transport layer (EN 13757-7)
+		//
+		constexpr std::uint8_t CI_LONG_HEADER = 0x72;	//	response with long header
+		constexpr std::uint8_t CI_SHORT_HEADER = 0x7A;	//	response with short header
+		constexpr std::uint8_t CI_NO_HEADER = 0x78;	//	response without header
+
+		/**
+		 * Idle filler. An encrypted block must start with 0x2F 0x2F
+		 * after decryption.
+		 */
+		constexpr char IDLE_FILLER = 0x2F;
+
+		/**
+		 * Transport layer header of a wireless M-Bus frame.
+		 * The long header contains the meter address (12 bytes),
+		 * the short header starts with the access number (4 bytes).
+		 */
+		class header
+		{
+		public:
+			header();
+
+			/**
+			 * @return security mode (0 == no encryption, 5 == AES-CBC with IV, 7 == AES-CBC with derived key)
+			 */
+			std::uint8_t get_mode() const;
+
+			/**
+			 * @return number of encrypted 16 byte blocks
+			 */
+			std::size_t get_block_count() const;
+
+			/**
+			 * @return offset of the first (encrypted) data byte
+			 * inside the payload
+			 */
+			std::size_t get_offset() const;
+
+			std::uint8_t get_access_no() const;
+			std::uint8_t get_status() const;
+
+			/**
+			 * @return true if the header contains the address
+			 * of the meter (long header)
+			 */
+			bool has_address() const;
+
+			/**
+			 * Build the initialization vector of security mode 5.
+			 * The first 8 bytes are the meter address (manufacturer, ID, version, medium)
+			 * followed by 8 times the access number.
+			 *
+			 * @param server_id 9 bytes server ID as generated by the wireless M-Bus parser.
+			 * Ignored if the header contains a meter address.
+			 * @param version version byte of the link layer as received. The server ID
+			 * contains only the lower 6 bits.
+			 */
+			std::array<unsigned char, 16> get_iv(cyng::buffer_t const& server_id, std::uint8_t version) const;
+
+			friend bool read_header(std::uint8_t, cyng::buffer_t const&, header&);
+
+		private:
+			std::uint8_t access_no_;
+			std::uint8_t status_;
+			std::uint16_t cfg_;
+			std::size_t offset_;
+
+			/**
+			 * manufacturer (2), ID (4), version (1), medium (1)
+			 */
+			std::array<unsigned char, 8> address_;
+			bool long_;
+		};
+
+		/**
+		 * Read the transport layer header.
+		 *
+		 * @param ci CI field (frame type)
+		 * @param payload data following the CI field
+		 * @return false if CI field is not supported or payload is too short
+		 */
+		bool read_header(std::uint8_t ci, cyng::buffer_t const& payload, header&);
+
+		/**
+		 * CRC as specified in EN 13757-4 (polynomial 0x3D65).
+		 */
+		std::uint16_t crc16_en13757(unsigned char const* cp, std::size_t len);
+		std::uint16_t crc16_en13757(cyng::buffer_t const&);
+
+	}
+}	//	node
+
+#endif
@@ -428,6 +428,10 @@ namespace node
 			std::size_t	packet_size_;
 
 			std::string manufacturer_;
+
+			/**
+			 * version byte as received
+			 */
 			std::uint8_t version_;
 			std::uint8_t media_;
 			std::uint32_t dev_id_;
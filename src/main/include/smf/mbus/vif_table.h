@@ -0,0 +1,231 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#ifndef NODE_MBUS_VIF_TABLE_H
+#define NODE_MBUS_VIF_TABLE_H
+
+#include <smf/mbus/units.h>
+#include <array>
+#include <cstdint>
+
+namespace node
+{
+	namespace mbus
+	{
+		/**
+		 * Physical meaning of a VIF (table 12 and 14 of EN 13757-3)
+		 */
+		enum vif_type : std::uint8_t
+		{
+			VIF_UNKNOWN = 0,
+			VIF_ENERGY,
+			VIF_VOLUME,
+			VIF_MASS,
+			VIF_ON_TIME,
+			VIF_OPERATING_TIME,
+			VIF_POWER,
+			VIF_VOLUME_FLOW,
+			VIF_MASS_FLOW,
+			VIF_FLOW_TEMPERATURE,
+			VIF_RETURN_TEMPERATURE,
+			VIF_TEMPERATURE_DIFFERENCE,
+			VIF_EXTERNAL_TEMPERATURE,
+			VIF_PRESSURE,
+			VIF_DATE,			//	data type G
+			VIF_DATE_TIME,		//	data type F
+			VIF_HCA,			//	heat cost allocator units
+			VIF_AVERAGING_DURATION,
+			VIF_ACTUALITY_DURATION,
+			VIF_FABRICATION_NO,
+			VIF_IDENTIFICATION,
+			VIF_ADDRESS,
+			VIF_EXT_FB,			//	alternate extension table follows
+			VIF_PLAIN_TEXT,		//	VIF in following string
+			VIF_EXT_FD,			//	main extension table follows
+			VIF_ANY,
+			VIF_MANUFACTURER_SPECIFIC,
+			VIF_RESERVED,
+			//	main extension table (0xFD)
+			VIF_ACCESS_NUMBER,
+			VIF_MEDIUM,
+			VIF_MANUFACTURER,
+			VIF_PARAMETER_SET_ID,
+			VIF_VERSION,
+			VIF_CUSTOMER,
+			VIF_ERROR_FLAGS,
+			VIF_DIGITAL_IO,
+			VIF_STORAGE_INTERVAL,
+			VIF_VOLTAGE,
+			VIF_CURRENT,
+			VIF_COUNTER,
+			VIF_REMAINING_BATTERY_LIFE_TIME,
+			VIF_MANUFACTURER_EXT,
+		};
+
+		/**
+		 * One entry of the lookup table
+		 */
+		struct vif_entry
+		{
+			vif_type	type_;
+			unit_code	unit_;
+			std::int8_t	scaler_;
+		};
+
+		/**
+		 * Data field of the DIF (lower nibble)
+		 */
+		enum dif_coding : std::uint8_t
+		{
+			DIF_NONE = 0,
+			DIF_INTEGER,
+			DIF_REAL,
+			DIF_BCD,
+			DIF_VARIABLE,
+			DIF_SPECIAL,
+		};
+
+		struct dif_entry
+		{
+			dif_coding	coding_;
+			std::uint8_t size_;
+		};
+
+		namespace detail
+		{
+			constexpr unit_code time_unit(std::uint8_t vif)
+			{
+				return ((vif & 0x03) == 0)
+					? SECOND
+					: (((vif & 0x03) == 1)
+						? MIN
+						: (((vif & 0x03) == 2) ? HOUR : DAY))
+					;
+			}
+
+			constexpr vif_entry make_primary(std::uint8_t vif)
+			{
+				//	without extension bit
+				vif &= 0x7F;
+				const std::int8_t n3 = static_cast<std::int8_t>(vif & 0x07);
+				const std::int8_t n2 = static_cast<std::int8_t>(vif & 0x03);
+
+				if (vif < 0x08)	return { VIF_ENERGY, WATT_HOUR, static_cast<std::int8_t>(n3 - 3) };
+				if (vif < 0x10)	return { VIF_ENERGY, JOULE, n3 };
+				if (vif < 0x18)	return { VIF_VOLUME, CUBIC_METRE, static_cast<std::int8_t>(n3 - 6) };
+				if (vif < 0x20)	return { VIF_MASS, KILOGRAM, static_cast<std::int8_t>(n3 - 3) };
+				if (vif < 0x24)	return { VIF_ON_TIME, time_unit(vif), 0 };
+				if (vif < 0x28)	return { VIF_OPERATING_TIME, time_unit(vif), 0 };
+				if (vif < 0x30)	return { VIF_POWER, WATT, static_cast<std::int8_t>(n3 - 3) };
+				if (vif < 0x38)	return { VIF_POWER, JOULE_PER_HOUR, n3 };
+				if (vif < 0x40)	return { VIF_VOLUME_FLOW, CUBIC_METRE_PER_HOUR, static_cast<std::int8_t>(n3 - 6) };
+				if (vif < 0x48)	return { VIF_VOLUME_FLOW, CUBIC_METRE_PER_MINUTE, static_cast<std::int8_t>(n3 - 7) };
+				if (vif < 0x50)	return { VIF_VOLUME_FLOW, CUBIC_METRE_PER_SECOND, static_cast<std::int8_t>(n3 - 9) };
+				if (vif < 0x58)	return { VIF_MASS_FLOW, KILOGRAM_PER_HOUR, static_cast<std::int8_t>(n3 - 3) };
+				if (vif < 0x5C)	return { VIF_FLOW_TEMPERATURE, DEGREE_CELSIUS, static_cast<std::int8_t>(n2 - 3) };
+				if (vif < 0x60)	return { VIF_RETURN_TEMPERATURE, DEGREE_CELSIUS, static_cast<std::int8_t>(n2 - 3) };
+				if (vif < 0x64)	return { VIF_TEMPERATURE_DIFFERENCE, KELVIN, static_cast<std::int8_t>(n2 - 3) };
+				if (vif < 0x68)	return { VIF_EXTERNAL_TEMPERATURE, DEGREE_CELSIUS, static_cast<std::int8_t>(n2 - 3) };
+				if (vif < 0x6C)	return { VIF_PRESSURE, BAR, static_cast<std::int8_t>(n2 - 3) };
+				if (vif == 0x6C)	return { VIF_DATE, UNDEFINED_, 0 };
+				if (vif == 0x6D)	return { VIF_DATE_TIME, UNDEFINED_, 0 };
+				if (vif == 0x6E)	return { VIF_HCA, UNIT_RESERVED, 0 };
+				if (vif == 0x6F)	return { VIF_RESERVED, UNDEFINED_, 0 };
+				if (vif < 0x74)	return { VIF_AVERAGING_DURATION, time_unit(vif), 0 };
+				if (vif < 0x78)	return { VIF_ACTUALITY_DURATION, time_unit(vif), 0 };
+				if (vif == 0x78)	return { VIF_FABRICATION_NO, UNDEFINED_, 0 };
+				if (vif == 0x79)	return { VIF_IDENTIFICATION, UNDEFINED_, 0 };
+				if (vif == 0x7A)	return { VIF_ADDRESS, UNDEFINED_, 0 };
+				if (vif == 0x7B)	return { VIF_EXT_FB, UNDEFINED_, 0 };
+				if (vif == 0x7C)	return { VIF_PLAIN_TEXT, UNDEFINED_, 0 };
+				if (vif == 0x7D)	return { VIF_EXT_FD, UNDEFINED_, 0 };
+				if (vif == 0x7E)	return { VIF_ANY, UNDEFINED_, 0 };
+				return { VIF_MANUFACTURER_SPECIFIC, UNDEFINED_, 0 };
+			}
+
+			/**
+			 * implements table 14 of EN 13757-3 (main VIFE-code extension table)
+			 */
+			constexpr vif_entry make_ext_fd(std::uint8_t vif)
+			{
+				vif &= 0x7F;
+				if (vif == 0x08)	return { VIF_ACCESS_NUMBER, UNDEFINED_, 0 };
+				if (vif == 0x09)	return { VIF_MEDIUM, UNDEFINED_, 0 };
+				if (vif == 0x0A)	return { VIF_MANUFACTURER, UNDEFINED_, 0 };
+				if (vif == 0x0B)	return { VIF_PARAMETER_SET_ID, UNDEFINED_, 0 };
+				if (vif < 0x10 && vif > 0x0B)	return { VIF_VERSION, UNDEFINED_, 0 };
+				if (vif == 0x10 || vif == 0x11)	return { VIF_CUSTOMER, UNDEFINED_, 0 };
+				if (vif == 0x17 || vif == 0x18)	return { VIF_ERROR_FLAGS, UNDEFINED_, 0 };
+				if (vif == 0x1A || vif == 0x1B)	return { VIF_DIGITAL_IO, UNDEFINED_, 0 };
+				if (vif > 0x23 && vif < 0x28)	return { VIF_STORAGE_INTERVAL, time_unit(vif), 0 };
+				if (vif == 0x28)	return { VIF_STORAGE_INTERVAL, MONTH, 0 };
+				if (vif == 0x29)	return { VIF_STORAGE_INTERVAL, YEAR, 0 };
+				if (vif >= 0x40 && vif < 0x50)	return { VIF_VOLTAGE, VOLT, static_cast<std::int8_t>((vif & 0x0F) - 9) };
+				if (vif >= 0x50 && vif < 0x60)	return { VIF_CURRENT, AMPERE, static_cast<std::int8_t>((vif & 0x0F) - 12) };
+				if (vif == 0x60 || vif == 0x61)	return { VIF_COUNTER, COUNT, 0 };
+				if (vif == 0x74)	return { VIF_REMAINING_BATTERY_LIFE_TIME, DAY, 0 };
+				if (vif == 0x76)	return { VIF_MANUFACTURER_EXT, UNDEFINED_, 0 };
+				return { VIF_UNKNOWN, UNDEFINED_, 0 };
+			}
+
+			constexpr dif_entry make_dif(std::uint8_t dif)
+			{
+				switch (dif & 0x0F) {
+				case 0x00:	return { DIF_NONE, 0 };
+				case 0x01:	return { DIF_INTEGER, 1 };
+				case 0x02:	return { DIF_INTEGER, 2 };
+				case 0x03:	return { DIF_INTEGER, 3 };
+				case 0x04:	return { DIF_INTEGER, 4 };
+				case 0x05:	return { DIF_REAL, 4 };
+				case 0x06:	return { DIF_INTEGER, 6 };
+				case 0x07:	return { DIF_INTEGER, 8 };
+				case 0x08:	return { DIF_NONE, 0 };	//	selection for readout
+				case 0x09:	return { DIF_BCD, 1 };
+				case 0x0A:	return { DIF_BCD, 2 };
+				case 0x0B:	return { DIF_BCD, 3 };
+				case 0x0C:	return { DIF_BCD, 4 };
+				case 0x0D:	return { DIF_VARIABLE, 0 };
+				case 0x0E:	return { DIF_BCD, 6 };
+				default:
+					break;
+				}
+				return { DIF_SPECIAL, 0 };
+			}
+
+			template <typename T, std::size_t N, typename F>
+			constexpr std::array<T, N> make_table(F f)
+			{
+				std::array<T, N> table{};
+				for (std::size_t idx = 0; idx < N; ++idx) {
+					table[idx] = f(static_cast<std::uint8_t>(idx));
+				}
+				return table;
+			}
+		}
+
+		/**
+		 * primary VIF without extension bit (0x00 - 0x7F)
+		 */
+		constexpr std::array<vif_entry, 128> vif_primary_table = detail::make_table<vif_entry, 128>(detail::make_primary);
+
+		/**
+		 * VIFE following 0xFD (without extension bit)
+		 */
+		constexpr std::array<vif_entry, 128> vif_ext_fd_table = detail::make_table<vif_entry, 128>(detail::make_ext_fd);
+
+		/**
+		 * data field of DIF (lower nibble)
+		 */
+		constexpr std::array<dif_entry, 16> dif_table = detail::make_table<dif_entry, 16>(detail::make_dif);
+
+		static_assert(vif_primary_table[0x13].type_ == VIF_VOLUME && vif_primary_table[0x13].scaler_ == -3, "VIF table");
+		static_assert(vif_primary_table[0x06].unit_ == WATT_HOUR && vif_primary_table[0x06].scaler_ == 3, "VIF table");
+		static_assert(dif_table[0x0C].coding_ == DIF_BCD && dif_table[0x0C].size_ == 4, "DIF table");
+	}
+}	//	node
+
+#endif
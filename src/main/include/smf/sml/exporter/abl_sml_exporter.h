@@ -12,6 +12,7 @@
 #include <smf/sml/defs.h>
 #include <smf/sml/units.h>
 #include <smf/sml/protocol/readout.h>
+#include <smf/sml/exporter/output_files.h>
 #include <cyng/intrinsics/sets.h>
 #include <cyng/object.h>
 #include <fstream>
@@ -40,11 +41,13 @@ namespace node
 		class abl_exporter
 		{
 		public:
-			abl_exporter(boost::filesystem::path root_dir
+			abl_exporter(output_files&
+				, boost::filesystem::path root_dir
 				, std::string prefix
 				, std::string suffix
 				, bool);
-			abl_exporter(boost::filesystem::path root_dir
+			abl_exporter(output_files&
+				, boost::filesystem::path root_dir
 				, std::string prefix
 				, std::string suffix
 				, bool
@@ -102,6 +105,7 @@ namespace node
 
 
 		private:
+			output_files& files_;
 			const boost::filesystem::path root_dir_;
 			const std::string prefix_;
 			const std::string suffix_;
@@ -0,0 +1,130 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#ifndef NODE_SML_EXPORTER_ARCHIVE_FORMAT_H
+#define NODE_SML_EXPORTER_ARCHIVE_FORMAT_H
+
+#include <smf/sml/intrinsics/obis.h>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace node
+{
+	namespace sml
+	{
+		/**
+		 * A single meter reading of the columnar archive
+		 */
+		struct archive_record
+		{
+			std::string server_;	//!<	formatted server ID
+			obis code_;
+			std::int64_t time_;	//!<	seconds since epoch (UTC)
+			std::int64_t value_;	//!<	raw value without scaler
+			std::int8_t scaler_;
+			std::uint8_t unit_;
+			std::uint64_t status_;
+		};
+
+		/**
+		 * Select records of an archive. Empty sets match all
+		 * servers/OBIS codes.
+		 */
+		struct archive_filter
+		{
+			archive_filter();
+
+			/**
+			 * @return true if the time range [begin, end] overlaps the specified range
+			 */
+			bool overlaps(std::int64_t min_time, std::int64_t max_time) const;
+			bool match_server(std::string const&) const;
+			bool match_code(obis const&) const;
+			bool match(archive_record const&) const;
+
+			std::set<std::string> servers_;
+			std::set<obis> codes_;
+			std::int64_t begin_;	//!<	inclusive
+			std::int64_t end_;	//!<	inclusive
+		};
+
+		/**
+		 * Collect records and write them as a chunk.
+		 *
+		 * A chunk starts with a fixed size header (magic "SMFC", version,
+		 * min/max time, number of records and the size of the two following
+		 * sections). The dictionary section contains all server IDs and
+		 * OBIS codes of the chunk and a list of series (server, OBIS, unit,
+		 * scaler, number of records). The column section contains the
+		 * records sorted by series and time:
+		 * <ul>
+		 * <li>time: delta-of-delta per series</li>
+		 * <li>value: delta per series</li>
+		 * <li>status: run length encoded</li>
+		 * </ul>
+		 * All numbers in these sections are zigzag encoded varints.
+		 *
+		 * Chunks are independent from each other. An archive file is a
+		 * sequence of chunks, so chunks can be appended at any time.
+		 */
+		class archive_chunk
+		{
+		public:
+			archive_chunk();
+
+			void append(archive_record const&);
+
+			/**
+			 * @return number of records
+			 */
+			std::size_t size() const;
+			bool empty() const;
+
+			/**
+			 * Encode all records as chunk and remove them
+			 */
+			void write(std::ostream&);
+
+		private:
+			std::vector<archive_record> records_;
+		};
+
+		/**
+		 * Counters of an archive scan
+		 */
+		struct archive_stats
+		{
+			archive_stats();
+
+			std::size_t chunks_;	//!<	total
+			std::size_t skipped_;	//!<	skipped by time index or dictionary
+			std::size_t records_;	//!<	decoded records
+			std::size_t matches_;	//!<	records passed the filter
+		};
+
+		/**
+		 * Read all chunks of an archive. Chunks that are out of the time
+		 * range of the filter are skipped by the header. Chunks without
+		 * the selected servers/OBIS codes are skipped after reading the
+		 * dictionary. Only the remaining chunks are decoded.
+		 *
+		 * @return false if the archive is corrupt
+		 */
+		bool scan_archive(std::istream&
+			, archive_filter const&
+			, std::function<void(archive_record const&)>
+			, archive_stats&);
+
+	}	//	sml
+}
+
+#endif
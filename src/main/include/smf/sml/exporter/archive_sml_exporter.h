@@ -0,0 +1,108 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#ifndef NODE_SML_EXPORTER_ARCHIVE_SML_H
+#define NODE_SML_EXPORTER_ARCHIVE_SML_H
+
+
+#include <smf/sml/defs.h>
+#include <smf/sml/intrinsics/obis.h>
+#include <smf/sml/exporter/archive_format.h>
+#include <smf/sml/exporter/output_files.h>
+#include <cyng/intrinsics/sets.h>
+#include <cyng/object.h>
+#include <chrono>
+#include <map>
+#include <boost/filesystem.hpp>
+
+namespace node
+{
+	namespace sml
+	{
+		/**
+		 * One archive file per profile and day (UTC)
+		 */
+		boost::filesystem::path get_archive_filename(std::string prefix
+			, std::string suffix
+			, obis profile
+			, std::int64_t time);
+
+		/**
+		 * walk down SML message body, collect all integer readings
+		 * of profile list responses and write them as chunks into
+		 * a columnar archive (see archive_chunk).
+		 *
+		 * Each archive file has its own pending chunk. A chunk is
+		 * written if it contains the maximum number of records or if
+		 * it is older than the age passed to flush().
+		 */
+		class archive_exporter
+		{
+			struct pending
+			{
+				archive_chunk chunk_;
+				std::chrono::steady_clock::time_point since_;
+			};
+
+		public:
+			archive_exporter(output_files&
+				, boost::filesystem::path root_dir
+				, std::string prefix
+				, std::string suffix
+				, std::size_t chunk_size);
+			virtual ~archive_exporter();
+
+			/**
+			 * read SML message
+			 */
+			void read(cyng::tuple_t const&, std::size_t idx);
+
+			/**
+			 * write all pending chunks older than the specified age
+			 */
+			void flush(std::chrono::seconds max_age);
+
+			/**
+			 * write all pending chunks
+			 */
+			void flush();
+
+			/**
+			 * @return number of records not written yet
+			 */
+			std::size_t size() const;
+
+		private:
+			void read_msg(cyng::tuple_t::const_iterator, cyng::tuple_t::const_iterator, std::size_t idx);
+			void read_body(cyng::object, cyng::object);
+			void read_get_profile_list_response(cyng::tuple_t::const_iterator, cyng::tuple_t::const_iterator);
+
+			/**
+			 * @return seconds since epoch and false if the time is not a timestamp
+			 */
+			std::pair<std::int64_t, bool> read_time(cyng::object);
+			obis read_obis(cyng::object);
+
+			void write(boost::filesystem::path const&, archive_chunk&);
+
+		private:
+			output_files& files_;
+			const boost::filesystem::path root_dir_;
+			const std::string prefix_;
+			const std::string suffix_;
+			const std::size_t chunk_size_;
+
+			/**
+			 * pending chunk of each archive file
+			 */
+			std::map<boost::filesystem::path, pending>	chunks_;
+		};
+
+	}	//	sml
+}
+
+#endif
@@ -12,6 +12,7 @@
 #include <smf/sml/defs.h>
 #include <smf/sml/units.h>
 #include <smf/sml/protocol/readout.h>
+#include <smf/sml/exporter/output_files.h>
 #include <cyng/intrinsics/sets.h>
 #include <cyng/object.h>
 #include <fstream>
@@ -39,11 +40,13 @@ namespace node
 		class csv_exporter
 		{
 		public:
-			csv_exporter(boost::filesystem::path root_dir
+			csv_exporter(output_files&
+				, boost::filesystem::path root_dir
 				, std::string prefix
 				, std::string suffix
 				, bool header);
-			csv_exporter(boost::filesystem::path root_dir
+			csv_exporter(output_files&
+				, boost::filesystem::path root_dir
 				, std::string prefix
 				, std::string suffix
 				, bool header
@@ -97,6 +100,7 @@ namespace node
 			void write_header();
 
 		private:
+			output_files& files_;
 			const boost::filesystem::path root_dir_;
 			const std::string prefix_;
 			const std::string suffix_;
@@ -106,7 +110,7 @@ namespace node
 			const std::string target_;
 			boost::uuids::random_generator rgn_;
 			readout ro_;
-			std::ofstream	ofstream_;
+			boost::filesystem::path	file_;	//!<	current output file
 		};
 
 	}	//	sml
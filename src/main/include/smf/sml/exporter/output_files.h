@@ -0,0 +1,121 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#ifndef NODE_SML_EXPORTER_OUTPUT_FILES_H
+#define NODE_SML_EXPORTER_OUTPUT_FILES_H
+
+#include <chrono>
+#include <fstream>
+#include <list>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <vector>
+#include <boost/filesystem.hpp>
+
+namespace node
+{
+	namespace sml
+	{
+		/**
+		 * Open output files of the file based exporters (ABL, CSV, XML).
+		 *
+		 * Files stay open after writing. Each file has its own write buffer,
+		 * so the data are written in large blocks when the buffer is full,
+		 * when flush() is called or when the file is closed.
+		 * The number of open files is bounded. If the limit is reached the
+		 * least recently used file is closed. A file that is opened again
+		 * is appended.
+		 *
+		 * All files that were written since the last sync are synchronized
+		 * with the storage device by flush() after the sync interval
+		 * (0 disables this).
+		 *
+		 * Not thread safe. Each consumer task owns one instance shared by
+		 * the exporters of all its lines.
+		 */
+		class output_files
+		{
+		public:
+			output_files(std::size_t max_open
+				, std::size_t buffer_size
+				, std::chrono::seconds idle_timeout
+				, std::chrono::seconds sync_interval);
+			virtual ~output_files();
+
+			/**
+			 * Get an open file. The file is opened in append mode if it
+			 * is not open yet.
+			 *
+			 * @param truncate discard the current content of the file
+			 * @return a stream that is not open if the file couldn't be opened
+			 */
+			std::ofstream& open(boost::filesystem::path const&, bool truncate = false);
+
+			/**
+			 * Flush and close the specified file
+			 */
+			void close(boost::filesystem::path const&);
+
+			/**
+			 * Flush all files, close files without activity since the idle
+			 * timeout and sync files if the sync interval is over.
+			 * Call this periodically.
+			 */
+			void flush();
+
+			/**
+			 * Flush, close and sync all files
+			 */
+			void clear();
+
+			/**
+			 * @return number of open files
+			 */
+			std::size_t size() const;
+
+		private:
+			struct entry
+			{
+				std::string path_;
+				std::unique_ptr<std::ofstream> stream_;
+				std::vector<char> buffer_;
+				std::chrono::steady_clock::time_point last_use_;
+			};
+			using list_t = std::list<entry>;
+
+			void remove(list_t::iterator);
+			void sync();
+
+		private:
+			std::size_t const max_open_;
+			std::size_t const buffer_size_;
+			std::chrono::seconds const idle_timeout_;
+			std::chrono::seconds const sync_interval_;
+
+			/**
+			 * most recently used file first
+			 */
+			list_t lru_;
+			std::unordered_map<std::string, list_t::iterator> index_;
+
+			/**
+			 * files written since the last sync
+			 */
+			std::set<std::string> unsynced_;
+			std::chrono::steady_clock::time_point last_sync_;
+
+			/**
+			 * returned if a file couldn't be opened
+			 */
+			std::ofstream closed_;
+		};
+
+	}	//	sml
+}
+
+#endif
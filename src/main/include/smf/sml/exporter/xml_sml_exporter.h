@@ -26,6 +26,11 @@ namespace node
 		/**
 		 * walk down SML message body recursively, collect data
 		 * and create an XML document.
+		 *
+		 * Alternatively the messages can be streamed: write_header(),
+		 * write(std::ostream&, ...) for each message and write_footer()
+		 * produce the same output as write(std::ostream&) without
+		 * keeping the messages in the document.
 		 */
 		class xml_exporter
 		{
@@ -54,6 +59,28 @@ namespace node
 			 */
 			bool write(boost::filesystem::path const&);
 
+			/**
+			 * Write XML document to stream
+			 */
+			void write(std::ostream&);
+
+			/**
+			 * Streaming output: write XML declaration, the start tag
+			 * of the root element and the meta data.
+			 */
+			void write_header(std::ostream&);
+
+			/**
+			 * Streaming output: convert a single SML message and write it.
+			 * Only this message is kept in memory.
+			 */
+			void write(std::ostream&, cyng::tuple_t const&, std::size_t idx);
+
+			/**
+			 * Streaming output: write the end tag of the root element
+			 */
+			void write_footer(std::ostream&);
+
 			/**
 			 * To build a usefull filename constructor with source,
 			 * channel and target info is required,
@@ -64,7 +91,7 @@ namespace node
 			/**
 			 * read SML message.
 			 */
-			void read_msg(cyng::tuple_t::const_iterator, cyng::tuple_t::const_iterator, std::size_t idx);
+			void read_msg(pugi::xml_node, cyng::tuple_t::const_iterator, cyng::tuple_t::const_iterator, std::size_t idx);
 			void read_body(pugi::xml_node, cyng::object, cyng::object);
 			void read_public_open_request(pugi::xml_node, cyng::tuple_t::const_iterator, cyng::tuple_t::const_iterator);
 			void read_public_open_response(pugi::xml_node, cyng::tuple_t::const_iterator, cyng::tuple_t::const_iterator);
@@ -94,6 +121,11 @@ namespace node
 			pugi::xml_document doc_;
 			pugi::xml_node root_;
 
+			/**
+			 * holds a single message in streaming mode
+			 */
+			pugi::xml_document fragment_;
+
 			const  std::string encoding_;
 			const  std::string root_name_;
 			const std::uint32_t source_;
@@ -69,6 +69,13 @@ namespace node
 				return std::tuple_size< data_type >::value;
 			}
 
+			/**
+			 *	@return all 6 bytes of the OBIS value
+			 */
+			inline data_type const& data() const {
+				return value_;
+			}
+
 			/**
 			 *	@return value group A
 			 */
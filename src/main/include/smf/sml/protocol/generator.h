@@ -108,6 +108,11 @@ namespace node
 		//protected:
 			std::size_t append_msg(cyng::tuple_t&&);
 
+			/**
+			 * Append a serialized message with CRC16
+			 */
+			std::size_t append_msg(cyng::buffer_t&&);
+
 		protected:
 			/**
 			 * buffer for current SML message
@@ -132,6 +137,11 @@ namespace node
 
 			std::size_t public_close();
 
+			/**
+			 * @return transaction id of the last generated message
+			 */
+			std::string get_trx() const;
+
 			/**
 			 * Restart system - 81 81 C7 83 82 01
 			 */
@@ -233,6 +243,16 @@ namespace node
 				, std::string const& password
 				, obis);
 
+			/**
+			 * Profile query - BODY_GET_PROFILE_LIST_REQUEST (0x400)
+			 */
+			std::size_t get_profile_list(cyng::buffer_t const& server_id
+				, std::string const& username
+				, std::string const& password
+				, std::chrono::system_clock::time_point begin_time
+				, std::chrono::system_clock::time_point end_time
+				, obis);
+
 			/**
 			 * get list of visible servers/meters - 81 81 10 06 FF FF
 			 */
@@ -0,0 +1,130 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#ifndef NODE_LIB_SML_REQUEST_TEMPLATE_H
+#define NODE_LIB_SML_REQUEST_TEMPLATE_H
+
+#include <smf/sml/defs.h>
+#include <smf/sml/intrinsics/obis.h>
+#include <cyng/intrinsics/buffer.h>
+#include <cyng/object.h>
+#include <chrono>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+namespace node
+{
+	namespace sml
+	{
+		/**
+		 * Preserialized SML message with patch slots.
+		 *
+		 * All constant parts of a message are serialized once when the
+		 * template is built. A slot marks a position where a value is
+		 * inserted for each message (transaction ID, group number,
+		 * server ID, user, password, timestamps, OBIS codes).
+		 * SML lists contain the number of elements and not the size in bytes.
+		 * So slot values of any length can be inserted without changing
+		 * the skeleton. Only the slot values and the CRC16 are computed
+		 * for each message, no object tree is built.
+		 *
+		 * The message frame (transaction ID, group number, abort code and
+		 * message type) is part of each template. The CRC16 and the
+		 * end of message are appended by render().
+		 *
+		 * A template is immutable after it was built and can be shared
+		 * between threads.
+		 */
+		class request_template
+		{
+		public:
+			/**
+			 * data type of a slot
+			 */
+			enum slot_type : std::uint8_t
+			{
+				SLOT_OCTET,	//!<	octet string (trx, server ID, user, password, OBIS code)
+				SLOT_UINT8,	//!<	unsigned 8 bit (group number)
+				SLOT_TIMESTAMP,	//!<	SML_Time as UNIX timestamp
+			};
+
+			/**
+			 * Value of a slot. Octet values reference the data of the
+			 * specified object. The object must live until render() returns.
+			 */
+			struct value
+			{
+				value(std::string const&);
+				value(cyng::buffer_t const&);
+				value(obis const&);
+				value(std::uint8_t);
+				value(std::chrono::system_clock::time_point);
+
+				slot_type type_;
+				char const* data_;
+				std::size_t size_;
+				std::uint32_t num_;
+			};
+
+		public:
+			/**
+			 * Start a message with slots for the transaction ID and the
+			 * group number.
+			 *
+			 * @param type message type
+			 * @param count number of elements of the message body
+			 */
+			request_template(sml_messages_enum type, std::size_t count);
+
+			/**
+			 * Start a list with the specified number of elements
+			 */
+			request_template& list(std::size_t count);
+
+			/**
+			 * Append a constant value
+			 */
+			request_template& append(cyng::object);
+
+			/**
+			 * Append a slot
+			 */
+			request_template& slot(slot_type);
+
+			/**
+			 * @return number of slots
+			 */
+			std::size_t slots() const;
+
+			/**
+			 * Produce a complete message with CRC16. The values are
+			 * inserted into the slots in the order of the slots.
+			 */
+			cyng::buffer_t render(std::initializer_list<value>) const;
+
+		private:
+			struct position
+			{
+				std::size_t offset_;	//!<	offset in skeleton
+				slot_type type_;
+			};
+
+		private:
+			/**
+			 * all constant parts of the message
+			 */
+			cyng::buffer_t skeleton_;
+
+			/**
+			 * ordered by offset
+			 */
+			std::vector<position> slots_;
+		};
+	}
+}
+#endif
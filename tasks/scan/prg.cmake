@@ -0,0 +1,41 @@
+# top level files
+set (task_scan)
+
+set (task_scan_cpp
+
+	tasks/scan/src/main.cpp	
+	tasks/scan/src/scanner.cpp
+)
+
+set (task_scan_h
+
+	tasks/scan/src/scanner.h
+)
+
+set (task_scan_info
+	${CMAKE_CURRENT_BINARY_DIR}/${PROJECT_NAME}_project_info.h
+
+	nodes/print_build_info.h
+	tasks/print_version_info.h
+
+	nodes/print_build_info.cpp
+	tasks/print_version_info.cpp
+)
+
+set (task_scan_archive
+
+	src/main/include/smf/sml/exporter/archive_format.h
+	lib/sml/exporter/src/archive_format.cpp
+)
+
+source_group("info" FILES ${task_scan_info})
+source_group("archive" FILES ${task_scan_archive})
+
+
+# define the main program
+set (task_scan
+  ${task_scan_cpp}
+  ${task_scan_h}
+  ${task_scan_info}
+  ${task_scan_archive}
+)
@@ -0,0 +1,150 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#include "../../../nodes/print_build_info.h"
+#include "../../print_version_info.h"
+#include "scanner.h"
+#include <smf/sml/obis_io.h>
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <stdexcept>
+#include <iostream>
+
+namespace
+{
+	/**
+	 * days since epoch of a date of the proleptic Gregorian calendar
+	 */
+	std::int64_t days_from_civil(std::int64_t y, unsigned m, unsigned d)
+	{
+		y -= (m <= 2) ? 1 : 0;
+		std::int64_t const era = (y >= 0 ? y : y - 399) / 400;
+		unsigned const yoe = static_cast<unsigned>(y - era * 400);
+		unsigned const doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+		unsigned const doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+		return era * 146097 + static_cast<std::int64_t>(doe) - 719468;
+	}
+
+	/**
+	 * Accepts seconds since epoch, "YYYY-MM-DD" and "YYYY-MM-DD HH:MM:SS" (UTC)
+	 */
+	std::int64_t parse_time(std::string const& str)
+	{
+		if (std::all_of(str.begin(), str.end(), ::isdigit)) {
+			return std::stoll(str);
+		}
+
+		int year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0;
+		auto const count = std::sscanf(str.c_str(), "%d-%d-%d%*[ T]%d:%d:%d", &year, &month, &day, &hour, &minute, &second);
+		if (count < 3 || month < 1 || month > 12 || day < 1 || day > 31) {
+			throw std::invalid_argument("invalid time " + str);
+		}
+		return days_from_civil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+	}
+}
+
+/**
+ * Scan the columnar archive files of the store node (SML:ARCHIVE)
+ */
+int main(int argc, char **argv) 
+{
+	std::vector<std::string> inputs, servers, codes;
+	std::string from, to, suffix;
+
+	boost::program_options::options_description generic("Generic options");
+	generic.add_options()
+
+		("help,h", "print usage message")
+		("version,v", "print version string")
+		("build,b", "last built timestamp and platform")
+		;
+
+	boost::program_options::options_description scan_options("scan");
+	scan_options.add_options()
+
+		("input,I", boost::program_options::value(&inputs), "archive files or directories")
+		("server,S", boost::program_options::value(&servers), "server ID (example: 01-e61e-13090016-3c-07)")
+		("obis,O", boost::program_options::value(&codes), "OBIS code in hex format (example: 0100010800ff)")
+		("from,F", boost::program_options::value(&from), "start time (UTC) as YYYY-MM-DD[THH:MM:SS] or seconds since epoch")
+		("to,T", boost::program_options::value(&to), "end time (UTC) - inclusive")
+		("suffix", boost::program_options::value(&suffix)->default_value("sma"), "file extension of archive files in directories")
+		("count,c", boost::program_options::bool_switch()->default_value(false), "print statistics only")
+		;
+
+	boost::program_options::positional_options_description positional;
+	positional.add("input", -1);
+
+	boost::program_options::options_description cmdline_options;
+	cmdline_options.add(generic).add(scan_options);
+
+	try
+	{
+		boost::program_options::variables_map vm;
+		boost::program_options::store(boost::program_options::command_line_parser(argc, argv).options(cmdline_options).positional(positional).run(), vm);
+		boost::program_options::notify(vm);
+
+		if (vm.count("help"))
+		{
+			std::cout
+				<< "usage: scan [options] file|directory..."
+				<< std::endl
+				<< cmdline_options
+				<< std::endl
+				;
+			return EXIT_SUCCESS;
+		}
+
+		if (vm.count("version"))
+		{
+			return node::print_version_info(std::cout, "scan");
+		}
+
+		if (vm.count("build"))
+		{
+			return node::print_build_info(std::cout);
+		}
+
+		if (inputs.empty())
+		{
+			std::cerr
+				<< "***error: no input files"
+				<< std::endl
+				;
+			return EXIT_FAILURE;
+		}
+
+		node::sml::archive_filter filter;
+		filter.servers_.insert(servers.begin(), servers.end());
+		for (auto const& code : codes) {
+			auto const obis = node::sml::to_obis(code);
+			if (obis.is_nil()) {
+				std::cerr
+					<< "***error: invalid OBIS code "
+					<< code
+					<< std::endl;
+				return EXIT_FAILURE;
+			}
+			filter.codes_.insert(obis);
+		}
+		if (!from.empty())	filter.begin_ = parse_time(from);
+		if (!to.empty())	filter.end_ = parse_time(to);
+
+		node::scanner s(filter, suffix, vm["count"].as< bool >());
+		return s.run(inputs, std::cout);
+	}
+	catch (std::exception const& ex)
+	{
+		std::cerr
+			<< "***error: "
+			<< ex.what()
+			<< std::endl
+			;
+	}
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,153 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#include "scanner.h"
+#include <smf/sml/obis_io.h>
+#include <smf/sml/scaler.h>
+#include <smf/sml/units.h>
+#include <cyng/chrono.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace node
+{
+	namespace
+	{
+		/**
+		 * @return UTC time as YYYY-MM-DDTHH:MM:SS
+		 */
+		std::string to_iso(std::int64_t time)
+		{
+			std::tm const tm = cyng::chrono::convert_utc(static_cast<std::time_t>(time));
+			std::stringstream ss;
+			ss
+				<< std::setfill('0')
+				<< cyng::chrono::year(tm)
+				<< '-'
+				<< std::setw(2)
+				<< cyng::chrono::month(tm)
+				<< '-'
+				<< std::setw(2)
+				<< cyng::chrono::day(tm)
+				<< 'T'
+				<< std::setw(2)
+				<< cyng::chrono::hour(tm)
+				<< ':'
+				<< std::setw(2)
+				<< cyng::chrono::minute(tm)
+				<< ':'
+				<< std::setw(2)
+				<< cyng::chrono::second(tm)
+				;
+			return ss.str();
+		}
+	}
+
+	scanner::scanner(sml::archive_filter const& filter, std::string const& suffix, bool count_only)
+		: filter_(filter)
+		, suffix_(suffix)
+		, count_only_(count_only)
+		, stats_()
+	{}
+
+	int scanner::run(std::vector<std::string> const& inputs, std::ostream& os)
+	{
+		auto const start = std::chrono::steady_clock::now();
+		auto const files = collect(inputs);
+
+		if (!count_only_) {
+			os << "server;obis;time;value;unit;status" << '\n';
+		}
+
+		bool ok{ true };
+		std::uintmax_t bytes{ 0 };
+		for (auto const& p : files) {
+			boost::system::error_code ec;
+			bytes += boost::filesystem::file_size(p, ec);
+			if (!scan(p, os)) {
+				std::cerr
+					<< "***error: "
+					<< p
+					<< " is corrupt"
+					<< std::endl;
+				ok = false;
+			}
+		}
+		os.flush();
+
+		auto const delta = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+		std::cerr
+			<< files.size()
+			<< " file(s), "
+			<< bytes
+			<< " bytes, "
+			<< stats_.chunks_
+			<< " chunks ("
+			<< stats_.skipped_
+			<< " skipped), "
+			<< stats_.records_
+			<< " records decoded, "
+			<< stats_.matches_
+			<< " matching records in "
+			<< delta.count()
+			<< " ms"
+			<< std::endl;
+
+		return (ok) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	std::vector<boost::filesystem::path> scanner::collect(std::vector<std::string> const& inputs) const
+	{
+		std::vector<boost::filesystem::path> files;
+		for (auto const& input : inputs) {
+			boost::filesystem::path const p(input);
+			if (boost::filesystem::is_directory(p)) {
+				for (auto const& entry : boost::filesystem::directory_iterator(p)) {
+					if (boost::filesystem::is_regular_file(entry.path())
+						&& (suffix_.empty() || entry.path().extension().string() == "." + suffix_)) {
+						files.push_back(entry.path());
+					}
+				}
+			}
+			else {
+				files.push_back(p);
+			}
+		}
+		std::sort(files.begin(), files.end());
+		return files;
+	}
+
+	bool scanner::scan(boost::filesystem::path const& p, std::ostream& os)
+	{
+		std::ifstream ifs(p.string(), std::ios::binary);
+		if (!ifs.is_open()) {
+			return false;
+		}
+
+		return sml::scan_archive(ifs, filter_, [&](sml::archive_record const& rec) {
+			if (!count_only_) {
+				os
+					<< rec.server_
+					<< ';'
+					<< sml::to_string(rec.code_)
+					<< ';'
+					<< to_iso(rec.time_)
+					<< ';'
+					<< sml::scale_value(rec.value_, rec.scaler_)
+					<< ';'
+					<< sml::get_unit_name(rec.unit_)
+					<< ';'
+					<< rec.status_
+					<< '\n'
+					;
+			}
+		}, stats_);
+	}
+}
@@ -0,0 +1,48 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#ifndef NODE_SCAN_SCANNER_H
+#define NODE_SCAN_SCANNER_H
+
+#include <smf/sml/exporter/archive_format.h>
+#include <boost/filesystem.hpp>
+#include <iostream>
+#include <vector>
+
+namespace node
+{
+	/**
+	 * Scan columnar archive files (SML:ARCHIVE) and print all
+	 * matching records as CSV.
+	 */
+	class scanner
+	{
+	public:
+		scanner(sml::archive_filter const&, std::string const& suffix, bool count_only);
+
+		/**
+		 * @param inputs archive files or directories
+		 * @return EXIT_FAILURE if at least one file is corrupt
+		 */
+		int run(std::vector<std::string> const& inputs, std::ostream&);
+
+	private:
+		/**
+		 * @return all files to scan sorted by name
+		 */
+		std::vector<boost::filesystem::path> collect(std::vector<std::string> const&) const;
+		bool scan(boost::filesystem::path const&, std::ostream&);
+
+	private:
+		sml::archive_filter const filter_;
+		std::string const suffix_;
+		bool const count_only_;
+		sml::archive_stats stats_;
+	};
+}
+
+#endif
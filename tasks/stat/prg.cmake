@@ -5,11 +5,15 @@ set (task_stat_cpp
 
 	tasks/stat/src/main.cpp	
 	tasks/stat/src/controller.cpp
+	tasks/stat/src/ring_counter.cpp
+	tasks/stat/src/tdigest.cpp
 )
 
 set (task_stat_h
 
 	tasks/stat/src/controller.h
+	tasks/stat/src/ring_counter.h
+	tasks/stat/src/tdigest.h
 )
 
 set (task_stat_schemes
@@ -38,6 +42,8 @@ set (task_stat_info
 set (task_stat_tasks
 	tasks/stat/src/tasks/cluster.h
 	tasks/stat/src/tasks/cluster.cpp
+	tasks/stat/src/tasks/aggregator.h
+	tasks/stat/src/tasks/aggregator.cpp
 )
 	
 if(WIN32)
@@ -40,7 +40,8 @@ namespace node
 		, cyng::logging::log_ptr
 		, boost::uuids::uuid
 		, cyng::vector_t const& cfg_cluster
-		, cyng::tuple_t cfg_db);
+		, cyng::tuple_t cfg_db
+		, cyng::tuple_t cfg_aggregation);
 
 	controller::controller(unsigned int pool_size, std::string const& json_path)
 	: pool_size_(pool_size)
@@ -217,6 +218,14 @@ namespace node
 						cyng::param_factory("period", 12)	//	seconds
 					))
 
+					, cyng::param_factory("aggregation", cyng::tuple_factory(
+						cyng::param_factory("cadence", 10),	//	seconds between summaries
+						cyng::param_factory("window", 60),	//	sliding window in seconds
+						cyng::param_factory("tumbling", 300),	//	tumbling window in seconds
+						cyng::param_factory("max-labels", 64),	//	failure reasons and gateways
+						cyng::param_factory("compression", 100)	//	t-digest
+					))
+
 					, cyng::param_factory("cluster", cyng::vector_factory({ cyng::tuple_factory(
 						cyng::param_factory("host", "127.0.0.1"),
 						cyng::param_factory("service", "7701"),
@@ -343,7 +352,8 @@ namespace node
 			, logger
 			, cluster_tag
 			, cyng::value_cast(dom.get("cluster"), vec)
-			, cyng::value_cast(dom.get("DB"), tpl));
+			, cyng::value_cast(dom.get("DB"), tpl)
+			, cyng::value_cast(dom.get("aggregation"), tpl));
 
 		//
 		//	wait for system signals
@@ -397,7 +407,8 @@ namespace node
 		, cyng::logging::log_ptr logger
 		, boost::uuids::uuid tag
 		, cyng::vector_t const& cfg_cluster
-		, cyng::tuple_t cfg_db)
+		, cyng::tuple_t cfg_db
+		, cyng::tuple_t cfg_aggregation)
 	{
 		CYNG_LOG_TRACE(logger, "cluster redundancy: " << cfg_cluster.size());
 
@@ -406,6 +417,7 @@ namespace node
 			, logger
 			, tag
 			, load_cluster_cfg(cfg_cluster)
-			, cyng::to_param_map(cfg_db));
+			, cyng::to_param_map(cfg_db)
+			, cyng::to_param_map(cfg_aggregation));
 	}
 }
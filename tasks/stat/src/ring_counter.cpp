@@ -0,0 +1,90 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#include "ring_counter.h"
+#include <algorithm>
+#include <boost/assert.hpp>
+
+namespace node
+{
+	ring_counter::ring_counter(std::size_t slots, std::chrono::seconds resolution)
+		: resolution_(std::max(resolution, std::chrono::seconds(1)))
+		, slots_(std::max<std::size_t>(slots, 1), 0u)
+		, head_(0)
+		, total_(0)
+	{}
+
+	void ring_counter::add(std::chrono::system_clock::time_point tp, std::uint64_t n)
+	{
+		auto const idx = get_slot(tp);
+		auto const size = static_cast<std::int64_t>(slots_.size());
+
+		if (idx > head_) {
+
+			//
+			//	clear all slots between the previous head and the new one
+			//
+			auto const count = std::min(idx - head_, size);
+			for (std::int64_t pos = idx - count + 1; pos <= idx; ++pos) {
+				slots_.at(static_cast<std::size_t>(pos % size)) = 0u;
+			}
+			head_ = idx;
+		}
+		else if (idx <= head_ - size) {
+			//	too old
+			return;
+		}
+
+		slots_.at(static_cast<std::size_t>(idx % size)) += n;
+		total_ += n;
+	}
+
+	std::uint64_t ring_counter::sum(std::chrono::system_clock::time_point now, std::chrono::seconds window) const
+	{
+		auto const last = get_slot(now);
+		auto const count = std::max<std::int64_t>(window.count() / resolution_.count(), 1);
+		return sum(last - count + 1, last);
+	}
+
+	std::uint64_t ring_counter::sum(std::chrono::system_clock::time_point start, std::chrono::system_clock::time_point end) const
+	{
+		return sum(get_slot(start), get_slot(end) - 1);
+	}
+
+	std::uint64_t ring_counter::total() const
+	{
+		return total_;
+	}
+
+	std::chrono::seconds ring_counter::span() const
+	{
+		return resolution_ * static_cast<int>(slots_.size());
+	}
+
+	std::int64_t ring_counter::get_slot(std::chrono::system_clock::time_point tp) const
+	{
+		auto const sec = std::chrono::duration_cast<std::chrono::seconds>(tp.time_since_epoch()).count();
+		return (sec < 0) ? 0 : (sec / resolution_.count());
+	}
+
+	std::uint64_t ring_counter::sum(std::int64_t first, std::int64_t last) const
+	{
+		auto const size = static_cast<std::int64_t>(slots_.size());
+
+		//
+		//	only slots that are still in the ring
+		//
+		first = std::max(first, std::max<std::int64_t>(head_ - size + 1, 0));
+		last = std::min(last, head_);
+
+		std::uint64_t result{ 0 };
+		for (auto pos = first; pos <= last; ++pos) {
+			result += slots_.at(static_cast<std::size_t>(pos % size));
+		}
+		return result;
+	}
+}
@@ -0,0 +1,75 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#ifndef NODE_STAT_RING_COUNTER_H
+#define NODE_STAT_RING_COUNTER_H
+
+#include <vector>
+#include <chrono>
+#include <cstdint>
+
+namespace node
+{
+	/**
+	 * Event counter with a fixed number of time slots.
+	 *
+	 * Each slot covers the configured resolution. Slots older than
+	 * slots * resolution are reused. This allows to query sliding
+	 * and tumbling windows up to this length in constant memory.
+	 */
+	class ring_counter
+	{
+	public:
+		ring_counter(std::size_t slots, std::chrono::seconds resolution);
+
+		/**
+		 * Count an event at the specified time. Events
+		 * outside the covered time span are ignored.
+		 */
+		void add(std::chrono::system_clock::time_point, std::uint64_t n = 1);
+
+		/**
+		 * sliding window: sum of all slots in (now - window, now]
+		 */
+		std::uint64_t sum(std::chrono::system_clock::time_point now, std::chrono::seconds window) const;
+
+		/**
+		 * tumbling window: sum of all slots in [start, end)
+		 */
+		std::uint64_t sum(std::chrono::system_clock::time_point start, std::chrono::system_clock::time_point end) const;
+
+		/**
+		 * @return all counted events since start
+		 */
+		std::uint64_t total() const;
+
+		/**
+		 * @return covered time span
+		 */
+		std::chrono::seconds span() const;
+
+	private:
+		std::int64_t get_slot(std::chrono::system_clock::time_point) const;
+
+		/**
+		 * sum of slots [first, last]
+		 */
+		std::uint64_t sum(std::int64_t first, std::int64_t last) const;
+
+	private:
+		std::chrono::seconds const resolution_;
+		std::vector<std::uint64_t> slots_;
+
+		/**
+		 * absolute number of the most recent slot
+		 */
+		std::int64_t head_;
+		std::uint64_t total_;
+	};
+}
+
+#endif
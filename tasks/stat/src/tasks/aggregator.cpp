@@ -0,0 +1,293 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#include "aggregator.h"
+#include <smf/cluster/generator.h>
+#include <cyng/async/task/task_builder.hpp>
+#include <cyng/vm/generator.h>
+#include <cyng/table/key.hpp>
+#include <cyng/table/body.hpp>
+#include <cyng/factory/set_factory.h>
+
+#include <boost/algorithm/string/predicate.hpp>
+
+namespace node
+{
+	aggregator::aggregator(cyng::async::base_task* btp
+		, cyng::logging::log_ptr logger
+		, bus::shared_type bus
+		, std::chrono::seconds cadence
+		, std::chrono::seconds window
+		, std::chrono::seconds tumbling
+		, std::size_t max_labels
+		, double compression)
+	: base_(*btp)
+		, logger_(logger)
+		, bus_(bus)
+		, cadence_(cadence)
+		, window_(window)
+		, tumbling_(tumbling)
+		, max_labels_(max_labels)
+		, slots_(static_cast<std::size_t>(std::max(window, tumbling * 2).count()))
+		, logins_(slots_, std::chrono::seconds(1))
+		, dialups_(slots_, std::chrono::seconds(1))
+		, closed_(slots_, std::chrono::seconds(1))
+		, failures_()
+		, bytes_()
+		, connections_()
+		, durations_(compression)
+		, last_durations_(compression)
+		, period_(std::chrono::system_clock::now())
+		, counted_()
+		, published_()
+	{
+		CYNG_LOG_INFO(logger_, "initialize task #"
+			<< base_.get_id()
+			<< " <"
+			<< base_.get_class_name()
+			<< "> cadence: "
+			<< cadence_.count()
+			<< "s, window: "
+			<< window_.count()
+			<< "s, tumbling: "
+			<< tumbling_.count()
+			<< "s");
+	}
+
+	cyng::continuation aggregator::run()
+	{
+		publish();
+
+		//
+		//	older records are ignored by the ring counters anyway
+		//
+		auto const limit = std::chrono::system_clock::now() - std::chrono::seconds(static_cast<std::int64_t>(slots_));
+		for (auto pos = counted_.begin(); pos != counted_.end(); ) {
+			if (pos->second < limit) {
+				pos = counted_.erase(pos);
+			}
+			else {
+				++pos;
+			}
+		}
+
+		base_.suspend(cadence_);
+		return cyng::continuation::TASK_CONTINUE;
+	}
+
+	void aggregator::stop()
+	{
+		CYNG_LOG_INFO(logger_, "task #"
+			<< base_.get_id()
+			<< " <"
+			<< base_.get_class_name()
+			<< "> stopped - "
+			<< logins_.total()
+			<< " logins, "
+			<< closed_.total()
+			<< " closed connections");
+	}
+
+	//	slot [0] - _TimeSeries
+	cyng::continuation aggregator::process(std::uint64_t id
+		, std::chrono::system_clock::time_point tp
+		, std::string account
+		, std::string evt
+		, std::string value)
+	{
+		//
+		//	The id is not unique after a restart of the master.
+		//	Together with the time stamp it is.
+		//
+		auto pos = counted_.find(id);
+		if (pos != counted_.end() && pos->second == tp)	return cyng::continuation::TASK_CONTINUE;
+		counted_[id] = tp;
+
+		if (boost::algorithm::equals(evt, "login")) {
+			if (boost::algorithm::equals(value, "OK")) {
+				logins_.add(tp);
+			}
+			else {
+				get_counter(failures_, value).add(tp);
+			}
+		}
+		else if (boost::algorithm::starts_with(evt, "dialup")) {
+			dialups_.add(tp);
+		}
+		return cyng::continuation::TASK_CONTINUE;
+	}
+
+	//	slot [1] - _Connection inserted
+	cyng::continuation aggregator::process(boost::uuids::uuid first
+		, boost::uuids::uuid second
+		, std::string name
+		, std::uint64_t throughput
+		, std::chrono::system_clock::time_point start)
+	{
+		connections_[std::make_pair(first, second)] = connection{ name, throughput, start };
+		return cyng::continuation::TASK_CONTINUE;
+	}
+
+	//	slot [2] - _Connection throughput
+	cyng::continuation aggregator::process(boost::uuids::uuid first
+		, boost::uuids::uuid second
+		, std::uint64_t throughput)
+	{
+		auto pos = connections_.find(std::make_pair(first, second));
+		if (pos != connections_.end()) {
+			if (throughput > pos->second.throughput_) {
+				get_counter(bytes_, pos->second.name_).add(std::chrono::system_clock::now(), throughput - pos->second.throughput_);
+			}
+			pos->second.throughput_ = throughput;
+		}
+		return cyng::continuation::TASK_CONTINUE;
+	}
+
+	//	slot [3] - _Connection removed
+	cyng::continuation aggregator::process(boost::uuids::uuid first, boost::uuids::uuid second)
+	{
+		auto pos = connections_.find(std::make_pair(first, second));
+		if (pos != connections_.end()) {
+			auto const now = std::chrono::system_clock::now();
+			auto const duration = std::chrono::duration_cast<std::chrono::milliseconds>(now - pos->second.start_);
+			durations_.add(duration.count() / 1000.0);
+			closed_.add(now);
+			connections_.erase(pos);
+		}
+		return cyng::continuation::TASK_CONTINUE;
+	}
+
+	//	slot [4] - cluster connection lost
+	cyng::continuation aggregator::process()
+	{
+		//
+		//	open connections are sent again after reconnect
+		//	and the master could have restarted
+		//
+		connections_.clear();
+		published_.clear();
+		return cyng::continuation::TASK_CONTINUE;
+	}
+
+	ring_counter& aggregator::get_counter(std::map<std::string, ring_counter>& counters, std::string const& label)
+	{
+		auto pos = counters.find(label);
+		if (pos != counters.end())	return pos->second;
+
+		//
+		//	fixed memory
+		//
+		auto const& name = (counters.size() < max_labels_) ? label : std::string("other");
+		return counters.emplace(std::piecewise_construct
+			, std::forward_as_tuple(name)
+			, std::forward_as_tuple(slots_, std::chrono::seconds(1))).first->second;
+	}
+
+	void aggregator::publish()
+	{
+		if (!bus_->is_online())	return;
+
+		auto const now = std::chrono::system_clock::now();
+		double const seconds = static_cast<double>(window_.count());
+
+		//
+		//	complete tumbling window
+		//
+		auto const elapsed = std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()) % tumbling_;
+		auto const end = now - elapsed;
+		auto const start = end - tumbling_;
+		if (period_ < end) {
+			last_durations_.reset();
+			last_durations_.merge(durations_);
+			durations_.reset();
+			period_ = end;
+		}
+
+		//
+		//	sliding windows
+		//
+		auto const logins = logins_.sum(now, window_);
+		publish("logins", "ok", window_, summary{ logins, logins / seconds, 0.0, 0.0, 0.0 });
+
+		std::uint64_t failed{ 0 };
+		for (auto const& c : failures_) {
+			auto const count = c.second.sum(now, window_);
+			failed += count;
+			publish("login.failures", c.first, window_, summary{ count, count / seconds, 0.0, 0.0, 0.0 });
+		}
+		publish("logins", "failed", window_, summary{ failed, failed / seconds, 0.0, 0.0, 0.0 });
+
+		auto const dialups = dialups_.sum(now, window_);
+		publish("dialups", "", window_, summary{ dialups, dialups / seconds, 0.0, 0.0, 0.0 });
+
+		for (auto const& c : bytes_) {
+			auto const count = c.second.sum(now, window_);
+			publish("bytes", c.first, window_, summary{ count, count / seconds, 0.0, 0.0, 0.0 });
+		}
+
+		auto const closed = closed_.sum(now, window_);
+		publish("connections", "closed", window_, summary{ closed, closed / seconds, 0.0, 0.0, 0.0 });
+		publish("connections", "open", window_, summary{ static_cast<std::uint64_t>(connections_.size()), 0.0, 0.0, 0.0, 0.0 });
+
+		//
+		//	tumbling windows
+		//
+		double const period = static_cast<double>(tumbling_.count());
+		auto const period_logins = logins_.sum(start, end);
+		publish("logins.period", "ok", tumbling_, summary{ period_logins, period_logins / period, 0.0, 0.0, 0.0 });
+
+		publish("connection.duration", "seconds", tumbling_, summary{ static_cast<std::uint64_t>(last_durations_.count())
+			, 0.0
+			, last_durations_.quantile(0.5)
+			, last_durations_.quantile(0.9)
+			, last_durations_.quantile(0.99) });
+	}
+
+	void aggregator::publish(std::string const& metric
+		, std::string const& label
+		, std::chrono::seconds window
+		, summary const& s)
+	{
+		auto const key = cyng::table::key_generator(metric, label);
+		auto pos = published_.find(std::make_pair(metric, label));
+		if (pos == published_.end()) {
+			bus_->vm_.async_run(bus_req_db_insert("_Statistics"
+				, key
+				, cyng::table::data_generator(std::chrono::system_clock::now()
+					, static_cast<std::uint32_t>(window.count())
+					, s.count_
+					, s.rate_
+					, s.p50_
+					, s.p90_
+					, s.p99_)
+				, 0
+				, bus_->vm_.tag()));
+			published_.emplace(std::make_pair(metric, label), s);
+			return;
+		}
+
+		//
+		//	send changed columns only
+		//
+		cyng::vector_t prg;
+		auto modify = [&](cyng::param_t const& param) {
+			auto const vec = bus_req_db_modify("_Statistics", key, param, 0, bus_->vm_.tag());
+			prg.insert(prg.end(), vec.begin(), vec.end());
+		};
+		if (pos->second.count_ != s.count_)	modify(cyng::param_factory("count", s.count_));
+		if (pos->second.rate_ != s.rate_)	modify(cyng::param_factory("rate", s.rate_));
+		if (pos->second.p50_ != s.p50_)	modify(cyng::param_factory("p50", s.p50_));
+		if (pos->second.p90_ != s.p90_)	modify(cyng::param_factory("p90", s.p90_));
+		if (pos->second.p99_ != s.p99_)	modify(cyng::param_factory("p99", s.p99_));
+
+		if (!prg.empty()) {
+			modify(cyng::param_factory("ts", std::chrono::system_clock::now()));
+			bus_->vm_.async_run(std::move(prg));
+			pos->second = s;
+		}
+	}
+}
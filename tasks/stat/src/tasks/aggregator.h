@@ -0,0 +1,185 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#ifndef NODE_STAT_TASK_AGGREGATOR_H
+#define NODE_STAT_TASK_AGGREGATOR_H
+
+#include "../ring_counter.h"
+#include "../tdigest.h"
+#include <smf/cluster/bus.h>
+#include <cyng/log.h>
+#include <cyng/async/mux.h>
+#include <cyng/async/policy.h>
+
+#include <map>
+#include <set>
+
+namespace node
+{
+	/**
+	 * Incremental aggregation of _TimeSeries events and _Connection
+	 * updates. All rollups are kept in fixed size ring buffers. At a
+	 * fixed cadence summaries are written into the master table _Statistics.
+	 */
+	class aggregator
+	{
+	public:
+		using msg_0 = std::tuple<std::uint64_t	//	id
+			, std::chrono::system_clock::time_point	//	time stamp
+			, std::string	//	account
+			, std::string	//	event
+			, std::string	//	value
+		>;
+		using msg_1 = std::tuple<boost::uuids::uuid	//	first
+			, boost::uuids::uuid	//	second
+			, std::string	//	caller
+			, std::uint64_t	//	throughput
+			, std::chrono::system_clock::time_point	//	start
+		>;
+		using msg_2 = std::tuple<boost::uuids::uuid, boost::uuids::uuid, std::uint64_t>;
+		using msg_3 = std::tuple<boost::uuids::uuid, boost::uuids::uuid>;
+		using msg_4 = std::tuple<>;
+		using signatures_t = std::tuple<msg_0, msg_1, msg_2, msg_3, msg_4>;
+
+	private:
+		using conn_key = std::pair<boost::uuids::uuid, boost::uuids::uuid>;
+		struct connection
+		{
+			std::string name_;
+			std::uint64_t throughput_;
+			std::chrono::system_clock::time_point start_;
+		};
+
+		/**
+		 * last published values of a row in _Statistics
+		 */
+		struct summary
+		{
+			std::uint64_t count_;
+			double rate_;
+			double p50_;
+			double p90_;
+			double p99_;
+		};
+
+	public:
+		aggregator(cyng::async::base_task* bt
+			, cyng::logging::log_ptr
+			, bus::shared_type
+			, std::chrono::seconds cadence
+			, std::chrono::seconds window
+			, std::chrono::seconds tumbling
+			, std::size_t max_labels
+			, double compression);
+		cyng::continuation run();
+		void stop();
+
+		/**
+		 * @brief slot [0]
+		 *
+		 * _TimeSeries event. The master sends all records of _TimeSeries
+		 * again after a reconnect. Records that were already counted are
+		 * skipped.
+		 */
+		cyng::continuation process(std::uint64_t
+			, std::chrono::system_clock::time_point
+			, std::string account
+			, std::string evt
+			, std::string value);
+
+		/**
+		 * @brief slot [1]
+		 *
+		 * _Connection inserted
+		 */
+		cyng::continuation process(boost::uuids::uuid
+			, boost::uuids::uuid
+			, std::string
+			, std::uint64_t
+			, std::chrono::system_clock::time_point);
+
+		/**
+		 * @brief slot [2]
+		 *
+		 * _Connection throughput update
+		 */
+		cyng::continuation process(boost::uuids::uuid, boost::uuids::uuid, std::uint64_t);
+
+		/**
+		 * @brief slot [3]
+		 *
+		 * _Connection removed
+		 */
+		cyng::continuation process(boost::uuids::uuid, boost::uuids::uuid);
+
+		/**
+		 * @brief slot [4]
+		 *
+		 * cluster connection lost - tables will be synchronized again
+		 */
+		cyng::continuation process();
+
+	private:
+		/**
+		 * @return counter of the specified label. If the maximum number of
+		 * labels is reached the label "other" is used.
+		 */
+		ring_counter& get_counter(std::map<std::string, ring_counter>&, std::string const&);
+
+		void publish();
+
+		/**
+		 * write only changed columns
+		 */
+		void publish(std::string const& metric
+			, std::string const& label
+			, std::chrono::seconds window
+			, summary const&);
+
+	private:
+		cyng::async::base_task& base_;
+		cyng::logging::log_ptr logger_;
+		bus::shared_type bus_;
+		std::chrono::seconds const cadence_;
+		std::chrono::seconds const window_;
+		std::chrono::seconds const tumbling_;
+		std::size_t const max_labels_;
+		std::size_t const slots_;
+
+		ring_counter logins_;
+		ring_counter dialups_;
+		ring_counter closed_;
+		std::map<std::string, ring_counter> failures_;
+		std::map<std::string, ring_counter> bytes_;
+
+		/**
+		 * open connections
+		 */
+		std::map<conn_key, connection> connections_;
+
+		/**
+		 * connection durations of the current and the
+		 * last complete tumbling window
+		 */
+		tdigest durations_;
+		tdigest last_durations_;
+		std::chrono::system_clock::time_point period_;
+
+		/**
+		 * counted _TimeSeries records (id, time stamp) - only
+		 * records within the span of the ring counters
+		 */
+		std::map<std::uint64_t, std::chrono::system_clock::time_point> counted_;
+
+		/**
+		 * published rows
+		 */
+		std::map<std::pair<std::string, std::string>, summary> published_;
+	};
+}
+
+#endif
@@ -6,12 +6,18 @@
  */
 
 #include "cluster.h"
+#include "aggregator.h"
 
 #include <smf/cluster/generator.h>
 #include <cyng/async/task/task_builder.hpp>
 #include <cyng/io/serializer.h>
 #include <cyng/vm/generator.h>
 #include <cyng/dom/algorithm.h>
+#include <cyng/tuple_cast.hpp>
+#include <cyng/value_cast.hpp>
+#include <cyng/numeric_cast.hpp>
+
+#include <boost/algorithm/string/predicate.hpp>
 
 namespace node
 {
@@ -19,12 +25,21 @@ namespace node
 		, cyng::logging::log_ptr logger
 		, boost::uuids::uuid cluster_tag
 		, cluster_config_t const& cfg_cluster
-		, cyng::param_map_t cfg_db)
+		, cyng::param_map_t cfg_db
+		, cyng::param_map_t cfg_aggregation)
 	: base_(*btp)
 		, bus_(bus_factory(btp->mux_, logger, cluster_tag, btp->get_id()))
 		, logger_(logger)
         , config_(cfg_cluster)
 		, cfg_db_(cfg_db)
+		, aggregator_(cyng::async::start_task_detached<aggregator>(btp->mux_
+			, logger
+			, bus_
+			, std::chrono::seconds(cyng::numeric_cast<std::uint32_t>(cyng::find(cfg_aggregation, "cadence"), 10u))
+			, std::chrono::seconds(cyng::numeric_cast<std::uint32_t>(cyng::find(cfg_aggregation, "window"), 60u))
+			, std::chrono::seconds(cyng::numeric_cast<std::uint32_t>(cyng::find(cfg_aggregation, "tumbling"), 300u))
+			, cyng::numeric_cast<std::size_t>(cyng::find(cfg_aggregation, "max-labels"), 64u)
+			, cyng::numeric_cast<double>(cyng::find(cfg_aggregation, "compression"), 100.0)))
 	{
 		CYNG_LOG_INFO(logger_, "initialize task #"
 			<< base_.get_id()
@@ -32,6 +47,20 @@ namespace node
 			<< base_.get_class_name()
 			<< ">");
 
+		//
+		//	data handling
+		//
+		bus_->vm_.register_function("db.trx.start", 0, [this](cyng::context& ctx) {
+			CYNG_LOG_TRACE(logger_, "db.trx.start");
+		});
+		bus_->vm_.register_function("db.trx.commit", 0, [this](cyng::context& ctx) {
+			CYNG_LOG_TRACE(logger_, "db.trx.commit");
+		});
+		bus_->vm_.register_function("bus.res.subscribe", 6, std::bind(&cluster::res_subscribe, this, std::placeholders::_1));
+		bus_->vm_.register_function("db.req.insert", 4, std::bind(&cluster::db_req_insert, this, std::placeholders::_1));
+		bus_->vm_.register_function("db.req.remove", 3, std::bind(&cluster::db_req_remove, this, std::placeholders::_1));
+		bus_->vm_.register_function("db.req.modify.by.param", 5, std::bind(&cluster::db_req_modify_by_param, this, std::placeholders::_1));
+
         //
         //	implement request handler
         //
@@ -76,12 +105,12 @@ namespace node
 		}
 
 		//
-		//	start clocks and storage tasks
+		//	subscribe tables
 		//
 		start_sub_tasks();
 
 		//
-		//	insert instance into table _CSV
+		//	insert instance into table _STAT
 		//
 		make_public();
 
@@ -91,7 +120,7 @@ namespace node
 	cyng::continuation cluster::process()
 	{
 		//
-		//	stop clocks and storage tasks
+		//	reset aggregation of open connections
 		//
 		stop_sub_tasks();
 
@@ -155,97 +184,151 @@ namespace node
 
 	void cluster::start_sub_tasks()
 	{
-		CYNG_LOG_INFO(logger_, "connect to configuration database");
-
-		//storage_task_ = cyng::async::start_task_delayed<storage_db>(base_.mux_
-		//	, std::chrono::seconds(2)
-		//	, logger_
-		//	, bus_
-		//	, cfg_db_
-		//	, cfg_clock_day_
-		//	, cfg_clock_month_).first;
-
-		//CYNG_LOG_INFO(logger_, "start clocks");
-
-  //      profile_15_min_tsk_ = cyng::async::start_task_delayed<profile_15_min>(base_.mux_
-  //          , std::chrono::seconds(3)
-  //          , logger_
-  //          , storage_task_
-  //          , offset_
-		//	, frame_
-		//	, format_).first;
-
-		//profile_60_min_tsk_ = cyng::async::start_task_delayed<profile_60_min>(base_.mux_
-		//	, std::chrono::seconds(4)
-		//	, logger_
-		//	, storage_task_
-		//	, offset_
-		//	, frame_
-		//	, format_).first;
-
-		//profile_24_h_tsk_ = cyng::async::start_task_delayed<profile_24_h>(base_.mux_
-  //          , std::chrono::seconds(5)
-		//	, logger_
-		//	, storage_task_
-		//	, offset_
-		//	, frame_
-		//	, format_).first;
+		//
+		//	The master sends all existing records and
+		//	all following changes.
+		//
+		CYNG_LOG_INFO(logger_, "subscribe tables _TimeSeries and _Connection");
+		bus_->vm_.async_run(bus_req_subscribe("_TimeSeries", base_.get_id()));
+		bus_->vm_.async_run(bus_req_subscribe("_Connection", base_.get_id()));
 	}
 
 	void cluster::stop_sub_tasks()
 	{
-		CYNG_LOG_INFO(logger_, "stop the clocks");
-
-		//if (profile_15_min_tsk_ != cyng::async::NO_TASK) {
-
-		//	CYNG_LOG_WARNING(logger_, "task #"
-		//		<< base_.get_id()
-		//		<< " <"
-		//		<< base_.get_class_name()
-		//		<< "> stop clock #"
-		//		<< profile_15_min_tsk_);
-
-		//	base_.mux_.stop(profile_15_min_tsk_);
-		//	profile_15_min_tsk_ = cyng::async::NO_TASK;
-		//}
-
-		//if (profile_60_min_tsk_ != cyng::async::NO_TASK) {
-
-		//	CYNG_LOG_WARNING(logger_, "task #"
-		//		<< base_.get_id()
-		//		<< " <"
-		//		<< base_.get_class_name()
-		//		<< "> stop clock #"
-		//		<< profile_60_min_tsk_);
-
-		//	base_.mux_.stop(profile_60_min_tsk_);
-		//	profile_60_min_tsk_ = cyng::async::NO_TASK;
-		//}
-
-		//if (profile_24_h_tsk_ != cyng::async::NO_TASK) {
-
-		//	CYNG_LOG_WARNING(logger_, "task #"
-		//		<< base_.get_id()
-		//		<< " <"
-		//		<< base_.get_class_name()
-		//		<< "> stop clock #"
-		//		<< profile_24_h_tsk_);
-
-		//	base_.mux_.stop(profile_24_h_tsk_);
-		//	profile_24_h_tsk_ = cyng::async::NO_TASK;
-		//}
-
-		//if (storage_task_ != cyng::async::NO_TASK) {
-
-		//	CYNG_LOG_WARNING(logger_, "task #"
-		//		<< base_.get_id()
-		//		<< " <"
-		//		<< base_.get_class_name()
-		//		<< "> stop storage task #"
-		//		<< storage_task_);
-		//	base_.mux_.stop(storage_task_);
-		//	storage_task_ = cyng::async::NO_TASK;
-		//}
+		base_.mux_.post(aggregator_, 4, cyng::tuple_t());
+	}
+
+	void cluster::res_subscribe(cyng::context& ctx)
+	{
+		const cyng::vector_t frame = ctx.get_frame();
+		//
+		//	* table name
+		//	* record key
+		//	* record data
+		//	* generation
+		//	* origin session id
+		//	* optional task id
+		//	
+		auto tpl = cyng::tuple_cast<
+			std::string,			//	[0] table name
+			cyng::table::key_type,	//	[1] table key
+			cyng::table::data_type,	//	[2] record
+			std::uint64_t,			//	[3] generation
+			boost::uuids::uuid,		//	[4] origin session id
+			std::size_t				//	[5] optional task id
+		>(frame);
+
+		//
+		//	reorder vectors
+		//
+		std::reverse(std::get<1>(tpl).begin(), std::get<1>(tpl).end());
+		std::reverse(std::get<2>(tpl).begin(), std::get<2>(tpl).end());
+
+		insert(std::get<0>(tpl), std::get<1>(tpl), std::get<2>(tpl));
+	}
+
+	void cluster::db_req_insert(cyng::context& ctx)
+	{
+		const cyng::vector_t frame = ctx.get_frame();
+		//
+		//	* table name
+		//	* record key
+		//	* record data
+		//	* generation
+		//	* source
+		//	
+		CYNG_LOG_TRACE(logger_, "db.req.insert - " << cyng::io::to_str(frame));
+
+		auto tpl = cyng::tuple_cast<
+			std::string,			//	[0] table name
+			cyng::table::key_type,	//	[1] table key
+			cyng::table::data_type,	//	[2] record
+			std::uint64_t,			//	[3] generation
+			boost::uuids::uuid		//	[4] source
+		>(frame);
+
+		//
+		//	assemble a record
+		//
+		std::reverse(std::get<1>(tpl).begin(), std::get<1>(tpl).end());
+		std::reverse(std::get<2>(tpl).begin(), std::get<2>(tpl).end());
+
+		insert(std::get<0>(tpl), std::get<1>(tpl), std::get<2>(tpl));
+	}
+
+	void cluster::db_req_remove(cyng::context& ctx)
+	{
+		const cyng::vector_t frame = ctx.get_frame();
+		//
+		//	* table name
+		//	* record key
+		//	* source
+		//	
+		CYNG_LOG_TRACE(logger_, ctx.get_name() << " - " << cyng::io::to_str(frame));
+
+		auto tpl = cyng::tuple_cast<
+			std::string,			//	[0] table name
+			cyng::table::key_type,	//	[1] table key
+			boost::uuids::uuid		//	[2] source
+		>(frame);
+
+		std::reverse(std::get<1>(tpl).begin(), std::get<1>(tpl).end());
+
+		if (boost::algorithm::equals(std::get<0>(tpl), "_Connection") && std::get<1>(tpl).size() == 2) {
+			base_.mux_.post(aggregator_, 3, cyng::tuple_t{ std::get<1>(tpl).at(0), std::get<1>(tpl).at(1) });
+		}
+	}
+
+	void cluster::db_req_modify_by_param(cyng::context& ctx)
+	{
+		const cyng::vector_t frame = ctx.get_frame();
+		//
+		//	* table name
+		//	* record key
+		//	* param [column,value]
+		//	* generation
+		//	* source
+		//	
+		CYNG_LOG_TRACE(logger_, ctx.get_name() << " - " << cyng::io::to_str(frame));
+
+		auto tpl = cyng::tuple_cast<
+			std::string,			//	[0] table name
+			cyng::table::key_type,	//	[1] table key
+			cyng::param_t,			//	[2] parameter
+			std::uint64_t,			//	[3] generation
+			boost::uuids::uuid		//	[4] source
+		>(frame);
+
+		std::reverse(std::get<1>(tpl).begin(), std::get<1>(tpl).end());
+
+		if (boost::algorithm::equals(std::get<0>(tpl), "_Connection")
+			&& boost::algorithm::equals(std::get<2>(tpl).first, "throughput")
+			&& std::get<1>(tpl).size() == 2) {
+
+			base_.mux_.post(aggregator_, 2, cyng::tuple_t{ std::get<1>(tpl).at(0)
+				, std::get<1>(tpl).at(1)
+				, std::get<2>(tpl).second });
+		}
+	}
+
+	void cluster::insert(std::string const& table
+		, cyng::table::key_type const& key
+		, cyng::table::data_type const& data)
+	{
+		if (boost::algorithm::equals(table, "_TimeSeries") && key.size() == 1 && data.size() == 5) {
+
+			//
+			//	[id] [ts, tag, account, evt, obj]
+			//
+			base_.mux_.post(aggregator_, 0, cyng::tuple_t{ key.at(0), data.at(0), data.at(2), data.at(3), data.at(4) });
+		}
+		else if (boost::algorithm::equals(table, "_Connection") && key.size() == 2 && data.size() == 7) {
+
+			//
+			//	[aName, bName, local, aLayer, bLayer, throughput, start]
+			//
+			base_.mux_.post(aggregator_, 1, cyng::tuple_t{ key.at(0), key.at(1), data.at(0), data.at(5), data.at(6) });
+		}
 	}
 
 	void cluster::make_public()
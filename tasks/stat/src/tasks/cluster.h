@@ -10,6 +10,8 @@
 
 #include <smf/cluster/bus.h>
 #include <smf/cluster/config.h>
+#include <cyng/table/key.hpp>
+#include <cyng/table/body.hpp>
 #include <cyng/log.h>
 #include <cyng/async/mux.h>
 #include <cyng/async/policy.h>
@@ -29,7 +31,8 @@ namespace node
 			, cyng::logging::log_ptr
 			, boost::uuids::uuid tag
 			, cluster_config_t const& cfg_cluster
-			, cyng::param_map_t cfg_db);
+			, cyng::param_map_t cfg_db
+			, cyng::param_map_t cfg_aggregation);
 		cyng::continuation run();
 		void stop();
 
@@ -56,6 +59,18 @@ namespace node
 
 		void make_public();
 
+		void res_subscribe(cyng::context& ctx);
+		void db_req_insert(cyng::context& ctx);
+		void db_req_remove(cyng::context& ctx);
+		void db_req_modify_by_param(cyng::context& ctx);
+
+		/**
+		 * forward a new record of _TimeSeries or _Connection to the aggregator
+		 */
+		void insert(std::string const& table
+			, cyng::table::key_type const& key
+			, cyng::table::data_type const& data);
+
 	private:
 		cyng::async::base_task& base_;
 		bus::shared_type bus_;
@@ -63,6 +78,11 @@ namespace node
         const cluster_redundancy config_;
 		const cyng::param_map_t cfg_db_;
 
+		/**
+		 * aggregation task
+		 */
+		std::size_t const aggregator_;
+
 	};	
 }
 
@@ -0,0 +1,164 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#include "tdigest.h"
+#include <algorithm>
+#include <cmath>
+
+namespace node
+{
+	tdigest::tdigest(double compression)
+		: compression_(compression)
+		, capacity_(static_cast<std::size_t>(compression * 4))
+		, centroids_()
+		, buffer_()
+		, total_(0.0)
+		, min_(0.0)
+		, max_(0.0)
+	{
+		centroids_.reserve(static_cast<std::size_t>(compression) + capacity_);
+		buffer_.reserve(capacity_);
+	}
+
+	void tdigest::add(double value, double weight)
+	{
+		if (std::isnan(value) || !(weight > 0.0))	return;
+
+		if (total_ == 0.0) {
+			min_ = max_ = value;
+		}
+		else {
+			min_ = std::min(min_, value);
+			max_ = std::max(max_, value);
+		}
+		total_ += weight;
+
+		buffer_.push_back(centroid{ value, weight });
+		if (buffer_.size() >= capacity_)	compress();
+	}
+
+	void tdigest::merge(tdigest const& other)
+	{
+		other.compress();
+		for (auto const& c : other.centroids_) {
+			add(c.mean_, c.weight_);
+		}
+		if (other.total_ > 0.0) {
+			min_ = std::min(min_, other.min_);
+			max_ = std::max(max_, other.max_);
+		}
+	}
+
+	double tdigest::quantile(double q) const
+	{
+		compress();
+		if (centroids_.empty())	return 0.0;
+		if (centroids_.size() == 1)	return centroids_.front().mean_;
+
+		q = std::min(std::max(q, 0.0), 1.0);
+		double const index = q * total_;
+
+		//
+		//	left tail: between min and center of first centroid
+		//
+		auto const& first = centroids_.front();
+		if (index < first.weight_ / 2.0) {
+			return min_ + (index / (first.weight_ / 2.0)) * (first.mean_ - min_);
+		}
+
+		//
+		//	interpolate between centers of adjacent centroids
+		//
+		double cumulative = first.weight_ / 2.0;
+		for (std::size_t idx = 0; idx + 1 < centroids_.size(); ++idx) {
+			auto const& left = centroids_.at(idx);
+			auto const& right = centroids_.at(idx + 1);
+			double const span = (left.weight_ + right.weight_) / 2.0;
+			if (index < cumulative + span) {
+				double const t = (index - cumulative) / span;
+				return left.mean_ + t * (right.mean_ - left.mean_);
+			}
+			cumulative += span;
+		}
+
+		//
+		//	right tail: between center of last centroid and max
+		//
+		auto const& last = centroids_.back();
+		double const rest = total_ - cumulative;
+		if (rest <= 0.0)	return max_;
+		double const t = std::min((index - cumulative) / rest, 1.0);
+		return last.mean_ + t * (max_ - last.mean_);
+	}
+
+	double tdigest::count() const
+	{
+		return total_;
+	}
+
+	double tdigest::min() const
+	{
+		return min_;
+	}
+
+	double tdigest::max() const
+	{
+		return max_;
+	}
+
+	void tdigest::reset()
+	{
+		centroids_.clear();
+		buffer_.clear();
+		total_ = min_ = max_ = 0.0;
+	}
+
+	void tdigest::compress() const
+	{
+		if (buffer_.empty())	return;
+
+		//
+		//	buffer and centroids are merged in place
+		//
+		buffer_.insert(buffer_.end(), centroids_.begin(), centroids_.end());
+		std::sort(buffer_.begin(), buffer_.end(), [](centroid const& a, centroid const& b) {
+			return a.mean_ < b.mean_;
+		});
+
+		centroids_.clear();
+		centroid current = buffer_.front();
+		double so_far = 0.0;
+		double k_lower = scale(0.0);
+
+		for (auto pos = buffer_.begin() + 1; pos != buffer_.end(); ++pos) {
+			double const q = (so_far + current.weight_ + pos->weight_) / total_;
+			if (scale(q) - k_lower <= 1.0) {
+				//
+				//	merge into current centroid
+				//
+				current.weight_ += pos->weight_;
+				current.mean_ += (pos->mean_ - current.mean_) * pos->weight_ / current.weight_;
+			}
+			else {
+				so_far += current.weight_;
+				k_lower = scale(so_far / total_);
+				centroids_.push_back(current);
+				current = *pos;
+			}
+		}
+		centroids_.push_back(current);
+		buffer_.clear();
+	}
+
+	double tdigest::scale(double q) const
+	{
+		//
+		//	k1(q) = delta / (2 pi) * asin(2q - 1)
+		//
+		return compression_ / (2.0 * 3.14159265358979323846) * std::asin(std::min(std::max(2.0 * q - 1.0, -1.0), 1.0));
+	}
+}
@@ -0,0 +1,85 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Sylko Olzscher
+ *
+ */
+
+#ifndef NODE_STAT_TDIGEST_H
+#define NODE_STAT_TDIGEST_H
+
+#include <vector>
+#include <cstddef>
+
+namespace node
+{
+	/**
+	 * Merging t-digest (Dunning) to estimate quantiles of a stream
+	 * of values in fixed memory.
+	 *
+	 * New values are collected in a buffer. If the buffer is full
+	 * it is merged into the sorted list of centroids. The number of
+	 * centroids is limited by the compression parameter.
+	 */
+	class tdigest
+	{
+		struct centroid
+		{
+			double mean_;
+			double weight_;
+		};
+
+	public:
+		explicit tdigest(double compression = 100.0);
+
+		void add(double value, double weight = 1.0);
+
+		/**
+		 * add all centroids of another digest
+		 */
+		void merge(tdigest const&);
+
+		/**
+		 * @param q quantile in the range [0, 1]
+		 * @return estimated value - 0 if digest is empty
+		 */
+		double quantile(double q) const;
+
+		/**
+		 * @return total weight
+		 */
+		double count() const;
+
+		double min() const;
+		double max() const;
+
+		/**
+		 * remove all values - memory is kept
+		 */
+		void reset();
+
+	private:
+		/**
+		 * merge buffer into centroids
+		 */
+		void compress() const;
+
+		/**
+		 * scale function k1
+		 */
+		double scale(double q) const;
+
+	private:
+		double const compression_;
+		std::size_t const capacity_;
+
+		mutable std::vector<centroid> centroids_;
+		mutable std::vector<centroid> buffer_;
+
+		double total_;
+		double min_;
+		double max_;
+	};
+}
+
+#endif
@@ -0,0 +1,94 @@
+#!/bin/bash
+#
+# Local sharded cluster for manual tests on one machine.
+#
+# Starts one master, one IP-T node and one setup node per shard.
+# Configuration files are generated with the --default option of
+# each node and patched with jq.
+#
+# Accounts are assigned to shards by hash. An IP-T device that connects
+# to the wrong IP-T node gets a login response with NEW_ADDRESS and the
+# address of the right node. IP-T clients of this project (store, gateway,
+# collector, emitter, stress) reconnect to this address. Push target
+# owners (i.e. store) have to login on every shard (one instance per
+# shard) and should be listed in "shard-global".
+# Dial-up connections and push channels are not forwarded between shards.
+#
+# usage: run.sh <build-dir> [shards] [work-dir]
+#
+
+set -e
+
+BIN=${1:?usage: run.sh <build-dir> [shards] [work-dir]}
+SHARDS=${2:-2}
+WORK=${3:-/tmp/smf-sharded}
+HOST=127.0.0.1
+MASTER_PORT=7701
+IPT_PORT=26862
+GLOBAL='["store"]'
+
+command -v jq >/dev/null || { echo "jq is required"; exit 1; }
+
+mkdir -p "$WORK"
+PIDS=()
+trap 'kill ${PIDS[@]} 2>/dev/null; wait' EXIT INT TERM
+
+#
+# IP-T address of each shard
+#
+REDIRECT=$(for ((i = 0; i < SHARDS; i++)); do echo "\"$HOST:$((IPT_PORT + i))\""; done | jq -s -c .)
+
+for ((i = 0; i < SHARDS; i++)); do
+	DIR="$WORK/shard-$i"
+	mkdir -p "$DIR"
+
+	"$BIN/master" -D -C "$DIR/master.json" >/dev/null
+	jq --arg port "$((MASTER_PORT + i))" \
+		--argjson idx "$i" \
+		--argjson redirect "$REDIRECT" \
+		--argjson global "$GLOBAL" \
+		--arg dir "$DIR" \
+		'.[0]["log-dir"] = $dir
+		| .[0].server.service = $port
+		| .[0].session["shard-index"] = $idx
+		| .[0].session["shard-redirect"] = $redirect
+		| .[0].session["shard-global"] = $global
+		| .[0].session["snapshot-dir"] = ($dir + "/snapshot")' \
+		"$DIR/master.json" > "$DIR/master.tmp" && mv "$DIR/master.tmp" "$DIR/master.json"
+
+	"$BIN/ipt" -D -C "$DIR/ipt.json" >/dev/null
+	jq --arg port "$((IPT_PORT + i))" \
+		--arg master "$((MASTER_PORT + i))" \
+		--arg dir "$DIR" \
+		'.[0]["log-dir"] = $dir
+		| .[0].server.service = $port
+		| .[0].cluster = [.[0].cluster[0] | .service = $master]' \
+		"$DIR/ipt.json" > "$DIR/ipt.tmp" && mv "$DIR/ipt.tmp" "$DIR/ipt.json"
+
+	"$BIN/setup" -D -C "$DIR/setup.json" >/dev/null
+	jq --arg master "$((MASTER_PORT + i))" \
+		--arg dir "$DIR" \
+		'.[0]["log-dir"] = $dir
+		| .[0].cluster = [.[0].cluster[0] | .service = $master]' \
+		"$DIR/setup.json" > "$DIR/setup.tmp" && mv "$DIR/setup.tmp" "$DIR/setup.json"
+
+	"$BIN/master" --console -C "$DIR/master.json" > "$DIR/master.log" 2>&1 &
+	PIDS+=($!)
+done
+
+#
+# cluster members need a running master
+#
+sleep 2
+
+for ((i = 0; i < SHARDS; i++)); do
+	DIR="$WORK/shard-$i"
+	"$BIN/ipt" --console -C "$DIR/ipt.json" > "$DIR/ipt.log" 2>&1 &
+	PIDS+=($!)
+	"$BIN/setup" --console -C "$DIR/setup.json" > "$DIR/setup.log" 2>&1 &
+	PIDS+=($!)
+	echo "shard #$i: master $HOST:$((MASTER_PORT + i)) - IP-T $HOST:$((IPT_PORT + i)) - logs in $DIR"
+done
+
+echo "press Ctrl-C to stop"
+wait
@@ -14,6 +14,9 @@
 #include "test-ipt-003.h"
 #include "test-ipt-004.h"
 #include "test-ipt-005.h"
+#include "test-ipt-006.h"
+#include "test-ipt-007.h"
+#include "test-ipt-008.h"
 
 //	Start with:
 //	./unit_test --report_level=detailed
@@ -51,6 +54,30 @@ BOOST_AUTO_TEST_CASE(ipt_005)
 	using namespace node;
 	BOOST_CHECK(test_ipt_005());
 }
+BOOST_AUTO_TEST_CASE(ipt_006)
+{
+	//
+	//	bulk scrambler
+	//
+	using namespace node;
+	BOOST_CHECK(test_ipt_006());
+}
+BOOST_AUTO_TEST_CASE(ipt_007)
+{
+	//
+	//	push channel pool
+	//
+	using namespace node;
+	BOOST_CHECK(test_ipt_007());
+}
+BOOST_AUTO_TEST_CASE(ipt_008)
+{
+	//
+	//	push data reassembly
+	//
+	using namespace node;
+	BOOST_CHECK(test_ipt_008());
+}
 BOOST_AUTO_TEST_SUITE_END()	//	IPT
 
 
@@ -59,6 +86,10 @@ BOOST_AUTO_TEST_SUITE_END()	//	IPT
 #include "test-sml-003.h"
 #include "test-sml-004.h"
 //#include "test-sml-005.h"
+#include "test-sml-006.h"
+#include "test-sml-007.h"
+#include "test-sml-008.h"
+#include "test-sml-009.h"
 
 BOOST_AUTO_TEST_SUITE(SML)
 BOOST_AUTO_TEST_CASE(sml_001)
@@ -86,12 +117,34 @@ BOOST_AUTO_TEST_CASE(sml_004)
 //	using namespace node;
 //	BOOST_CHECK(test_sml_005());
 //}
+BOOST_AUTO_TEST_CASE(sml_006)
+{
+	using namespace node;
+	BOOST_CHECK(test_sml_006());
+}
+BOOST_AUTO_TEST_CASE(sml_007)
+{
+	using namespace node;
+	BOOST_CHECK(test_sml_007());
+}
+BOOST_AUTO_TEST_CASE(sml_008)
+{
+	using namespace node;
+	BOOST_CHECK(test_sml_008());
+}
+BOOST_AUTO_TEST_CASE(sml_009)
+{
+	using namespace node;
+	BOOST_CHECK(test_sml_009());
+}
 BOOST_AUTO_TEST_SUITE_END()	//	SML
 
 
 #include "test-mbus-001.h"
 #include "test-mbus-002.h"
 #include "test-mbus-003.h"
+#include "test-mbus-004.h"
+#include "test-mbus-005.h"
 
 BOOST_AUTO_TEST_SUITE(MBUS)
 BOOST_AUTO_TEST_CASE(mbus_001)
@@ -109,6 +162,22 @@ BOOST_AUTO_TEST_CASE(mbus_003)
 	using namespace node;
 	BOOST_CHECK(test_mbus_003());
 }
+BOOST_AUTO_TEST_CASE(mbus_004)
+{
+	//
+	//	wireless M-Bus deduplication and decryption
+	//
+	using namespace node;
+	BOOST_CHECK(test_mbus_004());
+}
+BOOST_AUTO_TEST_CASE(mbus_005)
+{
+	//
+	//	table driven decoder
+	//
+	using namespace node;
+	BOOST_CHECK(test_mbus_005());
+}
 BOOST_AUTO_TEST_SUITE_END()	//	MBUS
 
 #include "test-serial-001.h"
@@ -119,3 +188,51 @@ BOOST_AUTO_TEST_CASE(serial_001)
 	BOOST_CHECK(test_serial_001());
 }
 BOOST_AUTO_TEST_SUITE_END()	//	SERIAL
+
+#include "test-mqtt-001.h"
+BOOST_AUTO_TEST_SUITE(MQTT)
+BOOST_AUTO_TEST_CASE(mqtt_001)
+{
+	//
+	//	broker topic tree
+	//
+	using namespace node;
+	BOOST_CHECK(test_mqtt_001());
+}
+BOOST_AUTO_TEST_SUITE_END()	//	MQTT
+
+#include "test-cluster-001.h"
+BOOST_AUTO_TEST_SUITE(CLUSTER)
+BOOST_AUTO_TEST_CASE(cluster_001)
+{
+	//
+	//	pooled receive buffers
+	//
+	using namespace node;
+	BOOST_CHECK(test_cluster_001());
+}
+BOOST_AUTO_TEST_SUITE_END()	//	CLUSTER
+
+#include "test-stat-001.h"
+BOOST_AUTO_TEST_SUITE(STAT)
+BOOST_AUTO_TEST_CASE(stat_001)
+{
+	//
+	//	ring counter and t-digest
+	//
+	using namespace node;
+	BOOST_CHECK(test_stat_001());
+}
+BOOST_AUTO_TEST_SUITE_END()	//	STAT
+
+#include "test-store-001.h"
+BOOST_AUTO_TEST_SUITE(STORE)
+BOOST_AUTO_TEST_CASE(store_001)
+{
+	//
+	//	file names of raw data
+	//
+	using namespace node;
+	BOOST_CHECK(test_store_001());
+}
+BOOST_AUTO_TEST_SUITE_END()	//	STORE
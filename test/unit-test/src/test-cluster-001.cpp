@@ -0,0 +1,84 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Sylko Olzscher 
+ * 
+ */ 
+#include "test-cluster-001.h"
+#include <boost/test/unit_test.hpp>
+#include <smf/cluster/buffer_pool.h>
+#include <string>
+
+namespace node 
+{
+	bool test_cluster_001()
+	{
+		//
+		//	block management
+		//
+		buffer_pool pool(16, 4);
+		BOOST_CHECK_EQUAL(pool.capacity(), 0u);
+		{
+			auto b1 = pool.get();
+			BOOST_CHECK_EQUAL(pool.capacity(), 4u);
+			BOOST_CHECK_EQUAL(pool.available(), 3u);
+			BOOST_CHECK_EQUAL(b1.size(), 16u);
+
+			auto b2 = std::move(b1);
+			BOOST_CHECK(b1.data() == nullptr);
+			BOOST_CHECK(b2.data() != nullptr);
+			BOOST_CHECK_EQUAL(pool.available(), 3u);
+
+			b2.reset();
+			BOOST_CHECK_EQUAL(pool.available(), 4u);
+
+			std::vector<buffer_pool::buffer> bufs;
+			for (std::size_t idx = 0; idx < 5; ++idx) {
+				bufs.push_back(pool.get());
+			}
+			//	second slab
+			BOOST_CHECK_EQUAL(pool.capacity(), 8u);
+			BOOST_CHECK_EQUAL(pool.available(), 3u);
+		}
+		BOOST_CHECK_EQUAL(pool.available(), 8u);
+
+		//
+		//	read from a connected socket
+		//
+		boost::asio::io_context ioc;
+		boost::asio::ip::tcp::acceptor acceptor(ioc, boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+		boost::asio::ip::tcp::socket client(ioc), server(ioc);
+		client.connect(acceptor.local_endpoint());
+		acceptor.accept(server);
+
+		std::string received;
+		std::size_t calls{ 0 };
+		async_read_pooled(server, [&](boost::system::error_code ec, buffer_pool::buffer const& buf, std::size_t n) {
+			++calls;
+			BOOST_CHECK(!ec);
+			received.assign(buf.data(), n);
+		});
+
+		//
+		//	no buffer is taken while waiting
+		//
+		auto const idle = get_buffer_pool().available();
+		ioc.poll();
+		BOOST_CHECK_EQUAL(calls, 0u);
+		BOOST_CHECK_EQUAL(get_buffer_pool().available(), idle);
+
+		boost::asio::write(client, boost::asio::buffer(std::string("hello")));
+		while (calls == 0 && ioc.run_one() != 0)
+			;
+		BOOST_CHECK_EQUAL(calls, 1u);
+		BOOST_CHECK_EQUAL(received, "hello");
+
+		//	synchronous writes of the serializers require blocking mode
+		BOOST_CHECK(!server.non_blocking());
+
+		//	buffer is returned after the handler
+		BOOST_CHECK_EQUAL(get_buffer_pool().available(), get_buffer_pool().capacity());
+
+		return true;
+	}
+}
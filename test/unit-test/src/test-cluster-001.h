@@ -0,0 +1,20 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Sylko Olzscher 
+ * 
+ */ 
+#ifndef TEST_CLUSTER_001_H
+#define TEST_CLUSTER_001_H
+
+#include <NODE_project_info.h>
+
+namespace node 
+{
+	/**
+	 * Pooled receive buffers: block management and
+	 * reading into a pooled buffer after readiness.
+	 */
+	bool test_cluster_001();
+}
+#endif
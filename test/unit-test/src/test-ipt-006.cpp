@@ -0,0 +1,177 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Sylko Olzscher 
+ * 
+ */ 
+#include "test-ipt-006.h"
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <boost/test/unit_test.hpp>
+#include <smf/ipt/scrambler.h>
+#include <smf/ipt/parser.h>
+#include <smf/ipt/codes.h>
+#include <cyng/io/serializer.h>
+#include <cyng/crypto/scrambler.hpp>
+
+namespace node 
+{
+	namespace
+	{
+		/**
+		 * reference implementation
+		 */
+		using reference_t = cyng::crypto::scrambler<char, ipt::scramble_key::SCRAMBLE_KEY_LENGTH>;
+
+		template <typename S>
+		void scramble_bytewise(S& s, char* p, std::size_t size)
+		{
+			for (std::size_t idx = 0; idx < size; ++idx) {
+				p[idx] = s[p[idx]];
+			}
+		}
+
+		void append_header(std::vector<char>& vec, std::uint16_t cmd, std::uint32_t length)
+		{
+			vec.push_back(static_cast<char>(cmd & 0xFF));
+			vec.push_back(static_cast<char>(cmd >> 8));
+			vec.push_back(0);	//	sequence
+			vec.push_back(0);	//	reserved
+			for (int idx = 0; idx < 4; ++idx) {
+				vec.push_back(static_cast<char>((length >> (idx * 8)) & 0xFF));
+			}
+		}
+	}
+
+	bool test_ipt_006()
+	{
+		std::mt19937 gen(42);
+		std::uniform_int_distribution<int> dist_byte(0, 255);
+
+		//
+		//	1. bulk processing compared with cyng::crypto::scrambler
+		//	with random keys, start offsets, lengths and chunk sizes
+		//
+		std::uniform_int_distribution<std::size_t> dist_offset(0, 2 * ipt::scrambler::KEY_LENGTH);
+		std::uniform_int_distribution<std::size_t> dist_length(0, 4096 + 64);
+		std::uniform_int_distribution<std::size_t> dist_chunk(0, 100);
+
+		for (std::size_t round = 0; round < 64; ++round) {
+
+			ipt::scramble_key::key_type key;
+			for (auto& c : key)	c = static_cast<char>(dist_byte(gen));
+
+			reference_t ref;
+			ref = key;
+			ipt::scrambler bulk;
+			bulk = key;
+
+			//
+			//	move both to the same random key offset
+			//
+			std::vector<char> prefix(dist_offset(gen));
+			for (auto& c : prefix)	c = static_cast<char>(dist_byte(gen));
+			std::vector<char> expected(prefix);
+			scramble_bytewise(ref, expected.data(), expected.size());
+			bulk.apply(prefix.data(), prefix.size());
+			BOOST_CHECK(prefix == expected);
+
+			std::vector<char> data(dist_length(gen));
+			for (auto& c : data)	c = static_cast<char>(dist_byte(gen));
+
+			expected = data;
+			scramble_bytewise(ref, expected.data(), expected.size());
+
+			std::vector<char> result(data.size());
+			for (std::size_t pos = 0; pos < data.size(); ) {
+				auto const n = std::min(dist_chunk(gen), data.size() - pos);
+				bulk.apply(data.data() + pos, result.data() + pos, n);
+				pos += n;
+			}
+			BOOST_CHECK(result == expected);
+			BOOST_CHECK_EQUAL(bulk.offset(), (prefix.size() + data.size()) % ipt::scrambler::KEY_LENGTH);
+
+			//
+			//	in place
+			//
+			std::vector<char> inplace(data);
+			bulk = key;
+			bulk.skip(prefix.size());
+			bulk.apply(inplace.data(), inplace.size());
+			BOOST_CHECK(inplace == expected);
+		}
+
+		//
+		//	2. key switch inside a single read: scrambled login
+		//	followed by a watchdog request with the new key
+		//
+		ipt::scramble_key const def_sk(ipt::scramble_key::default_scramble_key_);
+		ipt::scramble_key const new_sk = ipt::gen_random_sk();
+
+		std::vector<char> inp;
+		append_header(inp, ipt::code::CTRL_REQ_LOGIN_SCRAMBLED, 0x31);
+		std::vector<char> body{ 'n', 'a', 'm', 'e', '\0', 'p', 'w', 'd', '\0' };
+		body.insert(body.end(), new_sk.key().begin(), new_sk.key().end());
+		ipt::scrambler enc;
+		enc = def_sk.key();
+		enc.apply(body.data(), body.size());
+		inp.insert(inp.end(), body.begin(), body.end());
+
+		std::vector<char> watchdog;
+		append_header(watchdog, ipt::code::CTRL_REQ_WATCHDOG, 8);
+		enc = new_sk.key();
+		enc.apply(watchdog.data(), watchdog.size());
+		inp.insert(inp.end(), watchdog.begin(), watchdog.end());
+
+		std::string code;
+		ipt::parser p([&code](cyng::vector_t&& prg) {
+			code = cyng::io::to_str(prg);
+		}, def_sk);
+		p.read(inp.begin(), inp.end());
+		BOOST_CHECK(code.find("ipt.req.login.scrambled") != std::string::npos);
+		BOOST_CHECK(code.find("ipt.req.watchdog") != std::string::npos);
+
+		//
+		//	3. throughput
+		//
+		ipt::scramble_key const sk = ipt::gen_random_sk();
+		reference_t ref;
+		ref = sk.key();
+		ipt::scrambler bulk;
+		bulk = sk.key();
+
+		std::vector<char> buffer(NODE::PREFERRED_BUFFER_SIZE);
+		for (auto& c : buffer)	c = static_cast<char>(dist_byte(gen));
+		std::size_t const rounds = (64u * 1024u * 1024u) / buffer.size();
+
+		auto start = std::chrono::steady_clock::now();
+		for (std::size_t idx = 0; idx < rounds; ++idx) {
+			scramble_bytewise(ref, buffer.data(), buffer.size());
+		}
+		std::chrono::duration<double> const bytewise = std::chrono::steady_clock::now() - start;
+
+		start = std::chrono::steady_clock::now();
+		for (std::size_t idx = 0; idx < rounds; ++idx) {
+			bulk.apply(buffer.data(), buffer.size());
+		}
+		std::chrono::duration<double> const blockwise = std::chrono::steady_clock::now() - start;
+
+		double const mb = static_cast<double>(rounds * buffer.size()) / (1024.0 * 1024.0);
+		std::cout
+			<< "scrambler throughput: byte-wise "
+			<< (mb / bytewise.count())
+			<< " MB/s, bulk "
+			<< (mb / blockwise.count())
+			<< " MB/s"
+			<< std::endl;
+
+		//
+		//	both scramblers processed the same number of bytes
+		//
+		BOOST_CHECK_EQUAL(bulk.offset(), (rounds * buffer.size()) % ipt::scrambler::KEY_LENGTH);
+
+		return true;
+	}
+
+}
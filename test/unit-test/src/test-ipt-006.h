@@ -0,0 +1,20 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Sylko Olzscher 
+ * 
+ */ 
+#ifndef TEST_IPT_006_H
+#define TEST_IPT_006_H
+
+#include <NODE_project_info.h>
+
+namespace node 
+{
+	/**
+	 * Bulk scrambler: compare with byte-wise processing,
+	 * key switch during parsing and throughput.
+	 */
+	bool test_ipt_006();
+}
+#endif
@@ -0,0 +1,148 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Sylko Olzscher 
+ * 
+ */ 
+#include "test-ipt-007.h"
+#include <boost/test/unit_test.hpp>
+#include <smf/ipt/push_pool.h>
+
+namespace node 
+{
+	bool test_ipt_007()
+	{
+		ipt::push_pool pool(std::chrono::seconds(60), 2);
+		ipt::push_pool::channel ch{ 0u, 0u };
+		ipt::push_pool::segment seg;
+
+		//
+		//	first transfer opens a channel
+		//
+		BOOST_CHECK_EQUAL(pool.get_status("water@solostec", ch), ipt::push_pool::POOL_CLOSED);
+		pool.enqueue("water@solostec", cyng::buffer_t{ 1, 2, 3 }, 11u);
+		pool.track_open(1, "water@solostec");
+		BOOST_CHECK_EQUAL(pool.get_status("water@solostec", ch), ipt::push_pool::POOL_OPENING);
+		BOOST_CHECK(!pool.next("water@solostec", ch, seg));
+
+		//
+		//	data are queued while the channel is opening
+		//
+		pool.enqueue("water@solostec", cyng::buffer_t(600, 7), 12u);
+
+		std::string target;
+		BOOST_CHECK(!pool.opened(9, true, 42u, 7u, 0x100, 2, target));
+		BOOST_CHECK(pool.opened(1, true, 42u, 7u, 0x100, 2, target));
+		BOOST_CHECK_EQUAL(target, "water@solostec");
+		BOOST_CHECK_EQUAL(pool.get_status("water@solostec", ch), ipt::push_pool::POOL_OPEN);
+
+		//
+		//	two blocks in flight
+		//
+		BOOST_CHECK(pool.next("water@solostec", ch, seg));
+		BOOST_CHECK_EQUAL(ch.channel_, 42u);
+		BOOST_CHECK_EQUAL(ch.source_, 7u);
+		BOOST_CHECK_EQUAL(seg.status_, 0xC1);
+		BOOST_CHECK_EQUAL(seg.block_, 0u);
+		BOOST_CHECK_EQUAL(seg.data_.size(), 3u);
+		pool.track_transfer(2, "water@solostec");
+
+		BOOST_CHECK(pool.next("water@solostec", ch, seg));
+		BOOST_CHECK_EQUAL(seg.status_, 0x41);	//	SYN
+		BOOST_CHECK_EQUAL(seg.block_, 1u);
+		BOOST_CHECK_EQUAL(seg.data_.size(), 0x100u - 22u);
+		pool.track_transfer(3, "water@solostec");
+
+		BOOST_CHECK(!pool.next("water@solostec", ch, seg));
+
+		BOOST_CHECK(pool.transferred(2, true, target));
+
+		//	first payload is complete
+		auto results = pool.get_results();
+		BOOST_CHECK_EQUAL(results.size(), 1u);
+		BOOST_CHECK_EQUAL(results.at(0).tsk_, 11u);
+		BOOST_CHECK(results.at(0).success_);
+		BOOST_CHECK(pool.get_results().empty());
+
+		BOOST_CHECK(pool.next("water@solostec", ch, seg));
+		BOOST_CHECK_EQUAL(seg.status_, 0x21);	//	ACK
+		BOOST_CHECK_EQUAL(seg.block_, 2u);
+		pool.track_transfer(4, "water@solostec");
+
+		//
+		//	a failed block in the middle of the window is sent again
+		//	on the same channel - confirmed blocks are not
+		//
+		BOOST_CHECK(pool.transferred(3, false, target));
+		BOOST_CHECK_EQUAL(pool.get_status("water@solostec", ch), ipt::push_pool::POOL_OPEN);
+		BOOST_CHECK(pool.next("water@solostec", ch, seg));
+		BOOST_CHECK_EQUAL(ch.channel_, 42u);
+		BOOST_CHECK_EQUAL(seg.status_, 0x41);	//	SYN
+		BOOST_CHECK_EQUAL(seg.block_, 1u);
+		BOOST_CHECK_EQUAL(seg.data_.size(), 0x100u - 22u);
+		pool.track_transfer(5, "water@solostec");
+
+		//	window is full
+		BOOST_CHECK(!pool.next("water@solostec", ch, seg));
+
+		BOOST_CHECK(pool.transferred(4, true, target));
+		BOOST_CHECK(pool.next("water@solostec", ch, seg));
+		BOOST_CHECK_EQUAL(seg.status_, 0xA1);	//	ACK + FIN
+		BOOST_CHECK_EQUAL(seg.block_, 3u);
+		BOOST_CHECK_EQUAL(seg.data_.size(), 600u - 2u * (0x100u - 22u));
+		pool.track_transfer(6, "water@solostec");
+
+		BOOST_CHECK(pool.transferred(5, true, target));
+		BOOST_CHECK(pool.transferred(6, true, target));
+		BOOST_CHECK(!pool.next("water@solostec", ch, seg));
+
+		results = pool.get_results();
+		BOOST_CHECK_EQUAL(results.size(), 1u);
+		BOOST_CHECK_EQUAL(results.at(0).tsk_, 12u);
+		BOOST_CHECK(results.at(0).success_);
+
+		//	unknown sequence
+		BOOST_CHECK(!pool.transferred(6, true, target));
+
+		//
+		//	give up after max retries
+		//
+		pool.enqueue("water@solostec", cyng::buffer_t{ 9 }, 13u);
+		ipt::sequence_type seq{ 9 };
+		for (std::size_t idx = 0; idx < 3; ++idx) {
+			BOOST_CHECK(pool.next("water@solostec", ch, seg));
+			BOOST_CHECK_EQUAL(seg.status_, 0xC1);
+			BOOST_CHECK_EQUAL(seg.block_, 4u);
+			pool.track_transfer(seq, "water@solostec");
+			BOOST_CHECK(pool.transferred(seq++, false, target));
+		}
+		BOOST_CHECK_EQUAL(pool.get_status("water@solostec", ch), ipt::push_pool::POOL_CLOSED);
+		BOOST_CHECK_EQUAL(pool.size(), 0u);
+
+		//	dropped payload is reported as failure
+		results = pool.get_results();
+		BOOST_CHECK_EQUAL(results.size(), 1u);
+		BOOST_CHECK_EQUAL(results.at(0).tsk_, 13u);
+		BOOST_CHECK_EQUAL(results.at(0).target_, "water@solostec");
+		BOOST_CHECK(!results.at(0).success_);
+
+		//
+		//	idle channels expire
+		//
+		pool.enqueue("gas@solostec", cyng::buffer_t{ 1 }, 14u);
+		pool.track_open(20, "gas@solostec");
+		BOOST_CHECK(pool.opened(20, true, 50u, 8u, 0xffff, 1, target));
+		BOOST_CHECK(pool.next("gas@solostec", ch, seg));
+		pool.track_transfer(21, "gas@solostec");
+		auto const later = std::chrono::steady_clock::now() + std::chrono::seconds(61);
+		BOOST_CHECK(pool.expire(later).empty());
+		BOOST_CHECK(pool.transferred(21, true, target));
+		BOOST_CHECK(pool.expire(std::chrono::steady_clock::now()).empty());
+		auto const closed = pool.expire(later);
+		BOOST_CHECK_EQUAL(closed.size(), 1u);
+		BOOST_CHECK_EQUAL(closed.at(0).channel_, 50u);
+		BOOST_CHECK_EQUAL(pool.size(), 0u);
+
+		return true;
+	}
+}
@@ -0,0 +1,20 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Sylko Olzscher 
+ * 
+ */ 
+#ifndef TEST_IPT_007_H
+#define TEST_IPT_007_H
+
+#include <NODE_project_info.h>
+
+namespace node 
+{
+	/**
+	 * Push channel pool: reuse, segmentation, window,
+	 * retransmission and idle timeout.
+	 */
+	bool test_ipt_007();
+}
+#endif
@@ -0,0 +1,92 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Sylko Olzscher 
+ * 
+ */ 
+#include "test-ipt-008.h"
+#include <boost/test/unit_test.hpp>
+#include <smf/ipt/push_reassembly.h>
+
+namespace node 
+{
+	bool test_ipt_008()
+	{
+		ipt::push_reassembly ra(8);
+
+		//
+		//	single blocks with constant block number
+		//
+		auto r = ra.put(1u, 2u, 0xC1, 0, cyng::buffer_t{ 1, 2 });
+		BOOST_CHECK_EQUAL(r.size(), 1u);
+		r = ra.put(1u, 2u, 0xC1, 0, cyng::buffer_t{ 3 });
+		BOOST_CHECK_EQUAL(r.size(), 1u);
+		BOOST_CHECK(r.at(0) == (cyng::buffer_t{ 3 }));
+
+		//
+		//	segmented payload in order
+		//
+		BOOST_CHECK(ra.put(3u, 4u, 0x41, 0, cyng::buffer_t{ 1, 2 }).empty());
+		BOOST_CHECK(ra.put(3u, 4u, 0x21, 1, cyng::buffer_t{ 3 }).empty());
+		BOOST_CHECK_EQUAL(ra.size(), 1u);
+		r = ra.put(3u, 4u, 0xA1, 2, cyng::buffer_t{ 4 });
+		BOOST_CHECK_EQUAL(r.size(), 1u);
+		BOOST_CHECK(r.at(0) == (cyng::buffer_t{ 1, 2, 3, 4 }));
+
+		//	complete streams are removed
+		BOOST_CHECK_EQUAL(ra.size(), 0u);
+
+		//
+		//	block 4 arrives late
+		//
+		BOOST_CHECK(ra.put(3u, 4u, 0x41, 3, cyng::buffer_t{ 5 }).empty());
+		BOOST_CHECK(ra.put(3u, 4u, 0xA1, 5, cyng::buffer_t{ 7 }).empty());
+		BOOST_CHECK(ra.put(3u, 4u, 0xC1, 6, cyng::buffer_t{ 8 }).empty());
+		r = ra.put(3u, 4u, 0x21, 4, cyng::buffer_t{ 6 });
+		BOOST_CHECK_EQUAL(r.size(), 2u);
+		BOOST_CHECK(r.at(0) == (cyng::buffer_t{ 5, 6, 7 }));
+		BOOST_CHECK(r.at(1) == (cyng::buffer_t{ 8 }));
+
+		//
+		//	duplicate
+		//
+		BOOST_CHECK(ra.put(3u, 4u, 0x41, 7, cyng::buffer_t{ 9 }).empty());
+		BOOST_CHECK(ra.put(3u, 4u, 0x41, 7, cyng::buffer_t{ 9 }).empty());
+		r = ra.put(3u, 4u, 0xA1, 8, cyng::buffer_t{ 10 });
+		BOOST_CHECK_EQUAL(r.size(), 1u);
+		BOOST_CHECK(r.at(0) == (cyng::buffer_t{ 9, 10 }));
+
+		//
+		//	block numbers wrap around
+		//
+		ipt::push_reassembly wrap(8);
+		BOOST_CHECK(wrap.put(1u, 1u, 0x41, 0xFF, cyng::buffer_t{ 1 }).empty());
+		r = wrap.put(1u, 1u, 0xA1, 0x00, cyng::buffer_t{ 2 });
+		BOOST_CHECK_EQUAL(r.size(), 1u);
+		BOOST_CHECK(r.at(0) == (cyng::buffer_t{ 1, 2 }));
+
+		//
+		//	data without SYN are passed through
+		//
+		r = ra.put(5u, 6u, 0x01, 0, cyng::buffer_t{ 11 });
+		BOOST_CHECK_EQUAL(r.size(), 1u);
+		BOOST_CHECK(r.at(0) == (cyng::buffer_t{ 11 }));
+		BOOST_CHECK_EQUAL(ra.size(), 0u);
+
+		//
+		//	incomplete payload of a closed channel expires
+		//
+		BOOST_CHECK(ra.put(7u, 8u, 0x41, 0, cyng::buffer_t{ 12 }).empty());
+		BOOST_CHECK_EQUAL(ra.size(), 1u);
+		auto const now = std::chrono::steady_clock::now();
+		BOOST_CHECK_EQUAL(ra.expire(now, std::chrono::seconds(60)), 0u);
+		BOOST_CHECK_EQUAL(ra.expire(now + std::chrono::seconds(61), std::chrono::seconds(60)), 1u);
+		BOOST_CHECK_EQUAL(ra.size(), 0u);
+
+		BOOST_CHECK(ra.put(7u, 8u, 0x41, 0, cyng::buffer_t{ 12 }).empty());
+		ra.clear();
+		BOOST_CHECK_EQUAL(ra.size(), 0u);
+
+		return true;
+	}
+}
@@ -0,0 +1,20 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Sylko Olzscher 
+ * 
+ */ 
+#ifndef TEST_IPT_008_H
+#define TEST_IPT_008_H
+
+#include <NODE_project_info.h>
+
+namespace node 
+{
+	/**
+	 * Reassembly of segmented push data with
+	 * out of order and duplicate blocks.
+	 */
+	bool test_ipt_008();
+}
+#endif
@@ -0,0 +1,130 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Sylko Olzscher 
+ * 
+ */ 
+#include "test-mbus-004.h"
+#include <iostream>
+#include <boost/test/unit_test.hpp>
+#include <smf/mbus/header.h>
+#include <smf/mbus/dedup.h>
+#include <smf/mbus/parser.h>
+#ifdef NODE_SSL_INSTALLED
+#include <smf/mbus/aes.h>
+#endif
+#include <cyng/factory.h>
+
+namespace node 
+{
+	bool test_mbus_004()
+	{
+		//
+		//	deduplication
+		//
+		wmbus::dedup dd(std::chrono::seconds(30), 2);
+		auto const now = wmbus::dedup::clock_t::now();
+		BOOST_CHECK(dd.test_and_set(0x1EE6, 0x13090016, 0x43, 0x1234, now));
+		BOOST_CHECK(!dd.test_and_set(0x1EE6, 0x13090016, 0x43, 0x1234, now));
+		BOOST_CHECK(dd.test_and_set(0x1EE6, 0x13090016, 0x44, 0x1234, now));
+		BOOST_CHECK_EQUAL(dd.get_duplicates(), 1u);
+
+		//	same ID from another manufacturer
+		BOOST_CHECK(dd.test_and_set(0x2324, 0x13090016, 0x44, 0x1234, now));
+		BOOST_CHECK_EQUAL(dd.get_duplicates(), 1u);
+
+		//	expired
+		BOOST_CHECK(dd.test_and_set(0x1EE6, 0x13090016, 0x43, 0x1234, now + std::chrono::seconds(31)));
+		BOOST_CHECK_EQUAL(dd.size(), 1u);
+
+		//
+		//	long header of a mode 5 telegram with 2 encrypted blocks
+		//	13090016 E61E 3C 07 43 00 2065
+		//
+		cyng::buffer_t payload = cyng::make_buffer({ 0x13, 0x09, 0x00, 0x16, 0xE6, 0x1E, 0x3C, 0x07, 0x43, 0x00, 0x20, 0x65 });
+		wmbus::header h;
+		BOOST_CHECK(wmbus::read_header(wmbus::CI_LONG_HEADER, payload, h));
+		BOOST_CHECK_EQUAL(h.get_mode(), 5u);
+		BOOST_CHECK_EQUAL(h.get_block_count(), 2u);
+		BOOST_CHECK_EQUAL(h.get_access_no(), 0x43);
+		BOOST_CHECK_EQUAL(h.get_offset(), 12u);
+
+		auto const iv = h.get_iv(cyng::buffer_t{}, 0);
+		BOOST_CHECK_EQUAL(iv.at(0), 0xE6);
+		BOOST_CHECK_EQUAL(iv.at(2), 0x13);
+		BOOST_CHECK_EQUAL(iv.at(7), 0x07);
+		BOOST_CHECK_EQUAL(iv.at(8), 0x43);
+		BOOST_CHECK_EQUAL(iv.at(15), 0x43);
+
+		//
+		//	short header: the IV is build from the link layer fields
+		//	as reported by the parser.
+		//	L, C, M (E61E), ID (16000913), version (3C), medium (07),
+		//	CI (7A), access no (2A), status (00), mode 5 with 1 block (1005)
+		//	and one encrypted block.
+		//
+		//	key: 000102030405060708090A0B0C0D0E0F
+		//	IV: E61E160009133C07 2A2A2A2A2A2A2A2A
+		//	plain text: 2F2F0C1378563412 2F2F2F2F2F2F2F2F
+		//
+		cyng::buffer_t const frame = cyng::make_buffer({ 0x1E, 0x44, 0xE6, 0x1E, 0x16, 0x00, 0x09, 0x13, 0x3C, 0x07, 0x7A
+			, 0x2A, 0x00, 0x10, 0x05
+			, 0xBB, 0xFC, 0x1A, 0x7E, 0x74, 0x48, 0x75, 0x26, 0x14, 0x34, 0x8A, 0x86, 0xDC, 0x40, 0xFE, 0x27 });
+
+		cyng::buffer_t server_id, payload;
+		std::uint8_t version{ 0 }, frame_type{ 0 };
+		wmbus::parser p([&](cyng::vector_t&& prg) {
+			//	[op:ESBA, server_id, manufacturer, version, media, dev_id, frame_type, payload, mbus.push.frame, ...]
+			server_id = cyng::value_cast(prg.at(1), server_id);
+			version = cyng::value_cast<std::uint8_t>(prg.at(3), 0);
+			frame_type = cyng::value_cast<std::uint8_t>(prg.at(6), 0);
+			payload = cyng::value_cast(prg.at(7), payload);
+		});
+		p.read(frame.begin(), frame.end());
+
+		BOOST_CHECK_EQUAL(version, 0x3C);
+		BOOST_CHECK_EQUAL(frame_type, wmbus::CI_SHORT_HEADER);
+		BOOST_REQUIRE_EQUAL(server_id.size(), 9u);
+
+		wmbus::header hs;
+		BOOST_REQUIRE(wmbus::read_header(frame_type, payload, hs));
+		BOOST_CHECK_EQUAL(hs.get_mode(), 5u);
+		BOOST_CHECK_EQUAL(hs.get_block_count(), 1u);
+		BOOST_CHECK_EQUAL(hs.get_offset(), 4u);
+
+		auto const iv_short = hs.get_iv(server_id, version);
+		std::array<unsigned char, 16> const iv_expected{ { 0xE6, 0x1E, 0x16, 0x00, 0x09, 0x13, 0x3C, 0x07
+			, 0x2A, 0x2A, 0x2A, 0x2A, 0x2A, 0x2A, 0x2A, 0x2A } };
+		BOOST_CHECK(iv_short == iv_expected);
+
+#ifdef NODE_SSL_INSTALLED
+		//
+		//	known answer
+		//
+		cyng::buffer_t const key = cyng::make_buffer({ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F });
+		cyng::buffer_t const plain = cyng::make_buffer({ 0x2F, 0x2F, 0x0C, 0x13, 0x78, 0x56, 0x34, 0x12, 0x2F, 0x2F, 0x2F, 0x2F, 0x2F, 0x2F, 0x2F, 0x2F });
+
+		wmbus::key_cache kc(8);
+		auto data = payload;
+		BOOST_CHECK(kc.decrypt_mode_5(server_id, key, iv_short, data.data() + hs.get_offset(), 16));
+		BOOST_CHECK(cyng::buffer_t(data.begin() + hs.get_offset(), data.end()) == plain);
+		BOOST_CHECK_EQUAL(kc.size(), 1u);
+
+		//	second run uses cached cipher context
+		data = payload;
+		BOOST_CHECK(kc.decrypt_mode_5(server_id, key, iv_short, data.data() + hs.get_offset(), 16));
+		BOOST_CHECK(cyng::buffer_t(data.begin() + hs.get_offset(), data.end()) == plain);
+		BOOST_CHECK_EQUAL(kc.size(), 1u);
+
+		//	wrong key
+		cyng::buffer_t other(key);
+		other.at(0) = 0x10;
+		data = payload;
+		BOOST_CHECK(!kc.decrypt_mode_5(server_id, other, iv_short, data.data() + hs.get_offset(), 16));
+		BOOST_CHECK_EQUAL(kc.size(), 1u);
+#endif
+
+		return true;
+	}
+
+}
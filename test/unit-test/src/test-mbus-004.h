@@ -0,0 +1,16 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Sylko Olzscher 
+ * 
+ */ 
+#ifndef TEST_MBUS_004_H
+#define TEST_MBUS_004_H
+
+#include <NODE_project_info.h>
+
+namespace node 
+{
+	bool test_mbus_004();
+}
+#endif	//	TEST_MBUS_004_H
@@ -0,0 +1,67 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Sylko Olzscher 
+ * 
+ */ 
+#include "test-mbus-005.h"
+#include <iostream>
+#include <boost/test/unit_test.hpp>
+#include <smf/mbus/data_record.h>
+#include <cyng/factory.h>
+
+namespace node 
+{
+	bool test_mbus_005()
+	{
+		//
+		//	2F 2F				idle filler
+		//	0C 13 78 56 34 12	volume 12345678 * 10^-3 m3 (BCD 8 digits)
+		//	02 5A 21 01			flow temperature 289 * 10^-1 degree Celsius (int16)
+		//	42 6C 61 2C			date (storage 1): 2019-12-01
+		//	04 FD 48 E8 03 00 00	voltage 1000 * 10^-1 V
+		//	0A 13 34 F2			negative BCD: -234 * 10^-3 m3
+		//	0F 01 02			manufacturer specific
+		//
+		cyng::buffer_t const inp = cyng::make_buffer({ 0x2F, 0x2F
+			, 0x0C, 0x13, 0x78, 0x56, 0x34, 0x12
+			, 0x02, 0x5A, 0x21, 0x01
+			, 0x42, 0x6C, 0x61, 0x2C
+			, 0x04, 0xFD, 0x48, 0xE8, 0x03, 0x00, 0x00
+			, 0x0A, 0x13, 0x34, 0xF2
+			, 0x0F, 0x01, 0x02 });
+
+		std::array<mbus::data_record, 8> records;
+		std::size_t count{ 0 };
+		auto const offset = mbus::decode_records(inp.data(), inp.size(), records.data(), records.size(), count);
+
+		BOOST_CHECK_EQUAL(count, 5u);
+		BOOST_CHECK_EQUAL(offset, inp.size() - 3);
+
+		BOOST_CHECK_EQUAL(records.at(0).type_, mbus::RECORD_BCD);
+		BOOST_CHECK_EQUAL(records.at(0).vif_, mbus::VIF_VOLUME);
+		BOOST_CHECK_EQUAL(records.at(0).unit_, mbus::CUBIC_METRE);
+		BOOST_CHECK_EQUAL(records.at(0).scaler_, -3);
+		BOOST_CHECK_EQUAL(records.at(0).value_.i_, 12345678);
+
+		BOOST_CHECK_EQUAL(records.at(1).type_, mbus::RECORD_INTEGER);
+		BOOST_CHECK_EQUAL(records.at(1).vif_, mbus::VIF_FLOW_TEMPERATURE);
+		BOOST_CHECK_EQUAL(records.at(1).scaler_, -1);
+		BOOST_CHECK_EQUAL(records.at(1).value_.i_, 289);
+
+		BOOST_CHECK_EQUAL(records.at(2).type_, mbus::RECORD_DATE);
+		BOOST_CHECK_EQUAL(records.at(2).storage_nr_, 1u);
+		BOOST_CHECK_EQUAL(records.at(2).value_.i_, 20191201);
+
+		BOOST_CHECK_EQUAL(records.at(3).vif_, mbus::VIF_VOLTAGE);
+		BOOST_CHECK_EQUAL(records.at(3).unit_, mbus::VOLT);
+		BOOST_CHECK_EQUAL(records.at(3).scaler_, -1);
+		BOOST_CHECK_EQUAL(records.at(3).value_.i_, 1000);
+
+		BOOST_CHECK_EQUAL(records.at(4).type_, mbus::RECORD_BCD);
+		BOOST_CHECK_EQUAL(records.at(4).value_.i_, -234);
+
+		return true;
+	}
+
+}
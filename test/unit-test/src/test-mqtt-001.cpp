@@ -0,0 +1,101 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Sylko Olzscher 
+ * 
+ */ 
+#include "test-mqtt-001.h"
+#include <boost/test/unit_test.hpp>
+#include "../../../nodes/mqtt/src/topic_tree.h"
+
+namespace node 
+{
+	bool test_mqtt_001()
+	{
+		//
+		//	filter and topic validation
+		//
+		BOOST_CHECK(topic_tree::is_valid_filter("a/+/c"));
+		BOOST_CHECK(topic_tree::is_valid_filter("a/#"));
+		BOOST_CHECK(topic_tree::is_valid_filter("#"));
+		BOOST_CHECK(!topic_tree::is_valid_filter("a/#/c"));
+		BOOST_CHECK(!topic_tree::is_valid_filter("a/b+"));
+		BOOST_CHECK(!topic_tree::is_valid_filter(""));
+		BOOST_CHECK(topic_tree::is_valid_topic("a/b/c"));
+		BOOST_CHECK(!topic_tree::is_valid_topic("a/+"));
+
+		topic_tree tree(2);
+
+		//
+		//	wildcards
+		//
+		BOOST_CHECK(tree.subscribe("a/+/c", 1, 0));
+		BOOST_CHECK(tree.subscribe("a/#", 2, 1));
+		BOOST_CHECK(tree.subscribe("#", 3, 2));
+		BOOST_CHECK(tree.subscribe("a/b/c", 1, 2));
+		BOOST_CHECK(!tree.subscribe("a/#/c", 4, 0));
+		BOOST_CHECK_EQUAL(tree.size(), 4u);
+
+		topic_tree::receivers_t r;
+		BOOST_CHECK_EQUAL(tree.match("a/b/c", r), 3u);
+		//	overlapping subscriptions: max. QoS
+		BOOST_CHECK_EQUAL(r.at(1), 2u);
+		BOOST_CHECK_EQUAL(r.at(2), 1u);
+
+		//	"a/#" matches "a"
+		r.clear();
+		BOOST_CHECK_EQUAL(tree.match("a", r), 2u);
+		BOOST_CHECK(r.count(2) == 1);
+
+		//	no wildcard match for system topics
+		r.clear();
+		BOOST_CHECK_EQUAL(tree.match("$SYS/a", r), 0u);
+
+		//
+		//	replace subscription
+		//
+		BOOST_CHECK(tree.subscribe("a/#", 2, 0));
+		BOOST_CHECK_EQUAL(tree.size(), 4u);
+
+		//
+		//	remove subscriptions
+		//
+		BOOST_CHECK(tree.unsubscribe("a/+/c", 1));
+		BOOST_CHECK(!tree.unsubscribe("a/+/c", 1));
+		BOOST_CHECK_EQUAL(tree.remove(1), 1u);
+		BOOST_CHECK_EQUAL(tree.size(), 2u);
+		r.clear();
+		BOOST_CHECK_EQUAL(tree.match("a/b/c", r), 2u);
+		BOOST_CHECK(r.count(1) == 0);
+
+		//
+		//	retained messages
+		//
+		auto const p1 = std::make_shared<std::string const>("1");
+		auto const p2 = std::make_shared<std::string const>("2");
+		BOOST_CHECK(tree.retain("x/y", p1, 0));
+		BOOST_CHECK(tree.retain("x/z", p1, 1));
+		BOOST_CHECK_EQUAL(tree.retained_count(), 2u);
+
+		//	limit reached - replace is possible, insert not
+		BOOST_CHECK(!tree.retain("x/w", p1, 0));
+		BOOST_CHECK(tree.retain("x/y", p2, 0));
+		BOOST_CHECK_EQUAL(tree.retained_count(), 2u);
+
+		auto ret = tree.get_retained("x/+");
+		BOOST_CHECK_EQUAL(ret.size(), 2u);
+		ret = tree.get_retained("x/y");
+		BOOST_REQUIRE_EQUAL(ret.size(), 1u);
+		BOOST_CHECK_EQUAL(ret.at(0).topic_, "x/y");
+		BOOST_CHECK_EQUAL(*ret.at(0).payload_, "2");
+		BOOST_CHECK_EQUAL(tree.get_retained("#").size(), 2u);
+
+		//	empty payload removes a retained message
+		BOOST_CHECK(tree.retain("x/y", std::make_shared<std::string const>(), 0));
+		BOOST_CHECK_EQUAL(tree.retained_count(), 1u);
+		BOOST_CHECK(tree.retain("x/w", p1, 0));
+		BOOST_CHECK_EQUAL(tree.get_retained("x/#").size(), 2u);
+
+		return true;
+	}
+}
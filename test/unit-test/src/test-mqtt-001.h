@@ -0,0 +1,20 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Sylko Olzscher 
+ * 
+ */ 
+#ifndef TEST_MQTT_001_H
+#define TEST_MQTT_001_H
+
+#include <NODE_project_info.h>
+
+namespace node 
+{
+	/**
+	 * Topic tree of the MQTT broker: wildcard matching,
+	 * subscription management and retained messages.
+	 */
+	bool test_mqtt_001();
+}
+#endif
@@ -0,0 +1,78 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Sylko Olzscher 
+ * 
+ */ 
+#include "test-sml-006.h"
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem.hpp>
+#include <smf/sml/exporter/output_files.h>
+
+namespace node 
+{
+	namespace
+	{
+		std::string read_file(boost::filesystem::path const& p)
+		{
+			std::ifstream ifs(p.string(), std::ios::binary);
+			return std::string(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+		}
+	}
+
+	bool test_sml_006()
+	{
+		//
+		//	test LRU of open output files
+		//
+		auto const dir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("smf-test-%%%%-%%%%");
+		boost::filesystem::create_directories(dir);
+
+		{
+			sml::output_files files(2, 1024, std::chrono::seconds(60), std::chrono::seconds(0));
+
+			files.open(dir / "a.txt", true) << "a1";
+			files.open(dir / "b.txt", true) << "b1";
+			BOOST_CHECK_EQUAL(files.size(), 2);
+
+			//
+			//	data are buffered
+			//
+			BOOST_CHECK(read_file(dir / "a.txt").empty());
+
+			//
+			//	"a" is the least recently used file and will be closed
+			//
+			files.open(dir / "c.txt", true) << "c1";
+			BOOST_CHECK_EQUAL(files.size(), 2);
+			BOOST_CHECK_EQUAL(read_file(dir / "a.txt"), "a1");
+
+			//
+			//	reopen "a" in append mode
+			//
+			files.open(dir / "a.txt") << "a2";
+			BOOST_CHECK_EQUAL(files.size(), 2);
+			BOOST_CHECK_EQUAL(read_file(dir / "b.txt"), "b1");
+
+			files.flush();
+			BOOST_CHECK_EQUAL(read_file(dir / "a.txt"), "a1a2");
+			BOOST_CHECK_EQUAL(read_file(dir / "c.txt"), "c1");
+
+			files.close(dir / "c.txt");
+			BOOST_CHECK_EQUAL(files.size(), 1);
+
+			//
+			//	invalid path
+			//
+			BOOST_CHECK(!files.open(dir / "none" / "d.txt").is_open());
+			BOOST_CHECK_EQUAL(files.size(), 1);
+		}
+
+		boost::filesystem::remove_all(dir);
+		return true;
+	}
+
+}
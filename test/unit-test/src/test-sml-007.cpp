@@ -0,0 +1,112 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Sylko Olzscher 
+ * 
+ */ 
+#include "test-sml-007.h"
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <boost/test/unit_test.hpp>
+#include <smf/sml/exporter/xml_sml_exporter.h>
+#include <smf/sml/obis_db.h>
+
+#include <cyng/factory.h>
+
+namespace node 
+{
+	namespace
+	{
+		/**
+		 * Generate a get profile list response as delivered by the parser
+		 * with the specified number of period entries.
+		 */
+		cyng::tuple_t make_profile_list_response(std::size_t idx, std::size_t entries)
+		{
+			std::uint32_t const sec = 1546300800u + static_cast<std::uint32_t>(idx * 900u);
+
+			cyng::tuple_t period;
+			for (std::size_t counter = 0; counter < entries; ++counter) {
+				period.push_back(cyng::make_object(cyng::tuple_factory(sml::OBIS_REG_POS_AE_NO_TARIFF.to_buffer()
+					, static_cast<std::uint8_t>(30)	//	Wh
+					, static_cast<std::int8_t>(-1)
+					, static_cast<std::int64_t>(3932730457 + counter)
+					, cyng::null())));
+			}
+
+			return cyng::tuple_factory(cyng::buffer_t{ '1', '9', '0', '1', '0', '1', '0', '0' }
+				, static_cast<std::uint8_t>(0)	//	group no
+				, static_cast<std::uint8_t>(0)	//	abort on error
+				, cyng::tuple_factory(static_cast<std::uint16_t>(sml::BODY_GET_PROFILE_LIST_RESPONSE)
+					, cyng::tuple_factory(cyng::buffer_t{ 0x01, (char)0xA8, 0x15, 0x70, (char)0x94, 0x48, 0x03, 0x01, 0x02 }
+						, cyng::tuple_factory(static_cast<std::uint8_t>(sml::TIME_TIMESTAMP), sec)
+						, static_cast<std::uint32_t>(900)
+						, cyng::tuple_factory(sml::OBIS_PROFILE_15_MINUTE.to_buffer())
+						, cyng::tuple_factory(static_cast<std::uint8_t>(sml::TIME_TIMESTAMP), sec)
+						, static_cast<std::uint64_t>(0)
+						, period
+						, cyng::null()
+						, cyng::null()))
+				, static_cast<std::uint16_t>(0xb68a));
+		}
+	}
+
+	bool test_sml_007()
+	{
+		//
+		//	streaming output of the XML exporter has to be identical
+		//	with the output of the document
+		//
+		std::vector<cyng::tuple_t> messages;
+		for (std::size_t idx = 0; idx < 200; ++idx) {
+			messages.push_back(make_profile_list_response(idx, 96));
+		}
+
+		std::stringstream dom;
+		auto const start_dom = std::chrono::steady_clock::now();
+		{
+			sml::xml_exporter exporter("UTF-8", "SML", 1, 2, "test");
+			std::size_t idx{ 0 };
+			for (auto const& msg : messages) {
+				exporter.read(msg, idx++);
+			}
+			exporter.write(dom);
+		}
+		auto const delta_dom = std::chrono::steady_clock::now() - start_dom;
+
+		std::stringstream stream;
+		auto const start_stream = std::chrono::steady_clock::now();
+		{
+			sml::xml_exporter exporter("UTF-8", "SML", 1, 2, "test");
+			exporter.write_header(stream);
+			std::size_t idx{ 0 };
+			for (auto const& msg : messages) {
+				exporter.write(stream, msg, idx++);
+			}
+			exporter.write_footer(stream);
+		}
+		auto const delta_stream = std::chrono::steady_clock::now() - start_stream;
+
+		BOOST_CHECK(!dom.str().empty());
+		BOOST_CHECK_EQUAL(dom.str(), stream.str());
+
+		//
+		//	throughput comparison
+		//
+		std::cout
+			<< "XML export of "
+			<< messages.size()
+			<< " messages ("
+			<< stream.str().size()
+			<< " bytes) - document: "
+			<< std::chrono::duration_cast<std::chrono::milliseconds>(delta_dom).count()
+			<< " ms, streaming: "
+			<< std::chrono::duration_cast<std::chrono::milliseconds>(delta_stream).count()
+			<< " ms"
+			<< std::endl;
+
+		return true;
+	}
+
+}
@@ -0,0 +1,154 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Sylko Olzscher 
+ * 
+ */ 
+#include "test-sml-008.h"
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <tuple>
+#include <boost/test/unit_test.hpp>
+#include <smf/sml/exporter/archive_format.h>
+
+namespace node 
+{
+	bool test_sml_008()
+	{
+		//
+		//	columnar archive: encode/decode and skip chunks by index
+		//
+		std::int64_t const start = 1546300800;	//	2019-01-01
+		std::vector<sml::archive_record> records;
+		std::stringstream ss;
+
+		for (std::int64_t day = 0; day < 4; ++day) {
+			sml::archive_chunk chunk;
+			for (std::int64_t slot = 0; slot < 96; ++slot) {
+				for (std::size_t meter = 0; meter < 3; ++meter) {
+					sml::archive_record const rec{ "01-e61e-1309001" + std::to_string(meter) + "-3c-07"
+						, sml::obis(0x01, 0x00, 0x01, 0x08, 0x00, 0xFF)
+						, start + day * 86400 + slot * 900
+						, static_cast<std::int64_t>(2746916 + day * 1000 + slot * 10 + meter)
+						, -1
+						, 30
+						, (slot == 17) ? 8u : 0u };
+					chunk.append(rec);
+					records.push_back(rec);
+				}
+			}
+			BOOST_CHECK_EQUAL(chunk.size(), 288);
+			chunk.write(ss);
+			BOOST_CHECK(chunk.empty());
+		}
+
+		std::cout
+			<< records.size()
+			<< " records in "
+			<< ss.str().size()
+			<< " bytes"
+			<< std::endl;
+
+		//
+		//	read all
+		//
+		{
+			std::vector<sml::archive_record> result;
+			sml::archive_stats stats;
+			BOOST_CHECK(sml::scan_archive(ss, sml::archive_filter(), [&](sml::archive_record const& rec) {
+				result.push_back(rec);
+			}, stats));
+
+			BOOST_CHECK_EQUAL(stats.chunks_, 4);
+			BOOST_CHECK_EQUAL(stats.skipped_, 0);
+			BOOST_REQUIRE_EQUAL(result.size(), records.size());
+
+			//
+			//	records are sorted by series and time inside of each chunk
+			//
+			auto cmp = [](sml::archive_record const& a, sml::archive_record const& b) {
+				return std::tie(a.server_, a.time_) < std::tie(b.server_, b.time_);
+			};
+			std::sort(records.begin(), records.end(), cmp);
+			std::sort(result.begin(), result.end(), cmp);
+			for (std::size_t idx = 0; idx < records.size(); ++idx) {
+				BOOST_CHECK_EQUAL(result.at(idx).server_, records.at(idx).server_);
+				BOOST_CHECK(result.at(idx).code_ == records.at(idx).code_);
+				BOOST_CHECK_EQUAL(result.at(idx).time_, records.at(idx).time_);
+				BOOST_CHECK_EQUAL(result.at(idx).value_, records.at(idx).value_);
+				BOOST_CHECK_EQUAL(result.at(idx).scaler_, records.at(idx).scaler_);
+				BOOST_CHECK_EQUAL(result.at(idx).unit_, records.at(idx).unit_);
+				BOOST_CHECK_EQUAL(result.at(idx).status_, records.at(idx).status_);
+			}
+		}
+
+		//
+		//	time range of the second day and a single meter
+		//
+		{
+			ss.clear();
+			ss.seekg(0);
+
+			sml::archive_filter filter;
+			filter.begin_ = start + 86400;
+			filter.end_ = start + 2 * 86400 - 1;
+			filter.servers_.insert("01-e61e-13090012-3c-07");
+
+			std::size_t count{ 0 };
+			sml::archive_stats stats;
+			BOOST_CHECK(sml::scan_archive(ss, filter, [&](sml::archive_record const& rec) {
+				BOOST_CHECK_EQUAL(rec.server_, "01-e61e-13090012-3c-07");
+				++count;
+			}, stats));
+
+			BOOST_CHECK_EQUAL(count, 96);
+			BOOST_CHECK_EQUAL(stats.chunks_, 4);
+			BOOST_CHECK_EQUAL(stats.skipped_, 3);
+			BOOST_CHECK_EQUAL(stats.records_, 288);
+		}
+
+		//
+		//	unknown OBIS code - all chunks are skipped by dictionary
+		//
+		{
+			ss.clear();
+			ss.seekg(0);
+
+			sml::archive_filter filter;
+			filter.codes_.insert(sml::obis(0x01, 0x00, 0x02, 0x08, 0x00, 0xFF));
+			sml::archive_stats stats;
+			BOOST_CHECK(sml::scan_archive(ss, filter, [](sml::archive_record const&) {
+				BOOST_CHECK(false);
+			}, stats));
+			BOOST_CHECK_EQUAL(stats.skipped_, 4);
+			BOOST_CHECK_EQUAL(stats.records_, 0);
+		}
+
+		//
+		//	truncated archive
+		//
+		{
+			std::stringstream truncated(ss.str().substr(0, 100));
+			sml::archive_stats stats;
+			BOOST_CHECK(!sml::scan_archive(truncated, sml::archive_filter(), [](sml::archive_record const&) {}, stats));
+		}
+
+		//
+		//	corrupted dictionary: the server count (2^32 - 1) exceeds
+		//	the size of the dictionary
+		//
+		{
+			auto corrupted = ss.str().substr(0, 25);	//	header up to dictionary size
+			corrupted.append({ 5, 0, 0, 0 });	//	dictionary size
+			corrupted.append({ 0, 0, 0, 0 });	//	column size
+			corrupted.append({ '\xFF', '\xFF', '\xFF', '\xFF', 0x0F });
+			std::stringstream cs(corrupted);
+			sml::archive_stats stats;
+			BOOST_CHECK(!sml::scan_archive(cs, sml::archive_filter(), [](sml::archive_record const&) {}, stats));
+		}
+
+		return true;
+	}
+
+}
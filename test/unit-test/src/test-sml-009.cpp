@@ -0,0 +1,227 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Sylko Olzscher 
+ * 
+ */ 
+#include "test-sml-009.h"
+#include <iostream>
+#include <chrono>
+#include <boost/test/unit_test.hpp>
+#include <smf/sml/protocol/request_template.h>
+#include <smf/sml/protocol/generator.h>
+#include <smf/sml/protocol/message.h>
+#include <smf/sml/protocol/serializer.h>
+#include <smf/sml/crc16.h>
+#include <smf/sml/obis_db.h>
+
+#include <cyng/factory.h>
+#include <sstream>
+
+namespace node 
+{
+	bool test_sml_009()
+	{
+		//
+		//	request templates must produce the same messages
+		//	as the serialized object tree
+		//
+		sml::request_template const tpl = sml::request_template(sml::BODY_GET_PROC_PARAMETER_REQUEST, 5)
+			.slot(sml::request_template::SLOT_OCTET)	//	server id
+			.slot(sml::request_template::SLOT_OCTET)	//	username
+			.slot(sml::request_template::SLOT_OCTET)	//	password
+			.list(1).slot(sml::request_template::SLOT_OCTET)	//	path entry
+			.append(cyng::make_object())	//	attribute
+			;
+		BOOST_CHECK_EQUAL(tpl.slots(), 6);
+
+		cyng::buffer_t const server_id{ 0x05, 0x00, 0x15, 0x3B, 0x02, 0x29, 0x7E };
+		std::string const user = "operator";
+
+		for (std::size_t idx = 0; idx < 20; ++idx) {
+
+			std::string const trx = "3029127-" + std::to_string(idx * 7);
+			std::string const pwd(idx, 'x');
+			auto const group = static_cast<std::uint8_t>(idx);
+
+			auto const code = (idx % 2 == 0)
+				? sml::OBIS_CODE_ROOT_IPT_PARAM
+				: sml::OBIS_CODE_ROOT_ACTIVE_DEVICES
+				;
+
+			cyng::buffer_t expected = sml::linearize(sml::message(cyng::make_object(trx)
+				, group
+				, 0
+				, sml::BODY_GET_PROC_PARAMETER_REQUEST
+				, sml::get_proc_parameter_request(cyng::make_object(server_id), user, pwd, code)));
+			sml::sml_set_crc16(expected);
+
+			BOOST_CHECK(tpl.render({ trx, group, server_id, user, pwd, code }) == expected);
+		}
+
+		//
+		//	timestamps
+		//
+		sml::request_template const tpl_profile = sml::request_template(sml::BODY_GET_PROFILE_LIST_REQUEST, 9)
+			.slot(sml::request_template::SLOT_OCTET)	//	server id
+			.slot(sml::request_template::SLOT_OCTET)	//	username
+			.slot(sml::request_template::SLOT_OCTET)	//	password
+			.append(cyng::make_object(false))	//	with raw data
+			.slot(sml::request_template::SLOT_TIMESTAMP)	//	begin time
+			.slot(sml::request_template::SLOT_TIMESTAMP)	//	end time
+			.list(1).slot(sml::request_template::SLOT_OCTET)	//	path entry
+			.list(0)	//	object list
+			.list(0)	//	details
+			;
+
+		{
+			auto const start = std::chrono::system_clock::from_time_t(1546300800);	//	2019-01-01
+			auto const end = start + std::chrono::hours(24);
+			auto const code = sml::obis(0x81, 0x81, 0xC7, 0x86, 0x01, 0xFF);
+			std::uint8_t const group = 1;
+			std::string const trx = "3029127-2";
+
+			cyng::tuple_t obj_list, details;
+			cyng::buffer_t expected = sml::linearize(sml::message(cyng::make_object(trx)
+				, group
+				, 0
+				, sml::BODY_GET_PROFILE_LIST_REQUEST
+				, sml::get_profile_list_request(cyng::make_object(server_id), user, user, false, start, end, code, obj_list, details)));
+			sml::sml_set_crc16(expected);
+
+			BOOST_CHECK(tpl_profile.render({ trx, group, server_id, user, user, start, end, code }) == expected);
+		}
+
+		//
+		//	length fields of octet strings include the TL field
+		//	(carry at 15, 30, 46, ... and 254 bytes)
+		//
+		for (std::size_t size = 0; size < 300; ++size) {
+			std::ostringstream os;
+			sml::serialize(os, cyng::make_object(std::string(size, 'x')));
+			auto const b = os.str();
+
+			std::size_t length = 0, tl = 0;
+			do {
+				length = (length << 4) | (b.at(tl) & 0x0F);
+			} while ((b.at(tl++) & 0x80) != 0);
+
+			BOOST_CHECK_EQUAL(length, b.size());
+			BOOST_CHECK_EQUAL(tl + size, b.size());
+			BOOST_CHECK_EQUAL(b.at(0) & 0x70, 0);
+		}
+
+		//
+		//	req_generator must produce the same SML file as the object tree.
+		//	Field sizes with multi-byte length fields.
+		//
+		{
+			cyng::mac48 const client_id(0, 1, 2, 3, 4, 5);
+			std::string const name(15, 'n');
+			std::string const pwd(30, 'p');
+			std::string const pwd_long(254, 'q');
+			auto const start = std::chrono::system_clock::from_time_t(1546300800);	//	2019-01-01
+			auto const end = start + std::chrono::hours(24);
+			auto const code = sml::obis(0x81, 0x81, 0xC7, 0x86, 0x01, 0xFF);
+
+			//
+			//	the file id of the open request depends on the time
+			//
+			auto const file_id = sml::generator::gen_file_id();
+
+			sml::req_generator gen;
+			gen.public_open(client_id, server_id, name, pwd);
+			auto const trx_open = gen.get_trx();
+			gen.get_list(client_id.to_buffer(), server_id, name, std::string(46, 'l'), sml::OBIS_CODE_ROOT_IPT_PARAM);
+			auto const trx_list = gen.get_trx();
+			gen.get_profile_list(server_id, name, pwd_long, start, end, code);
+			auto const trx_profile = gen.get_trx();
+			gen.public_close();
+			auto const trx_close = gen.get_trx();
+
+			auto const expected = [&](std::string const& fid) -> cyng::buffer_t {
+				cyng::tuple_t obj_list, details;
+				std::vector<cyng::buffer_t> msgs;
+				msgs.push_back(sml::linearize(sml::message(cyng::make_object(trx_open)
+					, 0
+					, 0
+					, sml::BODY_OPEN_REQUEST
+					, sml::open_request(cyng::make_object()
+						, cyng::make_object(client_id.to_buffer())
+						, cyng::make_object(fid)
+						, cyng::make_object(server_id)
+						, cyng::make_object(name)
+						, cyng::make_object(pwd)
+						, cyng::make_object()))));
+				msgs.push_back(sml::linearize(sml::message(cyng::make_object(trx_list)
+					, 1
+					, 0
+					, sml::BODY_GET_LIST_REQUEST
+					, sml::get_list_request(cyng::make_object(client_id.to_buffer())
+						, cyng::make_object(server_id)
+						, name
+						, std::string(46, 'l')
+						, sml::OBIS_CODE_ROOT_IPT_PARAM))));
+				msgs.push_back(sml::linearize(sml::message(cyng::make_object(trx_profile)
+					, 2
+					, 0
+					, sml::BODY_GET_PROFILE_LIST_REQUEST
+					, sml::get_profile_list_request(cyng::make_object(server_id), name, pwd_long, false, start, end, code, obj_list, details))));
+				msgs.push_back(sml::linearize(sml::message(cyng::make_object(trx_close)
+					, 0
+					, 0
+					, sml::BODY_CLOSE_REQUEST
+					, sml::close_response(cyng::make_object()))));
+				for (auto& msg : msgs)	sml::sml_set_crc16(msg);
+				return sml::boxing(msgs);
+			};
+
+			auto const result = gen.boxing();
+			auto const file_id_after = sml::generator::gen_file_id();
+			BOOST_CHECK(result == expected(file_id) || (file_id != file_id_after && result == expected(file_id_after)));
+		}
+
+		//
+		//	compare runtime
+		//
+		std::size_t const count = 10000;
+		std::size_t size_tree = 0, size_tpl = 0;
+
+		auto const start_tree = std::chrono::steady_clock::now();
+		for (std::size_t idx = 0; idx < count; ++idx) {
+			cyng::buffer_t b = sml::linearize(sml::message(cyng::make_object(std::string("3029127-1"))
+				, static_cast<std::uint8_t>(idx)
+				, 0
+				, sml::BODY_GET_PROC_PARAMETER_REQUEST
+				, sml::get_proc_parameter_request(cyng::make_object(server_id), user, user, sml::OBIS_CODE_ROOT_IPT_PARAM)));
+			sml::sml_set_crc16(b);
+			size_tree += b.size();
+		}
+		auto const delta_tree = std::chrono::steady_clock::now() - start_tree;
+
+		auto const start_tpl = std::chrono::steady_clock::now();
+		for (std::size_t idx = 0; idx < count; ++idx) {
+			size_tpl += tpl.render({ std::string("3029127-1")
+				, static_cast<std::uint8_t>(idx)
+				, server_id
+				, user
+				, user
+				, sml::OBIS_CODE_ROOT_IPT_PARAM }).size();
+		}
+		auto const delta_tpl = std::chrono::steady_clock::now() - start_tpl;
+
+		BOOST_CHECK_EQUAL(size_tree, size_tpl);
+
+		std::cout
+			<< count
+			<< " requests - object tree: "
+			<< std::chrono::duration_cast<std::chrono::milliseconds>(delta_tree).count()
+			<< " ms, template: "
+			<< std::chrono::duration_cast<std::chrono::milliseconds>(delta_tpl).count()
+			<< " ms"
+			<< std::endl;
+
+		return true;
+	}
+
+}
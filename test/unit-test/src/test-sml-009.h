@@ -0,0 +1,16 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Sylko Olzscher 
+ * 
+ */ 
+#ifndef TEST_SML_009_H
+#define TEST_SML_009_H
+
+#include <NODE_project_info.h>
+
+namespace node 
+{
+	bool test_sml_009();
+}
+#endif	//	TEST_SML_009_H
@@ -0,0 +1,116 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Sylko Olzscher 
+ * 
+ */ 
+#include "test-stat-001.h"
+#include <boost/test/unit_test.hpp>
+#include "../../../tasks/stat/src/ring_counter.h"
+#include "../../../tasks/stat/src/tdigest.h"
+#include <random>
+#include <algorithm>
+
+namespace node 
+{
+	bool test_stat_001()
+	{
+		//
+		//	ring counter with 10 one-second slots
+		//
+		std::chrono::system_clock::time_point const t0(std::chrono::seconds(1000000));
+		ring_counter rc(10, std::chrono::seconds(1));
+		BOOST_CHECK(rc.span() == std::chrono::seconds(10));
+
+		for (int idx = 0; idx < 10; ++idx) {
+			rc.add(t0 + std::chrono::seconds(idx), idx + 1);
+		}
+		auto const now = t0 + std::chrono::seconds(9);
+		BOOST_CHECK_EQUAL(rc.total(), 55u);
+
+		//	sliding window (now - window, now]
+		BOOST_CHECK_EQUAL(rc.sum(now, std::chrono::seconds(1)), 10u);
+		BOOST_CHECK_EQUAL(rc.sum(now, std::chrono::seconds(3)), 27u);
+		BOOST_CHECK_EQUAL(rc.sum(now, std::chrono::seconds(10)), 55u);
+		//	longer than the ring
+		BOOST_CHECK_EQUAL(rc.sum(now, std::chrono::seconds(60)), 55u);
+
+		//	tumbling window [start, end)
+		BOOST_CHECK_EQUAL(rc.sum(t0, t0 + std::chrono::seconds(5)), 15u);
+		BOOST_CHECK_EQUAL(rc.sum(t0 + std::chrono::seconds(5), t0 + std::chrono::seconds(10)), 40u);
+
+		//	events older than the ring are ignored
+		rc.add(t0 - std::chrono::seconds(1));
+		BOOST_CHECK_EQUAL(rc.total(), 55u);
+
+		//	late events within the ring are counted
+		rc.add(t0 + std::chrono::seconds(2), 100);
+		BOOST_CHECK_EQUAL(rc.sum(now, std::chrono::seconds(10)), 155u);
+
+		//
+		//	advance 3 seconds: the 3 oldest slots are reused
+		//
+		rc.add(now + std::chrono::seconds(3));
+		BOOST_CHECK_EQUAL(rc.sum(now + std::chrono::seconds(3), std::chrono::seconds(10)), 155u - 1u - 2u - 103u + 1u);
+		BOOST_CHECK_EQUAL(rc.sum(now + std::chrono::seconds(3), std::chrono::seconds(3)), 1u);
+		BOOST_CHECK_EQUAL(rc.sum(t0, t0 + std::chrono::seconds(3)), 0u);
+
+		//	a gap larger than the ring clears all slots
+		rc.add(now + std::chrono::seconds(100));
+		BOOST_CHECK_EQUAL(rc.sum(now + std::chrono::seconds(100), std::chrono::seconds(10)), 1u);
+		BOOST_CHECK_EQUAL(rc.total(), 157u);
+
+		//
+		//	empty t-digest
+		//
+		tdigest td(100.0);
+		BOOST_CHECK_EQUAL(td.quantile(0.5), 0.0);
+		BOOST_CHECK_EQUAL(td.count(), 0.0);
+
+		//
+		//	uniform distribution [0, 1000)
+		//
+		std::mt19937 rng(42);
+		std::vector<double> values(10000);
+		std::uniform_real_distribution<double> dist(0.0, 1000.0);
+		for (auto& v : values) {
+			v = dist(rng);
+			td.add(v);
+		}
+		std::sort(values.begin(), values.end());
+
+		BOOST_CHECK_EQUAL(td.count(), 10000.0);
+		BOOST_CHECK_EQUAL(td.min(), values.front());
+		BOOST_CHECK_EQUAL(td.max(), values.back());
+		BOOST_CHECK_EQUAL(td.quantile(0.0), values.front());
+		BOOST_CHECK_EQUAL(td.quantile(1.0), values.back());
+
+		//	error relative to the range - tails are more accurate
+		for (auto const q : { 0.01, 0.1, 0.5, 0.9, 0.99 }) {
+			auto const exact = values.at(static_cast<std::size_t>(q * values.size()));
+			BOOST_CHECK_SMALL(td.quantile(q) - exact, (q < 0.05 || q > 0.95) ? 2.0 : 10.0);
+		}
+
+		//
+		//	merge two halves - same estimate as one digest
+		//
+		tdigest lower(100.0), upper(100.0);
+		for (auto const v : values) {
+			if (v < 500.0)	lower.add(v);
+			else upper.add(v);
+		}
+		lower.merge(upper);
+		BOOST_CHECK_EQUAL(lower.count(), 10000.0);
+		BOOST_CHECK_EQUAL(lower.max(), values.back());
+		BOOST_CHECK_SMALL(lower.quantile(0.5) - values.at(5000), 10.0);
+		BOOST_CHECK_SMALL(lower.quantile(0.99) - values.at(9900), 2.0);
+
+		//	reset keeps nothing
+		td.reset();
+		BOOST_CHECK_EQUAL(td.count(), 0.0);
+		td.add(7.0);
+		BOOST_CHECK_EQUAL(td.quantile(0.9), 7.0);
+
+		return true;
+	}
+}
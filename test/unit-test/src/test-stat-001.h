@@ -0,0 +1,20 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Sylko Olzscher 
+ * 
+ */ 
+#ifndef TEST_STAT_001_H
+#define TEST_STAT_001_H
+
+#include <NODE_project_info.h>
+
+namespace node 
+{
+	/**
+	 * Rollups of the stat task: sliding and tumbling windows
+	 * of the ring counter and quantiles of the t-digest.
+	 */
+	bool test_stat_001();
+}
+#endif
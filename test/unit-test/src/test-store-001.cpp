@@ -0,0 +1,58 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Sylko Olzscher 
+ * 
+ */ 
+#include "test-store-001.h"
+#include <boost/test/unit_test.hpp>
+#include "../../../nodes/ipt/store/src/raw_file_name.h"
+
+namespace node 
+{
+	bool test_store_001()
+	{
+		std::string protocol, target;
+		std::uint32_t channel{ 0 }, source{ 0 };
+
+		//
+		//	current layout
+		//
+		BOOST_CHECK(parse_raw_file_name("smf--SML-201901T011530-store-0012-00ab.bin", "smf", "bin", protocol, target, channel, source));
+		BOOST_CHECK_EQUAL(protocol, "SML");
+		BOOST_CHECK_EQUAL(target, "store");
+		BOOST_CHECK_EQUAL(channel, 0x12u);
+		BOOST_CHECK_EQUAL(source, 0xabu);
+
+		BOOST_CHECK(parse_raw_file_name("smf--IEC-201901T011530-water-meter-1a2b3-0001.bin", "smf", "bin", protocol, target, channel, source));
+		BOOST_CHECK_EQUAL(protocol, "IEC");
+		BOOST_CHECK_EQUAL(target, "water-meter");
+		BOOST_CHECK_EQUAL(channel, 0x1a2b3u);
+		BOOST_CHECK_EQUAL(source, 1u);
+
+		//
+		//	legacy layout without '-' between target and channel
+		//
+		BOOST_CHECK(parse_raw_file_name("smf--SML-201901T011530-store0012-00ab.bin", "smf", "bin", protocol, target, channel, source));
+		BOOST_CHECK_EQUAL(protocol, "SML");
+		BOOST_CHECK_EQUAL(target, "store");
+		BOOST_CHECK_EQUAL(channel, 0x12u);
+		BOOST_CHECK_EQUAL(source, 0xabu);
+
+		BOOST_CHECK(parse_raw_file_name("smf--IEC-201901T011530-gw-010012-0034.bin", "smf", "bin", protocol, target, channel, source));
+		BOOST_CHECK_EQUAL(target, "gw-01");
+		BOOST_CHECK_EQUAL(channel, 0x12u);
+		BOOST_CHECK_EQUAL(source, 0x34u);
+
+		//
+		//	invalid names
+		//
+		BOOST_CHECK(!parse_raw_file_name("smf--SML-201901T011530-0012-00ab.bin", "smf", "bin", protocol, target, channel, source));
+		BOOST_CHECK(!parse_raw_file_name("smf--SML-201901T011530-store-0012-00ab.log", "smf", "bin", protocol, target, channel, source));
+		BOOST_CHECK(!parse_raw_file_name("smf--SML-201901T011530-store-0012-xyz.bin", "smf", "bin", protocol, target, channel, source));
+		BOOST_CHECK(!parse_raw_file_name("smf--SML.bin", "smf", "bin", protocol, target, channel, source));
+
+		return true;
+	}
+
+}
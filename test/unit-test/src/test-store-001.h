@@ -0,0 +1,19 @@
+/*
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2019 Sylko Olzscher 
+ * 
+ */ 
+#ifndef TEST_STORE_001_H
+#define TEST_STORE_001_H
+
+#include <NODE_project_info.h>
+
+namespace node 
+{
+	/**
+	 * File names of the binary consumer in current and legacy layout.
+	 */
+	bool test_store_001();
+}
+#endif
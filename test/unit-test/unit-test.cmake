@@ -10,14 +10,27 @@ set (unit_test_cpp
 	test/unit-test/src/test-ipt-003.cpp
 	test/unit-test/src/test-ipt-004.cpp
 	test/unit-test/src/test-ipt-005.cpp
+	test/unit-test/src/test-ipt-006.cpp
+	test/unit-test/src/test-ipt-007.cpp
+	test/unit-test/src/test-ipt-008.cpp
 	test/unit-test/src/test-sml-001.cpp
 	test/unit-test/src/test-sml-002.cpp
 	test/unit-test/src/test-sml-003.cpp
 	test/unit-test/src/test-sml-004.cpp
+	test/unit-test/src/test-sml-006.cpp
+	test/unit-test/src/test-sml-007.cpp
+	test/unit-test/src/test-sml-008.cpp
+	test/unit-test/src/test-sml-009.cpp
 	test/unit-test/src/test-mbus-001.cpp
 	test/unit-test/src/test-mbus-002.cpp
 	test/unit-test/src/test-mbus-003.cpp
+	test/unit-test/src/test-mbus-004.cpp
+	test/unit-test/src/test-mbus-005.cpp
 	test/unit-test/src/test-serial-001.cpp
+	test/unit-test/src/test-mqtt-001.cpp
+	test/unit-test/src/test-cluster-001.cpp
+	test/unit-test/src/test-stat-001.cpp
+	test/unit-test/src/test-store-001.cpp
 )
     
 set (unit_test_h
@@ -26,14 +39,27 @@ set (unit_test_h
 	test/unit-test/src/test-ipt-003.h
 	test/unit-test/src/test-ipt-004.h
 	test/unit-test/src/test-ipt-005.h
+	test/unit-test/src/test-ipt-006.h
+	test/unit-test/src/test-ipt-007.h
+	test/unit-test/src/test-ipt-008.h
 	test/unit-test/src/test-sml-001.h
 	test/unit-test/src/test-sml-002.h
 	test/unit-test/src/test-sml-003.h
 	test/unit-test/src/test-sml-004.h
+	test/unit-test/src/test-sml-006.h
+	test/unit-test/src/test-sml-007.h
+	test/unit-test/src/test-sml-008.h
+	test/unit-test/src/test-sml-009.h
 	test/unit-test/src/test-mbus-001.h
 	test/unit-test/src/test-mbus-002.h
 	test/unit-test/src/test-mbus-003.h
+	test/unit-test/src/test-mbus-004.h
+	test/unit-test/src/test-mbus-005.h
 	test/unit-test/src/test-serial-001.h
+	test/unit-test/src/test-mqtt-001.h
+	test/unit-test/src/test-cluster-001.h
+	test/unit-test/src/test-stat-001.h
+	test/unit-test/src/test-store-001.h
 )
 
 set (sml_exporter
@@ -42,6 +68,36 @@ set (sml_exporter
 	lib/sml/exporter/src/xml_sml_exporter.cpp
 	src/main/include/smf/sml/exporter/db_sml_exporter.h
 	lib/sml/exporter/src/db_sml_exporter.cpp
+	src/main/include/smf/sml/exporter/output_files.h
+	lib/sml/exporter/src/output_files.cpp
+	src/main/include/smf/sml/exporter/archive_format.h
+	lib/sml/exporter/src/archive_format.cpp
+)
+
+set (mqtt_broker
+
+	nodes/mqtt/src/topic_tree.h
+	nodes/mqtt/src/topic_tree.cpp
+)
+
+set (cluster_net
+
+	src/main/include/smf/cluster/buffer_pool.h
+	nodes/shared/net/buffer_pool.cpp
+)
+
+set (stat_rollup
+
+	tasks/stat/src/ring_counter.h
+	tasks/stat/src/ring_counter.cpp
+	tasks/stat/src/tdigest.h
+	tasks/stat/src/tdigest.cpp
+)
+
+set (store_files
+
+	nodes/ipt/store/src/raw_file_name.h
+	nodes/ipt/store/src/raw_file_name.cpp
 )
 
 set (unit_test_samples
@@ -55,6 +111,10 @@ set (unit_test
   ${unit_test_cpp}
   ${unit_test_h}
   ${sml_exporter}
+  ${mqtt_broker}
+  ${cluster_net}
+  ${stat_rollup}
+  ${store_files}
   ${unit_test_samples}
 )
 